@@ -8,10 +8,13 @@ from pathlib import Path
 # Linker script fragment injected into the rodata output section of whichever
 # platform we're building for.  Placed just before the end-of-rodata marker so
 # that the dynarray entries land in flash rodata and are correctly sorted.
+# Sorted by name so that each array (usermods, effects) stays contiguous:
+# SORT_BY_INIT_PRIORITY orders by the trailing number only, which would
+# interleave the .0/.1/.99999 sections of different arrays.
 DYNARRAY_INJECTION = (
     "\n    /* dynarray: WLED dynamic module arrays */\n"
     "    . = ALIGN(0x10);\n"
-    "    KEEP(*(SORT_BY_INIT_PRIORITY(.dynarray.*)))\n"
+    "    KEEP(*(SORT_BY_NAME(.dynarray.*)))\n"
     "    "
 )
 
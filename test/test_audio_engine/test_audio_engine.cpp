@@ -0,0 +1,269 @@
+// fixed-point FFT and GEQ mapping of the AudioReactive analysis pipeline (usermods/audioreactive/audio_engine.h)
+#include <unity.h>
+#include <stdio.h>
+#include <math.h>
+#include <string>
+#include "wled_host.h"
+#include "../../usermods/audioreactive/audio_engine.h"
+
+#define SAMPLE_RATE 22050
+
+static uint32_t rnd = 1;
+static uint32_t nextRandom() { rnd ^= rnd << 13; rnd ^= rnd >> 17; rnd ^= rnd << 5; return rnd; }
+
+static void sine(int16_t *buf, unsigned n, float freq, float amplitude, float phase = 0.0f) {
+  for (unsigned i = 0; i < n; i++) buf[i] = int16_t(lroundf(amplitude * sinf(2.0f * float(M_PI) * freq * i / SAMPLE_RATE + phase)));
+}
+
+// magnitudes of the same windowed input, double precision DFT scaled like AudioFixedFFT (1/N, window, headroom)
+static void referenceDFT(const int16_t *in, unsigned n, double *mag) {
+  double mean = 0;
+  for (unsigned i = 0; i < n; i++) mean += in[i];
+  mean /= n;
+  for (unsigned k = 0; k < n / 2; k++) {
+    double re = 0, im = 0;
+    for (unsigned i = 0; i < n; i++) {
+      const double x = 2.0 * M_PI * i / (n - 1);
+      const double w = 0.35875 - 0.48829*cos(x) + 0.14128*cos(2*x) - 0.01168*cos(3*x);
+      const double v = (in[i] - mean) * w / 2.0;
+      re += v * cos(2.0 * M_PI * k * i / n);
+      im -= v * sin(2.0 * M_PI * k * i / n);
+    }
+    mag[k] = sqrt(re*re + im*im) / (n / 2);
+  }
+}
+
+// minimal WAV reader: 16 bit PCM, first channel only, unknown chunks are skipped; returns number of samples (0: error)
+static size_t loadWav(const char *path, int16_t *samples, size_t maxSamples, uint32_t &rate) {
+  FILE *f = fopen(path, "rb");
+  if (!f) return 0;
+  size_t count = 0;
+  unsigned channels = 0, bits = 0;
+  uint8_t hdr[12];
+  if (fread(hdr, 1, 12, f) == 12 && memcmp(hdr, "RIFF", 4) == 0 && memcmp(hdr + 8, "WAVE", 4) == 0) {
+    uint8_t chunk[8];
+    while (fread(chunk, 1, 8, f) == 8) {
+      const uint32_t len = chunk[4] | (chunk[5] << 8) | (chunk[6] << 16) | (uint32_t(chunk[7]) << 24);
+      if (memcmp(chunk, "fmt ", 4) == 0 && len >= 16) {
+        uint8_t fmt[16];
+        if (fread(fmt, 1, 16, f) != 16 || (fmt[0] | (fmt[1] << 8)) != 1) break; // PCM only
+        channels = fmt[2] | (fmt[3] << 8);
+        rate     = fmt[4] | (fmt[5] << 8) | (fmt[6] << 16) | (uint32_t(fmt[7]) << 24);
+        bits     = fmt[14] | (fmt[15] << 8);
+        fseek(f, len - 16 + (len & 1), SEEK_CUR);
+      } else if (memcmp(chunk, "data", 4) == 0) {
+        if (!channels || bits != 16) break;
+        uint8_t frame[16];
+        const size_t frameSize = 2 * channels;
+        for (size_t i = 0; i < len / frameSize && count < maxSamples && frameSize <= sizeof(frame); i++) {
+          if (fread(frame, 1, frameSize, f) != frameSize) break;
+          samples[count++] = int16_t(frame[0] | (frame[1] << 8));
+        }
+        break;
+      } else {
+        fseek(f, len + (len & 1), SEEK_CUR); // chunks are padded to even size
+      }
+    }
+  }
+  fclose(f);
+  return count;
+}
+
+// fixture next to this file: 4096 samples at 22050Hz, 440Hz + 1320Hz with attack and tremolo, 95Hz hum and noise
+static std::string fixturePath(const char *name) {
+  const std::string file = __FILE__;
+  const size_t slash = file.find_last_of('/');
+  return (slash == std::string::npos ? std::string() : file.substr(0, slash + 1)) + name;
+}
+
+void setUp(void) { rnd = 1; }
+void tearDown(void) {}
+
+void test_init_sizes(void) {
+  AudioFixedFFT fft;
+  TEST_ASSERT_FALSE(fft.init(128, AudioFixedFFT::BLACKMAN_HARRIS));
+  TEST_ASSERT_FALSE(fft.init(2048, AudioFixedFFT::BLACKMAN_HARRIS));
+  TEST_ASSERT_EQUAL(0, fft.size());
+  const uint16_t sizes[] = {256, 512, 1024};
+  for (uint16_t n : sizes) {
+    TEST_ASSERT_TRUE(fft.init(n, AudioFixedFFT::FLAT_TOP));
+    TEST_ASSERT_EQUAL(n, fft.size());
+  }
+}
+
+void test_isqrt(void) {
+  for (uint32_t x = 0; x < 70000; x++) TEST_ASSERT_EQUAL(uint32_t(sqrt(double(x))), AudioFixedFFT::isqrt32(x));
+  for (int i = 0; i < 100000; i++) {
+    const uint32_t x = nextRandom() >> 1;
+    TEST_ASSERT_EQUAL(uint32_t(sqrt(double(x))), AudioFixedFFT::isqrt32(x));
+  }
+}
+
+// a sine puts its peak into the right bin for all sizes (radix-4 only and mixed radix)
+void test_sine_peak(void) {
+  const uint16_t sizes[] = {256, 512, 1024};
+  const float freqs[] = {110.0f, 440.0f, 1000.0f, 3500.0f, 8000.0f};
+  AudioFixedFFT fft;
+  static int16_t buf[1024];
+  for (uint16_t n : sizes) {
+    TEST_ASSERT_TRUE(fft.init(n, AudioFixedFFT::BLACKMAN_HARRIS));
+    for (float f : freqs) {
+      sine(buf, n, f, 12000.0f);
+      fft.compute(buf);
+      unsigned peak = 1;
+      for (unsigned k = 1; k < n / 2; k++) if (buf[k] > buf[peak]) peak = k;
+      const float expected = f * n / SAMPLE_RATE;
+      TEST_ASSERT_FLOAT_WITHIN(1.0f, expected, float(peak));
+    }
+  }
+}
+
+// fixed-point magnitudes follow a double precision DFT within a few LSB
+void test_matches_reference(void) {
+  const uint16_t sizes[] = {256, 512, 1024};
+  AudioFixedFFT fft;
+  static int16_t in[1024], buf[1024];
+  static double ref[512];
+  for (uint16_t n : sizes) {
+    TEST_ASSERT_TRUE(fft.init(n, AudioFixedFFT::BLACKMAN_HARRIS));
+    // two tones and noise
+    for (unsigned i = 0; i < n; i++) {
+      in[i] = int16_t(lroundf(8000.0f * sinf(2.0f * float(M_PI) * 300.0f * i / SAMPLE_RATE)
+                            + 3000.0f * sinf(2.0f * float(M_PI) * 2500.0f * i / SAMPLE_RATE)) + int16_t(nextRandom() % 1001) - 500);
+    }
+    memcpy(buf, in, n * sizeof(int16_t));
+    fft.compute(buf);
+    referenceDFT(in, n, ref);
+    double maxErr = 0, peak = 0;
+    for (unsigned k = 1; k < n / 2; k++) {
+      maxErr = fmax(maxErr, fabs(buf[k] - ref[k]));
+      peak = fmax(peak, ref[k]);
+    }
+    char msg[96];
+    snprintf(msg, sizeof(msg), "N=%u: peak %.0f, max error %.1f", n, peak, maxErr);
+    TEST_MESSAGE(msg);
+    TEST_ASSERT_TRUE(maxErr < 4.0 + peak * 0.01);
+  }
+}
+
+// recorded signal from a WAV file: fixed-point bins follow the double precision DFT in every frame
+void test_wav_fixture(void) {
+  static int16_t wav[4096], buf[1024];
+  static double ref[512];
+  uint32_t rate = 0;
+  const size_t n = loadWav(fixturePath("tones.wav").c_str(), wav, 4096, rate);
+  TEST_ASSERT_EQUAL_MESSAGE(4096, n, "tones.wav not found or not 16 bit PCM");
+  TEST_ASSERT_EQUAL(SAMPLE_RATE, rate);
+  const uint16_t sizes[] = {512, 1024};
+  AudioFixedFFT fft;
+  char msg[112];
+  for (uint16_t size : sizes) {
+    TEST_ASSERT_TRUE(fft.init(size, AudioFixedFFT::BLACKMAN_HARRIS));
+    double worst = 0;
+    for (size_t offset = 0; offset + size <= n; offset += size) {
+      memcpy(buf, wav + offset, size * sizeof(int16_t));
+      fft.compute(buf);
+      referenceDFT(wav + offset, size, ref);
+      double maxErr = 0, peak = 0;
+      unsigned peakBin = 1;
+      for (unsigned k = 1; k < size / 2; k++) {
+        maxErr = fmax(maxErr, fabs(buf[k] - ref[k]));
+        if (ref[k] > peak) { peak = ref[k]; peakBin = k; }
+      }
+      TEST_ASSERT_TRUE(maxErr < 4.0 + peak * 0.01);
+      TEST_ASSERT_FLOAT_WITHIN(1.0f, 440.0f * size / SAMPLE_RATE, float(peakBin)); // strongest tone
+      unsigned fixedPeak = 1;
+      for (unsigned k = 1; k < size / 2; k++) if (buf[k] > buf[fixedPeak]) fixedPeak = k;
+      TEST_ASSERT_UINT_WITHIN(1, peakBin, fixedPeak);
+      worst = fmax(worst, maxErr / fmax(peak, 1.0));
+    }
+    snprintf(msg, sizeof(msg), "tones.wav N=%u: max error %.2f%% of peak", size, worst * 100.0);
+    TEST_MESSAGE(msg);
+  }
+}
+
+// full scale input does not overflow
+void test_full_scale(void) {
+  AudioFixedFFT fft;
+  static int16_t buf[1024];
+  TEST_ASSERT_TRUE(fft.init(1024, AudioFixedFFT::BLACKMAN_HARRIS));
+  for (unsigned i = 0; i < 1024; i++) buf[i] = (i & 1) ? 32767 : -32768; // Nyquist square wave
+  fft.compute(buf);
+  for (unsigned k = 0; k < 512; k++) TEST_ASSERT_TRUE(buf[k] >= 0);
+  sine(buf, 1024, 1000.0f, 32767.0f);
+  fft.compute(buf);
+  unsigned peak = 1;
+  for (unsigned k = 1; k < 512; k++) if (buf[k] > buf[peak]) peak = k;
+  TEST_ASSERT_FLOAT_WITHIN(1.0f, 1000.0f * 1024 / SAMPLE_RATE, float(peak));
+}
+
+// GEQ bands cover the same frequencies for every FFT size, are ordered and stay inside the spectrum
+void test_geq_map(void) {
+  AudioGEQMap ref, map;
+  ref.build(512, SAMPLE_RATE);
+  TEST_ASSERT_EQUAL(1, ref.bands[0].from);
+  TEST_ASSERT_EQUAL(215, ref.bands[15].to);
+  const uint16_t sizes[] = {256, 512, 1024};
+  for (uint16_t n : sizes) {
+    map.build(n, SAMPLE_RATE);
+    const float binHz = float(SAMPLE_RATE) / n;
+    for (int bp = 0; bp < 2; bp++) {
+      const AudioGEQBand *b = map.get(bp);
+      for (unsigned i = 0; i < AUDIO_ENGINE_GEQ_CHANNELS; i++) {
+        TEST_ASSERT_TRUE(b[i].from >= 1 && b[i].from <= b[i].to && b[i].to < n / 2);
+        if (i) TEST_ASSERT_TRUE(b[i].from >= b[i-1].from);
+      }
+    }
+    // centre of the 1kHz channel stays within one bin width of the reference
+    const float refHz = (ref.bands[7].from + ref.bands[7].to) * 0.5f * (float(SAMPLE_RATE) / 512);
+    TEST_ASSERT_FLOAT_WITHIN(binHz, refHz, (map.bands[7].from + map.bands[7].to) * 0.5f * binHz);
+  }
+}
+
+void test_stats(void) {
+  AudioAnalysisStats stats;
+  for (uint32_t t = 1; t <= 2000; t += 10) stats.frameDone(t); // 100 frames per second
+  TEST_ASSERT_EQUAL(200, stats.frames);
+  TEST_ASSERT_UINT_WITHIN(2, 100, stats.fps);
+  for (int i = 0; i < 50; i++) stats.addTime(AudioAnalysisStats::FFT, 1000);
+  TEST_ASSERT_UINT_WITHIN(10, 1000, stats.stageTime[AudioAnalysisStats::FFT]);
+  TEST_ASSERT_EQUAL(stats.stageTime[AudioAnalysisStats::FFT], stats.processingTime() - stats.stageTime[AudioAnalysisStats::SAMPLING]);
+}
+
+// CPU cost per FFT and resulting analysis rate with 50% overlap (host, relative numbers only)
+void test_benchmark(void) {
+  const uint16_t sizes[] = {256, 512, 1024};
+  AudioFixedFFT fft;
+  static int16_t in[1024], buf[1024];
+  for (unsigned i = 0; i < 1024; i++) in[i] = int16_t(nextRandom());
+  char msg[160];
+  for (uint16_t n : sizes) {
+    fft.init(n, AudioFixedFFT::BLACKMAN_HARRIS);
+    const unsigned runs = 20000;
+    volatile int sink = 0;
+    const double t0 = hostSeconds();
+    for (unsigned r = 0; r < runs; r++) {
+      memcpy(buf, in, n * sizeof(int16_t));
+      fft.compute(buf);
+      sink = sink + buf[r % (n / 2)];
+    }
+    const double us = (hostSeconds() - t0) * 1e6 / runs;
+    snprintf(msg, sizeof(msg), "N=%4u: %.2f us per FFT, %.1f frames/s without and %.1f with 50%% overlap",
+             n, us, double(SAMPLE_RATE) / n, 2.0 * SAMPLE_RATE / n);
+    TEST_MESSAGE(msg);
+  }
+}
+
+int main(void) {
+  UNITY_BEGIN();
+  RUN_TEST(test_init_sizes);
+  RUN_TEST(test_isqrt);
+  RUN_TEST(test_sine_peak);
+  RUN_TEST(test_matches_reference);
+  RUN_TEST(test_wav_fixture);
+  RUN_TEST(test_full_scale);
+  RUN_TEST(test_geq_map);
+  RUN_TEST(test_stats);
+  RUN_TEST(test_benchmark);
+  return UNITY_END();
+}
@@ -0,0 +1,235 @@
+// ring of audio feature frames (wled00/audio_frames.h): snapshots, history and a concurrent producer
+#include <unity.h>
+#include <stdio.h>
+#include <thread>
+#include <atomic>
+#include <math.h>
+#include "wled_host.h"
+#include "audio_frames.h"
+#include "../../usermods/audioreactive/audio_engine.h"
+
+static AudioFrame makeFrame(uint32_t n) {
+  AudioFrame f;
+  f.timestamp  = n * 21;
+  f.seq        = 0;
+  f.volumeSmth = n;
+  f.majorPeak  = n * 2;
+  f.magnitude  = n * 3;
+  f.volumeRaw  = int16_t(n);
+  f.samplePeak = n & 1;
+  f.onset      = uint8_t(n);
+  for (int i = 0; i < AUDIO_FRAME_GEQ_CHANNELS; i++) f.fftResult[i] = uint8_t(n + i);
+  return f;
+}
+
+// all fields derive from the timestamp: a torn frame mixes two cycles
+static bool consistent(const AudioFrame &f) {
+  const uint32_t n = f.timestamp / 21;
+  if (f.timestamp != n * 21 || f.volumeSmth != float(n) || f.majorPeak != float(n * 2) || f.magnitude != float(n * 3)) return false;
+  if (f.volumeRaw != int16_t(n) || f.samplePeak != (n & 1) || f.onset != uint8_t(n)) return false;
+  for (int i = 0; i < AUDIO_FRAME_GEQ_CHANNELS; i++) if (f.fftResult[i] != uint8_t(n + i)) return false;
+  return true;
+}
+
+void setUp(void) {}
+void tearDown(void) {}
+
+void test_empty(void) {
+  AudioFrameRing<8> ring;
+  AudioFrame f;
+  TEST_ASSERT_EQUAL(0, ring.count());
+  TEST_ASSERT_FALSE(ring.get(f));
+  TEST_ASSERT_EQUAL(0, ring.history(&f, 1));
+}
+
+// latest frame and older frames by age, seq numbers set by the ring
+void test_get_by_age(void) {
+  AudioFrameRing<8> ring;
+  for (uint32_t n = 0; n < 5; n++) ring.push(makeFrame(n));
+  AudioFrame f;
+  TEST_ASSERT_TRUE(ring.get(f));
+  TEST_ASSERT_EQUAL(4, f.seq);
+  TEST_ASSERT_EQUAL(4 * 21, f.timestamp);
+  TEST_ASSERT_TRUE(ring.get(f, 4));
+  TEST_ASSERT_EQUAL(0, f.seq);
+  TEST_ASSERT_FALSE(ring.get(f, 5));
+}
+
+// after wrapping only size() frames are available, history is newest first and consecutive
+void test_history_wraps(void) {
+  AudioFrameRing<8> ring;
+  for (uint32_t n = 0; n < 100; n++) ring.push(makeFrame(n));
+  TEST_ASSERT_EQUAL(100, ring.count());
+  AudioFrame h[16];
+  const size_t got = ring.history(h, 16);
+  TEST_ASSERT_EQUAL(ring.size(), got);
+  for (size_t i = 0; i < got; i++) {
+    TEST_ASSERT_EQUAL(99 - i, h[i].seq);
+    TEST_ASSERT_TRUE(consistent(h[i]));
+  }
+  TEST_ASSERT_FALSE(ring.get(h[0], ring.size()));
+}
+
+// producer thread (FFT task) and consumer thread (effects): no torn frames, no gaps in histories
+void test_concurrent_producer(void) {
+  static AudioFrames ring;
+  std::atomic<bool> done{false};
+  std::thread producer([&]() {
+    for (uint32_t n = 0; n < 400000; n++) ring.push(makeFrame(n));
+    done = true;
+  });
+  unsigned reads = 0, histories = 0;
+  uint32_t lastSeq = 0;
+  AudioFrame h[8];
+  while (!done) {
+    AudioFrame f;
+    if (ring.get(f)) {
+      TEST_ASSERT_TRUE_MESSAGE(consistent(f), "torn frame");
+      TEST_ASSERT_TRUE(f.seq >= lastSeq);  // never goes back in time
+      TEST_ASSERT_EQUAL(f.seq, f.timestamp / 21);
+      lastSeq = f.seq;
+      reads++;
+    }
+    const size_t got = ring.history(h, 8);
+    for (size_t i = 0; i < got; i++) {
+      TEST_ASSERT_TRUE_MESSAGE(consistent(h[i]), "torn frame in history");
+      if (i) TEST_ASSERT_EQUAL(h[i-1].seq - 1, h[i].seq);
+    }
+    if (got) histories++;
+  }
+  producer.join();
+  TEST_ASSERT_GREATER_THAN(0, reads);
+  char msg[96];
+  snprintf(msg, sizeof(msg), "%u snapshots, %u histories read while producing", reads, histories);
+  TEST_MESSAGE(msg);
+}
+
+// signal driven pipeline: blocks of samples (sine, noise, beat) -> analysis -> ring (producer thread) -> effects (consumer)
+#define SAMPLE_RATE   22050
+#define BLOCK         512
+#define SIGNAL_PERIOD 600   // blocks: 200 sine, 200 noise, 200 beat
+
+static AudioFixedFFT fft;
+static AudioGEQMap   geqMap;
+
+// block n of the test signal (periodic, noise is seeded by the block number)
+static void signalBlock(uint32_t n, int16_t *buf) {
+  const uint32_t b = n % SIGNAL_PERIOD;
+  uint32_t x = b * 2654435761U + 1;
+  for (unsigned i = 0; i < BLOCK; i++) {
+    float v = 0;
+    if (b < 200) v = 10000.0f * sinf(2.0f * float(M_PI) * (200.0f + 50.0f * (b % 40)) * i / SAMPLE_RATE); // sine, 200-2150Hz
+    else if (b < 400) { x ^= x << 13; x ^= x >> 17; x ^= x << 5; v = float(int32_t(x % 16001) - 8000); }  // white noise
+    else if ((b - 400) % 20 == 10) v = 24000.0f * expf(-float(i) / 120.0f) * sinf(2.0f * float(M_PI) * 80.0f * i / SAMPLE_RATE); // kick every 20 blocks
+    else v = 200.0f * sinf(2.0f * float(M_PI) * 440.0f * i / SAMPLE_RATE); // quiet between beats
+    buf[i] = int16_t(lroundf(v));
+  }
+}
+
+static int16_t blockPeak(uint32_t n) {
+  int16_t buf[BLOCK];
+  signalBlock(n, buf);
+  int peak = 0;
+  for (unsigned i = 0; i < BLOCK; i++) peak = std::max(peak, abs(buf[i]));
+  return peak;
+}
+
+// simplified FFT cycle of the AudioReactive usermod (FFTcode(), publishFFTFrame()) on block n
+static AudioFrame analyze(uint32_t n) {
+  static int16_t buf[BLOCK];
+  signalBlock(n, buf);
+  AudioFrame f;
+  memset(&f, 0, sizeof(f));
+  long sumAbs = 0;
+  for (unsigned i = 0; i < BLOCK; i++) sumAbs += abs(buf[i]);
+  const int16_t peakAbs = blockPeak(n), lastPeak = blockPeak(n + SIGNAL_PERIOD - 1);
+  fft.compute(buf);
+  unsigned peak = 1;
+  for (unsigned k = 2; k < BLOCK / 2; k++) if (buf[k] > buf[peak]) peak = k;
+  f.timestamp  = n * 23;
+  f.volumeSmth = float(sumAbs) / BLOCK;
+  f.volumeRaw  = peakAbs;
+  f.majorPeak  = float(peak) * SAMPLE_RATE / BLOCK;
+  f.magnitude  = buf[peak];
+  f.samplePeak = peakAbs > 4 * lastPeak && peakAbs > 8000;
+  f.onset      = std::min(255, std::max(0, (peakAbs - lastPeak) >> 6));
+  for (unsigned c = 0; c < AUDIO_FRAME_GEQ_CHANNELS; c++) {
+    const AudioGEQBand &band = geqMap.bands[c];
+    long sum = 0;
+    for (unsigned k = band.from; k <= band.to; k++) sum += buf[k];
+    f.fftResult[c] = std::min(255L, sum / (band.to - band.from + 1) / 4);
+  }
+  return f;
+}
+
+// frame equals the analysis of its block (expected: frame of the same block in the first signal period)
+static bool matches(const AudioFrame &f, const AudioFrame &expected) {
+  if (f.timestamp != f.seq * 23) return false;
+  AudioFrame a = f, b = expected;
+  a.seq = b.seq = a.timestamp = b.timestamp = 0;
+  return memcmp(&a, &b, sizeof(AudioFrame)) == 0;
+}
+
+void test_signal_pipeline(void) {
+  TEST_ASSERT_TRUE(fft.init(BLOCK, AudioFixedFFT::BLACKMAN_HARRIS));
+  geqMap.build(BLOCK, SAMPLE_RATE);
+  static AudioFrame expected[SIGNAL_PERIOD];
+  for (uint32_t n = 0; n < SIGNAL_PERIOD; n++) expected[n] = analyze(n);
+  // the features describe the signal: sine peak frequency, broadband noise, beats
+  for (uint32_t n = 0; n < 200; n++) TEST_ASSERT_FLOAT_WITHIN(float(SAMPLE_RATE) / BLOCK, 200.0f + 50.0f * (n % 40), expected[n].majorPeak);
+  for (uint32_t n = 200; n < 400; n++) {
+    unsigned lit = 0;
+    for (unsigned c = 0; c < AUDIO_FRAME_GEQ_CHANNELS; c++) lit += expected[n].fftResult[c] > 0;
+    TEST_ASSERT_GREATER_OR_EQUAL(14, lit);
+  }
+  for (uint32_t n = 400; n < SIGNAL_PERIOD; n++) {
+    const bool beat = (n - 400) % 20 == 10;
+    TEST_ASSERT_EQUAL(beat, expected[n].samplePeak);
+    if (beat) TEST_ASSERT_GREATER_THAN(100, expected[n].onset);
+  }
+
+  static AudioFrames ring;
+  const uint32_t blocks = 20000;
+  std::atomic<bool> done{false};
+  std::thread producer([&]() {
+    for (uint32_t n = 0; n < blocks; n++) ring.push(analyze(n));
+    done = true;
+  });
+  unsigned reads = 0, mismatches = 0, seen = 0, beats = 0;
+  uint32_t lastSeq = UINT32_MAX;
+  AudioFrame h[8];
+  while (!done) {
+    AudioFrame f;
+    if (ring.get(f)) {
+      if (!matches(f, expected[f.seq % SIGNAL_PERIOD])) mismatches++;
+      if (f.seq != lastSeq) { seen++; beats += f.samplePeak; lastSeq = f.seq; }
+      reads++;
+    }
+    const size_t got = ring.history(h, 8);
+    for (size_t i = 0; i < got; i++) if (!matches(h[i], expected[h[i].seq % SIGNAL_PERIOD])) mismatches++;
+  }
+  producer.join();
+  TEST_ASSERT_EQUAL_MESSAGE(0, mismatches, "torn or wrong frames");
+  TEST_ASSERT_GREATER_THAN(0, reads);
+  // the consumer sees the latest frames after the producer stopped
+  AudioFrame last[8];
+  TEST_ASSERT_EQUAL(8, ring.history(last, 8));
+  for (unsigned i = 0; i < 8; i++) {
+    TEST_ASSERT_EQUAL(blocks - 1 - i, last[i].seq);
+    TEST_ASSERT_TRUE(matches(last[i], expected[last[i].seq % SIGNAL_PERIOD]));
+  }
+  fft.end();
+  char msg[128];
+  snprintf(msg, sizeof(msg), "%u blocks analysed, %u frames read (%u different, %u beats)", blocks, reads, seen, beats);
+  TEST_MESSAGE(msg);
+}
+
+int main(void) {
+  UNITY_BEGIN();
+  RUN_TEST(test_empty);
+  RUN_TEST(test_get_by_age);
+  RUN_TEST(test_history_wraps);
+  RUN_TEST(test_concurrent_producer);
+  RUN_TEST(test_signal_pipeline);
+  return UNITY_END();
+}
@@ -0,0 +1,188 @@
+// V3 audio sync format and receive jitter buffer (usermods/audioreactive/audio_sync.h): loopback with loss and reordering
+#include <unity.h>
+#include <stdio.h>
+#include <math.h>
+#include "wled_host.h"
+#include "../../usermods/audioreactive/audio_sync.h"
+
+#define CYCLE 21  // ms per analysis cycle (512 samples at 22kHz)
+
+static uint32_t rnd = 1;
+static uint32_t nextRandom() { rnd ^= rnd << 13; rnd ^= rnd >> 17; rnd ^= rnd << 5; return rnd; }
+
+// sender side: smooth ramps so interpolation errors are measurable
+static AudioSyncFrame senderFrame(uint16_t seq) {
+  AudioSyncFrame f;
+  f.seq        = seq;
+  f.timestamp  = 100000 + seq * CYCLE;
+  f.sampleRaw  = float(seq % 200);
+  f.sampleSmth = seq * 0.05f;  // linear ramp over the whole test (fits 8.8 fixed point)
+  f.magnitude  = 1000.0f + seq;
+  f.majorPeak  = 440.0f;
+  f.samplePeak = (seq % 25) == 0;
+  for (int c = 0; c < AUDIOSYNC_GEQ_CHANNELS; c++) f.fftResult[c] = uint8_t((seq + c * 8) % 200);
+  return f;
+}
+
+void setUp(void) { rnd = 1; }
+void tearDown(void) {}
+
+void test_encode_decode(void) {
+  AudioSyncFrame in[AUDIOSYNC_V3_MAX_FRAMES], out[AUDIOSYNC_V3_MAX_FRAMES];
+  for (int i = 0; i < AUDIOSYNC_V3_MAX_FRAMES; i++) in[i] = senderFrame(500 - i);
+  in[0].sampleSmth = 123.45f;
+  in[0].magnitude  = 98765.4f;
+  uint8_t buf[AUDIOSYNC_V3_MAX_PACKET];
+  const size_t len = AudioSyncV3::encode(buf, sizeof(buf), in, AUDIOSYNC_V3_MAX_FRAMES);
+  TEST_ASSERT_GREATER_THAN(0, len);
+  TEST_ASSERT_TRUE((len - sizeof(audioSyncHeader_v3)) / AUDIOSYNC_V3_MAX_FRAMES < 44); // a frame is smaller than a V2 packet
+  TEST_ASSERT_EQUAL(AUDIOSYNC_V3_MAX_FRAMES, AudioSyncV3::decode(buf, len, out, AUDIOSYNC_V3_MAX_FRAMES));
+  for (int i = 0; i < AUDIOSYNC_V3_MAX_FRAMES; i++) {
+    TEST_ASSERT_EQUAL(in[i].seq, out[i].seq);
+    TEST_ASSERT_EQUAL(in[i].timestamp, out[i].timestamp);
+    TEST_ASSERT_EQUAL(in[i].samplePeak, out[i].samplePeak);
+    TEST_ASSERT_FLOAT_WITHIN(1.0f / 256, in[i].sampleRaw, out[i].sampleRaw);
+    TEST_ASSERT_FLOAT_WITHIN(1.0f / 256, in[i].sampleSmth, out[i].sampleSmth);
+    TEST_ASSERT_FLOAT_WITHIN(in[i].magnitude / 128, in[i].magnitude, out[i].magnitude); // bfloat16: 8 bit mantissa
+    TEST_ASSERT_EQUAL_MEMORY(in[i].fftResult, out[i].fftResult, AUDIOSYNC_GEQ_CHANNELS);
+  }
+  // too small buffer, truncated and foreign packets
+  TEST_ASSERT_EQUAL(0, AudioSyncV3::encode(buf, len - 1, in, AUDIOSYNC_V3_MAX_FRAMES));
+  TEST_ASSERT_EQUAL(0, AudioSyncV3::decode(buf, len - 1, out, AUDIOSYNC_V3_MAX_FRAMES));
+  TEST_ASSERT_FALSE(AudioSyncV3::isValid((const uint8_t*)"00002\0xxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxx", 44)); // V2 packet
+}
+
+// 32 channel GEQ packets are decoded into 16 channels (louder of each pair)
+void test_geq32(void) {
+  uint8_t buf[AUDIOSYNC_V3_MAX_PACKET];
+  audioSyncHeader_v3 hdr;
+  memset(&hdr, 0, sizeof(hdr));
+  memcpy(hdr.header, AUDIOSYNC_V3_HEADER, sizeof(AUDIOSYNC_V3_HEADER));
+  hdr.flags = AUDIOSYNC_V3_FLAG_GEQ32;
+  hdr.frames = 1;
+  hdr.seq = 7;
+  hdr.timestamp = 1000;
+  audioSyncFrame_v3 fr;
+  memset(&fr, 0, sizeof(fr));
+  memcpy(buf, &hdr, sizeof(hdr));
+  memcpy(buf + sizeof(hdr), &fr, sizeof(fr));
+  uint8_t *geq = buf + sizeof(hdr) + sizeof(fr);
+  for (int c = 0; c < 2 * AUDIOSYNC_GEQ_CHANNELS; c++) geq[c] = (c & 1) ? c : 100 - c;
+  AudioSyncFrame out;
+  TEST_ASSERT_EQUAL(1, AudioSyncV3::decode(buf, sizeof(hdr) + sizeof(fr) + 2 * AUDIOSYNC_GEQ_CHANNELS, &out, 1));
+  for (int c = 0; c < AUDIOSYNC_GEQ_CHANNELS; c++) TEST_ASSERT_EQUAL(geq[2*c] > geq[2*c+1] ? geq[2*c] : geq[2*c+1], out.fftResult[c]);
+}
+
+// sender bundles frames, network drops and reorders packets and adds jitter; the receiver plays out every cycle
+static void loopback(unsigned lossPercent, unsigned reorderPercent, unsigned jitterMs,
+                     unsigned &played, unsigned &gaps, unsigned &off, float &maxErr, uint32_t &lost, unsigned &peaks) {
+  const unsigned cycles = 3000;
+  AudioSyncJitterBuffer jb;
+  AudioSyncFrame history[AUDIOSYNC_V3_MAX_FRAMES];
+  unsigned historyCount = 0;
+  struct Packet { uint32_t arrival; size_t len; uint8_t data[AUDIOSYNC_V3_MAX_PACKET]; };
+  static Packet inFlight[64];
+  unsigned numInFlight = 0;
+  played = gaps = off = peaks = 0;
+  maxErr = 0;
+  const uint32_t localStart = 5000; // receiver clock is unrelated to the sender's
+  for (uint32_t now = localStart; now < localStart + cycles * CYCLE; now++) {
+    const uint32_t senderNow = now - localStart + 100000;
+    // sender: one packet per cycle with the previous frames repeated
+    if ((senderNow - 100000) % CYCLE == 0) {
+      memmove(&history[1], &history[0], (AUDIOSYNC_V3_MAX_FRAMES - 1) * sizeof(AudioSyncFrame));
+      history[0] = senderFrame((senderNow - 100000) / CYCLE);
+      if (historyCount < AUDIOSYNC_V3_MAX_FRAMES) historyCount++;
+      if (nextRandom() % 100 >= lossPercent && numInFlight < 64) {
+        Packet &p = inFlight[numInFlight++];
+        p.len = AudioSyncV3::encode(p.data, sizeof(p.data), history, historyCount);
+        p.arrival = now + 2 + nextRandom() % (jitterMs + 1) + ((nextRandom() % 100 < reorderPercent) ? CYCLE + 5 : 0);
+      }
+    }
+    // network: deliver packets whose arrival time has come (in any order)
+    for (unsigned i = 0; i < numInFlight; ) {
+      if (int32_t(now - inFlight[i].arrival) >= 0) {
+        AudioSyncFrame frames[AUDIOSYNC_V3_MAX_FRAMES];
+        const unsigned n = AudioSyncV3::decode(inFlight[i].data, inFlight[i].len, frames, AUDIOSYNC_V3_MAX_FRAMES);
+        for (unsigned f = 0; f < n; f++) jb.push(frames[f], now);
+        inFlight[i] = inFlight[--numInFlight];
+      } else i++;
+    }
+    // receiver: usermod loop runs every ~8ms
+    if (now % 8 == 0 && now > localStart + 200) {
+      AudioSyncFrame out;
+      if (jb.get(now, out)) {
+        played++;
+        peaks += out.samplePeak ? 1 : 0;
+        // expected value on the sender time line
+        const float pos = float(out.timestamp - 100000) / CYCLE;
+        const float err = fabsf(out.sampleSmth - pos * 0.05f);
+        if (err > 0.01f) off++;  // held frame (no newer frame received yet)
+        maxErr = fmaxf(maxErr, err);
+      } else gaps++;
+    }
+  }
+  lost = jb.lost;
+}
+
+void test_loopback_clean(void) {
+  unsigned played, gaps, off, peaks; float maxErr; uint32_t lost;
+  loopback(0, 0, 5, played, gaps, off, maxErr, lost, peaks);
+  TEST_ASSERT_EQUAL(0, gaps);
+  TEST_ASSERT_EQUAL(0, lost);
+  TEST_ASSERT_EQUAL(0, off);
+  TEST_ASSERT_TRUE(maxErr < 0.01f);
+  TEST_ASSERT_UINT_WITHIN(2, 3000 / 25, peaks); // every peak is delivered exactly once
+}
+
+// 20% loss, 10% reordering, 15ms jitter: bundles recover almost all frames, held frames stay close to the sender
+void test_loopback_loss_reorder(void) {
+  unsigned played, gaps, off, peaks; float maxErr; uint32_t lost;
+  loopback(20, 10, 15, played, gaps, off, maxErr, lost, peaks);
+  char msg[128];
+  snprintf(msg, sizeof(msg), "20%% loss, 10%% reordered: %u played, %u held, %u gaps, %u frames lost, max error %.3f", played, off, gaps, (unsigned)lost, maxErr);
+  TEST_MESSAGE(msg);
+  TEST_ASSERT_EQUAL(0, gaps);
+  TEST_ASSERT_TRUE(lost < 30);        // 1%: four packets in a row lost, or reordered beyond the playout delay
+  TEST_ASSERT_TRUE(off * 100 < played * 20); // a frame that was only received with the next bundle can arrive after its playout time
+  TEST_ASSERT_TRUE(maxErr < 0.05f * AUDIOSYNC_MAX_HOLD / CYCLE);
+  TEST_ASSERT_UINT_WITHIN(4, 3000 / 25, peaks);
+}
+
+// heavy loss: lost frames are bridged by interpolation, output keeps following the sender
+void test_loopback_heavy_loss(void) {
+  unsigned played, gaps, off, peaks; float maxErr; uint32_t lost;
+  loopback(60, 20, 15, played, gaps, off, maxErr, lost, peaks);
+  char msg[128];
+  snprintf(msg, sizeof(msg), "60%% loss, 20%% reordered: %u played, %u held, %u gaps, %u frames lost, max error %.3f", played, off, gaps, (unsigned)lost, maxErr);
+  TEST_MESSAGE(msg);
+  TEST_ASSERT_GREATER_THAN(0, lost);
+  TEST_ASSERT_TRUE(gaps * 20 < played); // less than 5% of the loop runs without data
+  TEST_ASSERT_TRUE(off * 100 < played * 60); // ramp is linear: interpolated gaps stay on it, only held frames are off
+  TEST_ASSERT_TRUE(maxErr < 0.05f * AUDIOSYNC_MAX_HOLD / CYCLE);
+}
+
+// no more data: last frame is held for AUDIOSYNC_MAX_HOLD, then the receiver reports no data
+void test_hold_and_stop(void) {
+  AudioSyncJitterBuffer jb;
+  for (uint16_t s = 0; s < 5; s++) jb.push(senderFrame(s), 1000 + s * CYCLE);
+  AudioSyncFrame out;
+  const uint32_t last = 1000 + 4 * CYCLE + AUDIOSYNC_JITTER_DELAY;
+  TEST_ASSERT_TRUE(jb.get(last + 10, out));
+  TEST_ASSERT_TRUE(jb.get(last + AUDIOSYNC_MAX_HOLD, out));
+  TEST_ASSERT_FALSE(jb.get(last + AUDIOSYNC_MAX_HOLD + 1, out));
+  // duplicates are counted but not played twice
+  jb.push(senderFrame(4), last + 300);
+  TEST_ASSERT_GREATER_THAN(0, jb.duplicates);
+}
+
+int main(void) {
+  UNITY_BEGIN();
+  RUN_TEST(test_encode_decode);
+  RUN_TEST(test_geq32);
+  RUN_TEST(test_loopback_clean);
+  RUN_TEST(test_loopback_loss_reorder);
+  RUN_TEST(test_loopback_heavy_loss);
+  RUN_TEST(test_hold_and_stop);
+  return UNITY_END();
+}
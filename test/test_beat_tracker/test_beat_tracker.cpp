@@ -0,0 +1,191 @@
+// onset detection and tempo tracking (usermods/audioreactive/audio_engine.h) on synthetic labelled clips
+#include <unity.h>
+#include <stdio.h>
+#include <math.h>
+#include "wled_host.h"
+#include "../../usermods/audioreactive/audio_engine.h"
+
+#define SAMPLE_RATE 22050
+#define FFT_SIZE    512
+#define HOP         (FFT_SIZE / 2)   // 50% overlap
+#define CLIP_SECS   20
+
+static uint32_t rnd = 1;
+static uint32_t nextRandom() { rnd ^= rnd << 13; rnd ^= rnd >> 17; rnd ^= rnd << 5; return rnd; }
+static float noise() { return float(int32_t(nextRandom())) / 2147483648.0f; }
+
+// labelled clip: kick on every beat, hi-hat on off-beats, optional snare on 2 and 4, sustained chord underneath
+struct Clip {
+  float    bpm;
+  bool     offbeats;
+  bool     snare;
+  int16_t *samples;
+  unsigned length;
+  float    beats[CLIP_SECS * 4];   // labels: beat times
+  unsigned numBeats;
+  float    events[CLIP_SECS * 8];  // labels: all percussive events (beats and hi-hats)
+  unsigned numEvents;
+};
+
+static void render(Clip &clip) {
+  clip.length  = SAMPLE_RATE * CLIP_SECS;
+  clip.samples = (int16_t*)malloc(clip.length * sizeof(int16_t));
+  clip.numBeats = 0;
+  const float beatLen = 60.0f / clip.bpm;
+  for (unsigned i = 0; i < clip.length; i++) {
+    const float t = float(i) / SAMPLE_RATE;
+    const unsigned beat = unsigned(t / beatLen);
+    const float tb = t - beat * beatLen;            // time since beat
+    const float to = tb - beatLen / 2;              // time since off-beat
+    float v = 0.1f * (sinf(2 * float(M_PI) * 220.0f * t) + sinf(2 * float(M_PI) * 440.0f * t) + sinf(2 * float(M_PI) * 660.0f * t)); // sustained tone with harmonics
+    v += 0.9f * expf(-tb * 25.0f) * sinf(2 * float(M_PI) * (50.0f + 80.0f * expf(-tb * 40.0f)) * tb);  // kick
+    if (clip.offbeats && to >= 0) v += 0.25f * expf(-to * 60.0f) * noise();                     // hi-hat
+    if (clip.snare && (beat & 1)) v += 0.4f * expf(-tb * 20.0f) * (noise() + sinf(2 * float(M_PI) * 190.0f * tb));
+    v += 0.02f * noise();
+    clip.samples[i] = int16_t(lroundf(fmaxf(-1.0f, fminf(1.0f, v * 0.6f)) * 20000.0f));
+  }
+  clip.numEvents = 0;
+  for (float t = 0; t < CLIP_SECS && clip.numBeats < CLIP_SECS * 4; t += beatLen) {
+    clip.beats[clip.numBeats++] = clip.events[clip.numEvents++] = t;
+    if (clip.offbeats) clip.events[clip.numEvents++] = t + beatLen / 2;
+  }
+}
+
+struct Result {
+  float    bpm;          // tempo at the end of the clip
+  uint8_t  confidence;
+  unsigned onsets;
+  unsigned hits;         // onsets within 70ms of a labelled event
+  unsigned beatsFound;   // labelled beats with an onset within 70ms
+  double   usPerFrame;   // CPU time of the tracker
+};
+
+// average of the FFT bins of each GEQ channel, 0..1023 (fftCalc[] before smoothing and scaling)
+static void geqChannels(const int16_t *bins, const AudioGEQMap &map, uint16_t *channels) {
+  for (unsigned c = 0; c < AUDIO_ENGINE_GEQ_CHANNELS; c++) {
+    const AudioGEQBand &b = map.bands[c];
+    uint32_t sum = 0;
+    for (unsigned k = b.from; k <= b.to; k++) sum += bins[k];
+    const uint32_t v = uint32_t(sum * b.gain) / (b.to - b.from + 1);
+    channels[c] = v > 1023 ? 1023 : v;
+  }
+}
+
+// analysis pipeline as in the FFT task: FFT with 50% overlap, GEQ channels, tracker
+static Result analyse(const Clip &clip) {
+  AudioFixedFFT fft;
+  fft.init(FFT_SIZE, AudioFixedFFT::BLACKMAN_HARRIS);
+  AudioGEQMap map;
+  map.build(FFT_SIZE, SAMPLE_RATE);
+  AudioBeatTracker tracker;
+  const float frameRate = float(SAMPLE_RATE) / HOP;
+  tracker.init(frameRate);
+  Result r = {};
+  static float onsetTimes[CLIP_SECS * 16];
+  double trackTime = 0;
+  unsigned frames = 0;
+  int16_t buf[FFT_SIZE];
+  for (unsigned pos = 0; pos + FFT_SIZE <= clip.length; pos += HOP, frames++) {
+    memcpy(buf, clip.samples + pos, sizeof(buf));
+    fft.compute(buf);
+    uint16_t channels[AUDIO_ENGINE_GEQ_CHANNELS];
+    geqChannels(buf, map, channels);
+    const double t0 = hostSeconds();
+    tracker.process(channels, AUDIO_ENGINE_GEQ_CHANNELS);
+    trackTime += hostSeconds() - t0;
+    if (tracker.onset && r.onsets < CLIP_SECS * 16) {
+      onsetTimes[r.onsets++] = float(pos + FFT_SIZE) / SAMPLE_RATE - 1.0f / frameRate; // onset belongs to the previous frame
+    }
+  }
+  r.bpm = tracker.bpm;
+  r.confidence = tracker.confidence;
+  r.usPerFrame = trackTime * 1e6 / frames;
+  // onsets can lag the beat by up to one analysis window
+  const float latency = float(FFT_SIZE) / SAMPLE_RATE;
+  for (unsigned i = 0; i < r.onsets; i++) {
+    for (unsigned e = 0; e < clip.numEvents; e++) if (onsetTimes[i] >= clip.events[e] - 0.07f && onsetTimes[i] <= clip.events[e] + latency + 0.07f) { r.hits++; break; }
+  }
+  for (unsigned b = 0; b < clip.numBeats; b++) {
+    for (unsigned i = 0; i < r.onsets; i++) if (onsetTimes[i] >= clip.beats[b] - 0.07f && onsetTimes[i] <= clip.beats[b] + latency + 0.07f) { r.beatsFound++; break; }
+  }
+  return r;
+}
+
+void setUp(void) { rnd = 1; }
+void tearDown(void) {}
+
+void test_silence_and_steady_tone(void) {
+  AudioBeatTracker tracker;
+  tracker.init(float(SAMPLE_RATE) / HOP);
+  uint16_t channels[AUDIO_ENGINE_GEQ_CHANNELS] = {};
+  for (int i = 0; i < 500; i++) tracker.process(channels, AUDIO_ENGINE_GEQ_CHANNELS);
+  TEST_ASSERT_EQUAL(0, tracker.onset);
+  TEST_ASSERT_EQUAL(0, tracker.confidence);
+  // steady tone: no onsets after it started
+  for (auto &c : channels) c = 500;
+  unsigned onsets = 0;
+  for (int i = 0; i < 500; i++) { tracker.process(channels, AUDIO_ENGINE_GEQ_CHANNELS); if (i > 2 && tracker.onset) onsets++; }
+  TEST_ASSERT_EQUAL(0, onsets);
+}
+
+// labelled clips at typical tempos: BPM within 3%, onset precision (vs. all events) and beat recall above 80%
+void test_labelled_clips(void) {
+  const struct { float bpm; bool offbeats; bool snare; } clips[] = {
+    { 90.0f, true,  true}, {100.0f, false, false}, {120.0f, true, false}, {128.0f, true, true}, {140.0f, false, true}, {160.0f, false, false}
+  };
+  char msg[160];
+  double cpu = 0;
+  for (const auto &c : clips) {
+    Clip clip;
+    clip.bpm = c.bpm; clip.offbeats = c.offbeats; clip.snare = c.snare;
+    render(clip);
+    const Result r = analyse(clip);
+    free(clip.samples);
+    const float precision = r.onsets ? float(r.hits) / r.onsets : 0.0f;
+    const float recall    = float(r.beatsFound) / clip.numBeats;
+    snprintf(msg, sizeof(msg), "%5.1f BPM%s%s: detected %6.1f BPM (confidence %3u), onsets %3u, precision %.2f, recall %.2f",
+             c.bpm, c.offbeats ? " +hat" : "", c.snare ? " +snare" : "", r.bpm, r.confidence, r.onsets, precision, recall);
+    TEST_MESSAGE(msg);
+    TEST_ASSERT_FLOAT_WITHIN(c.bpm * 0.03f, c.bpm, r.bpm);
+    TEST_ASSERT_GREATER_THAN(64, r.confidence);
+    TEST_ASSERT_TRUE(precision > 0.8f);
+    TEST_ASSERT_TRUE(recall > 0.8f);
+    cpu += r.usPerFrame;
+  }
+  snprintf(msg, sizeof(msg), "tracker CPU cost: %.2f us per frame (host)", cpu / (sizeof(clips) / sizeof(clips[0])));
+  TEST_MESSAGE(msg);
+}
+
+// beat phase wraps once per beat at the detected tempo
+void test_beat_phase(void) {
+  Clip clip;
+  clip.bpm = 120.0f; clip.offbeats = true; clip.snare = false;
+  render(clip);
+  AudioFixedFFT fft;
+  fft.init(FFT_SIZE, AudioFixedFFT::BLACKMAN_HARRIS);
+  AudioGEQMap map;
+  map.build(FFT_SIZE, SAMPLE_RATE);
+  AudioBeatTracker tracker;
+  tracker.init(float(SAMPLE_RATE) / HOP);
+  unsigned beats = 0, frames = 0;
+  int16_t buf[FFT_SIZE];
+  for (unsigned pos = 0; pos + FFT_SIZE <= clip.length; pos += HOP) {
+    memcpy(buf, clip.samples + pos, sizeof(buf));
+    fft.compute(buf);
+    uint16_t channels[AUDIO_ENGINE_GEQ_CHANNELS];
+    geqChannels(buf, map, channels);
+    tracker.process(channels, AUDIO_ENGINE_GEQ_CHANNELS);
+    if (pos >= SAMPLE_RATE * 10) { frames++; if (tracker.beat) beats++; } // second half: tempo has settled
+  }
+  free(clip.samples);
+  const float seconds = float(frames) * HOP / SAMPLE_RATE;
+  TEST_ASSERT_FLOAT_WITHIN(2.0f, seconds * 2.0f, float(beats)); // 2 beats per second
+}
+
+int main(void) {
+  UNITY_BEGIN();
+  RUN_TEST(test_silence_and_steady_tone);
+  RUN_TEST(test_labelled_clips);
+  RUN_TEST(test_beat_phase);
+  return UNITY_END();
+}
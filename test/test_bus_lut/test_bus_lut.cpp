@@ -0,0 +1,196 @@
+// fused per bus look-up tables of digital buses (wled00/bus_lut.h)
+#include <unity.h>
+#include <stdio.h>
+#include <math.h>
+#include <algorithm>
+#include "wled_host.h"
+#include "bus_lut.h"
+
+static uint8_t gammaT[256];
+static const uint8_t correction[3] = {255, 178, 97}; // white balance of ~2700K
+
+static uint32_t rnd = 1;
+static uint32_t nextRandom() { rnd ^= rnd << 13; rnd ^= rnd >> 17; rnd ^= rnd << 5; return rnd; }
+
+// previous per pixel path: gamma32(), colorBalanceFromKelvin(), color_fade(c, bri, true)
+static uint32_t reference(uint32_t c, uint8_t bri, bool gamma, bool kelvin) {
+  if (c && gamma) c = (uint32_t(gammaT[c >> 24]) << 24) | (uint32_t(gammaT[(c >> 16) & 0xFF]) << 16) | (uint32_t(gammaT[(c >> 8) & 0xFF]) << 8) | gammaT[c & 0xFF];
+  if (kelvin) {
+    const uint32_t r = (correction[0] * ((c >> 16) & 0xFF)) / 255, g = (correction[1] * ((c >> 8) & 0xFF)) / 255, b = (correction[2] * (c & 0xFF)) / 255;
+    c = (c & 0xFF000000) | (r << 16) | (g << 8) | b;
+  }
+  return color_fade(c, bri, true);
+}
+
+void setUp(void) {
+  rnd = 1;
+  for (unsigned i = 0; i < 256; i++) gammaT[i] = (uint8_t)(powf(i / 255.0f, 2.8f) * 255.0f + 0.5f); // calcGammaTable()
+}
+void tearDown(void) {}
+
+// table driven brightness equals color_fade(c, bri, true) for every brightness
+void test_fade_matches_color_fade(void) {
+  BusColorLUT lut;
+  for (unsigned bri = 0; bri < 256; bri++) {
+    lut.buildBri(bri);
+    for (unsigned r = 0; r < 256; r += 15) for (unsigned g = 0; g < 256; g += 15) for (unsigned b = 0; b < 256; b += 15) {
+      const uint32_t c = (((r + g) & 0xFF) << 24) | (r << 16) | (g << 8) | b;
+      TEST_ASSERT_EQUAL_HEX32(color_fade(c, bri, true), lut.fade(c));
+    }
+    for (int i = 0; i < 2000; i++) {
+      const uint32_t c = nextRandom();
+      TEST_ASSERT_EQUAL_HEX32(color_fade(c, bri, true), lut.fade(c));
+    }
+  }
+}
+
+// gamma & white balance table followed by brightness equals the previous per pixel path
+void test_fused_matches_reference(void) {
+  BusColorLUT lut;
+  for (int mode = 0; mode < 4; mode++) {
+    const bool gamma = mode & 1, kelvin = mode & 2;
+    const uint8_t none[3] = {255, 255, 255};
+    lut.buildPre(kelvin ? 2700 : 0, gamma ? 1 : -1, kelvin ? correction : none, gamma ? gammaT : nullptr);
+    TEST_ASSERT_TRUE(lut.preMatches(kelvin ? 2700 : 0, gamma ? 1 : -1));
+    const uint8_t levels[] = {1, 37, 128, 254, 255};
+    for (uint8_t bri : levels) {
+      lut.buildBri(bri);
+      for (int i = 0; i < 20000; i++) {
+        const uint32_t c = nextRandom();
+        TEST_ASSERT_EQUAL_HEX32(reference(c, bri, gamma, kelvin), lut.fade(lut.pre(c)));
+      }
+    }
+  }
+}
+
+// each bus keeps its own tables: a second bus with other settings does not change the first one's output
+void test_tables_per_bus(void) {
+  BusColorLUT a, b;
+  const uint8_t none[3] = {255, 255, 255};
+  a.buildPre(0, 1, none, gammaT);
+  a.buildBri(100);
+  b.buildPre(2700, -1, correction, nullptr);
+  b.buildBri(200);
+  TEST_ASSERT_TRUE(a.preMatches(0, 1) && a.briMatches(100));
+  TEST_ASSERT_TRUE(b.preMatches(2700, -1) && b.briMatches(200));
+  for (int i = 0; i < 1000; i++) {
+    const uint32_t c = nextRandom();
+    TEST_ASSERT_EQUAL_HEX32(reference(c, 100, true, false), a.fade(a.pre(c)));
+    TEST_ASSERT_EQUAL_HEX32(reference(c, 200, false, true), b.fade(b.pre(c)));
+  }
+}
+
+// 16 bit table: full precision gamma, white balance derived from it, linear without gamma
+void test_lut16(void) {
+  BusColorLUT16 lut;
+  const uint8_t none[3] = {255, 255, 255};
+  lut.build(0, -1, none, 2.8f);
+  for (unsigned i = 0; i < 256; i++) TEST_ASSERT_EQUAL_UINT16(i * 257, lut(3, i));
+  lut.build(2700, 1, correction, 2.8f);
+  TEST_ASSERT_TRUE(lut.matches(2700, 1));
+  TEST_ASSERT_EQUAL_UINT16(0, lut(0, 0));
+  TEST_ASSERT_EQUAL_UINT16(65535, lut(3, 255));
+  TEST_ASSERT_EQUAL_UINT16((97u * 65535u) / 255u, lut(2, 255));
+  unsigned distinct = 0, distinct8 = 0;
+  for (unsigned i = 1; i < 256; i++) {
+    TEST_ASSERT_TRUE(lut(3, i) >= lut(3, i - 1)); // monotonic
+    if (lut(3, i) != lut(3, i - 1)) distinct++;
+    if (gammaT[i] != gammaT[i - 1]) distinct8++;
+  }
+  TEST_ASSERT_GREATER_THAN(distinct8 + 50, distinct); // far fewer low levels collapse than with the 8 bit table
+}
+
+// bus_manager.cpp: Bus::autoWhiteCalc() in RGBW_MODE_AUTO_ACCURATE (8 bit) and BusDigital::setPixelColor16() (16 bit)
+static inline uint32_t autoWhite(uint32_t c) {
+  uint8_t r = c >> 16, g = c >> 8, b = c;
+  const uint8_t w = r < g ? (r < b ? r : b) : (g < b ? g : b);
+  r -= w; g -= w; b -= w;
+  return (uint32_t(w) << 24) | (uint32_t(r) << 16) | (uint32_t(g) << 8) | b;
+}
+static inline void autoWhite16(uint32_t &r, uint32_t &g, uint32_t &b, uint32_t &w) {
+  w = r < g ? (r < b ? r : b) : (g < b ? g : b);
+  r -= w; g -= w; b -= w;
+}
+static inline uint32_t scale16(uint32_t v, uint8_t bri) {
+  return v ? std::max<uint32_t>((v * (bri * 257U) + 0x8000) >> 16, 1) : 0;
+}
+// previous per pixel 16 bit path: gamma calculated for every channel of every pixel
+static inline uint32_t gamma16(uint8_t v, unsigned ch) {
+  const uint32_t g = uint16_t(powf(v / 255.0f, 2.8f) * 65535.0f + 0.5f);
+  return ch < 3 ? (correction[ch] * g) / 255 : g;
+}
+
+// two buses with different brightness, 300 pixels each: per pixel path vs. fused per bus tables
+// for RGB, RGBW with auto white (accurate mode) and 16 bit RGBW output
+void test_benchmark(void) {
+  const unsigned frames = 2000, pixels = 300, n = frames * pixels * 2;
+  static uint32_t colors[pixels];
+  for (auto &c : colors) c = nextRandom() & 0x00FFFFFF; // white is calculated by the bus
+  BusColorLUT lut[2];
+  BusColorLUT16 lut16[2];
+  double t[7];
+  uint32_t sum[6] = {0};
+  t[0] = hostSeconds();
+  // RGB
+  for (unsigned f = 0; f < frames; f++) for (unsigned bus = 0; bus < 2; bus++)
+    for (unsigned i = 0; i < pixels; i++) sum[0] += reference(colors[i], bus ? 200 : 100, true, true);
+  t[1] = hostSeconds();
+  for (unsigned f = 0; f < frames; f++) for (unsigned bus = 0; bus < 2; bus++) {
+    const uint8_t bri = bus ? 200 : 100;
+    if (!lut[bus].preMatches(2700, 1)) lut[bus].buildPre(2700, 1, correction, gammaT);
+    if (!lut[bus].briMatches(bri)) lut[bus].buildBri(bri);
+    for (unsigned i = 0; i < pixels; i++) sum[1] += lut[bus].fade(lut[bus].pre(colors[i]));
+  }
+  t[2] = hostSeconds();
+  // RGBW with auto white
+  for (unsigned f = 0; f < frames; f++) for (unsigned bus = 0; bus < 2; bus++)
+    for (unsigned i = 0; i < pixels; i++) sum[2] += color_fade(autoWhite(reference(colors[i], 255, true, true)), bus ? 200 : 100, true);
+  t[3] = hostSeconds();
+  for (unsigned f = 0; f < frames; f++) for (unsigned bus = 0; bus < 2; bus++)
+    for (unsigned i = 0; i < pixels; i++) sum[3] += lut[bus].fade(autoWhite(lut[bus].pre(colors[i])));
+  t[4] = hostSeconds();
+  // 16 bit RGBW with auto white
+  for (unsigned f = 0; f < frames; f++) for (unsigned bus = 0; bus < 2; bus++) {
+    const uint8_t bri = bus ? 200 : 100;
+    for (unsigned i = 0; i < pixels; i++) {
+      const uint32_t c = colors[i];
+      uint32_t r = gamma16(c >> 16, 0), g = gamma16(c >> 8, 1), b = gamma16(c, 2), w;
+      autoWhite16(r, g, b, w);
+      sum[4] += scale16(r, bri) + scale16(g, bri) + scale16(b, bri) + scale16(w, bri);
+    }
+  }
+  t[5] = hostSeconds();
+  for (unsigned f = 0; f < frames; f++) for (unsigned bus = 0; bus < 2; bus++) {
+    const uint8_t bri = bus ? 200 : 100;
+    if (!lut16[bus].matches(2700, 1)) lut16[bus].build(2700, 1, correction, 2.8f);
+    const BusColorLUT16 &l = lut16[bus];
+    for (unsigned i = 0; i < pixels; i++) {
+      const uint32_t c = colors[i];
+      uint32_t r = l(0, c >> 16), g = l(1, c >> 8), b = l(2, c), w;
+      autoWhite16(r, g, b, w);
+      sum[5] += scale16(r, bri) + scale16(g, bri) + scale16(b, bri) + scale16(w, bri);
+    }
+  }
+  t[6] = hostSeconds();
+  // both variants of each path produce the same output
+  TEST_ASSERT_EQUAL_UINT32(sum[0], sum[1]);
+  TEST_ASSERT_EQUAL_UINT32(sum[2], sum[3]);
+  TEST_ASSERT_EQUAL_UINT32(sum[4], sum[5]);
+  const char *name[3] = {"RGB", "RGBW auto white", "16 bit RGBW"};
+  char msg[128];
+  for (unsigned p = 0; p < 3; p++) {
+    snprintf(msg, sizeof(msg), "%s: per pixel %.1f ns/px, fused tables %.1f ns/px", name[p],
+             (t[2*p+1] - t[2*p]) * 1e9 / n, (t[2*p+2] - t[2*p+1]) * 1e9 / n);
+    TEST_MESSAGE(msg);
+  }
+}
+
+int main(void) {
+  UNITY_BEGIN();
+  RUN_TEST(test_fade_matches_color_fade);
+  RUN_TEST(test_fused_matches_reference);
+  RUN_TEST(test_tables_per_bus);
+  RUN_TEST(test_lut16);
+  RUN_TEST(test_benchmark);
+  return UNITY_END();
+}
@@ -0,0 +1,138 @@
+// binary config snapshot (wled00/cfg_cache.h): validation against data corruption, firmware build and the cfg.json it
+// belongs to, CRC of cfg.json read in chunks and its cost
+#include <unity.h>
+#include <stdio.h>
+#include <string>
+#include "wled_host.h"
+#include "cfg_cache.h"
+
+static uint32_t rnd = 1;
+static uint32_t nextRandom() { rnd ^= rnd << 13; rnd ^= rnd >> 17; rnd ^= rnd << 5; return rnd; }
+
+// bit by bit reference (previous implementation)
+static uint32_t crc32Bitwise(const uint8_t* data, size_t len, uint32_t crc = 0) {
+  crc = ~crc;
+  for (size_t i = 0; i < len; i++) {
+    crc ^= data[i];
+    for (unsigned k = 0; k < 8; k++) crc = (crc >> 1) ^ (0xEDB88320UL & (0U - (crc & 1)));
+  }
+  return ~crc;
+}
+
+// cfg.json of a typical setup (about 3 kB)
+static std::string configJson(unsigned leds = 150, unsigned pin = 16) {
+  std::string cfg = "{\"rev\":[1,0],\"vid\":2605010,\"id\":{\"mdns\":\"wled-abcdef\",\"name\":\"WLED\",\"inv\":\"Light\",\"sui\":false},";
+  cfg += "\"hw\":{\"led\":{\"total\":600,\"maxpwr\":850,\"cct\":false,\"cr\":false,\"ic\":false,\"cb\":0,\"fps\":42,\"rgbwm\":255,\"ins\":[";
+  for (unsigned i = 0; i < 4; i++)
+    cfg += std::string(i ? "," : "") + "{\"start\":" + std::to_string(i * leds) + ",\"len\":" + std::to_string(leds) + ",\"pin\":[" + std::to_string(pin + i)
+         + "],\"order\":0,\"rev\":false,\"skip\":0,\"type\":22,\"ref\":false,\"rgbwm\":0,\"freq\":0,\"maxpwr\":850,\"ledma\":55,\"drv\":0,\"text\":\"\"}";
+  cfg += "]},\"relay\":{\"pin\":-1,\"rev\":false,\"odrain\":false}},\"light\":{\"scale-bri\":100,\"gc\":{\"bri\":1,\"col\":2.2,\"val\":2.2}},\"timers\":{\"ins\":[";
+  for (unsigned i = 0; i < 10; i++) cfg += std::string(i ? "," : "") + "{\"en\":0,\"hour\":0,\"min\":0,\"macro\":0,\"dow\":127,\"start\":{\"mon\":1,\"day\":1},\"end\":{\"mon\":12,\"day\":31}}";
+  cfg += "]},\"um\":{";
+  for (unsigned i = 0; i < 12; i++) cfg += std::string(i ? "," : "") + "\"usermod" + std::to_string(i) + "\":{\"enabled\":true,\"pin\":[-1,-1],\"interval\":60000,\"name\":\"sensor\"}";
+  return cfg + "}}";
+}
+
+// configFileKey() in cfg.cpp: CRC of the file read in 128 byte chunks
+static uint32_t fileCrc(const std::string &file) {
+  uint32_t crc = 0;
+  for (size_t pos = 0; pos < file.size(); pos += 128)
+    crc = ConfigCache::crc32((const uint8_t*)file.data() + pos, file.size() - pos < 128 ? file.size() - pos : 128, crc);
+  return crc;
+}
+
+static CfgCacheData data;
+static CfgCacheHeader header;
+
+void setUp(void) {
+  rnd = 1;
+  memset(&data, 0, sizeof(data));
+  data.buses = 3;
+  data.ablMilliampsMax = 850;
+  data.gammaCorrectVal = 2.2f;
+  data.bus[0].len = 300;
+  strcpy(data.bus[2].text, "host");
+}
+void tearDown(void) {}
+
+void test_crc32(void) {
+  TEST_ASSERT_EQUAL_HEX32(0xCBF43926, ConfigCache::crc32((const uint8_t*)"123456789", 9));
+  uint8_t buf[1000];
+  for (auto &b : buf) b = nextRandom();
+  for (unsigned i = 0; i < 200; i++) {
+    const size_t len = nextRandom() % sizeof(buf), split = len ? nextRandom() % len : 0;
+    TEST_ASSERT_EQUAL_HEX32(crc32Bitwise(buf, len), ConfigCache::crc32(buf, len));
+    TEST_ASSERT_EQUAL_HEX32(ConfigCache::crc32(buf, len), ConfigCache::crc32(buf + split, len - split, ConfigCache::crc32(buf, split)));
+  }
+  const std::string cfg = configJson();
+  TEST_ASSERT_EQUAL_HEX32(ConfigCache::crc32((const uint8_t*)cfg.data(), cfg.size()), fileCrc(cfg));
+}
+
+// every single bit flip in the data, another build and out of range counts are rejected
+void test_validation(void) {
+  ConfigCache::seal(header, data, 2605010, 8123, 0x12345678);
+  TEST_ASSERT_TRUE(ConfigCache::isValid(header, data, 2605010, 8123, 0x12345678));
+  TEST_ASSERT_FALSE(ConfigCache::isValid(header, data, 2605011, 8123, 0x12345678));
+  unsigned undetected = 0;
+  for (size_t i = 0; i < sizeof(data); i++) for (unsigned b = 0; b < 8; b++) {
+    ((uint8_t*)&data)[i] ^= 1 << b;
+    undetected += ConfigCache::isValid(header, data, 2605010, 8123, 0x12345678);
+    ((uint8_t*)&data)[i] ^= 1 << b;
+  }
+  TEST_ASSERT_EQUAL(0, undetected);
+  header.layout = CFG_CACHE_LAYOUT - 1;
+  TEST_ASSERT_FALSE(ConfigCache::isValid(header, data, 2605010, 8123, 0x12345678));
+  data.buses = CFG_CACHE_MAX_BUSSES + 1;
+  ConfigCache::seal(header, data, 1, 1, 1);
+  TEST_ASSERT_FALSE(ConfigCache::isValid(header, data, 1, 1, 1));
+}
+
+// the snapshot belongs to one cfg.json: edits that keep the file size (other pin, LED count of the same length) are detected
+void test_config_file_changed(void) {
+  const std::string cfg = configJson(150, 16), samePins = configJson(150, 16), otherPins = configJson(150, 17), otherLeds = configJson(160, 16);
+  TEST_ASSERT_EQUAL(cfg.size(), otherPins.size());
+  TEST_ASSERT_EQUAL(cfg.size(), otherLeds.size());
+  ConfigCache::seal(header, data, 1, cfg.size(), fileCrc(cfg));
+  TEST_ASSERT_TRUE(ConfigCache::isValid(header, data, 1, samePins.size(), fileCrc(samePins)));
+  TEST_ASSERT_FALSE(ConfigCache::isValid(header, data, 1, otherPins.size(), fileCrc(otherPins)));
+  TEST_ASSERT_FALSE(ConfigCache::isValid(header, data, 1, otherLeds.size(), fileCrc(otherLeds)));
+  TEST_ASSERT_FALSE(ConfigCache::isValid(header, data, 1, cfg.size() + 1, fileCrc(cfg + " ")));
+  // any single byte change of cfg.json
+  unsigned undetected = 0;
+  std::string edited = cfg;
+  for (size_t i = 0; i < edited.size(); i++) {
+    edited[i] ^= 1 + nextRandom() % 255;
+    undetected += ConfigCache::isValid(header, data, 1, edited.size(), fileCrc(edited));
+    edited[i] = cfg[i];
+  }
+  TEST_ASSERT_EQUAL(0, undetected);
+  TEST_ASSERT_TRUE(ConfigCache::isValid(header, data, 1, edited.size(), fileCrc(edited)));
+}
+
+// boot cost of the key: hashing cfg.json and validating the snapshot
+void test_benchmark(void) {
+  const std::string cfg = configJson();
+  const unsigned rounds = 2000;
+  volatile uint32_t sink = 0;
+  double t0 = hostSeconds();
+  for (unsigned i = 0; i < rounds; i++) sink = sink + crc32Bitwise((const uint8_t*)cfg.data(), cfg.size());
+  double t1 = hostSeconds();
+  for (unsigned i = 0; i < rounds; i++) sink = sink + fileCrc(cfg);
+  double t2 = hostSeconds();
+  ConfigCache::seal(header, data, 1, cfg.size(), 1);
+  for (unsigned i = 0; i < rounds; i++) sink = sink + ConfigCache::isValid(header, data, 1, cfg.size(), 1);
+  double t3 = hostSeconds();
+  char msg[160];
+  snprintf(msg, sizeof(msg), "cfg.json %u bytes: CRC bitwise %.1f us, nibble table %.1f us, snapshot (%u bytes) validation %.1f us",
+           (unsigned)cfg.size(), (t1 - t0) * 1e6 / rounds, (t2 - t1) * 1e6 / rounds, (unsigned)sizeof(CfgCacheData), (t3 - t2) * 1e6 / rounds);
+  TEST_MESSAGE(msg);
+}
+
+int main(void) {
+  UNITY_BEGIN();
+  RUN_TEST(test_crc32);
+  RUN_TEST(test_validation);
+  RUN_TEST(test_config_file_changed);
+  RUN_TEST(test_benchmark);
+  return UNITY_END();
+}
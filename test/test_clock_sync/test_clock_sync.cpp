@@ -0,0 +1,120 @@
+// clock offset and drift estimation between follower and sync leader (wled00/clock_sync.h): convergence, packet loss,
+// leader clock steps and leader changes
+#include <unity.h>
+#include <stdio.h>
+#include <math.h>
+#include "clock_sync.h"
+
+static uint32_t rnd = 1;
+static uint32_t nextRandom() { rnd ^= rnd << 13; rnd ^= rnd >> 17; rnd ^= rnd << 5; return rnd; }
+static double uniform() { return (nextRandom() & 0xFFFFFF) / double(0x1000000); }
+
+// a clock running at rate with offset (us) at true time 0
+struct Clock {
+  double rate, offset;
+  uint64_t at(double t) const { return uint64_t(t * rate * 1e6 + offset); }
+};
+
+static Clock leader, follower;
+static ClockSync *cs;
+
+// one request/response exchange at true time t, network delay 2 ms + up to 20 ms of queuing each way
+static void exchange(double t, double loss = 0.0) {
+  if (uniform() < loss) return;
+  const double d1 = 0.002 + 0.020 * uniform() * uniform(), d2 = 0.002 + 0.020 * uniform() * uniform();
+  const uint64_t t1 = follower.at(t);
+  const uint64_t t2 = leader.at(t + d1);
+  const uint64_t t3 = t2 + 50;
+  if (uniform() < loss) return;
+  const uint64_t t4 = follower.at(t + d1 + 50e-6 + d2);
+  cs->addSample(t1, t2, t3, t4);
+}
+
+// estimated - true leader clock at true time t (ms)
+static double error(double t) {
+  const uint64_t f = follower.at(t);
+  return (double(int64_t(f + cs->getOffset(f))) - double(leader.at(t))) / 1000.0;
+}
+
+// exchanges every second from t0 to t1, returns the largest error of the last 10 s
+static double run(double t0, double t1, double loss = 0.0) {
+  double maxErr = 0;
+  for (double t = t0; t < t1; t += 1.0) {
+    exchange(t, loss);
+    if (t >= t1 - 10) for (double k = 0.1; k < 1.0; k += 0.3) maxErr = fmax(maxErr, fabs(error(t + k)));
+  }
+  return maxErr;
+}
+
+void setUp(void) {
+  rnd = 1;
+  leader   = {1 + 50e-6, 3.7e9};
+  follower = {1 - 30e-6, 1.2e8};
+  cs = new ClockSync();
+}
+void tearDown(void) { delete cs; }
+
+// offset within a millisecond and skew close to the true frequency difference
+void test_converges(void) {
+  TEST_ASSERT_FALSE(cs->isSynced(follower.at(0)));
+  const double err = run(0, 120);
+  TEST_ASSERT_TRUE(cs->isSynced(follower.at(120)));
+  TEST_ASSERT_TRUE(err < 1.0);
+  TEST_ASSERT_FLOAT_WITHIN(10e-6, 80e-6, cs->getSkew());
+  TEST_ASSERT_EQUAL(0, cs->stats.steps);
+  char msg[96];
+  snprintf(msg, sizeof(msg), "max error %.3f ms, skew %.1f ppm, delay %u us", err, cs->getSkew() * 1e6, (unsigned)cs->getDelay());
+  TEST_MESSAGE(msg);
+}
+
+// extrapolation keeps the error small with heavy packet loss, sync is lost after CLOCKSYNC_TIMEOUT without samples
+void test_packet_loss_and_timeout(void) {
+  const double err = run(0, 300, 0.5);
+  TEST_ASSERT_TRUE(err < 2.0);
+  TEST_ASSERT_TRUE(cs->stats.used < cs->stats.samples);
+  const double quiet = 299 + CLOCKSYNC_TIMEOUT * 1e-6 / follower.rate + 1;
+  TEST_ASSERT_TRUE(fabs(error(299 + 20)) < 5.0);  // still usable after 20 s without samples
+  TEST_ASSERT_FALSE(cs->isSynced(follower.at(quiet)));
+}
+
+// leader clock jumps (reboot): one step, then the estimate follows the new clock without mixing in old samples
+void test_leader_clock_step(void) {
+  run(0, 60);
+  leader.offset += 10e6;  // +10 s
+  double maxErr = 0;
+  for (double t = 60; t < 120; t += 1.0) {
+    exchange(t);
+    if (t >= 60 + CLOCKSYNC_FILTER) maxErr = fmax(maxErr, fabs(error(t + 0.5)));
+  }
+  TEST_ASSERT_EQUAL(1, cs->stats.steps);
+  TEST_ASSERT_TRUE(maxErr < 3.0);  // few samples yet, skew not settled
+  TEST_ASSERT_TRUE(run(120, 240) < 1.0);
+  TEST_ASSERT_FLOAT_WITHIN(20e-6, 80e-6, cs->getSkew());
+  TEST_ASSERT_EQUAL(1, cs->stats.steps);
+}
+
+// following another leader: reset() discards the previous leader's samples, no steps are detected
+void test_leader_change(void) {
+  run(0, 60);
+  leader = {1 - 120e-6, 9.1e9};
+  cs->reset();
+  TEST_ASSERT_FALSE(cs->isSynced(follower.at(60)));
+  double maxErr = 0;
+  for (double t = 60; t < 120; t += 1.0) {
+    exchange(t);
+    if (t >= 64) maxErr = fmax(maxErr, fabs(error(t + 0.5)));
+  }
+  TEST_ASSERT_TRUE(maxErr < 3.0);
+  TEST_ASSERT_TRUE(run(120, 240) < 1.0);
+  TEST_ASSERT_FLOAT_WITHIN(20e-6, -90e-6, cs->getSkew());
+  TEST_ASSERT_EQUAL(0, cs->stats.steps);
+}
+
+int main(void) {
+  UNITY_BEGIN();
+  RUN_TEST(test_converges);
+  RUN_TEST(test_packet_loss_and_timeout);
+  RUN_TEST(test_leader_clock_step);
+  RUN_TEST(test_leader_change);
+  return UNITY_END();
+}
@@ -0,0 +1,174 @@
+// DDP receive jitter buffer (wled00/ddp_frames.h): presentation timing, late/duplicate/dropped frames, network task vs loop()
+#include <unity.h>
+#include <stdio.h>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include "wled_host.h"
+#define RGBW32(r,g,b,w) (uint32_t((byte(w) << 24) | (byte(r) << 16) | (byte(g) << 8) | (byte(b))))   // colors.h
+#include "ddp_frames.h"
+
+#define LEDS 60
+
+// last presented frame: value of the first LED and range
+static uint32_t shownColor, shownStart, shownStop;
+static unsigned shownCount;
+static bool torn;
+static void onFrame(const uint32_t* pixels, unsigned start, unsigned stop) {
+  shownColor = pixels[start];
+  shownStart = start;
+  shownStop  = stop;
+  shownCount++;
+  for (unsigned i = start; i < stop; i++) if (pixels[i] != pixels[start]) torn = true;
+}
+
+static DDPFrameBuffer *fb;
+
+// frame <n> (all LEDs set to n) with time code <timecode> arrives complete at <now>, to be shown at <due>
+static void frame(uint8_t n, uint32_t timecode, unsigned long due, unsigned long now, unsigned leds = LEDS) {
+  uint8_t data[LEDS * 3];
+  for (unsigned i = 0; i < sizeof(data); i++) data[i] = n;
+  fb->write(0, data, leds / 2, 3);   // two packets per frame
+  fb->write(leds / 2, data, leds - leds / 2, 3);
+  fb->push(timecode, due, now);
+}
+
+void setUp(void) {
+  shownColor = shownStart = shownStop = shownCount = 0;
+  torn = false;
+  fb = new DDPFrameBuffer(onFrame);
+  TEST_ASSERT_TRUE(fb->begin(LEDS));
+}
+void tearDown(void) { delete fb; }
+
+// frames are held until their presentation time and shown in order
+void test_presented_when_due(void) {
+  frame(1, 1000, 150, 100);
+  frame(2, 2000, 175, 110);
+  TEST_ASSERT_EQUAL(2, fb->getDepth());
+  fb->handle(149);
+  TEST_ASSERT_EQUAL(0, shownCount);
+  fb->handle(150);
+  TEST_ASSERT_EQUAL(1, shownCount);
+  TEST_ASSERT_EQUAL_HEX32(RGBW32(1,1,1,0), shownColor);
+  TEST_ASSERT_EQUAL(0, shownStart);
+  TEST_ASSERT_EQUAL(LEDS, shownStop);
+  fb->handle(160);
+  TEST_ASSERT_EQUAL(1, shownCount);
+  fb->handle(175);
+  TEST_ASSERT_EQUAL(2, shownCount);
+  TEST_ASSERT_EQUAL_HEX32(RGBW32(2,2,2,0), shownColor);
+  TEST_ASSERT_EQUAL(0, fb->getDepth());
+  TEST_ASSERT_EQUAL(2, fb->stats.presented);
+  TEST_ASSERT_FALSE(torn);
+}
+
+// frames arriving after their presentation time, older than the shown one or repeated are dropped
+void test_late_and_duplicate(void) {
+  frame(1, 1000, 100 - DDP_LATE_TOLERANCE - 1, 100);
+  TEST_ASSERT_EQUAL(1, fb->stats.late);
+  TEST_ASSERT_EQUAL(0, fb->getDepth());
+  frame(2, 2000, 95, 100);   // within tolerance
+  fb->handle(100);
+  TEST_ASSERT_EQUAL_HEX32(RGBW32(2,2,2,0), shownColor);
+  frame(3, 2000, 120, 110);  // same time code as the shown frame
+  frame(4, 3000, 130, 110);
+  frame(5, 3000, 135, 112);  // same time code as a queued frame
+  TEST_ASSERT_EQUAL(2, fb->stats.duplicates);
+  frame(6, 1500, 140, 115);  // older than the shown frame
+  TEST_ASSERT_EQUAL(2, fb->stats.late);
+  fb->handle(200);
+  TEST_ASSERT_EQUAL_HEX32(RGBW32(4,4,4,0), shownColor);
+  TEST_ASSERT_EQUAL(2, fb->stats.presented);
+}
+
+// a full buffer drops the oldest frame, of several due frames only the newest is shown
+void test_full_buffer_and_backlog(void) {
+  for (unsigned i = 0; i <= DDP_JITTER_FRAMES; i++) frame(10 + i, 1000 * (i + 1), 200 + i, 100);
+  TEST_ASSERT_EQUAL(DDP_JITTER_FRAMES, fb->getDepth());
+  TEST_ASSERT_EQUAL(1, fb->stats.dropped);
+  fb->handle(200 + DDP_JITTER_FRAMES);
+  TEST_ASSERT_EQUAL(1, shownCount);
+  TEST_ASSERT_EQUAL_HEX32(RGBW32(10 + DDP_JITTER_FRAMES, 10 + DDP_JITTER_FRAMES, 10 + DDP_JITTER_FRAMES, 0), shownColor);
+  TEST_ASSERT_EQUAL(DDP_JITTER_FRAMES, fb->stats.dropped);
+  TEST_ASSERT_EQUAL(0, fb->getDepth());
+}
+
+// frames are not held longer than DDP_MAX_LATENCY, partial frames show only the received range
+void test_latency_clamp_and_range(void) {
+  frame(1, 1000, 100 + 10 * DDP_MAX_LATENCY, 100);
+  TEST_ASSERT_EQUAL(1, fb->stats.clamped);
+  fb->handle(100 + DDP_MAX_LATENCY);
+  TEST_ASSERT_EQUAL(1, shownCount);
+  const uint8_t data[3 * 10] = {7,7,7, 7,7,7, 7,7,7, 7,7,7, 7,7,7, 7,7,7, 7,7,7, 7,7,7, 7,7,7, 7,7,7};
+  fb->write(20, data, 10, 3);
+  fb->write(LEDS - 5, data, 10, 3);  // clipped to the strip
+  fb->push(2000, 700, 700);
+  fb->handle(700);
+  TEST_ASSERT_EQUAL(20, shownStart);
+  TEST_ASSERT_EQUAL(LEDS, shownStop);
+  fb->push(3000, 710, 710);          // no data received since the last push
+  TEST_ASSERT_EQUAL(0, fb->getDepth());
+}
+
+// without a common clock frames are shown DDP_JITTER_DELAY after the fastest packet, regardless of network jitter
+void test_schedule_follows_sender(void) {
+  const uint32_t base = 0x12340000;
+  unsigned long maxErr = 0;
+  for (unsigned i = 0; i < 200; i++) {
+    const unsigned long sent = 1000 + i * 25;
+    const unsigned long now = sent + 5 + (i % 7) * 4;   // 5..29 ms network delay
+    const uint32_t timecode = base + uint32_t((uint64_t(sent) << 16) / 1000);
+    const unsigned long due = fb->schedule(timecode, now);
+    const long err = long(due) - long(sent + 5 + DDP_JITTER_DELAY);  // fastest packet took 5 ms
+    if (i >= 7 && (unsigned long)labs(err) > maxErr) maxErr = labs(err);
+  }
+  TEST_ASSERT_LESS_OR_EQUAL(2, maxErr);
+  // sender restart: time code jumps, the reference follows immediately
+  const unsigned long due = fb->schedule(0x00010000, 20000);
+  TEST_ASSERT_UINT_WITHIN(1, 20000 + DDP_JITTER_DELAY, due);
+}
+
+// network task receives frames (and changes the LED count) while loop() presents them, both hold one lock
+void test_network_task_vs_loop(void) {
+  std::mutex lock;
+  std::atomic<bool> done{false};
+  std::atomic<unsigned long> clock{0};
+  std::thread network([&]() {
+    for (unsigned n = 1; n < 100000; n++) {
+      {
+        const std::lock_guard<std::mutex> guard(lock);
+        const unsigned long now = clock++;
+        fb->begin(n % 5000 < 10 ? LEDS / 2 : LEDS);  // occasional reconfiguration reallocates the buffer
+        frame(uint8_t(n), n << 8, now + n % 3, now, n % 5000 < 10 ? LEDS / 2 : LEDS);
+      }
+      std::this_thread::yield();
+    }
+    done = true;
+  });
+  unsigned loops = 0;
+  while (!done) {
+    const std::lock_guard<std::mutex> guard(lock);
+    fb->handle(clock);
+    loops++;
+  }
+  network.join();
+  fb->handle(clock + DDP_MAX_LATENCY);
+  TEST_ASSERT_FALSE_MESSAGE(torn, "frame changed while presented");
+  TEST_ASSERT_GREATER_THAN(0, shownCount);
+  TEST_ASSERT_EQUAL(shownCount, fb->stats.presented);
+  char msg[96];
+  snprintf(msg, sizeof(msg), "%u loops, %u frames presented, %u dropped", loops, shownCount, (unsigned)fb->stats.dropped);
+  TEST_MESSAGE(msg);
+}
+
+int main(void) {
+  UNITY_BEGIN();
+  RUN_TEST(test_presented_when_due);
+  RUN_TEST(test_late_and_duplicate);
+  RUN_TEST(test_full_buffer_and_backlog);
+  RUN_TEST(test_latency_clamp_and_range);
+  RUN_TEST(test_schedule_follows_sender);
+  RUN_TEST(test_network_task_vs_loop);
+  return UNITY_END();
+}
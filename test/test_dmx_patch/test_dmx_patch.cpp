@@ -0,0 +1,158 @@
+// compiled DMX output patch (wled00/dmx_patch.h): equivalence with the classic DMX output, overlapping fixtures,
+// 16 bit channels and multiple universes
+#include <unity.h>
+#include <stdio.h>
+#include <vector>
+#include "wled_host.h"
+#define DMX_MAX_UNIVERSES 2
+#include "dmx_patch.h"
+
+static uint32_t rnd = 1;
+static uint32_t nextRandom() { rnd ^= rnd << 13; rnd ^= rnd >> 17; rnd ^= rnd << 5; return rnd; }
+
+// classic handleDMXOutput(): every fixture writes all its channels in LED order, the last write wins
+static uint8_t classic[513];
+static void classicOutput(const std::vector<uint32_t> &px, uint8_t brightness, const DMXProfile &prof, const DMXFixtureGroup &grp, bool clear = true) {
+  if (clear) memset(classic, 0, sizeof(classic));
+  bool calc = true;
+  for (unsigned j = 0; j < prof.channels; j++) if (prof.map[j] == DMX_CH_SHUTTER) calc = false;
+  const unsigned stop = grp.count ? grp.startLED + grp.count : px.size();
+  for (unsigned i = grp.startLED; i < stop && i < px.size(); i++) {
+    const uint32_t c = px[i];
+    const uint8_t w = c >> 24, r = c >> 16, g = c >> 8, b = c;
+    for (unsigned j = 0; j < prof.channels; j++) {
+      const unsigned a = grp.start + grp.gap * (i - grp.startLED) + j;
+      if (a > 512) continue;
+      switch (prof.map[j]) {
+        case DMX_CH_ZERO:    classic[a] = 0; break;
+        case DMX_CH_RED:     classic[a] = calc ? (r * brightness) / 255 : r; break;
+        case DMX_CH_GREEN:   classic[a] = calc ? (g * brightness) / 255 : g; break;
+        case DMX_CH_BLUE:    classic[a] = calc ? (b * brightness) / 255 : b; break;
+        case DMX_CH_WHITE:   classic[a] = calc ? (w * brightness) / 255 : w; break;
+        case DMX_CH_SHUTTER: classic[a] = brightness; break;
+        case DMX_CH_FULL:    classic[a] = 255; break;
+      }
+    }
+  }
+}
+
+static std::vector<uint32_t> randomPixels(unsigned leds) {
+  std::vector<uint32_t> px(leds);
+  for (auto &c : px) c = nextRandom();
+  return px;
+}
+
+static DMXProfile randomProfile() {
+  DMXProfile prof;
+  prof.channels = 1 + nextRandom() % DMX_MAX_PROFILE_CHANNELS;
+  for (auto &m : prof.map) m = nextRandom() % (nextRandom() % 4 ? 6 : 7);  // shutter in some profiles only
+  return prof;
+}
+
+void setUp(void) { rnd = 1; }
+void tearDown(void) {}
+
+// one group with random profile, spacing (also smaller than the profile: fixtures overlap) and brightness
+void test_matches_classic_output(void) {
+  unsigned cases = 0;
+  for (int it = 0; it < 20000; it++) {
+    const unsigned leds = 1 + nextRandom() % 200;
+    DMXPatch p;
+    p.profile[0] = randomProfile();
+    const uint16_t gap = nextRandom() % 3 ? p.profile[0].channels + nextRandom() % 8 : nextRandom() % p.profile[0].channels;
+    p.group[0] = {uint16_t(nextRandom() % leds), 0, uint16_t(1 + nextRandom() % 64), gap, 0, 0};
+    p.groups = 1;
+    if (p.group[0].start + gap * (leds - p.group[0].startLED - 1) + p.profile[0].channels - 1 > 512) continue; // classic output clamps to 512
+    const std::vector<uint32_t> px = randomPixels(leds);
+    const uint8_t bri = nextRandom();
+    classicOutput(px, bri, p.profile[0], p.group[0]);
+    TEST_ASSERT_TRUE(p.compile(leds));
+    p.render(bri, [&](unsigned i) { return px[i]; });
+    const uint8_t *u = p.universe(0);
+    TEST_ASSERT_NOT_NULL(u);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(classic + 1, u + 1, 512);
+    TEST_ASSERT_TRUE(p.getEntries() <= 512);
+    cases++;
+  }
+  char msg[64];
+  snprintf(msg, sizeof(msg), "%u random configurations", cases);
+  TEST_MESSAGE(msg);
+}
+
+// overlapping groups: the later group wins for color and constant channels, whatever the LED order
+void test_overlapping_groups(void) {
+  DMXPatch p;
+  p.profile[0] = {3, {DMX_CH_RED, DMX_CH_GREEN, DMX_CH_BLUE}};
+  p.profile[1] = {3, {DMX_CH_FULL, DMX_CH_ZERO, DMX_CH_WHITE}};
+  p.group[0] = {50, 10, 1, 3, 0, 0};   // LEDs 50-59 on channels 1-30
+  p.group[1] = {0, 5, 10, 3, 1, 0};    // LEDs 0-4 on channels 10-24, after group 0
+  p.group[2] = {20, 1, 22, 3, 0, 0};   // LED 20 on channels 22-24, after group 1
+  p.groups = 3;
+  std::vector<uint32_t> px(60);
+  for (unsigned i = 0; i < px.size(); i++) px[i] = (uint32_t(i) << 24) | (uint32_t(i) << 16) | (uint32_t(i) << 8) | i;
+  TEST_ASSERT_TRUE(p.compile(px.size()));
+  p.render(255, [&](unsigned i) { return px[i]; });
+  const uint8_t *u = p.universe(0);
+  for (unsigned g = 0; g < 3; g++) classicOutput(px, 255, p.profile[p.group[g].profile], p.group[g], g == 0);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(classic + 1, u + 1, 512);
+  TEST_ASSERT_EQUAL(50, u[1]);    // group 0 only
+  TEST_ASSERT_EQUAL(255, u[10]);  // group 1 constant over group 0 color
+  TEST_ASSERT_EQUAL(0, u[14]);    // group 1 zero over group 0 color
+  TEST_ASSERT_EQUAL(20, u[22]);   // group 2 over group 1 constant
+  TEST_ASSERT_EQUAL(20, u[23]);
+  TEST_ASSERT_EQUAL(20, u[24]);   // group 2 blue over white of LED 4 in group 1
+  TEST_ASSERT_EQUAL(3, u[21]);    // group 1 white of LED 3
+}
+
+// 16 bit color channels and fixtures continuing in the next universe
+void test_fine_channels_and_universes(void) {
+  DMXPatch p;
+  p.profile[0] = {4, {DMX_CH_RED, DMX_CH_RED_FINE, DMX_CH_GREEN, DMX_CH_GREEN_FINE}};
+  p.group[0] = {0, 0, 1, 4, 0, 0};
+  p.groups = 1;
+  const std::vector<uint32_t> px(200, 0x00FF8000);
+  TEST_ASSERT_TRUE(p.compile(px.size()));
+  TEST_ASSERT_EQUAL(2, p.getUniverses());
+  p.render(128, [&](unsigned i) { return px[i]; });
+  const unsigned r16 = (255 * 257 * 128) / 255, g16 = (128 * 257 * 128) / 255;
+  for (unsigned u = 0; u < 2; u++) {
+    const uint8_t *d = p.universe(u);
+    const unsigned channels = u ? 200 * 4 - 512 : 512;
+    for (unsigned a = 1; a <= channels; a += 4) {
+      TEST_ASSERT_EQUAL(r16 >> 8, d[a]);
+      TEST_ASSERT_EQUAL(r16 & 0xFF, d[a+1]);
+      TEST_ASSERT_EQUAL(g16 >> 8, d[a+2]);
+      TEST_ASSERT_EQUAL(g16 & 0xFF, d[a+3]);
+    }
+    if (u) TEST_ASSERT_EQUAL(0, d[channels + 1]);
+  }
+}
+
+// 170 RGB fixtures: compiled patch vs. classic output
+void test_benchmark(void) {
+  const unsigned frames = 20000;
+  DMXPatch p;
+  p.profile[0] = {3, {DMX_CH_RED, DMX_CH_GREEN, DMX_CH_BLUE}};
+  p.group[0] = {0, 0, 1, 3, 0, 0};
+  p.groups = 1;
+  const std::vector<uint32_t> px = randomPixels(170);
+  p.compile(px.size());
+  volatile unsigned sink = 0;
+  double t0 = hostSeconds();
+  for (unsigned i = 0; i < frames; i++) { p.render(i & 0xFF, [&](unsigned k) { return px[k]; }); sink = sink + p.universe(0)[5]; }
+  double t1 = hostSeconds();
+  for (unsigned i = 0; i < frames; i++) { classicOutput(px, i & 0xFF, p.profile[0], p.group[0]); sink = sink + classic[5]; }
+  double t2 = hostSeconds();
+  char msg[96];
+  snprintf(msg, sizeof(msg), "510 channels: patch %.2f us/frame, classic %.2f us/frame", (t1 - t0) * 1e6 / frames, (t2 - t1) * 1e6 / frames);
+  TEST_MESSAGE(msg);
+}
+
+int main(void) {
+  UNITY_BEGIN();
+  RUN_TEST(test_matches_classic_output);
+  RUN_TEST(test_overlapping_groups);
+  RUN_TEST(test_fine_channels_and_universes);
+  RUN_TEST(test_benchmark);
+  return UNITY_END();
+}
@@ -0,0 +1,449 @@
+// multi-universe E1.31/Art-Net frame assembly (wled00/e131_frames.h): reordering, loss, timeout and synchronization
+#include <unity.h>
+#include "wled_host.h"
+#define E131_MAX_UNIVERSE_COUNT 12   // const.h
+#define REALTIME_MODE_E131      4
+#define REALTIME_MODE_ARTNET    6
+#include "e131_frames.h"
+
+#define UNIVERSES 4
+
+// universes handed to the strip by the last shown frame: frame number (first channel) per universe, 0 if not shown
+static uint8_t shownFrame[UNIVERSES];
+static unsigned shownUniverses, callbacks;
+static void onUniverse(uint8_t index, uint8_t* data, uint16_t, uint8_t) {
+  shownFrame[index] = data[1];
+  shownUniverses++;
+  callbacks++;
+}
+
+static E131FrameAssembler *fa;
+static unsigned framesBefore;
+
+// universe <index> of frame <frame> arrives, returns true if a frame was shown
+static bool packet(unsigned index, uint8_t frame, uint8_t seq, unsigned long now, uint16_t sync = 0, uint8_t mode = REALTIME_MODE_E131) {
+  uint8_t data[E131_SLOT_SIZE] = {0};
+  data[1] = frame;
+  framesBefore = fa->stats.frames;
+  shownUniverses = 0;
+  fa->add(index, data, 510, seq, mode, sync, now);
+  return fa->stats.frames != framesBefore;
+}
+
+static bool shown(uint8_t frame, unsigned universes) {
+  if (shownUniverses != universes) return false;
+  unsigned n = 0;
+  for (unsigned i = 0; i < UNIVERSES; i++) if (shownFrame[i] == frame) n++;
+  return n == universes;
+}
+
+void setUp(void) {
+  fa = new E131FrameAssembler(onUniverse);
+  TEST_ASSERT_TRUE(fa->begin(UNIVERSES));
+  memset(shownFrame, 0, sizeof(shownFrame));
+  callbacks = 0;
+}
+void tearDown(void) { delete fa; }
+
+void test_begin(void) {
+  TEST_ASSERT_FALSE(fa->begin(0));
+  TEST_ASSERT_FALSE(fa->isActive());
+  TEST_ASSERT_FALSE(fa->begin(E131_MAX_UNIVERSE_COUNT + 1));
+  TEST_ASSERT_TRUE(fa->begin(E131_MAX_UNIVERSE_COUNT));
+  TEST_ASSERT_EQUAL(E131_MAX_UNIVERSE_COUNT, fa->getUniverses());
+  fa->end();
+  TEST_ASSERT_FALSE(fa->isActive());
+  fa->add(0, shownFrame, 1, 1, REALTIME_MODE_E131, 0, 0); // ignored without buffer
+  TEST_ASSERT_EQUAL(0, callbacks);
+}
+
+// frame is shown once, when the last universe arrives, even if universes are reordered
+void test_complete_and_reordered(void) {
+  for (unsigned u = 0; u < UNIVERSES - 1; u++) TEST_ASSERT_FALSE(packet(u, 1, 1, 0));
+  TEST_ASSERT_TRUE(packet(UNIVERSES - 1, 1, 1, 0));
+  TEST_ASSERT_TRUE(shown(1, UNIVERSES));
+  const unsigned order[UNIVERSES] = {2, 0, 3, 1};
+  for (unsigned k = 0; k < UNIVERSES; k++) TEST_ASSERT_EQUAL(k == UNIVERSES - 1, packet(order[k], 2, 2, 10));
+  TEST_ASSERT_TRUE(shown(2, UNIVERSES));
+  TEST_ASSERT_EQUAL(2, fa->stats.outOfOrder);
+  TEST_ASSERT_EQUAL(0, fa->stats.partialFrames);
+}
+
+// a lost universe: the next frame's first universe shows what we have, late and duplicate packets are discarded
+void test_loss_and_late(void) {
+  for (unsigned u = 0; u < UNIVERSES; u++) packet(u, 1, 1, 0);
+  for (unsigned u = 0; u < UNIVERSES - 1; u++) TEST_ASSERT_FALSE(packet(u, 2, 2, 20));
+  TEST_ASSERT_TRUE(packet(0, 3, 3, 45));
+  TEST_ASSERT_TRUE(shown(2, UNIVERSES - 1));
+  TEST_ASSERT_EQUAL(1, fa->stats.partialFrames);
+  TEST_ASSERT_EQUAL(1, fa->stats.droppedUniverses);
+  const uint32_t ooo = fa->stats.outOfOrder;
+  TEST_ASSERT_FALSE(packet(0, 2, 2, 46)); // late
+  TEST_ASSERT_FALSE(packet(0, 3, 3, 46)); // duplicate
+  TEST_ASSERT_EQUAL(ooo + 2, fa->stats.outOfOrder);
+  for (unsigned u = 1; u < UNIVERSES; u++) packet(u, 3, 3, 47);
+  TEST_ASSERT_TRUE(shown(3, UNIVERSES));
+  // sequence wrap and sender restart (jump back by more than 20) are accepted
+  const uint8_t seqs[] = {120, 250, 255, 0, 5, 200};
+  for (unsigned i = 0; i < sizeof(seqs); i++) {
+    for (unsigned u = 0; u < UNIVERSES; u++) packet(u, 4 + i, seqs[i], 60 + i);
+    TEST_ASSERT_TRUE(shown(4 + i, UNIVERSES));
+  }
+}
+
+// Art-Net sequence 0 disables sequence checking
+void test_artnet_no_sequence(void) {
+  for (int f = 1; f <= 3; f++) for (unsigned u = 0; u < UNIVERSES; u++) packet(u, f, 0, f * 10, E131_ARTSYNC, REALTIME_MODE_ARTNET);
+  TEST_ASSERT_EQUAL(3, fa->stats.frames);
+  TEST_ASSERT_EQUAL(0, fa->stats.outOfOrder);
+}
+
+// the rest of the frame never arrives: shown after E131_FRAME_TIMEOUT
+void test_timeout(void) {
+  packet(0, 1, 1, 100);
+  fa->handle(100 + E131_FRAME_TIMEOUT);
+  TEST_ASSERT_EQUAL(0, fa->stats.frames);
+  fa->handle(100 + E131_FRAME_TIMEOUT + 1);
+  TEST_ASSERT_EQUAL(1, fa->stats.frames);
+  TEST_ASSERT_EQUAL(1, fa->stats.partialFrames);
+  TEST_ASSERT_EQUAL(UNIVERSES - 1, fa->stats.droppedUniverses);
+}
+
+// synchronized sender: frames wait for the sync packet of their address, fall back to free run when sync stops
+void test_sync(void) {
+  for (unsigned u = 0; u < UNIVERSES; u++) packet(u, 1, 1, 200, 7); // no sync packet seen yet: free run
+  TEST_ASSERT_EQUAL(1, fa->stats.frames);
+  fa->sync(7, 205);
+  TEST_ASSERT_EQUAL(1, fa->stats.syncPackets);
+  TEST_ASSERT_TRUE(fa->synchronized(205));
+  for (unsigned u = 0; u < UNIVERSES; u++) TEST_ASSERT_FALSE(packet(UNIVERSES - 1 - u, 2, 2, 210, 7));
+  fa->handle(400);                           // no timeout while synchronized
+  TEST_ASSERT_EQUAL(1, fa->stats.frames);
+  fa->sync(99, 230);                         // other synchronization universe
+  fa->sync(0, 230);                          // no address
+  TEST_ASSERT_EQUAL(1, fa->stats.frames);
+  fa->sync(7, 231);
+  TEST_ASSERT_EQUAL(2, fa->stats.frames);
+  TEST_ASSERT_TRUE(shown(2, UNIVERSES));
+  // newest data wins while waiting for sync
+  packet(0, 3, 3, 240, 7);
+  packet(0, 4, 4, 250, 7);
+  fa->sync(7, 260);
+  TEST_ASSERT_TRUE(shown(4, 1));
+  // sync lost: incomplete frame is shown after E131_SYNC_TIMEOUT
+  for (unsigned u = 0; u < 2; u++) packet(u, 5, 5, 300, 7);
+  fa->handle(260 + E131_SYNC_TIMEOUT - 1);
+  TEST_ASSERT_EQUAL(3, fa->stats.frames);
+  fa->handle(260 + E131_SYNC_TIMEOUT + 1);
+  TEST_ASSERT_EQUAL(4, fa->stats.frames);
+  TEST_ASSERT_FALSE(fa->synchronized(260 + E131_SYNC_TIMEOUT + 1));
+}
+
+// handleE131Packet() (e131.cpp) against host stand-ins for the parts of wled.h it uses: universe offset,
+// frame assembly and E1.31 synchronization as wired up in the packet handler
+#define WLED_H
+#include <arpa/inet.h>
+#include <algorithm>
+
+// const.h, colors.h, Toki.h
+#define REALTIME_MODE_INACTIVE    0
+#define REALTIME_MODE_DDP         8
+#define REALTIME_OVERRIDE_NONE    0
+#define DMX_MODE_DISABLED         0
+#define DMX_MODE_SINGLE_RGB       1
+#define DMX_MODE_SINGLE_DRGB      2
+#define DMX_MODE_EFFECT           3
+#define DMX_MODE_MULTIPLE_RGB     4
+#define DMX_MODE_MULTIPLE_DRGB    5
+#define DMX_MODE_MULTIPLE_RGBW    6
+#define DMX_MODE_EFFECT_W         7
+#define DMX_MODE_EFFECT_SEGMENT   8
+#define DMX_MODE_EFFECT_SEGMENT_W 9
+#define DMX_MODE_PRESET           10
+#define CALL_MODE_NOTIFICATION    3
+#define CALL_MODE_WS_SEND         11
+#define RGBW32(r,g,b,w) (uint32_t((byte(w) << 24) | (byte(r) << 16) | (byte(g) << 8) | (byte(b))))
+#define R(c) (byte((c) >> 16))
+#define G(c) (byte((c) >> 8))
+#define B(c) (byte(c))
+#define W(c) (byte((c) >> 24))
+#define YEARS_70 2208988800UL
+#define TOKI_TS_UDP_NTP 110
+#define DEBUG_PRINTLN(x)
+#define DEBUG_PRINTF_P(...)
+#define snprintf_P snprintf
+#include "e131_sources.h"
+#include "ddp_frames.h"
+
+// src/dependencies/e131/ESPAsyncE131.h
+#define ARTNET_DEFAULT_PORT 6454
+#define DDP_FLAGS_PUSH    0x01
+#define DDP_FLAGS_TIME    0x10
+#define DDP_TYPE_RGB24  0x0B
+#define DDP_TYPE_RGBW32 0x1B
+#define DDP_ID_CONFIG   250
+#define DDP_ID_STATUS   251
+#define ARTNET_OPCODE_OPPOLL 0x2000
+#define ARTNET_OPCODE_OPPOLLREPLY 0x2100
+#define ARTNET_OPCODE_OPSYNC 0x5200
+#define E131_VECTOR_ROOT_EXTENDED 0x00000008
+#define P_E131   0
+#define P_ARTNET 1
+#define P_DDP    2
+
+typedef union {
+  struct {
+    uint16_t preamble_size;
+    uint16_t postamble_size;
+    uint8_t  acn_id[12];
+    uint16_t root_flength;
+    uint32_t root_vector;
+    uint8_t  cid[16];
+    uint16_t frame_flength;
+    uint32_t frame_vector;
+    uint8_t  source_name[64];
+    uint8_t  priority;
+    uint16_t sync_address;
+    uint8_t  sequence_number;
+    uint8_t  options;
+    uint16_t universe;
+    uint16_t dmp_flength;
+    uint8_t  dmp_vector;
+    uint8_t  type;
+    uint16_t first_address;
+    uint16_t address_increment;
+    uint16_t property_value_count;
+    uint8_t  property_values[513];
+  } __attribute__((packed));
+  struct {
+    uint8_t  sync_root_layer[38];
+    uint16_t sync_flength;
+    uint32_t sync_vector;
+    uint8_t  sync_sequence_number;
+    uint16_t sync_universe;
+    uint16_t sync_reserved;
+  } __attribute__((packed));
+  struct {
+    uint8_t  art_id[8];
+    uint16_t art_opcode;
+    uint16_t art_protocol_ver;
+    uint8_t  art_sequence_number;
+    uint8_t  art_physical;
+    uint16_t art_universe;
+    uint16_t art_length;
+    uint8_t  art_data[512];
+  } __attribute__((packed));
+  struct {
+    uint8_t  flags;
+    uint8_t  sequenceNum;
+    uint8_t  dataType;
+    uint8_t  destination;
+    uint32_t channelOffset;
+    uint16_t dataLen;
+    uint8_t  data[1];
+  } __attribute__((packed));
+  uint8_t raw[1458];
+} e131_packet_t;
+
+typedef union {
+  struct {
+    uint8_t reply_id[8];
+    uint16_t reply_opcode;
+    uint8_t reply_ip[4];
+    uint16_t reply_port;
+    uint8_t reply_version_h, reply_version_l, reply_net_sw, reply_sub_sw, reply_oem_h, reply_oem_l, reply_ubea_ver, reply_status_1;
+    uint16_t reply_esta_man;
+    uint8_t reply_short_name[18];
+    uint8_t reply_long_name[64];
+    uint8_t reply_node_report[64];
+    uint8_t reply_num_ports_h, reply_num_ports_l;
+    uint8_t reply_port_types[4], reply_good_input[4], reply_good_output_a[4], reply_sw_in[4], reply_sw_out[4];
+    uint8_t reply_sw_video, reply_sw_macro, reply_sw_remote;
+    uint8_t reply_spare[3];
+    uint8_t reply_style;
+    uint8_t reply_mac[6];
+    uint8_t reply_bind_ip[4];
+    uint8_t reply_bind_index, reply_status_2;
+    uint8_t reply_good_output_b[4];
+    uint8_t reply_status_3;
+    uint8_t reply_filler[21];
+  } __attribute__((packed));
+  uint8_t raw[239];
+} ArtPollReply;
+
+static const uint8_t ACN_ID[12] = { 0x41, 0x53, 0x43, 0x2d, 0x45, 0x31, 0x2e, 0x31, 0x37, 0x00, 0x00, 0x00 };
+struct ESPAsyncE131 {
+  static bool isSyncPacket(const e131_packet_t *p) { // ESPAsyncE131.cpp
+    return memcmp(p->acn_id, ACN_ID, sizeof(p->acn_id)) == 0 && htonl(p->root_vector) == E131_VECTOR_ROOT_EXTENDED && htonl(p->sync_vector) == 1;
+  }
+};
+
+struct IPAddress {
+  uint8_t a[4];
+  IPAddress(uint8_t a0 = 0, uint8_t a1 = 0, uint8_t a2 = 0, uint8_t a3 = 0) : a{a0, a1, a2, a3} {}
+  uint8_t operator[](int i) const { return a[i]; }
+};
+struct {
+  IPAddress localIP() { return IPAddress(192, 168, 1, 2); }
+  void localMAC(uint8_t* mac) { memset(mac, 0, 6); }
+} Network;
+struct {
+  void beginPacket(IPAddress, uint16_t) {}
+  void write(const uint8_t*, size_t) {}
+  void endPacket() {}
+} notifierUdp;
+struct { uint8_t staticIP[4]; } multiWiFi[1] = {};
+struct Toki {
+  struct Time { uint32_t sec; uint16_t ms; };
+  uint8_t getTimeSource() { return 0; }
+  Time getTime() { return {0, 0}; }
+} toki;
+inline size_t strlcpy(char* dst, const char* src, size_t size) {
+  const size_t len = strlen(src);
+  if (size) { const size_t n = len < size ? len : size - 1; memcpy(dst, src, n); dst[n] = 0; }
+  return len;
+}
+
+// strip with one segment, pixels set by realtime data are recorded
+#define STRIP_LEDS 400
+struct Segment {
+  uint8_t mode = 0, speed = 0, intensity = 0, palette = 0, map1D2D = 0, opacity = 255;
+  bool reverse = false, reverse_y = false, mirror = false, mirror_y = false, transpose = false;
+  uint32_t colors[3] = {};
+  void setMode(uint8_t m) { mode = m; }
+  void setPalette(uint8_t p) { palette = p; }
+  void setColor(uint8_t slot, uint32_t c) { colors[slot] = c; }
+  void setOpacity(uint8_t o) { opacity = o; }
+};
+struct {
+  Segment segment;
+  unsigned getLengthTotal() const { return STRIP_LEDS; }
+  unsigned getSegmentsNum() const { return 1; }
+  Segment& getSegment(unsigned) { return segment; }
+  unsigned getModeCount() const { return 200; }
+  void setBrightness(uint8_t, bool = false) {}
+} strip;
+static uint32_t stripPixels[STRIP_LEDS];
+static unsigned pixelsSet;
+
+// wled.h
+const char versionString[] = "0.16.0";
+char serverDescription[33] = "WLED";
+byte bri = 128, realtimeMode = REALTIME_MODE_INACTIVE, realtimeOverride = REALTIME_OVERRIDE_NONE;
+IPAddress realtimeIP;
+uint16_t realtimeTimeoutMs = 2500;
+uint16_t e131Universe = 1, DMXAddress = 1, DMXSegmentSpacing = 0, pollReplyCount = 0;
+byte e131Priority = 0, e131MergeMode = E131_MERGE_LTP, DMXMode = DMX_MODE_MULTIPLE_RGB;
+byte e131LastSequenceNumber[E131_MAX_UNIVERSE_COUNT];
+bool e131SkipOutOfSequence = false, ddpTimecodeSync = false, e131NewData = false;
+int8_t currentPreset = -1, currentPlaylist = -1;
+byte presetCycCurr = 0;
+
+// fcn_declare.h
+void handleE131FrameUniverse(uint8_t index, uint8_t* data, uint16_t channels, uint8_t mode);
+void handleDDPFrame(const uint32_t* pixels, unsigned start, unsigned stop);
+void handleDMXData(uint16_t uni, uint16_t dmxChannels, uint8_t* e131_data, uint8_t mde, uint8_t previousUniverses);
+E131FrameAssembler e131Frames(handleE131FrameUniverse);
+E131SourceMerger e131Sources;
+DDPFrameBuffer ddpFrames(handleDDPFrame);
+void realtimeLock(uint32_t, byte md) { realtimeMode = md; }
+void setRealtimePixel(uint16_t i, byte r, byte g, byte b, byte w) { if (i < STRIP_LEDS) stripPixels[i] = RGBW32(r, g, b, w); pixelsSet++; }
+void applyPreset(byte, byte) {}
+void stateUpdated(byte) {}
+
+#include "e131.cpp"
+
+// E1.31 data packet: LED k of a universe is (universe, frame, k)
+static void sendE131(uint16_t universe, uint8_t frame, uint8_t seq, uint16_t syncAddress = 0) {
+  static e131_packet_t p;
+  memset(&p, 0, sizeof(p));
+  memcpy(p.acn_id, ACN_ID, sizeof(ACN_ID));
+  p.root_vector = htonl(4);
+  p.frame_vector = htonl(2);
+  memset(p.cid, 0x5A, sizeof(p.cid));
+  p.priority = 100;
+  p.sync_address = htons(syncAddress);
+  p.sequence_number = seq;
+  p.universe = htons(universe);
+  p.dmp_vector = 2;
+  p.property_value_count = htons(E131_SLOT_SIZE);
+  for (unsigned k = 0; k < 170; k++) {
+    p.property_values[1 + 3*k] = universe;
+    p.property_values[2 + 3*k] = frame;
+    p.property_values[3 + 3*k] = k;
+  }
+  handleE131Packet(&p, IPAddress(10, 0, 0, 1), P_E131);
+}
+
+static void sendE131Sync(uint16_t syncAddress) {
+  static e131_packet_t p;
+  memset(&p, 0, sizeof(p));
+  memcpy(p.acn_id, ACN_ID, sizeof(ACN_ID));
+  p.root_vector = htonl(E131_VECTOR_ROOT_EXTENDED);
+  p.sync_vector = htonl(1);
+  p.sync_universe = htons(syncAddress);
+  handleE131Packet(&p, IPAddress(10, 0, 0, 1), P_E131);
+}
+
+static bool stripShows(uint8_t frame) {
+  return stripPixels[0] == RGBW32(10, frame, 0, 0) && stripPixels[169] == RGBW32(10, frame, 169, 0)
+      && stripPixels[170] == RGBW32(11, frame, 0, 0) && stripPixels[STRIP_LEDS - 1] == RGBW32(12, frame, 59, 0);
+}
+
+// 400 LEDs starting at universe 10: 170 + 170 + 60 LEDs, shown once the frame is complete or synchronized
+void test_packet_handler(void) {
+  e131Universe = 10;
+  hostMillis = 1000;
+  sendE131(9, 1, 1);                 // below the first universe
+  sendE131(10 + E131_MAX_UNIVERSE_COUNT, 1, 1);
+  TEST_ASSERT_FALSE(e131Frames.isActive());
+  sendE131(11, 1, 1);
+  sendE131(10, 1, 1);
+  TEST_ASSERT_TRUE(e131Frames.isActive());
+  TEST_ASSERT_EQUAL(3, e131Frames.getUniverses());
+  TEST_ASSERT_EQUAL(0, pixelsSet);
+  sendE131(12, 1, 1);
+  TEST_ASSERT_EQUAL(STRIP_LEDS, pixelsSet);
+  TEST_ASSERT_TRUE(stripShows(1));
+  TEST_ASSERT_EQUAL(REALTIME_MODE_E131, realtimeMode);
+  TEST_ASSERT_TRUE(e131NewData);
+  TEST_ASSERT_EQUAL(1, e131Frames.stats.outOfOrder);
+
+  // synchronized sender: free run until the first sync packet, then frames wait for it
+  for (uint16_t u = 10; u <= 12; u++) sendE131(u, 2, 2, 7);
+  TEST_ASSERT_TRUE(stripShows(2));
+  sendE131Sync(7);
+  hostMillis += 20;
+  pixelsSet = 0;
+  for (uint16_t u = 10; u <= 12; u++) sendE131(u, 3, 3, 7);
+  e131SkipOutOfSequence = true;
+  sendE131(10, 2, 2, 7);             // late
+  TEST_ASSERT_EQUAL(0, pixelsSet);
+  sendE131Sync(8);                   // other synchronization universe
+  TEST_ASSERT_EQUAL(0, pixelsSet);
+  sendE131Sync(7);
+  TEST_ASSERT_EQUAL(STRIP_LEDS, pixelsSet);
+  TEST_ASSERT_TRUE(stripShows(3));
+  TEST_ASSERT_EQUAL(2, e131Frames.stats.syncPackets);
+
+  // sync lost: the frame is shown by the timeout handler in loop()
+  pixelsSet = 0;
+  sendE131(10, 4, 4, 7);
+  hostMillis += E131_SYNC_TIMEOUT + E131_FRAME_TIMEOUT + 1;
+  handleE131Timeouts();
+  TEST_ASSERT_EQUAL(170, pixelsSet);
+  TEST_ASSERT_EQUAL(RGBW32(10, 4, 0, 0), stripPixels[0]);
+  TEST_ASSERT_EQUAL(RGBW32(11, 3, 0, 0), stripPixels[170]);
+}
+
+int main(void) {
+  UNITY_BEGIN();
+  RUN_TEST(test_begin);
+  RUN_TEST(test_complete_and_reordered);
+  RUN_TEST(test_loss_and_late);
+  RUN_TEST(test_artnet_no_sequence);
+  RUN_TEST(test_timeout);
+  RUN_TEST(test_sync);
+  RUN_TEST(test_packet_handler);
+  return UNITY_END();
+}
@@ -0,0 +1,179 @@
+// E1.31 multi-source handling (wled00/e131_sources.h): priority, sequence, timeout and HTP/LTP merge
+#include <unity.h>
+#include "wled_host.h"
+#define E131_MAX_UNIVERSE_COUNT 12   // const.h
+#include "e131_sources.h"
+
+#define CHANNELS 6
+
+static E131SourceMerger *m;
+static uint8_t cid[E131_MAX_SOURCES + 2][16];
+static uint8_t seq[E131_MAX_SOURCES + 2];
+
+// packet of source <src> with all channels set to <level> unless given, returns merged data (without start code) or nullptr
+static const uint8_t *packet(unsigned src, uint8_t priority, unsigned long now, const uint8_t *levels = nullptr, uint8_t level = 0, uint16_t channels = CHANNELS, uint8_t options = 0) {
+  static uint8_t data[513];
+  data[0] = 0;
+  for (unsigned c = 1; c <= channels; c++) data[c] = levels ? levels[c-1] : level;
+  uint16_t ch = channels;
+  const uint8_t *out = m->merge(0, cid[src], priority, ++seq[src], options, data, ch, now);
+  return out ? out + 1 : nullptr;
+}
+
+void setUp(void) {
+  m = new E131SourceMerger();
+  for (unsigned i = 0; i < sizeof(cid) / 16; i++) { memset(cid[i], 0, 16); cid[i][0] = i + 1; seq[i] = 0; }
+}
+void tearDown(void) { delete m; }
+
+void test_priority(void) {
+  TEST_ASSERT_NOT_NULL(packet(0, 100, 0, nullptr, 10));
+  TEST_ASSERT_NOT_NULL(packet(1, 150, 10, nullptr, 20)); // higher priority takes over
+  TEST_ASSERT_NULL(packet(0, 100, 20, nullptr, 10));     // lower priority ignored
+  TEST_ASSERT_EQUAL(150, m->getPriority(0));
+  TEST_ASSERT_EQUAL(2, m->getSourceCount(0));
+  m->minPriority = 200;
+  TEST_ASSERT_NULL(packet(1, 150, 30, nullptr, 20));
+}
+
+// late and duplicate packets are only discarded if skipOutOfSequence is set
+void test_sequence(void) {
+  TEST_ASSERT_NOT_NULL(packet(0, 100, 0));
+  seq[0]--;
+  TEST_ASSERT_NOT_NULL(packet(0, 100, 1));
+  TEST_ASSERT_EQUAL(0, m->stats.late);
+  m->skipOutOfSequence = true;
+  seq[0]--;                                   // duplicate
+  TEST_ASSERT_NULL(packet(0, 100, 1));
+  seq[0] -= 5;                                // late
+  TEST_ASSERT_NULL(packet(0, 100, 2));
+  seq[0] += 100;                              // jump ahead
+  TEST_ASSERT_NOT_NULL(packet(0, 100, 3));
+  TEST_ASSERT_EQUAL(2, m->stats.late);
+  const uint8_t out = m->getSequence(0);
+  TEST_ASSERT_NOT_NULL(packet(0, 100, 4));
+  TEST_ASSERT_EQUAL(uint8_t(out + 1), m->getSequence(0));
+}
+
+// lower priority source takes over after the higher one terminates or times out (also without packets of others)
+void test_terminate_and_timeout(void) {
+  packet(0, 100, 0);
+  packet(1, 150, 0);
+  TEST_ASSERT_NULL(packet(1, 150, 10, nullptr, 0, CHANNELS, E131_OPTION_TERMINATED));
+  TEST_ASSERT_EQUAL(1, m->stats.sourcesTerminated);
+  TEST_ASSERT_NOT_NULL(packet(0, 100, 20));
+  packet(1, 150, 30);
+  packet(0, 100, 30);
+  m->expire(30 + E131_SOURCE_TIMEOUT);
+  TEST_ASSERT_EQUAL(2, m->getSourceCount(0));
+  m->expire(30 + E131_SOURCE_TIMEOUT + 1);    // loop(): both sources lost although no packet arrived
+  TEST_ASSERT_EQUAL(0, m->getSourceCount(0));
+  TEST_ASSERT_EQUAL(2, m->stats.sourcesLost);
+  TEST_ASSERT_NOT_NULL(packet(0, 100, 5000));  // source that returns is accepted again
+}
+
+// table full: new sources are rejected unless they replace one of lower priority
+void test_table_full(void) {
+  for (unsigned i = 0; i < E131_MAX_SOURCES; i++) packet(i, 100, 0);
+  TEST_ASSERT_NULL(packet(E131_MAX_SOURCES, 100, 1));
+  TEST_ASSERT_EQUAL(1, m->stats.rejected);
+  TEST_ASSERT_NOT_NULL(packet(E131_MAX_SOURCES + 1, 120, 2));
+  TEST_ASSERT_EQUAL(E131_MAX_SOURCES, m->getSourceCount(0));
+}
+
+void test_ltp(void) {
+  m->mergeMode = E131_MERGE_LTP;
+  packet(0, 100, 0, nullptr, 200);
+  const uint8_t *out = packet(1, 100, 1, nullptr, 50);
+  TEST_ASSERT_EQUAL(50, out[0]);
+}
+
+// HTP: every channel is the maximum over all active sources, a source lowering its level never goes below another one
+void test_htp_max_over_sources(void) {
+  m->mergeMode = E131_MERGE_HTP;
+  const uint8_t a1[CHANNELS] = {200, 10, 0, 255, 5, 100};
+  const uint8_t b1[CHANNELS] = {100, 50, 0, 0, 5, 150};
+  packet(0, 100, 0, a1);
+  const uint8_t *out = packet(1, 100, 1, b1);
+  const uint8_t max1[CHANNELS] = {200, 50, 0, 255, 5, 150};
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(max1, out, CHANNELS);
+  // A drops channel 1 below B: B's value is kept
+  const uint8_t a2[CHANNELS] = {20, 10, 0, 255, 5, 100};
+  out = packet(0, 100, 2, a2);
+  const uint8_t max2[CHANNELS] = {100, 50, 0, 255, 5, 150};
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(max2, out, CHANNELS);
+  // B drops too: A's values
+  const uint8_t b2[CHANNELS] = {0, 0, 0, 0, 0, 0};
+  out = packet(1, 100, 3, b2);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(a2, out, CHANNELS);
+  // a third source of lower priority does not take part
+  const uint8_t c[CHANNELS] = {255, 255, 255, 255, 255, 255};
+  TEST_ASSERT_NULL(packet(2, 50, 4, c));
+  out = packet(0, 100, 5, a2);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(a2, out, CHANNELS);
+  // B terminates: A alone
+  packet(1, 100, 6, nullptr, 0, CHANNELS, E131_OPTION_TERMINATED);
+  out = packet(0, 100, 7, a1);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(a1, out, CHANNELS);
+}
+
+// HTP with different channel counts: output covers the longest source
+void test_htp_channel_count(void) {
+  m->mergeMode = E131_MERGE_HTP;
+  uint16_t ch = 3;
+  uint8_t d[513] = {0, 10, 20, 30};
+  m->merge(0, cid[0], 100, ++seq[0], 0, d, ch, 0);
+  uint8_t e[513] = {0, 5, 5, 5, 40, 50};
+  ch = 5;
+  const uint8_t *out = m->merge(0, cid[1], 100, ++seq[1], 0, e, ch, 1);
+  TEST_ASSERT_EQUAL(5, ch);
+  const uint8_t expect[6] = {0, 10, 20, 30, 40, 50};
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(expect, out, 6);
+}
+
+// merge buffers: at most E131_MAX_HTP_UNIVERSES, freed when the last source of a universe is gone or LTP is selected
+void test_htp_buffer_limit(void) {
+  m->mergeMode = E131_MERGE_HTP;
+  uint8_t a[513] = {0, 200, 10}, b[513] = {0, 100, 50};
+  uint16_t ch;
+  for (unsigned u = 0; u <= E131_MAX_HTP_UNIVERSES; u++) {
+    ch = 2; m->merge(u, cid[0], 100, ++seq[0], 0, a, ch, 0);
+    ch = 2; const uint8_t *out = m->merge(u, cid[1], 100, ++seq[1], 0, b, ch, 1);
+    if (u < E131_MAX_HTP_UNIVERSES) TEST_ASSERT_EQUAL(50, out[2]); // merged
+    else {
+      TEST_ASSERT_EQUAL_PTR(b, out);                                // no buffer left: LTP
+      TEST_ASSERT_EQUAL(2, m->stats.htpOverflow);
+    }
+  }
+  // sources of universe 0 terminate and time out: its buffer goes to the next universe that needs one
+  ch = 2; m->merge(0, cid[0], 100, ++seq[0], E131_OPTION_TERMINATED, a, ch, 10);
+  m->expire(1 + E131_SOURCE_TIMEOUT + 1);
+  TEST_ASSERT_EQUAL(0, m->getSourceCount(0));
+  const unsigned last = E131_MAX_HTP_UNIVERSES;
+  ch = 2; m->merge(last, cid[0], 100, ++seq[0], 0, a, ch, 5000);
+  ch = 2; const uint8_t *out = m->merge(last, cid[1], 100, ++seq[1], 0, b, ch, 5001);
+  TEST_ASSERT_EQUAL(200, out[1]);
+  TEST_ASSERT_EQUAL(50, out[2]);
+  // LTP releases the buffer
+  m->mergeMode = E131_MERGE_LTP;
+  ch = 2; TEST_ASSERT_EQUAL_PTR(a, m->merge(last, cid[0], 100, ++seq[0], 0, a, ch, 5002));
+  m->mergeMode = E131_MERGE_HTP;
+  ch = 2; out = m->merge(last, cid[1], 100, ++seq[1], 0, b, ch, 5003); // kept data was released with the buffer
+  TEST_ASSERT_EQUAL(100, out[1]);
+  ch = 2; out = m->merge(last, cid[0], 100, ++seq[0], 0, a, ch, 5004);
+  TEST_ASSERT_EQUAL(200, out[1]);
+  TEST_ASSERT_EQUAL(50, out[2]);
+}
+
+int main(void) {
+  UNITY_BEGIN();
+  RUN_TEST(test_priority);
+  RUN_TEST(test_sequence);
+  RUN_TEST(test_terminate_and_timeout);
+  RUN_TEST(test_table_full);
+  RUN_TEST(test_ltp);
+  RUN_TEST(test_htp_max_over_sources);
+  RUN_TEST(test_htp_channel_count);
+  RUN_TEST(test_htp_buffer_limit);
+  return UNITY_END();
+}
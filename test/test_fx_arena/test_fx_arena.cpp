@@ -0,0 +1,189 @@
+// effect data arena (wled00/fx_arena.h): allocation, compaction and fragmentation stress
+#include <unity.h>
+#include <stdio.h>
+#include "wled_host.h"
+#include "fx_arena.h"
+
+#define SEGMENTS  32
+#define DATA_MAX  (64*1024)                                                   // MAX_SEGMENT_DATA (ESP32)
+#define ARENA     (DATA_MAX + 2 * SEGMENTS * FX_ARENA_BLOCK_OVERHEAD)         // WLED_FX_ARENA_SIZE default
+
+struct Owner {
+  uint8_t *data = nullptr;
+  size_t   len  = 0;
+  uint8_t  tag  = 0;
+};
+
+static uint32_t rnd = 1;
+static uint32_t nextRandom() { rnd ^= rnd << 13; rnd ^= rnd >> 17; rnd ^= rnd << 5; return rnd; }
+
+static void fill(Owner &o) { for (size_t i = 0; i < o.len; i++) o.data[i] = uint8_t(o.tag + i); }
+static bool intact(const Owner &o) {
+  for (size_t i = 0; i < o.len; i++) if (o.data[i] != uint8_t(o.tag + i)) return false;
+  return true;
+}
+
+void setUp(void) { rnd = 1; }
+void tearDown(void) {}
+
+void test_allocate_release(void) {
+  EffectDataArena arena(1024);
+  TEST_ASSERT_EQUAL(0, arena.capacity()); // not allocated before first use
+  Owner a, b;
+  a.data = arena.allocate(100, &a.data);
+  TEST_ASSERT_NOT_NULL(a.data);
+  for (int i = 0; i < 100; i++) TEST_ASSERT_EQUAL(0, a.data[i]); // cleared
+  b.data = arena.allocate(100, &b.data);
+  TEST_ASSERT_NOT_NULL(b.data);
+  TEST_ASSERT_EQUAL(1024, arena.capacity());
+  TEST_ASSERT_TRUE(arena.used() >= 200);
+  arena.release(b.data);
+  arena.release(b.data); // double free is ignored
+  arena.release(a.data);
+  TEST_ASSERT_EQUAL(0, arena.used());
+  TEST_ASSERT_EQUAL(0, arena.top());
+  TEST_ASSERT_NULL(arena.allocate(0, &a.data));
+  TEST_ASSERT_NULL(arena.allocate(2000, &a.data));
+}
+
+// a request that fits into the free space but not into a hole compacts the arena and moves the owners' data
+void test_compaction_moves_owners(void) {
+  EffectDataArena arena(4096);
+  Owner o[8];
+  for (int i = 0; i < 8; i++) {
+    o[i].len = 400;
+    o[i].tag = i * 17;
+    o[i].data = arena.allocate(o[i].len, &o[i].data);
+    TEST_ASSERT_NOT_NULL(o[i].data);
+    fill(o[i]);
+  }
+  for (int i = 0; i < 8; i += 2) { arena.release(o[i].data); o[i].data = nullptr; } // four 400 byte holes
+  Owner big;
+  big.len = 1500;
+  big.data = arena.allocate(big.len, &big.data);
+  TEST_ASSERT_NOT_NULL(big.data);
+  TEST_ASSERT_EQUAL(1, arena.compactions());
+  for (int i = 1; i < 8; i += 2) TEST_ASSERT_TRUE(intact(o[i]));
+}
+
+// moving the owner (Segment move constructor) must be followed by rebind()
+void test_rebind(void) {
+  EffectDataArena arena(2048);
+  Owner x, a, moved;
+  x.len = a.len = 600;
+  a.tag = 3;
+  x.data = arena.allocate(x.len, &x.data);
+  a.data = arena.allocate(a.len, &a.data);
+  fill(a);
+  moved = a;
+  a.data = nullptr;
+  arena.rebind(moved.data, &moved.data);
+  const uint8_t *before = moved.data;
+  arena.release(x.data); // hole in front of the moved block
+  Owner d;
+  d.data = arena.allocate(1200, &d.data); // fits only after compaction
+  TEST_ASSERT_NOT_NULL(d.data);
+  TEST_ASSERT_EQUAL(1, arena.compactions());
+  TEST_ASSERT_TRUE(moved.data != before);
+  TEST_ASSERT_TRUE(intact(moved));
+}
+
+// the default size has room for the block headers: segments using the whole data limit fit
+void test_headroom_for_headers(void) {
+  Owner seg[SEGMENTS], copy[SEGMENTS];
+  EffectDataArena arena(ARENA);
+  for (int i = 0; i < SEGMENTS; i++) {
+    seg[i].data = arena.allocate(DATA_MAX / (2 * SEGMENTS) - 1, &seg[i].data);   // odd sizes need padding
+    copy[i].data = arena.allocate(DATA_MAX / (2 * SEGMENTS) - 1, &copy[i].data); // transition copies
+    TEST_ASSERT_NOT_NULL(seg[i].data);
+    TEST_ASSERT_NOT_NULL(copy[i].data);
+  }
+  // the limit without headroom would not hold them
+  Owner o[SEGMENTS];
+  EffectDataArena tight(DATA_MAX);
+  int fits = 0;
+  for (int i = 0; i < SEGMENTS; i++) if ((o[i].data = tight.allocate(DATA_MAX / SEGMENTS - 1, &o[i].data))) fits++;
+  TEST_ASSERT_LESS_THAN(SEGMENTS, fits);
+}
+
+// random effect changes over 1M alloc/free cycles in epochs: every request within the data limit succeeds, requests
+// beyond the free space fail without touching the arena, no data is lost during compaction, and the largest free block
+// (without compaction) is recorded; at the end of every epoch all free space can still be allocated as one block
+void test_fragmentation_stress(void) {
+  EffectDataArena arena(ARENA);
+  Owner o[2 * SEGMENTS];
+  size_t dataUsed = 0;
+  const unsigned epochs = 10, cycles = 100000;
+  unsigned allocations = 0, failures = 0, rejected = 0;
+  double firstAvg = 0;
+  for (unsigned epoch = 0; epoch < epochs; epoch++) {
+    unsigned epochFailures = 0;
+    size_t epochMin = ARENA;
+    double epochSum = 0;
+    for (unsigned cycle = 0; cycle < cycles; cycle++) {
+      Owner &x = o[nextRandom() % (2 * SEGMENTS)];
+      if (x.data) {
+        TEST_ASSERT_TRUE(intact(x));
+        arena.release(x.data);
+        x.data = nullptr;
+        dataUsed -= x.len;
+      } else {
+        // mostly small effect data, sometimes large (particle systems, 2D effects)
+        x.len = nextRandom() % 8 ? 1 + nextRandom() % 512 : 1 + nextRandom() % 8192;
+        x.tag = nextRandom();
+        if (dataUsed + x.len > DATA_MAX) {
+          // rejected by the MAX_SEGMENT_DATA check in allocateData(); more than the free space fails cleanly here
+          const size_t used = arena.used(), top = arena.top();
+          uint8_t *p = arena.allocate(arena.capacity() - arena.used() + 1, &x.data);
+          TEST_ASSERT_NULL(p);
+          TEST_ASSERT_NULL(x.data);
+          TEST_ASSERT_EQUAL(used, arena.used());
+          TEST_ASSERT_EQUAL(top, arena.top());
+          rejected++;
+        } else {
+          x.data = arena.allocate(x.len, &x.data);
+          if (!x.data) { epochFailures++; continue; }
+          fill(x);
+          dataUsed += x.len;
+          allocations++;
+        }
+      }
+      const size_t largest = arena.largestFree();
+      if (largest < epochMin) epochMin = largest;
+      epochSum += largest;
+    }
+    // no lasting fragmentation: the whole free space is one allocation (after compaction)
+    Owner rest;
+    const size_t space = arena.capacity() - arena.used();
+    if (space > 64) {
+      rest.data = arena.allocate(space - 16, &rest.data);
+      TEST_ASSERT_NOT_NULL(rest.data);
+      arena.release(rest.data);
+    }
+    failures += epochFailures;
+    // fragmentation does not build up: the average largest free block stays at the level of the first epoch
+    if (!epoch) firstAvg = epochSum / cycles;
+    TEST_ASSERT_TRUE(epochSum / cycles > firstAvg / 2);
+    char msg[128];
+    snprintf(msg, sizeof(msg), "epoch %u: %u failures, largest free block min %u avg %.0f bytes, %u compactions",
+             epoch, epochFailures, unsigned(epochMin), epochSum / cycles, unsigned(arena.compactions()));
+    TEST_MESSAGE(msg);
+  }
+  for (auto &x : o) if (x.data) TEST_ASSERT_TRUE(intact(x));
+  TEST_ASSERT_EQUAL(0, failures);
+  TEST_ASSERT_GREATER_THAN(0, rejected);
+  TEST_ASSERT_GREATER_THAN(0, arena.compactions());
+  char msg[96];
+  snprintf(msg, sizeof(msg), "%u cycles: %u allocations, %u rejected, %u compactions", epochs * cycles, allocations, rejected, unsigned(arena.compactions()));
+  TEST_MESSAGE(msg);
+}
+
+int main(void) {
+  UNITY_BEGIN();
+  RUN_TEST(test_allocate_release);
+  RUN_TEST(test_compaction_moves_owners);
+  RUN_TEST(test_rebind);
+  RUN_TEST(test_headroom_for_headers);
+  RUN_TEST(test_fragmentation_stress);
+  return UNITY_END();
+}
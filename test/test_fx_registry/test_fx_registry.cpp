@@ -0,0 +1,258 @@
+// effect metadata registry (wled00/fx_registry.h): every _data_FX_MODE_* string of FX.cpp and the usermods is valid and
+// pre-parses to what the string parsers used before the registry (extractModeDefaults(), extractModeSlider()) read
+#include <unity.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <ctype.h>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <sstream>
+#include <filesystem>
+#include "wled_host.h"
+#include "fx_registry.h"
+
+struct FxString { std::string file, name, data; };
+static std::vector<FxString> fxStrings;
+
+// repository root, relative to this file
+static std::string rootPath() {
+  const std::string file = __FILE__;
+  const size_t slash = file.find_last_of('/');
+  return (slash == std::string::npos ? std::string() : file.substr(0, slash + 1)) + "../../";
+}
+
+// definitions "_data_FX_MODE_xxx[] PROGMEM = "..." "...";" of a source file (string literals may be split over lines)
+static void collect(const std::filesystem::path &path) {
+  std::ifstream in(path);
+  std::stringstream ss;
+  ss << in.rdbuf();
+  const std::string src = ss.str();
+  for (size_t pos = src.find("_data_FX_MODE_"); pos != std::string::npos; pos = src.find("_data_FX_MODE_", pos + 1)) {
+    const size_t bracket = src.find_first_not_of("ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789_", pos);
+    if (src.compare(bracket, 2, "[]") != 0) continue; // used, not defined
+    const size_t eq = src.find('=', bracket);
+    if (eq == std::string::npos || src.find("PROGMEM", bracket) > eq) continue;
+    std::string data;
+    size_t p = eq + 1;
+    while (true) {
+      p = src.find_first_not_of(" \t\r\n", p);
+      if (p == std::string::npos || src[p] != '"') break;
+      const size_t close = src.find('"', p + 1);
+      data += src.substr(p + 1, close - p - 1);
+      p = close + 1;
+    }
+    if (src.find_first_not_of(" \t\r\n", p) != src.find(';', p)) continue; // not a plain string literal
+    fxStrings.push_back({path.string(), src.substr(pos, bracket - pos), data});
+  }
+}
+
+static void collectAll() {
+  if (!fxStrings.empty()) return;
+  const std::string root = rootPath();
+  collect(root + "wled00/FX.cpp");
+  for (const auto &e : std::filesystem::recursive_directory_iterator(root + "usermods")) {
+    const std::string ext = e.path().extension().string();
+    if (e.is_regular_file() && (ext == ".cpp" || ext == ".h")) collect(e.path());
+  }
+}
+
+// util.cpp (before the registry): extractModeDefaults(), on the string instead of the mode id
+static int legacyDefault(const char *data, const char *segVar) {
+  char lineBuffer[256];
+  strncpy(lineBuffer, data, sizeof(lineBuffer) - 1);
+  lineBuffer[sizeof(lineBuffer) - 1] = '\0';
+  if (lineBuffer[0] == 0) return -1;
+  char *startPtr = strrchr(lineBuffer, ';');
+  if (!startPtr) return -1;
+  char *stopPtr = strstr(startPtr, segVar);
+  if (!stopPtr) return -1;
+  stopPtr += strlen(segVar) + 1;
+  return atoi(stopPtr);
+}
+
+// util.cpp (before the registry): extractModeSlider() label of slider/checkbox 0-7, with String replaced by std::string
+static std::string legacySlider(const std::string &lineBuffer, unsigned slider) {
+  static const char *defaults[] = {"FX Speed", "FX Intensity", "FX Custom 1", "FX Custom 2", "FX Custom 3"};
+  std::string dest;
+  const size_t start = lineBuffer.find('@');
+  const size_t stop  = start == std::string::npos ? std::string::npos : lineBuffer.find(';', start);
+  if (start != std::string::npos && start > 0 && stop != std::string::npos) {
+    const std::string names = lineBuffer.substr(start, stop - start);
+    long nameBegin = 1, nameEnd;
+    for (unsigned i = 0; i <= slider; i++) {
+      dest.clear();
+      if (nameBegin <= 0) break;
+      const size_t comma = names.find(',', nameBegin);
+      nameEnd = comma == std::string::npos ? -1 : long(comma);
+      if (i == slider) {
+        if (names[nameBegin] == '!') dest = slider < 5 ? defaults[slider] : "FX Custom";
+        else dest = nameEnd < 0 ? names.substr(nameBegin) : names.substr(nameBegin, nameEnd - nameBegin);
+      }
+      nameBegin = nameEnd + 1;
+    }
+    const size_t eq = dest.find('=');
+    if (eq != std::string::npos) dest.resize(eq);
+  } else if (slider < 2) {
+    dest = defaults[slider];
+  }
+  return dest;
+}
+
+// section n of the metadata split at ';' (empty if not given)
+static std::string section(const std::string &s, unsigned n) {
+  size_t p = s.find('@');
+  if (p == std::string::npos) return std::string();
+  p++;
+  for (unsigned i = 0; i < n; i++) {
+    p = s.find(';', p);
+    if (p == std::string::npos) return std::string();
+    p++;
+  }
+  return s.substr(p, s.find(';', p) - p);
+}
+
+static std::string field(const std::string &sec, unsigned k) {
+  size_t p = 0;
+  for (unsigned i = 0; i < k; i++) {
+    p = sec.find(',', p);
+    if (p == std::string::npos) return std::string();
+    p++;
+  }
+  return sec.substr(p, sec.find(',', p) - p);
+}
+
+static const char *keys[] = {
+#define FX_DEF_KEY(id, key) #key,
+  FX_DEFAULTS(FX_DEF_KEY)
+#undef FX_DEF_KEY
+};
+
+// compare a pre-parsed entry with the legacy parsers, returns number of differences (printed)
+static unsigned compare(const std::string &data, const EffectInfo &info, const char *what) {
+  unsigned diff = 0;
+  char msg[200];
+  auto report = [&](const char *field, int legacy, int parsed) {
+    snprintf(msg, sizeof(msg), "%s \"%.80s\": %s legacy %d, registry %d", what, data.c_str(), field, legacy, parsed);
+    TEST_MESSAGE(msg);
+    diff++;
+  };
+  const size_t at = data.find('@');
+  const unsigned nameLen = at == std::string::npos ? data.size() : at;
+  if (nameLen != info.nameLen) report("name length", nameLen, info.nameLen);
+  for (unsigned d = 0; d < FX_DEF_COUNT; d++) {
+    const int legacy = legacyDefault(data.c_str(), keys[d]);
+    if (legacy != info.getDefault(d)) report(keys[d], legacy, info.getDefault(d));
+  }
+  const bool hasData = at != std::string::npos;
+  if (hasData != bool(info.flags & FX_INFO_DATA)) report("metadata", hasData, info.flags & FX_INFO_DATA);
+  for (unsigned k = 0; k < 8; k++) {
+    const bool labelled = !legacySlider(data, k).empty();
+    if (labelled != bool(info.controls & (1 << k))) report(k < 5 ? "slider" : "checkbox", labelled, (info.controls >> k) & 1);
+  }
+  if (hasData) {
+    const std::string colors = section(data, 1), palette = section(data, 2), flags = section(data, 3);
+    for (unsigned k = 0; k < 3; k++) {
+      const bool labelled = !field(colors, k).empty();
+      if (labelled != bool(info.colors & (1 << k))) report("color", labelled, (info.colors >> k) & 1);
+    }
+    const bool usesPalette = !palette.empty() && !isdigit((unsigned char)palette[0]);
+    if (usesPalette != bool(info.flags & FX_INFO_PALETTE)) report("palette", usesPalette, info.flags & FX_INFO_PALETTE);
+    const bool is1D = flags.empty() || flags.find('1') != std::string::npos;
+    if (is1D != bool(info.flags & FX_INFO_1D)) report("1D", is1D, info.flags & FX_INFO_1D);
+    const char flagChars[] = {'0', '2', 'v', 'f'};
+    const uint8_t flagBits[] = {FX_INFO_0D, FX_INFO_2D, FX_INFO_VOLUME, FX_INFO_FREQUENCY};
+    for (unsigned k = 0; k < sizeof(flagChars); k++) {
+      const bool set = flags.find(flagChars[k]) != std::string::npos;
+      if (set != bool(info.flags & flagBits[k])) report("flag", set, info.flags & flagBits[k]);
+    }
+  } else {
+    if (info.flags != (FX_INFO_PALETTE | FX_INFO_1D)) report("default flags", FX_INFO_PALETTE | FX_INFO_1D, info.flags);
+  }
+  return diff;
+}
+
+static bool sameInfo(const EffectInfo &a, const EffectInfo &b) {
+  if (a.nameLen != b.nameLen || a.controls != b.controls || a.colors != b.colors || a.flags != b.flags) return false;
+  for (unsigned d = 0; d < FX_DEF_COUNT; d++) if (a.getDefault(d) != b.getDefault(d)) return false;
+  return true;
+}
+
+// FX.cpp: WS2812FX::addEffect(), metadata of effects added at runtime is truncated to the line buffer
+static EffectInfo addEffectInfo(const char *mode_name) {
+  char lineBuffer[256];
+  strncpy_P(lineBuffer, mode_name, sizeof(lineBuffer)-1);
+  lineBuffer[sizeof(lineBuffer)-1] = '\0';
+  return fxParse(lineBuffer);
+}
+
+void setUp(void) { collectAll(); }
+void tearDown(void) {}
+
+// constexpr evaluation (REGISTER_EFFECT) and runtime parsing (addEffect()) agree
+static constexpr char _data_juggle[] = "Juggle@!,Trail;!,!,;!;012;sx=16,ix=240";
+static constexpr EffectInfo _info_juggle = fxParse(_data_juggle);
+static_assert(fxValid(_data_juggle), "valid");
+static_assert(_info_juggle.nameLen == 6 && _info_juggle.controls == 0x03 && _info_juggle.colors == 0x03, "labels");
+static_assert(_info_juggle.getDefault(FX_DEF_SX) == 16 && _info_juggle.getDefault(FX_DEF_IX) == 240 && _info_juggle.getDefault(FX_DEF_PAL) == -1, "defaults");
+static_assert(!fxValid("Bad@!;!;!;3"), "unknown flag");
+static_assert(!fxValid("Bad@!;!;!;1;sx=256"), "default out of range");
+static_assert(!fxValid("Bad@!;!;!;1;xx=1"), "unknown key");
+static_assert(!fxValid("@!;!;!"), "no name");
+
+void test_constexpr_matches_runtime(void) {
+  const EffectInfo info = fxParse(std::string(_data_juggle).c_str());
+  TEST_ASSERT_TRUE(sameInfo(_info_juggle, info));
+  TEST_ASSERT_EQUAL(0, compare(_data_juggle, _info_juggle, "Juggle"));
+}
+
+// every effect string of the tree is valid and parses like the legacy parsers read it
+void test_all_effect_strings(void) {
+  TEST_ASSERT_TRUE(fxStrings.size() > 200);
+  unsigned invalid = 0, diff = 0, usermods = 0;
+  char msg[200];
+  for (const FxString &fx : fxStrings) {
+    if (fx.file.find("usermods") != std::string::npos) usermods++;
+    if (!fxValid(fx.data.c_str())) {
+      snprintf(msg, sizeof(msg), "invalid %s (%s)", fx.name.c_str(), fx.file.c_str());
+      TEST_MESSAGE(msg);
+      invalid++;
+    }
+    diff += compare(fx.data, fxParse(fx.data.c_str()), fx.name.c_str());
+  }
+  snprintf(msg, sizeof(msg), "%u effect strings (%u in usermods), %u invalid, %u differences", unsigned(fxStrings.size()), usermods, invalid, diff);
+  TEST_MESSAGE(msg);
+  TEST_ASSERT_TRUE(usermods > 0);
+  TEST_ASSERT_EQUAL(0, invalid);
+  TEST_ASSERT_EQUAL(0, diff);
+}
+
+// effects added at runtime: every cut of a string over 255 characters parses like the legacy parsers (which read
+// the same 255 characters)
+void test_add_effect_truncation(void) {
+  std::string data = "Long@";
+  for (unsigned k = 0; k < 8; k++) data += std::string(k == 7 ? 0 : 32, 'a' + k) + (k < 7 ? "," : ";");
+  data += "Fg,Bg,Third;!;12vf;sx=16,ix=240,c1=3,c2=200,c3=31,o1=1,o2=0,o3=1,m12=2,si=1,rev=1,mi=1,rY=0,mY=1,pal=50";
+  TEST_ASSERT_TRUE(data.size() > 300);
+  unsigned diff = 0;
+  for (size_t len = 1; len <= data.size(); len++) {
+    const std::string cut = data.substr(0, len);
+    const EffectInfo info = addEffectInfo(cut.c_str());
+    diff += compare(cut.substr(0, 255), info, "cut");
+    const EffectInfo first = addEffectInfo(cut.substr(0, 255).c_str());
+    TEST_ASSERT_TRUE(sameInfo(first, info));
+  }
+  TEST_ASSERT_EQUAL(0, diff);
+  // the defaults section is lost beyond 255 characters
+  const EffectInfo full = addEffectInfo(data.c_str());
+  TEST_ASSERT_EQUAL(-1, full.getDefault(FX_DEF_PAL));
+  TEST_ASSERT_EQUAL(legacyDefault(data.c_str(), "sx"), full.getDefault(FX_DEF_SX));
+}
+
+int main(void) {
+  UNITY_BEGIN();
+  RUN_TEST(test_constexpr_matches_runtime);
+  RUN_TEST(test_all_effect_strings);
+  RUN_TEST(test_add_effect_truncation);
+  return UNITY_END();
+}
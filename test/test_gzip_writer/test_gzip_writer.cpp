@@ -0,0 +1,327 @@
+// streaming gzip compressor (wled00/gzip_writer.h) of the cached JSON responses: the decompressed cache content is
+// byte for byte the freshly generated response (/json/eff, /json/palx, /json/fxdata), ETag CRC and length match it
+#include <unity.h>
+#include <stdio.h>
+#include <string>
+#include <vector>
+#include "wled_host.h"
+#include "gzip_writer.h"
+#include "src/dependencies/json/ArduinoJson-v6.h"
+
+typedef std::vector<uint8_t> Bytes;
+
+static uint32_t rnd = 1;
+static uint32_t nextRandom() { rnd ^= rnd << 13; rnd ^= rnd >> 17; rnd ^= rnd << 5; return rnd; }
+
+static uint32_t crc32(const std::string &s) {
+  uint32_t crc = 0xFFFFFFFF;
+  for (unsigned char c : s) {
+    crc ^= c;
+    for (unsigned k = 0; k < 8; k++) crc = (crc >> 1) ^ (0xEDB88320UL & (0U - (crc & 1)));
+  }
+  return ~crc;
+}
+
+// inflate (RFC 1951, fixed Huffman blocks as written by GzipWriter) of a gzip stream (RFC 1952), false if malformed
+struct Inflater {
+  const Bytes &in;
+  size_t pos = 10;
+  uint32_t bitBuf = 0;
+  unsigned bitCnt = 0;
+  bool error = false;
+
+  explicit Inflater(const Bytes &gz) : in(gz) {}
+
+  unsigned bits(unsigned n) {
+    while (bitCnt < n) {
+      if (pos >= in.size()) { error = true; return 0; }
+      bitBuf |= uint32_t(in[pos++]) << bitCnt;
+      bitCnt += 8;
+    }
+    const unsigned v = bitBuf & ((1U << n) - 1);
+    bitBuf >>= n;
+    bitCnt -= n;
+    return v;
+  }
+
+  // canonical code with code lengths len[0..n-1], decoded bit by bit
+  struct Code { short count[16] = {}; short symbol[288] = {}; };
+  static void build(Code &c, const uint8_t *len, unsigned n) {
+    short offs[16] = {};
+    for (unsigned s = 0; s < n; s++) c.count[len[s]]++;
+    c.count[0] = 0;
+    for (unsigned l = 1; l < 15; l++) offs[l + 1] = offs[l] + c.count[l];
+    for (unsigned s = 0; s < n; s++) if (len[s]) c.symbol[offs[len[s]]++] = s;
+  }
+  int decode(const Code &c) {
+    int code = 0, first = 0, index = 0;
+    for (unsigned l = 1; l < 16; l++) {
+      code |= bits(1);
+      const int count = c.count[l];
+      if (code - count < first) return c.symbol[index + (code - first)];
+      index += count;
+      first = (first + count) << 1;
+      code <<= 1;
+    }
+    error = true;
+    return -1;
+  }
+
+  bool run(std::string &out) {
+    static const short lbase[29] = {3,4,5,6,7,8,9,10,11,13,15,17,19,23,27,31,35,43,51,59,67,83,99,115,131,163,195,227,258};
+    static const short lext[29]  = {0,0,0,0,0,0,0,0,1,1,1,1,2,2,2,2,3,3,3,3,4,4,4,4,5,5,5,5,0};
+    static const short dbase[30] = {1,2,3,4,5,7,9,13,17,25,33,49,65,97,129,193,257,385,513,769,1025,1537,2049,3073,4097,6145,8193,12289,16385,24577};
+    static const short dext[30]  = {0,0,0,0,1,1,2,2,3,3,4,4,5,5,6,6,7,7,8,8,9,9,10,10,11,11,12,12,13,13};
+    if (in.size() < 18 || in[0] != 0x1F || in[1] != 0x8B || in[2] != 8 || in[3] != 0) return false;
+    uint8_t len[288];
+    for (unsigned s = 0; s < 288; s++) len[s] = s < 144 ? 8 : s < 256 ? 9 : s < 280 ? 7 : 8;
+    Code lit, dist;
+    build(lit, len, 288);
+    for (unsigned s = 0; s < 30; s++) len[s] = 5;
+    build(dist, len, 30);
+    out.clear();
+    bool last;
+    do {
+      last = bits(1);
+      if (bits(2) != 1) return false;  // only fixed Huffman blocks are written
+      for (;;) {
+        const int sym = decode(lit);
+        if (error || sym < 0) return false;
+        if (sym < 256) { out += char(sym); continue; }
+        if (sym == 256) break;
+        if (sym > 285) return false;
+        const unsigned l = lbase[sym - 257] + bits(lext[sym - 257]);
+        const int ds = decode(dist);
+        if (error || ds < 0 || ds > 29) return false;
+        const unsigned d = dbase[ds] + bits(dext[ds]);
+        if (d > out.size()) return false;
+        for (unsigned k = 0; k < l; k++) out += out[out.size() - d];
+      }
+    } while (!last && !error);
+    if (error || pos + 8 != in.size()) return false;
+    const uint32_t crc = in[pos] | in[pos+1] << 8 | in[pos+2] << 16 | uint32_t(in[pos+3]) << 24;
+    const uint32_t isize = in[pos+4] | in[pos+5] << 8 | in[pos+6] << 16 | uint32_t(in[pos+7]) << 24;
+    return crc == crc32(out) && isize == out.size();
+  }
+};
+
+static Bytes output(const GzipWriter &gz) { return Bytes(gz.data(), gz.data() + gz.size()); }
+
+// compressed, decompressed and compared with the fresh response; crc() and inputSize() make the ETag
+static void checkCached(GzipWriter &gz, const std::string &fresh, const char *what) {
+  TEST_ASSERT_TRUE_MESSAGE(gz.finish(), what);
+  std::string inflated;
+  TEST_ASSERT_TRUE_MESSAGE(Inflater(output(gz)).run(inflated), what);
+  TEST_ASSERT_TRUE_MESSAGE(inflated == fresh, what);
+  TEST_ASSERT_EQUAL_HEX32(crc32(fresh), gz.crc());
+  TEST_ASSERT_EQUAL(fresh.size(), gz.inputSize());
+  char msg[96];
+  snprintf(msg, sizeof(msg), "%s: %u -> %u bytes", what, (unsigned)fresh.size(), (unsigned)gz.size());
+  TEST_MESSAGE(msg);
+}
+
+// effect metadata like FX.cpp (quotes and backslashes included to exercise escaping), "" is a reserved slot
+static std::vector<std::string> modeData() {
+  static const char *data[] = {
+    "Solid", "Blink@!,Duty cycle;!,!;!;01", "Breathe@!;!,!;!;01", "Wipe@!,!;!,!;!", "Wipe Random@!;;!", "",
+    "Copy Segment@,Color shift,Lighten,Brighten,ID,Axis(2D),FullStack(last frame);;;12;ix=0,c1=0,c2=0,c3=0",
+    "Fire 2012@Cooling,Spark rate,,2D Blur,Boost;;!;1;pal=35,sx=64,ix=160,m12=1,c2=128", "Scrolling Text@!,Y Offset,Trail,Font size,Rotate,Gradient,Overlay,Reverse;!,!,Gradient;!;2;ix=128,c1=0,rev=0,mi=0,rY=0,mY=0",
+    "Quote \"test\"@!;!;!", "Back\\slash@!", "Noise 1@!,Scale;;!;;pal=20", "DJ Light@Speed;;;01f;m12=2,si=0", "Diffusion Fire@!,Spark rate,Diffusion Speed,Turbulence,,Use palette;;Color;2;pal=35",
+  };
+  std::vector<std::string> v;
+  for (unsigned i = 0; i < 220; i++) {
+    std::string s = data[i % (sizeof(data) / sizeof(data[0]))];
+    if (i >= 14 && !s.empty()) s.insert(s.find('@') == std::string::npos ? s.size() : s.find('@'), " " + std::to_string(i));
+    v.push_back(s);
+  }
+  return v;
+}
+
+// json.cpp: writeJSONString()/writeJSONStringElement()
+static size_t writeJSONStringElement(uint8_t* dest, size_t maxLen, const char* src) {
+  size_t pos = 0;
+  auto emit = [&](char c) -> bool {
+    if (pos >= maxLen) return false;
+    dest[pos++] = (uint8_t)c;
+    return true;
+  };
+  if (!emit(',') || !emit('"')) return 0;
+  for (const char* p = src; *p; ++p) {
+    const char esc = ARDUINOJSON_NAMESPACE::EscapeSequence::escapeChar(*p);
+    if (esc ? !emit('\\') || !emit(esc) : !emit(*p)) return 0;
+  }
+  return emit('"') ? pos : 0;
+}
+
+// json.cpp: writeModeData() (cache) and the chunk callback of respondModeData() (fresh response)
+template<typename T> static void writeModeData(const std::vector<std::string> &modes, T& out) {
+  uint8_t element[2*256+3];
+  bool first = true;
+  out.write('[');
+  for (const std::string &m : modes) {
+    if (m.empty()) continue;
+    const char* dataPtr = strchr(m.c_str(), '@');
+    size_t len = writeJSONStringElement(element, sizeof(element), dataPtr ? dataPtr + 1 : "");
+    if (first) out.write(element + 1, len - 1);
+    else       out.write(element, len);
+    first = false;
+  }
+  out.write(']');
+}
+
+static std::string respondModeData(const std::vector<std::string> &modes) {
+  std::string response;
+  size_t fx_index = 0;
+  uint8_t chunk[1460];
+  while (fx_index <= modes.size()) {
+    size_t len = 64 + nextRandom() % (sizeof(chunk) - 64), bytes_written = 0;  // packet buffers of random size
+    uint8_t *data = chunk;
+    while (fx_index < modes.size()) {
+      if (!modes[fx_index].empty()) {
+        const char* dataPtr = strchr(modes[fx_index].c_str(), '@');
+        size_t mode_bytes = writeJSONStringElement(data, len, dataPtr ? dataPtr + 1 : "");
+        if (mode_bytes == 0) break;
+        if (fx_index == 0) *data = '[';
+        data += mode_bytes;
+        len -= mode_bytes;
+        bytes_written += mode_bytes;
+      }
+      ++fx_index;
+    }
+    if (fx_index == modes.size() && len >= 1) {
+      *data = ']';
+      ++bytes_written;
+      ++fx_index;
+    }
+    response.append((const char*)chunk, bytes_written);
+  }
+  return response;
+}
+
+struct StringWriter {
+  std::string s;
+  size_t write(uint8_t c) { s += char(c); return 1; }
+  size_t write(const uint8_t* b, size_t n) { s.append((const char*)b, n); return n; }
+};
+
+void setUp(void) { rnd = 1; }
+void tearDown(void) {}
+
+// /json/fxdata: cached stream vs chunked fresh response
+void test_fxdata(void) {
+  const std::vector<std::string> modes = modeData();
+  const std::string fresh = respondModeData(modes);
+  StringWriter direct;
+  writeModeData(modes, direct);
+  TEST_ASSERT_TRUE(direct.s == fresh);
+  GzipWriter gz;
+  TEST_ASSERT_TRUE(gz.begin());
+  writeModeData(modes, gz);
+  checkCached(gz, fresh, "fxdata");
+}
+
+// /json/eff: serializeModeNames() into the JSON document, serialized once into the writer
+void test_eff(void) {
+  DynamicJsonDocument doc(32768);
+  JsonArray arr = doc.to<JsonArray>();
+  for (const std::string &m : modeData()) if (!m.empty()) arr.add(m.substr(0, m.find('@')));
+  std::string fresh;
+  serializeJson(doc, fresh);
+  GzipWriter gz;
+  TEST_ASSERT_TRUE(gz.begin());
+  serializeJson(doc, gz);
+  checkCached(gz, fresh, "eff");
+}
+
+// /json/palx: pages of palette color previews like serializePalettes()
+void test_palx(void) {
+  DynamicJsonDocument doc(32768);
+  for (unsigned page = 0; page < 3; page++) {
+    JsonObject root = doc.to<JsonObject>();
+    root["m"] = 14;
+    JsonObject palettes = root.createNestedObject("p");
+    for (unsigned i = page * 5; i < page * 5 + 5; i++) {
+      JsonArray p = palettes.createNestedArray(std::to_string(i));
+      if (i % 4 == 0) { p.add("c1"); p.add("c2"); continue; }
+      for (unsigned j = 0; j < 16; j++) {
+        JsonArray c = p.createNestedArray();
+        c.add(j * 16); c.add((i * 37 + j * 11) & 255); c.add((i * 5 + j) & 255); c.add(255 - j);
+      }
+    }
+    std::string fresh;
+    serializeJson(doc, fresh);
+    GzipWriter gz;
+    TEST_ASSERT_TRUE(gz.begin());
+    serializeJson(doc, gz);
+    checkCached(gz, fresh, "palx page");
+  }
+}
+
+// output limit reached: not cached, but CRC and length of the response are valid for the ETag
+void test_output_limit(void) {
+  const std::vector<std::string> modes = modeData();
+  const std::string fresh = respondModeData(modes);
+  GzipWriter gz;
+  TEST_ASSERT_TRUE(gz.begin(128));
+  writeModeData(modes, gz);
+  TEST_ASSERT_TRUE(gz.failed());
+  TEST_ASSERT_FALSE(gz.finish());
+  TEST_ASSERT_EQUAL_HEX32(crc32(fresh), gz.crc());
+  TEST_ASSERT_EQUAL(fresh.size(), gz.inputSize());
+}
+
+// empty, random, repetitive and long input in single byte and large writes (window slides several times)
+void test_edge_cases(void) {
+  std::string in;
+  for (unsigned c = 0; c < 6; c++) {
+    switch (c) {
+      case 0: in.clear(); break;
+      case 1: in = "x"; break;
+      case 2: in.assign(100000, 'a'); break;
+      case 3: in.clear(); for (unsigned i = 0; i < 30000; i++) in += char(nextRandom()); break;
+      case 4: in.clear(); for (unsigned i = 0; i < 60000; i++) in += "0123456789abcdef"[nextRandom() % (i % 3000 < 1500 ? 16 : 2)]; break;
+      default: in.clear(); for (unsigned i = 0; i < 3000; i++) in += "{\"n\":" + std::to_string(i % 97) + ",\"v\":[1,2,3]},"; break;
+    }
+    for (unsigned single = 0; single < 2; single++) {
+      GzipWriter gz;
+      TEST_ASSERT_TRUE(gz.begin());
+      if (single) for (char ch : in) gz.write(uint8_t(ch));
+      else for (size_t p = 0; p < in.size(); p += 4096) gz.write((const uint8_t*)in.data() + p, in.size() - p < 4096 ? in.size() - p : 4096);
+      TEST_ASSERT_TRUE(gz.finish());
+      std::string out;
+      TEST_ASSERT_TRUE(Inflater(output(gz)).run(out));
+      TEST_ASSERT_TRUE(out == in);
+    }
+  }
+}
+
+// compression time of the largest cached response
+void test_benchmark(void) {
+  const std::vector<std::string> modes = modeData();
+  const unsigned rounds = 200;
+  size_t in = 0, out = 0;
+  const double t0 = hostSeconds();
+  for (unsigned i = 0; i < rounds; i++) {
+    GzipWriter gz;
+    gz.begin();
+    writeModeData(modes, gz);
+    gz.finish();
+    in = gz.inputSize();
+    out = gz.size();
+  }
+  const double t1 = hostSeconds();
+  char msg[96];
+  snprintf(msg, sizeof(msg), "fxdata %u -> %u bytes in %.2f ms", (unsigned)in, (unsigned)out, (t1 - t0) * 1e3 / rounds);
+  TEST_MESSAGE(msg);
+}
+
+int main(void) {
+  UNITY_BEGIN();
+  RUN_TEST(test_fxdata);
+  RUN_TEST(test_eff);
+  RUN_TEST(test_palx);
+  RUN_TEST(test_output_limit);
+  RUN_TEST(test_edge_cases);
+  RUN_TEST(test_benchmark);
+  return UNITY_END();
+}
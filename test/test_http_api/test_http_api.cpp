@@ -0,0 +1,187 @@
+// single pass HTTP API tokenizer (wled00/http_api.h): same parameters and values as the per parameter search of the
+// previous handleSet(), resulting state and throughput
+#include <unity.h>
+#include <stdio.h>
+#include <ctype.h>
+#include <string>
+#include <vector>
+#include "wled_host.h"
+
+// util.cpp (random values are the lower limit, so results are reproducible)
+static void parseNumber(const char* str, byte &val, byte minv = 0, byte maxv = 255) {
+  if (str == nullptr || str[0] == '\0') return;
+  if (str[0] == 'r') { val = minv; return; }
+  bool wrap = false;
+  if (str[0] == 'w' && strlen(str) > 1) { str++; wrap = true; }
+  if (str[0] == '~') {
+    int out = atoi(str + 1);
+    if (out == 0) {
+      if (str[1] == '0') return;
+      if (str[1] == '-') val = (int)(val - 1) < (int)minv ? maxv : ((int)maxv < val - 1 ? maxv : val - 1);
+      else               val = (int)(val + 1) > (int)maxv ? minv : ((int)minv > val + 1 ? minv : val + 1);
+    } else {
+      if (wrap && val == maxv && out > 0) out = minv;
+      else if (wrap && val == minv && out < 0) out = maxv;
+      else {
+        out += val;
+        if (out > maxv) out = maxv;
+        if (out < minv) out = minv;
+      }
+      val = out;
+    }
+    return;
+  } else if (minv == maxv && minv == 0) {
+    byte p1 = atoi(str);
+    const char* str2 = strchr(str, '~');
+    if (str2) {
+      byte p2 = atoi(++str2);
+      if (p2 > 0) {
+        while (isdigit(*(++str2)));
+        parseNumber(str2, val, p1, p2);
+        return;
+      }
+    }
+  }
+  val = atoi(str);
+}
+
+#include "http_api.h"
+
+// search patterns of the previous handleSet() (value at 3 characters after the match)
+struct Legacy { HttpApiKey key; const char* pattern; };
+static const Legacy legacy[] = {
+  {API_SM,"SM="}, {API_SS,"SS="}, {API_SV,"SV="}, {API_S,"&S="},  {API_S2,"S2="}, {API_GP,"GP="}, {API_SP,"SP="},
+  {API_RV,"RV="}, {API_MI,"MI="}, {API_SB,"SB="}, {API_SW,"SW="}, {API_PS,"PS="}, {API_P1,"P1="}, {API_P2,"P2="},
+  {API_PL,"PL="}, {API_NP,"NP"},  {API_A,"&A="},  {API_R,"&R="},  {API_G,"&G="},  {API_B,"&B="},  {API_W,"&W="},
+  {API_R2,"R2="}, {API_G2,"G2="}, {API_B2,"B2="}, {API_W2,"W2="}, {API_LX,"LX="}, {API_LY,"LY="}, {API_HU,"HU="},
+  {API_SA,"SA="}, {API_K,"&K="},  {API_CL,"CL="}, {API_C2,"C2="}, {API_C3,"C3="}, {API_SR,"SR"},  {API_SC,"SC"},
+  {API_FX,"FX="}, {API_SX,"SX="}, {API_IX,"IX="}, {API_FP,"FP="}, {API_X1,"X1="}, {API_X2,"X2="}, {API_X3,"X3="},
+  {API_M1,"M1="}, {API_M2,"M2="}, {API_M3,"M3="}, {API_FXD,"FXD="}, {API_OL,"OL="}, {API_M,"&M="}, {API_SN,"SN="},
+  {API_RN,"RN="}, {API_RD,"RD="}, {API_T,"&T="},  {API_ND,"&ND"}, {API_NL,"NL="}, {API_NT,"NT="}, {API_NF,"NF="},
+  {API_TT,"TT="}, {API_ST,"ST="}, {API_CT,"CT="}, {API_LO,"LO="}, {API_RB,"RB"},  {API_NM,"NM="}, {API_U0,"U0="},
+  {API_U1,"U1="}, {API_NN,"&NN"}, {API_IN,"IN"},
+};
+static const unsigned LEGACY_KEYS = sizeof(legacy) / sizeof(legacy[0]);
+
+// byte parameters set with updateVal() and their limits in handleSet()
+struct Update { HttpApiKey key; byte minv, maxv; };
+static const Update updates[] = {
+  {API_PL,0,0}, {API_A,0,255}, {API_R,0,255}, {API_G,0,255}, {API_B,0,255}, {API_W,0,255}, {API_R2,0,255}, {API_G2,0,255},
+  {API_B2,0,255}, {API_W2,0,255}, {API_FX,0,200}, {API_SX,0,255}, {API_IX,0,255}, {API_FP,0,70}, {API_X1,0,255},
+  {API_X2,0,255}, {API_X3,0,31}, {API_SN,0,255}, {API_RN,0,255},
+};
+
+static const char* legacyFind(const std::string &req, const char* pattern) {
+  const char* m = strstr(req.c_str(), pattern);
+  return m && m != req.c_str() ? m : nullptr; // indexOf() > 0
+}
+
+// parameters found, their values and the resulting state are those of the previous per parameter search
+static unsigned mismatches(const std::string &req) {
+  const HttpApiParams api(req.c_str());
+  unsigned bad = 0;
+  for (const Legacy &l : legacy) {
+    const char* m = legacyFind(req, l.pattern);
+    if (!m != !api.has(l.key)) { bad++; continue; }
+    if (!m || l.key == API_FXD) continue; // FXD: only presence is used
+    if (!strchr(l.pattern, '=')) { // flags: only the value of SR is used
+      if (l.key == API_SR && atoi(m + 2 < req.c_str() + req.size() ? m + 3 : "") != api.num(API_SR)) bad++;
+      continue;
+    }
+    if (strcmp(m + 3, api.value(l.key))) bad++;
+  }
+  for (const Update &u : updates) {
+    const char* pattern = nullptr;
+    for (const Legacy &l : legacy) if (l.key == u.key) pattern = l.pattern;
+    byte before = 100, after = 100;
+    const char* m = legacyFind(req, pattern);
+    if (m) parseNumber(m + strlen(pattern), before, u.minv, u.maxv);
+    if (api.update(u.key, after, u.minv, u.maxv) != (m != nullptr) || before != after) bad++;
+  }
+  return bad;
+}
+
+static const char* corpus[] = {
+  "win", "win&T=2", "win&A=128", "win&A=~10", "win&A=~-10", "win&A=r", "/win&FX=5&SX=200&IX=50&FP=3",
+  "win&R=255&G=0&B=0&W=10", "win&R2=1&G2=2&B2=3&W2=4", "win&CL=hFF0000&C2=h00FF00&C3=#0000FF", "win&CL=16711680",
+  "win&HU=16000&SA=200", "win&HU=16000&H2", "win&K=3000", "win&K=6500&K2", "win&SR=0", "win&SR=1", "win&SR", "win&SC",
+  "win&SM=1&SS=2&SV=2&S=0&S2=30&GP=2&SP=1&RV=1&MI=0&SB=128&SW=2", "win&PS=3", "win&PL=4", "win&PL=~&P1=1&P2=5",
+  "win&P1=1&P2=5&PL=~", "win&PL=1~5~", "win&NP", "win&FX=~&FXD=", "win&FX=r&FXD=1", "win&X1=1&X2=2&X3=3&M1=1&M2=0&M3=1",
+  "win&OL=1", "win&M=3", "win&SN=1&RN=0&RD=1", "win&T=0", "win&T=1&NN", "win&ND", "win&NL=10&ND", "win&NL=0",
+  "win&NL=30&NT=0&NF=2", "win&TT=700", "win&ST=1700000000", "win&CT=1800000000&NM=1", "win&LO=1", "win&LO=3",
+  "win&RB", "win&U0=5&U1=-3", "win&IN", "win&A=0&IN&NN", "win&FX=0&FX=5", "win&LX=100100100", "win&LY=201050050",
+  "win&FX=8&SX=128&IX=~20&FP=r&A=w~10", "win&&A=5", "win&A=", "win&T=2&A=128&CL=hFFAA00&FX=2&IN",
+};
+
+static uint32_t rnd = 1;
+static uint32_t nextRandom() { rnd ^= rnd << 13; rnd ^= rnd >> 17; rnd ^= rnd << 5; return rnd; }
+
+// well formed request with random parameters and values
+static std::string randomRequest() {
+  static const char* values[] = {"0", "1", "2", "128", "255", "~", "~-", "~10", "r", "w~1", "hFF00AA", "#10", "-5", "1~5~"};
+  std::string req = nextRandom() & 1 ? "win" : "/win";
+  const unsigned params = nextRandom() % 12;
+  for (unsigned j = 0; j < params; j++) {
+    const Legacy &l = legacy[nextRandom() % LEGACY_KEYS];
+    std::string name = l.pattern[0] == '&' ? l.pattern + 1 : l.pattern;
+    if (name.back() == '=') name.pop_back();
+    req += "&" + name;
+    if (strchr(l.pattern, '=') || nextRandom() & 1) req += std::string("=") + values[nextRandom() % 14];
+  }
+  return req;
+}
+
+void setUp(void) { rnd = 1; }
+void tearDown(void) {}
+
+void test_corpus(void) {
+  for (const char* req : corpus) TEST_ASSERT_EQUAL_MESSAGE(0, mismatches(req), req);
+}
+
+void test_random_requests(void) {
+  for (unsigned i = 0; i < 200000; i++) {
+    const std::string req = randomRequest();
+    TEST_ASSERT_EQUAL_MESSAGE(0, mismatches(req), req.c_str());
+  }
+}
+
+// names that are substrings of others, first occurrence wins, unknown and too long names are skipped
+void test_tokens(void) {
+  const HttpApiParams api("win&S2=30&S=5&FXD=&FX=7&FX=9&ABCD=1&SR&XYZ=3&A");
+  TEST_ASSERT_EQUAL(30, api.num(API_S2));
+  TEST_ASSERT_EQUAL(5, api.num(API_S));
+  TEST_ASSERT_TRUE(api.has(API_FXD));
+  TEST_ASSERT_EQUAL(7, api.num(API_FX));
+  TEST_ASSERT_TRUE(api.has(API_SR));
+  TEST_ASSERT_FALSE(api.has(API_A));  // not a flag, needs "="
+  TEST_ASSERT_EQUAL_STRING("S=5&FXD=&FX=7&FX=9&ABCD=1&SR&XYZ=3&A", api.value(API_S2) + 3);
+}
+
+// previous search (one scan per parameter) vs single pass
+void test_benchmark(void) {
+  std::vector<std::string> requests;
+  for (unsigned i = 0; i < 1000; i++) requests.push_back(randomRequest());
+  const unsigned rounds = 200;
+  volatile unsigned sink = 0;
+  double t0 = hostSeconds();
+  for (unsigned k = 0; k < rounds; k++) for (const std::string &r : requests) for (const Legacy &l : legacy) sink = sink + (legacyFind(r, l.pattern) != nullptr);
+  double t1 = hostSeconds();
+  for (unsigned k = 0; k < rounds; k++) for (const std::string &r : requests) {
+    const HttpApiParams api(r.c_str());
+    for (const Legacy &l : legacy) sink = sink + api.has(l.key);
+  }
+  double t2 = hostSeconds();
+  const double a = (t1 - t0) * 1e9 / (rounds * requests.size()), b = (t2 - t1) * 1e9 / (rounds * requests.size());
+  char msg[96];
+  snprintf(msg, sizeof(msg), "per parameter search %.0f ns/request, single pass %.0f ns/request", a, b);
+  TEST_MESSAGE(msg);
+}
+
+int main(void) {
+  UNITY_BEGIN();
+  RUN_TEST(test_corpus);
+  RUN_TEST(test_random_requests);
+  RUN_TEST(test_tokens);
+  RUN_TEST(test_benchmark);
+  return UNITY_END();
+}
@@ -0,0 +1,213 @@
+// binary live view stream (wled00/live_stream.h): decoded frames match the quantised pixels for all formats, steps and
+// typical content, key frames after failures and at the interval, compression and encoding time
+#include <unity.h>
+#include <stdio.h>
+#include <math.h>
+#include <vector>
+#include "wled_host.h"
+#include "live_stream.h"
+
+typedef std::vector<uint8_t> Bytes;
+
+static uint32_t rnd = 1;
+static uint32_t nextRandom() { rnd ^= rnd << 13; rnd ^= rnd >> 17; rnd ^= rnd << 5; return rnd; }
+
+// decoder of the peek view (common.js)
+struct Decoder {
+  std::vector<uint32_t> frame;
+  unsigned w = 0, h = 0, bpp = 3;
+  uint8_t seq = 0;
+  bool have = false;
+  bool key = false;
+
+  bool decode(const Bytes &m) {
+    if (m.size() < LIVE_HEADER || m[0] != 'L' || m[1] != 3) return false;
+    key = m[2] & LIVE_FLAG_KEY;
+    const unsigned fmt = (m[2] >> 1) & 3;
+    bpp = fmt == LIVE_FMT_RGB888 ? 3 : fmt == LIVE_FMT_RGB565 ? 2 : 1;
+    const unsigned nw = (m[4] << 8) | m[5], nh = (m[6] << 8) | m[7];
+    if (!key && (!have || m[3] != uint8_t(seq + 1) || nw != w || nh != h)) return false;  // delta frame without its base
+    w = nw;
+    h = nh;
+    seq = m[3];
+    frame.resize(w * h);
+    if (key) std::fill(frame.begin(), frame.end(), 0);
+    size_t p = LIVE_HEADER;
+    unsigned i = 0;
+    auto read = [&](uint32_t &v) {
+      if (p + bpp > m.size()) return false;
+      v = 0;
+      for (unsigned k = 0; k < bpp; k++) v = (v << 8) | m[p++];
+      return true;
+    };
+    while (i < w * h) {
+      if (p >= m.size()) return false;
+      const uint8_t c = m[p++];
+      uint32_t v = 0;
+      const unsigned count = c < 128 ? c + 1 : c - 126;
+      if (c >= 128 && !read(v)) return false;
+      for (unsigned k = 0; k < count; k++) {
+        if (i >= w * h || (c < 128 && !read(v))) return false;
+        frame[i++] ^= v;
+      }
+    }
+    have = true;
+    return p == m.size();
+  }
+};
+
+// quantisation as documented in live_stream.h
+static uint32_t quantise(uint32_t c, unsigned fmt, uint8_t bri = 255) {
+  const unsigned w = c >> 24;
+  unsigned r = ((c >> 16) & 0xFF) + w, g = ((c >> 8) & 0xFF) + w, b = (c & 0xFF) + w;
+  r = r > 255 ? 255 : r;
+  g = g > 255 ? 255 : g;
+  b = b > 255 ? 255 : b;
+  if (bri < 255) { r = r * (bri + 1) >> 8; g = g * (bri + 1) >> 8; b = b * (bri + 1) >> 8; }
+  if (fmt == LIVE_FMT_RGB565) return ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3);
+  if (fmt == LIVE_FMT_RGB332) return (r & 0xE0) | ((g & 0xE0) >> 3) | (b >> 6);
+  return (r << 16) | (g << 8) | b;
+}
+
+static uint32_t hue(float deg) {
+  const float h = fmodf(deg, 360) / 60;
+  const int i = int(h);
+  const uint8_t a = 255 * (1 - (h - i)), b = 255 * (h - i);
+  switch (i) {
+    case 0:  return 0xFF0000 | (b << 8);
+    case 1:  return (a << 16) | 0xFF00;
+    case 2:  return 0xFF00 | b;
+    case 3:  return (a << 8) | 0xFF;
+    case 4:  return (b << 16) | 0xFF;
+    default: return 0xFF0000 | a;
+  }
+}
+
+// measure(), allocate, encode() like sendLiveStreamWs()
+static Bytes send(LiveStreamEncoder &enc, const std::vector<uint32_t> &px, uint8_t bri = 255) {
+  Bytes buf(enc.measure(px.data(), bri));
+  const size_t len = enc.encode(px.data(), bri, buf.data(), buf.size());
+  TEST_ASSERT_EQUAL(buf.size(), len);
+  return buf;
+}
+
+static bool matches(const Decoder &dec, const std::vector<uint32_t> &px, unsigned width, unsigned step, unsigned fmt, uint8_t bri = 255) {
+  for (unsigned y = 0; y < dec.h; y++) for (unsigned x = 0; x < dec.w; x++)
+    if (dec.frame[y * dec.w + x] != quantise(px[y * step * width + x * step], fmt, bri)) return false;
+  return true;
+}
+
+void setUp(void) { rnd = 1; }
+void tearDown(void) {}
+
+// 128x128 matrix, solid, rainbow, twinkle and noise content in every format at full and half resolution
+void test_round_trip(void) {
+  const unsigned W = 128, H = 128, N = W * H;
+  static const char *fxNames[] = {"solid", "rainbow", "twinkle", "noise"};
+  static const char *fmtNames[] = {"RGB888", "RGB565", "RGB332"};
+  static const unsigned steps[] = {1, 2};
+  std::vector<uint32_t> px(N);
+  for (unsigned fmt = 0; fmt < 3; fmt++) for (unsigned step : steps) for (unsigned fx = 0; fx < 4; fx++) {
+    LiveStreamEncoder enc;
+    Decoder dec;
+    TEST_ASSERT_TRUE(enc.begin(W, H, step, fmt));
+    TEST_ASSERT_EQUAL((W / step) * (H / step), enc.pixels());
+    const unsigned frames = 150;
+    double t = 0;
+    for (unsigned f = 0; f < frames; f++) {
+      for (unsigned i = 0; i < N; i++) switch (fx) {
+        case 0: px[i] = 0x00FF8000; break;
+        case 1: px[i] = hue((i % W) * 360.0f / W + f * 3); break;
+        case 2: if (!f) px[i] = 0; if (nextRandom() % 64 == 0) px[i] = nextRandom() & 1 ? 0xFFFFFFFF : 0; break;
+        default: px[i] = ((nextRandom() & 0xFF) << 16) | ((nextRandom() & 0x3F) << 8); break;
+      }
+      const double t0 = hostSeconds();
+      const Bytes m = send(enc, px);
+      t += hostSeconds() - t0;
+      TEST_ASSERT_TRUE(dec.decode(m));
+      TEST_ASSERT_EQUAL(f % LIVE_KEYFRAME_INTERVAL == 0, dec.key);
+      TEST_ASSERT_TRUE(matches(dec, px, W, step, fmt));
+    }
+    if (step == 1) {
+      char msg[128];
+      snprintf(msg, sizeof(msg), "%s %-7s %6.1fx smaller than RGB888, %5.1fx than raw %s, %.2f ms/frame",
+               fmtNames[fmt], fxNames[fx], double(enc.stats.frames) * enc.pixels() * 3 / enc.stats.sent, double(enc.stats.raw) / enc.stats.sent, fmtNames[fmt], t * 1e3 / frames);
+      TEST_MESSAGE(msg);
+    }
+  }
+}
+
+// brightness and white are applied like on the LEDs
+void test_brightness(void) {
+  std::vector<uint32_t> px(300);
+  for (auto &c : px) c = nextRandom();
+  LiveStreamEncoder enc;
+  Decoder dec;
+  TEST_ASSERT_TRUE(enc.begin(300, 1, 1, LIVE_FMT_RGB888));
+  TEST_ASSERT_TRUE(dec.decode(send(enc, px, 100)));
+  TEST_ASSERT_TRUE(matches(dec, px, 300, 1, LIVE_FMT_RGB888, 100));
+  TEST_ASSERT_TRUE(dec.decode(send(enc, px, 255)));
+  TEST_ASSERT_FALSE(dec.key);
+  TEST_ASSERT_TRUE(matches(dec, px, 300, 1, LIVE_FMT_RGB888));
+}
+
+// the frame changes between measure() and encode(): nothing is sent, the next message is a key frame; the same after
+// invalidate() (message not handed to the client)
+void test_key_frame_after_failure(void) {
+  std::vector<uint32_t> px(64 * 64, 0x112233);
+  LiveStreamEncoder enc;
+  Decoder dec;
+  TEST_ASSERT_TRUE(enc.begin(64, 64, 1, LIVE_FMT_RGB888));
+  TEST_ASSERT_TRUE(dec.decode(send(enc, px)));
+  Bytes buf(enc.measure(px.data(), 255));
+  for (auto &c : px) c = nextRandom();
+  TEST_ASSERT_EQUAL(0, enc.encode(px.data(), 255, buf.data(), buf.size()));
+  TEST_ASSERT_TRUE(dec.decode(send(enc, px)));
+  TEST_ASSERT_TRUE(dec.key);
+  TEST_ASSERT_TRUE(matches(dec, px, 64, 1, LIVE_FMT_RGB888));
+  px[5] = 0;
+  const Bytes lost = send(enc, px);  // not delivered
+  enc.invalidate();
+  px[6] = 0;
+  TEST_ASSERT_TRUE(dec.decode(send(enc, px)));
+  TEST_ASSERT_TRUE(dec.key);
+  TEST_ASSERT_TRUE(matches(dec, px, 64, 1, LIVE_FMT_RGB888));
+  TEST_ASSERT_FALSE(dec.decode(lost));  // stale delta frame is rejected by the client
+}
+
+// odd sizes and a 1D strip at several steps
+void test_geometry(void) {
+  std::vector<uint32_t> px(1001);
+  for (auto &c : px) c = nextRandom();
+  static const unsigned steps[] = {1, 3, 7};
+  for (unsigned step : steps) {
+    LiveStreamEncoder enc;
+    Decoder dec;
+    TEST_ASSERT_TRUE(enc.begin(1001, 1, step, LIVE_FMT_RGB565));
+    for (unsigned f = 0; f < 3; f++) {
+      px[f * 5] ^= 0xFF;
+      TEST_ASSERT_TRUE(dec.decode(send(enc, px)));
+      TEST_ASSERT_EQUAL((1001 + step - 1) / step, dec.w);
+      TEST_ASSERT_TRUE(matches(dec, px, 1001, step, LIVE_FMT_RGB565));
+    }
+  }
+  std::vector<uint32_t> m(37 * 23);
+  for (auto &c : m) c = nextRandom() & 0x0F0F0F;
+  LiveStreamEncoder enc;
+  Decoder dec;
+  TEST_ASSERT_TRUE(enc.begin(37, 23, 2, LIVE_FMT_RGB332));
+  TEST_ASSERT_TRUE(dec.decode(send(enc, m)));
+  TEST_ASSERT_EQUAL(19, dec.w);
+  TEST_ASSERT_EQUAL(12, dec.h);
+  TEST_ASSERT_TRUE(matches(dec, m, 37, 2, LIVE_FMT_RGB332));
+  TEST_ASSERT_FALSE(enc.begin(0, 1, 1, LIVE_FMT_RGB888));
+}
+
+int main(void) {
+  UNITY_BEGIN();
+  RUN_TEST(test_round_trip);
+  RUN_TEST(test_brightness);
+  RUN_TEST(test_key_frame_after_failure);
+  RUN_TEST(test_geometry);
+  return UNITY_END();
+}
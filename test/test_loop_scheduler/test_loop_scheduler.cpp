@@ -0,0 +1,168 @@
+// cooperative loop scheduler (wled00/loop_scheduler.h): deferral by priority and frame deadline, maximum deferral,
+// statistics, and frame lateness of a synthetic loop against the fixed call order
+#include <unity.h>
+#include <stdio.h>
+
+// simulated clock (us), tasks advance it by their cost
+static unsigned long simUs = 0;
+unsigned long micros() { return simUs; }
+unsigned long millis() { return simUs / 1000; }
+#include "loop_scheduler.h"
+
+static uint32_t rnd = 1;
+static uint32_t nextRandom() { rnd ^= rnd << 13; rnd ^= rnd >> 17; rnd ^= rnd << 5; return rnd; }
+
+static LoopScheduler *s;
+
+static bool runTask(unsigned id, unsigned long cost) { return s->run(id, [cost]{ simUs += cost; }); }
+
+void setUp(void) {
+  rnd = 1;
+  simUs = 1000000;
+  s = new LoopScheduler();
+}
+void tearDown(void) { delete s; }
+
+// critical tasks always run, normal ones wait while the frame is overdue, deferrable ones while their cost does not fit
+void test_priorities(void) {
+  runTask(LOOP_TASK_PRESETS, 10000);  // learn a 10 ms cost
+  s->beginLoop(millis(), millis(), 25, true);
+  TEST_ASSERT_TRUE(runTask(LOOP_TASK_USERMODS, 1000));
+  TEST_ASSERT_TRUE(runTask(LOOP_TASK_PRESETS, 10000));   // 24 ms left
+  simUs += 10000;
+  TEST_ASSERT_FALSE(runTask(LOOP_TASK_PRESETS, 10000));  // 4 ms left
+  TEST_ASSERT_TRUE(runTask(LOOP_TASK_USERMODS, 1000));
+  simUs += 5000;                                          // frame overdue
+  TEST_ASSERT_FALSE(runTask(LOOP_TASK_USERMODS, 1000));
+  TEST_ASSERT_TRUE(runTask(LOOP_TASK_STRIP, 1000));
+  TEST_ASSERT_EQUAL(1, s->timing(LOOP_TASK_USERMODS).deferred);
+  TEST_ASSERT_EQUAL(1, s->timing(LOOP_TASK_PRESETS).deferred);
+  // next iteration after the frame: everything runs again
+  s->beginLoop(millis(), millis(), 25, true);
+  TEST_ASSERT_TRUE(runTask(LOOP_TASK_USERMODS, 1000));
+  TEST_ASSERT_TRUE(runTask(LOOP_TASK_PRESETS, 10000));
+  // no frame expected (strip off, realtime): nothing is deferred
+  s->beginLoop(millis(), millis() - 100, 25, false);
+  TEST_ASSERT_TRUE(runTask(LOOP_TASK_USERMODS, 1000));
+  TEST_ASSERT_TRUE(runTask(LOOP_TASK_PRESETS, 10000));
+  TEST_ASSERT_EQUAL(LONG_MAX, s->remaining());
+}
+
+// a task whose cost never fits runs after LOOP_MAX_DEFER, its expected cost decays when it gets cheaper
+void test_max_defer_and_decay(void) {
+  runTask(LOOP_TASK_CONFIG, 40000);
+  unsigned long lastFrame = millis(), waitingSince = millis(), maxWait = 0;
+  unsigned runs = 0;
+  while (simUs < 20000000UL) {
+    s->beginLoop(millis(), lastFrame, 25, true);
+    const unsigned long start = millis();
+    if (runTask(LOOP_TASK_CONFIG, runs < 10 ? 40000 : 100)) {
+      runs++;
+      if (start - waitingSince > maxWait) maxWait = start - waitingSince;  // wanted to run again right after
+      waitingSince = millis();
+    }
+    runTask(LOOP_TASK_STRIP, 0);
+    if (millis() - lastFrame >= 25) { lastFrame = millis(); simUs += 15000; }
+    simUs += 500;
+  }
+  TEST_ASSERT_TRUE(maxWait <= LOOP_MAX_DEFER + 25);
+  TEST_ASSERT_TRUE(runs > 10);
+  // once cheap, the peak has decayed and the task is only deferred while the frame is overdue
+  const uint32_t deferred = s->timing(LOOP_TASK_CONFIG).deferred;
+  for (unsigned i = 0; i < 100; i++) {
+    s->beginLoop(millis(), lastFrame, 25, true);
+    runTask(LOOP_TASK_CONFIG, 100);
+    runTask(LOOP_TASK_STRIP, 0);
+    if (millis() - lastFrame >= 25) { lastFrame = millis(); simUs += 15000; }
+    simUs += 500;
+  }
+  TEST_ASSERT_TRUE(s->timing(LOOP_TASK_CONFIG).deferred - deferred < 10);
+}
+
+// histogram buckets, halving on saturation, late frames
+void test_statistics(void) {
+  s->beginLoop(millis(), millis(), 25, false);
+  for (unsigned i = 0; i < 70000; i++) runTask(LOOP_TASK_WS, 10);
+  for (unsigned i = 0; i < 1000; i++) runTask(LOOP_TASK_WS, 20000);
+  const LoopScheduler::Timing &t = s->timing(LOOP_TASK_WS);
+  TEST_ASSERT_EQUAL(71000, t.runs);
+  TEST_ASSERT_EQUAL(20000, t.max);
+  TEST_ASSERT_TRUE(t.hist[0] < UINT16_MAX && t.hist[0] > 30000);  // halved once
+  TEST_ASSERT_TRUE(t.hist[LOOP_HIST_BUCKETS - 1] >= 1000);        // > 16 ms
+  TEST_ASSERT_EQUAL(250, LoopScheduler::bucketLimit(0));
+  TEST_ASSERT_EQUAL(0, LoopScheduler::bucketLimit(LOOP_HIST_BUCKETS - 1));
+  // a frame started 3 ms after its deadline is late, one within LOOP_LATE is not
+  unsigned long frame = millis();
+  s->beginLoop(millis(), frame, 25, true);
+  frame += 25 + LOOP_LATE;
+  s->beginLoop(frame, frame, 25, true);
+  frame += 28;
+  s->beginLoop(frame, frame, 25, true);
+  TEST_ASSERT_EQUAL(1, s->stats.late);
+}
+
+// synthetic loop: 18 ms render at 40 fps, usermods 0.3-2 ms, presets occasionally 20 ms (file system), MQTT 3 ms every
+// 200 ms, config write 40 ms every 5 s, maintenance 8 ms every 30 s
+struct Sim { unsigned frames = 0, late = 0, maxLate = 0, psMaxWait = 0; };
+
+static Sim simulate(bool scheduled, unsigned seconds) {
+  Sim r;
+  unsigned long lastFrame = millis(), psPending = 0, mqttNext = 0, cfgNext = millis() + 5000, maintNext = millis() + 30000;
+  bool ps = false;
+  const unsigned frametime = 25;
+  auto task = [&](unsigned id, unsigned long cost) {
+    if (!scheduled) { simUs += cost; return true; }
+    return runTask(id, cost);
+  };
+  const unsigned long end = simUs + seconds * 1000000UL;
+  while (simUs < end) {
+    if (scheduled) s->beginLoop(millis(), lastFrame, frametime, true);
+    task(LOOP_TASK_NOTIFY, 50);
+    task(LOOP_TASK_USERMODS, 300 + nextRandom() % 1700);
+    if (!ps && nextRandom() % 400 == 0) { ps = true; psPending = millis(); }
+    if (ps && task(LOOP_TASK_PRESETS, 20000)) {
+      ps = false;
+      if (millis() - psPending > r.psMaxWait) r.psMaxWait = millis() - psPending;
+    } else if (!ps) task(LOOP_TASK_PRESETS, 5);
+    if (millis() >= mqttNext) { if (task(LOOP_TASK_MQTT, 3000)) mqttNext = millis() + 200; }
+    else task(LOOP_TASK_MQTT, 5);
+    const unsigned long now = millis();
+    task(LOOP_TASK_STRIP, 0);
+    if (now - lastFrame >= frametime) {
+      const unsigned late = now - (lastFrame + frametime);
+      r.frames++;
+      if (late > r.maxLate) r.maxLate = late;
+      if (late > LOOP_LATE) r.late++;
+      lastFrame = now;
+      simUs += 18000;
+    }
+    if (millis() >= maintNext) { if (task(LOOP_TASK_MAINTAIN, 8000)) maintNext += 30000; }
+    if (millis() >= cfgNext) { if (task(LOOP_TASK_CONFIG, 40000)) cfgNext += 5000; }
+    task(LOOP_TASK_WS, 100);
+    simUs += 200; // core, yield
+  }
+  return r;
+}
+
+void test_frame_lateness(void) {
+  const Sim fixed = simulate(false, 300);
+  rnd = 1;
+  const Sim sched = simulate(true, 300);
+  char msg[200];
+  snprintf(msg, sizeof(msg), "300 s at 40 fps: fixed order %u frames, %u late (max %u ms); scheduled %u frames, %u late (max %u ms), presets waited up to %u ms",
+           fixed.frames, fixed.late, fixed.maxLate, sched.frames, sched.late, sched.maxLate, sched.psMaxWait);
+  TEST_MESSAGE(msg);
+  TEST_ASSERT_TRUE(sched.late * 2 < fixed.late);
+  TEST_ASSERT_TRUE(sched.frames >= fixed.frames);
+  TEST_ASSERT_TRUE(sched.psMaxWait <= LOOP_MAX_DEFER + 25);
+  TEST_ASSERT_EQUAL(sched.late, s->stats.late);
+}
+
+int main(void) {
+  UNITY_BEGIN();
+  RUN_TEST(test_priorities);
+  RUN_TEST(test_max_defer_and_decay);
+  RUN_TEST(test_statistics);
+  RUN_TEST(test_frame_lateness);
+  return UNITY_END();
+}
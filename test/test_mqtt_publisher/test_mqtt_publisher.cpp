@@ -0,0 +1,186 @@
+// coalescing MQTT state publisher (wled00/mqtt_publisher.h): window, rate limits, unchanged payloads, backpressure,
+// and message rates with a fake client under synthetic state churn
+#include <unity.h>
+#include <stdio.h>
+#include "wled_host.h"
+#include "mqtt_publisher.h"
+
+// fake client: accepts a message if its send buffer (drained at rate bytes/ms, 0: unlimited) has room
+struct FakeClient {
+  unsigned capacity = 4096, queued = 0, rate = 0;
+  unsigned long last = 0;
+  unsigned messages = 0, rejected = 0, bytes = 0;
+  unsigned perTopic[MQTT_TOPICS] = {};
+  void tick(unsigned long now) {
+    const unsigned drained = (now - last) * rate;
+    queued = drained > queued ? 0 : queued - drained;
+    last = now;
+  }
+  bool publish(unsigned topic, size_t len) {
+    if (rate && queued + len > capacity) { rejected++; return false; }
+    queued += len;
+    messages++;
+    bytes += len;
+    perTopic[topic]++;
+    return true;
+  }
+};
+
+struct State { unsigned bri = 128, col = 0xFF0000; };
+
+// payloads like publishMqtt() renders them, v is an XML response of about 650 bytes
+static size_t render(unsigned topic, const State &s, char *buf) {
+  switch (topic) {
+    case MQTT_TOPIC_BRI:    return sprintf(buf, "%u", s.bri);
+    case MQTT_TOPIC_COL:    return sprintf(buf, "#%06X", s.col);
+    case MQTT_TOPIC_STATUS: return sprintf(buf, "online");
+    default: {
+      const size_t n = sprintf(buf, "<?xml version=\"1.0\" ?><vs><ac>%u</ac><cl>%u</cl>", s.bri, s.col);
+      memset(buf + n, 'x', 600);
+      return n + 600;
+    }
+  }
+}
+
+static MqttPublisher *pub;
+static FakeClient *client;
+static State state;
+static char buf[1024];
+
+// one loop iteration of handleMqtt(): publish at most one due topic
+static void service(unsigned long now) {
+  client->tick(now);
+  const int t = pub->due(now);
+  if (t < 0) return;
+  const size_t n = render(t, state, buf);
+  pub->publish(t, buf, n, now, [&](const char*, size_t len) { return client->publish(t, len); });
+}
+
+static const unsigned STATE_TOPICS = (1U << MQTT_TOPIC_BRI) | (1U << MQTT_TOPIC_COL) | (1U << MQTT_TOPIC_XML);
+
+void setUp(void) {
+  pub = new MqttPublisher();
+  client = new FakeClient();
+  state = State();
+}
+void tearDown(void) { delete pub; delete client; }
+
+// changes within the window become one message with the latest state, immediate skips the window
+void test_coalescing_window(void) {
+  for (unsigned long now = 0; now < 100; now += 10) {
+    state.bri = now;
+    pub->mark(1U << MQTT_TOPIC_BRI, now);
+    service(now);
+  }
+  TEST_ASSERT_EQUAL(0, client->messages);
+  TEST_ASSERT_EQUAL(9, pub->stats.coalesced);
+  service(100);
+  TEST_ASSERT_EQUAL(1, client->messages);
+  TEST_ASSERT_EQUAL_STRING("90", buf);
+  TEST_ASSERT_FALSE(pub->isPending(MQTT_TOPIC_BRI));
+  state.bri = 7;
+  pub->mark(1U << MQTT_TOPIC_BRI, 150, true);
+  service(150);
+  TEST_ASSERT_EQUAL(2, client->messages);
+}
+
+// a topic is not published more often than its interval, unchanged payloads are skipped until reset()
+void test_rate_limit_and_unchanged(void) {
+  pub->window = 0;
+  pub->interval[MQTT_TOPIC_XML] = 1000;
+  for (unsigned long now = 0; now < 5000; now++) {
+    if (now % 10 == 0) { state.bri = (now / 10) & 0xFF; pub->mark(1U << MQTT_TOPIC_XML, now); }
+    service(now);
+  }
+  TEST_ASSERT_EQUAL(5, client->perTopic[MQTT_TOPIC_XML]);
+  for (unsigned long now = 5000; now < 6000; now++) service(now);  // last change
+  TEST_ASSERT_EQUAL(6, client->perTopic[MQTT_TOPIC_XML]);
+  pub->mark(1U << MQTT_TOPIC_STATUS, 6000);
+  service(6000);
+  pub->mark(1U << MQTT_TOPIC_STATUS, 6001);
+  service(6001);
+  TEST_ASSERT_EQUAL(1, client->perTopic[MQTT_TOPIC_STATUS]);
+  TEST_ASSERT_EQUAL(1, pub->stats.unchanged);
+  pub->reset();  // reconnected: retained status is sent again
+  pub->mark(1U << MQTT_TOPIC_STATUS, 6002);
+  service(6002);
+  TEST_ASSERT_EQUAL(2, client->perTopic[MQTT_TOPIC_STATUS]);
+}
+
+// a message the client does not take stays pending and is retried after MQTT_RETRY_DELAY, the loop never waits
+void test_backpressure(void) {
+  pub->window = 0;
+  client->rate = 1;
+  client->capacity = 700;
+  pub->mark(1U << MQTT_TOPIC_XML, 0);
+  service(0);
+  state.bri = 1;
+  pub->mark(1U << MQTT_TOPIC_XML, 1);
+  service(1);   // XML does not fit
+  TEST_ASSERT_EQUAL(1, pub->stats.deferred);
+  TEST_ASSERT_TRUE(pub->isPending(MQTT_TOPIC_XML));
+  pub->mark(1U << MQTT_TOPIC_COL | 1U << MQTT_TOPIC_BRI, 2);
+  service(2);   // other topics are not blocked by the deferred one
+  service(3);
+  TEST_ASSERT_EQUAL(1, client->perTopic[MQTT_TOPIC_BRI]);
+  TEST_ASSERT_EQUAL(1, client->perTopic[MQTT_TOPIC_COL]);
+  unsigned long now = 4;
+  while (pub->isPending(MQTT_TOPIC_XML)) service(now++);
+  TEST_ASSERT_EQUAL(2, client->perTopic[MQTT_TOPIC_XML]);
+  TEST_ASSERT_TRUE(now > 1 + MQTT_RETRY_DELAY);
+}
+
+// synthetic churn at one loop per ms: previous inline publishing of every change vs coalesced publishing
+static void churn(const char *name, unsigned changesPerSec, bool fade, unsigned xmlInterval, unsigned linkRate, float maxPerSec) {
+  const unsigned seconds = 20;
+  FakeClient inline_;
+  inline_.rate = client->rate = linkRate;
+  pub->interval[MQTT_TOPIC_XML] = xmlInterval;
+  unsigned changes = 0, stalled = 0;
+  unsigned long nextChange = 0;
+  for (unsigned long now = 0; now < seconds * 1000UL; now++) {
+    inline_.tick(now);
+    if (now >= nextChange) {
+      nextChange += 1000 / changesPerSec;
+      changes++;
+      if (fade) state.bri = (state.bri + 1) & 0xFF;
+      else {
+        state.bri = (changes * 7) & 0xFF;
+        if (changes % 3 == 0) state.col ^= 0x00FF00;
+      }
+      // previously: g, c, status and v were published for every change, the loop waited for the client
+      static const unsigned topics[] = {MQTT_TOPIC_BRI, MQTT_TOPIC_COL, MQTT_TOPIC_STATUS, MQTT_TOPIC_XML};
+      for (unsigned t : topics) {
+        const size_t n = render(t, state, buf);
+        while (!inline_.publish(t, n)) { stalled++; inline_.tick(++now); }
+      }
+      pub->mark(STATE_TOPICS, now);
+    }
+    service(now);
+  }
+  for (unsigned long now = seconds * 1000UL; now < seconds * 1000UL + 2000; now++) service(now);
+  const float rate = client->messages / float(seconds);
+  char msg[200];
+  snprintf(msg, sizeof(msg), "%s: %u changes, inline %.1f msg/s (stalled %u ms), coalesced %.1f msg/s, %.0f B/s",
+           name, changes, inline_.messages / float(seconds), stalled, rate, client->bytes / float(seconds));
+  TEST_MESSAGE(msg);
+  TEST_ASSERT_TRUE(rate <= maxPerSec);
+  TEST_ASSERT_TRUE(rate < inline_.messages / float(seconds));
+  // the last state was published
+  TEST_ASSERT_FALSE(pub->isPending(MQTT_TOPIC_BRI) || pub->isPending(MQTT_TOPIC_COL) || pub->isPending(MQTT_TOPIC_XML));
+}
+
+void test_churn_fade(void)     { churn("fade 50/s", 50, true, 0, 0, 3 * 1000.0f / MQTT_PUBLISH_WINDOW); }
+void test_churn_encoder(void)  { churn("encoder 200/s, v limited to 1/s", 200, false, 1000, 0, 2 * 1000.0f / MQTT_PUBLISH_WINDOW + 1); }
+void test_churn_slow_link(void){ churn("fade 50/s, 20 B/ms link", 50, true, 0, 20, 3 * 1000.0f / MQTT_PUBLISH_WINDOW); }
+
+int main(void) {
+  UNITY_BEGIN();
+  RUN_TEST(test_coalescing_window);
+  RUN_TEST(test_rate_limit_and_unchanged);
+  RUN_TEST(test_backpressure);
+  RUN_TEST(test_churn_fade);
+  RUN_TEST(test_churn_encoder);
+  RUN_TEST(test_churn_slow_link);
+  return UNITY_END();
+}
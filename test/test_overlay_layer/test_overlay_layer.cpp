@@ -0,0 +1,282 @@
+// overlay layers (wled00/overlay_layer.h): alpha, opacity and clipping, placement in the frame buffer, frames recomposed
+// only in the dirty span against a full recomposition, and the cost per frame
+#include <unity.h>
+#include <stdio.h>
+#include <vector>
+#include "wled_host.h"
+#include "overlay_layer.h"
+
+static uint32_t rnd = 1;
+static uint32_t nextRandom() { rnd ^= rnd << 13; rnd ^= rnd >> 17; rnd ^= rnd << 5; return rnd; }
+
+static uint32_t replace(uint32_t t, uint32_t) { return t; }
+
+// the parts of Segment and WS2812FX the placement uses
+struct Segment {
+  static unsigned maxWidth;
+  uint16_t start, stop, startY, stopY;
+  bool     on;
+  inline bool isActive() const { return stop > start; }
+};
+unsigned Segment::maxWidth = 32;
+
+struct Strip {
+  std::vector<Segment>       _segments;
+  std::vector<OverlayLayer*> _overlays;
+  std::vector<uint32_t>      base;   // segments blended into the frame buffer
+  std::vector<uint32_t>      pixels; // frame buffer
+  size_t _touchedStart = SIZE_MAX, _touchedStop = 0;
+  inline unsigned getLengthTotal() const { return pixels.size(); }
+  inline void touchPixel(unsigned n) { if (n < _touchedStart) _touchedStart = n; if (n >= _touchedStop) _touchedStop = n + 1; }
+
+  // FX_fcn.cpp: WS2812FX::overlayPlacement()
+  bool overlayPlacement(const OverlayLayer &layer, size_t &base, unsigned &w, unsigned &h) const {
+    if (!layer.isVisible()) return false;
+    unsigned x = layer.x();
+    unsigned y = layer.y();
+    w = layer.width();
+    h = layer.height();
+    if (layer.segment() >= 0) {
+      if ((size_t)layer.segment() >= _segments.size()) return false;
+      const Segment &seg = _segments[layer.segment()];
+      if (!seg.isActive() || !seg.on) return false;
+      x += seg.start;
+      y += seg.startY;
+      if (x >= seg.stop || y >= seg.stopY) return false;
+      w = std::min(w, unsigned(seg.stop - x));
+      h = std::min(h, unsigned(seg.stopY - y));
+    } else {
+      if (x >= Segment::maxWidth) return false;
+      w = std::min(w, unsigned(Segment::maxWidth - x)); // do not wrap into the next row
+    }
+    base = x + y * Segment::maxWidth;
+    return base < getLengthTotal();
+  }
+
+  // FX_fcn.cpp: WS2812FX::removeOverlay()
+  void removeOverlay(OverlayLayer *layer) {
+    for (size_t i = 0; i < _overlays.size(); i++) if (_overlays[i] == layer) {
+      size_t start = SIZE_MAX, stop = 0;
+      layer->track(0, 0, start, stop); // not shown anymore, so it is recomposed in full if added again
+      stop = std::min(stop, (size_t)getLengthTotal());
+      if (start < stop) {
+        touchPixel(start);
+        touchPixel(stop - 1);
+      }
+      _overlays.erase(_overlays.begin() + i);
+      return;
+    }
+  }
+
+  void blendOverlays(size_t start, size_t stop) {
+    for (const OverlayLayer *layer : _overlays) {
+      size_t b;
+      unsigned w, h;
+      if (overlayPlacement(*layer, b, w, h)) layer->composite(pixels.data(), b, Segment::maxWidth, w, h, start, stop, replace);
+    }
+  }
+
+  // dirty span of show() (frameSignature()) with unchanged segments, recomposed from the segment pixels, returns its size
+  size_t show() {
+    const size_t totalLen = getLengthTotal();
+    size_t dirtyStart = _touchedStart, dirtyStop = _touchedStop;
+    for (OverlayLayer *layer : _overlays) {
+      size_t b = 0, stop = 0;
+      unsigned w, h;
+      if (overlayPlacement(*layer, b, w, h)) stop = std::min(b + (h - 1) * Segment::maxWidth + w, totalLen);
+      else b = 0;
+      layer->track(b, stop, dirtyStart, dirtyStop);
+    }
+    if (dirtyStop > totalLen) dirtyStop = totalLen;
+    _touchedStart = SIZE_MAX;
+    _touchedStop  = 0;
+    if (dirtyStart >= dirtyStop) return 0;
+    for (size_t i = dirtyStart; i < dirtyStop; i++) pixels[i] = base[i];
+    blendOverlays(dirtyStart, dirtyStop);
+    return dirtyStop - dirtyStart;
+  }
+
+  // every pixel recomposed
+  std::vector<uint32_t> reference() {
+    std::vector<uint32_t> frame = pixels;
+    pixels = base;
+    blendOverlays(0, getLengthTotal());
+    std::swap(frame, pixels);
+    return frame;
+  }
+};
+
+static Strip *strip;
+
+void setUp(void) {
+  rnd = 1;
+  Segment::maxWidth = 32;
+  strip = new Strip();
+  strip->base.resize(32 * 16);
+  for (auto &c : strip->base) c = nextRandom() & 0x00FFFFFF;
+  strip->pixels = strip->base;
+  strip->_segments.push_back({0, 32, 0, 16, true});
+  strip->_segments.push_back({4, 12, 2, 6, true});
+}
+void tearDown(void) { delete strip; }
+
+// transparent pixels, per pixel alpha, layer opacity, setRange() clamping, composition limited to [start, stop)
+void test_alpha_and_opacity(void) {
+  OverlayLayer l;
+  TEST_ASSERT_TRUE(l.begin(10));
+  uint32_t f[30];
+  for (auto &c : f) c = 0x101010;
+  l.composite(f, 5, 30, 10, 1, 0, 30, replace);
+  for (auto c : f) TEST_ASSERT_EQUAL_HEX32(0x101010, c);
+  l.setPixelColor(0, 0xFF0000);
+  l.setRange(9, 7, 0x204080, 128);
+  l.setRange(8, 1000, 0x00FF00);
+  l.composite(f, 5, 30, 10, 1, 0, 30, replace);
+  TEST_ASSERT_EQUAL_HEX32(0x101010, f[4]);
+  TEST_ASSERT_EQUAL_HEX32(0xFF0000, f[5]);
+  TEST_ASSERT_EQUAL_HEX32(color_blend(0x101010, 0x204080, 128), f[12]);
+  TEST_ASSERT_EQUAL_HEX32(0x00FF00, f[14]);
+  TEST_ASSERT_EQUAL_HEX32(0x101010, f[15]);
+  for (auto &c : f) c = 0;
+  l.setOpacity(100);
+  l.composite(f, 5, 30, 10, 1, 6, 14, replace);
+  TEST_ASSERT_EQUAL_HEX32(0, f[5]);
+  TEST_ASSERT_EQUAL_HEX32(color_blend(0, 0x00FF00, (255 * 101) >> 8), f[13]);
+  TEST_ASSERT_EQUAL_HEX32(0, f[14]);
+  l.setOpacity(0);
+  TEST_ASSERT_FALSE(l.isVisible());
+  TEST_ASSERT_FALSE(l.begin(0));
+  TEST_ASSERT_FALSE(l.isReady());
+}
+
+// global layers are clipped at the right edge (no wrap into the next row), segment layers to their segment
+void test_placement(void) {
+  OverlayLayer l;
+  TEST_ASSERT_TRUE(l.begin(10, 3, 28, 4));
+  for (unsigned i = 0; i < 30; i++) l.setPixelColor(i, 0xFFFFFF);
+  size_t base;
+  unsigned w, h;
+  TEST_ASSERT_TRUE(strip->overlayPlacement(l, base, w, h));
+  TEST_ASSERT_EQUAL(28 + 4 * 32, base);
+  TEST_ASSERT_EQUAL(4, w);
+  TEST_ASSERT_EQUAL(3, h);
+  strip->_overlays.push_back(&l);
+  strip->show();
+  for (unsigned y = 4; y < 8; y++) for (unsigned x = 0; x < 32; x++) {
+    const bool covered = y < 7 && x >= 28;
+    TEST_ASSERT_EQUAL_HEX32(covered ? 0xFFFFFF : strip->base[x + y * 32], strip->pixels[x + y * 32]);
+  }
+  l.place(32, 0);
+  TEST_ASSERT_FALSE(strip->overlayPlacement(l, base, w, h));
+  l.place(0, 16);
+  TEST_ASSERT_FALSE(strip->overlayPlacement(l, base, w, h));
+  // (6, 3) of segment 1 (8x4 at 4,2): 2x1 pixels left
+  l.place(6, 3, 1);
+  TEST_ASSERT_TRUE(strip->overlayPlacement(l, base, w, h));
+  TEST_ASSERT_EQUAL(10 + 5 * 32, base);
+  TEST_ASSERT_EQUAL(2, w);
+  TEST_ASSERT_EQUAL(1, h);
+  strip->_segments[1].on = false;
+  TEST_ASSERT_FALSE(strip->overlayPlacement(l, base, w, h));
+  l.place(0, 0, 5);
+  TEST_ASSERT_FALSE(strip->overlayPlacement(l, base, w, h));
+  // 1D: a single row as wide as the strip
+  Segment::maxWidth = strip->getLengthTotal();
+  l.begin(60, 1, strip->getLengthTotal() - 20);
+  TEST_ASSERT_TRUE(strip->overlayPlacement(l, base, w, h));
+  TEST_ASSERT_EQUAL(20, w);
+}
+
+// a removed layer's area is recomposed, limited to the current length if the strip got shorter since it was shown
+void test_remove(void) {
+  OverlayLayer l;
+  l.begin(32, 2, 0, 14);
+  l.setRange(0, 63, 0x123456);
+  strip->_overlays.push_back(&l);
+  strip->show();
+  TEST_ASSERT_EQUAL(14 * 32, l.shownStart());
+  TEST_ASSERT_EQUAL(16 * 32, l.shownStop());
+  strip->pixels.resize(15 * 32);
+  strip->base.resize(15 * 32);
+  strip->removeOverlay(&l);
+  TEST_ASSERT_TRUE(strip->_overlays.empty());
+  TEST_ASSERT_EQUAL(14 * 32, strip->_touchedStart);
+  TEST_ASSERT_EQUAL(15 * 32, strip->_touchedStop);
+  TEST_ASSERT_EQUAL(32, strip->show());
+  TEST_ASSERT_TRUE(strip->pixels == strip->base);
+}
+
+// random drawing, moves, opacity and visibility changes and removals: the frame recomposed in the dirty span only
+// always equals a full recomposition, unchanged frames recompose nothing
+void test_dirty_span(void) {
+  OverlayLayer layers[4];
+  layers[0].begin(60, 1, 100);            // clock ring on the first rows
+  layers[1].begin(8, 8, 20, 6);           // global 2D, partly beyond the right edge when moved
+  layers[2].begin(5, 3, 1, 1, 1);         // relative to segment 1
+  layers[3].begin(32, 1, 0, 15);
+  for (auto &l : layers) strip->_overlays.push_back(&l);
+  unsigned unchanged = 0;
+  size_t recomposed = 0;
+  const unsigned frames = 20000;
+  for (unsigned f = 0; f < frames; f++) {
+    OverlayLayer &l = layers[nextRandom() % 4];
+    switch (nextRandom() % 10) {
+      case 0: case 1: case 2: l.setPixelColor(nextRandom() % (l.width() * l.height()), nextRandom() & 0xFFFFFF, nextRandom()); break;
+      case 3: l.place(nextRandom() % 40, nextRandom() % 18, &l == &layers[2] ? 1 : -1); break;
+      case 4: l.setOpacity(nextRandom() % 4 ? 255 : nextRandom()); break;
+      case 5: l.setVisible(nextRandom() % 4); break;
+      case 6: l.clear(); break;
+      case 7: strip->_segments[1].on = nextRandom() % 3; break;
+      case 8:
+        if (strip->_overlays.size() == 4) strip->removeOverlay(&l);
+        else {
+          strip->_overlays.clear();
+          for (auto &m : layers) strip->_overlays.push_back(&m);
+        }
+        break;
+      default: break; // nothing changed
+    }
+    const size_t span = strip->show();
+    recomposed += span;
+    if (!span) unchanged++;
+    const std::vector<uint32_t> ref = strip->reference();
+    TEST_ASSERT_TRUE(ref == strip->pixels);
+  }
+  TEST_ASSERT_TRUE(unchanged > frames / 20);
+  char msg[96];
+  snprintf(msg, sizeof(msg), "%u frames: %u unchanged, %.0f of %u pixels recomposed per frame",
+           frames, unchanged, double(recomposed) / frames, strip->getLengthTotal());
+  TEST_MESSAGE(msg);
+}
+
+// cost per frame: tracking an unchanged layer, compositing a clock ring and a 16x16 layer
+void test_benchmark(void) {
+  OverlayLayer ring, square;
+  ring.begin(60, 1, 100);
+  for (unsigned i = 0; i < 60; i += 5) ring.setPixelColor(i, 0x00FF00);
+  square.begin(16, 16, 8, 0);
+  for (unsigned i = 0; i < 256; i++) square.setPixelColor(i, nextRandom(), nextRandom());
+  const unsigned n = 200000;
+  size_t sink = 0;
+  double t0 = hostSeconds();
+  for (unsigned i = 0; i < n; i++) { size_t a = SIZE_MAX, b = 0; ring.track(100, 160, a, b); sink += a; }
+  double t1 = hostSeconds();
+  for (unsigned i = 0; i < n; i++) { ring.composite(strip->pixels.data(), 100, 32, 60, 1, 0, 512, replace); sink += strip->pixels[i % 512]; }
+  double t2 = hostSeconds();
+  for (unsigned i = 0; i < n / 10; i++) { square.composite(strip->pixels.data(), 8, 32, 16, 16, 0, 512, replace); sink += strip->pixels[i % 512]; }
+  double t3 = hostSeconds();
+  char msg[160];
+  snprintf(msg, sizeof(msg), "unchanged layer %.1f ns, 60 pixel ring %.1f ns, 16x16 layer %.1f ns per frame (%u)",
+           (t1 - t0) * 1e9 / n, (t2 - t1) * 1e9 / n, (t3 - t2) * 1e10 / n, unsigned(sink & 1));
+  TEST_MESSAGE(msg);
+}
+
+int main(void) {
+  UNITY_BEGIN();
+  RUN_TEST(test_alpha_and_opacity);
+  RUN_TEST(test_placement);
+  RUN_TEST(test_remove);
+  RUN_TEST(test_dirty_span);
+  RUN_TEST(test_benchmark);
+  return UNITY_END();
+}
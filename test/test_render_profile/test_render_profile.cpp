@@ -0,0 +1,114 @@
+// render profiler (wled00/render_profile.h): window statistics, per segment series and effect changes, stage sampling of
+// shown frames as in strip.service(), and the cost of a measurement
+#include <unity.h>
+#include <stdio.h>
+#include "render_profile.h"
+
+RenderProfiler renderProfiler;
+
+static volatile uint32_t sink;
+static void work(unsigned n) { for (unsigned i = 0; i < n; i++) sink = sink * 1664525u + 1013904223u; }
+
+static const uint32_t US = 1000;  // ticks per us on a host build
+
+void setUp(void) { renderProfiler.reset(); }
+void tearDown(void) {}
+
+// the first window is published with every sample, later ones when complete
+void test_windows(void) {
+  TEST_ASSERT_EQUAL(US, RenderProfiler::ticksPerUs());
+  renderProfiler.addStage(RENDER_STAGE_BUS, 10 * US);
+  TEST_ASSERT_EQUAL(10, renderProfiler.stage(RENDER_STAGE_BUS).avg);
+  renderProfiler.addStage(RENDER_STAGE_BUS, 30 * US);
+  TEST_ASSERT_EQUAL(10, renderProfiler.stage(RENDER_STAGE_BUS).min);
+  TEST_ASSERT_EQUAL(20, renderProfiler.stage(RENDER_STAGE_BUS).avg);
+  TEST_ASSERT_EQUAL(30, renderProfiler.stage(RENDER_STAGE_BUS).max);
+  for (unsigned i = 2; i < RENDER_PROFILE_WINDOW; i++) renderProfiler.addStage(RENDER_STAGE_BUS, 20 * US);
+  TEST_ASSERT_EQUAL(20, renderProfiler.stage(RENDER_STAGE_BUS).avg);
+  // second window: previous values stay until it is complete, then only its samples count
+  for (unsigned i = 0; i < RENDER_PROFILE_WINDOW - 1; i++) renderProfiler.addStage(RENDER_STAGE_BUS, 100 * US);
+  TEST_ASSERT_EQUAL(30, renderProfiler.stage(RENDER_STAGE_BUS).max);
+  renderProfiler.addStage(RENDER_STAGE_BUS, 200 * US);
+  const RenderProfiler::Stat &st = renderProfiler.stage(RENDER_STAGE_BUS);
+  TEST_ASSERT_EQUAL(100, st.min);
+  TEST_ASSERT_EQUAL((100 * (RENDER_PROFILE_WINDOW - 1) + 200) / RENDER_PROFILE_WINDOW, st.avg);
+  TEST_ASSERT_EQUAL(200, st.max);
+  TEST_ASSERT_EQUAL(2 * RENDER_PROFILE_WINDOW, st.samples);
+  // saturating window sum
+  for (unsigned i = 0; i < RENDER_PROFILE_WINDOW; i++) renderProfiler.addStage(RENDER_STAGE_FRAME, UINT32_MAX / 4);
+  TEST_ASSERT_EQUAL(UINT32_MAX / RENDER_PROFILE_WINDOW / US, renderProfiler.stage(RENDER_STAGE_FRAME).avg);
+  renderProfiler.addStage(RENDER_STAGES, 1);  // out of range, ignored
+}
+
+// per segment effect and blend series, restarted when the effect changes, segments beyond the limit are not profiled
+void test_segments(void) {
+  for (unsigned i = 0; i < 40; i++) {
+    renderProfiler.addSegment(0, 7, RENDER_SEG_EFFECT, 50 * US);
+    renderProfiler.addSegment(0, 7, RENDER_SEG_BLEND, 5 * US);
+    renderProfiler.addSegment(1, 42, RENDER_SEG_EFFECT, 900 * US);
+  }
+  TEST_ASSERT_EQUAL(7, renderProfiler.segmentMode(0));
+  TEST_ASSERT_EQUAL(50, renderProfiler.segment(0, RENDER_SEG_EFFECT).avg);
+  TEST_ASSERT_EQUAL(5, renderProfiler.segment(0, RENDER_SEG_BLEND).avg);
+  TEST_ASSERT_EQUAL(900, renderProfiler.segment(1, RENDER_SEG_EFFECT).avg);
+  TEST_ASSERT_EQUAL(0, renderProfiler.segment(1, RENDER_SEG_BLEND).samples);
+  renderProfiler.addSegment(1, 43, RENDER_SEG_EFFECT, 10 * US);
+  TEST_ASSERT_EQUAL(43, renderProfiler.segmentMode(1));
+  TEST_ASSERT_EQUAL(1, renderProfiler.segment(1, RENDER_SEG_EFFECT).samples);
+  TEST_ASSERT_EQUAL(10, renderProfiler.segment(1, RENDER_SEG_EFFECT).max);
+  renderProfiler.addSegment(RENDER_PROFILE_SEGMENTS, 1, RENDER_SEG_EFFECT, 1);
+  renderProfiler.addSegment(2, 1, RENDER_SEG_BLEND + 1, 1);
+  TEST_ASSERT_EQUAL(0, renderProfiler.segment(2, RENDER_SEG_BLEND).samples);
+}
+
+// sample sites of strip.service(): effects and frame are sampled for shown frames only, so the effects stage is not
+// diluted by iterations without an active segment (or suspended ones)
+void test_service_sampling(void) {
+  unsigned shown = 0;
+  for (unsigned f = 0; f < 200; f++) {
+    const bool active = f % 4 != 0;
+    RENDER_PROFILE_START(frameStart);
+    bool doShow = false;
+    if (active) {
+      doShow = true;
+      RENDER_PROFILE_START(fxStart);
+      work(20000);
+      RENDER_PROFILE_SEGMENT(0, 5, RENDER_SEG_EFFECT, fxStart);
+    }
+    if (doShow) {
+      RENDER_PROFILE_STAGE(RENDER_STAGE_EFFECTS, frameStart);
+      work(2000);  // show()
+      RENDER_PROFILE_STAGE(RENDER_STAGE_FRAME, frameStart);
+      shown++;
+    }
+  }
+  const RenderProfiler::Stat &fx = renderProfiler.stage(RENDER_STAGE_EFFECTS), &seg = renderProfiler.segment(0, RENDER_SEG_EFFECT);
+  TEST_ASSERT_EQUAL(shown, fx.samples);
+  TEST_ASSERT_EQUAL(shown, renderProfiler.stage(RENDER_STAGE_FRAME).samples);
+  TEST_ASSERT_TRUE(fx.min >= seg.min);  // every effects sample contains an effect call
+  TEST_ASSERT_TRUE(renderProfiler.stage(RENDER_STAGE_FRAME).avg >= fx.avg);
+  char msg[128];
+  snprintf(msg, sizeof(msg), "effect %u/%u/%u us, effects stage %u/%u/%u us (min/avg/max)", seg.min, seg.avg, seg.max, fx.min, fx.avg, fx.max);
+  TEST_MESSAGE(msg);
+}
+
+// cost of one measurement (start and stage)
+void test_overhead(void) {
+  const unsigned n = 1000000;
+  const uint32_t t0 = RenderProfiler::ticks();
+  for (unsigned i = 0; i < n; i++) { RENDER_PROFILE_START(t); RENDER_PROFILE_STAGE(RENDER_STAGE_BUS, t); }
+  const uint32_t t1 = RenderProfiler::ticks();
+  TEST_ASSERT_EQUAL(n, renderProfiler.stage(RENDER_STAGE_BUS).samples);
+  char msg[64];
+  snprintf(msg, sizeof(msg), "%.1f ns per measurement", (t1 - t0) / double(n));
+  TEST_MESSAGE(msg);
+}
+
+int main(void) {
+  UNITY_BEGIN();
+  RUN_TEST(test_windows);
+  RUN_TEST(test_segments);
+  RUN_TEST(test_service_sampling);
+  RUN_TEST(test_overhead);
+  return UNITY_END();
+}
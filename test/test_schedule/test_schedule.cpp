@@ -0,0 +1,306 @@
+// timer schedule engine (wled00/schedule.h): cron expressions, a year of EU DST transitions in 1 s steps against a per
+// second match of every rule, the bounded sunrise/sunset search and the cost of a year of typical timers
+#include <unity.h>
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+#include "wled_host.h"
+#include "schedule.h"
+
+static uint32_t rnd = 1;
+static uint32_t nextRandom() { rnd ^= rnd << 13; rnd ^= rnd >> 17; rnd ^= rnd << 5; return rnd; }
+static uint64_t nextRandom64() { return (uint64_t(nextRandom()) << 32) | nextRandom(); }
+
+// days since 1970 of a civil date (inverse of scheduleDate())
+static uint32_t scheduleDays(unsigned y, unsigned m, unsigned d) {
+  y -= m <= 2;
+  const unsigned era = y / 400, yoe = y - era * 400;
+  const unsigned doy = (153 * (m > 2 ? m - 3 : m + 9) + 2) / 5 + d - 1;
+  return era * 146097 + yoe * 365 + yoe / 4 - yoe / 100 + doy - 719468;
+}
+
+static uint32_t lastSunday(unsigned y, unsigned m) {
+  uint32_t d = (m == 12 ? scheduleDays(y + 1, 1, 1) : scheduleDays(y, m + 1, 1)) - 1;
+  while (scheduleWeekday(d)) d--;
+  return d;
+}
+
+// CET/CEST: +2 h from the last Sunday of March 01:00 UTC to the last Sunday of October 01:00 UTC, +1 h otherwise
+static int32_t utcOffset(uint32_t utc) {
+  static unsigned year = 0;
+  static uint32_t start, end;
+  unsigned y, m, d;
+  scheduleDate(utc / 86400, y, m, d);
+  if (y != year) {
+    year  = y;
+    start = lastSunday(y, 3) * 86400 + 3600;
+    end   = lastSunday(y, 10) * 86400 + 3600;
+  }
+  return utc >= start && utc < end ? 7200 : 3600;
+}
+
+// synthetic sun: no sunrise/sunset every 97th day, otherwise around 06:00/18:00
+static unsigned sunCalls = 0;
+static int sunMinutes(uint32_t day, bool sunset) {
+  sunCalls++;
+  if (day % 97 == 0) return -1;
+  return (sunset ? 18*60 : 6*60) + int(day % 120) - 60;
+}
+static int noSun(uint32_t, bool) { sunCalls++; return -1; }
+
+static std::vector<ScheduleRule> rules;
+static bool ruleOf(unsigned id, ScheduleRule& r) {
+  if (id >= rules.size()) return false;
+  r = rules[id];
+  return true;
+}
+
+// reference: does rule r fire at local second t
+static bool matches(const ScheduleRule& r, uint32_t t) {
+  const uint32_t day = t / 86400, sod = t % 86400;
+  if (!scheduleDayMatches(r, day)) return false;
+  if (r.sun) {
+    const int sun = sunMinutes(day, r.sun == SCHEDULE_SUNSET);
+    return sun >= 0 && sod == uint32_t(((sun + r.offset) % 1440 + 1440) % 1440 * 60);
+  }
+  return ((r.time.hours >> (sod / 3600)) & 1) && ((r.time.minutes >> (sod / 60 % 60)) & 1) && ((r.time.seconds >> (sod % 60)) & 1);
+}
+
+static ScheduleRule randomRule() {
+  static const char* exprs[] = {"0 30 7 * * 1-5", "*/15 * 8-18 * * *", "0 0 */2 * * 6,0", "@daily", "@hourly", "0 0 0 29 2 *",
+    "5 4 3 1,15 * 1", "0 0 2 * * *", "30 30 2 * * *", "0 59 1 * 3,10 0", "0 0 12 * 1-6/2 *", "7/20 0 0 * * *"};
+  ScheduleRule r = {};
+  CronSpec& c = r.time;
+  const unsigned k = nextRandom() % 16;
+  if (k < 12) cronParse(exprs[k], c);
+  else if (k < 14) {
+    c.seconds  = (nextRandom64() & nextRandom64() & ((1ULL << 60) - 1)) | 1;
+    c.minutes  = (nextRandom64() & nextRandom64() & ((1ULL << 60) - 1)) | 2;
+    c.hours    = (nextRandom() & 0xFFFFFF) | (1 << 3);
+    c.days     = nextRandom() % 3 ? CRON_ALL_DAYS : (nextRandom() & CRON_ALL_DAYS) | 2;
+    c.months   = nextRandom() % 2 ? CRON_ALL_MONTHS : (nextRandom() & CRON_ALL_MONTHS) | 4;
+    c.weekdays = nextRandom() % 2 ? CRON_ALL_WEEKDAYS : (nextRandom() & CRON_ALL_WEEKDAYS) | 1;
+  } else {
+    c.seconds  = c.minutes = c.hours = 1;
+    c.days     = CRON_ALL_DAYS;
+    c.months   = CRON_ALL_MONTHS;
+    c.weekdays = nextRandom() & CRON_ALL_WEEKDAYS;
+    r.sun      = 1 + nextRandom() % 2;
+    r.offset   = int(nextRandom() % 241) - 120;
+  }
+  if (nextRandom() % 4 == 0) {
+    r.monthStart = 1 + nextRandom() % 12;
+    r.dayStart   = 1 + nextRandom() % 31;
+    r.monthEnd   = 1 + nextRandom() % 12;
+    r.dayEnd     = 1 + nextRandom() % 31;
+  }
+  return r;
+}
+
+void setUp(void) {
+  rnd = 1;
+  sunCalls = 0;
+  rules.clear();
+}
+void tearDown(void) {}
+
+// parsing, invalid expressions, print/parse round trip
+void test_cron(void) {
+  CronSpec c, p;
+  TEST_ASSERT_TRUE(cronParse("0 30 7 * * 1-5", c));
+  TEST_ASSERT_TRUE(c.seconds == 1 && c.minutes == 1ULL << 30 && c.hours == 1 << 7 && c.weekdays == 0x3E);
+  TEST_ASSERT_TRUE(cronParse("30 7 * * 7", c));  // 5 fields, Sunday as 7
+  TEST_ASSERT_TRUE(c.seconds == 1 && c.minutes == 1ULL << 30 && c.weekdays == 1);
+  TEST_ASSERT_TRUE(cronParse("10/20 * * * * *", c));
+  TEST_ASSERT_TRUE(c.seconds == ((1ULL << 10) | (1ULL << 30) | (1ULL << 50)));
+  TEST_ASSERT_TRUE(cronParse("@weekly", c) && c.weekdays == 1);
+  static const char* bad[] = {"", "* * * *", "* * * * * * *", "60 * * * * *", "* * 24 * * *", "* * * 0 * *", "* * * * 13 *",
+    "* * * * * 8", "*/0 * * * * *", "5-3 * * * * *", "1, * * * * *", "a * * * * *", "@nope", "* * * * *x *"};
+  for (const char* b : bad) TEST_ASSERT_FALSE_MESSAGE(cronParse(b, c), b);
+  char buf[CRON_MAX_LEN];
+  for (unsigned i = 0; i < 5000; i++) {
+    c = randomRule().time;
+    if (i % 3 == 0) {  // alternating values, the longest output
+      c.seconds = 0x0AAAAAAAAAAAAAAAULL | 1ULL << 59;
+      c.minutes = 0x0555555555555555ULL ^ 4;
+      c.hours   = 0xAAAAAA ^ 2;
+      c.days    = 0xAAAAAAAA ^ 8;
+    }
+    if (!c.weekdays) continue;
+    TEST_ASSERT_TRUE(cronPrint(c, buf, sizeof(buf)) < sizeof(buf));
+    TEST_ASSERT_TRUE_MESSAGE(cronParse(buf, p), buf);
+    TEST_ASSERT_TRUE(c.seconds == p.seconds && c.minutes == p.minutes && c.hours == p.hours && c.days == p.days && c.months == p.months && c.weekdays == p.weekdays);
+  }
+  cronParse("0 */15 8-18 * * 1-5", c);
+  cronPrint(c, buf, sizeof(buf));
+  TEST_ASSERT_TRUE(!strcmp("0 */15 8-18 * * 1-5", buf));
+  char small[8];
+  TEST_ASSERT_TRUE(cronPrint(c, small, sizeof(small)) >= sizeof(small));
+  TEST_ASSERT_EQUAL(7, strlen(small));
+}
+
+// 02:30:30 every day for a year: skipped on the last Sunday of March, twice on the last Sunday of October
+void test_dst(void) {
+  ScheduleRule r = {};
+  cronParse("30 30 2 * * *", r.time);
+  rules.push_back(r);
+  Schedule s(ruleOf, sunMinutes);
+  const uint32_t start = scheduleDays(2027, 1, 1) * 86400;
+  unsigned count = 0, march = 0, october = 0;
+  for (uint32_t utc = start; utc < start + 365 * 86400; utc++) {
+    const int32_t offset = utcOffset(utc);
+    const uint32_t local = utc + offset;
+    s.update(local, offset, 1, [&](unsigned) {
+      count++;
+      march   += local / 86400 == lastSunday(2027, 3);
+      october += local / 86400 == lastSunday(2027, 10);
+    });
+  }
+  TEST_ASSERT_EQUAL(365, count);
+  TEST_ASSERT_EQUAL(0, march);
+  TEST_ASSERT_EQUAL(2, october);
+  TEST_ASSERT_EQUAL(3, s.stats.rebuilds);  // start and both transitions
+}
+
+// a year in 1 s steps with DST: every fire of random rules (cron, sun, date ranges) matches a per second check
+void test_year(void) {
+  const unsigned n = 24;
+  for (unsigned i = 0; i < n; i++) rules.push_back(randomRule());
+  Schedule s(ruleOf, sunMinutes);
+  const uint32_t start = scheduleDays(2027, 1, 1) * 86400;
+  std::vector<uint32_t> fired, expected;
+  for (uint32_t utc = start; utc < start + 365 * 86400; utc++) {
+    const int32_t offset = utcOffset(utc);
+    const uint32_t local = utc + offset;
+    s.update(local, offset, n, [&](unsigned id) { fired.push_back(utc); fired.push_back(id); });
+    for (unsigned id = 0; id < n; id++) if (matches(rules[id], local)) { expected.push_back(utc); expected.push_back(id); }
+  }
+  TEST_ASSERT_EQUAL(expected.size(), fired.size());
+  TEST_ASSERT_TRUE(expected == fired);
+  char msg[96];
+  snprintf(msg, sizeof(msg), "%u rules: %u fires, %u rebuilds, %u instants computed", n, unsigned(fired.size() / 2), s.stats.rebuilds, s.stats.computed);
+  TEST_MESSAGE(msg);
+}
+
+// without sunrise/sunset (polar day or night, no location) a sun rule is searched for a year, not SCHEDULE_HORIZON days
+void test_sun_horizon(void) {
+  ScheduleRule r = {};
+  r.time.days     = CRON_ALL_DAYS;
+  r.time.months   = CRON_ALL_MONTHS;
+  r.time.weekdays = CRON_ALL_WEEKDAYS;
+  r.sun           = SCHEDULE_SUNRISE;
+  for (unsigned i = 0; i < 10; i++) rules.push_back(r);
+  Schedule s(ruleOf, noSun);
+  s.update(scheduleDays(2027, 1, 1) * 86400, 0, 10, [](unsigned) {});
+  TEST_ASSERT_EQUAL(0, s.size());
+  TEST_ASSERT_EQUAL(10 * SCHEDULE_SUN_HORIZON, sunCalls);
+  // a sun rule for three days a year finds them next year
+  r.sun        = SCHEDULE_SUNSET;
+  r.monthStart = 3;
+  r.dayStart   = 1;
+  r.monthEnd   = 3;
+  r.dayEnd     = 3;
+  unsigned y, m, d;
+  scheduleDate(scheduleNext(r, scheduleDays(2027, 4, 1) * 86400, sunMinutes) / 86400, y, m, d);
+  TEST_ASSERT_TRUE(y == 2028 && m == 3 && d <= 3);
+  // cron rules still look SCHEDULE_HORIZON days ahead: Feb 29
+  TEST_ASSERT_TRUE(cronParse("0 0 12 29 2 *", r.time));
+  r.sun = r.monthStart = r.dayStart = r.monthEnd = r.dayEnd = 0;
+  scheduleDate(scheduleNext(r, scheduleDays(2097, 3, 1) * 86400, nullptr) / 86400, y, m, d);
+  TEST_ASSERT_TRUE(y == 2104 && m == 2 && d == 29);
+}
+
+// ntp.cpp: getTimerSunMinutes() with a getSunTime() that has no sun for 60 days
+static uint32_t sunCacheDay[2] = {UINT32_MAX, UINT32_MAX};
+static int16_t  sunCacheMinutes[2];
+static uint32_t sunNoneFirst[2] = {UINT32_MAX, UINT32_MAX};
+static uint32_t sunNoneLast[2];
+static uint32_t polarNight;
+
+static time_t getSunTime(time_t theDay, bool sunset) {
+  sunCalls++;
+  const uint32_t day = theDay / 86400;
+  return day >= polarNight && day < polarNight + 60 ? 0 : time_t(day) * 86400 + (sunset ? 18 : 6) * 3600;
+}
+
+static int getTimerSunMinutes(uint32_t theDay, bool sunset)
+{
+  if (theDay >= sunNoneFirst[sunset] && theDay <= sunNoneLast[sunset]) return -1;
+  if (sunCacheDay[sunset] != theDay) {
+    const time_t t = getSunTime((time_t)theDay * 86400 + 43200, sunset);
+    sunCacheMinutes[sunset] = t ? (t % 86400) / 60 : -1;
+    sunCacheDay[sunset] = theDay;
+    if (!t) { // find the end of this run of days without sun
+      sunNoneFirst[sunset] = sunNoneLast[sunset] = theDay;
+      while (sunNoneLast[sunset] - theDay < SCHEDULE_SUN_HORIZON && !getSunTime((time_t)(sunNoneLast[sunset] + 1) * 86400 + 43200, sunset))
+        sunNoneLast[sunset]++;
+    }
+  }
+  return sunCacheMinutes[sunset];
+}
+
+// further sun timers skip the days without sun found by the first one
+void test_no_sun_cache(void) {
+  const uint32_t start = scheduleDays(2027, 11, 20) * 86400;
+  polarNight = start / 86400 + 5;
+  ScheduleRule r = {};
+  r.time.days = CRON_ALL_DAYS;
+  r.time.months = CRON_ALL_MONTHS;
+  r.time.weekdays = 1 << 3;  // Wednesdays only, the search crosses the whole night
+  r.sun = SCHEDULE_SUNRISE;
+  for (unsigned i = 0; i < 20; i++) rules.push_back(r);
+  Schedule s(ruleOf, getTimerSunMinutes);
+  s.update(start + 6 * 86400, 0, 20, [](unsigned) {});
+  TEST_ASSERT_EQUAL(20, s.size());
+  TEST_ASSERT_TRUE(s.next() / 86400 >= polarNight + 60);
+  TEST_ASSERT_TRUE(sunCalls <= 62);  // each day of the night once (not every Wednesday per timer) and the day after
+}
+
+// a year of 500 typical timers when the clock only stops at the next instant (or every SCHEDULE_MAX_CATCHUP s)
+void test_benchmark(void) {
+  static const char* exprs[] = {"0 30 7 * * 1-5", "0 0 18 * * 1-5", "0 */15 8-18 * * 1-5", "@daily", "0 0 22 * * 5,6",
+    "30 45 6 * * *", "0 0 8 1 * *", "0 0 2 * * *", "30 30 2 * * *", "0 0 12 24-26 12 *", "15 0 0 * * 0", "0 5 9-17/2 * * *"};
+  const unsigned n = 500;
+  for (unsigned i = 0; i < n; i++) {
+    ScheduleRule r = {};
+    const unsigned k = nextRandom() % 16;
+    if (k < 12) cronParse(exprs[k], r.time);
+    else {
+      r.time.days = CRON_ALL_DAYS;
+      r.time.months = CRON_ALL_MONTHS;
+      r.time.weekdays = CRON_ALL_WEEKDAYS;
+      r.sun = 1 + k % 2;
+      r.offset = int(nextRandom() % 241) - 120;
+    }
+    rules.push_back(r);
+  }
+  Schedule s(ruleOf, sunMinutes);
+  uint32_t utc = scheduleDays(2027, 1, 1) * 86400;
+  const uint32_t end = utc + 365 * 86400;
+  unsigned fired = 0;
+  const double t0 = hostSeconds();
+  while (utc < end) {
+    const int32_t offset = utcOffset(utc);
+    s.update(utc + offset, offset, n, [&](unsigned) { fired++; });
+    const uint32_t next = s.next();
+    uint32_t step = next > utc + offset ? next - (utc + offset) : 1;
+    utc += step < SCHEDULE_MAX_CATCHUP ? step : SCHEDULE_MAX_CATCHUP;
+  }
+  const double t = hostSeconds() - t0;
+  char msg[128];
+  snprintf(msg, sizeof(msg), "%u timers, a year: %u fired, %u rebuilds, %u instants computed, %.1f ms (%.2f us per fire)",
+           n, fired, s.stats.rebuilds, s.stats.computed, t * 1e3, t * 1e6 / fired);
+  TEST_MESSAGE(msg);
+  TEST_ASSERT_EQUAL(fired + n * s.stats.rebuilds, s.stats.computed);
+}
+
+int main(void) {
+  UNITY_BEGIN();
+  RUN_TEST(test_cron);
+  RUN_TEST(test_dst);
+  RUN_TEST(test_year);
+  RUN_TEST(test_sun_horizon);
+  RUN_TEST(test_no_sun_cache);
+  RUN_TEST(test_benchmark);
+  return UNITY_END();
+}
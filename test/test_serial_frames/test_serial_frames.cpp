@@ -0,0 +1,376 @@
+// framed binary serial protocol (wled00/serial_frames.h): encoding variants, error statuses, resynchronization after
+// rejected or timed out frames, buffer lifetime, and sustained frame rate over a pseudo terminal
+#include <unity.h>
+#include <stdio.h>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <fcntl.h>
+#include <poll.h>
+#include <termios.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include "wled_host.h"
+#define RGBW32(r,g,b,w) (uint32_t((byte(w) << 24) | (byte(r) << 16) | (byte(g) << 8) | (byte(b))))   // colors.h
+#include "serial_frames.h"
+
+#define LEDS 2048
+
+typedef std::vector<uint8_t> Bytes;
+
+static uint32_t rnd = 1;
+static uint32_t nextRandom() { rnd ^= rnd << 13; rnd ^= rnd >> 17; rnd ^= rnd << 5; return rnd; }
+
+// frame as sent by the host: runs of equal pixels are RLE encoded, delta frames are XORed onto prev
+static Bytes encode(uint8_t seq, const std::vector<uint32_t> &px, bool rle, const std::vector<uint32_t> *prev = nullptr, uint8_t flags = SERIAL_FLAG_ACK) {
+  std::vector<uint32_t> v(px);
+  if (prev) for (size_t i = 0; i < v.size(); i++) v[i] ^= (*prev)[i];
+  Bytes pay;
+  auto put = [&](uint32_t c) { pay.push_back(c >> 16); pay.push_back(c >> 8); pay.push_back(c); };
+  for (size_t i = 0; i < v.size(); ) {
+    size_t run = 1;
+    while (rle && i + run < v.size() && v[i + run] == v[i] && run < 129) run++;
+    if (!rle) { put(v[i++]); continue; }
+    if (run >= 2) { pay.push_back(uint8_t(run + 126)); put(v[i]); i += run; continue; }
+    size_t n = 1;
+    while (i + n < v.size() && n < 128 && v[i + n] != v[i + n - 1] && (i + n + 1 >= v.size() || v[i + n + 1] != v[i + n])) n++;
+    pay.push_back(uint8_t(n - 1));
+    for (size_t k = 0; k < n; k++) put(v[i + k]);
+    i += n;
+  }
+  flags |= (rle ? SERIAL_FLAG_RLE : 0) | (prev ? SERIAL_FLAG_DELTA : 0);
+  const uint8_t header[] = {SERIAL_FRAME_START, SERIAL_FRAME_PIXELS, flags, seq, 0, 0, uint8_t(v.size() >> 8), uint8_t(v.size()), uint8_t(pay.size() >> 8), uint8_t(pay.size())};
+  Bytes f(sizeof(header) + pay.size());
+  memcpy(f.data(), header, sizeof(header));
+  if (!pay.empty()) memcpy(f.data() + sizeof(header), pay.data(), pay.size());
+  const uint16_t crc = SerialFrameDecoder::crc16(0xFFFF, f.data() + 1, f.size() - 1);
+  f.push_back(crc >> 8);
+  f.push_back(crc & 0xFF);
+  return f;
+}
+
+// stand-in for Serial: bytes become available in chunks (as they fill the UART buffer), replies are collected
+struct HostStream {
+  Bytes in, out;
+  size_t pos = 0, limit = 0;
+  int    available() const { return int(limit - pos); }
+  int    peek() const { return pos < limit ? in[pos] : -1; }
+  int    read() { return pos < limit ? in[pos++] : -1; }
+  size_t readBytes(uint8_t *buf, size_t n) {
+    if (n > limit - pos) n = limit - pos;
+    memcpy(buf, &in[pos], n);
+    pos += n;
+    return n;
+  }
+  size_t write(const uint8_t *buf, size_t n) { out.insert(out.end(), buf, buf + n); return n; }
+};
+
+static SerialFrameDecoder *dec;
+static std::vector<int> statuses;  // status of every completed frame
+static Bytes commands;             // bytes seen by the Adalight/command parser
+static const std::vector<std::vector<uint32_t>> *replayed; // frames sent in a loop, checked when committed
+static unsigned committed, mismatches;
+
+// one call of handleSerial() (wled_serial.cpp): bytes go to the decoder while it is active, a start byte seen by
+// the command parser starts a frame, everything else is a command
+template<class S> static void handleSerial(S &serial, unsigned long now) {
+  dec->handle(now);
+  while (serial.available() > 0) {
+    if (dec->active()) {
+      const int status = dec->receive(serial, now, true);
+      if (status != SERIAL_FRAME_INCOMPLETE) statuses.push_back(status);
+      if (status == SERIAL_ACK_OK && replayed) { // commit
+        const std::vector<uint32_t> &px = (*replayed)[committed++ % replayed->size()];
+        if (memcmp(dec->pixels(), px.data(), LEDS * sizeof(uint32_t))) mismatches++;
+      }
+      continue;
+    }
+    if (serial.peek() == SERIAL_FRAME_START) {
+      dec->begin(LEDS);
+      dec->start(now);
+    } else commands.push_back(serial.peek());
+    serial.read();
+  }
+}
+
+static HostStream serial;
+
+static void feed(const Bytes &in, unsigned long now, unsigned chunk = 64) {
+  serial.in.insert(serial.in.end(), in.begin(), in.end());
+  do {
+    serial.limit = serial.limit + chunk < serial.in.size() ? serial.limit + chunk : serial.in.size();
+    handleSerial(serial, now);
+  } while (serial.limit < serial.in.size());
+}
+
+static std::vector<uint32_t> randomFrame() {
+  std::vector<uint32_t> px(LEDS);
+  for (unsigned i = 0; i < LEDS; i++) px[i] = (i / 10) & 1 ? RGBW32(0, 0, 255, 0) : nextRandom() & 0xFFFFFF;
+  return px;
+}
+
+static bool shows(const std::vector<uint32_t> &px) { return memcmp(dec->pixels(), px.data(), LEDS * sizeof(uint32_t)) == 0; }
+
+void setUp(void) {
+  rnd = 1;
+  dec = new SerialFrameDecoder();
+  serial = HostStream();
+  statuses.clear();
+  commands.clear();
+}
+void tearDown(void) { delete dec; }
+
+// raw, RLE and delta frames decode to the sent pixels, in any read chunking
+void test_encodings(void) {
+  std::vector<uint32_t> prev;
+  for (unsigned f = 0; f < 60; f++) {
+    const std::vector<uint32_t> px = randomFrame();
+    const bool delta = f % 3 == 2;
+    feed(encode(f, px, f % 3 != 0, delta ? &prev : nullptr), f * 20, 1 + nextRandom() % 200);
+    TEST_ASSERT_EQUAL(f + 1, statuses.size());
+    TEST_ASSERT_EQUAL(SERIAL_ACK_OK, statuses.back());
+    TEST_ASSERT_TRUE(shows(px));
+    prev = px;
+  }
+  TEST_ASSERT_EQUAL(60, dec->stats.frames);
+  TEST_ASSERT_EQUAL(0, commands.size());
+  TEST_ASSERT_EQUAL(60 * 4, serial.out.size());  // acknowledgements
+  const uint8_t ack[4] = {SERIAL_FRAME_START, SERIAL_FRAME_ACK, 59, SERIAL_ACK_OK};
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(ack, &serial.out[59 * 4], 4);
+}
+
+// checksum mismatch and delta frames without base are reported, the frame buffer keeps the last good frame
+void test_crc_and_keyframe(void) {
+  const std::vector<uint32_t> a = randomFrame(), b = randomFrame();
+  feed(encode(1, a, true), 0);
+  Bytes bad = encode(2, b, true);
+  bad[20] ^= 0x01;
+  feed(bad, 10);
+  TEST_ASSERT_EQUAL(SERIAL_ACK_CRC, statuses.back());
+  TEST_ASSERT_TRUE(shows(a));
+  feed(encode(7, b, true, &a), 20);  // delta frame that does not follow frame 1
+  TEST_ASSERT_EQUAL(SERIAL_ACK_KEYFRAME, statuses.back());
+  feed(encode(2, b, true, &a), 30);
+  TEST_ASSERT_EQUAL(SERIAL_ACK_OK, statuses.back());
+  TEST_ASSERT_TRUE(shows(b));
+  TEST_ASSERT_EQUAL(1, dec->stats.crcErrors);
+  TEST_ASSERT_EQUAL(1, dec->stats.keyframes);
+}
+
+// a rejected header (more pixels than the strip has): its payload is dropped even if it contains start bytes and
+// Adalight headers, the next frame is received
+void test_rejected_header_payload_dropped(void) {
+  std::vector<uint32_t> big(LEDS + 10, RGBW32(SERIAL_FRAME_START, 'A', 'd', 0));
+  for (unsigned i = 0; i < big.size(); i += 3) big[i] = RGBW32('a', 0, SERIAL_FRAME_START, 0);
+  const std::vector<uint32_t> px = randomFrame();
+  Bytes stream = encode(1, big, false);
+  const Bytes next = encode(2, px, true);
+  stream.insert(stream.end(), next.begin(), next.end());
+  feed(stream, 0, 7);
+  TEST_ASSERT_EQUAL(2, statuses.size());
+  TEST_ASSERT_EQUAL(SERIAL_ACK_FORMAT, statuses[0]);
+  TEST_ASSERT_EQUAL(SERIAL_ACK_OK, statuses[1]);
+  TEST_ASSERT_TRUE(shows(px));
+  TEST_ASSERT_EQUAL(0, commands.size());
+}
+
+// a corrupted length: the rest of the frame is dropped up to the next start byte
+void test_crc_error_resyncs_on_start_byte(void) {
+  const std::vector<uint32_t> px = randomFrame();
+  Bytes stream = encode(1, std::vector<uint32_t>(LEDS, RGBW32('A', 'd', 'a', 0)), false);
+  const unsigned len = ((stream[8] << 8) | stream[9]) - 30; // payload length 30 bytes too short
+  stream[8] = len >> 8;
+  stream[9] = len;
+  const Bytes next = encode(2, px, true);
+  stream.insert(stream.end(), next.begin(), next.end());
+  feed(stream, 0);
+  TEST_ASSERT_EQUAL(2, statuses.size());
+  TEST_ASSERT_EQUAL(SERIAL_ACK_CRC, statuses[0]);
+  TEST_ASSERT_EQUAL(SERIAL_ACK_OK, statuses[1]);
+  TEST_ASSERT_TRUE(shows(px));
+  TEST_ASSERT_EQUAL(0, commands.size());
+}
+
+// a timed out frame: bytes arriving late are dropped, commands after an idle line are parsed again
+void test_timeout(void) {
+  const Bytes f = encode(1, std::vector<uint32_t>(LEDS, RGBW32('v', 'l', 'A', 0)), false);
+  feed(Bytes(f.begin(), f.begin() + 100), 0);
+  feed(Bytes(), SERIAL_FRAME_TIMEOUT + 1);   // loop() sees the timeout
+  feed(Bytes(f.begin() + 100, f.end()), SERIAL_FRAME_TIMEOUT + 5);
+  TEST_ASSERT_EQUAL(0, statuses.size());
+  TEST_ASSERT_EQUAL(0, commands.size());
+  const Bytes cmd = {'v'};
+  feed(cmd, SERIAL_FRAME_TIMEOUT + 20);       // still within the rejected frame
+  TEST_ASSERT_EQUAL(0, commands.size());
+  feed(cmd, 2 * SERIAL_FRAME_TIMEOUT + 30);   // line was idle
+  TEST_ASSERT_EQUAL(1, commands.size());
+  TEST_ASSERT_EQUAL('v', commands[0]);
+  // timeout within the header: resync on the next start byte
+  const std::vector<uint32_t> px = randomFrame();
+  const Bytes g = encode(2, px, true);
+  feed(Bytes(g.begin(), g.begin() + 5), 1000);
+  feed(g, 1000 + SERIAL_FRAME_TIMEOUT + 1);
+  TEST_ASSERT_EQUAL(SERIAL_ACK_OK, statuses.back());
+  TEST_ASSERT_TRUE(shows(px));
+}
+
+// stray start bytes cost no memory, buffers of an unused stream are released
+void test_buffer_lifetime(void) {
+  const Bytes stray = {SERIAL_FRAME_START, 'v', 'l', 'A', 'd', 'a', 'o', 'O', 'v', 'l'};
+  feed(stray, 0);
+  TEST_ASSERT_EQUAL(SERIAL_ACK_FORMAT, statuses.back());
+  TEST_ASSERT_EQUAL(0, dec->allocated());
+  Bytes bad = encode(1, randomFrame(), true);
+  bad[bad.size() - 1] ^= 0xFF;
+  feed(bad, 1000);                          // valid header: receive buffer only
+  TEST_ASSERT_EQUAL(SERIAL_ACK_CRC, statuses.back());
+  TEST_ASSERT_TRUE(dec->allocated() > 0 && dec->allocated() < LEDS * sizeof(uint32_t));
+  TEST_ASSERT_NULL(dec->pixels());
+  const std::vector<uint32_t> a = randomFrame(), b = randomFrame();
+  feed(encode(2, a, true), 1100);
+  TEST_ASSERT_EQUAL(SERIAL_ACK_OK, statuses.back());
+  TEST_ASSERT_TRUE(dec->allocated() > LEDS * sizeof(uint32_t));
+  feed(Bytes(), 1100 + SERIAL_FRAME_RELEASE);
+  TEST_ASSERT_TRUE(dec->allocated() > 0);
+  feed(Bytes(), 1100 + SERIAL_FRAME_RELEASE + 1);
+  TEST_ASSERT_EQUAL(0, dec->allocated());
+  feed(encode(3, b, true, &a), 20000);      // delta base is gone with the buffer
+  TEST_ASSERT_EQUAL(SERIAL_ACK_KEYFRAME, statuses.back());
+  feed(encode(3, b, true), 20010);
+  TEST_ASSERT_EQUAL(SERIAL_ACK_OK, statuses.back());
+  TEST_ASSERT_TRUE(shows(b));
+}
+
+// decoding speed of a 2048 pixel RLE frame
+void test_benchmark(void) {
+  const unsigned frames = 5000;
+  const std::vector<uint32_t> px = randomFrame();
+  const Bytes f = encode(0, px, true, nullptr, 0);
+  double t0 = hostSeconds();
+  for (unsigned i = 0; i < frames; i++) {
+    serial = HostStream();
+    feed(f, i, f.size());
+  }
+  double t1 = hostSeconds();
+  TEST_ASSERT_EQUAL(frames, dec->stats.frames);
+  char msg[96];
+  snprintf(msg, sizeof(msg), "%u bytes per frame, %.1f us per frame", (unsigned)f.size(), (t1 - t0) * 1e6 / frames);
+  TEST_MESSAGE(msg);
+}
+
+// Serial on a pseudo terminal: bytes arrive as the kernel delivers them, peek() is served from a read-ahead buffer
+struct PtyStream {
+  int fd;
+  Bytes buf;
+  size_t pos = 0;
+  void fill() {
+    if (pos == buf.size()) { buf.clear(); pos = 0; }
+    uint8_t tmp[4096];
+    const ssize_t n = ::read(fd, tmp, sizeof(tmp));
+    if (n > 0) buf.insert(buf.end(), tmp, tmp + n);
+  }
+  int available() { if (pos == buf.size()) fill(); return int(buf.size() - pos); }
+  int peek() { return available() ? buf[pos] : -1; }
+  int read() { return available() ? buf[pos++] : -1; }
+  size_t readBytes(uint8_t *dst, size_t n) {
+    if (n > size_t(available())) n = available();
+    memcpy(dst, &buf[pos], n);
+    pos += n;
+    return n;
+  }
+  size_t write(const uint8_t *src, size_t n) { return ::write(fd, src, n) == ssize_t(n) ? n : 0; }
+};
+
+static unsigned long hostNow() { return (unsigned long)(hostSeconds() * 1000.0); }
+
+// sustained frame rate at 2048 pixels: the sender waits for the acknowledgement of every frame (flow control)
+static void replay(int master, const std::vector<Bytes> &stream, unsigned frames, std::atomic<unsigned> &acked) {
+  uint8_t ack[4];
+  for (unsigned i = 0; i < frames; i++) {
+    const Bytes &f = stream[i % stream.size()];
+    for (size_t sent = 0; sent < f.size(); ) {
+      const ssize_t n = ::write(master, f.data() + sent, f.size() - sent);
+      if (n <= 0) return;
+      sent += n;
+    }
+    for (size_t got = 0; got < sizeof(ack); ) {
+      pollfd p = {master, POLLIN, 0};
+      if (poll(&p, 1, 1000) <= 0) return;
+      const ssize_t n = ::read(master, ack + got, sizeof(ack) - got);
+      if (n <= 0) return;
+      got += n;
+    }
+    if (ack[0] != SERIAL_FRAME_START || ack[1] != SERIAL_FRAME_ACK || ack[3] != SERIAL_ACK_OK) return;
+    acked++;
+  }
+}
+
+void test_pty_replay(void) {
+  const int master = posix_openpt(O_RDWR | O_NOCTTY);
+  TEST_ASSERT_TRUE(master >= 0);
+  TEST_ASSERT_EQUAL(0, grantpt(master));
+  TEST_ASSERT_EQUAL(0, unlockpt(master));
+  PtyStream pty;
+  pty.fd = open(ptsname(master), O_RDWR | O_NOCTTY | O_NONBLOCK);
+  TEST_ASSERT_TRUE(pty.fd >= 0);
+  termios tio;
+  tcgetattr(pty.fd, &tio);
+  cfmakeraw(&tio);
+  tcsetattr(pty.fd, TCSANOW, &tio);
+
+  // raw key frames of random pixels, and RLE delta frames in which a tenth of the pixels changes
+  const char *names[] = {"raw", "RLE delta"};
+  for (unsigned variant = 0; variant < 2; variant++) {
+    std::vector<Bytes> stream;
+    std::vector<std::vector<uint32_t>> expect;
+    std::vector<uint32_t> px = randomFrame();
+    size_t bytes = 0;
+    for (unsigned f = 0; f < 16; f++) {
+      const std::vector<uint32_t> prev = px;
+      if (variant == 0) px = randomFrame();
+      else for (unsigned i = 0; i < LEDS / 10; i++) px[nextRandom() % LEDS] = nextRandom() & 0xFFFFFF;
+      stream.push_back(encode(f, px, variant == 1, variant == 1 && f ? &prev : nullptr));
+      expect.push_back(px);
+      bytes += stream.back().size();
+    }
+    delete dec;
+    dec = new SerialFrameDecoder();
+    replayed = &expect;
+    committed = mismatches = 0;
+    const unsigned frames = 480;
+    std::atomic<unsigned> acked(0);
+    const double t0 = hostSeconds();
+    std::thread sender(replay, master, std::cref(stream), frames, std::ref(acked));
+    while (acked < frames && hostSeconds() - t0 < 20.0) {
+      pollfd p = {pty.fd, POLLIN, 0};
+      poll(&p, 1, 10);
+      handleSerial(pty, hostNow());
+    }
+    sender.join();
+    replayed = nullptr;
+    const double t = hostSeconds() - t0;
+    TEST_ASSERT_EQUAL(frames, acked.load());
+    TEST_ASSERT_EQUAL(frames, committed);
+    TEST_ASSERT_EQUAL(0, mismatches);
+    TEST_ASSERT_TRUE(frames / t > 30.0);
+    char msg[128];
+    snprintf(msg, sizeof(msg), "pty, %u pixels, %s: %u bytes per frame, %.0f frames/s, %.1f MB/s",
+      LEDS, names[variant], unsigned(bytes / stream.size()), frames / t, bytes / stream.size() * frames / t / 1e6);
+    TEST_MESSAGE(msg);
+  }
+  close(pty.fd);
+  close(master);
+}
+
+int main(void) {
+  UNITY_BEGIN();
+  RUN_TEST(test_encodings);
+  RUN_TEST(test_crc_and_keyframe);
+  RUN_TEST(test_rejected_header_payload_dropped);
+  RUN_TEST(test_crc_error_resyncs_on_start_byte);
+  RUN_TEST(test_timeout);
+  RUN_TEST(test_buffer_lifetime);
+  RUN_TEST(test_benchmark);
+  RUN_TEST(test_pty_replay);
+  return UNITY_END();
+}
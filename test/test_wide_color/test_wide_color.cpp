@@ -0,0 +1,248 @@
+// wide color (4x16 bit) kernels, temporal dithering (wled00/color16.h) and 16 bit bus helpers (wled00/bus_lut.h)
+#include <unity.h>
+#include <stdio.h>
+#include <math.h>
+#include <algorithm>
+#include "wled_host.h"
+#include "bus_lut.h"
+#include "color16.h"
+
+static const uint8_t correction[3] = {255, 178, 97}; // white balance of ~2700K
+static uint8_t gammaT[256];
+
+static uint32_t rnd = 1;
+static uint32_t nextRandom() { rnd ^= rnd << 13; rnd ^= rnd >> 17; rnd ^= rnd << 5; return rnd; }
+
+// bus_manager.cpp: Bus::autoWhiteCalc() (without CCT)
+static uint32_t autoWhiteCalc(unsigned aWM, uint32_t c) {
+  unsigned w = c >> 24;
+  if (aWM != RGBW_MODE_MANUAL_ONLY) {
+    unsigned r = (c >> 16) & 0xFF, g = (c >> 8) & 0xFF, b = c & 0xFF;
+    if (aWM == RGBW_MODE_DUAL && w > 0) {
+    } else if (aWM == RGBW_MODE_MAX) {
+      w = r > g ? (r > b ? r : b) : (g > b ? g : b);
+    } else {
+      w = r < g ? (r < b ? r : b) : (g < b ? g : b);
+      if (aWM == RGBW_MODE_AUTO_ACCURATE) { r -= w; g -= w; b -= w; }
+    }
+    c = (w << 24) | (r << 16) | (g << 8) | b;
+  }
+  return c;
+}
+
+// bus_wrapper.h: PolyBus::setPixelColor() channel order (8 bit), returns W, R, G, B slots of the chip
+static uint32_t colorOrder8(uint8_t co, uint32_t c) {
+  const uint8_t r = c >> 16, g = c >> 8, b = c, w = c >> 24;
+  uint8_t R, G, B, W;
+  switch (co & 0x0F) {
+    default: G = g; R = r; B = b; break;
+    case  1: G = r; R = g; B = b; break;
+    case  2: G = b; R = r; B = g; break;
+    case  3: G = r; R = b; B = g; break;
+    case  4: G = b; R = g; B = r; break;
+    case  5: G = g; R = b; B = r; break;
+  }
+  switch (co >> 4) {
+    default: W = w;        break;
+    case  1: W = B; B = w; break;
+    case  2: W = G; G = w; break;
+    case  3: W = R; R = w; break;
+  }
+  return (uint32_t(W) << 24) | (uint32_t(R) << 16) | (uint32_t(G) << 8) | B;
+}
+
+void setUp(void) {
+  rnd = 1;
+  for (unsigned i = 0; i < 256; i++) gammaT[i] = (uint8_t)(powf(i / 255.0f, 2.8f) * 255.0f + 0.5f); // calcGammaTable()
+}
+void tearDown(void) {}
+
+// widening is exact and reversible, narrowing rounds to the nearest 8 bit level
+void test_widen_narrow(void) {
+  for (unsigned v = 0; v < 256; v++) TEST_ASSERT_EQUAL_UINT8(v, narrow8(v * 257));
+  for (unsigned v = 0; v < 65536; v++) TEST_ASSERT_EQUAL_UINT8((unsigned)lround(v / 257.0), narrow8(v));
+  for (int i = 0; i < 10000; i++) {
+    const uint32_t c = nextRandom();
+    const uint64_t c16 = color_widen(c);
+    TEST_ASSERT_EQUAL_UINT16(((c >> 16) & 0xFF) * 257, R16(c16));
+    TEST_ASSERT_EQUAL_UINT16((c >> 24) * 257, W16(c16));
+    TEST_ASSERT_EQUAL_HEX32(c, color_narrow(c16));
+  }
+}
+
+// wide blend matches color_blend() within one 8 bit step but keeps the fraction
+void test_blend64(void) {
+  for (int i = 0; i < 20000; i++) {
+    const uint32_t a = nextRandom(), b = nextRandom();
+    const uint8_t o = nextRandom();
+    const uint64_t a16 = color_widen(a), b16 = color_widen(b);
+    TEST_ASSERT_TRUE(color_blend64(a16, b16, 0) == a16);
+    TEST_ASSERT_TRUE(color_blend64(a16, b16, 65535) == b16);
+    const uint32_t c8 = color_blend(a, b, o), c16 = color_narrow(color_blend64(a16, b16, o * 257));
+    for (unsigned s = 0; s < 32; s += 8) TEST_ASSERT_INT_WITHIN(1, (c8 >> s) & 0xFF, (c16 >> s) & 0xFF);
+  }
+  // dim color faded in by opacity: 8 bit blend has as many levels as the color, wide blend one per opacity step
+  unsigned levels8 = 0, levels16 = 0, last8 = 256, last16 = 65536;
+  for (unsigned o = 0; o < 256; o++) {
+    const unsigned v8  = color_blend(0, 0x00141414, o) & 0xFF;
+    const unsigned v16 = B16(color_blend64(0, color_widen(0x00141414), o * 257));
+    if (v8 != last8) levels8++;
+    if (v16 != last16) levels16++;
+    last8 = v8; last16 = v16;
+  }
+  TEST_ASSERT_LESS_OR_EQUAL(21, levels8);
+  TEST_ASSERT_EQUAL(256, levels16);
+}
+
+// fade16() is the brightness scaling of the 16 bit bus path
+void test_fade16(void) {
+  for (unsigned bri = 0; bri < 256; bri++) {
+    const uint32_t scale = bri * 257U;
+    for (unsigned v = 0; v < 65536; v += 13) {
+      const uint32_t ref = bri == 255 ? v : (bri == 0 ? 0 : (v ? std::max<uint32_t>((v * scale + 0x8000) >> 16, 1) : 0)); // BusDigital::setPixelColor16()
+      TEST_ASSERT_EQUAL_UINT16(ref, fade16(v, scale, true));
+    }
+  }
+  TEST_ASSERT_EQUAL_UINT16(0, fade16(100, 256, false));
+  TEST_ASSERT_EQUAL_UINT16(1, fade16(100, 256, true));
+  TEST_ASSERT_TRUE(color_fade64(RGBW64(65535, 1000, 0, 7), 65535) == RGBW64(65535, 1000, 0, 7));
+  TEST_ASSERT_TRUE(color_fade64(RGBW64(65535, 1000, 0, 7), 32768) == RGBW64(32768, 500, 0, 4));
+}
+
+// interpolated 16 bit gamma is exact for widened values and monotonic in between
+void test_gamma_wide(void) {
+  BusColorLUT16 lut;
+  lut.build(2700, 1, correction, 2.8f);
+  for (unsigned ch = 0; ch < 4; ch++) {
+    for (unsigned v = 0; v < 256; v++) TEST_ASSERT_EQUAL_UINT16(lut(ch, v), lut.wide(ch, v * 257));
+    for (unsigned v = 1; v < 65536; v++) TEST_ASSERT_TRUE(lut.wide(ch, v) >= lut.wide(ch, v - 1));
+  }
+  // dim fade through 16 bit gamma: output levels of the 8 bit and the wide blend
+  unsigned levels8 = 0, levels16 = 0, last8 = 65536, last16 = 65536;
+  for (unsigned o = 0; o < 256; o++) {
+    const unsigned v8  = lut(3, color_blend(0, 0x28000000, o) >> 24);
+    const unsigned v16 = lut.wide(3, W16(color_blend64(0, color_widen(0x28000000), o * 257)));
+    if (v8 != last8) levels8++;
+    if (v16 != last16) levels16++;
+    last8 = v8; last16 = v16;
+  }
+  char msg[96];
+  snprintf(msg, sizeof(msg), "fade of level 40 at gamma 2.8: %u output levels (8 bit frame buffer), %u (wide)", levels8, levels16);
+  TEST_MESSAGE(msg);
+  TEST_ASSERT_GREATER_THAN(4 * levels8, levels16);
+}
+
+// temporal dithering: average over 16 frames is the 16 bit level (1/16 step), thresholds differ between neighbours
+void test_dither(void) {
+  for (unsigned v = 0; v < 65536; v += 37) {
+    for (unsigned pix = 0; pix < 4; pix++) for (unsigned start = 0; start < 256; start += 85) {
+      unsigned sum = 0;
+      for (unsigned f = 0; f < 16; f++) sum += dither8(v, ditherThreshold(start + f, pix));
+      const double avg = sum / 16.0, exact = (v - (v >> 8)) / 256.0;
+      TEST_ASSERT_TRUE(fabs(avg - exact) <= 1.0 / 32 + 1e-9);
+      TEST_ASSERT_TRUE(sum / 16 == narrow8(v) || sum / 16 + 1 == narrow8(v) || sum / 16 == narrow8(v) + 1u);
+    }
+  }
+  for (unsigned f = 0; f < 256; f++) {
+    TEST_ASSERT_EQUAL_UINT8(255, dither8(65535, ditherThreshold(f, f)));
+    TEST_ASSERT_EQUAL_UINT8(0, dither8(0, ditherThreshold(f, f)));
+    TEST_ASSERT_EQUAL_UINT8(100, dither8(100 * 257, ditherThreshold(f, f))); // widened levels are never dithered
+    TEST_ASSERT_TRUE(ditherThreshold(f, 0) != ditherThreshold(f, 1));
+  }
+}
+
+// 16 bit auto white equals the 8 bit calculation for widened colors
+void test_auto_white16(void) {
+  const unsigned modes[] = {RGBW_MODE_MANUAL_ONLY, RGBW_MODE_AUTO_BRIGHTER, RGBW_MODE_AUTO_ACCURATE, RGBW_MODE_DUAL, RGBW_MODE_MAX};
+  for (unsigned mode : modes) for (int i = 0; i < 5000; i++) {
+    uint32_t c = nextRandom();
+    if (i & 1) c &= 0x00FFFFFF; // DUAL calculates white only if it is off
+    uint32_t r = ((c >> 16) & 0xFF) * 257, g = ((c >> 8) & 0xFF) * 257, b = (c & 0xFF) * 257, w = (c >> 24) * 257;
+    autoWhite16(mode, r, g, b, w);
+    TEST_ASSERT_TRUE(color_widen(autoWhiteCalc(mode, c)) == RGBW64(r, g, b, w));
+  }
+}
+
+// 16 bit color order of PolyBus::setPixelColor16() equals the 8 bit color order
+void test_color_order16(void) {
+  for (unsigned co = 0; co < 0x50; co++) {
+    if ((co & 0x0F) > 5) continue;
+    for (int i = 0; i < 100; i++) {
+      const uint32_t c = nextRandom();
+      uint16_t r = ((c >> 16) & 0xFF) * 257, g = ((c >> 8) & 0xFF) * 257, b = (c & 0xFF) * 257, w = (c >> 24) * 257, ww = 1, cw = 2;
+      busColorOrder16(co, r, g, b, w, ww, cw);
+      TEST_ASSERT_TRUE(color_widen(colorOrder8(co, c)) == RGBW64(r, g, b, w));
+      TEST_ASSERT_EQUAL_UINT16((co >> 4) == 4 ? 2 : 1, ww);
+      TEST_ASSERT_EQUAL_UINT16((co >> 4) == 4 ? 1 : 2, cw);
+    }
+  }
+}
+
+// 2048 pixels: frame buffer RAM and ns/pixel of composing (one segment at opacity 200) and output of the 8 bit path
+// vs. the wide color path (16 bit bus at full precision, 8 bit bus with dithering)
+void test_benchmark(void) {
+  const unsigned frames = 500, pixels = 2048, n = frames * pixels;
+  static uint32_t seg[pixels], fb[pixels];
+  static uint64_t fb16[pixels];
+  for (auto &c : seg) c = nextRandom();
+  BusColorLUT lut;
+  BusColorLUT16 lut16;
+  lut.buildPre(2700, 1, correction, gammaT);
+  lut.buildBri(128);
+  lut16.build(2700, 1, correction, 2.8f);
+  const uint16_t bri = 128 * 257;
+  uint32_t sum[3] = {0};
+  double t[6];
+  t[0] = hostSeconds();
+  for (unsigned f = 0; f < frames; f++) {
+    memset(fb, 0, sizeof(fb));
+    for (unsigned i = 0; i < pixels; i++) fb[i] = color_blend(fb[i], seg[i], 200);
+  }
+  t[1] = hostSeconds();
+  for (unsigned f = 0; f < frames; f++) for (unsigned i = 0; i < pixels; i++) sum[0] += lut.fade(lut.pre(fb[i]));
+  t[2] = hostSeconds();
+  for (unsigned f = 0; f < frames; f++) {
+    memset(fb16, 0, sizeof(fb16));
+    for (unsigned i = 0; i < pixels; i++) {
+      const uint64_t c16 = color_blend64(fb16[i], color_widen(seg[i]), 200 * 257);
+      fb16[i] = c16;
+      fb[i] = color_narrow(c16);
+    }
+  }
+  t[3] = hostSeconds();
+  for (unsigned f = 0; f < frames; f++) for (unsigned i = 0; i < pixels; i++) {
+    const uint64_t c = color_narrow(fb16[i]) == fb[i] ? fb16[i] : color_widen(fb[i]);
+    sum[1] += fade16(lut16.wide(0, R16(c)), bri, true) + fade16(lut16.wide(1, G16(c)), bri, true) + fade16(lut16.wide(2, B16(c)), bri, true) + fade16(lut16.wide(3, W16(c)), bri, true);
+  }
+  t[4] = hostSeconds();
+  for (unsigned f = 0; f < frames; f++) for (unsigned i = 0; i < pixels; i++) {
+    const uint64_t c = color_narrow(fb16[i]) == fb[i] ? fb16[i] : color_widen(fb[i]);
+    const uint8_t th = ditherThreshold(f, i);
+    sum[2] += dither8(fade16(lut16.wide(0, R16(c)), bri, true), th) + dither8(fade16(lut16.wide(1, G16(c)), bri, true), th)
+            + dither8(fade16(lut16.wide(2, B16(c)), bri, true), th) + dither8(fade16(lut16.wide(3, W16(c)), bri, true), th);
+  }
+  t[5] = hostSeconds();
+  TEST_ASSERT_TRUE(sum[0] && sum[1] && sum[2]);
+  char msg[160];
+  snprintf(msg, sizeof(msg), "frame buffer RAM: 8 bit %u B/px, wide %u B/px (+%u B table per 8 bit bus)",
+           (unsigned)sizeof(uint32_t), (unsigned)(sizeof(uint32_t) + sizeof(uint64_t)), (unsigned)sizeof(BusColorLUT16));
+  TEST_MESSAGE(msg);
+  snprintf(msg, sizeof(msg), "compose: 8 bit %.1f ns/px, wide %.1f ns/px", (t[1] - t[0]) * 1e9 / n, (t[3] - t[2]) * 1e9 / n);
+  TEST_MESSAGE(msg);
+  snprintf(msg, sizeof(msg), "output: 8 bit %.1f ns/px, wide 16 bit bus %.1f ns/px, wide dithered 8 bit bus %.1f ns/px",
+           (t[2] - t[1]) * 1e9 / n, (t[4] - t[3]) * 1e9 / n, (t[5] - t[4]) * 1e9 / n);
+  TEST_MESSAGE(msg);
+}
+
+int main(void) {
+  UNITY_BEGIN();
+  RUN_TEST(test_widen_narrow);
+  RUN_TEST(test_blend64);
+  RUN_TEST(test_fade16);
+  RUN_TEST(test_gamma_wide);
+  RUN_TEST(test_dither);
+  RUN_TEST(test_auto_white16);
+  RUN_TEST(test_color_order16);
+  RUN_TEST(test_benchmark);
+  return UNITY_END();
+}
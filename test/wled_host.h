@@ -0,0 +1,96 @@
+/* wled_host.h
+
+Stand-ins for the few firmware functions used by the self-contained helpers in wled00 (header only), so they can be unit
+tested on the build host (pio test -e native). Include before the header under test.
+
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+
+typedef uint8_t byte;
+
+#define PROGMEM
+#define PSTR(s) (s)
+#define FPSTR(s) (s)
+#define F(s) (s)
+#define memcpy_P memcpy
+#define strlen_P strlen
+#define strncpy_P strncpy
+#define pgm_read_byte(p) (*(const uint8_t*)(p))
+#define pgm_read_dword(p) (*(const uint32_t*)(p))
+
+// allocation (fcn_declare.h)
+#define BFRALLOC_NOBYTEACCESS    (1 << 0)
+#define BFRALLOC_PREFER_DRAM     (1 << 1)
+#define BFRALLOC_ENFORCE_DRAM    (1 << 2)
+#define BFRALLOC_PREFER_PSRAM    (1 << 3)
+#define BFRALLOC_ENFORCE_PSRAM   (1 << 4)
+#define BFRALLOC_CLEAR           (1 << 5)
+inline void *p_malloc(size_t size)              { return malloc(size); }
+inline void *p_calloc(size_t count, size_t size) { return calloc(count, size); }
+inline void *p_realloc(void *ptr, size_t size)   { return realloc(ptr, size); }
+inline void  p_free(void *ptr)                   { free(ptr); }
+inline void *d_malloc(size_t size)              { return malloc(size); }
+inline void *d_calloc(size_t count, size_t size) { return calloc(count, size); }
+inline void  d_free(void *ptr)                   { free(ptr); }
+inline void *allocate_buffer(size_t size, uint32_t type) { return type & BFRALLOC_CLEAR ? calloc(size, 1) : malloc(size); }
+
+// time: tests move the clock with hostMillis
+static uint32_t hostMillis = 0;
+inline uint32_t millis() { return hostMillis; }
+inline uint32_t micros() { return hostMillis * 1000; }
+
+// const.h
+#define RGBW_MODE_MANUAL_ONLY     0
+#define RGBW_MODE_AUTO_BRIGHTER   1
+#define RGBW_MODE_AUTO_ACCURATE   2
+#define RGBW_MODE_DUAL            3
+#define RGBW_MODE_MAX             4
+
+// colors.cpp (same arithmetic)
+inline uint32_t color_blend(uint32_t color1, uint32_t color2, uint8_t blend) {
+  const uint32_t TWO_CHANNEL_MASK = 0x00FF00FF;
+  uint32_t rb1 =  color1       & TWO_CHANNEL_MASK;
+  uint32_t wg1 = (color1 >> 8) & TWO_CHANNEL_MASK;
+  uint32_t rb2 =  color2       & TWO_CHANNEL_MASK;
+  uint32_t wg2 = (color2 >> 8) & TWO_CHANNEL_MASK;
+  uint32_t rb3 = ((((rb1 << 8) | rb2) + (rb2 * blend) - (rb1 * blend)) >> 8) &  TWO_CHANNEL_MASK;
+  uint32_t wg3 = ((((wg1 << 8) | wg2) + (wg2 * blend) - (wg1 * blend)))      & ~TWO_CHANNEL_MASK;
+  return rb3 | wg3;
+}
+
+inline uint32_t color_fade(uint32_t c1, uint8_t amount, bool video = false) {
+  if (c1 == 0 || amount == 0) return 0;
+  if (amount == 255) return c1;
+  const uint32_t TWO_CHANNEL_MASK = 0x00FF00FF;
+  uint32_t rb = c1 & TWO_CHANNEL_MASK;
+  uint32_t wg = (c1 >> 8) & TWO_CHANNEL_MASK;
+  uint32_t rb_scaled;
+  uint32_t wg_scaled;
+  if (video) {
+    rb_scaled = ((rb * amount + 0x007F007F) >> 8) & TWO_CHANNEL_MASK;
+    wg_scaled = (wg * amount + 0x007F007F) & ~TWO_CHANNEL_MASK;
+    uint8_t r = uint8_t(rb>>16), g = uint8_t(wg), b = uint8_t(rb), w = uint8_t(wg>>16);
+    uint8_t maxc = (r > g) ? ((r > b) ? r : b) : ((g > b) ? g : b);
+    maxc = (maxc>>2) + 1;
+    rb_scaled |= r > maxc ? 0x00010000 : 0;
+    wg_scaled |= g > maxc ? 0x00000100 : 0;
+    rb_scaled |= b > maxc ? 0x00000001 : 0;
+    wg_scaled |= w ? 0x01000000 : 0;
+  } else {
+    rb_scaled = ((rb * (amount + 1)) >> 8) & TWO_CHANNEL_MASK;
+    wg_scaled = ((wg * (amount + 1)) & ~TWO_CHANNEL_MASK);
+  }
+  return (rb_scaled | wg_scaled);
+}
+
+// wall clock for benchmarks
+inline double hostSeconds() {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
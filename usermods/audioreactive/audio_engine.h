@@ -0,0 +1,413 @@
+/* audio_engine.h
+
+Platform independent building blocks of the AudioReactive analysis pipeline:
+ - fixed-point (Q15) real FFT for 256/512/1024 samples, radix-4 with a radix-2 stage where needed
+ - pre-computed mapping tables from FFT bins to GEQ channels for any FFT size / sample rate
+ - onset detection (spectral flux) and tempo tracking (autocorrelation of the onset envelope), fixed-point
+ - analysis statistics (frames per second, time spent per stage)
+
+Nothing in here depends on Arduino or ESP-IDF, so the same code can be compiled on a PC
+(e.g. to run recorded WAV files through the analysis and compare results).
+
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#define AUDIO_ENGINE_GEQ_CHANNELS 16  // must match NUM_GEQ_CHANNELS of AudioReactive
+
+//
+// fixed-point real FFT
+//
+// compute() takes N real samples (int16) and returns the magnitudes of the first N/2 bins in the same buffer.
+// The N real samples are processed as N/2 complex values (even samples = real part, odd samples = imaginary part),
+// so the buffer needs no extra space. Results are scaled by 1/N, like the ESP-DSP sc16 FFT.
+//
+class AudioFixedFFT {
+  public:
+    enum Window : uint8_t { BLACKMAN_HARRIS = 0, FLAT_TOP = 1 };
+
+    AudioFixedFFT() : _size(0), _window(nullptr), _cos(nullptr) {}
+    ~AudioFixedFFT() { end(); }
+
+    // allocate and calculate window and twiddle tables, size must be 256, 512 or 1024
+    bool init(uint16_t size, Window window) {
+      end();
+      if (size != 256 && size != 512 && size != 1024) return false;
+      _window = (int16_t*)malloc(size * sizeof(int16_t));
+      _cos    = (int16_t*)malloc(size * sizeof(int16_t));
+      if (!_window || !_cos) { end(); return false; }
+      _size = size;
+      const double pi2 = 2.0 * M_PI;
+      for (unsigned i = 0; i < size; i++) {
+        const double x = pi2 * i / (size - 1);
+        double w;
+        if (window == FLAT_TOP) w = 0.21557895 - 0.41663158*cos(x) + 0.277263158*cos(2*x) - 0.083578947*cos(3*x) + 0.006947368*cos(4*x);
+        else                    w = 0.35875    - 0.48829   *cos(x) + 0.14128    *cos(2*x) - 0.01168    *cos(3*x);
+        _window[i] = toQ15(w);
+        _cos[i]    = toQ15(cos(pi2 * i / size)); // full circle, sin(x) is read as cos(x - pi/2)
+      }
+      return true;
+    }
+
+    void end() {
+      free(_window); _window = nullptr;
+      free(_cos);    _cos    = nullptr;
+      _size = 0;
+    }
+
+    inline uint16_t size() const { return _size; }
+
+    // remove DC offset, apply window, run FFT and convert to magnitudes (buffer[0 .. size/2-1])
+    void compute(int16_t *buffer) const {
+      if (!_size) return;
+      const unsigned N = _size;
+      const unsigned M = N / 2;   // number of complex values
+      int16_t *z = buffer;        // interleaved complex values [Re,Im,Re,Im,...]
+
+      // DC removal and window, samples are scaled down by 2 to keep one bit of headroom for the butterflies
+      int32_t sum = 0;
+      for (unsigned i = 0; i < N; i++) sum += buffer[i];
+      const int32_t mean = sum / (int32_t)N;
+      for (unsigned i = 0; i < N; i++) {
+        int32_t v = ((buffer[i] - mean) * (int32_t)_window[i] + (1 << 15)) >> 16;
+        buffer[i] = v > 16384 ? 16384 : (v < -16384 ? -16384 : v);
+      }
+
+      // bit reversal of complex values
+      for (unsigned i = 1, j = 0; i < M; i++) {
+        unsigned bit = M >> 1;
+        for (; j & bit; bit >>= 1) j ^= bit;
+        j |= bit;
+        if (i < j) {
+          int16_t t = z[2*i];   z[2*i]   = z[2*j];   z[2*j]   = t;
+          t         = z[2*i+1]; z[2*i+1] = z[2*j+1]; z[2*j+1] = t;
+        }
+      }
+
+      // radix-2 stage if M is not a power of 4 (each stage scales by 1/2 or 1/4 to prevent overflow)
+      unsigned L = 1;
+      if (__builtin_ctz(M) & 1) {
+        for (unsigned i = 0; i < M; i += 2) {
+          int32_t ar = z[2*i],   ai = z[2*i+1];
+          int32_t br = z[2*i+2], bi = z[2*i+3];
+          z[2*i]   = (ar + br + 1) >> 1; z[2*i+1] = (ai + bi + 1) >> 1;
+          z[2*i+2] = (ar - br + 1) >> 1; z[2*i+3] = (ai - bi + 1) >> 1;
+        }
+        L = 2;
+      }
+
+      // radix-4 stages, each combines four DFTs of length L into one of length 4L
+      // after bit reversal the sub-DFTs at offset 0, L, 2L, 3L hold the samples with index 0, 2, 1, 3 (mod 4)
+      for (; L < M; L *= 4) {
+        const unsigned step = N / (4 * L);  // twiddle W(4L)^j = W(N)^(j*step)
+        for (unsigned j = 0; j < L; j++) {
+          int32_t w1r, w1i, w2r, w2i, w3r, w3i;
+          twiddle(j * step,     w1r, w1i);
+          twiddle(2 * j * step, w2r, w2i);
+          twiddle(3 * j * step, w3r, w3i);
+          for (unsigned k = j; k < M; k += 4 * L) {
+            int16_t *p0 = z + 2*k, *p1 = z + 2*(k+L), *p2 = z + 2*(k+2*L), *p3 = z + 2*(k+3*L);
+            int32_t ar = p0[0], ai = p0[1];
+            int32_t br, bi, cr, ci, dr, di;
+            cmul(p1[0], p1[1], w2r, w2i, br, bi);  // samples 2 (mod 4)
+            cmul(p2[0], p2[1], w1r, w1i, cr, ci);  // samples 1 (mod 4)
+            cmul(p3[0], p3[1], w3r, w3i, dr, di);  // samples 3 (mod 4)
+            const int32_t s0r = ar + br, s0i = ai + bi, d0r = ar - br, d0i = ai - bi;
+            const int32_t s1r = cr + dr, s1i = ci + di, d1r = cr - dr, d1i = ci - di;
+            p0[0] = (s0r + s1r + 2) >> 2; p0[1] = (s0i + s1i + 2) >> 2;  // A + B + C + D
+            p2[0] = (s0r - s1r + 2) >> 2; p2[1] = (s0i - s1i + 2) >> 2;  // A + B - C - D
+            p1[0] = (d0r + d1i + 2) >> 2; p1[1] = (d0i - d1r + 2) >> 2;  // A - B - i(C - D)
+            p3[0] = (d0r - d1i + 2) >> 2; p3[1] = (d0i + d1r + 2) >> 2;  // A - B + i(C - D)
+          }
+        }
+      }
+
+      // split complex spectrum into spectrum of the real input: X[k] = E + W(N)^k * O, X[M-k] = conj(E - W(N)^k * O)
+      {
+        const int32_t ar = z[0], ai = z[1];
+        z[0] = sat16(ar + ai); z[1] = 0; // DC
+      }
+      for (unsigned k = 1; k <= M/2; k++) {
+        const unsigned m = M - k;
+        const int32_t zkr = z[2*k], zki = z[2*k+1];
+        const int32_t zmr = z[2*m], zmi = -z[2*m+1]; // conj(Z[M-k])
+        const int32_t er = (zkr + zmr) >> 1, ei = (zki + zmi) >> 1;
+        const int32_t or_ = (zki - zmi) >> 1, oi = (zmr - zkr) >> 1; // -i * (Z[k] - conj(Z[M-k])) / 2
+        int32_t wr, wi, tr, ti;
+        twiddle(k, wr, wi);
+        cmul(or_, oi, wr, wi, tr, ti);
+        z[2*k] = sat16(er + tr); z[2*k+1] = sat16(ei + ti);
+        z[2*m] = sat16(er - tr); z[2*m+1] = sat16(ti - ei);
+      }
+
+      // magnitudes, written front to back over the already processed complex values
+      for (unsigned k = 0; k < M; k++) {
+        const int32_t re = z[2*k], im = z[2*k+1];
+        buffer[k] = isqrt32(uint32_t(re*re) + uint32_t(im*im));
+      }
+    }
+
+    // integer square root (bitwise)
+    static uint16_t isqrt32(uint32_t x) {
+      uint32_t r = 0, b = 1UL << 30;
+      while (b > x) b >>= 2;
+      while (b) {
+        if (x >= r + b) { x -= r + b; r = (r >> 1) + b; }
+        else r >>= 1;
+        b >>= 2;
+      }
+      return r;
+    }
+
+  private:
+    uint16_t _size;
+    int16_t *_window;
+    int16_t *_cos;
+
+    static int16_t toQ15(double v) { return (int16_t)lround(v * 32767.0); }
+    static int16_t sat16(int32_t v) { return v > 32767 ? 32767 : (v < -32768 ? -32768 : v); }
+
+    // W(N)^n = cos(2*pi*n/N) - i*sin(2*pi*n/N)
+    inline void twiddle(unsigned n, int32_t &wr, int32_t &wi) const {
+      wr =  _cos[n & (_size-1)];
+      wi = -_cos[(n - _size/4) & (_size-1)];
+    }
+    // complex multiplication with Q15 factor
+    static inline void cmul(int32_t ar, int32_t ai, int32_t wr, int32_t wi, int32_t &rr, int32_t &ri) {
+      rr = (ar * wr - ai * wi + (1 << 14)) >> 15;
+      ri = (ar * wi + ai * wr + (1 << 14)) >> 15;
+    }
+};
+
+//
+// mapping of FFT bins to GEQ channels
+//
+// The reference mapping was optimized for 512 samples at 22050 Hz (43 Hz per bin, by softhack007),
+// for other FFT sizes and sample rates the bin ranges are scaled to cover the same frequencies.
+//
+typedef struct AudioGEQBand {
+  uint16_t from;  // first FFT bin
+  uint16_t to;    // last FFT bin (inclusive)
+  float    gain;  // damping of channel
+} audiogeqband_t;
+
+class AudioGEQMap {
+  public:
+    AudioGEQBand bands[AUDIO_ENGINE_GEQ_CHANNELS];          // full range
+    AudioGEQBand bandsBandPass[AUDIO_ENGINE_GEQ_CHANNELS];  // frequencies below 100Hz and high end removed
+
+    void build(uint16_t fftSize, uint32_t sampleRate) {
+      static const AudioGEQBand ref[AUDIO_ENGINE_GEQ_CHANNELS] = {
+        {  1,   2, 1.0f}, {  2,   3, 1.0f}, {  3,   5, 1.0f}, {  5,   7, 1.0f},   // sub-bass, bass, bass + midrange
+        {  7,  10, 1.0f}, { 10,  13, 1.0f}, { 13,  19, 1.0f}, { 19,  26, 1.0f},   // midrange -- 1kHz should always be the center
+        { 26,  33, 1.0f}, { 33,  44, 1.0f}, { 44,  56, 1.0f}, { 56,  70, 1.0f},   // midrange + high mid
+        { 70,  86, 1.0f}, { 86, 104, 1.0f}, {104, 165, 0.88f},{165, 215, 0.70f}   // high mid + high, don't use the last bins (aliasing)
+      };
+      static const AudioGEQBand refBandPass[4] = { {3, 4, 0.8f}, {4, 5, 0.9f}, {5, 6, 1.0f}, {6, 7, 1.0f} };
+      static const AudioGEQBand refBandPassHigh = {165, 205, 0.75f};
+
+      const float scale = (22050.0f / 512.0f) / (float(sampleRate) / float(fftSize)); // reference bin width / actual bin width
+      for (unsigned i = 0; i < AUDIO_ENGINE_GEQ_CHANNELS; i++) {
+        bands[i] = bandsBandPass[i] = scaled(ref[i], scale, fftSize);
+      }
+      for (unsigned i = 0; i < 4; i++) bandsBandPass[i] = scaled(refBandPass[i], scale, fftSize);
+      bandsBandPass[AUDIO_ENGINE_GEQ_CHANNELS-1] = scaled(refBandPassHigh, scale, fftSize);
+    }
+
+    inline const AudioGEQBand *get(bool bandPass) const { return bandPass ? bandsBandPass : bands; }
+
+  private:
+    static AudioGEQBand scaled(const AudioGEQBand &b, float scale, uint16_t fftSize) {
+      const long maxBin = fftSize / 2 - 1;
+      long from = lroundf(b.from * scale);
+      long to   = lroundf(b.to   * scale);
+      if (from < 1) from = 1;
+      if (from > maxBin) from = maxBin;
+      if (to < from) to = from;
+      if (to > maxBin) to = maxBin;
+      return { uint16_t(from), uint16_t(to), b.gain };
+    }
+};
+
+//
+// onset detection and tempo tracking
+//
+// process() is called once per analysis frame with the (linear) GEQ channel values:
+//  - onset envelope: spectral flux of log-compressed channels, minus its moving average, normalized to 0..255
+//  - onsets: local maxima of the envelope above a threshold, at least 100ms apart
+//  - tempo: leaky autocorrelation of the envelope, updated incrementally for lags of 60..180 BPM,
+//    weighted towards 120 BPM to resolve double/half tempo ambiguity
+//  - beat phase: free running oscillator at the detected tempo, pulled towards detected onsets
+//
+class AudioBeatTracker {
+  public:
+    static constexpr unsigned HISTORY = 128;      // frames of onset envelope kept, must be a power of 2
+    static constexpr unsigned MAX_LAG = HISTORY - 1;
+    static constexpr unsigned MAX_CHANNELS = 32;
+    static constexpr uint16_t NOISE_FLOOR = 8;    // channel levels below this are treated as silence (log compression would turn noise into flux)
+
+    uint8_t onset = 0;        // onset strength in the last frame (0 = no onset)
+    bool    beat = false;     // a beat occurred in the last frame
+    uint8_t confidence = 0;   // tempo confidence 0..255
+    float   bpm = 0.0f;       // tempo (0 if unknown)
+
+    // frameRate = analysis frames per second
+    void init(float frameRate, unsigned minBPM = 60, unsigned maxBPM = 180) {
+      *this = AudioBeatTracker();
+      _frameRate = frameRate;
+      _lagMin = clampLag(lroundf(60.0f * frameRate / maxBPM));
+      _lagMax = clampLag(lroundf(60.0f * frameRate / minBPM));
+      if (_lagMax < _lagMin + 2) _lagMax = clampLag(_lagMin + 2);
+      _acfMax = clampLag(2 * _lagMax);
+      for (unsigned l = _lagMin; l <= _lagMax; l++) {
+        const float octaves = log2f(60.0f * frameRate / l / 120.0f);
+        _weight[l] = uint8_t(lroundf(255.0f * expf(-2.0f * octaves * octaves))); // log-gaussian around 120 BPM, sigma = 1/2 octave
+      }
+      _minGap = lroundf(0.1f * frameRate);
+    }
+
+    inline uint8_t phase() const { return _phase >> 24; } // position between beats 0..255 (0 = on the beat)
+
+    void process(const uint16_t *channels, unsigned numChannels) {
+      if (numChannels > MAX_CHANNELS) numChannels = MAX_CHANNELS;
+
+      // spectral flux of log-compressed channels
+      uint32_t flux = 0;
+      for (unsigned i = 0; i < numChannels; i++) {
+        const uint16_t l = log2q5(channels[i] > NOISE_FLOOR ? channels[i] : NOISE_FLOOR);
+        if (l > _prev[i]) flux += l - _prev[i];
+        _prev[i] = l;
+      }
+      // remove moving average (~0.4s), normalize with slowly decaying maximum
+      const int32_t f = flux << 4;                      // Q4
+      _fluxAvg += (f - _fluxAvg) >> 4;
+      const int32_t env = f > _fluxAvg ? f - _fluxAvg : 0;
+      _envMax -= _envMax >> 8;
+      if (env > _envMax) _envMax = env;
+      if (_envMax < 64) _envMax = 64;                   // don't amplify silence
+      const uint8_t e = (env * 255) / _envMax;
+
+      // onset = previous frame is a local maximum above threshold
+      onset = 0;
+      if (_sinceOnset < 255) _sinceOnset++;
+      if (_e1 > _e2 && _e1 >= e && _e1 > 48 && _sinceOnset > _minGap) {
+        onset = _e1;
+        _sinceOnset = 1;
+      }
+      _e2 = _e1;
+      _e1 = e;
+
+      // incremental autocorrelation of the envelope
+      _pos = (_pos + 1) & (HISTORY - 1);
+      _env[_pos] = e;
+      if (_frames < HISTORY) _frames++;
+      for (unsigned l = _lagMin; l <= _acfMax; l++) {
+        _acf[l] += int32_t(e) * _env[(_pos - l) & (HISTORY - 1)] - (_acf[l] >> 7); // time constant 128 frames
+      }
+      // best tempo: a lag is supported by its own and (half of) its double lag, which avoids locking to half tempo on accented beats
+      int32_t best = 0, sum = 0;
+      unsigned bestLag = 0;
+      for (unsigned l = _lagMin; l <= _lagMax; l++) {
+        const int32_t a = (_acf[l] >> 8) + (2*l <= _acfMax ? _acf[2*l] >> 9 : 0);
+        const int32_t score = a * _weight[l];
+        sum += _acf[l] >> 8;
+        if (score > best) { best = score; bestLag = l; }
+      }
+
+      // tempo, with parabolic interpolation of the autocorrelation peak
+      if (bestLag && _frames > _lagMax) {
+        float lag = bestLag;
+        if (bestLag > _lagMin && bestLag < _lagMax) {
+          const float a = _acf[bestLag-1], b = _acf[bestLag], c = _acf[bestLag+1];
+          const float d = a - 2*b + c;
+          if (d < 0) lag += 0.5f * (a - c) / d;
+        }
+        bpm = 60.0f * _frameRate / lag;
+        _phaseInc = uint32_t(4294967296.0f / lag);
+        const int32_t peak = _acf[bestLag] >> 8;
+        const int32_t mean = sum / int32_t(_lagMax - _lagMin + 1);
+        confidence = peak > 0 && peak > mean ? ((peak - mean) * 255) / peak : 0;
+      } else {
+        bpm = 0;
+        confidence = 0;
+      }
+
+      // beat phase: advance oscillator, pull towards onsets (phase error / 4)
+      const uint32_t last = _phase;
+      _phase += _phaseInc;
+      if (onset && confidence > 64) _phase -= int32_t(_phase) / 4;
+      beat = _phaseInc && int32_t(last) < 0 && int32_t(_phase) >= 0; // crossed 0
+    }
+
+  private:
+    float    _frameRate = 0.0f;
+    uint16_t _prev[MAX_CHANNELS] = {};
+    int32_t  _fluxAvg = 0;
+    int32_t  _envMax = 64;
+    uint8_t  _e1 = 0, _e2 = 0;         // envelope of the last two frames
+    uint8_t  _sinceOnset = 0;
+    uint8_t  _minGap = 0;
+    uint8_t  _env[HISTORY] = {};
+    uint8_t  _pos = 0;
+    uint8_t  _frames = 0;
+    uint8_t  _lagMin = 0, _lagMax = 0; // tempo range
+    uint8_t  _acfMax = 0;              // autocorrelation is calculated up to this lag
+    uint8_t  _weight[HISTORY] = {};
+    int32_t  _acf[HISTORY] = {};
+    uint32_t _phase = 0;               // 0..2^32 = one beat
+    uint32_t _phaseInc = 0;
+
+    static uint8_t clampLag(long l) { return l < 2 ? 2 : (l > long(MAX_LAG) ? MAX_LAG : l); }
+
+    // 32 * log2(x + 1), linear interpolation between powers of 2
+    static uint16_t log2q5(uint32_t x) {
+      x++;
+      const unsigned e = 31 - __builtin_clz(x);
+      const uint32_t frac = e >= 5 ? (x >> (e - 5)) & 31 : (x << (5 - e)) & 31;
+      return e * 32 + frac;
+    }
+};
+
+//
+// analysis statistics
+//
+class AudioAnalysisStats {
+  public:
+    enum Stage : uint8_t { SAMPLING = 0, FILTER, FFT, GEQ, POST, BEAT, NUM_STAGES };
+
+    uint32_t frames;                  // frames analysed since start
+    uint16_t fps;                     // frames analysed during the last second
+    uint32_t stageTime[NUM_STAGES];   // smoothed processing time per stage in microseconds
+
+    AudioAnalysisStats() { reset(); }
+    void reset() {
+      frames = 0;
+      fps = 0;
+      memset(stageTime, 0, sizeof(stageTime));
+      _periodStart = 0;
+      _framesInPeriod = 0;
+    }
+
+    inline void addTime(Stage stage, uint32_t us) { stageTime[stage] = (us*3 + stageTime[stage]*7) / 10; } // smooth
+    uint32_t processingTime() const { return stageTime[FILTER] + stageTime[FFT] + stageTime[GEQ] + stageTime[POST] + stageTime[BEAT]; }
+
+    // call once per analysed frame, now = time in milliseconds
+    void frameDone(uint32_t now) {
+      frames++;
+      _framesInPeriod++;
+      if (now - _periodStart >= 1000) {
+        fps = _framesInPeriod * 1000 / (now - _periodStart);
+        _framesInPeriod = 0;
+        _periodStart = now;
+      }
+    }
+
+  private:
+    uint32_t _periodStart;
+    uint16_t _framesInPeriod;
+};
@@ -1,5 +1,7 @@
 
 #include "wled.h"
+#include "audio_frames.h"
+#include "audio_sync.h"
 
 #ifdef ARDUINO_ARCH_ESP32
 
@@ -74,7 +76,7 @@
 #define MAX_PALETTES 3
 
 static volatile bool disableSoundProcessing = false;      // if true, sound processing (FFT, filters, AGC) will be suspended. "volatile" as its shared between tasks.
-static uint8_t audioSyncEnabled = 0;          // bit field: bit 0 - send, bit 1 - receive (config value)
+static uint8_t audioSyncEnabled = 0;          // bit field: bit 0 - send, bit 1 - receive, bit 2 - send "V3" format (config value)
 static bool udpSyncConnected = false;         // UDP connection status -> true if connected to multicast group
 
 #define NUM_GEQ_CHANNELS 16                                           // number of frequency channels. Don't change !!
@@ -97,6 +99,14 @@ static bool samplePeak = false;      // Boolean flag for peak - used in effects.
 static bool udpSamplePeak = false;   // Boolean flag for peak. Set at the same time as samplePeak, but reset by transmitAudioData
 static unsigned long timeOfPeak = 0; // time of last sample peak detection.
 static uint8_t fftResult[NUM_GEQ_CHANNELS]= {0};// Our calculated freq. channel result table to be used by effects
+static AudioFrames audioFrames;                 // history of consistent audio feature frames for effects (see audio_frames.h)
+static float   beatBPM = 0.0f;                  // tempo in BPM, 0 = unknown (onset detection & tempo tracking only with local analysis)
+static uint8_t beatPhase = 0;                   // position between two beats 0..255, 0 = on the beat
+static uint8_t beatConfidence = 0;              // confidence of tempo 0..255
+static uint8_t beatOnset = 0;                   // onset strength of last analysis cycle, 0 = no onset
+#ifdef ARDUINO_ARCH_ESP32
+static int16_t lastVolumeRaw = 0;               // volumeRaw of the last usermod loop, published with audio frames by the FFT task
+#endif
 
 // TODO: probably best not used by receive nodes
 //static float agcSensitivity = 128;            // AGC sensitivity estimation, based on agc gain (multAgc). calculated by getSensitivity(). range 0..255
@@ -113,12 +123,18 @@ static uint16_t decayTime = 1400;             // int: decay time in milliseconds
 // peak detection
 #ifdef ARDUINO_ARCH_ESP32
 static void detectSamplePeak(void);  // peak detection function (needs scaled FFT results in vReal[]) - no used for 8266 receive-only mode
+static void publishFFTFrame(void);   // publish results of an FFT cycle to audioFrames - FFT task only
 #endif
 static void autoResetPeak(void);     // peak auto-reset function
 static uint8_t maxVol = 31;          // (was 10) Reasonable value for constant volume for 'peak detector', as it won't always trigger  (deprecated)
 static uint8_t binNum = 8;           // Used to select the bin for FFT based beat detection  (deprecated)
 
 #ifdef ARDUINO_ARCH_ESP32
+#include "audio_engine.h" // platform independent parts of the analysis (fixed-point FFT, GEQ mapping, statistics)
+
+#if defined(UM_AUDIOREACTIVE_USE_FIXED_FFT)
+#define UM_AUDIOREACTIVE_USE_INTEGER_FFT // platform independent fixed-point FFT from audio_engine.h, works on int16 samples
+#else
 #if !defined(UM_AUDIOREACTIVE_USE_ESPDSP_FFT) && (defined(CONFIG_IDF_TARGET_ESP32S3) || defined(CONFIG_IDF_TARGET_ESP32))
 #define UM_AUDIOREACTIVE_USE_ARDUINO_FFT // use ArduinoFFT library for FFT instead of ESP-IDF DSP library by default on ESP32 and S3
 #endif
@@ -141,6 +157,7 @@ static uint8_t binNum = 8;           // Used to select the bin for FFT based bea
 #define UM_AUDIOREACTIVE_USE_INTEGER_FFT // always use integer FFT on ESP32-S2 and ESP32-C3
 #endif
 #endif
+#endif // UM_AUDIOREACTIVE_USE_FIXED_FFT
 
 #if !defined(UM_AUDIOREACTIVE_USE_INTEGER_FFT)
 using FFTsampleType = float;
@@ -218,9 +235,11 @@ static TaskHandle_t FFT_Task = nullptr;
 static float fftResultPink[NUM_GEQ_CHANNELS] = { 1.70f, 1.71f, 1.73f, 1.78f, 1.68f, 1.56f, 1.55f, 1.63f, 1.79f, 1.62f, 1.80f, 2.06f, 2.47f, 3.35f, 6.83f, 9.55f };
 
 // globals and FFT Output variables shared with animations
-#if defined(WLED_DEBUG) || defined(SR_DEBUG)
-static uint64_t fftTime = 0;
-static uint64_t sampleTime = 0;
+static AudioAnalysisStats audioStats;         // analysis rate and time per processing stage
+static AudioGEQMap geqMap;                    // FFT bins of each GEQ channel, for the actual FFT size
+static AudioBeatTracker beatTracker;          // onset detection and tempo tracking
+#ifdef UM_AUDIOREACTIVE_USE_FIXED_FFT
+static AudioFixedFFT fixedFFT;
 #endif
 
 // FFT Task variables (filtering and post-processing)
@@ -235,14 +254,20 @@ constexpr SRate_t SAMPLE_RATE = 22050;        // Base sample rate in Hz - 22Khz
 //constexpr SRate_t SAMPLE_RATE = 16000;        // 16kHz - use if FFTtask takes more than 20ms. Physical sample time -> 32ms
 //constexpr SRate_t SAMPLE_RATE = 20480;        // Base sample rate in Hz - 20Khz is experimental.    Physical sample time -> 25ms
 //constexpr SRate_t SAMPLE_RATE = 10240;        // Base sample rate in Hz - previous default.         Physical sample time -> 50ms
-#define FFT_MIN_CYCLE 21                      // minimum time before FFT task is repeated. Use with 22Khz sampling
-//#define FFT_MIN_CYCLE 30                      // Use with 16Khz sampling
-//#define FFT_MIN_CYCLE 23                      // minimum time before FFT task is repeated. Use with 20Khz sampling
-//#define FFT_MIN_CYCLE 46                      // minimum time before FFT task is repeated. Use with 10Khz sampling
 
 // FFT Constants
-constexpr uint16_t samplesFFT = 512;            // Samples in an FFT batch - This value MUST ALWAYS be a power of 2
-constexpr uint16_t samplesFFT_2 = 256;          // meaningfull part of FFT results - only the "lower half" contains useful information.
+#ifndef SR_FFT_SIZE
+  #define SR_FFT_SIZE 512                       // Samples in an FFT batch: 256, 512 or 1024
+#endif
+#ifndef SR_FFT_OVERLAP
+  #define SR_FFT_OVERLAP 0                      // 1 = 50% overlap of consecutive FFT batches, doubles the update rate (and CPU load)
+#endif
+constexpr uint16_t samplesFFT = SR_FFT_SIZE;    // Samples in an FFT batch - This value MUST ALWAYS be a power of 2
+constexpr uint16_t samplesFFT_2 = samplesFFT/2; // meaningfull part of FFT results - only the "lower half" contains useful information.
+constexpr uint16_t samplesHop = SR_FFT_OVERLAP ? samplesFFT_2 : samplesFFT; // new samples per FFT batch
+static_assert(samplesFFT == 256 || samplesFFT == 512 || samplesFFT == 1024, "SR_FFT_SIZE must be 256, 512 or 1024");
+
+#define FFT_MIN_CYCLE ((samplesHop * 1000) / SAMPLE_RATE - 2) // minimum time before FFT task is repeated (21ms with 512 samples @ 22Khz)
 // the following are observed values, supported by a bit of "educated guessing"
 //#define FFT_DOWNSCALE 0.65f                             // 20kHz - downscaling factor for FFT results - "Flat-Top" window @20Khz, old freq channels 
 #ifdef FFT_PREFER_EXACT_PEAKS
@@ -269,9 +294,9 @@ static float fftAddAvg(int from, int to) {
     result += valFFT[i];
   }
  #if !defined(UM_AUDIOREACTIVE_USE_INTEGER_FFT)
-  result = result * 0.0625; // divide by 16 to reduce magnitude. Want end result to be scaled linear and ~4096 max.
+  result = result * (32.0f / samplesFFT); // divide by 16 (with 512 samples) to reduce magnitude. Want end result to be scaled linear and ~4096 max.
  #else
-  result *= 32; // scale result to match float values. note: raw scaling value between float and int is 512, float version is scaled down by 16
+  result *= 32; // scale result to match float values. note: raw scaling value between float and int is samplesFFT, float version is scaled down by samplesFFT/32
 #endif
   return float(result) / float(to - from + 1); // return average as float
 }
@@ -294,6 +319,15 @@ void FFTcode(void * parameter)
   }
   // Create FFT object with weighing factor storage
   ArduinoFFT<float> FFT = ArduinoFFT<float>(valFFT, vImag, samplesFFT, SAMPLE_RATE, true);
+#elif defined(UM_AUDIOREACTIVE_USE_FIXED_FFT)
+  // allocate FFT buffer on first call - fixed-point FFT works in place, no extra space for imaginary parts needed
+  if (valFFT == nullptr) valFFT = (int16_t*) calloc(sizeof(int16_t), samplesFFT);
+  if ((valFFT == nullptr)) return; // something went wrong
+#ifdef FFT_PREFER_EXACT_PEAKS
+  if (!fixedFFT.init(samplesFFT, AudioFixedFFT::BLACKMAN_HARRIS)) return; // window and twiddle tables
+#else
+  if (!fixedFFT.init(samplesFFT, AudioFixedFFT::FLAT_TOP)) return;
+#endif
 #elif !defined(UM_AUDIOREACTIVE_USE_INTEGER_FFT)
   // allocate and initialize FFT buffers on first call
   // note: free() is never used on these pointers. If it ever is implemented, this implementation can cause memory leaks (need to free raw pointers)
@@ -337,6 +371,14 @@ void FFTcode(void * parameter)
   }
   free(windowFloat); // free temporary buffer
 #endif
+#if SR_FFT_OVERLAP
+  // second half of previous batch, re-used for 50% overlap
+  static FFTsampleType *sampleHistory = nullptr;
+  if (sampleHistory == nullptr) sampleHistory = (FFTsampleType*) calloc(sizeof(FFTsampleType), samplesFFT_2);
+  if ((sampleHistory == nullptr)) return; // something went wrong
+#endif
+  geqMap.build(samplesFFT, SAMPLE_RATE);
+  beatTracker.init(float(SAMPLE_RATE) / samplesHop); // one onset envelope value per FFT batch
 
   // see https://www.freertos.org/vtaskdelayuntil.html
   const TickType_t xFrequency = FFT_MIN_CYCLE * portTICK_PERIOD_MS;  
@@ -352,27 +394,28 @@ void FFTcode(void * parameter)
       continue;
     }
 
-#if defined(WLED_DEBUG) || defined(SR_DEBUG)
-    uint64_t start = esp_timer_get_time();
-    bool haveDoneFFT = false; // indicates if second measurement (FFT time) is valid
-#endif
-
-    // get a fresh batch of samples from I2S
-    if (audioSource) audioSource->getSamples(valFFT, samplesFFT); // note: valFFT is used as a int16_t buffer on C3 and S2, could optimize RAM use by only allocating half the size (but makes code harder to read)
+    // measure time spent in each processing stage
+    uint64_t stageStart = esp_timer_get_time();
+    auto endStage = [&stageStart](AudioAnalysisStats::Stage stage) {
+      uint64_t now = esp_timer_get_time();
+      if (now > stageStart) audioStats.addTime(stage, now - stageStart); // filter out overflows
+      stageStart = now;
+    };
 
-#if defined(WLED_DEBUG) || defined(SR_DEBUG)
-    if (start < esp_timer_get_time()) { // filter out overflows
-      uint64_t sampleTimeInMillis = (esp_timer_get_time() - start +5ULL) / 10ULL; // "+5" to ensure proper rounding
-      sampleTime = (sampleTimeInMillis*3 + sampleTime*7)/10; // smooth
-    }
-    start = esp_timer_get_time(); // start measuring FFT time
-#endif
+    // get a fresh batch of samples from I2S (with overlap, only the second half of the batch is new)
+    FFTsampleType *newSamples = valFFT + (samplesFFT - samplesHop);
+    if (audioSource) audioSource->getSamples(newSamples, samplesHop); // note: valFFT is used as a int16_t buffer on C3 and S2, could optimize RAM use by only allocating half the size (but makes code harder to read)
+    endStage(AudioAnalysisStats::SAMPLING);
 
     xLastWakeTime = xTaskGetTickCount();       // update "last unblocked time" for vTaskDelay
 
     // band pass filter - can reduce noise floor by a factor of 50 and avoid aliasing effects to base & high frequency bands
     // downside: frequencies below 100Hz will be ignored
-    if (useMicFilter) runMicFilter(samplesFFT, valFFT);
+    if (useMicFilter) runMicFilter(samplesHop, newSamples);
+#if SR_FFT_OVERLAP
+    memcpy(valFFT, sampleHistory, samplesFFT_2 * sizeof(FFTsampleType));     // first half = second half of previous batch
+    memcpy(sampleHistory, newSamples, samplesFFT_2 * sizeof(FFTsampleType)); // keep for next batch
+#endif
     // find highest sample in the batch
     FFTsampleType maxSample = 0;                         // max sample from FFT batch
     for (int i=0; i < samplesFFT; i++) {
@@ -383,6 +426,7 @@ void FFTcode(void * parameter)
     // release highest sample to volume reactive effects early - not strictly necessary here - could also be done at the end of the function
     // early release allows the filters (getSample() and agcAvg()) to work with fresh values - we will have matching gain and noise gate values when we want to process the FFT results.
     micDataReal = maxSample;
+    endStage(AudioAnalysisStats::FILTER);
 
 #ifdef SR_DEBUG
     if (true) {  // this allows measure FFT runtimes, as it disables the "only when needed" optimization 
@@ -390,7 +434,22 @@ void FFTcode(void * parameter)
     if (sampleAvg > 0.25f) { // noise gate open means that FFT results will be used. Don't run FFT if results are not needed.
 #endif
 
-#ifdef UM_AUDIOREACTIVE_USE_ARDUINO_FFT
+#if defined(UM_AUDIOREACTIVE_USE_FIXED_FFT)
+      // run platform independent fixed-point FFT (removes DC offset and applies window), leaves magnitudes of samplesFFT_2 bins in valFFT
+      fixedFFT.compute(valFFT);
+      valFFT[0] = 0; // set DC bin to 0, as it is not needed and can cause issues
+      int FFT_MajorPeak_int = 0;
+      int FFT_Magnitude_int = 0;
+      for (int i = 1; i < samplesFFT_2; i++) { // skip [0], it is DC offset
+        if (valFFT[i] > FFT_Magnitude_int) {
+          FFT_Magnitude_int = valFFT[i];
+          FFT_MajorPeak_int = ((i * SAMPLE_RATE)/samplesFFT);
+        }
+        // note: scaling is done in fftAddAvg(), so we don't scale here
+      }
+      FFT_MajorPeak = FFT_MajorPeak_int;
+      FFT_Magnitude = FFT_Magnitude_int;
+#elif defined(UM_AUDIOREACTIVE_USE_ARDUINO_FFT)
       // run Arduino FFT (takes 3-5ms on ESP32, ~12ms on ESP32-S2, ~20ms on ESP32-C3)
       memset(vImag, 0, samplesFFT * sizeof(float));               // set imaginary parts to 0
       FFT.dcRemoval();                                            // remove DC offset
@@ -472,13 +531,12 @@ void FFTcode(void * parameter)
 #endif
 #endif
       FFT_MajorPeak = constrain(FFT_MajorPeak, 1.0f, 11025.0f);   // restrict value to range expected by effects
-#if defined(WLED_DEBUG) || defined(SR_DEBUG)
-      haveDoneFFT = true;
-#endif
+      endStage(AudioAnalysisStats::FFT);
     } else { // noise gate closed - only clear results as FFT was skipped. MIC samples are still valid when we do this -> set all samples to 0
       memset(valFFT, 0, samplesFFT * sizeof(FFTsampleType));
       FFT_MajorPeak = 1;
       FFT_Magnitude = 0.001;
+      stageStart = esp_timer_get_time(); // FFT was skipped, don't count this as FFT time
     }
 
     // mapping of FFT result bins to frequency channels
@@ -510,35 +568,14 @@ void FFTcode(void * parameter)
       fftCalc[14] = fftAddAvg(147,194);   // 2940 - 3900
       fftCalc[15] = fftAddAvg(194,250);   // 3880 - 5000 // avoid the last 5 bins, which are usually inaccurate
 #else
-      /* new mapping, optimized for 22050 Hz by softhack007 */
-      // bins frequency  range
-      if (useBandPassFilter) {
-        // skip frequencies below 100hz
-        fftCalc[ 0] = 0.8f * fftAddAvg(3,4);
-        fftCalc[ 1] = 0.9f * fftAddAvg(4,5);
-        fftCalc[ 2] = fftAddAvg(5,6);
-        fftCalc[ 3] = fftAddAvg(6,7);
-        // don't use the last bins from 206 to 255. 
-        fftCalc[15] = fftAddAvg(165,205) * 0.75f;   // 40 7106 - 8828 high             -- with some damping
-      } else {
-        fftCalc[ 0] = fftAddAvg(1,2);               // 1    43 - 86   sub-bass
-        fftCalc[ 1] = fftAddAvg(2,3);               // 1    86 - 129  bass
-        fftCalc[ 2] = fftAddAvg(3,5);               // 2   129 - 216  bass
-        fftCalc[ 3] = fftAddAvg(5,7);               // 2   216 - 301  bass + midrange
-        // don't use the last bins from 216 to 255. They are usually contaminated by aliasing (aka noise) 
-        fftCalc[15] = fftAddAvg(165,215) * 0.70f;   // 50 7106 - 9259 high             -- with some damping
-      }
-      fftCalc[ 4] = fftAddAvg(7,10);                // 3   301 - 430  midrange
-      fftCalc[ 5] = fftAddAvg(10,13);               // 3   430 - 560  midrange
-      fftCalc[ 6] = fftAddAvg(13,19);               // 5   560 - 818  midrange
-      fftCalc[ 7] = fftAddAvg(19,26);               // 7   818 - 1120 midrange -- 1Khz should always be the center !
-      fftCalc[ 8] = fftAddAvg(26,33);               // 7  1120 - 1421 midrange
-      fftCalc[ 9] = fftAddAvg(33,44);               // 9  1421 - 1895 midrange
-      fftCalc[10] = fftAddAvg(44,56);               // 12 1895 - 2412 midrange + high mid
-      fftCalc[11] = fftAddAvg(56,70);               // 14 2412 - 3015 high mid
-      fftCalc[12] = fftAddAvg(70,86);               // 16 3015 - 3704 high mid
-      fftCalc[13] = fftAddAvg(86,104);              // 18 3704 - 4479 high mid
-      fftCalc[14] = fftAddAvg(104,165) * 0.88f;     // 61 4479 - 7106 high mid + high  -- with slight damping
+      /* new mapping, optimized for 22050 Hz by softhack007 - scaled to the actual FFT size, see AudioGEQMap */
+      // bins (512 samples) frequency  range
+      //   1 -   2    43 -   86  sub-bass            7 -  10   301 -  430  midrange          44 -  56  1895 - 2412  midrange + high mid
+      //   2 -   3    86 -  129  bass               10 -  13   430 -  560  midrange          56 - 104  2412 - 4479  high mid
+      //   3 -   5   129 -  216  bass               13 -  26   560 - 1120  midrange         104 - 165  4479 - 7106  high mid + high
+      //   5 -   7   216 -  301  bass + midrange    26 -  44  1120 - 1895  midrange         165 - 215  7106 - 9259  high (bins above are contaminated by aliasing)
+      const AudioGEQBand *bands = geqMap.get(useBandPassFilter); // band pass: skip frequencies below 100hz and above 8.8kHz
+      for (int i = 0; i < NUM_GEQ_CHANNELS; i++) fftCalc[i] = fftAddAvg(bands[i].from, bands[i].to) * bands[i].gain;
 #endif
     } else {  // noise gate closed - just decay old values
       for (int i=0; i < NUM_GEQ_CHANNELS; i++) {
@@ -547,18 +584,27 @@ void FFTcode(void * parameter)
       }
     }
 
+    endStage(AudioAnalysisStats::GEQ);
+
     // post-processing of frequency channels (pink noise adjustment, AGC, smoothing, scaling)
     postProcessFFTResults((fabsf(sampleAvg) > 0.25f)? true : false , NUM_GEQ_CHANNELS);
 
-#if defined(WLED_DEBUG) || defined(SR_DEBUG)
-    if (haveDoneFFT && (start < esp_timer_get_time())) { // filter out overflows
-      uint64_t fftTimeInMillis = ((esp_timer_get_time() - start) +5ULL) / 10ULL; // "+5" to ensure proper rounding
-      fftTime  = (fftTimeInMillis*3 + fftTime*7)/10; // smooth
-    }
-#endif
     // run peak detection
     autoResetPeak();
     detectSamplePeak();
+    endStage(AudioAnalysisStats::POST);
+
+    // onset detection and tempo tracking, on GEQ channels after gain but before smoothing and scaling
+    uint16_t beatChannels[NUM_GEQ_CHANNELS];
+    for (int i = 0; i < NUM_GEQ_CHANNELS; i++) beatChannels[i] = fftCalc[i];  // 0 ... 1023
+    beatTracker.process(beatChannels, NUM_GEQ_CHANNELS);
+    beatBPM        = beatTracker.bpm;
+    beatPhase      = beatTracker.phase();
+    beatConfidence = beatTracker.confidence;
+    beatOnset      = beatTracker.onset;
+    endStage(AudioAnalysisStats::BEAT);
+    publishFFTFrame();
+    audioStats.frameDone(millis());
     
     #if !defined(I2S_GRAB_ADC1_COMPLETELY)    
     if ((audioSource == nullptr) || (audioSource->getType() != AudioSource::Type_I2SAdc))  // the "delay trick" does not help for analog ADC
@@ -737,6 +783,21 @@ static void detectSamplePeak(void) {
   }
 }
 
+// the FFT task is the producer of audioFrames while sound processing is running (the usermod loop publishes
+// received UDP sync data only while the FFT task is suspended, see AudioReactive::publishAudioFrame())
+static void publishFFTFrame(void) {
+  AudioFrame frame;
+  memcpy(frame.fftResult, fftResult, sizeof(frame.fftResult));
+  frame.timestamp  = millis();
+  frame.volumeSmth = (soundAgc) ? sampleAgc : sampleAvg;      // filters & AGC run in the usermod loop, use their latest values
+  frame.volumeRaw  = lastVolumeRaw;
+  frame.majorPeak  = FFT_MajorPeak;
+  frame.magnitude  = (frame.volumeSmth < 1) ? 0.001f : FFT_Magnitude * ((soundAgc) ? multAgc : 1.0f); // same as my_magnitude
+  frame.samplePeak = samplePeak;
+  frame.onset      = beatOnset;
+  audioFrames.push(frame);
+}
+
 #endif
 
 static void autoResetPeak(void) {
@@ -818,7 +879,10 @@ class AudioReactive : public Usermod {
       double FFT_MajorPeak;   //  08 Bytes
     };
 
-    #define UDPSOUND_MAX_PACKET 88 // max packet size for audiosync
+    #define UDPSOUND_MAX_PACKET AUDIOSYNC_V3_MAX_PACKET // max packet size for audiosync (V1: 88 bytes, V3: up to 182 bytes, see audio_sync.h)
+    #ifndef AUDIOSYNC_V3_BUNDLE
+    #define AUDIOSYNC_V3_BUNDLE 3  // frames per V3 packet: newest frame + repeated previous frames, to cover lost packets
+    #endif
 
     // set your config variables to their boot default value (this can also be done in readFromConfig() or a constructor if you prefer)
     #ifdef UM_AUDIOREACTIVE_ENABLE
@@ -839,6 +903,14 @@ class AudioReactive : public Usermod {
 
     bool updateIsRunning = false; // true during OTA.
 
+    AudioSyncJitterBuffer syncJitter;  // V3 receive: frames waiting for playout
+#ifdef ARDUINO_ARCH_ESP32
+    AudioSyncFrame syncTxFrames[AUDIOSYNC_V3_BUNDLE]; // V3 send: last frames sent, newest first
+    uint8_t  syncTxCount = 0;
+    uint16_t syncTxSeq = 0;
+    uint32_t syncTxAudioFrame = 0;     // audioFrames.count() at last V3 transmission
+#endif
+
 #ifdef ARDUINO_ARCH_ESP32
     // used for AGC
     int      last_soundAgc = -1;   // used to detect AGC mode change (for resetting AGC internal error buffers)
@@ -862,7 +934,7 @@ class AudioReactive : public Usermod {
 
     // used to feed "Info" Page
     unsigned long last_UDPTime = 0;    // time of last valid UDP sound sync datapacket
-    int receivedFormat = 0;            // last received UDP sound sync format - 0=none, 1=v1 (0.13.x), 2=v2 (0.14.x)
+    int receivedFormat = 0;            // last received UDP sound sync format - 0=none, 1=v1 (0.13.x), 2=v2 (0.14.x), 3=v3
     float maxSample5sec = 0.0f;        // max sample (after AGC) in last 5 seconds 
     unsigned long sampleMaxTimer = 0;  // last time maxSample5sec was reset
     #define CYCLE_SAMPLEMAX 3500       // time window for merasuring
@@ -1220,6 +1292,33 @@ class AudioReactive : public Usermod {
       return;
     } // transmitAudioData()
 
+    // "V3" format: quantised values with sequence number and timestamp, previous frames are repeated in each packet
+    void transmitAudioData_v3()
+    {
+      if (!udpSyncConnected) return;
+
+      memmove(&syncTxFrames[1], &syncTxFrames[0], (AUDIOSYNC_V3_BUNDLE-1) * sizeof(AudioSyncFrame));
+      AudioSyncFrame &frame = syncTxFrames[0];
+      frame.seq        = syncTxSeq++;
+      frame.timestamp  = millis();
+      // transmit samples that were not modified by limitSampleDynamics()
+      frame.sampleRaw  = (soundAgc) ? rawSampleAgc: sampleRaw;
+      frame.sampleSmth = (soundAgc) ? sampleAgc   : sampleAvg;
+      frame.samplePeak = udpSamplePeak ? 1:0;
+      udpSamplePeak    = false;           // Reset udpSamplePeak after we've transmitted it
+      for (int i = 0; i < NUM_GEQ_CHANNELS; i++) frame.fftResult[i] = (uint8_t)constrain(fftResult[i], 0, 254);
+      frame.magnitude  = my_magnitude;
+      frame.majorPeak  = FFT_MajorPeak;
+      if (syncTxCount < AUDIOSYNC_V3_BUNDLE) syncTxCount++;
+
+      uint8_t buffer[AUDIOSYNC_V3_MAX_PACKET];
+      size_t packetSize = AudioSyncV3::encode(buffer, sizeof(buffer), syncTxFrames, syncTxCount);
+      if (packetSize && fftUdp.beginMulticastPacket() != 0) { // beginMulticastPacket returns 0 in case of error
+        fftUdp.write(buffer, packetSize);
+        fftUdp.endPacket();
+      }
+    } // transmitAudioData_v3()
+
 #endif
 
     static bool isValidUdpSyncVersion(const char *header) {
@@ -1234,9 +1333,21 @@ class AudioReactive : public Usermod {
       memset(&receivedPacket, 0, sizeof(receivedPacket));                                  // start clean
       memcpy(&receivedPacket, fftBuff, min((unsigned)packetSize, (unsigned)sizeof(receivedPacket))); // don't violate alignment - thanks @willmmiles#
 
+      AudioSyncFrame frame;
+      frame.sampleRaw  = receivedPacket.sampleRaw;
+      frame.sampleSmth = receivedPacket.sampleSmth;
+      frame.samplePeak = receivedPacket.samplePeak;
+      frame.magnitude  = receivedPacket.FFT_Magnitude;
+      frame.majorPeak  = receivedPacket.FFT_MajorPeak;
+      memcpy(frame.fftResult, receivedPacket.fftResult, sizeof(frame.fftResult));
+      applyAudioFrame(frame);
+    }
+
+    // update samples from a received (V2) or played out (V3) frame
+    void applyAudioFrame(const AudioSyncFrame &frame) {
       // update samples for effects
-      volumeSmth   = fmaxf(receivedPacket.sampleSmth, 0.0f);
-      volumeRaw    = fmaxf(receivedPacket.sampleRaw, 0.0f);
+      volumeSmth   = fmaxf(frame.sampleSmth, 0.0f);
+      volumeRaw    = fmaxf(frame.sampleRaw, 0.0f);
 #ifdef ARDUINO_ARCH_ESP32
       // update internal samples
       sampleRaw    = volumeRaw;
@@ -1249,15 +1360,21 @@ class AudioReactive : public Usermod {
       // If it's true already, then the animation still needs to respond.
       autoResetPeak();
       if (!samplePeak) {
-            samplePeak = receivedPacket.samplePeak >0 ? true:false;
+            samplePeak = frame.samplePeak >0 ? true:false;
             if (samplePeak) timeOfPeak = millis();
             //userVar1 = samplePeak;
       }
       //These values are only computed by ESP32
-      for (int i = 0; i < NUM_GEQ_CHANNELS; i++) fftResult[i] = receivedPacket.fftResult[i];
-      my_magnitude  = fmaxf(receivedPacket.FFT_Magnitude, 0.0f);
+      for (int i = 0; i < NUM_GEQ_CHANNELS; i++) fftResult[i] = frame.fftResult[i];
+      my_magnitude  = fmaxf(frame.magnitude, 0.0f);
       FFT_Magnitude = my_magnitude;
-      FFT_MajorPeak = constrain(receivedPacket.FFT_MajorPeak, 1.0f, 11025.0f);  // restrict value to range expected by effects
+      FFT_MajorPeak = constrain(frame.majorPeak, 1.0f, 11025.0f);  // restrict value to range expected by effects
+    }
+
+    void decodeAudioData_v3(int packetSize, uint8_t *fftBuff) {
+      AudioSyncFrame frames[AUDIOSYNC_V3_MAX_FRAMES];
+      unsigned count = AudioSyncV3::decode(fftBuff, packetSize, frames, AUDIOSYNC_V3_MAX_FRAMES);
+      for (unsigned i = 0; i < count; i++) syncJitter.push(frames[i], millis());
     }
 
     void decodeAudioData_v1(int packetSize, uint8_t *fftBuff) {
@@ -1293,28 +1410,44 @@ class AudioReactive : public Usermod {
       if (!udpSyncConnected) return false;
       bool haveFreshData = false;
 
-      size_t packetSize = fftUdp.parsePacket();
+      for (unsigned packets = 0; packets < AUDIOSYNC_V3_MAX_FRAMES; packets++) { // V3 senders transmit at analysis rate: read all packets that arrived since last run
+        size_t packetSize = fftUdp.parsePacket();
+        if (packetSize == 0) break;
 #ifdef ARDUINO_ARCH_ESP32
-      if ((packetSize > 0) && ((packetSize < 5) || (packetSize > UDPSOUND_MAX_PACKET))) fftUdp.flush(); // discard invalid packets (too small or too big) - only works on esp32
+        if ((packetSize < 5) || (packetSize > UDPSOUND_MAX_PACKET)) fftUdp.flush(); // discard invalid packets (too small or too big) - only works on esp32
 #endif
-      if ((packetSize > 5) && (packetSize <= UDPSOUND_MAX_PACKET)) {
-        //DEBUGSR_PRINTLN("Received UDP Sync Packet");
-        uint8_t fftBuff[UDPSOUND_MAX_PACKET+1] = { 0 }; // fixed-size buffer for receiving (stack), to avoid heap fragmentation caused by variable sized arrays
-        fftUdp.read(fftBuff, packetSize);
+        if ((packetSize > 5) && (packetSize <= UDPSOUND_MAX_PACKET)) {
+          //DEBUGSR_PRINTLN("Received UDP Sync Packet");
+          uint8_t fftBuff[UDPSOUND_MAX_PACKET+1] = { 0 }; // fixed-size buffer for receiving (stack), to avoid heap fragmentation caused by variable sized arrays
+          fftUdp.read(fftBuff, packetSize);
+
+          // VERIFY THAT THIS IS A COMPATIBLE PACKET
+          if (AudioSyncV3::isValid(fftBuff, packetSize)) {
+            if (receivedFormat != 3) syncJitter.reset(); // (re)start playout
+            decodeAudioData_v3(packetSize, fftBuff);     // frames are played out below
+            receivedFormat = 3;
+          } else if (packetSize == sizeof(audioSyncPacket) && (isValidUdpSyncVersion((const char *)fftBuff))) {
+            decodeAudioData(packetSize, fftBuff);
+            //DEBUGSR_PRINTLN("Finished parsing UDP Sync Packet v2");
+            haveFreshData = true;
+            receivedFormat = 2;
+          } else {
+            if (packetSize == sizeof(audioSyncPacket_v1) && (isValidUdpSyncVersion_v1((const char *)fftBuff))) {
+              decodeAudioData_v1(packetSize, fftBuff);
+              //DEBUGSR_PRINTLN("Finished parsing UDP Sync Packet v1");
+              haveFreshData = true;
+              receivedFormat = 1;
+            } else receivedFormat = 0; // unknown format
+          }
+        }
+      }
 
-        // VERIFY THAT THIS IS A COMPATIBLE PACKET
-        if (packetSize == sizeof(audioSyncPacket) && (isValidUdpSyncVersion((const char *)fftBuff))) {
-          decodeAudioData(packetSize, fftBuff);
-          //DEBUGSR_PRINTLN("Finished parsing UDP Sync Packet v2");
+      // V3: play out buffered frames (interpolated, bridges lost or late packets)
+      if (receivedFormat == 3) {
+        AudioSyncFrame frame;
+        if (syncJitter.get(millis(), frame)) {
+          applyAudioFrame(frame);
           haveFreshData = true;
-          receivedFormat = 2;
-        } else {
-          if (packetSize == sizeof(audioSyncPacket_v1) && (isValidUdpSyncVersion_v1((const char *)fftBuff))) {
-            decodeAudioData_v1(packetSize, fftBuff);
-            //DEBUGSR_PRINTLN("Finished parsing UDP Sync Packet v1");
-            haveFreshData = true;
-            receivedFormat = 1;
-          } else receivedFormat = 0; // unknown format
         }
       }
       return haveFreshData;
@@ -1340,7 +1473,7 @@ class AudioReactive : public Usermod {
         // usermod exchangeable data
         // we will assign all usermod exportable data here as pointers to original variables or arrays and allocate memory for pointers
         um_data = new um_data_t;
-        um_data->u_size = 8;
+        um_data->u_size = 12;
         um_data->u_type = new um_types_t[um_data->u_size];
         um_data->u_data = new void*[um_data->u_size];
         um_data->u_data[0] = &volumeSmth;      //*used (New)
@@ -1359,6 +1492,14 @@ class AudioReactive : public Usermod {
         um_data->u_type[6] = UMT_BYTE;
         um_data->u_data[7] = &binNum;          // assigned in effect function from UI element!!! (Puddlepeak, Ripplepeak, Waterfall)
         um_data->u_type[7] = UMT_BYTE;
+        um_data->u_data[8] = &audioFrames;     // consistent snapshots & history of audio features (AudioFrames, see audio_frames.h)
+        um_data->u_type[8] = UMT_PTR;          // pointer to AudioFrames object
+        um_data->u_data[9] = &beatBPM;         // tempo (BPM), 0 = unknown
+        um_data->u_type[9] = UMT_FLOAT;
+        um_data->u_data[10] = &beatPhase;      // position between beats 0..255, 0 = on the beat
+        um_data->u_type[10] = UMT_BYTE;
+        um_data->u_data[11] = &beatConfidence; // tempo confidence 0..255
+        um_data->u_type[11] = UMT_BYTE;
       }
 
 
@@ -1589,6 +1730,7 @@ class AudioReactive : public Usermod {
         if (volumeSmth < 1 ) my_magnitude = 0.001f;  // noise gate closed - mute
 
         limitSampleDynamics();
+        lastVolumeRaw = volumeRaw;
       }  // if (!disableSoundProcessing)
 #endif
 
@@ -1598,6 +1740,7 @@ class AudioReactive : public Usermod {
       connectUDPSoundSync();  // ensure we have a connection - if needed
 
       // UDP Microphone Sync  - receive mode
+      bool haveSyncData = false;
       if ((audioSyncEnabled & 0x02) && udpSyncConnected) {
           // Only run the audio listener code if we're in Receive mode
           static float syncVolumeSmth = 0;
@@ -1613,7 +1756,9 @@ class AudioReactive : public Usermod {
           if (have_new_sample) syncVolumeSmth = volumeSmth;   // remember received sample
           else volumeSmth = syncVolumeSmth;                   // restore originally received sample for next run of dynamics limiter
           limitSampleDynamics();                              // run dynamics limiter on received volumeSmth, to hide jumps and hickups
+          haveSyncData = have_new_sample;
       }
+      publishAudioFrame(haveSyncData);
 
       #if defined(MIC_LOGGER) || defined(MIC_SAMPLING_LOG) || defined(FFT_SAMPLING_LOG)
       static unsigned long lastMicLoggerTime = 0;
@@ -1645,7 +1790,14 @@ class AudioReactive : public Usermod {
 
 #ifdef ARDUINO_ARCH_ESP32
       //UDP Microphone Sync  - transmit mode
-      if ((audioSyncEnabled & 0x01) && (millis() - lastTime > 20)) {
+      if ((audioSyncEnabled & 0x05) == 0x05) {
+        // V3: transmit once per analysis cycle
+        if (audioFrames.count() != syncTxAudioFrame) {
+          syncTxAudioFrame = audioFrames.count();
+          transmitAudioData_v3();
+          lastTime = millis();
+        }
+      } else if ((audioSyncEnabled & 0x01) && (millis() - lastTime > 20)) {
         // Only run the transmit code IF we're in Transmit mode
         transmitAudioData();
         lastTime = millis();
@@ -1656,6 +1808,22 @@ class AudioReactive : public Usermod {
     }
 
 
+    // publish a received UDP sync packet to audioFrames
+    // only called in receive mode: the FFT task is suspended then, so the ring keeps a single producer (see publishFFTFrame())
+    void publishAudioFrame(bool haveSyncData) {
+      if (!haveSyncData) return;
+      AudioFrame frame;
+      memcpy(frame.fftResult, fftResult, sizeof(frame.fftResult));
+      frame.timestamp  = millis();
+      frame.volumeSmth = volumeSmth;
+      frame.volumeRaw  = volumeRaw;
+      frame.majorPeak  = FFT_MajorPeak;
+      frame.magnitude  = my_magnitude;
+      frame.samplePeak = samplePeak;
+      frame.onset      = samplePeak ? 255 : 0; // no onset detection on received data
+      audioFrames.push(frame);
+    }
+
     bool getUMData(um_data_t **data) override
     {
       if (!data || !enabled) return false; // no pointer provided by caller or not enabled -> exit
@@ -1666,9 +1834,7 @@ class AudioReactive : public Usermod {
 #ifdef ARDUINO_ARCH_ESP32
     void onUpdateBegin(bool init) override
     {
-#ifdef WLED_DEBUG
-      fftTime = sampleTime = 0;
-#endif
+      audioStats.reset();
       // gracefully suspend FFT task (if running)
       disableSoundProcessing = true;
 
@@ -1703,7 +1869,7 @@ class AudioReactive : public Usermod {
           xTaskCreateUniversal(               // xTaskCreateUniversal also works on -S2 and -C3 with single core
             FFTcode,                          // Function to implement the task
             "FFT",                            // Name of the task
-            3592,                             // Stack size in words // 3592 leaves 800-1024 bytes of task stack free
+            3592 + (samplesHop > 512 ? samplesHop - 512 : 0), // Stack size in words // 3592 leaves 800-1024 bytes of task stack free (getSamples() needs one word per sample)
             NULL,                             // Task input parameter
             FFTTASK_PRIORITY,                 // Priority of the task
             &FFT_Task                         // Task handle
@@ -1876,7 +2042,7 @@ class AudioReactive : public Usermod {
         if (audioSyncEnabled) {
           if (audioSyncEnabled & 0x01) {
             infoArr.add(F("send mode"));
-            if ((udpSyncConnected) && (millis() - lastTime < 2500)) infoArr.add(F(" v2"));
+            if ((udpSyncConnected) && (millis() - lastTime < 2500)) infoArr.add((audioSyncEnabled & 0x04) ? F(" v3") : F(" v2"));
           } else if (audioSyncEnabled & 0x02) {
               infoArr.add(F("receive mode"));
           }
@@ -1886,25 +2052,45 @@ class AudioReactive : public Usermod {
         if (audioSyncEnabled && udpSyncConnected && (millis() - last_UDPTime < 2500)) {
             if (receivedFormat == 1) infoArr.add(F(" v1"));
             if (receivedFormat == 2) infoArr.add(F(" v2"));
+            if (receivedFormat == 3) {
+              infoArr.add(F(" v3"));
+              if (syncJitter.received) {
+                infoArr.add(F(", lost "));
+                infoArr.add(syncJitter.lost * 100 / (syncJitter.received + syncJitter.lost));
+                infoArr.add(F("%"));
+              }
+            }
         }
 
-        #if defined(WLED_DEBUG) || defined(SR_DEBUG)
         #ifdef ARDUINO_ARCH_ESP32
+        if (!disableSoundProcessing && !(audioSyncEnabled & 0x02)) {
+          infoArr = user.createNestedArray(F("Analysis"));
+          infoArr.add(audioStats.fps);
+          infoArr.add(F(" fps, FFT size "));
+          infoArr.add(samplesFFT);
+          if (SR_FFT_OVERLAP) infoArr.add(F(" (50% overlap)"));
+        }
+
+        #if defined(WLED_DEBUG) || defined(SR_DEBUG)
+        const uint32_t sampleTime = audioStats.stageTime[AudioAnalysisStats::SAMPLING];
+        const uint32_t fftTime = audioStats.processingTime();
         infoArr = user.createNestedArray(F("Sampling time"));
-        infoArr.add(float(sampleTime)/100.0f);
+        infoArr.add(float(sampleTime)/1000.0f);
         infoArr.add(" ms");
 
         infoArr = user.createNestedArray(F("FFT time"));
-        infoArr.add(float(fftTime)/100.0f);
-        if ((fftTime/100) >= FFT_MIN_CYCLE) // FFT time over budget -> I2S buffer will overflow 
+        infoArr.add(float(fftTime)/1000.0f);
+        if ((fftTime/1000) >= FFT_MIN_CYCLE) // FFT time over budget -> I2S buffer will overflow 
           infoArr.add("<b style=\"color:red;\">! ms</b>");
-        else if ((fftTime/80 + sampleTime/80) >= FFT_MIN_CYCLE) // FFT time >75% of budget -> risk of instability
+        else if ((fftTime/800 + sampleTime/800) >= FFT_MIN_CYCLE) // FFT time >75% of budget -> risk of instability
           infoArr.add("<b style=\"color:orange;\"> ms!</b>");
         else
           infoArr.add(" ms");
 
-        DEBUGSR_PRINTF("AR Sampling time: %5.2f ms\n", float(sampleTime)/100.0f);
-        DEBUGSR_PRINTF("AR FFT time     : %5.2f ms\n", float(fftTime)/100.0f);
+        DEBUGSR_PRINTF("AR Sampling time: %5.2f ms\n", float(sampleTime)/1000.0f);
+        DEBUGSR_PRINTF("AR FFT time     : %5.2f ms (filter %u us, FFT %u us, GEQ %u us, post %u us)\n", float(fftTime)/1000.0f,
+                       unsigned(audioStats.stageTime[AudioAnalysisStats::FILTER]), unsigned(audioStats.stageTime[AudioAnalysisStats::FFT]),
+                       unsigned(audioStats.stageTime[AudioAnalysisStats::GEQ]), unsigned(audioStats.stageTime[AudioAnalysisStats::POST]));
         #endif
         #endif
       }
@@ -2148,6 +2334,7 @@ class AudioReactive : public Usermod {
       uiScript.print(F("addOption(dd,'Off',0);"));
 #ifdef ARDUINO_ARCH_ESP32
       uiScript.print(F("addOption(dd,'Send',1);"));
+      uiScript.print(F("addOption(dd,'Send (V3)',5);"));
 #endif
       uiScript.print(F("addOption(dd,'Receive',2);"));
 #ifdef ARDUINO_ARCH_ESP32
@@ -0,0 +1,258 @@
+/* audio_sync.h
+
+"V3" audio sync format and receive-side jitter buffer, platform independent.
+
+A V3 packet carries up to AUDIOSYNC_V3_MAX_FRAMES audio frames, newest first. Senders transmit one packet per
+analysis cycle and repeat the previous frames in every packet, so a lost packet is usually covered by the next one.
+Each frame has a sequence number and a sender timestamp; values are quantised (volume 8.8 fixed point, magnitude
+as bfloat16, peak frequency in Hz), GEQ channels are 16 or 32 bytes (AUDIOSYNC_V3_FLAG_GEQ32).
+
+The receiver puts frames into AudioSyncJitterBuffer, which plays them out with a small, constant delay on the
+sender's time line. Frames are interpolated, and gaps (lost packets) are bridged by interpolating between the
+surrounding frames or by holding the last frame for a short time.
+
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+
+#define AUDIOSYNC_V3_HEADER      "00003"
+#define AUDIOSYNC_V3_MAX_FRAMES  4       // frames per packet
+#define AUDIOSYNC_V3_FLAG_GEQ32  0x01    // frames have 32 GEQ channels instead of 16
+#define AUDIOSYNC_GEQ_CHANNELS   16      // must match NUM_GEQ_CHANNELS of AudioReactive
+
+#ifndef AUDIOSYNC_JITTER_DELAY
+  #define AUDIOSYNC_JITTER_DELAY 40      // playout delay (ms) of the receiver, should cover about 2 analysis cycles
+#endif
+#define AUDIOSYNC_JITTER_SLOTS   8       // frames kept in the jitter buffer
+#define AUDIOSYNC_MAX_HOLD       250     // (ms) hold the last frame this long if no newer frames arrive, then stop
+
+// "V3" packet: header followed by <frames> frames of sizeof(audioSyncFrame_v3) + 16 or 32 GEQ bytes
+struct __attribute__ ((packed)) audioSyncHeader_v3 {
+  char     header[6];     // "00003"
+  uint8_t  flags;         // AUDIOSYNC_V3_FLAG_*
+  uint8_t  frames;        // number of frames, newest first
+  uint16_t seq;           // sequence number of newest frame (older frames: seq-1, seq-2, ...)
+  uint32_t timestamp;     // sender time (ms) of newest frame
+};
+
+struct __attribute__ ((packed)) audioSyncFrame_v3 {
+  uint8_t  age;           // time (ms) between this frame and the newest frame of the packet
+  uint8_t  samplePeak;    // 0 no peak; >=1 peak detected
+  uint16_t sampleRaw;     // 8.8 fixed point
+  uint16_t sampleSmth;    // 8.8 fixed point
+  uint16_t magnitude;     // bfloat16 (upper half of a float)
+  uint16_t majorPeak;     // Hz
+                          // followed by 16 or 32 GEQ channels
+};
+
+#define AUDIOSYNC_V3_MAX_PACKET (sizeof(audioSyncHeader_v3) + AUDIOSYNC_V3_MAX_FRAMES * (sizeof(audioSyncFrame_v3) + 2*AUDIOSYNC_GEQ_CHANNELS))
+
+// decoded audio frame
+typedef struct AudioSyncFrame {
+  uint16_t seq;
+  uint32_t timestamp;     // sender time (ms)
+  float    sampleRaw;
+  float    sampleSmth;
+  float    magnitude;
+  float    majorPeak;
+  uint8_t  samplePeak;
+  uint8_t  fftResult[AUDIOSYNC_GEQ_CHANNELS];
+} audiosyncframe_t;
+
+namespace AudioSyncV3 {
+  inline uint16_t toFixed88(float v)   { v = v < 0.0f ? 0.0f : (v > 255.99f ? 255.99f : v); return uint16_t(v * 256.0f + 0.5f); }
+  inline float    fromFixed88(uint16_t v) { return v / 256.0f; }
+  inline uint16_t toBFloat16(float v) {
+    uint32_t u; memcpy(&u, &v, sizeof(u));
+    u += 0x7FFF + ((u >> 16) & 1); // round to nearest even
+    return u >> 16;
+  }
+  inline float fromBFloat16(uint16_t v) {
+    uint32_t u = uint32_t(v) << 16; float f; memcpy(&f, &u, sizeof(f));
+    return f;
+  }
+
+  // encode frames (newest first) into buffer, returns packet size or 0 if the buffer is too small
+  inline size_t encode(uint8_t *buffer, size_t bufferSize, const AudioSyncFrame *frames, unsigned count) {
+    if (count == 0) return 0;
+    if (count > AUDIOSYNC_V3_MAX_FRAMES) count = AUDIOSYNC_V3_MAX_FRAMES;
+    const size_t frameSize = sizeof(audioSyncFrame_v3) + AUDIOSYNC_GEQ_CHANNELS;
+    const size_t packetSize = sizeof(audioSyncHeader_v3) + count * frameSize;
+    if (packetSize > bufferSize) return 0;
+
+    audioSyncHeader_v3 hdr;
+    memset(&hdr, 0, sizeof(hdr));
+    memcpy(hdr.header, AUDIOSYNC_V3_HEADER, sizeof(AUDIOSYNC_V3_HEADER));
+    hdr.flags     = 0;
+    hdr.frames    = count;
+    hdr.seq       = frames[0].seq;
+    hdr.timestamp = frames[0].timestamp;
+    memcpy(buffer, &hdr, sizeof(hdr));
+
+    uint8_t *p = buffer + sizeof(hdr);
+    for (unsigned i = 0; i < count; i++, p += frameSize) {
+      const AudioSyncFrame &f = frames[i];
+      const uint32_t age = frames[0].timestamp - f.timestamp;
+      audioSyncFrame_v3 fr;
+      fr.age        = age > 255 ? 255 : age;
+      fr.samplePeak = f.samplePeak;
+      fr.sampleRaw  = toFixed88(f.sampleRaw);
+      fr.sampleSmth = toFixed88(f.sampleSmth);
+      fr.magnitude  = toBFloat16(f.magnitude);
+      fr.majorPeak  = f.majorPeak < 0.0f ? 0 : (f.majorPeak > 65535.0f ? 65535 : uint16_t(f.majorPeak + 0.5f));
+      memcpy(p, &fr, sizeof(fr));
+      memcpy(p + sizeof(fr), f.fftResult, AUDIOSYNC_GEQ_CHANNELS);
+    }
+    return packetSize;
+  }
+
+  inline bool isValid(const uint8_t *buffer, size_t packetSize) {
+    if (packetSize < sizeof(audioSyncHeader_v3) || memcmp(buffer, AUDIOSYNC_V3_HEADER, sizeof(AUDIOSYNC_V3_HEADER)) != 0) return false;
+    const audioSyncHeader_v3 *hdr = reinterpret_cast<const audioSyncHeader_v3*>(buffer);
+    const size_t geq = (hdr->flags & AUDIOSYNC_V3_FLAG_GEQ32) ? 2*AUDIOSYNC_GEQ_CHANNELS : AUDIOSYNC_GEQ_CHANNELS;
+    return hdr->frames > 0 && hdr->frames <= AUDIOSYNC_V3_MAX_FRAMES && packetSize == sizeof(audioSyncHeader_v3) + hdr->frames * (sizeof(audioSyncFrame_v3) + geq);
+  }
+
+  // decode packet into frames (newest first), returns number of frames or 0 if the packet is invalid
+  inline unsigned decode(const uint8_t *buffer, size_t packetSize, AudioSyncFrame *frames, unsigned maxFrames) {
+    if (!isValid(buffer, packetSize)) return 0;
+    audioSyncHeader_v3 hdr;
+    memcpy(&hdr, buffer, sizeof(hdr)); // don't violate alignment
+    const bool geq32 = hdr.flags & AUDIOSYNC_V3_FLAG_GEQ32;
+    const size_t frameSize = sizeof(audioSyncFrame_v3) + (geq32 ? 2*AUDIOSYNC_GEQ_CHANNELS : AUDIOSYNC_GEQ_CHANNELS);
+    const unsigned count = hdr.frames < maxFrames ? hdr.frames : maxFrames;
+
+    const uint8_t *p = buffer + sizeof(hdr);
+    for (unsigned i = 0; i < count; i++, p += frameSize) {
+      audioSyncFrame_v3 fr;
+      memcpy(&fr, p, sizeof(fr));
+      AudioSyncFrame &f = frames[i];
+      f.seq        = hdr.seq - i;
+      f.timestamp  = hdr.timestamp - fr.age;
+      f.samplePeak = fr.samplePeak;
+      f.sampleRaw  = fromFixed88(fr.sampleRaw);
+      f.sampleSmth = fromFixed88(fr.sampleSmth);
+      f.magnitude  = fromBFloat16(fr.magnitude);
+      f.majorPeak  = fr.majorPeak;
+      const uint8_t *geq = p + sizeof(fr);
+      for (unsigned c = 0; c < AUDIOSYNC_GEQ_CHANNELS; c++) {
+        f.fftResult[c] = geq32 ? (geq[2*c] > geq[2*c+1] ? geq[2*c] : geq[2*c+1]) : geq[c]; // 32 channels: use the louder one of each pair
+      }
+    }
+    return count;
+  }
+}
+
+//
+// receive side jitter buffer
+//
+class AudioSyncJitterBuffer {
+  public:
+    uint32_t received;    // frames added
+    uint32_t duplicates;  // frames received more than once or after their playout time (repeated in bundles)
+    uint32_t lost;        // frames never received (bridged by interpolation or hold)
+
+    AudioSyncJitterBuffer() { reset(); }
+
+    void reset() {
+      _count = 0;
+      _synced = false;
+      _havePlayed = false;
+      received = duplicates = lost = 0;
+    }
+
+    // add a received frame, now = local time (ms)
+    void push(const AudioSyncFrame &frame, uint32_t now) {
+      // sender time to local time offset: the smallest observed transit time, slowly relaxed to follow clock drift
+      const int32_t offset = int32_t(now - frame.timestamp);
+      if (!_synced || offset - _offset < 0 || offset - _offset > 1000) { _offset = offset; _offsetTime = now; _synced = true; } // resync after big jumps (sender restart)
+      else if (now - _offsetTime > 1000) { _offset++; _offsetTime = now; }
+
+      if (_havePlayed && int16_t(frame.seq - _playedSeq) <= 0) { duplicates++; return; }
+      int pos = 0;
+      for (; pos < _count; pos++) {
+        const int16_t d = frame.seq - _frames[pos].seq;
+        if (d == 0) { duplicates++; return; }
+        if (d < 0) break;
+      }
+      if (_count == AUDIOSYNC_JITTER_SLOTS) {
+        if (pos == 0) { duplicates++; return; } // older than everything we have
+        removeFirst(); pos--;                  // drop oldest frame
+      }
+      memmove(&_frames[pos+1], &_frames[pos], (_count - pos) * sizeof(AudioSyncFrame));
+      _frames[pos] = frame;
+      _count++;
+      received++;
+    }
+
+    // get the frame for local time now (interpolated between received frames); returns false if no data is available
+    // samplePeak is set once for every received frame with a peak
+    bool get(uint32_t now, AudioSyncFrame &out) {
+      if (!_synced || _count == 0) return false;
+      const uint32_t t = now - _offset - AUDIOSYNC_JITTER_DELAY; // playout position on sender time line
+
+      // drop frames that are completely in the past (keep the last one before t)
+      uint8_t peak = 0;
+      while (_count > 1 && int32_t(t - _frames[1].timestamp) >= 0) {
+        peak |= consume(_frames[0]);
+        removeFirst();
+      }
+      const AudioSyncFrame &a = _frames[0];
+      if (int32_t(t - a.timestamp) < 0) return false;         // buffer not filled yet
+      peak |= consume(a);
+
+      if (_count > 1) {
+        // interpolate towards next frame (may be several sequence numbers ahead if packets were lost)
+        const AudioSyncFrame &b = _frames[1];
+        const uint32_t span = b.timestamp - a.timestamp;
+        const uint32_t w = span ? ((t - a.timestamp) << 8) / span : 0; // 0..256
+        out.seq        = a.seq;
+        out.timestamp  = t;
+        out.sampleRaw  = lerp(a.sampleRaw,  b.sampleRaw,  w);
+        out.sampleSmth = lerp(a.sampleSmth, b.sampleSmth, w);
+        out.magnitude  = lerp(a.magnitude,  b.magnitude,  w);
+        out.majorPeak  = w < 128 ? a.majorPeak : b.majorPeak;  // don't interpolate frequencies
+        for (unsigned c = 0; c < AUDIOSYNC_GEQ_CHANNELS; c++) out.fftResult[c] = (a.fftResult[c] * (256 - w) + b.fftResult[c] * w) >> 8;
+      } else {
+        // no newer frame (yet): hold the last one for a short time
+        if (t - a.timestamp > AUDIOSYNC_MAX_HOLD) return false;
+        out = a;
+        out.timestamp = t;
+      }
+      out.samplePeak = peak;
+      return true;
+    }
+
+    inline uint8_t count() const { return _count; }
+
+  private:
+    AudioSyncFrame _frames[AUDIOSYNC_JITTER_SLOTS]; // sorted by sequence number, oldest first
+    uint8_t  _count;
+    bool     _synced;
+    bool     _havePlayed;
+    uint16_t _playedSeq;      // newest frame that reached its playout time
+    int32_t  _offset;         // local time - sender time
+    uint32_t _offsetTime;
+
+    void removeFirst() {
+      _count--;
+      memmove(&_frames[0], &_frames[1], _count * sizeof(AudioSyncFrame));
+    }
+
+    // mark frame as played, count lost frames in front of it, returns its peak flag if not played before
+    uint8_t consume(const AudioSyncFrame &f) {
+      if (_havePlayed) {
+        const int16_t d = f.seq - _playedSeq;
+        if (d <= 0) return 0;
+        lost += d - 1;
+      }
+      _havePlayed = true;
+      _playedSeq = f.seq;
+      return f.samplePeak;
+    }
+
+    static inline float lerp(float a, float b, uint32_t w) { return a + (b - a) * (w / 256.0f); }
+};
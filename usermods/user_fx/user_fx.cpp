@@ -95,7 +95,7 @@ unsigned dataSize = cols * rows;  // SEGLEN (virtual length) is equivalent to vW
     }
   }
 }
-static const char _data_FX_MODE_DIFFUSIONFIRE[] PROGMEM = "Diffusion Fire@!,Spark rate,Diffusion Speed,Turbulence,,Use palette;;Color;;2;pal=35";
+static constexpr char _data_FX_MODE_DIFFUSIONFIRE[] PROGMEM = "Diffusion Fire@!,Spark rate,Diffusion Speed,Turbulence,,Use palette;;Color;2;pal=35";
 
 
 /*
@@ -337,7 +337,7 @@ static void mode_spinning_wheel(void) {
     }
   }
 }
-static const char _data_FX_MODE_SPINNINGWHEEL[] PROGMEM = "Spinning Wheel@Speed (0=random),Slowdown (0=random),Spinner size,,Spin delay,Spin me!,Color per block,Sync restart;!,!;!;;m12=1,c1=1,c3=8,o1=1,o3=1";
+static constexpr char _data_FX_MODE_SPINNINGWHEEL[] PROGMEM = "Spinning Wheel@Speed (0=random),Slowdown (0=random),Spinner size,,Spin delay,Spin me!,Color per block,Sync restart;!,!;!;;m12=1,c1=1,c3=8,o1=1,o3=1";
 
 
 /*
@@ -623,7 +623,7 @@ static void mode_2D_lavalamp(void) {
     }
   }
 }
-static const char _data_FX_MODE_2D_LAVALAMP[] PROGMEM = "Lava Lamp@,# of blobs,Blob size,H. Damping,,,Attract,Keep Color Ratio;;!;2;ix=64,c2=192,o2=1,o3=1,pal=47";
+static constexpr char _data_FX_MODE_2D_LAVALAMP[] PROGMEM = "Lava Lamp@,# of blobs,Blob size,H. Damping,,,Attract,Keep Color Ratio;;!;2;ix=64,c2=192,o2=1,o3=1,pal=47";
 
 
 /*
@@ -814,7 +814,7 @@ static void mode_2D_magma(void) {
 
   SEGENV.step++;
 }
-static const char _data_FX_MODE_2D_MAGMA[] PROGMEM = "Magma@Flow rate,Magma height,Lava bombs,Gravity,,,Bombs in front;;!;2;ix=192,c2=32,o2=1,pal=35";
+static constexpr char _data_FX_MODE_2D_MAGMA[] PROGMEM = "Magma@Flow rate,Magma height,Lava bombs,Gravity,,,Bombs in front;;!;2;ix=192,c2=32,o2=1,pal=35";
 
 
 /*
@@ -1003,7 +1003,7 @@ static void mode_ants(void) {
 
   SEGMENT.blur(SEGMENT.custom2>>1);
 }
-static const char _data_FX_MODE_ANTS[] PROGMEM = "Ants@Ant speed,# of ants,Ant size,Blur,,Gathering food,Smear,Pass by;!,!,!;!;1;sx=192,ix=255,c1=32,c2=0,o1=1,o3=1";
+static constexpr char _data_FX_MODE_ANTS[] PROGMEM = "Ants@Ant speed,# of ants,Ant size,Blur,,Gathering food,Smear,Pass by;!,!,!;!;1;sx=192,ix=255,c1=32,c2=0,o1=1,o3=1";
 
 
 /*
@@ -1255,7 +1255,26 @@ static void mode_morsecode(void) {
     }
   }
 }
-static const char _data_FX_MODE_MORSECODE[] PROGMEM = "Morse Code@Speed,,,,Color mode,Color by Word,Punctuation,EndOfMessage;;!;1;sx=192,c3=8,o1=1,o2=1";
+static constexpr char _data_FX_MODE_MORSECODE[] PROGMEM = "Morse Code@Speed,,,,Color mode,Color by Word,Punctuation,EndOfMessage;;!;1;sx=192,c3=8,o1=1,o2=1";
+
+
+// effects are registered at compile time (metadata is checked by the compiler), see wled00/fx_registry.h
+REGISTER_EFFECT(255, mode_diffusionfire, _data_FX_MODE_DIFFUSIONFIRE);
+REGISTER_EFFECT(255, mode_spinning_wheel, _data_FX_MODE_SPINNINGWHEEL);
+REGISTER_EFFECT(255, mode_2D_lavalamp, _data_FX_MODE_2D_LAVALAMP);
+REGISTER_EFFECT(255, mode_2D_magma, _data_FX_MODE_2D_MAGMA);
+REGISTER_EFFECT(255, mode_ants, _data_FX_MODE_ANTS);
+REGISTER_EFFECT(255, mode_morsecode, _data_FX_MODE_MORSECODE);
+
+////////////////////////////////////////
+//  add your effect function(s) here  //
+////////////////////////////////////////
+
+// use id=255 for all custom user FX (the final id is assigned at boot)
+
+// REGISTER_EFFECT(255, mode_your_effect, _data_FX_MODE_YOUR_EFFECT);
+// REGISTER_EFFECT(255, mode_your_effect2, _data_FX_MODE_YOUR_EFFECT2);
+// REGISTER_EFFECT(255, mode_your_effect3, _data_FX_MODE_YOUR_EFFECT3);
 
 
 /////////////////////
@@ -1265,24 +1284,7 @@ static const char _data_FX_MODE_MORSECODE[] PROGMEM = "Morse Code@Speed,,,,Color
 class UserFxUsermod : public Usermod {
  private:
  public:
-  void setup() override {
-    strip.addEffect(255, &mode_diffusionfire, _data_FX_MODE_DIFFUSIONFIRE);
-    strip.addEffect(255, &mode_spinning_wheel, _data_FX_MODE_SPINNINGWHEEL);
-    strip.addEffect(255, &mode_2D_lavalamp, _data_FX_MODE_2D_LAVALAMP);
-    strip.addEffect(255, &mode_2D_magma, _data_FX_MODE_2D_MAGMA);
-    strip.addEffect(255, &mode_ants, _data_FX_MODE_ANTS);
-    strip.addEffect(255, &mode_morsecode, _data_FX_MODE_MORSECODE);
-
-    ////////////////////////////////////////
-    //  add your effect function(s) here  //
-    ////////////////////////////////////////
-
-    // use id=255 for all custom user FX (the final id is assigned when adding the effect)
-
-    // strip.addEffect(255, &mode_your_effect, _data_FX_MODE_YOUR_EFFECT);
-    // strip.addEffect(255, &mode_your_effect2, _data_FX_MODE_YOUR_EFFECT2);
-    // strip.addEffect(255, &mode_your_effect3, _data_FX_MODE_YOUR_EFFECT3);
-  }
+  void setup() override {}
 
 
   ///////////////////////////////////////////////////////////////////////////////////////////////
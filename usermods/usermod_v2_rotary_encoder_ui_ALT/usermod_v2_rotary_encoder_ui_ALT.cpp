@@ -234,8 +234,9 @@ class RotaryEncoderUIUsermod : public Usermod {
     /**
      * Sort the modes and palettes to the index arrays
      * modes_alpha_indexes and palettes_alpha_indexes.
+     * Returns false if there is no memory for the index arrays.
      */
-    void sortModesAndPalettes();
+    bool sortModesAndPalettes();
     byte *re_initIndexArray(int numModes);
 
     /**
@@ -392,32 +393,39 @@ byte RotaryEncoderUIUsermod::readPin(uint8_t pin) {
 /**
  * Sort the modes and palettes to the index arrays
  * modes_alpha_indexes and palettes_alpha_indexes.
+ * Returns false if there is no memory for the index arrays.
  */
-void RotaryEncoderUIUsermod::sortModesAndPalettes() {
+bool RotaryEncoderUIUsermod::sortModesAndPalettes() {
   DEBUG_PRINT(F("Sorting modes: ")); DEBUG_PRINTLN(strip.getModeCount());
   //modes_qstrings = re_findModeStrings(JSON_mode_names, strip.getModeCount());
-  modes_qstrings = strip.getModeDataSrc();
+  modes_qstrings = (const char **)malloc(sizeof(const char *) * strip.getModeCount()); // allocates memory for all mode names
+  if (modes_qstrings) for (unsigned i = 0; i < strip.getModeCount(); i++) modes_qstrings[i] = strip.getModeData(i);
   modes_alpha_indexes = re_initIndexArray(strip.getModeCount());
-  re_sortModes(modes_qstrings, modes_alpha_indexes, strip.getModeCount(), MODE_SORT_SKIP_COUNT);
+  if (!modes_alpha_indexes) return false;
+  re_sortModes(modes_qstrings, modes_alpha_indexes, strip.getModeCount(), MODE_SORT_SKIP_COUNT); // stays unsorted without mode names
 
   DEBUG_PRINT(F("Sorting palettes: ")); DEBUG_PRINT(getPaletteCount()); DEBUG_PRINT('/'); DEBUG_PRINTLN(customPalettes.size());
   palettes_qstrings = re_findModeStrings(JSON_palette_names, getPaletteCount()); // allocates memory for all palette names
   palettes_alpha_indexes = re_initIndexArray(getPaletteCount()); // allocates memory for all palette indexes
+  if (!palettes_alpha_indexes) return false;
   if (customPalettes.size()) {
     for (int i=0; i<customPalettes.size(); i++) {
       palettes_alpha_indexes[FIXED_PALETTE_COUNT+i] = 255-i;
-      palettes_qstrings[FIXED_PALETTE_COUNT+i] = PSTR("~Custom~");
+      if (palettes_qstrings) palettes_qstrings[FIXED_PALETTE_COUNT+i] = PSTR("~Custom~");
     }
   }
+  if (!palettes_qstrings) return true; // no memory for palette names, leave them unsorted
   // How many palette names start with '*' and should not be sorted?
   // (Also skipping the first one, 'Default').
   int skipPaletteCount = 1; // could use DYNAMIC_PALETTE_COUNT instead
   while (pgm_read_byte_near(palettes_qstrings[skipPaletteCount]) == '*') skipPaletteCount++; // legacy code
   re_sortModes(palettes_qstrings, palettes_alpha_indexes, FIXED_PALETTE_COUNT, skipPaletteCount); // only sort fixed palettes (skip dynamic)
+  return true;
 }
 
 byte *RotaryEncoderUIUsermod::re_initIndexArray(int numModes) {
   byte *indexes = (byte *)malloc(sizeof(byte) * numModes);
+  if (!indexes) return nullptr;
   for (unsigned i = 0; i < numModes; i++) {
     indexes[i] = i;
   }
@@ -430,6 +438,7 @@ byte *RotaryEncoderUIUsermod::re_initIndexArray(int numModes) {
  */
 const char **RotaryEncoderUIUsermod::re_findModeStrings(const char json[], int numModes) {
   const char **modeStrings = (const char **)malloc(sizeof(const char *) * numModes);
+  if (!modeStrings) return nullptr;
   uint8_t modeIndex = 0;
   bool insideQuotes = false;
   // advance past the mark for markLineNum that may exist.
@@ -522,7 +531,11 @@ void RotaryEncoderUIUsermod::setup()
 
   currentCCT = (approximateKelvinFromRGB(RGBW32(colPri[0], colPri[1], colPri[2], colPri[3])) - 1900) >> 5;
 
-  if (!initDone) sortModesAndPalettes();
+  if (!initDone && !sortModesAndPalettes()) {
+    DEBUG_PRINTLN(F("Not enough memory for mode and palette lists, disabling."));
+    enabled = false;
+    return;
+  }
 
 #ifdef USERMOD_FOUR_LINE_DISPLAY
   // This Usermod uses FourLineDisplayUsermod for the best experience.
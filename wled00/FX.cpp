@@ -63,7 +63,10 @@
   my_magnitude  = *(float*)   um_data->u_data[5];
   maxVol        =  (uint8_t*) um_data->u_data[6];  // requires UI element (SEGMENT.customX?), changes source element
   binNum        =  (uint8_t*) um_data->u_data[7];  // requires UI element (SEGMENT.customX?), changes source element
-  fftBin        =  (float*)   um_data->u_data[8];
+  frames        = um_data->u_size > 8 ? (AudioFrames*) um_data->u_data[8] : nullptr; // consistent snapshots & history (see audio_frames.h), not available with simulated sound
+  bpm           = um_data->u_size > 11 ? *(float*)  um_data->u_data[9]  : 0; // tempo (BPM), 0 = unknown
+  beatPhase     = um_data->u_size > 11 ? *(uint8_t*)um_data->u_data[10] : 0; // position between beats 0..255, 0 = on the beat
+  beatConfidence= um_data->u_size > 11 ? *(uint8_t*)um_data->u_data[11] : 0; // tempo confidence 0..255
 */
 
 #define IBN 5100
@@ -136,7 +139,7 @@ static um_data_t* getAudioData() {
 void mode_static(void) {
   SEGMENT.fill(SEGCOLOR(0));
 }
-static const char _data_FX_MODE_STATIC[] PROGMEM = "Solid";
+static constexpr char _data_FX_MODE_STATIC[] PROGMEM = "Solid";
 
 /*
  * Copy a segment and perform (optional) color adjustments
@@ -184,7 +187,7 @@ void mode_copy_segment(void) {
     }
   }
 }
-static const char _data_FX_MODE_COPY[] PROGMEM = "Copy Segment@,Color shift,Lighten,Brighten,ID,Axis(2D),FullStack(last frame);;;12;ix=0,c1=0,c2=0,c3=0";
+static constexpr char _data_FX_MODE_COPY[] PROGMEM = "Copy Segment@,Color shift,Lighten,Brighten,ID,Axis(2D),FullStack(last frame);;;12;ix=0,c1=0,c2=0,c3=0";
 
 
 /*
@@ -224,7 +227,7 @@ void blink(uint32_t color1, uint32_t color2, bool strobe, bool do_palette) {
 void mode_blink(void) {
   blink(SEGCOLOR(0), SEGCOLOR(1), false, true);
 }
-static const char _data_FX_MODE_BLINK[] PROGMEM = "Blink@!,Duty cycle;!,!;!;01";
+static constexpr char _data_FX_MODE_BLINK[] PROGMEM = "Blink@!,Duty cycle;!,!;!;01";
 
 
 /*
@@ -233,7 +236,7 @@ static const char _data_FX_MODE_BLINK[] PROGMEM = "Blink@!,Duty cycle;!,!;!;01";
 void mode_blink_rainbow(void) {
   blink(SEGMENT.color_wheel(SEGENV.call & 0xFF), SEGCOLOR(1), false, false);
 }
-static const char _data_FX_MODE_BLINK_RAINBOW[] PROGMEM = "Blink Rainbow@Frequency,Blink duration;!,!;!;01";
+static constexpr char _data_FX_MODE_BLINK_RAINBOW[] PROGMEM = "Blink Rainbow@Frequency,Blink duration;!,!;!;01";
 
 
 /*
@@ -242,7 +245,7 @@ static const char _data_FX_MODE_BLINK_RAINBOW[] PROGMEM = "Blink Rainbow@Frequen
 void mode_strobe(void) {
   return blink(SEGCOLOR(0), SEGCOLOR(1), true, true);
 }
-static const char _data_FX_MODE_STROBE[] PROGMEM = "Strobe@!;!,!;!;01";
+static constexpr char _data_FX_MODE_STROBE[] PROGMEM = "Strobe@!;!,!;!;01";
 
 
 /*
@@ -251,7 +254,7 @@ static const char _data_FX_MODE_STROBE[] PROGMEM = "Strobe@!;!,!;!;01";
 void mode_strobe_rainbow(void) {
   return blink(SEGMENT.color_wheel(SEGENV.call & 0xFF), SEGCOLOR(1), true, false);
 }
-static const char _data_FX_MODE_STROBE_RAINBOW[] PROGMEM = "Strobe Rainbow@!;,!;!;01";
+static constexpr char _data_FX_MODE_STROBE_RAINBOW[] PROGMEM = "Strobe Rainbow@!;,!;!;01";
 
 
 /*
@@ -316,7 +319,7 @@ void color_wipe(bool rev, bool useRandomColors) {
 void mode_color_wipe(void) {
   color_wipe(false, false);
 }
-static const char _data_FX_MODE_COLOR_WIPE[] PROGMEM = "Wipe@!,!;!,!;!";
+static constexpr char _data_FX_MODE_COLOR_WIPE[] PROGMEM = "Wipe@!,!;!,!;!";
 
 
 /*
@@ -325,7 +328,7 @@ static const char _data_FX_MODE_COLOR_WIPE[] PROGMEM = "Wipe@!,!;!,!;!";
 void mode_color_sweep(void) {
   color_wipe(true, false);
 }
-static const char _data_FX_MODE_COLOR_SWEEP[] PROGMEM = "Sweep@!,!;!,!;!";
+static constexpr char _data_FX_MODE_COLOR_SWEEP[] PROGMEM = "Sweep@!,!;!,!;!";
 
 
 /*
@@ -335,7 +338,7 @@ static const char _data_FX_MODE_COLOR_SWEEP[] PROGMEM = "Sweep@!,!;!,!;!";
 void mode_color_wipe_random(void) {
   color_wipe(false, true);
 }
-static const char _data_FX_MODE_COLOR_WIPE_RANDOM[] PROGMEM = "Wipe Random@!;;!";
+static constexpr char _data_FX_MODE_COLOR_WIPE_RANDOM[] PROGMEM = "Wipe Random@!;;!";
 
 
 /*
@@ -344,7 +347,7 @@ static const char _data_FX_MODE_COLOR_WIPE_RANDOM[] PROGMEM = "Wipe Random@!;;!"
 void mode_color_sweep_random(void) {
   color_wipe(true, true);
 }
-static const char _data_FX_MODE_COLOR_SWEEP_RANDOM[] PROGMEM = "Sweep Random@!;;!";
+static constexpr char _data_FX_MODE_COLOR_SWEEP_RANDOM[] PROGMEM = "Sweep Random@!;;!";
 
 
 /*
@@ -376,7 +379,7 @@ void mode_random_color(void) {
 
   SEGMENT.fill(color_blend(SEGMENT.color_wheel(SEGENV.aux1), SEGMENT.color_wheel(SEGENV.aux0), uint8_t(fade)));
 }
-static const char _data_FX_MODE_RANDOM_COLOR[] PROGMEM = "Random Colors@!,Fade time;;!;01";
+static constexpr char _data_FX_MODE_RANDOM_COLOR[] PROGMEM = "Random Colors@!,Fade time;;!;01";
 
 
 /*
@@ -411,7 +414,7 @@ void mode_dynamic(void) {
     }
   }
 }
-static const char _data_FX_MODE_DYNAMIC[] PROGMEM = "Dynamic@!,!,,,,Smooth;;!";
+static constexpr char _data_FX_MODE_DYNAMIC[] PROGMEM = "Dynamic@!,!,,,,Smooth;;!";
 
 
 /*
@@ -423,7 +426,7 @@ void mode_dynamic_smooth(void) {
   mode_dynamic();
   SEGMENT.check1 = old;
  }
-static const char _data_FX_MODE_DYNAMIC_SMOOTH[] PROGMEM = "Dynamic Smooth@!,!;;!";
+static constexpr char _data_FX_MODE_DYNAMIC_SMOOTH[] PROGMEM = "Dynamic Smooth@!,!;;!";
 
 
 /*
@@ -444,7 +447,7 @@ void mode_breath(void) {
   }
 
 }
-static const char _data_FX_MODE_BREATH[] PROGMEM = "Breathe@!;!,!;!;01";
+static constexpr char _data_FX_MODE_BREATH[] PROGMEM = "Breathe@!;!,!;!;01";
 
 
 /*
@@ -458,7 +461,7 @@ void mode_fade(void) {
     SEGMENT.setPixelColor(i, color_blend(SEGCOLOR(1), SEGMENT.color_from_palette(i, true, PALETTE_SOLID_WRAP, 0), lum));
   }
 }
-static const char _data_FX_MODE_FADE[] PROGMEM = "Fade@!;!,!;!;01";
+static constexpr char _data_FX_MODE_FADE[] PROGMEM = "Fade@!;!,!;!;01";
 
 
 /*
@@ -496,7 +499,7 @@ void scan(bool dual) {
 void mode_scan(void) {
   scan(false);
 }
-static const char _data_FX_MODE_SCAN[] PROGMEM = "Scan@!,# of dots,,,,,Overlay;!,!,!;!";
+static constexpr char _data_FX_MODE_SCAN[] PROGMEM = "Scan@!,# of dots,,,,,Overlay;!,!,!;!";
 
 
 /*
@@ -505,7 +508,7 @@ static const char _data_FX_MODE_SCAN[] PROGMEM = "Scan@!,# of dots,,,,,Overlay;!
 void mode_dual_scan(void) {
   scan(true);
 }
-static const char _data_FX_MODE_DUAL_SCAN[] PROGMEM = "Scan Dual@!,# of dots,,,,,Overlay;!,!,!;!";
+static constexpr char _data_FX_MODE_DUAL_SCAN[] PROGMEM = "Scan Dual@!,# of dots,,,,,Overlay;!,!,!;!";
 
 
 /*
@@ -521,7 +524,7 @@ void mode_rainbow(void) {
     SEGMENT.fill(SEGMENT.color_wheel(counter));
   }
 }
-static const char _data_FX_MODE_RAINBOW[] PROGMEM = "Colorloop@!,Saturation;;!;01";
+static constexpr char _data_FX_MODE_RAINBOW[] PROGMEM = "Colorloop@!,Saturation;;!;01";
 
 
 /*
@@ -537,7 +540,7 @@ void mode_rainbow_cycle(void) {
     SEGMENT.setPixelColor(i, SEGMENT.color_wheel(index));
   }
 }
-static const char _data_FX_MODE_RAINBOW_CYCLE[] PROGMEM = "Rainbow@!,Size;;!";
+static constexpr char _data_FX_MODE_RAINBOW_CYCLE[] PROGMEM = "Rainbow@!,Size;;!";
 
 
 /*
@@ -575,7 +578,7 @@ static void running(uint32_t color1, uint32_t color2, bool theatre = false) {
 void mode_theater_chase(void) {
   running(SEGCOLOR(0), SEGCOLOR(1), true);
 }
-static const char _data_FX_MODE_THEATER_CHASE[] PROGMEM = "Theater@!,Gap size;!,!;!";
+static constexpr char _data_FX_MODE_THEATER_CHASE[] PROGMEM = "Theater@!,Gap size;!,!;!";
 
 
 /*
@@ -585,7 +588,7 @@ static const char _data_FX_MODE_THEATER_CHASE[] PROGMEM = "Theater@!,Gap size;!,
 void mode_theater_chase_rainbow(void) {
   running(SEGMENT.color_wheel(SEGENV.step), SEGCOLOR(1), true);
 }
-static const char _data_FX_MODE_THEATER_CHASE_RAINBOW[] PROGMEM = "Theater Rainbow@!,Gap size;,!;!";
+static constexpr char _data_FX_MODE_THEATER_CHASE_RAINBOW[] PROGMEM = "Theater Rainbow@!,Gap size;,!;!";
 
 
 /*
@@ -627,7 +630,7 @@ static void running_base(bool saw, bool dual=false) {
 void mode_running_dual(void) {
   running_base(false, true);
 }
-static const char _data_FX_MODE_RUNNING_DUAL[] PROGMEM = "Running Dual@!,Wave width;L,!,R;!";
+static constexpr char _data_FX_MODE_RUNNING_DUAL[] PROGMEM = "Running Dual@!,Wave width;L,!,R;!";
 
 
 /*
@@ -636,7 +639,7 @@ static const char _data_FX_MODE_RUNNING_DUAL[] PROGMEM = "Running Dual@!,Wave wi
 void mode_running_lights(void) {
   running_base(false);
 }
-static const char _data_FX_MODE_RUNNING_LIGHTS[] PROGMEM = "Running@!,Wave width;!,!;!";
+static constexpr char _data_FX_MODE_RUNNING_LIGHTS[] PROGMEM = "Running@!,Wave width;!,!;!";
 
 
 /*
@@ -645,7 +648,7 @@ static const char _data_FX_MODE_RUNNING_LIGHTS[] PROGMEM = "Running@!,Wave width
 void mode_saw(void) {
   running_base(true);
 }
-static const char _data_FX_MODE_SAW[] PROGMEM = "Saw@!,Width;!,!;!";
+static constexpr char _data_FX_MODE_SAW[] PROGMEM = "Saw@!,Width;!,!;!";
 
 
 /*
@@ -679,7 +682,7 @@ void mode_twinkle(void) {
     SEGMENT.setPixelColor(j, SEGMENT.color_from_palette(j, true, PALETTE_SOLID_WRAP, 0));
   }
 }
-static const char _data_FX_MODE_TWINKLE[] PROGMEM = "Twinkle@!,!;!,!;!;;m12=0"; //pixels
+static constexpr char _data_FX_MODE_TWINKLE[] PROGMEM = "Twinkle@!,!;!,!;!;;m12=0"; //pixels
 
 
 /*
@@ -744,7 +747,7 @@ void dissolve(uint32_t color) {
 void mode_dissolve(void) {
   dissolve(SEGMENT.check1 ? SEGMENT.color_wheel(hw_random8()) : SEGCOLOR(0));
 }
-static const char _data_FX_MODE_DISSOLVE[] PROGMEM = "Dissolve@Repeat speed,Dissolve speed,,,,Random,Complete;!,!;!";
+static constexpr char _data_FX_MODE_DISSOLVE[] PROGMEM = "Dissolve@Repeat speed,Dissolve speed,,,,Random,Complete;!,!;!";
 
 
 /*
@@ -753,7 +756,7 @@ static const char _data_FX_MODE_DISSOLVE[] PROGMEM = "Dissolve@Repeat speed,Diss
 void mode_dissolve_random(void) {
   dissolve(SEGMENT.color_wheel(hw_random8()));
 }
-static const char _data_FX_MODE_DISSOLVE_RANDOM[] PROGMEM = "Dissolve Rnd@Repeat speed,Dissolve speed;,!;!";
+static constexpr char _data_FX_MODE_DISSOLVE_RANDOM[] PROGMEM = "Dissolve Rnd@Repeat speed,Dissolve speed;,!;!";
 
 /*
  * Blinks one LED at a time.
@@ -773,7 +776,7 @@ void mode_sparkle(void) {
 
   SEGMENT.setPixelColor(SEGENV.aux0, SEGCOLOR(0));
 }
-static const char _data_FX_MODE_SPARKLE[] PROGMEM = "Sparkle@!,,,,,,Overlay;!,!;!;;m12=0";
+static constexpr char _data_FX_MODE_SPARKLE[] PROGMEM = "Sparkle@!,,,,,,Overlay;!,!;!;;m12=0";
 
 /*
  * Lights all LEDs in the color. Flashes single col 1 pixels randomly. (List name: Sparkle Dark)
@@ -792,7 +795,7 @@ void mode_flash_sparkle(void) {
     SEGENV.aux0 = 255-SEGMENT.speed;
   }
 }
-static const char _data_FX_MODE_FLASH_SPARKLE[] PROGMEM = "Sparkle Dark@!,!,,,,,Overlay;Bg,Fx;!;;m12=0";
+static constexpr char _data_FX_MODE_FLASH_SPARKLE[] PROGMEM = "Sparkle Dark@!,!,,,,,Overlay;Bg,Fx;!;;m12=0";
 
 
 /*
@@ -815,7 +818,7 @@ void mode_hyper_sparkle(void) {
     SEGENV.aux0 = 255-SEGMENT.speed;
   }
 }
-static const char _data_FX_MODE_HYPER_SPARKLE[] PROGMEM = "Sparkle+@!,!,,,,,Overlay;Bg,Fx;!;;m12=0";
+static constexpr char _data_FX_MODE_HYPER_SPARKLE[] PROGMEM = "Sparkle+@!,!,,,,,Overlay;Bg,Fx;!;;m12=0";
 
 
 /*
@@ -843,7 +846,7 @@ void mode_multi_strobe(void) {
     SEGENV.step = strip.now;
   }
 }
-static const char _data_FX_MODE_MULTI_STROBE[] PROGMEM = "Strobe Mega@!,!;!,!;!;01";
+static constexpr char _data_FX_MODE_MULTI_STROBE[] PROGMEM = "Strobe Mega@!,!;!,!;!;01";
 
 
 /*
@@ -883,7 +886,7 @@ void mode_android(void) {
       SEGMENT.setPixelColor(i, SEGMENT.color_from_palette(i, true, PALETTE_SOLID_WRAP, 1));
   }
 }
-static const char _data_FX_MODE_ANDROID[] PROGMEM = "Android@!,Width;!,!;!;;m12=1"; //vertical
+static constexpr char _data_FX_MODE_ANDROID[] PROGMEM = "Android@!,Width;!,!;!;;m12=1"; //vertical
 
 /*
  * color chase function.
@@ -961,7 +964,7 @@ static void chase(uint32_t color1, uint32_t color2, uint32_t color3, bool do_pal
 void mode_chase_color(void) {
   chase(SEGCOLOR(1), (SEGCOLOR(2)) ? SEGCOLOR(2) : SEGCOLOR(0), SEGCOLOR(0), true);
 }
-static const char _data_FX_MODE_CHASE_COLOR[] PROGMEM = "Chase@!,Width;!,!,!;!";
+static constexpr char _data_FX_MODE_CHASE_COLOR[] PROGMEM = "Chase@!,Width;!,!,!;!";
 
 
 /*
@@ -970,7 +973,7 @@ static const char _data_FX_MODE_CHASE_COLOR[] PROGMEM = "Chase@!,Width;!,!,!;!";
 void mode_chase_random(void) {
   chase(SEGCOLOR(1), (SEGCOLOR(2)) ? SEGCOLOR(2) : SEGCOLOR(0), SEGCOLOR(0), false);
 }
-static const char _data_FX_MODE_CHASE_RANDOM[] PROGMEM = "Chase Random@!,Width;!,,!;!";
+static constexpr char _data_FX_MODE_CHASE_RANDOM[] PROGMEM = "Chase Random@!,Width;!,,!;!";
 
 
 /*
@@ -984,7 +987,7 @@ void mode_chase_rainbow(void) {
 
   chase(color, SEGCOLOR(0), SEGCOLOR(1), false);
 }
-static const char _data_FX_MODE_CHASE_RAINBOW[] PROGMEM = "Chase Rainbow@!,Width;!,!;!";
+static constexpr char _data_FX_MODE_CHASE_RAINBOW[] PROGMEM = "Chase Rainbow@!,Width;!,!;!";
 
 
 /*
@@ -998,7 +1001,7 @@ void mode_chase_rainbow_white(void) {
 
   chase(SEGCOLOR(0), color2, color3, false);
 }
-static const char _data_FX_MODE_CHASE_RAINBOW_WHITE[] PROGMEM = "Rainbow Runner@!,Size;Bg;!";
+static constexpr char _data_FX_MODE_CHASE_RAINBOW_WHITE[] PROGMEM = "Rainbow Runner@!,Size;Bg;!";
 
 
 /*
@@ -1041,7 +1044,7 @@ void mode_colorful(void) {
     for (unsigned j = 0; j < numColors; j++) SEGMENT.setPixelColor(i + j, cols[SEGENV.aux0 + j]);
   }
 }
-static const char _data_FX_MODE_COLORFUL[] PROGMEM = "Colorful@!,Saturation;1,2,3;!";
+static constexpr char _data_FX_MODE_COLORFUL[] PROGMEM = "Colorful@!,Saturation;1,2,3;!";
 
 
 /*
@@ -1071,7 +1074,7 @@ void mode_traffic_light(void) {
     SEGENV.step = strip.now;
   }
 }
-static const char _data_FX_MODE_TRAFFIC_LIGHT[] PROGMEM = "Traffic Light@!,US style;,!;!";
+static constexpr char _data_FX_MODE_TRAFFIC_LIGHT[] PROGMEM = "Traffic Light@!,US style;,!;!";
 
 
 /*
@@ -1110,7 +1113,7 @@ void mode_chase_flash(void) {
   if (advance)
     SEGENV.step = now + delay; // set next update time
 }
-static const char _data_FX_MODE_CHASE_FLASH[] PROGMEM = "Chase Flash@!;Bg,Fx;!";
+static constexpr char _data_FX_MODE_CHASE_FLASH[] PROGMEM = "Chase Flash@!;Bg,Fx;!";
 
 
 /*
@@ -1153,7 +1156,7 @@ void mode_chase_flash_random(void) {
   if (advance)
     SEGENV.step = now + delay; // set next update time
 }
-static const char _data_FX_MODE_CHASE_FLASH_RANDOM[] PROGMEM = "Chase Flash Rnd@!;!,!;!";
+static constexpr char _data_FX_MODE_CHASE_FLASH_RANDOM[] PROGMEM = "Chase Flash Rnd@!;!,!;!";
 
 
 /*
@@ -1162,7 +1165,7 @@ static const char _data_FX_MODE_CHASE_FLASH_RANDOM[] PROGMEM = "Chase Flash Rnd@
 void mode_running_color(void) {
   running(SEGCOLOR(0), SEGCOLOR(1));
 }
-static const char _data_FX_MODE_RUNNING_COLOR[] PROGMEM = "Chase 2@!,Width;!,!;!";
+static constexpr char _data_FX_MODE_RUNNING_COLOR[] PROGMEM = "Chase 2@!,Width;!,!;!";
 
 
 /*
@@ -1198,7 +1201,7 @@ void mode_running_random(void) {
 
   SEGENV.aux1 = it;
 }
-static const char _data_FX_MODE_RUNNING_RANDOM[] PROGMEM = "Stream@!,Zone size;;!";
+static constexpr char _data_FX_MODE_RUNNING_RANDOM[] PROGMEM = "Stream@!,Zone size;;!";
 
 
 /*
@@ -1245,7 +1248,7 @@ void mode_larson_scanner(void) {
     SEGENV.aux1 = index;
   }
 }
-static const char _data_FX_MODE_LARSON_SCANNER[] PROGMEM = "Scanner@!,Trail,Delay,,,Dual,Bi-delay;!,!,!;!;;m12=0,c1=0";
+static constexpr char _data_FX_MODE_LARSON_SCANNER[] PROGMEM = "Scanner@!,Trail,Delay,,,Dual,Bi-delay;!,!,!;!;;m12=0,c1=0";
 
 /*
  * Creates two Larson scanners moving in opposite directions
@@ -1255,7 +1258,7 @@ void mode_dual_larson_scanner(void){
   SEGMENT.check1 = true;
   mode_larson_scanner();
 }
-static const char _data_FX_MODE_DUAL_LARSON_SCANNER[] PROGMEM = "Scanner Dual@!,Trail,Delay,,,Dual,Bi-delay;!,!,!;!;;m12=0,c1=0";
+static constexpr char _data_FX_MODE_DUAL_LARSON_SCANNER[] PROGMEM = "Scanner Dual@!,Trail,Delay,,,Dual,Bi-delay;!,!,!;!;;m12=0,c1=0";
 
 /*
  * Firing comets from one end. "Lighthouse"
@@ -1280,7 +1283,7 @@ void mode_comet(void) {
   }
   SEGENV.aux0 = index++;
 }
-static const char _data_FX_MODE_COMET[] PROGMEM = "Lighthouse@!,Fade rate;!,!;!";
+static constexpr char _data_FX_MODE_COMET[] PROGMEM = "Lighthouse@!,Fade rate;!,!;!";
 
 /*
  * Fireworks function.
@@ -1322,7 +1325,7 @@ void mode_fireworks() {
     }
   }
 }
-static const char _data_FX_MODE_FIREWORKS[] PROGMEM = "Fireworks@,Frequency;!,!;!;12;ix=192,pal=11";
+static constexpr char _data_FX_MODE_FIREWORKS[] PROGMEM = "Fireworks@,Frequency;!,!;!;12;ix=192,pal=11";
 
 //Twinkling LEDs running. Inspired by https://github.com/kitesurfer1404/WS2812FX/blob/master/src/custom/Rain.h
 void mode_rain() {
@@ -1356,7 +1359,7 @@ void mode_rain() {
   }
   mode_fireworks();
 }
-static const char _data_FX_MODE_RAIN[] PROGMEM = "Rain@!,Spawning rate;!,!;!;12;ix=128,pal=0";
+static constexpr char _data_FX_MODE_RAIN[] PROGMEM = "Rain@!,Spawning rate;!,!;!;12;ix=128,pal=0";
 
 /*
  * Fire flicker function
@@ -1383,7 +1386,7 @@ void mode_fire_flicker(void) {
 
   SEGENV.step = it;
 }
-static const char _data_FX_MODE_FIRE_FLICKER[] PROGMEM = "Fire Flicker@!,!;!;!;01";
+static constexpr char _data_FX_MODE_FIRE_FLICKER[] PROGMEM = "Fire Flicker@!,!;!;!;01";
 
 
 /*
@@ -1418,7 +1421,7 @@ void gradient_base(bool loading) {
 void mode_gradient(void) {
   gradient_base(false);
 }
-static const char _data_FX_MODE_GRADIENT[] PROGMEM = "Gradient@!,Spread;!,!;!;;ix=16";
+static constexpr char _data_FX_MODE_GRADIENT[] PROGMEM = "Gradient@!,Spread;!,!;!;;ix=16";
 
 
 /*
@@ -1427,7 +1430,7 @@ static const char _data_FX_MODE_GRADIENT[] PROGMEM = "Gradient@!,Spread;!,!;!;;i
 void mode_loading(void) {
   gradient_base(true);
 }
-static const char _data_FX_MODE_LOADING[] PROGMEM = "Loading@!,Fade;!,!;!;;ix=16";
+static constexpr char _data_FX_MODE_LOADING[] PROGMEM = "Loading@!,Fade;!,!;!;;ix=16";
 
 /*
  * Two dots running
@@ -1449,7 +1452,7 @@ void mode_two_dots() {
     SEGMENT.setPixelColor(indexB, color2);
   }
 }
-static const char _data_FX_MODE_TWO_DOTS[] PROGMEM = "Two Dots@!,Dot size,,,,,Overlay;1,2,Bg;!";
+static constexpr char _data_FX_MODE_TWO_DOTS[] PROGMEM = "Two Dots@!,Dot size,,,,,Overlay;1,2,Bg;!";
 
 
 /*
@@ -1535,7 +1538,7 @@ void mode_fairy() {
     }
   }
 }
-static const char _data_FX_MODE_FAIRY[] PROGMEM = "Fairy@!,# of flashers;!,!;!";
+static constexpr char _data_FX_MODE_FAIRY[] PROGMEM = "Fairy@!,# of flashers;!,!;!";
 
 
 /*
@@ -1584,7 +1587,7 @@ void mode_fairytwinkle() {
     SEGMENT.setPixelColor(f, color_blend(SEGCOLOR(1), SEGMENT.color_from_palette(PRNG16 >> 8, false, false, 0), flasherBri));
   }
 }
-static const char _data_FX_MODE_FAIRYTWINKLE[] PROGMEM = "Fairytwinkle@!,!;!,!;!;;m12=0"; //pixels
+static constexpr char _data_FX_MODE_FAIRYTWINKLE[] PROGMEM = "Fairytwinkle@!,!;!,!;!;;m12=0"; //pixels
 
 
 /*
@@ -1614,7 +1617,7 @@ void tricolor_chase(uint32_t color1, uint32_t color2) {
 void mode_tricolor_chase(void) {
   tricolor_chase(SEGCOLOR(2), SEGCOLOR(0));
 }
-static const char _data_FX_MODE_TRICOLOR_CHASE[] PROGMEM = "Chase 3@!,Size;1,2,3;!";
+static constexpr char _data_FX_MODE_TRICOLOR_CHASE[] PROGMEM = "Chase 3@!,Size;1,2,3;!";
 
 
 /*
@@ -1686,7 +1689,7 @@ void mode_icu(void) {
   // use upper bits of SEGENV.step to store current state, lower bits for next update time
   SEGENV.step = (state << 16) | nextUpdate;
 }
-static const char _data_FX_MODE_ICU[] PROGMEM = "ICU@!,!,,,,,Overlay;!,!;!";
+static constexpr char _data_FX_MODE_ICU[] PROGMEM = "ICU@!,!,,,,,Overlay;!,!;!";
 
 
 /*
@@ -1724,7 +1727,7 @@ void mode_tricolor_wipe(void) {
     }
   }
 }
-static const char _data_FX_MODE_TRICOLOR_WIPE[] PROGMEM = "Tri Wipe@!;1,2,3;!";
+static constexpr char _data_FX_MODE_TRICOLOR_WIPE[] PROGMEM = "Tri Wipe@!;1,2,3;!";
 
 
 /*
@@ -1766,7 +1769,7 @@ void mode_tricolor_fade(void) {
     SEGMENT.setPixelColor(i, color);
   }
 }
-static const char _data_FX_MODE_TRICOLOR_FADE[] PROGMEM = "Tri Fade@!;1,2,3;!";
+static constexpr char _data_FX_MODE_TRICOLOR_FADE[] PROGMEM = "Tri Fade@!;1,2,3;!";
 
 /*
  * Creates random comets
@@ -1803,7 +1806,7 @@ void mode_multi_comet(void) {
 
   SEGENV.step = it;
 }
-static const char _data_FX_MODE_MULTI_COMET[] PROGMEM = "Multi Comet@!,Fade;!,!;!;1";
+static constexpr char _data_FX_MODE_MULTI_COMET[] PROGMEM = "Multi Comet@!,Fade;!,!;!;1";
 #undef MAX_COMETS
 
 /*
@@ -1837,7 +1840,7 @@ void mode_random_chase(void) {
 
   prng.setSeed(prevSeed); // restore original seed so other effects can use "random" PRNG
 }
-static const char _data_FX_MODE_RANDOM_CHASE[] PROGMEM = "Stream 2@!;;";
+static constexpr char _data_FX_MODE_RANDOM_CHASE[] PROGMEM = "Stream 2@!;;";
 
 
 //7 bytes
@@ -1898,7 +1901,7 @@ void mode_oscillate(void) {
 
   SEGENV.step = it;
 }
-static const char _data_FX_MODE_OSCILLATE[] PROGMEM = "Oscillate";
+static constexpr char _data_FX_MODE_OSCILLATE[] PROGMEM = "Oscillate";
 
 
 void mode_lightning(void) {
@@ -1940,7 +1943,7 @@ void mode_lightning(void) {
     }
   }
 }
-static const char _data_FX_MODE_LIGHTNING[] PROGMEM = "Lightning@!,!,,,,,Overlay;!,!;!";
+static constexpr char _data_FX_MODE_LIGHTNING[] PROGMEM = "Lightning@!,!,,,,,Overlay;!,!;!";
 
 // combined function from original pride and colorwaves
 void mode_colorwaves_pride_base(bool isPride2015) {
@@ -1997,7 +2000,7 @@ void mode_colorwaves_pride_base(bool isPride2015) {
 void mode_pride_2015(void) {
   mode_colorwaves_pride_base(true);
 }
-static const char _data_FX_MODE_PRIDE_2015[] PROGMEM = "Pride 2015@!;;";
+static constexpr char _data_FX_MODE_PRIDE_2015[] PROGMEM = "Pride 2015@!;;";
 
 // ColorWavesWithPalettes by Mark Kriegsman: https://gist.github.com/kriegsman/8281905786e8b2632aeb
 // This function draws color waves with an ever-changing,
@@ -2005,7 +2008,7 @@ static const char _data_FX_MODE_PRIDE_2015[] PROGMEM = "Pride 2015@!;;";
 void mode_colorwaves() {
   mode_colorwaves_pride_base(false);
 }
-static const char _data_FX_MODE_COLORWAVES[] PROGMEM = "Colorwaves@!,Hue;!;!;;pal=26";
+static constexpr char _data_FX_MODE_COLORWAVES[] PROGMEM = "Colorwaves@!,Hue;!;!;;pal=26";
 
 
 //eight colored dots, weaving in and out of sync with each other
@@ -2023,7 +2026,7 @@ void mode_juggle(void) {
     dothue += 32;
   }
 }
-static const char _data_FX_MODE_JUGGLE[] PROGMEM = "Juggle@!,Trail;;!;;sx=64,ix=128";
+static constexpr char _data_FX_MODE_JUGGLE[] PROGMEM = "Juggle@!,Trail;;!;;sx=64,ix=128";
 
 
 void mode_palette() {
@@ -2121,7 +2124,7 @@ void mode_palette() {
     }
   }
 }
-static const char _data_FX_MODE_PALETTE[] PROGMEM = "Palette@Shift,Size,Rotation,,,Animate Shift,Animate Rotation,Anamorphic;;!;12;ix=112,c1=0,o1=1,o2=0,o3=1";
+static constexpr char _data_FX_MODE_PALETTE[] PROGMEM = "Palette@Shift,Size,Rotation,,,Animate Shift,Animate Rotation,Anamorphic;;!;12;ix=112,c1=0,o1=1,o2=0,o3=1";
 
 #if defined(WLED_PS_DONT_REPLACE_1D_FX) || defined(WLED_PS_DONT_REPLACE_2D_FX)
 // WLED limitation: Analog Clock overlay will NOT work when Fire2012 is active
@@ -2207,7 +2210,7 @@ void mode_fire_2012() {
   if (it != SEGENV.step)
     SEGENV.step = it;
 }
-static const char _data_FX_MODE_FIRE_2012[] PROGMEM = "Fire 2012@Cooling,Spark rate,,2D Blur,Boost;;!;1;pal=35,sx=64,ix=160,m12=1,c2=128"; // bars
+static constexpr char _data_FX_MODE_FIRE_2012[] PROGMEM = "Fire 2012@Cooling,Spark rate,,2D Blur,Boost;;!;1;pal=35,sx=64,ix=160,m12=1,c2=128"; // bars
 #endif // WLED_PS_DONT_REPLACE_x_FX
 
 // colored stripes pulsing at a defined Beats-Per-Minute (BPM)
@@ -2218,7 +2221,7 @@ void mode_bpm() {
     SEGMENT.setPixelColor(i, SEGMENT.color_from_palette(stp + (i * 2), false, PALETTE_SOLID_WRAP, 0, beat - stp + (i * 10)));
   }
 }
-static const char _data_FX_MODE_BPM[] PROGMEM = "Bpm@!;!;!;;sx=64";
+static constexpr char _data_FX_MODE_BPM[] PROGMEM = "Bpm@!;!;!;;sx=64";
 
 
 void mode_fillnoise8() {
@@ -2229,7 +2232,7 @@ void mode_fillnoise8() {
   }
   SEGENV.step += beatsin8_t(SEGMENT.speed, 1, 6); //10,1,4
 }
-static const char _data_FX_MODE_FILLNOISE8[] PROGMEM = "Fill Noise@!;!;!";
+static constexpr char _data_FX_MODE_FILLNOISE8[] PROGMEM = "Fill Noise@!;!;!";
 
 
 void mode_noise16_1() {
@@ -2248,7 +2251,7 @@ void mode_noise16_1() {
     SEGMENT.setPixelColor(i, SEGMENT.color_from_palette(index, false, PALETTE_SOLID_WRAP, 0));
   }
 }
-static const char _data_FX_MODE_NOISE16_1[] PROGMEM = "Noise 1@!;!;!;;pal=20";
+static constexpr char _data_FX_MODE_NOISE16_1[] PROGMEM = "Noise 1@!;!;!;;pal=20";
 
 
 void mode_noise16_2() {
@@ -2264,7 +2267,7 @@ void mode_noise16_2() {
     SEGMENT.setPixelColor(i, SEGMENT.color_from_palette(index, false, PALETTE_SOLID_WRAP, 0, noise));
   }
 }
-static const char _data_FX_MODE_NOISE16_2[] PROGMEM = "Noise 2@!;!;!;;pal=43";
+static constexpr char _data_FX_MODE_NOISE16_2[] PROGMEM = "Noise 2@!;!;!;;pal=43";
 
 
 void mode_noise16_3() {
@@ -2283,7 +2286,7 @@ void mode_noise16_3() {
     SEGMENT.setPixelColor(i, SEGMENT.color_from_palette(index, false, PALETTE_SOLID_WRAP, 0, noise));
   }
 }
-static const char _data_FX_MODE_NOISE16_3[] PROGMEM = "Noise 3@!;!;!;;pal=35";
+static constexpr char _data_FX_MODE_NOISE16_3[] PROGMEM = "Noise 3@!;!;!;;pal=35";
 
 
 //https://github.com/aykevl/ledstrip-spark/blob/master/ledstrip.ino
@@ -2294,7 +2297,7 @@ void mode_noise16_4() {
     SEGMENT.setPixelColor(i, SEGMENT.color_from_palette(index, false, PALETTE_SOLID_WRAP, 0));
   }
 }
-static const char _data_FX_MODE_NOISE16_4[] PROGMEM = "Noise 4@!;!;!;;pal=26";
+static constexpr char _data_FX_MODE_NOISE16_4[] PROGMEM = "Noise 4@!;!;!;;pal=26";
 
 
 //based on https://gist.github.com/kriegsman/5408ecd397744ba0393e
@@ -2350,7 +2353,7 @@ void mode_colortwinkle() {
     }
   }
 }
-static const char _data_FX_MODE_COLORTWINKLE[] PROGMEM = "Colortwinkles@Fade speed,Spawn speed;;!;;m12=0"; //pixels
+static constexpr char _data_FX_MODE_COLORTWINKLE[] PROGMEM = "Colortwinkles@Fade speed,Spawn speed;;!;;m12=0"; //pixels
 
 
 //Calm effect, like a lake at night
@@ -2367,7 +2370,7 @@ void mode_lake() {
     SEGMENT.setPixelColor(i, SEGMENT.color_from_palette(index, false, false, 0, lum));
   }
 }
-static const char _data_FX_MODE_LAKE[] PROGMEM = "Lake@!;Fx;!";
+static constexpr char _data_FX_MODE_LAKE[] PROGMEM = "Lake@!;Fx;!";
 
 
 // meteor effect & meteor smooth (merged by @dedehai)
@@ -2437,7 +2440,7 @@ void mode_meteor() {
 
   SEGENV.step += SEGMENT.speed +1;
 }
-static const char _data_FX_MODE_METEOR[] PROGMEM = "Meteor@!,Trail,,,,Gradient,,Smooth;;!;1";
+static constexpr char _data_FX_MODE_METEOR[] PROGMEM = "Meteor@!,Trail,,,,Gradient,,Smooth;;!;1";
 
 
 //Railway Crossing / Christmas Fairy lights
@@ -2468,7 +2471,7 @@ void mode_railway() {
   }
   SEGENV.step += FRAMETIME;
 }
-static const char _data_FX_MODE_RAILWAY[] PROGMEM = "Railway@!,Smoothness;1,2;!;;pal=3";
+static constexpr char _data_FX_MODE_RAILWAY[] PROGMEM = "Railway@!,Smoothness;1,2;!;;pal=3";
 
 
 //Water ripple
@@ -2549,7 +2552,7 @@ void mode_ripple(void) {
 
   ripple_base(SEGMENT.custom1>>1);
 }
-static const char _data_FX_MODE_RIPPLE[] PROGMEM = "Ripple@!,Wave #,Blur,,,,Overlay;,!;!;12;c1=0";
+static constexpr char _data_FX_MODE_RIPPLE[] PROGMEM = "Ripple@!,Wave #,Blur,,,,Overlay;,!;!;12;c1=0";
 
 
 void mode_ripple_rainbow(void) {
@@ -2568,7 +2571,7 @@ void mode_ripple_rainbow(void) {
   SEGMENT.fill(color_blend(SEGMENT.color_wheel(SEGENV.aux0),BLACK,uint8_t(235)));
   ripple_base();
 }
-static const char _data_FX_MODE_RIPPLE_RAINBOW[] PROGMEM = "Ripple Rainbow@!,Wave #;;!;12";
+static constexpr char _data_FX_MODE_RIPPLE_RAINBOW[] PROGMEM = "Ripple Rainbow@!,Wave #;;!;12";
 
 
 //  TwinkleFOX by Mark Kriegsman: https://gist.github.com/kriegsman/756ea6dcae8e30845b5a
@@ -2700,14 +2703,14 @@ void mode_twinklefox()
 {
   twinklefox_base(false);
 }
-static const char _data_FX_MODE_TWINKLEFOX[] PROGMEM = "Twinklefox@!,Twinkle rate,,,,Cool;!,!;!";
+static constexpr char _data_FX_MODE_TWINKLEFOX[] PROGMEM = "Twinklefox@!,Twinkle rate,,,,Cool;!,!;!";
 
 
 void mode_twinklecat()
 {
   twinklefox_base(true);
 }
-static const char _data_FX_MODE_TWINKLECAT[] PROGMEM = "Twinklecat@!,Twinkle rate,,,,Cool,Reverse;!,!;!";
+static constexpr char _data_FX_MODE_TWINKLECAT[] PROGMEM = "Twinklecat@!,Twinkle rate,,,,Cool,Reverse;!,!;!";
 
 
 void mode_halloween_eyes()
@@ -2862,7 +2865,7 @@ void mode_halloween_eyes()
     data.startTime = strip.now;
   }
 }
-static const char _data_FX_MODE_HALLOWEEN_EYES[] PROGMEM = "Halloween Eyes@Eye off time,Eye on time,,,,,Overlay;!,!;!;12";
+static constexpr char _data_FX_MODE_HALLOWEEN_EYES[] PROGMEM = "Halloween Eyes@Eye off time,Eye on time,,,,,Overlay;!,!;!;12";
 
 
 //Speed slider sets amount of LEDs lit, intensity sets unlit
@@ -2882,7 +2885,7 @@ void mode_static_pattern()
     }
   }
 }
-static const char _data_FX_MODE_STATIC_PATTERN[] PROGMEM = "Solid Pattern@Fg size,Bg size;Fg,!;!;;pal=0";
+static constexpr char _data_FX_MODE_STATIC_PATTERN[] PROGMEM = "Solid Pattern@Fg size,Bg size;Fg,!;!;;pal=0";
 
 
 void mode_tri_static_pattern()
@@ -2906,7 +2909,7 @@ void mode_tri_static_pattern()
     }
   }
 }
-static const char _data_FX_MODE_TRI_STATIC_PATTERN[] PROGMEM = "Solid Pattern Tri@,Size;1,2,3;;;pal=0";
+static constexpr char _data_FX_MODE_TRI_STATIC_PATTERN[] PROGMEM = "Solid Pattern Tri@,Size;1,2,3;;;pal=0";
 
 
 static void spots_base(uint16_t threshold)
@@ -2940,7 +2943,7 @@ void mode_spots()
 {
   spots_base((255 - SEGMENT.speed) << 8);
 }
-static const char _data_FX_MODE_SPOTS[] PROGMEM = "Spots@Spread,Width,,,,,Overlay;!,!;!";
+static constexpr char _data_FX_MODE_SPOTS[] PROGMEM = "Spots@Spread,Width,,,,,Overlay;!,!;!";
 
 
 //Intensity slider sets number of "lights", LEDs per light fade in and out
@@ -2951,7 +2954,7 @@ void mode_spots_fade()
   unsigned tr = (t >> 1) + (t >> 2);
   spots_base(tr);
 }
-static const char _data_FX_MODE_SPOTS_FADE[] PROGMEM = "Spots Fade@Spread,Width,,,,,Overlay;!,!;!";
+static constexpr char _data_FX_MODE_SPOTS_FADE[] PROGMEM = "Spots Fade@Spread,Width,,,,,Overlay;!,!;!";
 
 //each needs 12 bytes
 typedef struct Ball {
@@ -3032,7 +3035,7 @@ void mode_bouncing_balls(void) {
   for (unsigned stripNr=0; stripNr<strips; stripNr++)
     virtualStrip::runStrip(stripNr, &balls[stripNr * maxNumBalls]);
 }
-static const char _data_FX_MODE_BOUNCINGBALLS[] PROGMEM = "Bouncing Balls@Gravity,# of balls,,,,,Overlay;!,!,!;!;1;m12=1"; //bar
+static constexpr char _data_FX_MODE_BOUNCINGBALLS[] PROGMEM = "Bouncing Balls@Gravity,# of balls,,,,,Overlay;!,!,!;!;1;m12=1"; //bar
 
 #ifdef WLED_PS_DONT_REPLACE_1D_FX
 /*
@@ -3131,7 +3134,7 @@ static void mode_rolling_balls(void) {
     balls[i].height = thisHeight;
   }
 }
-static const char _data_FX_MODE_ROLLINGBALLS[] PROGMEM = "Rolling Balls@!,# of balls,,,,Collide,Overlay,Trails;!,!,!;!;1;m12=1"; //bar
+static constexpr char _data_FX_MODE_ROLLINGBALLS[] PROGMEM = "Rolling Balls@!,# of balls,,,,Collide,Overlay,Trails;!,!,!;!;1;m12=1"; //bar
 #endif // WLED_PS_DONT_REPLACE_1D_FX
 
 
@@ -3326,7 +3329,7 @@ static void mode_pacman(void) {
 
   SEGMENT.blur(SEGMENT.custom2>>1);
 }
-static const char _data_FX_MODE_PACMAN[] PROGMEM = "PacMan@Speed,# of PowerDots,Blink distance,Blur,# of Ghosts,Dots,Smear,Compact;;!;1;m12=0,sx=192,ix=64,c1=64,c2=0,c3=12,o1=1,o2=0";
+static constexpr char _data_FX_MODE_PACMAN[] PROGMEM = "PacMan@Speed,# of PowerDots,Blink distance,Blur,# of Ghosts,Dots,Smear,Compact;;!;1;m12=0,sx=192,ix=64,c1=64,c2=0,c3=12,o1=1,o2=0";
 
 
 /*
@@ -3368,19 +3371,19 @@ static void sinelon_base(bool dual, bool rainbow=false) {
 void mode_sinelon(void) {
   sinelon_base(false);
 }
-static const char _data_FX_MODE_SINELON[] PROGMEM = "Sinelon@!,Trail;!,!,!;!";
+static constexpr char _data_FX_MODE_SINELON[] PROGMEM = "Sinelon@!,Trail;!,!,!;!";
 
 
 void mode_sinelon_dual(void) {
   sinelon_base(true);
 }
-static const char _data_FX_MODE_SINELON_DUAL[] PROGMEM = "Sinelon Dual@!,Trail;!,!,!;!";
+static constexpr char _data_FX_MODE_SINELON_DUAL[] PROGMEM = "Sinelon Dual@!,Trail;!,!,!;!";
 
 
 void mode_sinelon_rainbow(void) {
   sinelon_base(false, true);
 }
-static const char _data_FX_MODE_SINELON_RAINBOW[] PROGMEM = "Sinelon Rainbow@!,Trail;,,!;!";
+static constexpr char _data_FX_MODE_SINELON_RAINBOW[] PROGMEM = "Sinelon Rainbow@!,Trail;,,!;!";
 
 // utility function that will add random glitter to SEGMENT
 void glitter_base(uint8_t intensity, uint32_t col = ULTRAWHITE) {
@@ -3406,7 +3409,7 @@ void mode_glitter()
   }
   glitter_base(SEGMENT.intensity, SEGCOLOR(2) ? SEGCOLOR(2) : ULTRAWHITE);
 }
-static const char _data_FX_MODE_GLITTER[] PROGMEM = "Glitter@!,!,,,,,Overlay;,,Glitter color;!;;pal=11,m12=0"; //pixels
+static constexpr char _data_FX_MODE_GLITTER[] PROGMEM = "Glitter@!,!,,,,,Overlay;,,Glitter color;!;;pal=11,m12=0"; //pixels
 
 
 //Solid colour background with glitter (can be replaced by Glitter)
@@ -3415,7 +3418,7 @@ void mode_solid_glitter()
   SEGMENT.fill(SEGCOLOR(0));
   glitter_base(SEGMENT.intensity, SEGCOLOR(2) ? SEGCOLOR(2) : ULTRAWHITE);
 }
-static const char _data_FX_MODE_SOLID_GLITTER[] PROGMEM = "Solid Glitter@,!;Bg,,Glitter color;;;m12=0";
+static constexpr char _data_FX_MODE_SOLID_GLITTER[] PROGMEM = "Solid Glitter@,!;Bg,,Glitter color;;;m12=0";
 
 //each needs 20 bytes
 //Spark type is used for popcorn, 1D fireworks, and drip
@@ -3488,7 +3491,7 @@ void mode_popcorn(void) {
   for (unsigned stripNr=0; stripNr<strips; stripNr++)
     virtualStrip::runStrip(stripNr, &popcorn[stripNr * usablePopcorns], usablePopcorns);
 }
-static const char _data_FX_MODE_POPCORN[] PROGMEM = "Popcorn@!,!,,,,,Overlay;!,!,!;!;;m12=1"; //bar
+static constexpr char _data_FX_MODE_POPCORN[] PROGMEM = "Popcorn@!,!,,,,,Overlay;!,!,!;!;;m12=1"; //bar
 
 //values close to 100 produce 5Hz flicker, which looks very candle-y
 //Inspired by https://github.com/avanhanegem/ArduinoCandleEffectNeoPixel
@@ -3579,14 +3582,14 @@ void mode_candle()
 {
   candle(false);
 }
-static const char _data_FX_MODE_CANDLE[] PROGMEM = "Candle@!,!;!,!;!;01;sx=96,ix=224,pal=0";
+static constexpr char _data_FX_MODE_CANDLE[] PROGMEM = "Candle@!,!;!,!;!;01;sx=96,ix=224,pal=0";
 
 
 void mode_candle_multi()
 {
   candle(true);
 }
-static const char _data_FX_MODE_CANDLE_MULTI[] PROGMEM = "Candle Multi@!,!;!,!;!;;sx=96,ix=224,pal=0";
+static constexpr char _data_FX_MODE_CANDLE_MULTI[] PROGMEM = "Candle Multi@!,!;!,!;!;;sx=96,ix=224,pal=0";
 
 #ifdef WLED_PS_DONT_REPLACE_1D_FX
 /*
@@ -3718,7 +3721,7 @@ void mode_starburst(void) {
   }
 }
 #undef STARBURST_MAX_FRAG
-static const char _data_FX_MODE_STARBURST[] PROGMEM = "Fireworks Starburst@Chance,Fragments,,,,,Overlay;,!;!;;pal=11,m12=0";
+static constexpr char _data_FX_MODE_STARBURST[] PROGMEM = "Fireworks Starburst@Chance,Fragments,,,,,Overlay;,!;!;;pal=11,m12=0";
 #endif // WLED_PS_DONT_REPLACE_1DFX
 
 #if defined(WLED_PS_DONT_REPLACE_1D_FX) || defined(WLED_PS_DONT_REPLACE_2D_FX)
@@ -3856,7 +3859,7 @@ void mode_exploding_fireworks(void)
   }
 }
 #undef MAX_SPARKS
-static const char _data_FX_MODE_EXPLODING_FIREWORKS[] PROGMEM = "Fireworks 1D@Gravity,Firing side;!,!;!;12;pal=11,ix=128";
+static constexpr char _data_FX_MODE_EXPLODING_FIREWORKS[] PROGMEM = "Fireworks 1D@Gravity,Firing side;!,!;!;12;pal=11,ix=128";
 #endif // WLED_PS_DONT_REPLACE_x_FX
 
 /*
@@ -3941,7 +3944,7 @@ void mode_drip(void)
   for (unsigned stripNr=0; stripNr<strips; stripNr++)
     virtualStrip::runStrip(stripNr, &drops[stripNr*maxNumDrops]);
 }
-static const char _data_FX_MODE_DRIP[] PROGMEM = "Drip@Gravity,# of drips,,,,,Overlay;!,!;!;;m12=1"; //bar
+static constexpr char _data_FX_MODE_DRIP[] PROGMEM = "Drip@Gravity,# of drips,,,,,Overlay;!,!;!;;m12=1"; //bar
 
 /*
  * Tetris or Stacking (falling bricks) Effect
@@ -4029,7 +4032,7 @@ void mode_tetrix(void) {
   for (unsigned stripNr=0; stripNr<strips; stripNr++)
     virtualStrip::runStrip(stripNr, &drops[stripNr]);
 }
-static const char _data_FX_MODE_TETRIX[] PROGMEM = "Tetrix@!,Width,,,,One color;!,!;!;;sx=0,ix=0,pal=11,m12=1";
+static constexpr char _data_FX_MODE_TETRIX[] PROGMEM = "Tetrix@!,Width,,,,One color;!,!;!;;sx=0,ix=0,pal=11,m12=1";
 
 
 /*
@@ -4051,7 +4054,7 @@ void mode_plasma(void) {
     SEGMENT.setPixelColor(i, SEGMENT.color_from_palette(colorIndex, false, PALETTE_SOLID_WRAP, 0, thisBright));
   }
 }
-static const char _data_FX_MODE_PLASMA[] PROGMEM = "Plasma@Phase,!;!;!";
+static constexpr char _data_FX_MODE_PLASMA[] PROGMEM = "Plasma@Phase,!;!;!";
 
 
 /*
@@ -4102,7 +4105,7 @@ void mode_percent(void) {
     if (SEGENV.aux1 < active_leds) SEGENV.aux1 = active_leds;
   }
 }
-static const char _data_FX_MODE_PERCENT[] PROGMEM = "Percent@!,% of fill,,,,One color;!,!;!";
+static constexpr char _data_FX_MODE_PERCENT[] PROGMEM = "Percent@!,% of fill,,,,One color;!,!;!";
 
 
 /*
@@ -4133,7 +4136,7 @@ void mode_heartbeat(void) {
     SEGMENT.setPixelColor(i, color_blend(SEGMENT.color_from_palette(i, true, PALETTE_SOLID_WRAP, 0), SEGCOLOR(1), uint8_t(255 - (SEGENV.aux1 >> 8))));
   }
 }
-static const char _data_FX_MODE_HEARTBEAT[] PROGMEM = "Heartbeat@!,!;!,!;!;01;m12=1";
+static constexpr char _data_FX_MODE_HEARTBEAT[] PROGMEM = "Heartbeat@!,!;!,!;!;01;m12=1";
 
 
 //  "Pacifica"
@@ -4249,7 +4252,7 @@ void mode_pacifica()
 
   strip.now = nowOld;
 }
-static const char _data_FX_MODE_PACIFICA[] PROGMEM = "Pacifica@!,Angle;;!;;pal=51";
+static constexpr char _data_FX_MODE_PACIFICA[] PROGMEM = "Pacifica@!,Angle;;!;;pal=51";
 
 
 /*
@@ -4298,7 +4301,7 @@ void mode_sunrise() {
     SEGMENT.setPixelColor(SEGLEN - i - 1, c);
   }
 }
-static const char _data_FX_MODE_SUNRISE[] PROGMEM = "Sunrise@Time [min],Width;;!;;pal=35,sx=60";
+static constexpr char _data_FX_MODE_SUNRISE[] PROGMEM = "Sunrise@Time [min],Width;;!;;pal=35,sx=60";
 
 
 /*
@@ -4331,13 +4334,13 @@ static void phased_base(uint8_t moder) {                  // We're making sine w
 void mode_phased(void) {
   phased_base(0);
 }
-static const char _data_FX_MODE_PHASED[] PROGMEM = "Phased@!,!;!,!;!";
+static constexpr char _data_FX_MODE_PHASED[] PROGMEM = "Phased@!,!;!,!;!";
 
 
 void mode_phased_noise(void) {
   phased_base(1);
 }
-static const char _data_FX_MODE_PHASEDNOISE[] PROGMEM = "Phased Noise@!,!;!,!;!";
+static constexpr char _data_FX_MODE_PHASEDNOISE[] PROGMEM = "Phased Noise@!,!;!,!;!";
 
 
 void mode_twinkleup(void) {                     // A very short twinkle routine with fade-in and dual controls. By Andrew Tuline.
@@ -4353,7 +4356,7 @@ void mode_twinkleup(void) {                     // A very short twinkle routine
 
   prng.setSeed(prevSeed);                       // restore original seed so other effects can use "random" PRNG
 }
-static const char _data_FX_MODE_TWINKLEUP[] PROGMEM = "Twinkleup@!,Intensity;!,!;!;;m12=0";
+static constexpr char _data_FX_MODE_TWINKLEUP[] PROGMEM = "Twinkleup@!,Intensity;!,!;!;;m12=0";
 
 
 // Peaceful noise that's slow and with gradually changing palettes. Does not support WLED palettes or default colours or controls.
@@ -4388,7 +4391,7 @@ void mode_noisepal(void) {                                    // Slow noise pale
 
   SEGENV.aux0 += beatsin8_t(10,1,4);                                        // Moving along the distance. Vary it a bit with a sine wave.
 }
-static const char _data_FX_MODE_NOISEPAL[] PROGMEM = "Noise Pal@!,Scale;;!";
+static constexpr char _data_FX_MODE_NOISEPAL[] PROGMEM = "Noise Pal@!,Scale;;!";
 
 
 // Sine waves that have controllable phase change speed, frequency and cutoff. By Andrew Tuline.
@@ -4408,7 +4411,7 @@ void mode_sinewave(void) {             // Adjustable sinewave. By Andrew Tuline
     SEGMENT.setPixelColor(i, color_blend(SEGCOLOR(1), SEGMENT.color_from_palette(i*colorIndex/255, false, PALETTE_SOLID_WRAP, 0), pixBri));
   }
 }
-static const char _data_FX_MODE_SINEWAVE[] PROGMEM = "Sine@!,Scale;;!";
+static constexpr char _data_FX_MODE_SINEWAVE[] PROGMEM = "Sine@!,Scale;;!";
 
 
 /*
@@ -4444,7 +4447,7 @@ void mode_flow(void)
     }
   }
 }
-static const char _data_FX_MODE_FLOW[] PROGMEM = "Flow@!,Zones;;!;;m12=1"; //vertical
+static constexpr char _data_FX_MODE_FLOW[] PROGMEM = "Flow@!,Zones;;!;;m12=1"; //vertical
 
 
 /*
@@ -4468,7 +4471,7 @@ void mode_chunchun(void)
     SEGMENT.setPixelColor(bird, SEGMENT.color_from_palette((i * 255)/ numBirds, false, false, 0)); // no palette wrapping
   }
 }
-static const char _data_FX_MODE_CHUNCHUN[] PROGMEM = "Chunchun@!,Gap size;!,!;!";
+static constexpr char _data_FX_MODE_CHUNCHUN[] PROGMEM = "Chunchun@!,Gap size;!,!;!";
 
 #define SPOT_TYPE_SOLID       0
 #define SPOT_TYPE_GRADIENT    1
@@ -4614,7 +4617,7 @@ void mode_dancing_shadows(void)
     }
   }
 }
-static const char _data_FX_MODE_DANCING_SHADOWS[] PROGMEM = "Dancing Shadows@!,# of shadows;!;!";
+static constexpr char _data_FX_MODE_DANCING_SHADOWS[] PROGMEM = "Dancing Shadows@!,# of shadows;!;!";
 #endif // WLED_PS_DONT_REPLACE_1D_FX
 
 /*
@@ -4631,7 +4634,7 @@ void mode_washing_machine(void) {
     SEGMENT.setPixelColor(i, SEGMENT.color_from_palette(col, false, PALETTE_SOLID_WRAP, 3));
   }
 }
-static const char _data_FX_MODE_WASHING_MACHINE[] PROGMEM = "Washing Machine@!,!;;!";
+static constexpr char _data_FX_MODE_WASHING_MACHINE[] PROGMEM = "Washing Machine@!,!;;!";
 
 
 /*
@@ -4649,7 +4652,7 @@ void mode_image(void) {
   //   Serial.println(status);
   // }
 }
-static const char _data_FX_MODE_IMAGE[] PROGMEM = "Image@!,Blur,;;;12;sx=128,ix=0";
+static constexpr char _data_FX_MODE_IMAGE[] PROGMEM = "Image@!,Blur,;;;12;sx=128,ix=0";
 
 /*
   Blends random colors across palette
@@ -4674,7 +4677,7 @@ void mode_blends(void) {
     if (offset >= pixelLen) offset = 0;
   }
 }
-static const char _data_FX_MODE_BLENDS[] PROGMEM = "Blends@Shift speed,Blend speed;;!";
+static constexpr char _data_FX_MODE_BLENDS[] PROGMEM = "Blends@Shift speed,Blend speed;;!";
 
 
 /*
@@ -4801,7 +4804,7 @@ void mode_tv_simulator(void) {
     SEGENV.aux0 = 0;
   }
 }
-static const char _data_FX_MODE_TV_SIMULATOR[] PROGMEM = "TV Simulator@!,!;;!;01";
+static constexpr char _data_FX_MODE_TV_SIMULATOR[] PROGMEM = "TV Simulator@!,!;;!;01";
 
 
 /*
@@ -4948,7 +4951,7 @@ void mode_aurora(void) {
     SEGMENT.setPixelColor(i, mixedRgb);
   }
 }
-static const char _data_FX_MODE_AURORA[] PROGMEM = "Aurora@!,!;1,2,3;!;;sx=24,pal=50";
+static constexpr char _data_FX_MODE_AURORA[] PROGMEM = "Aurora@!,!;1,2,3;!;;sx=24,pal=50";
 
 
 /** Softly floating colorful clouds.
@@ -5022,7 +5025,7 @@ void mode_ColorClouds()
     SEGMENT.setPixelColor(i, pixel);
   }
 }
-static const char _data_FX_MODE_COLORCLOUDS[] PROGMEM = "Color Clouds@!,!,Clouds,Colors,Distance,,,Cozy;;!;;sx=24,ix=32,c1=48,c2=64,c3=12,pal=0";
+static constexpr char _data_FX_MODE_COLORCLOUDS[] PROGMEM = "Color Clouds@!,!,Clouds,Colors,Distance,,,Cozy;;!;;sx=24,ix=32,c1=48,c2=64,c3=12,pal=0";
 
 
 // WLED-SR effects
@@ -5041,7 +5044,7 @@ void mode_perlinmove(void) {
     SEGMENT.setPixelColor(pixloc, SEGMENT.color_from_palette(pixloc%255, false, PALETTE_SOLID_WRAP, 0));
   }
 } // mode_perlinmove()
-static const char _data_FX_MODE_PERLINMOVE[] PROGMEM = "Perlin Move@!,# of pixels,Fade rate;!,!;!";
+static constexpr char _data_FX_MODE_PERLINMOVE[] PROGMEM = "Perlin Move@!,# of pixels,Fade rate;!,!;!";
 
 
 /////////////////////////
@@ -5057,7 +5060,7 @@ void mode_wavesins(void) {
     SEGMENT.setPixelColor(i, SEGMENT.color_from_palette(index, false, PALETTE_SOLID_WRAP, 0, bri));
   }
 } // mode_waveins()
-static const char _data_FX_MODE_WAVESINS[] PROGMEM = "Wavesins@!,Brightness variation,Starting color,Range of colors,Color variation;!;!";
+static constexpr char _data_FX_MODE_WAVESINS[] PROGMEM = "Wavesins@!,Brightness variation,Starting color,Range of colors,Color variation;!;!";
 
 
 //////////////////////////////
@@ -5078,7 +5081,7 @@ void mode_FlowStripe(void) {
     SEGMENT.setPixelColor(i, SEGMENT.color_from_palette(b + hue, false, true, 3));
   }
 } // mode_FlowStripe()
-static const char _data_FX_MODE_FLOWSTRIPE[] PROGMEM = "Flow Stripe@Hue speed,Effect speed;;!;pal=11";
+static constexpr char _data_FX_MODE_FLOWSTRIPE[] PROGMEM = "Flow Stripe@Hue speed,Effect speed;;!;;pal=11";
 
 /*
   Shimmer effect: moves a gradient with optional modulators across the strip at a given interval, up to 60 seconds
@@ -5149,7 +5152,7 @@ void mode_shimmer() {
     }
   }
 }
-static const char _data_FX_MODE_SHIMMER[] PROGMEM = "Shimmer@Speed,Interval,Size,Granular,Flow,Zebra,Reverse,Sporadic;Fx,Bg,Cx;!;1;pal=15,sx=220,ix=10,c2=0,c3=0";
+static constexpr char _data_FX_MODE_SHIMMER[] PROGMEM = "Shimmer@Speed,Interval,Size,Granular,Flow,Zebra,Reverse,Sporadic;Fx,Bg,Cx;!;1;pal=15,sx=220,ix=10,c2=0,c3=0";
 
 #ifndef WLED_DISABLE_2D
 ///////////////////////////////////////////////////////////////////////////////
@@ -5183,7 +5186,7 @@ void mode_2DBlackHole(void) {            // By: Stepko https://editor.soulmateli
   // blur everything a bit
   if (SEGMENT.check3) SEGMENT.blur(16, cols*rows < 100);
 } // mode_2DBlackHole()
-static const char _data_FX_MODE_2DBLACKHOLE[] PROGMEM = "Black Hole@Fade rate,Outer Y freq.,Outer X freq.,Inner X freq.,Inner Y freq.,Solid,,Blur;!;!;2;pal=11";
+static constexpr char _data_FX_MODE_2DBLACKHOLE[] PROGMEM = "Black Hole@Fade rate,Outer Y freq.,Outer X freq.,Inner X freq.,Inner Y freq.,Solid,,Blur;!;!;2;pal=11";
 
 
 ////////////////////////////
@@ -5233,7 +5236,7 @@ void mode_2DColoredBursts() {              // By: ldirko   https://editor.soulma
   }
   SEGMENT.blur(SEGMENT.custom3>>1, SEGMENT.check2);
 } // mode_2DColoredBursts()
-static const char _data_FX_MODE_2DCOLOREDBURSTS[] PROGMEM = "Colored Bursts@Speed,# of lines,,,Blur,Gradient,Smear,Dots;;!;2;c3=16";
+static constexpr char _data_FX_MODE_2DCOLOREDBURSTS[] PROGMEM = "Colored Bursts@Speed,# of lines,,,Blur,Gradient,Smear,Dots;;!;2;c3=16";
 
 
 /////////////////////
@@ -5252,7 +5255,7 @@ void mode_2Ddna(void) {         // dna originally by by ldirko at https://pasteb
   }
   SEGMENT.blur(SEGMENT.intensity / (8 - (SEGMENT.check1 * 2)), SEGMENT.check1);
 } // mode_2Ddna()
-static const char _data_FX_MODE_2DDNA[] PROGMEM = "DNA@Scroll speed,Blur,,,,Smear;;!;2;ix=0";
+static constexpr char _data_FX_MODE_2DDNA[] PROGMEM = "DNA@Scroll speed,Blur,,,,Smear;;!;2;ix=0";
 
 /////////////////////////
 //     2D DNA Spiral   //
@@ -5297,7 +5300,7 @@ void mode_2DDNASpiral() {               // By: ldirko  https://editor.soulmateli
   }
   SEGMENT.blur(((uint16_t)SEGMENT.custom1 * 3) / (6 + SEGMENT.check1), SEGMENT.check1);
 } // mode_2DDNASpiral()
-static const char _data_FX_MODE_2DDNASPIRAL[] PROGMEM = "DNA Spiral@Scroll speed,Y frequency,Blur,,,Smear;;!;2;c1=0";
+static constexpr char _data_FX_MODE_2DDNASPIRAL[] PROGMEM = "DNA Spiral@Scroll speed,Y frequency,Blur,,,Smear;;!;2;c1=0";
 
 
 /////////////////////////
@@ -5325,7 +5328,7 @@ void mode_2DDrift() {              // By: Stepko   https://editor.soulmatelights
   }
   SEGMENT.blur(SEGMENT.intensity>>(3 - SEGMENT.check2), SEGMENT.check2);
 } // mode_2DDrift()
-static const char _data_FX_MODE_2DDRIFT[] PROGMEM = "Drift@Rotation speed,Blur,,,,Twin,Smear;;!;2;ix=0";
+static constexpr char _data_FX_MODE_2DDRIFT[] PROGMEM = "Drift@Rotation speed,Blur,,,,Twin,Smear;;!;2;ix=0";
 
 
 //////////////////////////
@@ -5356,7 +5359,7 @@ void mode_2Dfirenoise(void) {               // firenoise2d. By Andrew Tuline. Ye
     } // for i
   } // for j
 } // mode_2Dfirenoise()
-static const char _data_FX_MODE_2DFIRENOISE[] PROGMEM = "Firenoise@X scale,Y scale,,,,Palette;;!;2;pal=66";
+static constexpr char _data_FX_MODE_2DFIRENOISE[] PROGMEM = "Firenoise@X scale,Y scale,,,,Palette;;!;2;pal=66";
 
 
 //////////////////////////////
@@ -5376,7 +5379,7 @@ void mode_2DFrizzles(void) {                 // By: Stepko https://editor.soulma
   }
   SEGMENT.blur(SEGMENT.custom1 >> (3 + SEGMENT.check1), SEGMENT.check1);
 } // mode_2DFrizzles()
-static const char _data_FX_MODE_2DFRIZZLES[] PROGMEM = "Frizzles@X frequency,Y frequency,Blur,,,Smear;;!;2";
+static constexpr char _data_FX_MODE_2DFRIZZLES[] PROGMEM = "Frizzles@X frequency,Y frequency,Blur,,,Smear;;!;2";
 
 
 ///////////////////////////////////////////
@@ -5536,7 +5539,7 @@ void mode_2Dgameoflife(void) { // Written by Ewoud Wijma, inspired by https://na
     SEGENV.step = strip.now;
   }
 } // mode_2Dgameoflife()
-static const char _data_FX_MODE_2DGAMEOFLIFE[] PROGMEM = "Game Of Life@!,,Blur,,,,,Mutation;!,!;!;2;pal=11,sx=128";
+static constexpr char _data_FX_MODE_2DGAMEOFLIFE[] PROGMEM = "Game Of Life@!,,Blur,,,,,Mutation;!,!;!;2;pal=11,sx=128";
 
 
 /////////////////////////
@@ -5555,7 +5558,7 @@ void mode_2DHiphotic() {                        //  By: ldirko  https://editor.s
     }
   }
 } // mode_2DHiphotic()
-static const char _data_FX_MODE_2DHIPHOTIC[] PROGMEM = "Hiphotic@X scale,Y scale,,,Speed;!;!;2";
+static constexpr char _data_FX_MODE_2DHIPHOTIC[] PROGMEM = "Hiphotic@X scale,Y scale,,,Speed;!;!;2";
 
 
 /////////////////////////
@@ -5671,7 +5674,7 @@ void mode_2DJulia(void) {                           // An animated Julia set by
   if(SEGMENT.check1)
     SEGMENT.blur(100, true);
 } // mode_2DJulia()
-static const char _data_FX_MODE_2DJULIA[] PROGMEM = "Julia@,Max iterations per pixel,X center,Y center,Area size, Blur;!;!;2;ix=24,c1=128,c2=128,c3=16";
+static constexpr char _data_FX_MODE_2DJULIA[] PROGMEM = "Julia@,Max iterations per pixel,X center,Y center,Area size, Blur;!;!;2;ix=24,c1=128,c2=128,c3=16";
 
 
 //////////////////////////////
@@ -5698,7 +5701,7 @@ void mode_2DLissajous(void) {            // By: Andrew Tuline
   }
   SEGMENT.blur(SEGMENT.custom1 >> (1 + SEGMENT.check1 * 3), SEGMENT.check1);
 } // mode_2DLissajous()
-static const char _data_FX_MODE_2DLISSAJOUS[] PROGMEM = "Lissajous@X frequency,Fade rate,Blur,,Speed,Smear;!;!;2;c1=0";
+static constexpr char _data_FX_MODE_2DLISSAJOUS[] PROGMEM = "Lissajous@X frequency,Fade rate,Blur,,Speed,Smear;!;!;2;c1=0";
 
 
 ///////////////////////
@@ -5767,7 +5770,7 @@ void mode_2Dmatrix(void) {                  // Matrix2D. By Jeremy Williams. Ada
     }
   }
 } // mode_2Dmatrix()
-static const char _data_FX_MODE_2DMATRIX[] PROGMEM = "Matrix@!,Spawning rate,Trail,,,Custom color;Spawn,Trail;;2";
+static constexpr char _data_FX_MODE_2DMATRIX[] PROGMEM = "Matrix@!,Spawning rate,Trail,,,Custom color;Spawn,Trail;;2";
 
 
 /////////////////////////
@@ -5824,7 +5827,7 @@ void mode_2Dmetaballs(void) {   // Metaballs by Stefan Petrick. Cannot have one
     }
   }
 } // mode_2Dmetaballs()
-static const char _data_FX_MODE_2DMETABALLS[] PROGMEM = "Metaballs@!;;!;2";
+static constexpr char _data_FX_MODE_2DMETABALLS[] PROGMEM = "Metaballs@!;;!;2";
 
 
 //////////////////////
@@ -5845,7 +5848,7 @@ void mode_2Dnoise(void) {                  // By Andrew Tuline
     }
   }
 } // mode_2Dnoise()
-static const char _data_FX_MODE_2DNOISE[] PROGMEM = "Noise2D@!,Scale;;!;2";
+static constexpr char _data_FX_MODE_2DNOISE[] PROGMEM = "Noise2D@!,Scale;;!;2";
 
 
 //////////////////////////////
@@ -5880,7 +5883,7 @@ void mode_2DPlasmaball(void) {                   // By: Stepko https://editor.so
   }
   SEGMENT.blur(SEGMENT.custom2>>5);
 } // mode_2DPlasmaball()
-static const char _data_FX_MODE_2DPLASMABALL[] PROGMEM = "Plasma Ball@Speed,,Fade,Blur;;!;2";
+static constexpr char _data_FX_MODE_2DPLASMABALL[] PROGMEM = "Plasma Ball@Speed,,Fade,Blur;;!;2";
 
 
 ////////////////////////////////
@@ -5913,7 +5916,7 @@ void mode_2DPolarLights(void) {        // By: Kostyantyn Matviyevskyy  https://e
     }
   }
 } // mode_2DPolarLights()
-static const char _data_FX_MODE_2DPOLARLIGHTS[] PROGMEM = "Polar Lights@!,Scale,,,,Flip Palette;;!;2;pal=71";
+static constexpr char _data_FX_MODE_2DPOLARLIGHTS[] PROGMEM = "Polar Lights@!,Scale,,,,Flip Palette;;!;2;pal=71";
 
 
 /////////////////////////
@@ -5933,7 +5936,7 @@ void mode_2DPulser(void) {                       // By: ldirko   https://editor.
 
   SEGMENT.blur(SEGMENT.intensity>>4);
 } // mode_2DPulser()
-static const char _data_FX_MODE_2DPULSER[] PROGMEM = "Pulser@!,Blur;;!;2";
+static constexpr char _data_FX_MODE_2DPULSER[] PROGMEM = "Pulser@!,Blur;;!;2";
 
 
 /////////////////////////
@@ -5960,7 +5963,7 @@ void mode_2DSindots(void) {                             // By: ldirko   https://
   }
   SEGMENT.blur(SEGMENT.custom2 >> (3 + SEGMENT.check1), SEGMENT.check1);
 } // mode_2DSindots()
-static const char _data_FX_MODE_2DSINDOTS[] PROGMEM = "Sindots@!,Dot distance,Fade rate,Blur,,Smear;;!;2;";
+static constexpr char _data_FX_MODE_2DSINDOTS[] PROGMEM = "Sindots@!,Dot distance,Fade rate,Blur,,Smear;;!;2;";
 
 
 //////////////////////////////
@@ -5991,7 +5994,7 @@ void mode_2Dsquaredswirl(void) {            // By: Mark Kriegsman. https://gist.
   SEGMENT.addPixelColorXY(j, n, ColorFromPalette(SEGPALETTE, strip.now/41, 255, LINEARBLEND));
   SEGMENT.addPixelColorXY(k, p, ColorFromPalette(SEGPALETTE, strip.now/73, 255, LINEARBLEND));
 } // mode_2Dsquaredswirl()
-static const char _data_FX_MODE_2DSQUAREDSWIRL[] PROGMEM = "Squared Swirl@,Fade,,,Blur;;!;2";
+static constexpr char _data_FX_MODE_2DSQUAREDSWIRL[] PROGMEM = "Squared Swirl@,Fade,,,Blur;;!;2";
 
 
 //////////////////////////////
@@ -6039,7 +6042,7 @@ void mode_2DSunradiation(void) {                   // By: ldirko https://editor.
     yindex += (cols + 2);
   }
 } // mode_2DSunradiation()
-static const char _data_FX_MODE_2DSUNRADIATION[] PROGMEM = "Sun Radiation@Variance,Brightness;;;2";
+static constexpr char _data_FX_MODE_2DSUNRADIATION[] PROGMEM = "Sun Radiation@Variance,Brightness;;;2";
 
 
 /////////////////////////
@@ -6076,7 +6079,7 @@ void mode_2Dtartan(void) {          // By: Elliott Kember  https://editor.soulma
     }
   }
 } // mode_2DTartan()
-static const char _data_FX_MODE_2DTARTAN[] PROGMEM = "Tartan@X scale,Y scale,,,Sharpness;;!;2";
+static constexpr char _data_FX_MODE_2DTARTAN[] PROGMEM = "Tartan@X scale,Y scale,,,Sharpness;;!;2";
 
 
 /////////////////////////
@@ -6115,7 +6118,7 @@ void mode_2Dspaceships(void) {    //// Space ships by stepko (c)05.02.21 [https:
   }
   SEGMENT.blur(SEGMENT.intensity >> 3, SEGMENT.check1);
 }
-static const char _data_FX_MODE_2DSPACESHIPS[] PROGMEM = "Spaceships@!,Blur,,,,Smear;;!;2";
+static constexpr char _data_FX_MODE_2DSPACESHIPS[] PROGMEM = "Spaceships@!,Blur,,,,Smear;;!;2";
 
 
 /////////////////////////
@@ -6186,7 +6189,7 @@ void mode_2Dcrazybees(void) {
     }
   }
 }
-static const char _data_FX_MODE_2DCRAZYBEES[] PROGMEM = "Crazy Bees@!,Blur,,,,Smear;;!;2;pal=11,ix=0";
+static constexpr char _data_FX_MODE_2DCRAZYBEES[] PROGMEM = "Crazy Bees@!,Blur,,,,Smear;;!;2;pal=11,ix=0";
 #undef MAX_BEES
 
 #ifdef WLED_PS_DONT_REPLACE_2D_FX
@@ -6274,7 +6277,7 @@ void mode_2Dghostrider(void) {
     SEGMENT.blur(SEGMENT.intensity>>3);
   }
 }
-static const char _data_FX_MODE_2DGHOSTRIDER[] PROGMEM = "Ghost Rider@Fade rate,Blur;;!;2";
+static constexpr char _data_FX_MODE_2DGHOSTRIDER[] PROGMEM = "Ghost Rider@Fade rate,Blur;;!;2";
 #undef LIGHTERS_AM
 
 ////////////////////////////
@@ -6371,7 +6374,7 @@ void mode_2Dfloatingblobs(void) {
 
   if (SEGENV.step < strip.now) SEGENV.step = strip.now + 2000; // change colors every 2 seconds
 }
-static const char _data_FX_MODE_2DBLOBS[] PROGMEM = "Blobs@!,# blobs,Blur,Trail;!;!;2;c1=8";
+static constexpr char _data_FX_MODE_2DBLOBS[] PROGMEM = "Blobs@!,# blobs,Blur,Trail;!;!;2;c1=8";
 #undef MAX_BLOBS
 #endif // WLED_PS_DONT_REPLACE_2D_FX
 
@@ -6563,7 +6566,7 @@ void mode_2Dscrollingtext(void) {
     currentXOffset += advance;
   }
 }
-static const char _data_FX_MODE_2DSCROLLTEXT[] PROGMEM = "Scrolling Text@!,Y Offset,Trail,Font size,Rotate,Gradient,Custom Font,Reverse;!,!,Gradient;!;2;ix=128,c1=0,rev=0,mi=0,rY=0,mY=0";
+static constexpr char _data_FX_MODE_2DSCROLLTEXT[] PROGMEM = "Scrolling Text@!,Y Offset,Trail,Font size,Rotate,Gradient,Custom Font,Reverse;!,!,Gradient;!;2;ix=128,c1=0,rev=0,mi=0,rY=0,mY=0";
 
 
 ////////////////////////////
@@ -6590,7 +6593,7 @@ void mode_2Ddriftrose(void) {
   }
   SEGMENT.blur(SEGMENT.intensity >> 4, SEGMENT.check1);
 }
-static const char _data_FX_MODE_2DDRIFTROSE[] PROGMEM = "Drift Rose@Fade,Blur,,,,Smear;;!;2;pal=11";
+static constexpr char _data_FX_MODE_2DDRIFTROSE[] PROGMEM = "Drift Rose@Fade,Blur,,,,Smear;;!;2;pal=11";
 
 /////////////////////////////
 //  2D PLASMA ROTOZOOMER   //
@@ -6634,7 +6637,7 @@ void mode_2Dplasmarotozoom() {
   *a -= 0.03f + float(SEGENV.speed-128)*0.0002f;  // rotation speed
   if(*a < -6283.18530718f) *a += 6283.18530718f; // 1000*2*PI, protect sin/cos from very large input float values (will give wrong results)
 }
-static const char _data_FX_MODE_2DPLASMAROTOZOOM[] PROGMEM = "Rotozoomer@!,Scale,,,,Alt;;!;2;pal=54";
+static constexpr char _data_FX_MODE_2DPLASMAROTOZOOM[] PROGMEM = "Rotozoomer@!,Scale,,,,Alt;;!;2;pal=54";
 
 #endif // WLED_DISABLE_2D
 
@@ -6713,7 +6716,7 @@ void mode_ripplepeak(void) {                // * Ripple peak. By Andrew Tuline.
     } // switch step
   } // for i
 } // mode_ripplepeak()
-static const char _data_FX_MODE_RIPPLEPEAK[] PROGMEM = "Ripple Peak@Fade rate,Max # of ripples,Select bin,Volume (min);!,!;!;1v;c2=0,m12=0,si=0"; // Pixel, Beatsin
+static constexpr char _data_FX_MODE_RIPPLEPEAK[] PROGMEM = "Ripple Peak@Fade rate,Max # of ripples,Select bin,Volume (min);!,!;!;1v;c2=0,m12=0,si=0"; // Pixel, Beatsin
 
 
 #ifndef WLED_DISABLE_2D
@@ -6751,7 +6754,7 @@ void mode_2DSwirl(void) {
   SEGMENT.addPixelColorXY( i,nj, ColorFromPalette(SEGPALETTE, (strip.now / 37 + volumeSmth*4), volumeRaw * SEGMENT.intensity / 64, LINEARBLEND)); //CHSV( ms / 37, 200, 255);
   SEGMENT.addPixelColorXY(ni, j, ColorFromPalette(SEGPALETTE, (strip.now / 41 + volumeSmth*4), volumeRaw * SEGMENT.intensity / 64, LINEARBLEND)); //CHSV( ms / 41, 200, 255);
 } // mode_2DSwirl()
-static const char _data_FX_MODE_2DSWIRL[] PROGMEM = "Swirl@!,Sensitivity,Blur;,Bg Swirl;!;2v;ix=64,si=0"; // Beatsin // TODO: color 1 unused?
+static constexpr char _data_FX_MODE_2DSWIRL[] PROGMEM = "Swirl@!,Sensitivity,Blur;,Bg Swirl;!;2v;ix=64,si=0"; // Beatsin // TODO: color 1 unused?
 
 
 /////////////////////////
@@ -6786,7 +6789,7 @@ void mode_2DWaverly(void) {
   }
   if (SEGMENT.check3) SEGMENT.blur(16, cols*rows < 100);
 } // mode_2DWaverly()
-static const char _data_FX_MODE_2DWAVERLY[] PROGMEM = "Waverly@Amplification,Sensitivity,,,,,Blur;;!;2v;ix=64,si=0"; // Beatsin
+static constexpr char _data_FX_MODE_2DWAVERLY[] PROGMEM = "Waverly@Amplification,Sensitivity,,,,,Blur;;!;2v;ix=64,si=0"; // Beatsin
 
 #endif // WLED_DISABLE_2D
 
@@ -6888,7 +6891,7 @@ void mode_gravcenter_base(unsigned mode) {
 void mode_gravcenter(void) {                // Gravcenter. By Andrew Tuline.
   mode_gravcenter_base(0);
 }
-static const char _data_FX_MODE_GRAVCENTER[] PROGMEM = "Gravcenter@Rate of fall,Sensitivity;!,!;!;1v;ix=128,m12=2,si=0"; // Circle, Beatsin
+static constexpr char _data_FX_MODE_GRAVCENTER[] PROGMEM = "Gravcenter@Rate of fall,Sensitivity;!,!;!;1v;ix=128,m12=2,si=0"; // Circle, Beatsin
 
 ///////////////////////
 //   * GRAVCENTRIC   //
@@ -6896,7 +6899,7 @@ static const char _data_FX_MODE_GRAVCENTER[] PROGMEM = "Gravcenter@Rate of fall,
 void mode_gravcentric(void) {               // Gravcentric. By Andrew Tuline.
   mode_gravcenter_base(1);
 }
-static const char _data_FX_MODE_GRAVCENTRIC[] PROGMEM = "Gravcentric@Rate of fall,Sensitivity;!,!;!;1v;ix=128,m12=3,si=0"; // Corner, Beatsin
+static constexpr char _data_FX_MODE_GRAVCENTRIC[] PROGMEM = "Gravcentric@Rate of fall,Sensitivity;!,!;!;1v;ix=128,m12=3,si=0"; // Corner, Beatsin
 
 
 ///////////////////////
@@ -6905,7 +6908,7 @@ static const char _data_FX_MODE_GRAVCENTRIC[] PROGMEM = "Gravcentric@Rate of fal
 void mode_gravimeter(void) {                // Gravmeter. By Andrew Tuline.
  mode_gravcenter_base(2);
 }
-static const char _data_FX_MODE_GRAVIMETER[] PROGMEM = "Gravimeter@Rate of fall,Sensitivity;!,!;!;1v;ix=128,m12=2,si=0"; // Circle, Beatsin
+static constexpr char _data_FX_MODE_GRAVIMETER[] PROGMEM = "Gravimeter@Rate of fall,Sensitivity;!,!;!;1v;ix=128,m12=2,si=0"; // Circle, Beatsin
 
 
 ///////////////////////
@@ -6914,7 +6917,7 @@ static const char _data_FX_MODE_GRAVIMETER[] PROGMEM = "Gravimeter@Rate of fall,
 void mode_gravfreq(void) {                  // Gravfreq. By Andrew Tuline.
   mode_gravcenter_base(3);
 }
-static const char _data_FX_MODE_GRAVFREQ[] PROGMEM = "Gravfreq@Rate of fall,Sensitivity;!,!;!;1f;ix=128,m12=0,si=0"; // Pixels, Beatsin
+static constexpr char _data_FX_MODE_GRAVFREQ[] PROGMEM = "Gravfreq@Rate of fall,Sensitivity;!,!;!;1f;ix=128,m12=0,si=0"; // Pixels, Beatsin
 
 
 //////////////////////
@@ -6932,7 +6935,7 @@ void mode_juggles(void) {                   // Juggles. By Andrew Tuline.
     SEGMENT.setPixelColor(beatsin16_t(SEGMENT.speed/4+i*2,0,SEGLEN-1), color_blend(SEGCOLOR(1), SEGMENT.color_from_palette(strip.now/4+i*2, false, PALETTE_SOLID_WRAP, 0), my_sampleAgc));
   }
 } // mode_juggles()
-static const char _data_FX_MODE_JUGGLES[] PROGMEM = "Juggles@!,# of balls;!,!;!;01v;m12=0,si=0"; // Pixels, Beatsin
+static constexpr char _data_FX_MODE_JUGGLES[] PROGMEM = "Juggles@!,# of balls;!,!;!;01v;m12=0,si=0"; // Pixels, Beatsin
 
 
 //////////////////////
@@ -6966,7 +6969,7 @@ void mode_matripix(void) {                  // Matripix. By Andrew Tuline.
     SEGMENT.setPixelColor(k, pixels[k]);
   }
 } // mode_matripix()
-static const char _data_FX_MODE_MATRIPIX[] PROGMEM = "Matripix@!,Brightness;!,!;!;1v;ix=64,m12=2,si=1"; //,rev=1,mi=1,rY=1,mY=1 Circle, WeWillRockYou, reverseX
+static constexpr char _data_FX_MODE_MATRIPIX[] PROGMEM = "Matripix@!,Brightness;!,!;!;1v;ix=64,m12=2,si=1"; //,rev=1,mi=1,rY=1,mY=1 Circle, WeWillRockYou, reverseX
 
 
 //////////////////////
@@ -6996,7 +6999,7 @@ void mode_midnoise(void) {                  // Midnoise. By Andrew Tuline.
   SEGENV.aux0=SEGENV.aux0+beatsin8_t(5,0,10);
   SEGENV.aux1=SEGENV.aux1+beatsin8_t(4,0,10);
 } // mode_midnoise()
-static const char _data_FX_MODE_MIDNOISE[] PROGMEM = "Midnoise@Fade rate,Max. length;!,!;!;1v;ix=128,m12=1,si=0"; // Bar, Beatsin
+static constexpr char _data_FX_MODE_MIDNOISE[] PROGMEM = "Midnoise@Fade rate,Max. length;!,!;!;1v;ix=128,m12=1,si=0"; // Bar, Beatsin
 
 
 //////////////////////
@@ -7022,7 +7025,7 @@ void mode_noisefire(void) {                 // Noisefire. By Andrew Tuline.
     SEGMENT.setPixelColor(i, ColorFromPalette(myPal, index, volumeSmth*2, LINEARBLEND)); // Use my own palette.
   }
 } // mode_noisefire()
-static const char _data_FX_MODE_NOISEFIRE[] PROGMEM = "Noisefire@!,!;;;01v;m12=2,si=0"; // Circle, Beatsin
+static constexpr char _data_FX_MODE_NOISEFIRE[] PROGMEM = "Noisefire@!,!;;;01v;m12=2,si=0"; // Circle, Beatsin
 
 
 ///////////////////////
@@ -7051,7 +7054,7 @@ void mode_noisemeter(void) {                // Noisemeter. By Andrew Tuline.
   SEGENV.aux0+=beatsin8_t(5,0,10);
   SEGENV.aux1+=beatsin8_t(4,0,10);
 } // mode_noisemeter()
-static const char _data_FX_MODE_NOISEMETER[] PROGMEM = "Noisemeter@Fade rate,Width;!,!;!;1v;ix=128,m12=2,si=0"; // Circle, Beatsin
+static constexpr char _data_FX_MODE_NOISEMETER[] PROGMEM = "Noisemeter@Fade rate,Width;!,!;!;1v;ix=128,m12=2,si=0"; // Circle, Beatsin
 
 
 //////////////////////
@@ -7079,7 +7082,7 @@ void mode_pixelwave(void) {                 // Pixelwave. By Andrew Tuline.
     for (unsigned i = 0; i < SEGLEN/2; i++)          SEGMENT.setPixelColor(i, SEGMENT.getPixelColor(i+1)); // move to the right
   }
 } // mode_pixelwave()
-static const char _data_FX_MODE_PIXELWAVE[] PROGMEM = "Pixelwave@!,Sensitivity;!,!;!;1v;ix=64,m12=2,si=0"; // Circle, Beatsin
+static constexpr char _data_FX_MODE_PIXELWAVE[] PROGMEM = "Pixelwave@!,Sensitivity;!,!;!;1v;ix=64,m12=2,si=0"; // Circle, Beatsin
 
 
 //////////////////////
@@ -7114,7 +7117,7 @@ void mode_plasmoid(void) {                  // Plasmoid. By Andrew Tuline.
     SEGMENT.addPixelColor(i, color_blend(SEGCOLOR(1), SEGMENT.color_from_palette(colorIndex, false, PALETTE_SOLID_WRAP, 0), thisbright));
   }
 } // mode_plasmoid()
-static const char _data_FX_MODE_PLASMOID[] PROGMEM = "Plasmoid@Phase,# of pixels;!,!;!;01v;sx=128,ix=128,m12=0,si=0"; // Pixels, Beatsin
+static constexpr char _data_FX_MODE_PLASMOID[] PROGMEM = "Plasmoid@Phase,# of pixels;!,!;!;01v;sx=128,ix=128,m12=0,si=0"; // Pixels, Beatsin
 
 
 //////////////////////
@@ -7158,12 +7161,12 @@ void mode_puddles_base(bool peakdetect) {
 void mode_puddlepeak(void) {                // Puddlepeak. By Andrew Tuline.
   mode_puddles_base(true);
 } 
-static const char _data_FX_MODE_PUDDLEPEAK[] PROGMEM = "Puddlepeak@Fade rate,Puddle size,Select bin,Volume (min);!,!;!;1v;c2=0,m12=0,si=0"; // Pixels, Beatsin
+static constexpr char _data_FX_MODE_PUDDLEPEAK[] PROGMEM = "Puddlepeak@Fade rate,Puddle size,Select bin,Volume (min);!,!;!;1v;c2=0,m12=0,si=0"; // Pixels, Beatsin
 
 void mode_puddles(void) {                   // Puddles. By Andrew Tuline.
   mode_puddles_base(false);
 } 
-static const char _data_FX_MODE_PUDDLES[] PROGMEM = "Puddles@Fade rate,Puddle size;!,!;!;1v;m12=0,si=0"; // Pixels, Beatsin
+static constexpr char _data_FX_MODE_PUDDLES[] PROGMEM = "Puddles@Fade rate,Puddle size;!,!;!;1v;m12=0,si=0"; // Pixels, Beatsin
 
 
 //////////////////////
@@ -7190,7 +7193,7 @@ void mode_pixels(void) {                    // Pixels. By Andrew Tuline.
     SEGMENT.setPixelColor(segLoc, color_blend(SEGCOLOR(1), SEGMENT.color_from_palette(myVals[i%32]+i*4, false, PALETTE_SOLID_WRAP, 0), uint8_t(volumeSmth)));
   }
 } // mode_pixels()
-static const char _data_FX_MODE_PIXELS[] PROGMEM = "Pixels@Fade rate,# of pixels;!,!;!;1v;m12=0,si=0"; // Pixels, Beatsin
+static constexpr char _data_FX_MODE_PIXELS[] PROGMEM = "Pixels@Fade rate,# of pixels;!,!;!;1v;m12=0,si=0"; // Pixels, Beatsin
 
 //////////////////////
 //    ** Blurz      //
@@ -7220,7 +7223,7 @@ void mode_blurz(void) {                    // Blurz. By Andrew Tuline.
     SEGMENT.blur(SEGMENT.intensity); // note: blur > 210 results in a alternating pattern, this could be fixed by mapping but some may like it (very old bug)
   }
 } // mode_blurz()
-static const char _data_FX_MODE_BLURZ[] PROGMEM = "Blurz@Fade rate,Blur;!,Color mix;!;1f;m12=0,si=0"; // Pixels, Beatsin
+static constexpr char _data_FX_MODE_BLURZ[] PROGMEM = "Blurz@Fade rate,Blur;!,Color mix;!;1f;m12=0,si=0"; // Pixels, Beatsin
 
 
 /////////////////////////
@@ -7249,7 +7252,7 @@ void mode_DJLight(void) {                   // Written by ??? Adapted by Will Ta
     for (int i = 0; i < mid; i++)            SEGMENT.setPixelColor(i, SEGMENT.getPixelColor(i+1)); // move to the right
   }
 } // mode_DJLight()
-static const char _data_FX_MODE_DJLIGHT[] PROGMEM = "DJ Light@Speed;;;01f;m12=2,si=0"; // Circle, Beatsin
+static constexpr char _data_FX_MODE_DJLIGHT[] PROGMEM = "DJ Light@Speed;;;01f;m12=2,si=0"; // Circle, Beatsin
 
 
 ////////////////////
@@ -7280,7 +7283,7 @@ void mode_freqmap(void) {                   // Map FFT_MajorPeak to SEGLEN. Woul
 
   SEGMENT.setPixelColor(locn, color_blend(SEGCOLOR(1), SEGMENT.color_from_palette(SEGMENT.intensity+pixCol, false, PALETTE_SOLID_WRAP, 0), bright));
 } // mode_freqmap()
-static const char _data_FX_MODE_FREQMAP[] PROGMEM = "Freqmap@Fade rate,Starting color;!,!;!;1f;m12=0,si=0"; // Pixels, Beatsin
+static constexpr char _data_FX_MODE_FREQMAP[] PROGMEM = "Freqmap@Fade rate,Starting color;!,!;!;1f;m12=0,si=0"; // Pixels, Beatsin
 
 
 ///////////////////////
@@ -7330,7 +7333,7 @@ void mode_freqmatrix(void) {                // Freqmatrix. By Andreas Pleschung.
     for (int i = SEGLEN - 1; i > 0; i--) SEGMENT.setPixelColor(i, SEGMENT.getPixelColor(i-1)); //move to the left
   }
 } // mode_freqmatrix()
-static const char _data_FX_MODE_FREQMATRIX[] PROGMEM = "Freqmatrix@Speed,Sound effect,Low bin,High bin,Sensitivity;;;01f;m12=3,si=0"; // Corner, Beatsin
+static constexpr char _data_FX_MODE_FREQMATRIX[] PROGMEM = "Freqmatrix@Speed,Sound effect,Low bin,High bin,Sensitivity;;;01f;m12=3,si=0"; // Corner, Beatsin
 
 
 //////////////////////
@@ -7362,7 +7365,7 @@ void mode_freqpixels(void) {                // Freqpixel. By Andrew Tuline.
     SEGMENT.setPixelColor(locn, color_blend(SEGCOLOR(1), SEGMENT.color_from_palette(SEGMENT.intensity+pixCol, false, PALETTE_SOLID_WRAP, 0), (uint8_t)my_magnitude));
   }
 } // mode_freqpixels()
-static const char _data_FX_MODE_FREQPIXELS[] PROGMEM = "Freqpixels@Fade rate,Starting color and # of pixels;!,!,;!;1f;m12=0,si=0"; // Pixels, Beatsin
+static constexpr char _data_FX_MODE_FREQPIXELS[] PROGMEM = "Freqpixels@Fade rate,Starting color and # of pixels;!,!,;!;1f;m12=0,si=0"; // Pixels, Beatsin
 
 
 //////////////////////
@@ -7423,7 +7426,7 @@ void mode_freqwave(void) {                  // Freqwave. By Andreas Pleschung.
     for (unsigned i = 0; i < SEGLEN/2; i++)          SEGMENT.setPixelColor(i, SEGMENT.getPixelColor(i+1)); // move to the right
   }
 } // mode_freqwave()
-static const char _data_FX_MODE_FREQWAVE[] PROGMEM = "Freqwave@Speed,Sound effect,Low bin,High bin,Pre-amp;;;01f;m12=2,si=0"; // Circle, Beatsin
+static constexpr char _data_FX_MODE_FREQWAVE[] PROGMEM = "Freqwave@Speed,Sound effect,Low bin,High bin,Pre-amp;;;01f;m12=2,si=0"; // Circle, Beatsin
 
 
 //////////////////////
@@ -7444,7 +7447,7 @@ void mode_noisemove(void) {                 // Noisemove.    By: Andrew Tuline
     SEGMENT.setPixelColor(locn, color_blend(SEGCOLOR(1), SEGMENT.color_from_palette(i*64, false, PALETTE_SOLID_WRAP, 0), uint8_t(fftResult[i % 16]*4)));
   }
 } // mode_noisemove()
-static const char _data_FX_MODE_NOISEMOVE[] PROGMEM = "Noisemove@Move speed,Fade rate;!,!;!;01f;m12=0,si=0"; // Pixels, Beatsin
+static constexpr char _data_FX_MODE_NOISEMOVE[] PROGMEM = "Noisemove@Move speed,Fade rate;!,!;!;01f;m12=0,si=0"; // Pixels, Beatsin
 
 
 //////////////////////
@@ -7477,7 +7480,7 @@ void mode_rocktaves(void) {                 // Rocktaves. Same note from each oc
   i = constrain(i, 0U, SEGLEN-1U);
   SEGMENT.addPixelColor(i, color_blend(SEGCOLOR(1), SEGMENT.color_from_palette((uint8_t)frTemp, false, PALETTE_SOLID_WRAP, 0), volTemp));
 } // mode_rocktaves()
-static const char _data_FX_MODE_ROCKTAVES[] PROGMEM = "Rocktaves@;!,!;!;01f;m12=1,si=0"; // Bar, Beatsin
+static constexpr char _data_FX_MODE_ROCKTAVES[] PROGMEM = "Rocktaves@;!,!;!;01f;m12=1,si=0"; // Bar, Beatsin
 
 
 ///////////////////////
@@ -7531,7 +7534,7 @@ void mode_waterfall(void) {                   // Waterfall. By: Andrew Tuline
     }
   }
 } // mode_waterfall()
-static const char _data_FX_MODE_WATERFALL[] PROGMEM = "Waterfall@!,Adjust color,Select bin,Volume (min);!,!;!;01f;c2=0,m12=2,si=0"; // Circles, Beatsin
+static constexpr char _data_FX_MODE_WATERFALL[] PROGMEM = "Waterfall@!,Adjust color,Select bin,Volume (min);!,!;!;01f;c2=0,m12=2,si=0"; // Circles, Beatsin
 
 
 #ifndef WLED_DISABLE_2D
@@ -7591,7 +7594,7 @@ void mode_2DGEQ(void) { // By Will Tatam. Code reduction by Ewoud Wijma.
     if (rippleTime && previousBarHeight[x]>0) previousBarHeight[x]--;    //delay/ripple effect
   }
 } // mode_2DGEQ()
-static const char _data_FX_MODE_2DGEQ[] PROGMEM = "GEQ@Fade speed,Ripple decay,# of bands,,Bin,Color bars;!,,Peaks;!;2f;c1=255,c2=64,pal=11,si=0,c3=0";
+static constexpr char _data_FX_MODE_2DGEQ[] PROGMEM = "GEQ@Fade speed,Ripple decay,# of bands,,Bin,Color bars;!,,Peaks;!;2f;c1=255,c2=64,pal=11,si=0,c3=0";
 
 
 /////////////////////////
@@ -7642,7 +7645,7 @@ void mode_2DFunkyPlank(void) {              // Written by ??? Adapted by Will Ta
     }
   }
 } // mode_2DFunkyPlank
-static const char _data_FX_MODE_2DFUNKYPLANK[] PROGMEM = "Funky Plank@Scroll speed,,# of bands;;;2f;si=0"; // Beatsin
+static constexpr char _data_FX_MODE_2DFUNKYPLANK[] PROGMEM = "Funky Plank@Scroll speed,,# of bands;;;2f;si=0"; // Beatsin
 
 
 /////////////////////////
@@ -7744,7 +7747,7 @@ void mode_2DAkemi(void) {
     }
   }
 } // mode_2DAkemi
-static const char _data_FX_MODE_2DAKEMI[] PROGMEM = "Akemi@Color speed,Dance;Head palette,Arms & Legs,Eyes & Mouth;Face palette;2f;si=0"; //beatsin
+static constexpr char _data_FX_MODE_2DAKEMI[] PROGMEM = "Akemi@Color speed,Dance;Head palette,Arms & Legs,Eyes & Mouth;Face palette;2f;si=0"; //beatsin
 
 
 // Distortion waves - ldirko
@@ -7823,7 +7826,7 @@ void mode_2Ddistortionwaves() {
   if(!SEGMENT.check1 && SEGMENT.palette)
     SEGMENT.blur(200, true);
 }
-static const char _data_FX_MODE_2DDISTORTIONWAVES[] PROGMEM = "Distortion Waves@!,Scale,,,,Fill,Zoom,Alt;;!;2;pal=0";
+static constexpr char _data_FX_MODE_2DDISTORTIONWAVES[] PROGMEM = "Distortion Waves@!,Scale,,,,Fill,Zoom,Alt;;!;2;pal=0";
 
 
 //Soap
@@ -7926,7 +7929,7 @@ void mode_2Dsoap() {
   soapPixels(true,  noise3d, pixels); // rows
   soapPixels(false, noise3d, pixels); // cols
 }
-static const char _data_FX_MODE_2DSOAP[] PROGMEM = "Soap@!,Smoothness,Density;;!;2;pal=11";
+static constexpr char _data_FX_MODE_2DSOAP[] PROGMEM = "Soap@!,Smoothness,Density;;!;2;pal=11";
 
 
 //Idea from https://www.youtube.com/watch?v=HsA-6KIbgto&ab_channel=GreatScott%21
@@ -7984,7 +7987,7 @@ void mode_2Doctopus() {
     }
   }
 }
-static const char _data_FX_MODE_2DOCTOPUS[] PROGMEM = "Octopus@!,,Offset X,Offset Y,Legs,fasttan;;!;2;";
+static constexpr char _data_FX_MODE_2DOCTOPUS[] PROGMEM = "Octopus@!,,Offset X,Offset Y,Legs,fasttan;;!;2;";
 
 
 //Waving Cell
@@ -8009,7 +8012,7 @@ void mode_2Dwavingcell() {
   }
   SEGMENT.blur(SEGMENT.intensity);
 }
-static const char _data_FX_MODE_2DWAVINGCELL[] PROGMEM = "Waving Cell@!,Blur,Amplitude 1,Amplitude 2,Amplitude 3,,Flow;;!;2;ix=0";
+static constexpr char _data_FX_MODE_2DWAVINGCELL[] PROGMEM = "Waving Cell@!,Blur,Amplitude 1,Amplitude 2,Amplitude 3,,Flow;;!;2;ix=0";
 
 #ifndef WLED_DISABLE_PARTICLESYSTEM2D
 
@@ -8125,7 +8128,7 @@ void mode_particlevortex(void) {
   PartSys->update(); //update all particles and render to frame
 }
 #undef NUMBEROFSOURCES
-static const char _data_FX_MODE_PARTICLEVORTEX[] PROGMEM = "PS Vortex@Rotation Speed,Particle Speed,Arms,Flip,Nozzle,Smear,Direction,Random Flip;;!;2;pal=27,c1=200,c2=0,c3=0";
+static constexpr char _data_FX_MODE_PARTICLEVORTEX[] PROGMEM = "PS Vortex@Rotation Speed,Particle Speed,Arms,Flip,Nozzle,Smear,Direction,Random Flip;;!;2;pal=27,c1=200,c2=0,c3=0";
 
 /*
   Particle Fireworks
@@ -8268,7 +8271,7 @@ void mode_particlefireworks(void) {
   PartSys->update(); // update and render
 }
 #undef NUMBEROFSOURCES
-static const char _data_FX_MODE_PARTICLEFIREWORKS[] PROGMEM = "PS Fireworks@Launches,Explosion Size,Fuse,Blur,Gravity,Cylinder,Ground,Fast;;!;2;pal=11,ix=50,c1=40,c2=0,c3=12";
+static constexpr char _data_FX_MODE_PARTICLEFIREWORKS[] PROGMEM = "PS Fireworks@Launches,Explosion Size,Fuse,Blur,Gravity,Cylinder,Ground,Fast;;!;2;pal=11,ix=50,c1=40,c2=0,c3=12";
 
 /*
   Particle Volcano
@@ -8341,7 +8344,7 @@ void mode_particlevolcano(void) {
   PartSys->update(); // update and render
 }
 #undef NUMBEROFSOURCES
-static const char _data_FX_MODE_PARTICLEVOLCANO[] PROGMEM = "PS Volcano@Speed,Intensity,Move,Bounce,Spread,AgeColor,Walls,Collide;;!;2;pal=35,sx=100,ix=190,c1=0,c2=160,c3=6,o1=1";
+static constexpr char _data_FX_MODE_PARTICLEVOLCANO[] PROGMEM = "PS Volcano@Speed,Intensity,Move,Bounce,Spread,AgeColor,Walls,Collide;;!;2;pal=35,sx=100,ix=190,c1=0,c2=160,c3=6,o1=1";
 
 /*
   Particle Fire
@@ -8443,7 +8446,7 @@ void mode_particlefire(void) {
 
   PartSys->updateFire(SEGMENT.intensity); // update and render the fire
 }
-static const char _data_FX_MODE_PARTICLEFIRE[] PROGMEM = "PS Fire@Speed,Intensity,Flame Height,Wind,Spread,Smooth,Cylinder,Turbulence;;!;2;pal=35,sx=110,c1=110,c2=50,c3=31,o1=1";
+static constexpr char _data_FX_MODE_PARTICLEFIRE[] PROGMEM = "PS Fire@Speed,Intensity,Flame Height,Wind,Spread,Smooth,Cylinder,Turbulence;;!;2;pal=35,sx=110,c1=110,c2=50,c3=31,o1=1";
 
 /*
   PS Ballpit: particles falling down, user can enable these three options: X-wraparound, side bounce, ground bounce
@@ -8513,7 +8516,7 @@ void mode_particlepit(void) {
 
   PartSys->update(); // update and render
 }
-static const char _data_FX_MODE_PARTICLEPIT[] PROGMEM = "PS Ballpit@Speed,Intensity,Size,Hardness,Saturation,Cylinder,Walls,Ground;;!;2;pal=11,sx=100,ix=220,c1=70,c2=180,c3=31,o3=1";
+static constexpr char _data_FX_MODE_PARTICLEPIT[] PROGMEM = "PS Ballpit@Speed,Intensity,Size,Hardness,Saturation,Cylinder,Walls,Ground;;!;2;pal=11,sx=100,ix=220,c1=70,c2=180,c3=31,o3=1";
 
 /*
   Particle Waterfall
@@ -8584,7 +8587,7 @@ void mode_particlewaterfall(void) {
 
   PartSys->update();   // update and render
 }
-static const char _data_FX_MODE_PARTICLEWATERFALL[] PROGMEM = "PS Waterfall@Speed,Intensity,Variation,Collide,Position,Cylinder,Walls,Ground;;!;2;pal=9,sx=15,ix=200,c1=32,c2=160,o3=1";
+static constexpr char _data_FX_MODE_PARTICLEWATERFALL[] PROGMEM = "PS Waterfall@Speed,Intensity,Variation,Collide,Position,Cylinder,Walls,Ground;;!;2;pal=9,sx=15,ix=200,c1=32,c2=160,o3=1";
 
 /*
   Particle Box, applies gravity to particles in either a random direction or random but only downwards (sloshing)
@@ -8670,7 +8673,7 @@ void mode_particlebox(void) {
 
   PartSys->update();   // update and render
 }
-static const char _data_FX_MODE_PARTICLEBOX[] PROGMEM = "PS Box@!,Particles,Tilt,Hardness,Size,Random,Washing Machine,Sloshing;;!;2;pal=53,ix=50,c3=1,o1=1";
+static constexpr char _data_FX_MODE_PARTICLEBOX[] PROGMEM = "PS Box@!,Particles,Tilt,Hardness,Size,Random,Washing Machine,Sloshing;;!;2;pal=53,ix=50,c3=1,o1=1";
 
 /*
   Fuzzy Noise: Perlin noise 'gravity' mapping as in particles on 'noise hills' viewed from above
@@ -8731,7 +8734,7 @@ void mode_particleperlin(void) {
 
   PartSys->update(); // update and render
 }
-static const char _data_FX_MODE_PARTICLEPERLIN[] PROGMEM = "PS Fuzzy Noise@Speed,Particles,Bounce,Friction,Scale,Cylinder,Smear,Collide;;!;2;pal=64,sx=50,ix=200,c1=130,c2=30,c3=5";
+static constexpr char _data_FX_MODE_PARTICLEPERLIN[] PROGMEM = "PS Fuzzy Noise@Speed,Particles,Bounce,Friction,Scale,Cylinder,Smear,Collide;;!;2;pal=64,sx=50,ix=200,c1=130,c2=30,c3=5";
 
 /*
   Particle smashing down like meteors and exploding as they hit the ground, has many parameters to play with
@@ -8838,7 +8841,7 @@ void mode_particleimpact(void) {
   PartSys->update(); // update and render
 }
 #undef NUMBEROFSOURCES
-static const char _data_FX_MODE_PARTICLEIMPACT[] PROGMEM = "PS Impact@Launches,!,Force,Hardness,Blur,Cylinder,Walls,Collide;;!;2;pal=0,sx=32,ix=85,c1=70,c2=130,c3=0,o3=1";
+static constexpr char _data_FX_MODE_PARTICLEIMPACT[] PROGMEM = "PS Impact@Launches,!,Force,Hardness,Blur,Cylinder,Walls,Collide;;!;2;pal=0,sx=32,ix=85,c1=70,c2=130,c3=0,o3=1";
 
 /*
   Particle Attractor, a particle attractor sits in the matrix center, a spray bounces around and seeds particles
@@ -8929,8 +8932,8 @@ void mode_particleattractor(void) {
   PartSys->particleMoveUpdate(PartSys->sources[0].source, PartSys->sources[0].sourceFlags, &sourcesettings); // move the source
   PartSys->update(); // update and render
 }
-//static const char _data_FX_MODE_PARTICLEATTRACTOR[] PROGMEM = "PS Attractor@Mass,Particles,Size,Collide,Friction,AgeColor,Move,Swallow;;!;2;pal=9,sx=100,ix=82,c1=1,c2=0";
-static const char _data_FX_MODE_PARTICLEATTRACTOR[] PROGMEM = "PS Attractor@Mass,Particles,Size,Collide,Friction,AgeColor,Move,Swallow;;!;2;pal=9,sx=100,ix=82,c1=2,c2=0";
+//static constexpr char _data_FX_MODE_PARTICLEATTRACTOR[] PROGMEM = "PS Attractor@Mass,Particles,Size,Collide,Friction,AgeColor,Move,Swallow;;!;2;pal=9,sx=100,ix=82,c1=1,c2=0";
+static constexpr char _data_FX_MODE_PARTICLEATTRACTOR[] PROGMEM = "PS Attractor@Mass,Particles,Size,Collide,Friction,AgeColor,Move,Swallow;;!;2;pal=9,sx=100,ix=82,c1=2,c2=0";
 
 /*
   Particle Spray, just a particle spray with many parameters
@@ -9002,7 +9005,7 @@ void mode_particlespray(void) {
 
   PartSys->update(); // update and render
 }
-static const char _data_FX_MODE_PARTICLESPRAY[] PROGMEM = "PS Spray@Speed,!,Left/Right,Up/Down,Angle,Gravity,Cylinder/Square,Collide;;!;2v;pal=0,sx=150,ix=150,c1=220,c2=30,c3=21";
+static constexpr char _data_FX_MODE_PARTICLESPRAY[] PROGMEM = "PS Spray@Speed,!,Left/Right,Up/Down,Angle,Gravity,Cylinder/Square,Collide;;!;2v;pal=0,sx=150,ix=150,c1=220,c2=30,c3=21";
 
 
 /*
@@ -9075,7 +9078,7 @@ void mode_particleGEQ(void) {
   PartSys->update(); // update and render
 }
 
-static const char _data_FX_MODE_PARTICLEGEQ[] PROGMEM = "PS GEQ 2D@Speed,Intensity,Diverge,Bounce,Gravity,Cylinder,Walls,Floor;;!;2f;pal=0,sx=155,ix=200,c1=0";
+static constexpr char _data_FX_MODE_PARTICLEGEQ[] PROGMEM = "PS GEQ 2D@Speed,Intensity,Diverge,Bounce,Gravity,Cylinder,Walls,Floor;;!;2f;pal=0,sx=155,ix=200,c1=0";
 
 /*
   Particle rotating GEQ
@@ -9146,7 +9149,7 @@ void mode_particlecenterGEQ(void) {
   }
   PartSys->update(); // update and render
 }
-static const char _data_FX_MODE_PARTICLECIRCULARGEQ[] PROGMEM = "PS GEQ Nova@Speed,Intensity,Rotation Speed,Color Change,Nozzle,,Direction;;!;2f;pal=13,ix=180,c1=0,c2=0,c3=8";
+static constexpr char _data_FX_MODE_PARTICLECIRCULARGEQ[] PROGMEM = "PS GEQ Nova@Speed,Intensity,Rotation Speed,Color Change,Nozzle,,Direction;;!;2f;pal=13,ix=180,c1=0,c2=0,c3=8";
 
 /*
   Particle replacement of Ghost Rider by DedeHai (Damian Schneider), original FX by stepko adapted by Blaz Kristan (AKA blazoncek)
@@ -9225,7 +9228,7 @@ void mode_particleghostrider(void) {
 
   PartSys->update(); // update and render
 }
-static const char _data_FX_MODE_PARTICLEGHOSTRIDER[] PROGMEM = "PS Ghost Rider@Speed,Spiral,Blur,Color Cycle,Spread,AgeColor,Walls;;!;2;pal=1,sx=70,ix=0,c1=220,c2=30,c3=21,o1=1";
+static constexpr char _data_FX_MODE_PARTICLEGHOSTRIDER[] PROGMEM = "PS Ghost Rider@Speed,Spiral,Blur,Color Cycle,Spread,AgeColor,Walls;;!;2;pal=1,sx=70,ix=0,c1=220,c2=30,c3=21,o1=1";
 
 /*
   PS Blobs: large particles bouncing around, changing size and form
@@ -9298,7 +9301,7 @@ void mode_particleblobs(void) {
   PartSys->setMotionBlur(((SEGMENT.custom3) << 3) + 7);
   PartSys->update(); // update and render
 }
-static const char _data_FX_MODE_PARTICLEBLOBS[] PROGMEM = "PS Blobs@Speed,Blobs,Size,Life,Blur,Wobble,Collide,Pulsate;;!;2v;sx=30,ix=64,c1=200,c2=130,c3=0,o3=1";
+static constexpr char _data_FX_MODE_PARTICLEBLOBS[] PROGMEM = "PS Blobs@Speed,Blobs,Size,Life,Blur,Wobble,Collide,Pulsate;;!;2v;sx=30,ix=64,c1=200,c2=130,c3=0,o3=1";
 
 /*
   Particle Galaxy, particles spiral like in a galaxy
@@ -9396,7 +9399,7 @@ void mode_particlegalaxy(void) {
 
   PartSys->update(); // update and render
 }
-static const char _data_FX_MODE_PARTICLEGALAXY[] PROGMEM = "PS Galaxy@!,!,Size,,Color,,Starfield,Trace;;!;2;pal=59,sx=80,c1=1,c3=4";
+static constexpr char _data_FX_MODE_PARTICLEGALAXY[] PROGMEM = "PS Galaxy@!,!,Size,,Color,,Starfield,Trace;;!;2;pal=59,sx=80,c1=1,c3=4";
 
 #endif //WLED_DISABLE_PARTICLESYSTEM2D
 #endif // WLED_DISABLE_2D
@@ -9514,7 +9517,7 @@ void mode_particleDrip(void) {
 
   PartSys->update(); // update and render
 }
-static const char _data_FX_MODE_PARTICLEDRIP[] PROGMEM = "PS DripDrop@Speed,!,Splash,Blur,Gravity,Rain,PushSplash,Smooth;,!;!;1;pal=0,sx=150,ix=25,c1=220,c2=30,c3=21";
+static constexpr char _data_FX_MODE_PARTICLEDRIP[] PROGMEM = "PS DripDrop@Speed,!,Splash,Blur,Gravity,Rain,PushSplash,Smooth;,!;!;1;pal=0,sx=150,ix=25,c1=220,c2=30,c3=21";
 
 
 /*
@@ -9630,7 +9633,7 @@ void mode_particlePinball(void) {
 
   PartSys->update(); // update and render
 }
-static const char _data_FX_MODE_PSPINBALL[] PROGMEM = "PS Pinball@Speed,!,Size,Blur,Gravity,Collide,Rolling,Position Color;,!;!;1;pal=0,ix=220,c2=0,c3=8,o1=1";
+static constexpr char _data_FX_MODE_PSPINBALL[] PROGMEM = "PS Pinball@Speed,!,Size,Blur,Gravity,Collide,Rolling,Position Color;,!;!;1;pal=0,ix=220,c2=0,c3=8,o1=1";
 
 /*
   Particle Replacement for original Dancing Shadows:
@@ -9748,7 +9751,7 @@ void mode_particleDancingShadows(void) {
 
   PartSys->update(); // update and render
 }
-static const char _data_FX_MODE_PARTICLEDANCINGSHADOWS[] PROGMEM = "PS Dancing Shadows@Speed,!,Blur,Color Cycle,,Smear,Position Color,Smooth;,!;!;1;sx=100,ix=180,c1=0,c2=0";
+static constexpr char _data_FX_MODE_PARTICLEDANCINGSHADOWS[] PROGMEM = "PS Dancing Shadows@Speed,!,Blur,Color Cycle,,Smear,Position Color,Smooth;,!;!;1;sx=100,ix=180,c1=0,c2=0";
 
 /*
   Particle Fireworks 1D replacement
@@ -9868,7 +9871,7 @@ void mode_particleFireworks1D(void) {
     else PartSys->particles[i].ttl = 0;
   }
 }
-static const char _data_FX_MODE_PS_FIREWORKS1D[] PROGMEM = "PS Fireworks 1D@Gravity,Explosion,Firing side,Blur,Color,Colorful,Trail,Smooth;,!;!;1;c2=30,o1=1";
+static constexpr char _data_FX_MODE_PS_FIREWORKS1D[] PROGMEM = "PS Fireworks 1D@Gravity,Explosion,Firing side,Blur,Color,Colorful,Trail,Smooth;,!;!;1;c2=30,o1=1";
 
 /*
   Particle based Sparkle effect
@@ -9938,7 +9941,7 @@ void mode_particleSparkler(void) {
     else PartSys->particles[i].ttl = 0;
   }
 }
-static const char _data_FX_MODE_PS_SPARKLER[] PROGMEM = "PS Sparkler@Move,!,Saturation,Blur,Sparklers,Slide,Bounce,Large;,!;!;1;pal=0,sx=255,c1=0,c2=0,c3=6";
+static constexpr char _data_FX_MODE_PS_SPARKLER[] PROGMEM = "PS Sparkler@Move,!,Saturation,Blur,Sparklers,Slide,Bounce,Large;,!;!;1;pal=0,sx=255,c1=0,c2=0,c3=6";
 
 /*
   Particle based Hourglass, particles falling at defined intervals
@@ -10061,7 +10064,7 @@ void mode_particleHourglass(void) {
 
   PartSys->update(); // update and render
 }
-static const char _data_FX_MODE_PS_HOURGLASS[] PROGMEM = "PS Hourglass@Interval,!,Color,Blur,Gravity,Colorflip,Start,Fast Reset;,!;!;1;pal=34,sx=5,ix=200,c1=140,c2=80,c3=4,o1=1,o2=1,o3=1";
+static constexpr char _data_FX_MODE_PS_HOURGLASS[] PROGMEM = "PS Hourglass@Interval,!,Color,Blur,Gravity,Colorflip,Start,Fast Reset;,!;!;1;pal=34,sx=5,ix=200,c1=140,c2=80,c3=4,o1=1,o2=1,o3=1";
 
 /*
   Particle based Spray effect (like a volcano, possible replacement for popcorn)
@@ -10111,7 +10114,7 @@ void mode_particle1Dspray(void) {
   }
   PartSys->update(); // update and render
 }
-static const char _data_FX_MODE_PS_1DSPRAY[] PROGMEM = "PS Spray 1D@Speed(+/-),!,Position,Blur,Gravity(+/-),AgeColor,Bounce,Position Color;,!;!;1;sx=200,ix=220,c1=0,c2=0";
+static constexpr char _data_FX_MODE_PS_1DSPRAY[] PROGMEM = "PS Spray 1D@Speed(+/-),!,Position,Blur,Gravity(+/-),AgeColor,Bounce,Position Color;,!;!;1;sx=200,ix=220,c1=0,c2=0";
 
 /*
   Particle based balance: particles move back and forth (1D pendent to 2D particle box)
@@ -10191,7 +10194,7 @@ void mode_particleBalance(void) {
   }
   PartSys->update(); // update and render
 }
-static const char _data_FX_MODE_PS_BALANCE[] PROGMEM = "PS 1D Balance@!,!,Hardness,Blur,Tilt,Position Color,Wrap,Random;,!;!;1;pal=18,c2=0,c3=4,o1=1";
+static constexpr char _data_FX_MODE_PS_BALANCE[] PROGMEM = "PS 1D Balance@!,!,Hardness,Blur,Tilt,Position Color,Wrap,Random;,!;!;1;pal=18,c2=0,c3=4,o1=1";
 
 /*
 Particle based Chase effect
@@ -10286,7 +10289,7 @@ void mode_particleChase(void) {
 
   PartSys->update(); // update and render
 }
-static const char _data_FX_MODE_PS_CHASE[] PROGMEM = "PS Chase@!,Density,Size,Hue,Blur,Playful,,Position Color;,!;!;1;pal=11,sx=50,c2=5,c3=0";
+static constexpr char _data_FX_MODE_PS_CHASE[] PROGMEM = "PS Chase@!,Density,Size,Hue,Blur,Playful,,Position Color;,!;!;1;pal=11,sx=50,c2=5,c3=0";
 
 /*
   Particle Fireworks Starburst replacement (smoother rendering, more settings)
@@ -10344,7 +10347,7 @@ void mode_particleStarburst(void) {
 
   PartSys->update(); // update and render
 }
-static const char _data_FX_MODE_PS_STARBURST[] PROGMEM = "PS Starburst@Chance,Fragments,Size,Blur,Cooling,Gravity,Colorful,Push;,!;!;1;pal=52,sx=150,ix=150,c1=120,c2=0,c3=21";
+static constexpr char _data_FX_MODE_PS_STARBURST[] PROGMEM = "PS Starburst@Chance,Fragments,Size,Blur,Cooling,Gravity,Colorful,Push;,!;!;1;pal=52,sx=150,ix=150,c1=120,c2=0,c3=21";
 
 /*
   Particle based 1D GEQ effect, each frequency bin gets an emitter, distributed over the strip
@@ -10416,7 +10419,7 @@ void mode_particle1DGEQ(void) {
 
   PartSys->update(); // update and render
 }
-static const char _data_FX_MODE_PS_1D_GEQ[] PROGMEM = "PS GEQ 1D@Speed,!,Size,Blur,,,,;,!;!;1f;pal=0,sx=50,ix=200,c1=0,c2=0,c3=0,o1=1,o2=1";
+static constexpr char _data_FX_MODE_PS_1D_GEQ[] PROGMEM = "PS GEQ 1D@Speed,!,Size,Blur,,,,;,!;!;1f;pal=0,sx=50,ix=200,c1=0,c2=0,c3=0,o1=1,o2=1";
 
 /*
   Particle based Fire effect
@@ -10480,7 +10483,7 @@ void mode_particleFire1D(void) {
 
   PartSys->update(); // update and render
 }
-static const char _data_FX_MODE_PS_FIRE1D[] PROGMEM = "PS Fire 1D@!,!,Cooling,Blur;,!;!;1;pal=35,sx=100,ix=50,c1=80,c2=100,c3=28,o1=1,o2=1";
+static constexpr char _data_FX_MODE_PS_FIRE1D[] PROGMEM = "PS Fire 1D@!,!,Cooling,Blur;,!;!;1;pal=35,sx=100,ix=50,c1=80,c2=100,c3=28,o1=1,o2=1";
 
 /*
   Particle based AR effect, swoop particles along the strip with selected frequency loudness
@@ -10582,7 +10585,7 @@ void mode_particle1DsonicStream(void) {
     }
   }
 }
-static const char _data_FX_MODE_PS_SONICSTREAM[] PROGMEM = "PS Sonic Stream@!,!,Color,Blur,Bin,Mod,Filter,Push;,!;!;1f;c3=0,o2=1";
+static constexpr char _data_FX_MODE_PS_SONICSTREAM[] PROGMEM = "PS Sonic Stream@!,!,Color,Blur,Bin,Mod,Filter,Push;,!;!;1f;c3=0,o2=1";
 
 
 /*
@@ -10672,7 +10675,7 @@ void mode_particle1DsonicBoom(void) {
 
   PartSys->update(); // update and render (needs to be done before manipulation for initial particle spacing to be right)
 }
-static const char _data_FX_MODE_PS_SONICBOOM[] PROGMEM = "PS Sonic Boom@!,!,Color,Position,Bin,Mod,Filter,Blur;,!;!;1f;c2=63,c3=0,o2=1";
+static constexpr char _data_FX_MODE_PS_SONICBOOM[] PROGMEM = "PS Sonic Boom@!,!,Color,Position,Bin,Mod,Filter,Blur;,!;!;1f;c2=63,c3=0,o2=1";
 
 /*
 Particles bound by springs
@@ -10840,7 +10843,7 @@ void mode_particleSpringy(void) {
   }
   PartSys->update(); // update and render
 }
-static const char _data_FX_MODE_PS_SPRINGY[] PROGMEM = "PS Springy@Stiffness,Damping,Density,Hue,Mode,Smear,XL,AR;,!;!;1f;pal=54,c2=0,c3=23";
+static constexpr char _data_FX_MODE_PS_SPRINGY[] PROGMEM = "PS Springy@Stiffness,Damping,Density,Hue,Mode,Smear,XL,AR;,!;!;1f;pal=54,c2=0,c3=23";
 
 #endif // WLED_DISABLE_PARTICLESYSTEM1D
 
@@ -10939,285 +10942,307 @@ void mode_slow_transition(void) {
   }
   SEGMENT.cct = data->currentCCT;
 }
-static const char _data_FX_MODE_SLOW_TRANSITION[] PROGMEM = "Slow Transition@Time (min),,,,,,Sweep;!;!;1;pal=2,sx=0,ix=0";
+static constexpr char _data_FX_MODE_SLOW_TRANSITION[] PROGMEM = "Slow Transition@Time (min),,,,,,Sweep;!;!;1;pal=2,sx=0,ix=0";
 
 //////////////////////////////////////////////////////////////////////////////////////////
 // mode data
-static const char _data_RESERVED[] PROGMEM = "RSVD";
-
-// add (or replace reserved) effect mode and data into vector
-// use id==255 to find unallocated gaps (with "Reserved" data string)
-// if vector size() is smaller than id (single) data is appended at the end (regardless of id)
-// return the actual id used for the effect or 255 if the add failed.
-uint8_t WS2812FX::addEffect(uint8_t id, mode_ptr mode_fn, const char *mode_name) {
-  if (id == 255) { // find empty slot
-    for (size_t i=1; i<_mode.size(); i++) if (_modeData[i] == _data_RESERVED) { id = i; break; }
-  }
-  if (id < _mode.size()) {
-    if (_modeData[id] != _data_RESERVED) return 255; // do not overwrite an already added effect
-    _mode[id]     = mode_fn;
-    _modeData[id] = mode_name;
-    return id;
-  } else if (_mode.size() < 255) { // 255 is reserved for indicating the effect wasn't added
-    _mode.push_back(mode_fn);
-    _modeData.push_back(mode_name);
-    if (_modeCount < _mode.size()) _modeCount++;
-    return _mode.size() - 1;
-  } else {
-    return 255; // The vector is full so return 255
-  }
-}
-
-void WS2812FX::setupEffectData() {
-  // Solid must be first! (assuming vector is empty upon call to setup)
-  _mode.push_back(&mode_static);
-  _modeData.push_back(_data_FX_MODE_STATIC);
-  // fill reserved word in case there will be any gaps in the array
-  for (size_t i=1; i<_modeCount; i++) {
-    _mode.push_back(&mode_static);
-    _modeData.push_back(_data_RESERVED);
-  }
-  // now replace all pre-allocated effects
-  addEffect(FX_MODE_COPY, &mode_copy_segment, _data_FX_MODE_COPY);
-  // --- 1D non-audio effects ---
-  addEffect(FX_MODE_BLINK, &mode_blink, _data_FX_MODE_BLINK);
-  addEffect(FX_MODE_BREATH, &mode_breath, _data_FX_MODE_BREATH);
-  addEffect(FX_MODE_COLOR_WIPE, &mode_color_wipe, _data_FX_MODE_COLOR_WIPE);
-  addEffect(FX_MODE_COLOR_WIPE_RANDOM, &mode_color_wipe_random, _data_FX_MODE_COLOR_WIPE_RANDOM);
-  addEffect(FX_MODE_RANDOM_COLOR, &mode_random_color, _data_FX_MODE_RANDOM_COLOR);
-  addEffect(FX_MODE_COLOR_SWEEP, &mode_color_sweep, _data_FX_MODE_COLOR_SWEEP);
-  addEffect(FX_MODE_DYNAMIC, &mode_dynamic, _data_FX_MODE_DYNAMIC);
-  addEffect(FX_MODE_RAINBOW, &mode_rainbow, _data_FX_MODE_RAINBOW);
-  addEffect(FX_MODE_RAINBOW_CYCLE, &mode_rainbow_cycle, _data_FX_MODE_RAINBOW_CYCLE);
-  addEffect(FX_MODE_SCAN, &mode_scan, _data_FX_MODE_SCAN);
-  addEffect(FX_MODE_DUAL_SCAN, &mode_dual_scan, _data_FX_MODE_DUAL_SCAN);
-  addEffect(FX_MODE_FADE, &mode_fade, _data_FX_MODE_FADE);
-  addEffect(FX_MODE_THEATER_CHASE, &mode_theater_chase, _data_FX_MODE_THEATER_CHASE);
-  addEffect(FX_MODE_THEATER_CHASE_RAINBOW, &mode_theater_chase_rainbow, _data_FX_MODE_THEATER_CHASE_RAINBOW);
-  addEffect(FX_MODE_RUNNING_LIGHTS, &mode_running_lights, _data_FX_MODE_RUNNING_LIGHTS);
-  addEffect(FX_MODE_SAW, &mode_saw, _data_FX_MODE_SAW);
-  addEffect(FX_MODE_TWINKLE, &mode_twinkle, _data_FX_MODE_TWINKLE);
-  addEffect(FX_MODE_DISSOLVE, &mode_dissolve, _data_FX_MODE_DISSOLVE);
-  addEffect(FX_MODE_DISSOLVE_RANDOM, &mode_dissolve_random, _data_FX_MODE_DISSOLVE_RANDOM);
-  addEffect(FX_MODE_FLASH_SPARKLE, &mode_flash_sparkle, _data_FX_MODE_FLASH_SPARKLE);
-  addEffect(FX_MODE_HYPER_SPARKLE, &mode_hyper_sparkle, _data_FX_MODE_HYPER_SPARKLE);
-  addEffect(FX_MODE_STROBE, &mode_strobe, _data_FX_MODE_STROBE);
-  addEffect(FX_MODE_STROBE_RAINBOW, &mode_strobe_rainbow, _data_FX_MODE_STROBE_RAINBOW);
-  addEffect(FX_MODE_MULTI_STROBE, &mode_multi_strobe, _data_FX_MODE_MULTI_STROBE);
-  addEffect(FX_MODE_BLINK_RAINBOW, &mode_blink_rainbow, _data_FX_MODE_BLINK_RAINBOW);
-  addEffect(FX_MODE_ANDROID, &mode_android, _data_FX_MODE_ANDROID);
-  addEffect(FX_MODE_CHASE_COLOR, &mode_chase_color, _data_FX_MODE_CHASE_COLOR);
-  addEffect(FX_MODE_CHASE_RANDOM, &mode_chase_random, _data_FX_MODE_CHASE_RANDOM);
-  addEffect(FX_MODE_CHASE_RAINBOW, &mode_chase_rainbow, _data_FX_MODE_CHASE_RAINBOW);
-  addEffect(FX_MODE_CHASE_FLASH, &mode_chase_flash, _data_FX_MODE_CHASE_FLASH);
-  addEffect(FX_MODE_CHASE_FLASH_RANDOM, &mode_chase_flash_random, _data_FX_MODE_CHASE_FLASH_RANDOM);
-  addEffect(FX_MODE_CHASE_RAINBOW_WHITE, &mode_chase_rainbow_white, _data_FX_MODE_CHASE_RAINBOW_WHITE);
-  addEffect(FX_MODE_COLORFUL, &mode_colorful, _data_FX_MODE_COLORFUL);
-  addEffect(FX_MODE_TRAFFIC_LIGHT, &mode_traffic_light, _data_FX_MODE_TRAFFIC_LIGHT);
-  addEffect(FX_MODE_COLOR_SWEEP_RANDOM, &mode_color_sweep_random, _data_FX_MODE_COLOR_SWEEP_RANDOM);
-  addEffect(FX_MODE_RUNNING_COLOR, &mode_running_color, _data_FX_MODE_RUNNING_COLOR);
-  addEffect(FX_MODE_AURORA, &mode_aurora, _data_FX_MODE_AURORA);
-  addEffect(FX_MODE_COLORCLOUDS, &mode_ColorClouds, _data_FX_MODE_COLORCLOUDS);
-  addEffect(FX_MODE_RUNNING_RANDOM, &mode_running_random, _data_FX_MODE_RUNNING_RANDOM);
-  addEffect(FX_MODE_LARSON_SCANNER, &mode_larson_scanner, _data_FX_MODE_LARSON_SCANNER);
-  addEffect(FX_MODE_RAIN, &mode_rain, _data_FX_MODE_RAIN);
-  addEffect(FX_MODE_PRIDE_2015, &mode_pride_2015, _data_FX_MODE_PRIDE_2015);
-  addEffect(FX_MODE_COLORWAVES, &mode_colorwaves, _data_FX_MODE_COLORWAVES);
-  addEffect(FX_MODE_FIREWORKS, &mode_fireworks, _data_FX_MODE_FIREWORKS);
-  addEffect(FX_MODE_TETRIX, &mode_tetrix, _data_FX_MODE_TETRIX);
-  addEffect(FX_MODE_FIRE_FLICKER, &mode_fire_flicker, _data_FX_MODE_FIRE_FLICKER);
-  addEffect(FX_MODE_GRADIENT, &mode_gradient, _data_FX_MODE_GRADIENT);
-  addEffect(FX_MODE_LOADING, &mode_loading, _data_FX_MODE_LOADING);
-  addEffect(FX_MODE_FAIRY, &mode_fairy, _data_FX_MODE_FAIRY);
-  addEffect(FX_MODE_TWO_DOTS, &mode_two_dots, _data_FX_MODE_TWO_DOTS);
-  addEffect(FX_MODE_FAIRYTWINKLE, &mode_fairytwinkle, _data_FX_MODE_FAIRYTWINKLE);
-  addEffect(FX_MODE_RUNNING_DUAL, &mode_running_dual, _data_FX_MODE_RUNNING_DUAL);
-  #ifdef WLED_ENABLE_GIF
-  addEffect(FX_MODE_IMAGE, &mode_image, _data_FX_MODE_IMAGE);
-  #endif
-  addEffect(FX_MODE_TRICOLOR_CHASE, &mode_tricolor_chase, _data_FX_MODE_TRICOLOR_CHASE);
-  addEffect(FX_MODE_TRICOLOR_WIPE, &mode_tricolor_wipe, _data_FX_MODE_TRICOLOR_WIPE);
-  addEffect(FX_MODE_TRICOLOR_FADE, &mode_tricolor_fade, _data_FX_MODE_TRICOLOR_FADE);
-  addEffect(FX_MODE_LIGHTNING, &mode_lightning, _data_FX_MODE_LIGHTNING);
-  addEffect(FX_MODE_ICU, &mode_icu, _data_FX_MODE_ICU);
-  addEffect(FX_MODE_DUAL_LARSON_SCANNER, &mode_dual_larson_scanner, _data_FX_MODE_DUAL_LARSON_SCANNER);
-  addEffect(FX_MODE_RANDOM_CHASE, &mode_random_chase, _data_FX_MODE_RANDOM_CHASE);
-  addEffect(FX_MODE_OSCILLATE, &mode_oscillate, _data_FX_MODE_OSCILLATE);
-  addEffect(FX_MODE_JUGGLE, &mode_juggle, _data_FX_MODE_JUGGLE);
-  addEffect(FX_MODE_PALETTE, &mode_palette, _data_FX_MODE_PALETTE);
-  addEffect(FX_MODE_BPM, &mode_bpm, _data_FX_MODE_BPM);
-  addEffect(FX_MODE_FILLNOISE8, &mode_fillnoise8, _data_FX_MODE_FILLNOISE8);
-  addEffect(FX_MODE_NOISE16_1, &mode_noise16_1, _data_FX_MODE_NOISE16_1);
-  addEffect(FX_MODE_NOISE16_2, &mode_noise16_2, _data_FX_MODE_NOISE16_2);
-  addEffect(FX_MODE_NOISE16_3, &mode_noise16_3, _data_FX_MODE_NOISE16_3);
-  addEffect(FX_MODE_NOISE16_4, &mode_noise16_4, _data_FX_MODE_NOISE16_4);
-  addEffect(FX_MODE_COLORTWINKLE, &mode_colortwinkle, _data_FX_MODE_COLORTWINKLE);
-  addEffect(FX_MODE_LAKE, &mode_lake, _data_FX_MODE_LAKE);
-  addEffect(FX_MODE_METEOR, &mode_meteor, _data_FX_MODE_METEOR);
-  //addEffect(FX_MODE_METEOR_SMOOTH, &mode_meteor_smooth, _data_FX_MODE_METEOR_SMOOTH); // merged with mode_meteor 
-  addEffect(FX_MODE_RAILWAY, &mode_railway, _data_FX_MODE_RAILWAY);
-  addEffect(FX_MODE_RIPPLE, &mode_ripple, _data_FX_MODE_RIPPLE);
-  addEffect(FX_MODE_TWINKLEFOX, &mode_twinklefox, _data_FX_MODE_TWINKLEFOX);
-  addEffect(FX_MODE_TWINKLECAT, &mode_twinklecat, _data_FX_MODE_TWINKLECAT);
-  addEffect(FX_MODE_HALLOWEEN_EYES, &mode_halloween_eyes, _data_FX_MODE_HALLOWEEN_EYES);
-  addEffect(FX_MODE_STATIC_PATTERN, &mode_static_pattern, _data_FX_MODE_STATIC_PATTERN);
-  addEffect(FX_MODE_TRI_STATIC_PATTERN, &mode_tri_static_pattern, _data_FX_MODE_TRI_STATIC_PATTERN);
-  addEffect(FX_MODE_SPOTS, &mode_spots, _data_FX_MODE_SPOTS);
-  addEffect(FX_MODE_SPOTS_FADE, &mode_spots_fade, _data_FX_MODE_SPOTS_FADE);
-  addEffect(FX_MODE_COMET, &mode_comet, _data_FX_MODE_COMET);
-  #if defined(WLED_PS_DONT_REPLACE_1D_FX) || defined(WLED_PS_DONT_REPLACE_2D_FX)
-  addEffect(FX_MODE_FIRE_2012, &mode_fire_2012, _data_FX_MODE_FIRE_2012);
-  addEffect(FX_MODE_EXPLODING_FIREWORKS, &mode_exploding_fireworks, _data_FX_MODE_EXPLODING_FIREWORKS);
-  #endif
-  addEffect(FX_MODE_SPARKLE, &mode_sparkle, _data_FX_MODE_SPARKLE);
-  addEffect(FX_MODE_GLITTER, &mode_glitter, _data_FX_MODE_GLITTER);
-  addEffect(FX_MODE_SOLID_GLITTER, &mode_solid_glitter, _data_FX_MODE_SOLID_GLITTER);
-  addEffect(FX_MODE_MULTI_COMET, &mode_multi_comet, _data_FX_MODE_MULTI_COMET);  
-  #ifdef WLED_PS_DONT_REPLACE_1D_FX
-  addEffect(FX_MODE_ROLLINGBALLS, &mode_rolling_balls, _data_FX_MODE_ROLLINGBALLS);
-  addEffect(FX_MODE_STARBURST, &mode_starburst, _data_FX_MODE_STARBURST);
-  addEffect(FX_MODE_DANCING_SHADOWS, &mode_dancing_shadows, _data_FX_MODE_DANCING_SHADOWS);
-  #endif
-  addEffect(FX_MODE_CANDLE, &mode_candle, _data_FX_MODE_CANDLE);
-  addEffect(FX_MODE_BOUNCINGBALLS, &mode_bouncing_balls, _data_FX_MODE_BOUNCINGBALLS);
-  addEffect(FX_MODE_POPCORN, &mode_popcorn, _data_FX_MODE_POPCORN);
-  addEffect(FX_MODE_DRIP, &mode_drip, _data_FX_MODE_DRIP);
-  addEffect(FX_MODE_SINELON, &mode_sinelon, _data_FX_MODE_SINELON);
-  addEffect(FX_MODE_SINELON_DUAL, &mode_sinelon_dual, _data_FX_MODE_SINELON_DUAL);
-  addEffect(FX_MODE_SINELON_RAINBOW, &mode_sinelon_rainbow, _data_FX_MODE_SINELON_RAINBOW);
-  addEffect(FX_MODE_PLASMA, &mode_plasma, _data_FX_MODE_PLASMA);
-  addEffect(FX_MODE_PERCENT, &mode_percent, _data_FX_MODE_PERCENT);
-  addEffect(FX_MODE_RIPPLE_RAINBOW, &mode_ripple_rainbow, _data_FX_MODE_RIPPLE_RAINBOW);
-  addEffect(FX_MODE_HEARTBEAT, &mode_heartbeat, _data_FX_MODE_HEARTBEAT);
-  addEffect(FX_MODE_PACIFICA, &mode_pacifica, _data_FX_MODE_PACIFICA);
-  addEffect(FX_MODE_CANDLE_MULTI, &mode_candle_multi, _data_FX_MODE_CANDLE_MULTI);
-  addEffect(FX_MODE_SUNRISE, &mode_sunrise, _data_FX_MODE_SUNRISE);
-  addEffect(FX_MODE_PHASED, &mode_phased, _data_FX_MODE_PHASED);
-  addEffect(FX_MODE_TWINKLEUP, &mode_twinkleup, _data_FX_MODE_TWINKLEUP);
-  addEffect(FX_MODE_NOISEPAL, &mode_noisepal, _data_FX_MODE_NOISEPAL);
-  addEffect(FX_MODE_SINEWAVE, &mode_sinewave, _data_FX_MODE_SINEWAVE);
-  addEffect(FX_MODE_PHASEDNOISE, &mode_phased_noise, _data_FX_MODE_PHASEDNOISE);
-  addEffect(FX_MODE_FLOW, &mode_flow, _data_FX_MODE_FLOW);
-  addEffect(FX_MODE_CHUNCHUN, &mode_chunchun, _data_FX_MODE_CHUNCHUN);  
-  addEffect(FX_MODE_WASHING_MACHINE, &mode_washing_machine, _data_FX_MODE_WASHING_MACHINE);
-  addEffect(FX_MODE_BLENDS, &mode_blends, _data_FX_MODE_BLENDS);
-  addEffect(FX_MODE_TV_SIMULATOR, &mode_tv_simulator, _data_FX_MODE_TV_SIMULATOR);
-  addEffect(FX_MODE_DYNAMIC_SMOOTH, &mode_dynamic_smooth, _data_FX_MODE_DYNAMIC_SMOOTH);
-  addEffect(FX_MODE_PACMAN, &mode_pacman, _data_FX_MODE_PACMAN);
-  addEffect(FX_MODE_SLOW_TRANSITION, &mode_slow_transition, _data_FX_MODE_SLOW_TRANSITION);
-
-  // --- 1D audio effects ---
-  addEffect(FX_MODE_PIXELS, &mode_pixels, _data_FX_MODE_PIXELS);
-  addEffect(FX_MODE_PIXELWAVE, &mode_pixelwave, _data_FX_MODE_PIXELWAVE);
-  addEffect(FX_MODE_JUGGLES, &mode_juggles, _data_FX_MODE_JUGGLES);
-  addEffect(FX_MODE_MATRIPIX, &mode_matripix, _data_FX_MODE_MATRIPIX);
-  addEffect(FX_MODE_GRAVIMETER, &mode_gravimeter, _data_FX_MODE_GRAVIMETER);
-  addEffect(FX_MODE_PLASMOID, &mode_plasmoid, _data_FX_MODE_PLASMOID);
-  addEffect(FX_MODE_PUDDLES, &mode_puddles, _data_FX_MODE_PUDDLES);
-  addEffect(FX_MODE_MIDNOISE, &mode_midnoise, _data_FX_MODE_MIDNOISE);
-  addEffect(FX_MODE_NOISEMETER, &mode_noisemeter, _data_FX_MODE_NOISEMETER);
-  addEffect(FX_MODE_FREQWAVE, &mode_freqwave, _data_FX_MODE_FREQWAVE);
-  addEffect(FX_MODE_FREQMATRIX, &mode_freqmatrix, _data_FX_MODE_FREQMATRIX);
-  addEffect(FX_MODE_WATERFALL, &mode_waterfall, _data_FX_MODE_WATERFALL);
-  addEffect(FX_MODE_FREQPIXELS, &mode_freqpixels, _data_FX_MODE_FREQPIXELS);
-  addEffect(FX_MODE_NOISEFIRE, &mode_noisefire, _data_FX_MODE_NOISEFIRE);
-  addEffect(FX_MODE_PUDDLEPEAK, &mode_puddlepeak, _data_FX_MODE_PUDDLEPEAK);
-  addEffect(FX_MODE_NOISEMOVE, &mode_noisemove, _data_FX_MODE_NOISEMOVE);
-  addEffect(FX_MODE_PERLINMOVE, &mode_perlinmove, _data_FX_MODE_PERLINMOVE);
-  addEffect(FX_MODE_RIPPLEPEAK, &mode_ripplepeak, _data_FX_MODE_RIPPLEPEAK);
-  addEffect(FX_MODE_FREQMAP, &mode_freqmap, _data_FX_MODE_FREQMAP);
-  addEffect(FX_MODE_GRAVCENTER, &mode_gravcenter, _data_FX_MODE_GRAVCENTER);
-  addEffect(FX_MODE_GRAVCENTRIC, &mode_gravcentric, _data_FX_MODE_GRAVCENTRIC);
-  addEffect(FX_MODE_GRAVFREQ, &mode_gravfreq, _data_FX_MODE_GRAVFREQ);
-  addEffect(FX_MODE_DJLIGHT, &mode_DJLight, _data_FX_MODE_DJLIGHT);
-  addEffect(FX_MODE_BLURZ, &mode_blurz, _data_FX_MODE_BLURZ);
-  addEffect(FX_MODE_FLOWSTRIPE, &mode_FlowStripe, _data_FX_MODE_FLOWSTRIPE);
-  addEffect(FX_MODE_WAVESINS, &mode_wavesins, _data_FX_MODE_WAVESINS);
-  addEffect(FX_MODE_ROCKTAVES, &mode_rocktaves, _data_FX_MODE_ROCKTAVES);
-  addEffect(FX_MODE_SHIMMER, &mode_shimmer, _data_FX_MODE_SHIMMER);
-
-  // --- 2D  effects ---
+static constexpr char _data_RESERVED[] PROGMEM = "RSVD";
+static constexpr EffectInfo _info_RESERVED = fxParse(_data_RESERVED);
+
+// effect registry (fx_registry.h), usermods add their effects to the same array
+DECLARE_DYNARRAY(EffectEntry, effects);
+
+// Solid must have id 0
+REGISTER_EFFECT(FX_MODE_STATIC, mode_static, _data_FX_MODE_STATIC);
+REGISTER_EFFECT(FX_MODE_COPY, mode_copy_segment, _data_FX_MODE_COPY);
+// --- 1D non-audio effects ---
+REGISTER_EFFECT(FX_MODE_BLINK, mode_blink, _data_FX_MODE_BLINK);
+REGISTER_EFFECT(FX_MODE_BREATH, mode_breath, _data_FX_MODE_BREATH);
+REGISTER_EFFECT(FX_MODE_COLOR_WIPE, mode_color_wipe, _data_FX_MODE_COLOR_WIPE);
+REGISTER_EFFECT(FX_MODE_COLOR_WIPE_RANDOM, mode_color_wipe_random, _data_FX_MODE_COLOR_WIPE_RANDOM);
+REGISTER_EFFECT(FX_MODE_RANDOM_COLOR, mode_random_color, _data_FX_MODE_RANDOM_COLOR);
+REGISTER_EFFECT(FX_MODE_COLOR_SWEEP, mode_color_sweep, _data_FX_MODE_COLOR_SWEEP);
+REGISTER_EFFECT(FX_MODE_DYNAMIC, mode_dynamic, _data_FX_MODE_DYNAMIC);
+REGISTER_EFFECT(FX_MODE_RAINBOW, mode_rainbow, _data_FX_MODE_RAINBOW);
+REGISTER_EFFECT(FX_MODE_RAINBOW_CYCLE, mode_rainbow_cycle, _data_FX_MODE_RAINBOW_CYCLE);
+REGISTER_EFFECT(FX_MODE_SCAN, mode_scan, _data_FX_MODE_SCAN);
+REGISTER_EFFECT(FX_MODE_DUAL_SCAN, mode_dual_scan, _data_FX_MODE_DUAL_SCAN);
+REGISTER_EFFECT(FX_MODE_FADE, mode_fade, _data_FX_MODE_FADE);
+REGISTER_EFFECT(FX_MODE_THEATER_CHASE, mode_theater_chase, _data_FX_MODE_THEATER_CHASE);
+REGISTER_EFFECT(FX_MODE_THEATER_CHASE_RAINBOW, mode_theater_chase_rainbow, _data_FX_MODE_THEATER_CHASE_RAINBOW);
+REGISTER_EFFECT(FX_MODE_RUNNING_LIGHTS, mode_running_lights, _data_FX_MODE_RUNNING_LIGHTS);
+REGISTER_EFFECT(FX_MODE_SAW, mode_saw, _data_FX_MODE_SAW);
+REGISTER_EFFECT(FX_MODE_TWINKLE, mode_twinkle, _data_FX_MODE_TWINKLE);
+REGISTER_EFFECT(FX_MODE_DISSOLVE, mode_dissolve, _data_FX_MODE_DISSOLVE);
+REGISTER_EFFECT(FX_MODE_DISSOLVE_RANDOM, mode_dissolve_random, _data_FX_MODE_DISSOLVE_RANDOM);
+REGISTER_EFFECT(FX_MODE_FLASH_SPARKLE, mode_flash_sparkle, _data_FX_MODE_FLASH_SPARKLE);
+REGISTER_EFFECT(FX_MODE_HYPER_SPARKLE, mode_hyper_sparkle, _data_FX_MODE_HYPER_SPARKLE);
+REGISTER_EFFECT(FX_MODE_STROBE, mode_strobe, _data_FX_MODE_STROBE);
+REGISTER_EFFECT(FX_MODE_STROBE_RAINBOW, mode_strobe_rainbow, _data_FX_MODE_STROBE_RAINBOW);
+REGISTER_EFFECT(FX_MODE_MULTI_STROBE, mode_multi_strobe, _data_FX_MODE_MULTI_STROBE);
+REGISTER_EFFECT(FX_MODE_BLINK_RAINBOW, mode_blink_rainbow, _data_FX_MODE_BLINK_RAINBOW);
+REGISTER_EFFECT(FX_MODE_ANDROID, mode_android, _data_FX_MODE_ANDROID);
+REGISTER_EFFECT(FX_MODE_CHASE_COLOR, mode_chase_color, _data_FX_MODE_CHASE_COLOR);
+REGISTER_EFFECT(FX_MODE_CHASE_RANDOM, mode_chase_random, _data_FX_MODE_CHASE_RANDOM);
+REGISTER_EFFECT(FX_MODE_CHASE_RAINBOW, mode_chase_rainbow, _data_FX_MODE_CHASE_RAINBOW);
+REGISTER_EFFECT(FX_MODE_CHASE_FLASH, mode_chase_flash, _data_FX_MODE_CHASE_FLASH);
+REGISTER_EFFECT(FX_MODE_CHASE_FLASH_RANDOM, mode_chase_flash_random, _data_FX_MODE_CHASE_FLASH_RANDOM);
+REGISTER_EFFECT(FX_MODE_CHASE_RAINBOW_WHITE, mode_chase_rainbow_white, _data_FX_MODE_CHASE_RAINBOW_WHITE);
+REGISTER_EFFECT(FX_MODE_COLORFUL, mode_colorful, _data_FX_MODE_COLORFUL);
+REGISTER_EFFECT(FX_MODE_TRAFFIC_LIGHT, mode_traffic_light, _data_FX_MODE_TRAFFIC_LIGHT);
+REGISTER_EFFECT(FX_MODE_COLOR_SWEEP_RANDOM, mode_color_sweep_random, _data_FX_MODE_COLOR_SWEEP_RANDOM);
+REGISTER_EFFECT(FX_MODE_RUNNING_COLOR, mode_running_color, _data_FX_MODE_RUNNING_COLOR);
+REGISTER_EFFECT(FX_MODE_AURORA, mode_aurora, _data_FX_MODE_AURORA);
+REGISTER_EFFECT(FX_MODE_COLORCLOUDS, mode_ColorClouds, _data_FX_MODE_COLORCLOUDS);
+REGISTER_EFFECT(FX_MODE_RUNNING_RANDOM, mode_running_random, _data_FX_MODE_RUNNING_RANDOM);
+REGISTER_EFFECT(FX_MODE_LARSON_SCANNER, mode_larson_scanner, _data_FX_MODE_LARSON_SCANNER);
+REGISTER_EFFECT(FX_MODE_RAIN, mode_rain, _data_FX_MODE_RAIN);
+REGISTER_EFFECT(FX_MODE_PRIDE_2015, mode_pride_2015, _data_FX_MODE_PRIDE_2015);
+REGISTER_EFFECT(FX_MODE_COLORWAVES, mode_colorwaves, _data_FX_MODE_COLORWAVES);
+REGISTER_EFFECT(FX_MODE_FIREWORKS, mode_fireworks, _data_FX_MODE_FIREWORKS);
+REGISTER_EFFECT(FX_MODE_TETRIX, mode_tetrix, _data_FX_MODE_TETRIX);
+REGISTER_EFFECT(FX_MODE_FIRE_FLICKER, mode_fire_flicker, _data_FX_MODE_FIRE_FLICKER);
+REGISTER_EFFECT(FX_MODE_GRADIENT, mode_gradient, _data_FX_MODE_GRADIENT);
+REGISTER_EFFECT(FX_MODE_LOADING, mode_loading, _data_FX_MODE_LOADING);
+REGISTER_EFFECT(FX_MODE_FAIRY, mode_fairy, _data_FX_MODE_FAIRY);
+REGISTER_EFFECT(FX_MODE_TWO_DOTS, mode_two_dots, _data_FX_MODE_TWO_DOTS);
+REGISTER_EFFECT(FX_MODE_FAIRYTWINKLE, mode_fairytwinkle, _data_FX_MODE_FAIRYTWINKLE);
+REGISTER_EFFECT(FX_MODE_RUNNING_DUAL, mode_running_dual, _data_FX_MODE_RUNNING_DUAL);
+#ifdef WLED_ENABLE_GIF
+REGISTER_EFFECT(FX_MODE_IMAGE, mode_image, _data_FX_MODE_IMAGE);
+#endif
+REGISTER_EFFECT(FX_MODE_TRICOLOR_CHASE, mode_tricolor_chase, _data_FX_MODE_TRICOLOR_CHASE);
+REGISTER_EFFECT(FX_MODE_TRICOLOR_WIPE, mode_tricolor_wipe, _data_FX_MODE_TRICOLOR_WIPE);
+REGISTER_EFFECT(FX_MODE_TRICOLOR_FADE, mode_tricolor_fade, _data_FX_MODE_TRICOLOR_FADE);
+REGISTER_EFFECT(FX_MODE_LIGHTNING, mode_lightning, _data_FX_MODE_LIGHTNING);
+REGISTER_EFFECT(FX_MODE_ICU, mode_icu, _data_FX_MODE_ICU);
+REGISTER_EFFECT(FX_MODE_DUAL_LARSON_SCANNER, mode_dual_larson_scanner, _data_FX_MODE_DUAL_LARSON_SCANNER);
+REGISTER_EFFECT(FX_MODE_RANDOM_CHASE, mode_random_chase, _data_FX_MODE_RANDOM_CHASE);
+REGISTER_EFFECT(FX_MODE_OSCILLATE, mode_oscillate, _data_FX_MODE_OSCILLATE);
+REGISTER_EFFECT(FX_MODE_JUGGLE, mode_juggle, _data_FX_MODE_JUGGLE);
+REGISTER_EFFECT(FX_MODE_PALETTE, mode_palette, _data_FX_MODE_PALETTE);
+REGISTER_EFFECT(FX_MODE_BPM, mode_bpm, _data_FX_MODE_BPM);
+REGISTER_EFFECT(FX_MODE_FILLNOISE8, mode_fillnoise8, _data_FX_MODE_FILLNOISE8);
+REGISTER_EFFECT(FX_MODE_NOISE16_1, mode_noise16_1, _data_FX_MODE_NOISE16_1);
+REGISTER_EFFECT(FX_MODE_NOISE16_2, mode_noise16_2, _data_FX_MODE_NOISE16_2);
+REGISTER_EFFECT(FX_MODE_NOISE16_3, mode_noise16_3, _data_FX_MODE_NOISE16_3);
+REGISTER_EFFECT(FX_MODE_NOISE16_4, mode_noise16_4, _data_FX_MODE_NOISE16_4);
+REGISTER_EFFECT(FX_MODE_COLORTWINKLE, mode_colortwinkle, _data_FX_MODE_COLORTWINKLE);
+REGISTER_EFFECT(FX_MODE_LAKE, mode_lake, _data_FX_MODE_LAKE);
+REGISTER_EFFECT(FX_MODE_METEOR, mode_meteor, _data_FX_MODE_METEOR);
+//REGISTER_EFFECT(FX_MODE_METEOR_SMOOTH, mode_meteor_smooth, _data_FX_MODE_METEOR_SMOOTH); // merged with mode_meteor 
+REGISTER_EFFECT(FX_MODE_RAILWAY, mode_railway, _data_FX_MODE_RAILWAY);
+REGISTER_EFFECT(FX_MODE_RIPPLE, mode_ripple, _data_FX_MODE_RIPPLE);
+REGISTER_EFFECT(FX_MODE_TWINKLEFOX, mode_twinklefox, _data_FX_MODE_TWINKLEFOX);
+REGISTER_EFFECT(FX_MODE_TWINKLECAT, mode_twinklecat, _data_FX_MODE_TWINKLECAT);
+REGISTER_EFFECT(FX_MODE_HALLOWEEN_EYES, mode_halloween_eyes, _data_FX_MODE_HALLOWEEN_EYES);
+REGISTER_EFFECT(FX_MODE_STATIC_PATTERN, mode_static_pattern, _data_FX_MODE_STATIC_PATTERN);
+REGISTER_EFFECT(FX_MODE_TRI_STATIC_PATTERN, mode_tri_static_pattern, _data_FX_MODE_TRI_STATIC_PATTERN);
+REGISTER_EFFECT(FX_MODE_SPOTS, mode_spots, _data_FX_MODE_SPOTS);
+REGISTER_EFFECT(FX_MODE_SPOTS_FADE, mode_spots_fade, _data_FX_MODE_SPOTS_FADE);
+REGISTER_EFFECT(FX_MODE_COMET, mode_comet, _data_FX_MODE_COMET);
+#if defined(WLED_PS_DONT_REPLACE_1D_FX) || defined(WLED_PS_DONT_REPLACE_2D_FX)
+REGISTER_EFFECT(FX_MODE_FIRE_2012, mode_fire_2012, _data_FX_MODE_FIRE_2012);
+REGISTER_EFFECT(FX_MODE_EXPLODING_FIREWORKS, mode_exploding_fireworks, _data_FX_MODE_EXPLODING_FIREWORKS);
+#endif
+REGISTER_EFFECT(FX_MODE_SPARKLE, mode_sparkle, _data_FX_MODE_SPARKLE);
+REGISTER_EFFECT(FX_MODE_GLITTER, mode_glitter, _data_FX_MODE_GLITTER);
+REGISTER_EFFECT(FX_MODE_SOLID_GLITTER, mode_solid_glitter, _data_FX_MODE_SOLID_GLITTER);
+REGISTER_EFFECT(FX_MODE_MULTI_COMET, mode_multi_comet, _data_FX_MODE_MULTI_COMET);  
+#ifdef WLED_PS_DONT_REPLACE_1D_FX
+REGISTER_EFFECT(FX_MODE_ROLLINGBALLS, mode_rolling_balls, _data_FX_MODE_ROLLINGBALLS);
+REGISTER_EFFECT(FX_MODE_STARBURST, mode_starburst, _data_FX_MODE_STARBURST);
+REGISTER_EFFECT(FX_MODE_DANCING_SHADOWS, mode_dancing_shadows, _data_FX_MODE_DANCING_SHADOWS);
+#endif
+REGISTER_EFFECT(FX_MODE_CANDLE, mode_candle, _data_FX_MODE_CANDLE);
+REGISTER_EFFECT(FX_MODE_BOUNCINGBALLS, mode_bouncing_balls, _data_FX_MODE_BOUNCINGBALLS);
+REGISTER_EFFECT(FX_MODE_POPCORN, mode_popcorn, _data_FX_MODE_POPCORN);
+REGISTER_EFFECT(FX_MODE_DRIP, mode_drip, _data_FX_MODE_DRIP);
+REGISTER_EFFECT(FX_MODE_SINELON, mode_sinelon, _data_FX_MODE_SINELON);
+REGISTER_EFFECT(FX_MODE_SINELON_DUAL, mode_sinelon_dual, _data_FX_MODE_SINELON_DUAL);
+REGISTER_EFFECT(FX_MODE_SINELON_RAINBOW, mode_sinelon_rainbow, _data_FX_MODE_SINELON_RAINBOW);
+REGISTER_EFFECT(FX_MODE_PLASMA, mode_plasma, _data_FX_MODE_PLASMA);
+REGISTER_EFFECT(FX_MODE_PERCENT, mode_percent, _data_FX_MODE_PERCENT);
+REGISTER_EFFECT(FX_MODE_RIPPLE_RAINBOW, mode_ripple_rainbow, _data_FX_MODE_RIPPLE_RAINBOW);
+REGISTER_EFFECT(FX_MODE_HEARTBEAT, mode_heartbeat, _data_FX_MODE_HEARTBEAT);
+REGISTER_EFFECT(FX_MODE_PACIFICA, mode_pacifica, _data_FX_MODE_PACIFICA);
+REGISTER_EFFECT(FX_MODE_CANDLE_MULTI, mode_candle_multi, _data_FX_MODE_CANDLE_MULTI);
+REGISTER_EFFECT(FX_MODE_SUNRISE, mode_sunrise, _data_FX_MODE_SUNRISE);
+REGISTER_EFFECT(FX_MODE_PHASED, mode_phased, _data_FX_MODE_PHASED);
+REGISTER_EFFECT(FX_MODE_TWINKLEUP, mode_twinkleup, _data_FX_MODE_TWINKLEUP);
+REGISTER_EFFECT(FX_MODE_NOISEPAL, mode_noisepal, _data_FX_MODE_NOISEPAL);
+REGISTER_EFFECT(FX_MODE_SINEWAVE, mode_sinewave, _data_FX_MODE_SINEWAVE);
+REGISTER_EFFECT(FX_MODE_PHASEDNOISE, mode_phased_noise, _data_FX_MODE_PHASEDNOISE);
+REGISTER_EFFECT(FX_MODE_FLOW, mode_flow, _data_FX_MODE_FLOW);
+REGISTER_EFFECT(FX_MODE_CHUNCHUN, mode_chunchun, _data_FX_MODE_CHUNCHUN);  
+REGISTER_EFFECT(FX_MODE_WASHING_MACHINE, mode_washing_machine, _data_FX_MODE_WASHING_MACHINE);
+REGISTER_EFFECT(FX_MODE_BLENDS, mode_blends, _data_FX_MODE_BLENDS);
+REGISTER_EFFECT(FX_MODE_TV_SIMULATOR, mode_tv_simulator, _data_FX_MODE_TV_SIMULATOR);
+REGISTER_EFFECT(FX_MODE_DYNAMIC_SMOOTH, mode_dynamic_smooth, _data_FX_MODE_DYNAMIC_SMOOTH);
+REGISTER_EFFECT(FX_MODE_PACMAN, mode_pacman, _data_FX_MODE_PACMAN);
+REGISTER_EFFECT(FX_MODE_SLOW_TRANSITION, mode_slow_transition, _data_FX_MODE_SLOW_TRANSITION);
+
+// --- 1D audio effects ---
+REGISTER_EFFECT(FX_MODE_PIXELS, mode_pixels, _data_FX_MODE_PIXELS);
+REGISTER_EFFECT(FX_MODE_PIXELWAVE, mode_pixelwave, _data_FX_MODE_PIXELWAVE);
+REGISTER_EFFECT(FX_MODE_JUGGLES, mode_juggles, _data_FX_MODE_JUGGLES);
+REGISTER_EFFECT(FX_MODE_MATRIPIX, mode_matripix, _data_FX_MODE_MATRIPIX);
+REGISTER_EFFECT(FX_MODE_GRAVIMETER, mode_gravimeter, _data_FX_MODE_GRAVIMETER);
+REGISTER_EFFECT(FX_MODE_PLASMOID, mode_plasmoid, _data_FX_MODE_PLASMOID);
+REGISTER_EFFECT(FX_MODE_PUDDLES, mode_puddles, _data_FX_MODE_PUDDLES);
+REGISTER_EFFECT(FX_MODE_MIDNOISE, mode_midnoise, _data_FX_MODE_MIDNOISE);
+REGISTER_EFFECT(FX_MODE_NOISEMETER, mode_noisemeter, _data_FX_MODE_NOISEMETER);
+REGISTER_EFFECT(FX_MODE_FREQWAVE, mode_freqwave, _data_FX_MODE_FREQWAVE);
+REGISTER_EFFECT(FX_MODE_FREQMATRIX, mode_freqmatrix, _data_FX_MODE_FREQMATRIX);
+REGISTER_EFFECT(FX_MODE_WATERFALL, mode_waterfall, _data_FX_MODE_WATERFALL);
+REGISTER_EFFECT(FX_MODE_FREQPIXELS, mode_freqpixels, _data_FX_MODE_FREQPIXELS);
+REGISTER_EFFECT(FX_MODE_NOISEFIRE, mode_noisefire, _data_FX_MODE_NOISEFIRE);
+REGISTER_EFFECT(FX_MODE_PUDDLEPEAK, mode_puddlepeak, _data_FX_MODE_PUDDLEPEAK);
+REGISTER_EFFECT(FX_MODE_NOISEMOVE, mode_noisemove, _data_FX_MODE_NOISEMOVE);
+REGISTER_EFFECT(FX_MODE_PERLINMOVE, mode_perlinmove, _data_FX_MODE_PERLINMOVE);
+REGISTER_EFFECT(FX_MODE_RIPPLEPEAK, mode_ripplepeak, _data_FX_MODE_RIPPLEPEAK);
+REGISTER_EFFECT(FX_MODE_FREQMAP, mode_freqmap, _data_FX_MODE_FREQMAP);
+REGISTER_EFFECT(FX_MODE_GRAVCENTER, mode_gravcenter, _data_FX_MODE_GRAVCENTER);
+REGISTER_EFFECT(FX_MODE_GRAVCENTRIC, mode_gravcentric, _data_FX_MODE_GRAVCENTRIC);
+REGISTER_EFFECT(FX_MODE_GRAVFREQ, mode_gravfreq, _data_FX_MODE_GRAVFREQ);
+REGISTER_EFFECT(FX_MODE_DJLIGHT, mode_DJLight, _data_FX_MODE_DJLIGHT);
+REGISTER_EFFECT(FX_MODE_BLURZ, mode_blurz, _data_FX_MODE_BLURZ);
+REGISTER_EFFECT(FX_MODE_FLOWSTRIPE, mode_FlowStripe, _data_FX_MODE_FLOWSTRIPE);
+REGISTER_EFFECT(FX_MODE_WAVESINS, mode_wavesins, _data_FX_MODE_WAVESINS);
+REGISTER_EFFECT(FX_MODE_ROCKTAVES, mode_rocktaves, _data_FX_MODE_ROCKTAVES);
+REGISTER_EFFECT(FX_MODE_SHIMMER, mode_shimmer, _data_FX_MODE_SHIMMER);
+
+// --- 2D  effects ---
 #ifndef WLED_DISABLE_2D
-  addEffect(FX_MODE_2DPLASMAROTOZOOM, &mode_2Dplasmarotozoom, _data_FX_MODE_2DPLASMAROTOZOOM);
-  addEffect(FX_MODE_2DSPACESHIPS, &mode_2Dspaceships, _data_FX_MODE_2DSPACESHIPS);
-  addEffect(FX_MODE_2DCRAZYBEES, &mode_2Dcrazybees, _data_FX_MODE_2DCRAZYBEES);
+REGISTER_EFFECT(FX_MODE_2DPLASMAROTOZOOM, mode_2Dplasmarotozoom, _data_FX_MODE_2DPLASMAROTOZOOM);
+REGISTER_EFFECT(FX_MODE_2DSPACESHIPS, mode_2Dspaceships, _data_FX_MODE_2DSPACESHIPS);
+REGISTER_EFFECT(FX_MODE_2DCRAZYBEES, mode_2Dcrazybees, _data_FX_MODE_2DCRAZYBEES);
 
-  #ifdef WLED_PS_DONT_REPLACE_2D_FX
-  addEffect(FX_MODE_2DGHOSTRIDER, &mode_2Dghostrider, _data_FX_MODE_2DGHOSTRIDER);
-  addEffect(FX_MODE_2DBLOBS, &mode_2Dfloatingblobs, _data_FX_MODE_2DBLOBS);
-  #endif
+#ifdef WLED_PS_DONT_REPLACE_2D_FX
+REGISTER_EFFECT(FX_MODE_2DGHOSTRIDER, mode_2Dghostrider, _data_FX_MODE_2DGHOSTRIDER);
+REGISTER_EFFECT(FX_MODE_2DBLOBS, mode_2Dfloatingblobs, _data_FX_MODE_2DBLOBS);
+#endif
 
-  addEffect(FX_MODE_2DSCROLLTEXT, &mode_2Dscrollingtext, _data_FX_MODE_2DSCROLLTEXT);
-  addEffect(FX_MODE_2DDRIFTROSE, &mode_2Ddriftrose, _data_FX_MODE_2DDRIFTROSE);
-  addEffect(FX_MODE_2DDISTORTIONWAVES, &mode_2Ddistortionwaves, _data_FX_MODE_2DDISTORTIONWAVES);
-  addEffect(FX_MODE_2DGEQ, &mode_2DGEQ, _data_FX_MODE_2DGEQ); // audio
-  addEffect(FX_MODE_2DNOISE, &mode_2Dnoise, _data_FX_MODE_2DNOISE);
-  addEffect(FX_MODE_2DFIRENOISE, &mode_2Dfirenoise, _data_FX_MODE_2DFIRENOISE);
-  addEffect(FX_MODE_2DSQUAREDSWIRL, &mode_2Dsquaredswirl, _data_FX_MODE_2DSQUAREDSWIRL);
-
-  //non audio
-  addEffect(FX_MODE_2DDNA, &mode_2Ddna, _data_FX_MODE_2DDNA);
-  addEffect(FX_MODE_2DMATRIX, &mode_2Dmatrix, _data_FX_MODE_2DMATRIX);
-  addEffect(FX_MODE_2DMETABALLS, &mode_2Dmetaballs, _data_FX_MODE_2DMETABALLS);
-  addEffect(FX_MODE_2DFUNKYPLANK, &mode_2DFunkyPlank, _data_FX_MODE_2DFUNKYPLANK); // audio
-  addEffect(FX_MODE_2DPULSER, &mode_2DPulser, _data_FX_MODE_2DPULSER);
-  addEffect(FX_MODE_2DDRIFT, &mode_2DDrift, _data_FX_MODE_2DDRIFT);
-  addEffect(FX_MODE_2DWAVERLY, &mode_2DWaverly, _data_FX_MODE_2DWAVERLY); // audio
-  addEffect(FX_MODE_2DSUNRADIATION, &mode_2DSunradiation, _data_FX_MODE_2DSUNRADIATION);
-  addEffect(FX_MODE_2DCOLOREDBURSTS, &mode_2DColoredBursts, _data_FX_MODE_2DCOLOREDBURSTS);
-  addEffect(FX_MODE_2DJULIA, &mode_2DJulia, _data_FX_MODE_2DJULIA);
-  addEffect(FX_MODE_2DGAMEOFLIFE, &mode_2Dgameoflife, _data_FX_MODE_2DGAMEOFLIFE);
-  addEffect(FX_MODE_2DTARTAN, &mode_2Dtartan, _data_FX_MODE_2DTARTAN);
-  addEffect(FX_MODE_2DPOLARLIGHTS, &mode_2DPolarLights, _data_FX_MODE_2DPOLARLIGHTS);
-  addEffect(FX_MODE_2DSWIRL, &mode_2DSwirl, _data_FX_MODE_2DSWIRL); // audio
-  addEffect(FX_MODE_2DLISSAJOUS, &mode_2DLissajous, _data_FX_MODE_2DLISSAJOUS);
-  addEffect(FX_MODE_2DFRIZZLES, &mode_2DFrizzles, _data_FX_MODE_2DFRIZZLES);
-  addEffect(FX_MODE_2DPLASMABALL, &mode_2DPlasmaball, _data_FX_MODE_2DPLASMABALL);
-  addEffect(FX_MODE_2DHIPHOTIC, &mode_2DHiphotic, _data_FX_MODE_2DHIPHOTIC);
-  addEffect(FX_MODE_2DSINDOTS, &mode_2DSindots, _data_FX_MODE_2DSINDOTS);
-  addEffect(FX_MODE_2DDNASPIRAL, &mode_2DDNASpiral, _data_FX_MODE_2DDNASPIRAL);
-  addEffect(FX_MODE_2DBLACKHOLE, &mode_2DBlackHole, _data_FX_MODE_2DBLACKHOLE);
-  addEffect(FX_MODE_2DSOAP, &mode_2Dsoap, _data_FX_MODE_2DSOAP);
-  addEffect(FX_MODE_2DOCTOPUS, &mode_2Doctopus, _data_FX_MODE_2DOCTOPUS);
-  addEffect(FX_MODE_2DWAVINGCELL, &mode_2Dwavingcell, _data_FX_MODE_2DWAVINGCELL);
-  addEffect(FX_MODE_2DAKEMI, &mode_2DAkemi, _data_FX_MODE_2DAKEMI); // audio
+REGISTER_EFFECT(FX_MODE_2DSCROLLTEXT, mode_2Dscrollingtext, _data_FX_MODE_2DSCROLLTEXT);
+REGISTER_EFFECT(FX_MODE_2DDRIFTROSE, mode_2Ddriftrose, _data_FX_MODE_2DDRIFTROSE);
+REGISTER_EFFECT(FX_MODE_2DDISTORTIONWAVES, mode_2Ddistortionwaves, _data_FX_MODE_2DDISTORTIONWAVES);
+REGISTER_EFFECT(FX_MODE_2DGEQ, mode_2DGEQ, _data_FX_MODE_2DGEQ); // audio
+REGISTER_EFFECT(FX_MODE_2DNOISE, mode_2Dnoise, _data_FX_MODE_2DNOISE);
+REGISTER_EFFECT(FX_MODE_2DFIRENOISE, mode_2Dfirenoise, _data_FX_MODE_2DFIRENOISE);
+REGISTER_EFFECT(FX_MODE_2DSQUAREDSWIRL, mode_2Dsquaredswirl, _data_FX_MODE_2DSQUAREDSWIRL);
+
+//non audio
+REGISTER_EFFECT(FX_MODE_2DDNA, mode_2Ddna, _data_FX_MODE_2DDNA);
+REGISTER_EFFECT(FX_MODE_2DMATRIX, mode_2Dmatrix, _data_FX_MODE_2DMATRIX);
+REGISTER_EFFECT(FX_MODE_2DMETABALLS, mode_2Dmetaballs, _data_FX_MODE_2DMETABALLS);
+REGISTER_EFFECT(FX_MODE_2DFUNKYPLANK, mode_2DFunkyPlank, _data_FX_MODE_2DFUNKYPLANK); // audio
+REGISTER_EFFECT(FX_MODE_2DPULSER, mode_2DPulser, _data_FX_MODE_2DPULSER);
+REGISTER_EFFECT(FX_MODE_2DDRIFT, mode_2DDrift, _data_FX_MODE_2DDRIFT);
+REGISTER_EFFECT(FX_MODE_2DWAVERLY, mode_2DWaverly, _data_FX_MODE_2DWAVERLY); // audio
+REGISTER_EFFECT(FX_MODE_2DSUNRADIATION, mode_2DSunradiation, _data_FX_MODE_2DSUNRADIATION);
+REGISTER_EFFECT(FX_MODE_2DCOLOREDBURSTS, mode_2DColoredBursts, _data_FX_MODE_2DCOLOREDBURSTS);
+REGISTER_EFFECT(FX_MODE_2DJULIA, mode_2DJulia, _data_FX_MODE_2DJULIA);
+REGISTER_EFFECT(FX_MODE_2DGAMEOFLIFE, mode_2Dgameoflife, _data_FX_MODE_2DGAMEOFLIFE);
+REGISTER_EFFECT(FX_MODE_2DTARTAN, mode_2Dtartan, _data_FX_MODE_2DTARTAN);
+REGISTER_EFFECT(FX_MODE_2DPOLARLIGHTS, mode_2DPolarLights, _data_FX_MODE_2DPOLARLIGHTS);
+REGISTER_EFFECT(FX_MODE_2DSWIRL, mode_2DSwirl, _data_FX_MODE_2DSWIRL); // audio
+REGISTER_EFFECT(FX_MODE_2DLISSAJOUS, mode_2DLissajous, _data_FX_MODE_2DLISSAJOUS);
+REGISTER_EFFECT(FX_MODE_2DFRIZZLES, mode_2DFrizzles, _data_FX_MODE_2DFRIZZLES);
+REGISTER_EFFECT(FX_MODE_2DPLASMABALL, mode_2DPlasmaball, _data_FX_MODE_2DPLASMABALL);
+REGISTER_EFFECT(FX_MODE_2DHIPHOTIC, mode_2DHiphotic, _data_FX_MODE_2DHIPHOTIC);
+REGISTER_EFFECT(FX_MODE_2DSINDOTS, mode_2DSindots, _data_FX_MODE_2DSINDOTS);
+REGISTER_EFFECT(FX_MODE_2DDNASPIRAL, mode_2DDNASpiral, _data_FX_MODE_2DDNASPIRAL);
+REGISTER_EFFECT(FX_MODE_2DBLACKHOLE, mode_2DBlackHole, _data_FX_MODE_2DBLACKHOLE);
+REGISTER_EFFECT(FX_MODE_2DSOAP, mode_2Dsoap, _data_FX_MODE_2DSOAP);
+REGISTER_EFFECT(FX_MODE_2DOCTOPUS, mode_2Doctopus, _data_FX_MODE_2DOCTOPUS);
+REGISTER_EFFECT(FX_MODE_2DWAVINGCELL, mode_2Dwavingcell, _data_FX_MODE_2DWAVINGCELL);
+REGISTER_EFFECT(FX_MODE_2DAKEMI, mode_2DAkemi, _data_FX_MODE_2DAKEMI); // audio
 
 #ifndef WLED_DISABLE_PARTICLESYSTEM2D
-  addEffect(FX_MODE_PARTICLEVOLCANO, &mode_particlevolcano, _data_FX_MODE_PARTICLEVOLCANO);
-  addEffect(FX_MODE_PARTICLEFIRE, &mode_particlefire, _data_FX_MODE_PARTICLEFIRE);
-  addEffect(FX_MODE_PARTICLEFIREWORKS, &mode_particlefireworks, _data_FX_MODE_PARTICLEFIREWORKS);
-  addEffect(FX_MODE_PARTICLEVORTEX, &mode_particlevortex, _data_FX_MODE_PARTICLEVORTEX);
-  addEffect(FX_MODE_PARTICLEPERLIN, &mode_particleperlin, _data_FX_MODE_PARTICLEPERLIN);
-  addEffect(FX_MODE_PARTICLEPIT, &mode_particlepit, _data_FX_MODE_PARTICLEPIT);
-  addEffect(FX_MODE_PARTICLEBOX, &mode_particlebox, _data_FX_MODE_PARTICLEBOX);
-  addEffect(FX_MODE_PARTICLEATTRACTOR, &mode_particleattractor, _data_FX_MODE_PARTICLEATTRACTOR); // 872 bytes
-  addEffect(FX_MODE_PARTICLEIMPACT, &mode_particleimpact, _data_FX_MODE_PARTICLEIMPACT);
-  addEffect(FX_MODE_PARTICLEWATERFALL, &mode_particlewaterfall, _data_FX_MODE_PARTICLEWATERFALL);
-  addEffect(FX_MODE_PARTICLESPRAY, &mode_particlespray, _data_FX_MODE_PARTICLESPRAY);
-  addEffect(FX_MODE_PARTICLESGEQ, &mode_particleGEQ, _data_FX_MODE_PARTICLEGEQ);
-  addEffect(FX_MODE_PARTICLECENTERGEQ, &mode_particlecenterGEQ, _data_FX_MODE_PARTICLECIRCULARGEQ);
-  addEffect(FX_MODE_PARTICLEGHOSTRIDER, &mode_particleghostrider, _data_FX_MODE_PARTICLEGHOSTRIDER);
-  addEffect(FX_MODE_PARTICLEBLOBS, &mode_particleblobs, _data_FX_MODE_PARTICLEBLOBS);
-  addEffect(FX_MODE_PARTICLEGALAXY, &mode_particlegalaxy, _data_FX_MODE_PARTICLEGALAXY);
+REGISTER_EFFECT(FX_MODE_PARTICLEVOLCANO, mode_particlevolcano, _data_FX_MODE_PARTICLEVOLCANO);
+REGISTER_EFFECT(FX_MODE_PARTICLEFIRE, mode_particlefire, _data_FX_MODE_PARTICLEFIRE);
+REGISTER_EFFECT(FX_MODE_PARTICLEFIREWORKS, mode_particlefireworks, _data_FX_MODE_PARTICLEFIREWORKS);
+REGISTER_EFFECT(FX_MODE_PARTICLEVORTEX, mode_particlevortex, _data_FX_MODE_PARTICLEVORTEX);
+REGISTER_EFFECT(FX_MODE_PARTICLEPERLIN, mode_particleperlin, _data_FX_MODE_PARTICLEPERLIN);
+REGISTER_EFFECT(FX_MODE_PARTICLEPIT, mode_particlepit, _data_FX_MODE_PARTICLEPIT);
+REGISTER_EFFECT(FX_MODE_PARTICLEBOX, mode_particlebox, _data_FX_MODE_PARTICLEBOX);
+REGISTER_EFFECT(FX_MODE_PARTICLEATTRACTOR, mode_particleattractor, _data_FX_MODE_PARTICLEATTRACTOR); // 872 bytes
+REGISTER_EFFECT(FX_MODE_PARTICLEIMPACT, mode_particleimpact, _data_FX_MODE_PARTICLEIMPACT);
+REGISTER_EFFECT(FX_MODE_PARTICLEWATERFALL, mode_particlewaterfall, _data_FX_MODE_PARTICLEWATERFALL);
+REGISTER_EFFECT(FX_MODE_PARTICLESPRAY, mode_particlespray, _data_FX_MODE_PARTICLESPRAY);
+REGISTER_EFFECT(FX_MODE_PARTICLESGEQ, mode_particleGEQ, _data_FX_MODE_PARTICLEGEQ);
+REGISTER_EFFECT(FX_MODE_PARTICLECENTERGEQ, mode_particlecenterGEQ, _data_FX_MODE_PARTICLECIRCULARGEQ);
+REGISTER_EFFECT(FX_MODE_PARTICLEGHOSTRIDER, mode_particleghostrider, _data_FX_MODE_PARTICLEGHOSTRIDER);
+REGISTER_EFFECT(FX_MODE_PARTICLEBLOBS, mode_particleblobs, _data_FX_MODE_PARTICLEBLOBS);
+REGISTER_EFFECT(FX_MODE_PARTICLEGALAXY, mode_particlegalaxy, _data_FX_MODE_PARTICLEGALAXY);
 #endif // WLED_DISABLE_PARTICLESYSTEM2D
 #endif // WLED_DISABLE_2D
 
 #ifndef WLED_DISABLE_PARTICLESYSTEM1D
-addEffect(FX_MODE_PSDRIP, &mode_particleDrip, _data_FX_MODE_PARTICLEDRIP);
-addEffect(FX_MODE_PSPINBALL, &mode_particlePinball, _data_FX_MODE_PSPINBALL); //potential replacement for: bouncing balls, rollingballs, popcorn
-addEffect(FX_MODE_PSDANCINGSHADOWS, &mode_particleDancingShadows, _data_FX_MODE_PARTICLEDANCINGSHADOWS);
-addEffect(FX_MODE_PSFIREWORKS1D, &mode_particleFireworks1D, _data_FX_MODE_PS_FIREWORKS1D);
-addEffect(FX_MODE_PSSPARKLER, &mode_particleSparkler, _data_FX_MODE_PS_SPARKLER);
-addEffect(FX_MODE_PSHOURGLASS, &mode_particleHourglass, _data_FX_MODE_PS_HOURGLASS);
-addEffect(FX_MODE_PS1DSPRAY, &mode_particle1Dspray, _data_FX_MODE_PS_1DSPRAY);
-addEffect(FX_MODE_PSBALANCE, &mode_particleBalance, _data_FX_MODE_PS_BALANCE);
-addEffect(FX_MODE_PSCHASE, &mode_particleChase, _data_FX_MODE_PS_CHASE);
-addEffect(FX_MODE_PSSTARBURST, &mode_particleStarburst, _data_FX_MODE_PS_STARBURST);
-addEffect(FX_MODE_PS1DGEQ, &mode_particle1DGEQ, _data_FX_MODE_PS_1D_GEQ);
-addEffect(FX_MODE_PSFIRE1D, &mode_particleFire1D, _data_FX_MODE_PS_FIRE1D);
-addEffect(FX_MODE_PS1DSONICSTREAM, &mode_particle1DsonicStream, _data_FX_MODE_PS_SONICSTREAM);
-addEffect(FX_MODE_PS1DSONICBOOM, &mode_particle1DsonicBoom, _data_FX_MODE_PS_SONICBOOM);
-addEffect(FX_MODE_PS1DSPRINGY, &mode_particleSpringy, _data_FX_MODE_PS_SPRINGY);
+REGISTER_EFFECT(FX_MODE_PSDRIP, mode_particleDrip, _data_FX_MODE_PARTICLEDRIP);
+REGISTER_EFFECT(FX_MODE_PSPINBALL, mode_particlePinball, _data_FX_MODE_PSPINBALL); //potential replacement for: bouncing balls, rollingballs, popcorn
+REGISTER_EFFECT(FX_MODE_PSDANCINGSHADOWS, mode_particleDancingShadows, _data_FX_MODE_PARTICLEDANCINGSHADOWS);
+REGISTER_EFFECT(FX_MODE_PSFIREWORKS1D, mode_particleFireworks1D, _data_FX_MODE_PS_FIREWORKS1D);
+REGISTER_EFFECT(FX_MODE_PSSPARKLER, mode_particleSparkler, _data_FX_MODE_PS_SPARKLER);
+REGISTER_EFFECT(FX_MODE_PSHOURGLASS, mode_particleHourglass, _data_FX_MODE_PS_HOURGLASS);
+REGISTER_EFFECT(FX_MODE_PS1DSPRAY, mode_particle1Dspray, _data_FX_MODE_PS_1DSPRAY);
+REGISTER_EFFECT(FX_MODE_PSBALANCE, mode_particleBalance, _data_FX_MODE_PS_BALANCE);
+REGISTER_EFFECT(FX_MODE_PSCHASE, mode_particleChase, _data_FX_MODE_PS_CHASE);
+REGISTER_EFFECT(FX_MODE_PSSTARBURST, mode_particleStarburst, _data_FX_MODE_PS_STARBURST);
+REGISTER_EFFECT(FX_MODE_PS1DGEQ, mode_particle1DGEQ, _data_FX_MODE_PS_1D_GEQ);
+REGISTER_EFFECT(FX_MODE_PSFIRE1D, mode_particleFire1D, _data_FX_MODE_PS_FIRE1D);
+REGISTER_EFFECT(FX_MODE_PS1DSONICSTREAM, mode_particle1DsonicStream, _data_FX_MODE_PS_SONICSTREAM);
+REGISTER_EFFECT(FX_MODE_PS1DSONICBOOM, mode_particle1DsonicBoom, _data_FX_MODE_PS_SONICBOOM);
+REGISTER_EFFECT(FX_MODE_PS1DSPRINGY, mode_particleSpringy, _data_FX_MODE_PS_SPRINGY);
 #endif // WLED_DISABLE_PARTICLESYSTEM1D
 
+// assign an id to entry index (registry, then _addedEffects)
+// use id==255 to find the first unassigned id, if id is not smaller than the mode count the effect is appended (regardless of id)
+// return the actual id used for the effect or 255 if it could not be added
+uint8_t WS2812FX::assignEffect(uint8_t id, unsigned index) {
+  if (id == 255) { // find empty slot
+    for (size_t i=1; i<_modeCount; i++) if (_effectIndex[i] == FX_INDEX_NONE) { id = i; break; }
+  }
+  if (id >= _modeCount) {
+    if (_modeCount == 255) return 255; // 255 is reserved for indicating the effect wasn't added
+    id = _modeCount++;
+  }
+  if (_effectIndex[id] != FX_INDEX_NONE) return 255; // do not overwrite an already added effect
+  _effectIndex[id] = index;
+  return id;
+}
+
+// add an effect at runtime (metadata is parsed once, the string must stay valid)
+uint8_t WS2812FX::addEffect(uint8_t id, mode_ptr mode_fn, const char *mode_name) {
+  if (!mode_fn || !mode_name) return 255;
+  char lineBuffer[256];
+  strncpy_P(lineBuffer, mode_name, sizeof(lineBuffer)-1);
+  lineBuffer[sizeof(lineBuffer)-1] = '\0'; // terminate string
+  const uint8_t fx = assignEffect(id, _effectsLen + _addedEffects.size());
+  if (fx == 255) return 255;
+  _addedEffects.push_back({mode_fn, mode_name, fxParse(lineBuffer), fx});
+  return fx;
+}
+
+// builds the id -> entry index of the registry, built-in effects (fixed id) first, then those with id 255
+void WS2812FX::setupEffectData() {
+  _effects    = DYNARRAY_BEGIN(effects);
+  _effectsLen = DYNARRAY_LENGTH(effects);
+  for (size_t i=0; i<255; i++) _effectIndex[i] = FX_INDEX_NONE;
+  for (unsigned pass = 0; pass < 2; pass++) {
+    for (unsigned i = 0; i < _effectsLen; i++) {
+      const uint8_t id = pgm_read_byte(&_effects[i].id); // flash
+      if ((id == 255) == (pass == 0)) continue;
+      if (assignEffect(id, i) == 255) DEBUG_PRINTF_P(PSTR("Effect %u not added.\n"), id);
+    }
+  }
+}
+
+// copy of the pre-parsed metadata, like getModeData() Solid for id 0 or out of range
+EffectInfo WS2812FX::getEffectInfo(unsigned id) const {
+  EffectInfo info;
+  const EffectEntry *fx = getEffect(id && id < _modeCount ? id : 0);
+  if (fx) memcpy_P(&info, &fx->info, sizeof(info)); // registry entries are in flash
+  else    info = _info_RESERVED;
+  return info;
 }
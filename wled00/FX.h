@@ -19,6 +19,9 @@
 #include <vector>
 #include "wled.h"
 #include "colors.h"
+#include "color16.h"
+#include "fx_registry.h"
+#include "overlay_layer.h"
 #ifdef WLED_DEBUG
   // enable additional debug output
   #if defined(WLED_DEBUG_HOST)
@@ -415,6 +418,14 @@ typedef enum mapping1D2D {
 class WS2812FX;
 class FontManager;
 
+#ifdef WLED_ENABLE_FX_ARENA
+#include "fx_arena.h"
+#ifndef WLED_FX_ARENA_SIZE
+  // data limit plus block headers of effect data and transition copies of all segments
+  #define WLED_FX_ARENA_SIZE (MAX_SEGMENT_DATA + 2 * MAX_NUM_SEGMENTS * FX_ARENA_BLOCK_OVERHEAD)
+#endif
+#endif
+
 // segment, 76 bytes
 class Segment {
   public:
@@ -481,9 +492,11 @@ class Segment {
         bool    _manualW  : 1;
       };
     };
+    mutable uint32_t _lastHash;       // hash of pixels & blending parameters at last WS2812FX::show() (0 if segment was not shown, 2 after a transition ended), see frameHash()
 
     // static variables are use to speed up effect calculations by stashing common pre-calculated values
     static unsigned      _usedSegmentData;    // amount of data used by all segments
+    static uint16_t      _dataAllocFails;     // number of failed effect data allocations (limit reached or out of memory)
     static unsigned      _vLength;            // 1D dimension used for current effect
     static unsigned      _vWidth, _vHeight;   // 2D dimensions used for current effect
     static uint32_t      _currentColors[NUM_COLORS]; // colors used for current effect (faster access from effect functions)
@@ -509,6 +522,7 @@ class Segment {
       uint16_t      _progress;            // transition progress (0-65535); pre-calculated from _start & _dur in updateTransitionProgress()
       uint8_t       _prevPaletteBlends;   // number of previous palette blends (there are max 255 blends possible)
       uint8_t       _palette, _bri, _cct; // palette ID, brightness and CCT at the start of transition (brightness will be 0 if segment was off)
+      bool          _snapshot;            // old segment is a frozen snapshot of its last frame (no effect data, old mode is not rendered)
       Transition(uint16_t dur=750)
       : _oldSegment(nullptr)
       , _start(millis())
@@ -522,6 +536,7 @@ class Segment {
       , _palette(0)
       , _bri(0)
       , _cct(0)
+      , _snapshot(false)
       {}
       ~Transition() {
         //DEBUGFX_PRINTF_P(PSTR("-- Destroying transition: %p\n"), this);
@@ -542,6 +557,7 @@ class Segment {
   #endif
     void resetIfRequired();         // sets all SEGENV variables to 0 and clears data buffer
     void loadPalette(CRGBPalette16 &tgt, uint8_t pal);
+    uint32_t frameHash() const;     // hash of pixel buffer and blending parameters used to detect unchanged segments in WS2812FX::show() (never 0)
 
     // transition functions
     void stopTransition();                  // ends transition mode by destroying transition structure (does nothing if not in transition)
@@ -552,6 +568,7 @@ class Segment {
     }
     inline uint16_t progress() const          { return isInTransition() ? _t->_progress : 0xFFFFU; } // relies on handleTransition()/updateTransitionProgress() to update progression variable
     inline Segment *getOldSegment() const     { return isInTransition() ? _t->_oldSegment : nullptr; }
+    inline bool     isSnapshotTransition() const { return isInTransition() && _t->_snapshot; } // old segment is frozen, do not run its mode
 
     inline static void modeBlend(bool blend)  { Segment::_modeBlend = blend; }  // for isPreviousMode()
     inline static void setClippingRect(int startX, int stopX, int startY = 0, int stopY = 1) { _clipStart = startX; _clipStop = stopX; _clipStartY = startY; _clipStopY = stopY; };
@@ -593,6 +610,7 @@ class Segment {
     , _dataLen(0)
     , _default_palette(6)
     , _capabilities(0)
+    , _lastHash(0)
     , _t(nullptr)
     {
       DEBUGFX_PRINTF_P(PSTR("-- Creating segment: %p [%d,%d:%d,%d]\n"), this, (int)start, (int)stop, (int)startY, (int)stopY);
@@ -606,7 +624,8 @@ class Segment {
       }
     }
 
-    Segment(const Segment &orig); // copy constructor
+    Segment(const Segment &orig) : Segment(orig, true) {} // copy constructor
+    Segment(const Segment &orig, bool copyData); // copy constructor, optionally without effect data (for transition snapshots)
     Segment(Segment &&orig) noexcept; // move constructor
 
     ~Segment() {
@@ -672,6 +691,7 @@ class Segment {
     bool allocateData(size_t len);  // allocates effect data buffer in heap and clears it
     void deallocateData();          // deallocates (frees) effect data buffer from heap
     inline static unsigned getUsedSegmentData()            { return Segment::_usedSegmentData; }
+    inline static uint16_t getDataAllocFails()             { return Segment::_dataAllocFails; }
     /**
       * Flags that before the next effect is calculated,
       * the internal segment state should be reset.
@@ -813,12 +833,6 @@ class Segment {
 class WS2812FX {
   typedef void (*mode_ptr)(); // pointer to mode function
   typedef void (*show_callback)(); // pre show callback
-  typedef struct ModeData {
-    uint8_t     _id;   // mode (effect) id
-    mode_ptr    _fcn;  // mode (effect) function
-    const char *_data; // mode (effect) name and its UI control data
-    ModeData(uint8_t id, void (*fcn)(void), const char *data) : _id(id), _fcn(fcn), _data(data) {}
-  } mode_data_t;
 
   public:
 
@@ -836,6 +850,9 @@ class WS2812FX {
       // true private variables
       _pixels(nullptr),
       _pixelCCT(nullptr),
+#ifdef WLED_ENABLE_WIDE_COLOR
+      _pixels16(nullptr),
+#endif
       _suspend(false),
       _brightness(DEFAULT_BRIGHTNESS),
       _length(DEFAULT_LED_COUNT),
@@ -850,24 +867,31 @@ class WS2812FX {
       _segment_index(0),
       _mainSegment(0),
       _modeCount(MODE_COUNT),
+      _effects(nullptr),
+      _effectsLen(0),
       _callback(nullptr),
       customMappingTable(nullptr),
       customMappingSize(0),
       _lastShow(0),
-      _lastServiceShow(0)
+      _lastServiceShow(0),
+      _lastFrameSig(0),
+      _touchedStart(UINT16_MAX),
+      _touchedStop(0),
+      _overlayStart(UINT16_MAX),
+      _overlayStop(0)
     {
-      _mode.reserve(_modeCount);     // allocate memory to prevent initial fragmentation (does not increase size())
-      _modeData.reserve(_modeCount); // allocate memory to prevent initial fragmentation (does not increase size())
-      if (_mode.capacity() <= 1 || _modeData.capacity() <= 1) _modeCount = 1; // memory allocation failed only show Solid
-      else setupEffectData();
+      setupEffectData();
     }
 
     ~WS2812FX() {
       p_free(_pixels);
       p_free(_pixelCCT); // just in case
+#ifdef WLED_ENABLE_WIDE_COLOR
+      p_free(_pixels16);
+#endif
       d_free(customMappingTable);
-      _mode.clear();
-      _modeData.clear();
+      _addedEffects.clear();
+      _overlays.clear();
       _segments.clear();
 #ifndef WLED_DISABLE_2D
       panel.clear();
@@ -889,13 +913,16 @@ class WS2812FX {
       makeAutoSegments(bool forceReset = false),  // will create segments based on configured outputs
       fixInvalidSegments(),                       // fixes incorrect segment configuration
       blendSegment(const Segment &topSegment) const,    // blends topSegment into pixels
+      blendOverlays(size_t start, size_t stop) const,   // composites overlay layers into pixels [start, stop)
+      addOverlay(OverlayLayer *layer),            // shows an overlay layer on top of the segments (until removed)
+      removeOverlay(OverlayLayer *layer),
       show(),                                     // initiates LED output
       setTargetFps(unsigned fps),
-      setupEffectData(),                          // add default effects to the list; defined in FX.cpp
+      setupEffectData(),                          // index the registered effects (fx_registry.h); defined in FX.cpp
       waitForIt();                                // wait until frame is over (service() has finished or time for 1 frame has passed)
 
     void setRealtimePixelColor(unsigned i, uint32_t c);
-    inline void setPixelColor(unsigned n, uint32_t c) const   { if (n < getLengthTotal()) _pixels[n] = c; }  // paints absolute strip pixel with index n and color c
+    inline void setPixelColor(unsigned n, uint32_t c) const   { if (n < getLengthTotal()) { _pixels[n] = c; touchPixel(n); } }  // paints absolute strip pixel with index n and color c
     inline void resetTimebase()                               { timebase = 0UL - millis(); }
     inline void setPixelColor(unsigned n, uint8_t r, uint8_t g, uint8_t b, uint8_t w = 0) const
                                                               { setPixelColor(n, RGBW32(r,g,b,w)); }
@@ -907,6 +934,7 @@ class WS2812FX {
     inline void appendSegment(uint16_t sStart=0, uint16_t sStop=30, uint16_t sStartY = 0, uint16_t sStopY = 1)
                                                               { if (_segments.size() < getMaxSegments()) _segments.emplace_back(sStart,sStop,sStartY,sStopY); }
     inline void suspend()                                     { _suspend = true; }    // will suspend (and canacel) strip.service() execution
+    inline void forceFullShow()                               { _lastFrameSig = 0; }  // next show() will recompose and output entire frame
     inline void resume()                                      { _suspend = false; }   // will resume strip.service() execution
 
     void restartRuntime();
@@ -929,7 +957,7 @@ class WS2812FX {
     uint8_t getFirstSelectedSegId() const;
     uint8_t getLastActiveSegmentId() const;
     uint8_t getActiveSegsLightCapabilities(bool selectedOnly = false) const;
-    uint8_t addEffect(uint8_t id, mode_ptr mode_fn, const char *mode_name);         // add effect to the list; defined in FX.cpp;
+    uint8_t addEffect(uint8_t id, mode_ptr mode_fn, const char *mode_name);         // add effect at runtime (prefer REGISTER_EFFECT()); defined in FX.cpp;
 
     inline uint8_t getBrightness() const    { return _brightness; }       // returns current strip brightness
     inline static constexpr unsigned getMaxSegments() { return MAX_NUM_SEGMENTS; }  // returns maximum number of supported segments (fixed value)
@@ -955,10 +983,17 @@ class WS2812FX {
     unsigned long now, timebase;
     inline uint32_t getPixelColor(unsigned n) const { return (getMappedPixelIndex(n) < getLengthTotal()) ? _pixels[n] : 0; } // returns color of pixel n, black if out of (mapped) bounds
     inline uint32_t getPixelColorNoMap(unsigned n) const { return (n < getLengthTotal()) ? _pixels[n] : 0; } // ignores mapping table
+    inline const uint32_t *getPixels() const        { return _pixels; }                   // returns frame buffer (getLengthTotal() pixels, unmapped)
     inline uint32_t getLastShow() const             { return _lastShow; }                 // returns millis() timestamp of last strip.show() call
+    inline uint32_t getLastFrame() const            { return _lastServiceShow; }          // returns millis() timestamp of the start of the last frame rendered by service()
 
-    const char *getModeData(unsigned id = 0) const  { return (id && id < _modeCount) ? _modeData[id] : PSTR("Solid"); }
-    inline const char **getModeDataSrc()            { return &(_modeData[0]); }           // vectors use arrays for underlying data
+    inline const EffectEntry *getEffect(unsigned id) const {                              // registry entry of effect id, nullptr if reserved (entry may be in flash, use getEffectInfo())
+      if (id >= _modeCount || _effectIndex[id] == FX_INDEX_NONE) return nullptr;
+      return _effectIndex[id] < _effectsLen ? &_effects[_effectIndex[id]] : &_addedEffects[_effectIndex[id] - _effectsLen];
+    }
+    inline mode_ptr getModeFunction(unsigned id) const { const EffectEntry *fx = getEffect(id); return fx ? fx->fcn : getEffect(0)->fcn; } // Solid if reserved
+    const char *getModeData(unsigned id = 0) const  { return (id && id < _modeCount) ? (getEffect(id) ? getEffect(id)->data : PSTR("RSVD")) : PSTR("Solid"); }
+    EffectInfo getEffectInfo(unsigned id) const;                                           // pre-parsed metadata of effect id; defined in FX.cpp
 
     Segment&        getSegment(unsigned id);
     inline Segment& getFirstSelectedSeg() { return _segments[getFirstSelectedSegId()]; }  // returns reference to first segment that is "selected"
@@ -1014,6 +1049,9 @@ class WS2812FX {
   private:
     uint32_t *_pixels;
     uint8_t  *_pixelCCT;
+#ifdef WLED_ENABLE_WIDE_COLOR
+    uint64_t *_pixels16; // wide color frame buffer (color16.h), only allocated if a 16 bit bus is configured
+#endif
     std::vector<Segment> _segments;
 
     volatile bool _suspend;
@@ -1038,8 +1076,11 @@ class WS2812FX {
     uint8_t _mainSegment;
 
     uint8_t                  _modeCount;
-    std::vector<mode_ptr>    _mode;     // SRAM footprint: 4 bytes per element
-    std::vector<const char*> _modeData; // mode (effect) name and its slider control data array
+    uint16_t                 _effectIndex[255]; // effect id -> registry entry (_effects, then _addedEffects), FX_INDEX_NONE if reserved
+    const EffectEntry       *_effects;          // registered effects (flash)
+    uint16_t                 _effectsLen;
+    std::vector<EffectEntry> _addedEffects;     // effects added at runtime with addEffect()
+    std::vector<OverlayLayer*> _overlays;       // overlay layers composited in show() (owned by their clients)
 
     show_callback _callback;
 
@@ -1049,6 +1090,29 @@ class WS2812FX {
     unsigned long _lastShow;
     unsigned long _lastServiceShow;
 
+    // dirty region tracking (see show())
+    uint32_t          _lastFrameSig;                  // signature of global output parameters at last show(), 0 forces full frame
+    mutable uint16_t  _touchedStart, _touchedStop;    // span of pixels painted directly (setPixelColor()) since last show()
+    uint16_t          _overlayStart, _overlayStop;    // span of pixels painted by show callback (overlays) during last show()
+
+    inline void touchPixel(unsigned n) const { if (n < _touchedStart) _touchedStart = n; if (n >= _touchedStop) _touchedStop = n + 1; }
+    // blends color c with opacity o into frame buffer pixel idx using blend mode function blend
+    // with wide color frame buffer the 8 bit pixel is its rounded value (show() detects pixels that were painted directly)
+    template<typename F> inline void blendPixel(size_t idx, uint32_t c, uint8_t o, const F &blend) const {
+#ifdef WLED_ENABLE_WIDE_COLOR
+      if (_pixels16) {
+        const uint64_t c16 = color_blend64(_pixels16[idx], color_widen(blend(c, _pixels[idx])), o * 257U);
+        _pixels16[idx] = c16;
+        _pixels[idx]   = color_narrow(c16);
+        return;
+      }
+#endif
+      _pixels[idx] = color_blend(_pixels[idx], blend(c, _pixels[idx]), o);
+    }
+    uint32_t frameSignature() const;                  // returns signature of global parameters affecting output (never 0)
+    bool     overlayPlacement(const OverlayLayer &layer, size_t &base, unsigned &w, unsigned &h) const; // frame buffer area of a layer
+    uint8_t  assignEffect(uint8_t id, unsigned index);  // assigns effect id to a registry entry (255: first free id)
+
     friend class Segment;
 };
 
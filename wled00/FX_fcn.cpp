@@ -38,6 +38,7 @@
 // Segment class implementation
 ///////////////////////////////////////////////////////////////////////////////
 unsigned      Segment::_usedSegmentData   = 0U; // amount of RAM all segments use for their data[]
+uint16_t      Segment::_dataAllocFails    = 0;  // number of failed data allocations
 uint16_t      Segment::maxWidth           = DEFAULT_LED_COUNT;
 uint16_t      Segment::maxHeight          = 1;
 unsigned      Segment::_vLength           = 0;
@@ -56,8 +57,8 @@ uint16_t Segment::_clipStop = 0;
 uint8_t  Segment::_clipStartY = 0;
 uint8_t  Segment::_clipStopY = 1;
 
-// copy constructor
-Segment::Segment(const Segment &orig) {
+// copy constructor (effect data is not copied for transition snapshots)
+Segment::Segment(const Segment &orig, bool copyData) {
   //DEBUG_PRINTF_P(PSTR("-- Copy segment constructor: %p -> %p\n"), &orig, this);
   memcpy((void*)this, (void*)&orig, sizeof(Segment));
   _t   = nullptr; // copied segment cannot be in transition
@@ -72,7 +73,7 @@ Segment::Segment(const Segment &orig) {
     if (pixels) {
       memcpy(pixels, orig.pixels, sizeof(uint32_t) * orig.length());
       if (orig.name) { name = static_cast<char*>(allocate_buffer(strlen(orig.name)+1, BFRALLOC_PREFER_PSRAM)); if (name) strcpy(name, orig.name); }
-      if (orig.data) { if (allocateData(orig._dataLen)) memcpy(data, orig.data, orig._dataLen); }
+      if (orig.data && copyData) { if (allocateData(orig._dataLen)) memcpy(data, orig.data, orig._dataLen); }
     } else {
       DEBUGFX_PRINTLN(F("!!! Not enough RAM for pixel buffer !!!"));
       errorFlag = ERR_NORAM_PX;
@@ -85,6 +86,9 @@ Segment::Segment(const Segment &orig) {
 Segment::Segment(Segment &&orig) noexcept {
   //DEBUG_PRINTF_P(PSTR("-- Move segment constructor: %p -> %p\n"), &orig, this);
   memcpy((void*)this, (void*)&orig, sizeof(Segment));
+  #ifdef WLED_ENABLE_FX_ARENA
+  if (data) fxArena.rebind(data, &data); // data block must follow its new owner
+  #endif
   orig._t   = nullptr; // old segment cannot be in transition any more
   orig.name = nullptr;
   orig.data = nullptr;
@@ -136,6 +140,9 @@ Segment& Segment::operator= (Segment &&orig) noexcept {
     p_free(pixels);   // free old pixel buffer
     // move source data
     memcpy((void*)this, (void*)&orig, sizeof(Segment));
+    #ifdef WLED_ENABLE_FX_ARENA
+    if (data) fxArena.rebind(data, &data); // data block must follow its new owner
+    #endif
     orig.name = nullptr;
     orig.data = nullptr;
     orig._dataLen = 0;
@@ -166,16 +173,27 @@ bool Segment::allocateData(size_t len) {
     // not enough memory
     DEBUG_PRINTF_P(PSTR("SegmentData limit reached: %d/%d\n"), len, Segment::getUsedSegmentData());
     errorFlag = ERR_NORAM;
+    if (_dataAllocFails < UINT16_MAX) _dataAllocFails++;
     return false;
   }
   #endif
 
   if (data) {
+    #ifdef WLED_ENABLE_FX_ARENA
+    fxArena.release(data); // release block so it can be merged with neighbouring holes
+    #else
     d_free(data); // free data and try to allocate again (segment buffer may be blocking contiguous heap)
+    #endif
+    data = nullptr;
     Segment::addUsedSegmentData(-_dataLen); // subtract buffer size
+    _dataLen = 0;
   }
 
+  #ifdef WLED_ENABLE_FX_ARENA
+  data = fxArena.allocate(len, &data);
+  #else
   data = static_cast<byte*>(allocate_buffer(len, BFRALLOC_PREFER_DRAM | BFRALLOC_CLEAR)); // prefer DRAM over PSRAM for speed
+  #endif
 
   if (data) {
     Segment::addUsedSegmentData(len);
@@ -186,6 +204,7 @@ bool Segment::allocateData(size_t len) {
   // allocation failed
   DEBUG_PRINTLN(F("!!! Allocation failed. !!!"));
   errorFlag = ERR_NORAM;
+  if (_dataAllocFails < UINT16_MAX) _dataAllocFails++;
   return false;
 }
 
@@ -193,7 +212,11 @@ void Segment::deallocateData() {
   if (!data) { _dataLen = 0; return; }
   if ((Segment::getUsedSegmentData() > 0) && (_dataLen > 0)) { // check that we don't have a dangling / inconsistent data pointer
     //DEBUG_PRINTF_P(PSTR("---  Released data (%p): %d/%d -> %p\n"), this, _dataLen, Segment::getUsedSegmentData(), data);
+    #ifdef WLED_ENABLE_FX_ARENA
+    fxArena.release(data);
+    #else
     d_free(data);
+    #endif
   } else {
     DEBUG_PRINTF_P(PSTR("---- Released data (%p): inconsistent UsedSegmentData (%d/%d), cowardly refusing to free nothing.\n"), this, _dataLen, Segment::getUsedSegmentData());
   }
@@ -280,6 +303,20 @@ void Segment::loadPalette(CRGBPalette16 &targetPalette, uint8_t pal) {
   }
 }
 
+// FNV-1a hash of segment's pixel buffer and parameters used in WS2812FX::blendSegment()
+// used by WS2812FX::show() to skip re-blending and output of segments that did not change since last frame
+uint32_t Segment::frameHash() const {
+  uint32_t hash = 2166136261UL;
+  const auto mix = [&hash](uint32_t v) { hash = (hash ^ v) * 16777619UL; };
+  mix(start | (uint32_t(stop) << 16));
+  mix(startY | (uint32_t(stopY) << 16));
+  mix(offset | (uint32_t(options) << 16));
+  mix(grouping | (spacing << 8) | (blendMode << 16) | (uint32_t(currentBri()) << 24));
+  mix(currentCCT());
+  if (pixels) for (unsigned i = 0; i < length(); i++) mix(pixels[i]);
+  return hash | 0x01; // 0 is reserved for "not shown"
+}
+
 // starting a transition has to occur before change so we get current values 1st
 void Segment::startTransition(uint16_t dur, bool segmentCopy) {
   if (dur == 0 || !isActive()) {
@@ -289,7 +326,8 @@ void Segment::startTransition(uint16_t dur, bool segmentCopy) {
   if (isInTransition()) {
     if (segmentCopy && !_t->_oldSegment) {
       // already in transition but segment copy requested and not yet created
-      _t->_oldSegment = new(std::nothrow) Segment(*this); // store/copy current segment settings
+      _t->_oldSegment = new(std::nothrow) Segment(*this, !transitionSnapshot); // store/copy current segment settings
+      _t->_snapshot = transitionSnapshot;
       _t->_start = millis();                              // restart countdown
       _t->_dur   = dur;
       _t->_prevPaletteBlends = 0;
@@ -313,7 +351,11 @@ void Segment::startTransition(uint16_t dur, bool segmentCopy) {
     loadPalette(_t->_palT, palette);
     #endif
     for (int i=0; i<NUM_COLORS; i++) _t->_colors[i] = colors[i];
-    if (segmentCopy) _t->_oldSegment = new(std::nothrow) Segment(*this); // store/copy current segment settings
+    if (segmentCopy) {
+      // snapshot transitions only keep the last frame (pixels) of the old effect, its data is not needed as it will not be rendered
+      _t->_oldSegment = new(std::nothrow) Segment(*this, !transitionSnapshot); // store/copy current segment settings
+      _t->_snapshot = transitionSnapshot;
+    }
     if (_t->_oldSegment) {
       DEBUGFX_PRINTF_P(PSTR("-- Started transition: S=%p T(%p) O[%p] OP[%p]\n"), this, _t, _t->_oldSegment, _t->_oldSegment->pixels);
       if (!_t->_oldSegment->isActive()) stopTransition();
@@ -327,6 +369,7 @@ void Segment::stopTransition() {
   DEBUG_PRINTF_P(PSTR("-- Stopping transition: S=%p T(%p) O[%p]\n"), this, _t, _t->_oldSegment);
   delete _t;
   _t = nullptr;
+  _lastHash = 0x02; // never returned by frameHash(): final frame is recomposed even if it hashes like the last blended one
 }
 
 // sets transition progress variable (0-65535) based on time passed since transition start
@@ -550,31 +593,32 @@ Segment &Segment::setOption(uint8_t n, bool val) {
 
 Segment &Segment::setMode(uint8_t fx, bool loadDefaults) {
   // skip reserved
-  while (fx < strip.getModeCount() && strncmp_P("RSVD", strip.getModeData(fx), 4) == 0) fx++;
+  while (fx < strip.getModeCount() && !strip.getEffect(fx)) fx++;
   if (fx >= strip.getModeCount()) fx = 0; // set solid mode
   // if we have a valid mode & is not reserved
   if (fx != mode) {
     startTransition(strip.getTransition(), true); // set effect transitions (must create segment copy)
     mode = fx;
+    const EffectInfo info = strip.getEffectInfo(fx); // defaults were parsed at compile time
     int sOpt;
-    // load default values from effect string
+    // load default values from effect metadata
     if (loadDefaults) {
-      sOpt = extractModeDefaults(fx, "sx");  speed     = (sOpt >= 0) ? sOpt : DEFAULT_SPEED;
-      sOpt = extractModeDefaults(fx, "ix");  intensity = (sOpt >= 0) ? sOpt : DEFAULT_INTENSITY;
-      sOpt = extractModeDefaults(fx, "c1");  custom1   = (sOpt >= 0) ? sOpt : DEFAULT_C1;
-      sOpt = extractModeDefaults(fx, "c2");  custom2   = (sOpt >= 0) ? sOpt : DEFAULT_C2;
-      sOpt = extractModeDefaults(fx, "c3");  custom3   = (sOpt >= 0) ? sOpt : DEFAULT_C3;
-      sOpt = extractModeDefaults(fx, "o1");  check1    = (sOpt >= 0) ? (bool)sOpt : false;
-      sOpt = extractModeDefaults(fx, "o2");  check2    = (sOpt >= 0) ? (bool)sOpt : false;
-      sOpt = extractModeDefaults(fx, "o3");  check3    = (sOpt >= 0) ? (bool)sOpt : false;
-      sOpt = extractModeDefaults(fx, "m12"); if (sOpt >= 0) map1D2D   = constrain(sOpt, 0, 7); else map1D2D = M12_Pixels;  // reset mapping if not defined (2D FX may not work)
-      sOpt = extractModeDefaults(fx, "si");  if (sOpt >= 0) soundSim  = constrain(sOpt, 0, 3);
-      sOpt = extractModeDefaults(fx, "rev"); if (sOpt >= 0) reverse   = (bool)sOpt;
-      sOpt = extractModeDefaults(fx, "mi");  if (sOpt >= 0) mirror    = (bool)sOpt; // NOTE: setting this option is a risky business
-      sOpt = extractModeDefaults(fx, "rY");  if (sOpt >= 0) reverse_y = (bool)sOpt;
-      sOpt = extractModeDefaults(fx, "mY");  if (sOpt >= 0) mirror_y  = (bool)sOpt; // NOTE: setting this option is a risky business
+      sOpt = info.getDefault(FX_DEF_SX);  speed     = (sOpt >= 0) ? sOpt : DEFAULT_SPEED;
+      sOpt = info.getDefault(FX_DEF_IX);  intensity = (sOpt >= 0) ? sOpt : DEFAULT_INTENSITY;
+      sOpt = info.getDefault(FX_DEF_C1);  custom1   = (sOpt >= 0) ? sOpt : DEFAULT_C1;
+      sOpt = info.getDefault(FX_DEF_C2);  custom2   = (sOpt >= 0) ? sOpt : DEFAULT_C2;
+      sOpt = info.getDefault(FX_DEF_C3);  custom3   = (sOpt >= 0) ? sOpt : DEFAULT_C3;
+      sOpt = info.getDefault(FX_DEF_O1);  check1    = (sOpt >= 0) ? (bool)sOpt : false;
+      sOpt = info.getDefault(FX_DEF_O2);  check2    = (sOpt >= 0) ? (bool)sOpt : false;
+      sOpt = info.getDefault(FX_DEF_O3);  check3    = (sOpt >= 0) ? (bool)sOpt : false;
+      sOpt = info.getDefault(FX_DEF_M12); if (sOpt >= 0) map1D2D   = constrain(sOpt, 0, 7); else map1D2D = M12_Pixels;  // reset mapping if not defined (2D FX may not work)
+      sOpt = info.getDefault(FX_DEF_SI);  if (sOpt >= 0) soundSim  = constrain(sOpt, 0, 3);
+      sOpt = info.getDefault(FX_DEF_REV); if (sOpt >= 0) reverse   = (bool)sOpt;
+      sOpt = info.getDefault(FX_DEF_MI);  if (sOpt >= 0) mirror    = (bool)sOpt; // NOTE: setting this option is a risky business
+      sOpt = info.getDefault(FX_DEF_RY);  if (sOpt >= 0) reverse_y = (bool)sOpt;
+      sOpt = info.getDefault(FX_DEF_MY);  if (sOpt >= 0) mirror_y  = (bool)sOpt; // NOTE: setting this option is a risky business
     }
-    sOpt = extractModeDefaults(fx, "pal"); // always extract 'pal' to set _default_palette
+    sOpt = info.getDefault(FX_DEF_PAL); // always extract 'pal' to set _default_palette
     if (sOpt >= 0 && loadDefaults) setPalette(sOpt);
     if (sOpt <= 0) sOpt = 6; // partycolors if zero or not set
     _default_palette = sOpt; // _default_palette is loaded into pal0 in loadPalette() (if selected)
@@ -1188,6 +1232,10 @@ void WS2812FX::finalizeInit() {
   #endif
   #endif
 
+  p_free(_pixelCCT); // CCT buffer will be re-allocated in show() if needed
+  _pixelCCT = nullptr;
+  forceFullShow();
+
   DEBUG_PRINTF_P(PSTR("Heap before buses: %d\n"), getFreeHeapSize());
   // create buses/outputs
   unsigned mem = 0; // memory estimation including DMA buffer for I2S and pixel buffers
@@ -1261,6 +1309,15 @@ void WS2812FX::finalizeInit() {
   // use PSRAM if available: there is no measurable perfomance impact between PSRAM and DRAM on S2/S3 with QSPI PSRAM for this buffer
   _pixels = static_cast<uint32_t*>(allocate_buffer(getLengthTotal() * sizeof(uint32_t), BFRALLOC_ENFORCE_PSRAM | BFRALLOC_NOBYTEACCESS | BFRALLOC_CLEAR));
   DEBUG_PRINTF_P(PSTR("strip buffer size: %uB\n"), getLengthTotal() * sizeof(uint32_t));
+#ifdef WLED_ENABLE_WIDE_COLOR
+  // wide color frame buffer is only used if there is a bus that can output it (8 bit buses dither it)
+  p_free(_pixels16);
+  _pixels16 = nullptr;
+  if (BusManager::has16bitBus()) {
+    _pixels16 = static_cast<uint64_t*>(allocate_buffer(getLengthTotal() * sizeof(uint64_t), BFRALLOC_PREFER_PSRAM | BFRALLOC_NOBYTEACCESS | BFRALLOC_CLEAR));
+    DEBUG_PRINTF_P(PSTR("wide color buffer size: %uB\n"), _pixels16 ? getLengthTotal() * sizeof(uint64_t) : 0);
+  }
+#endif
   DEBUG_PRINTF_P(PSTR("Heap after strip init: %uB\n"), getFreeHeapSize());
 }
 
@@ -1275,6 +1332,7 @@ void WS2812FX::service() {
   if (_suspend || elapsed <= MIN_FRAME_DELAY) return;   // keep wifi alive - no matter if triggered or unlimited
 
   _isServicing = true;
+  RENDER_PROFILE_START(frameStart);
   bool doShow = _triggered;    // true if ≥1 active segment was processed (and strip was not suspended mid-loop), or trigger received → triggers show()
   for (size_t i = 0; i < _segments.size(); i++) {
     Segment &seg = _segments[i];
@@ -1291,26 +1349,29 @@ void WS2812FX::service() {
       // if we arrive here, its always showtime (timeToShow == true)
       doShow = true;
       if (!seg.freeze) { //only run effect function if not frozen
+        RENDER_PROFILE_START(fxStart);
         // Effect blending
         uint16_t prog = seg.progress();
         seg.beginDraw(prog);                // set up parameters for get/setPixelColor() (will also blend colors and palette if blend style is FADE)
         _currentSegment = &seg;             // set current segment for effect functions (SEGMENT & SEGENV)
         // workaround for on/off transition to respect blending style
-        _mode[seg.mode]();                  // run new/current mode (needed for bri workaround)
+        getModeFunction(seg.mode)();        // run new/current mode (needed for bri workaround)
         seg.call++;
         // if segment is in transition and no old segment exists we don't need to run the old mode
         // (blendSegments() takes care of On/Off transitions and clipping)
+        // snapshot transitions blend against the frozen last frame of the old mode
         Segment *segO = seg.getOldSegment();
-        if (segO && segO->isActive() && (seg.mode != segO->mode || blendingStyle != TRANSITION_FADE ||
+        if (segO && segO->isActive() && !seg.isSnapshotTransition() && (seg.mode != segO->mode || blendingStyle != TRANSITION_FADE ||
             (segO->name != seg.name && segO->name && seg.name && strncmp(segO->name, seg.name, WLED_MAX_SEGNAME_LEN) != 0))) {
           Segment::modeBlend(true);         // set flag for beginDraw() to blend colors and palette
           segO->beginDraw(prog);            // set up palette & colors (also sets draw dimensions), parent segment has transition progress
           _currentSegment = segO;           // set current segment
           // workaround for on/off transition to respect blending style
-          _mode[segO->mode]();              // run old mode (needed for bri workaround; semaphore!!)
+          getModeFunction(segO->mode)();    // run old mode (needed for bri workaround; semaphore!!)
           segO->call++;                     // increment old mode run counter
           Segment::modeBlend(false);        // unset flag
         }
+        RENDER_PROFILE_SEGMENT(i, seg.mode, RENDER_SEG_EFFECT, fxStart);
       }
     }
   }
@@ -1321,10 +1382,12 @@ void WS2812FX::service() {
   if ((_targetFps != FPS_UNLIMITED) && (millis() - nowUp > _frametime)) DEBUG_PRINTF_P(PSTR("Slow effects %u/%d.\n"), (unsigned)(millis()-nowUp), (int)_frametime);
   #endif
   if (doShow && !_suspend) {
+    RENDER_PROFILE_STAGE(RENDER_STAGE_EFFECTS, frameStart); // only frames that are shown, like RENDER_STAGE_FRAME
     yield();
     Segment::handleRandomPalette(); // slowly transition random palette; move it into for loop when each segment has individual random palette
     _lastServiceShow = nowUp; // update timestamp, for precise FPS control
     show();
+    RENDER_PROFILE_STAGE(RENDER_STAGE_FRAME, frameStart);
   }
   #ifdef WLED_DEBUG
   if ((_targetFps != FPS_UNLIMITED) && (millis() - nowUp > _frametime)) DEBUG_PRINTF_P(PSTR("Slow strip %u/%d.\n"), (unsigned)(millis()-nowUp), (int)_frametime);
@@ -1362,34 +1425,38 @@ static uint8_t _burn      (uint8_t a, uint8_t b) { return ~_divide(a,~b); }
 static uint8_t _stencil   (uint8_t a, uint8_t b) { return a ? a : b; } // function unused
 static uint8_t _dummy     (uint8_t a, uint8_t b) { return a; } // dummy (same as _top) to fill the function list and make it safe from OOB access
 
-#define BLENDMODES  17 // number of blend modes must match "bm" in index.js, all cases must be handled in segblend() @ blendSegment()
+#define BLENDMODES  17 // number of blend modes must match "bm" in index.js, all cases must be handled in blendColors()
 
-void WS2812FX::blendSegment(const Segment &topSegment) const {
-  typedef uint8_t(*FuncType)(uint8_t, uint8_t);
-  // function pointer array: fill with _dummy if using special case: avoid OOB access and always provide a valid path
-  // note: making the function array static const uses more ram and comes at no significant speed gain
-  FuncType funcs[] = {
-    _dummy,      _dummy,     _dummy,    _subtract,
-    _difference, _average,   _dummy,    _divide,
-    _lighten,    _darken,    _screen,   _overlay,
-    _hardlight,  _softlight, _dodge,    _burn,
-    _dummy
-  };
+typedef uint8_t(*BlendFunc)(uint8_t, uint8_t);
+// function pointer array: fill with _dummy if using special case: avoid OOB access and always provide a valid path
+// note: making the function array static const uses more ram and comes at no significant speed gain
+#define BLEND_FUNCS { \
+    _dummy,      _dummy,     _dummy,    _subtract, \
+    _difference, _average,   _dummy,    _divide,   \
+    _lighten,    _darken,    _screen,   _overlay,  \
+    _hardlight,  _softlight, _dodge,    _burn,     \
+    _dummy \
+  }
+
+// blend top color t with bottom color b (blend mode < BLENDMODES, funcs: BLEND_FUNCS)
+static inline uint32_t blendColors(size_t blendMode, uint32_t t, uint32_t b, const BlendFunc *funcs) {
+  // use direct calculations/returns for simple/frequent modes (faster)
+  switch (blendMode) {
+    case 0 : return t;                   // top
+    case 1 : return b;                   // bottom
+    case 2 : return color_add(t,b,true); // add with preserve color ratio to avoid color clipping
+    case 6 : return RGBW32(_multiply(R(t),R(b)), _multiply(G(t),G(b)), _multiply(B(t),B(b)), _multiply(W(t),W(b))); // multiply (7% faster than lambda at 100bytes flash cost)
+    case 16: return t ? t : b;           // stencil (use top layer if not black, else bottom)
+  }
+  // default: use function pointer from array
+  const auto func = funcs[blendMode];
+  return RGBW32(func(R(t),R(b)), func(G(t),G(b)), func(B(t),B(b)), func(W(t),W(b)));
+}
 
+void WS2812FX::blendSegment(const Segment &topSegment) const {
+  BlendFunc funcs[] = BLEND_FUNCS;
   const size_t blendMode = topSegment.blendMode < BLENDMODES ? topSegment.blendMode : 0; // default to top if unsupported mode
-  const auto segblend = [&](uint32_t t, uint32_t b){
-    // use direct calculations/returns for simple/frequent modes (faster)
-    switch (blendMode) {
-      case 0 : return t;                   // top
-      case 1 : return b;                   // bottom
-      case 2 : return color_add(t,b,true); // add with preserve color ratio to avoid color clipping
-      case 6 : return RGBW32(_multiply(R(t),R(b)), _multiply(G(t),G(b)), _multiply(B(t),B(b)), _multiply(W(t),W(b))); // multiply (7% faster than lambda at 100bytes flash cost)
-      case 16: return t ? t : b;           // stencil (use top layer if not black, else bottom)
-    }
-    // default: use function pointer from array
-    const auto func = funcs[blendMode];
-    return RGBW32(func(R(t),R(b)), func(G(t),G(b)), func(B(t),B(b)), func(W(t),W(b)));
-  };
+  const auto segblend = [&](uint32_t t, uint32_t b){ return blendColors(blendMode, t, b, funcs); };
 
   const int     length     = topSegment.length();     // physical segment length (counts all pixels in 2D segment)
   const int     width      = topSegment.width();
@@ -1422,12 +1489,11 @@ void WS2812FX::blendSegment(const Segment &topSegment) const {
         if (topSegment.reverse_y) { start_offset += (height - 1) * Segment::maxWidth; y_inc = -Segment::maxWidth; }
 
         for (int y = 0; y < height; y++) {
-          uint32_t* pRow = &_pixels[start_offset + y * y_inc];
+          const int row = start_offset + y * y_inc;
           const int y_width = y * width;
           for (int x = 0; x < width; x++) {
-            uint32_t* p = pRow + x * x_inc;
-            uint32_t c_a = topSegment.getPixelColorRaw(x + y_width);
-            *p = color_blend(*p, segblend(c_a, *p), opacity);
+            const uint32_t c_a = topSegment.getPixelColorRaw(x + y_width);
+            blendPixel(row + x * x_inc, c_a, opacity, segblend);
           }
         }
       } else { // transposed
@@ -1437,7 +1503,7 @@ void WS2812FX::blendSegment(const Segment &topSegment) const {
             const int py = topSegment.reverse_y ? (width  - x - 1) : x;  // source pixel: swap x into y, reverse if needed
             const uint32_t c_a = topSegment.getPixelColorRaw(px + py * height); // height = virtual width
             const size_t idx = XY(topSegment.start + x, topSegment.startY + y); // write logical (non swapped) pixel coordinate
-            _pixels[idx] = color_blend(_pixels[idx], segblend(c_a, _pixels[idx]), opacity);
+            blendPixel(idx, c_a, opacity, segblend);
           }
         }
       }
@@ -1445,7 +1511,6 @@ void WS2812FX::blendSegment(const Segment &topSegment) const {
 #endif
     } else if (!isMatrix) {
       // 1D fast path, include CCT as it is more common on 1D setups
-      uint32_t* strip = _pixels;
       int start = topSegment.start;
       int off   = topSegment.offset;
       for (int i = 0; i < length; i++) {
@@ -1453,7 +1518,7 @@ void WS2812FX::blendSegment(const Segment &topSegment) const {
         int p = topSegment.reverse ? (length - i - 1) : i;
         int idx = start + p + off;
         if (idx >= topSegment.stop) idx -= length;
-        strip[idx] = color_blend(strip[idx], segblend(c_a, strip[idx]), opacity);
+        blendPixel(idx, c_a, opacity, segblend);
         if (_pixelCCT) _pixelCCT[idx] = cct;
       }
       return;
@@ -1531,7 +1596,7 @@ void WS2812FX::blendSegment(const Segment &topSegment) const {
       const int baseX = topSegment.start  + x;
       const int baseY = topSegment.startY + y;
       size_t indx = XY(baseX, baseY); // absolute address on strip
-      _pixels[indx] = color_blend(_pixels[indx], segblend(c, _pixels[indx]), o);
+      blendPixel(indx, c, o, segblend);
       if (_pixelCCT) _pixelCCT[indx] = cct;
       // Apply mirroring if enabled
       if (topSegment.mirror || topSegment.mirror_y) {
@@ -1540,9 +1605,9 @@ void WS2812FX::blendSegment(const Segment &topSegment) const {
         const size_t idxMX = XY(topSegment.transpose ? baseX : mirrorX, topSegment.transpose ? mirrorY : baseY);
         const size_t idxMY = XY(topSegment.transpose ? mirrorX : baseX, topSegment.transpose ? baseY : mirrorY);
         const size_t idxMM = XY(mirrorX, mirrorY);
-        if (topSegment.mirror)                        _pixels[idxMX] = color_blend(_pixels[idxMX], segblend(c, _pixels[idxMX]), o);
-        if (topSegment.mirror_y)                      _pixels[idxMY] = color_blend(_pixels[idxMY], segblend(c, _pixels[idxMY]), o);
-        if (topSegment.mirror && topSegment.mirror_y) _pixels[idxMM] = color_blend(_pixels[idxMM], segblend(c, _pixels[idxMM]), o);
+        if (topSegment.mirror)                        blendPixel(idxMX, c, o, segblend);
+        if (topSegment.mirror_y)                      blendPixel(idxMY, c, o, segblend);
+        if (topSegment.mirror && topSegment.mirror_y) blendPixel(idxMM, c, o, segblend);
         if (_pixelCCT) {
           if (topSegment.mirror)                        _pixelCCT[idxMX] = cct;
           if (topSegment.mirror_y)                      _pixelCCT[idxMY] = cct;
@@ -1630,12 +1695,12 @@ void WS2812FX::blendSegment(const Segment &topSegment) const {
         unsigned indxM = topSegment.stop - i - 1;
         indxM += topSegment.offset; // offset/phase
         if (indxM >= topSegment.stop) indxM -= length; // wrap
-        _pixels[indxM] = color_blend(_pixels[indxM], segblend(c, _pixels[indxM]), o);
+        blendPixel(indxM, c, o, segblend);
         if (_pixelCCT) _pixelCCT[indxM] = cct;
       }
       indx += topSegment.offset; // offset/phase
       if (indx >= topSegment.stop) indx -= length; // wrap
-      _pixels[indx] = color_blend(_pixels[indx], segblend(c, _pixels[indx]), o);
+      blendPixel(indx, c, o, segblend);
       if (_pixelCCT) _pixelCCT[indx] = cct;
     };
 
@@ -1680,6 +1745,91 @@ void WS2812FX::blendSegment(const Segment &topSegment) const {
   Segment::setClippingRect(0, 0);             // disable clipping for overlays
 }
 
+// frame buffer area of an overlay layer (rows Segment::maxWidth apart, clipped to its segment), false if it is not shown
+bool WS2812FX::overlayPlacement(const OverlayLayer &layer, size_t &base, unsigned &w, unsigned &h) const {
+  if (!layer.isVisible()) return false;
+  unsigned x = layer.x();
+  unsigned y = layer.y();
+  w = layer.width();
+  h = layer.height();
+  if (layer.segment() >= 0) {
+    if ((size_t)layer.segment() >= _segments.size()) return false;
+    const Segment &seg = _segments[layer.segment()];
+    if (!seg.isActive() || !seg.on) return false;
+    x += seg.start;
+    y += seg.startY;
+    if (x >= seg.stop || y >= seg.stopY) return false;
+    w = std::min(w, unsigned(seg.stop - x));
+    h = std::min(h, unsigned(seg.stopY - y));
+  } else {
+    if (x >= Segment::maxWidth) return false;
+    w = std::min(w, unsigned(Segment::maxWidth - x)); // do not wrap into the next row
+  }
+  base = x + y * Segment::maxWidth;
+  return base < getLengthTotal();
+}
+
+// composite overlay layers into [start, stop) of the frame buffer, right after the segments were blended into it
+void WS2812FX::blendOverlays(size_t start, size_t stop) const {
+  BlendFunc funcs[] = BLEND_FUNCS;
+  stop = std::min(stop, (size_t)getLengthTotal());
+  for (const OverlayLayer *layer : _overlays) {
+    size_t base;
+    unsigned w, h;
+    if (!overlayPlacement(*layer, base, w, h)) continue;
+    const size_t blendMode = layer->blendMode() < BLENDMODES ? layer->blendMode() : 0;
+    layer->composite(_pixels, base, Segment::maxWidth, w, h, start, stop, [&](uint32_t t, uint32_t b){ return blendColors(blendMode, t, b, funcs); });
+  }
+}
+
+void WS2812FX::addOverlay(OverlayLayer *layer) {
+  if (!layer) return;
+  for (const OverlayLayer *l : _overlays) if (l == layer) return;
+  _overlays.push_back(layer);
+}
+
+void WS2812FX::removeOverlay(OverlayLayer *layer) {
+  for (size_t i = 0; i < _overlays.size(); i++) if (_overlays[i] == layer) {
+    // area it was shown at is recomposed in next show()
+    size_t start = SIZE_MAX, stop = 0;
+    layer->track(0, 0, start, stop); // not shown anymore, so it is recomposed in full if added again
+    stop = std::min(stop, (size_t)getLengthTotal());
+    if (start < stop) {
+      touchPixel(start);
+      touchPixel(stop - 1);
+    }
+    _overlays.erase(_overlays.begin() + i);
+    return;
+  }
+}
+
+// signature of global parameters that affect every pixel of the output
+// if it changes between frames entire frame needs to be recomposed and sent to buses
+uint32_t WS2812FX::frameSignature() const {
+  uint32_t sig = 2166136261UL;
+  const auto mix = [&sig](uint32_t v) { sig = (sig ^ v) * 16777619UL; };
+  mix(_brightness | (realtimeMode << 8) | (realtimeOverride << 16) | (useMainSegmentOnly << 24) | (arlsDisableGammaCorrection << 25) | (gammaCorrectCol << 26) | (cctFromRgb << 27) | (correctWB << 28));
+  mix(Segment::maxWidth | (uint32_t(Segment::maxHeight) << 16));
+  mix(_length | (uint32_t(customMappingSize) << 16));
+  mix(uint32_t(uintptr_t(customMappingTable)));
+  mix(uint8_t(Bus::getCCTBlend()) | (Bus::getGlobalAWMode() << 8) | (blendingStyle << 16));
+  uint32_t gammaBits; memcpy(&gammaBits, &gammaCorrectVal, sizeof(gammaBits));
+  mix(gammaBits);
+  // segment layout (removed/resized segments leave stale pixels behind)
+  mix(_segments.size());
+  for (const Segment &seg : _segments) {
+    mix(seg.start | (uint32_t(seg.stop) << 16));
+    mix(seg.startY | (uint32_t(seg.stopY) << 16) | (uint32_t(seg.isActive()) << 31));
+  }
+  return sig | 0x01; // 0 is reserved for "force full frame"
+}
+
+// show() only recomposes and outputs the span of the frame buffer that changed since last frame:
+// - a segment is dirty if it is in transition or its frameHash() changed (pixels, opacity, CCT, options, etc.)
+// - pixels painted directly into frame buffer (overlays, setRange(), etc.) are recomposed in the next frame
+// - overlay layers (overlay_layer.h) are composited after the segments, their area is recomposed when they change
+// - span is extended until it fully contains every segment overlapping it (so blend modes and opacity remain correct)
+// entire frame is recomposed if frameSignature() changed or if realtime data is written directly into frame buffer
 void WS2812FX::show() {
   if (!_pixels) {
     DEBUGFX_PRINTLN(F("Error: no _pixels!"));
@@ -1691,51 +1841,164 @@ void WS2812FX::show() {
   size_t diff = showNow - _lastShow;
 
   size_t totalLen = getLengthTotal();
+  const bool blendSegments = realtimeMode == REALTIME_MODE_INACTIVE || useMainSegmentOnly || realtimeOverride > REALTIME_OVERRIDE_NONE;
+  const uint32_t frameSig = frameSignature();
+  bool fullFrame = !blendSegments || frameSig != _lastFrameSig;
+  _lastFrameSig = frameSig;
+
   // WARNING: as WLED doesn't handle CCT on pixel level but on Segment level instead
   // we need to keep track of each pixel's CCT when blending segments (if CCT is present)
   // and then set appropriate CCT from that pixel during paint (see below).
-  if ((hasCCTBus() || correctWB) && !cctFromRgb)
-    _pixelCCT = static_cast<uint8_t*>(allocate_buffer(totalLen * sizeof(uint8_t), BFRALLOC_PREFER_PSRAM)); // allocate CCT buffer if necessary, prefer PSRAM
-  if (_pixelCCT) memset(_pixelCCT, 127, totalLen); // set neutral (50:50) CCT
-
-  if (realtimeMode == REALTIME_MODE_INACTIVE || useMainSegmentOnly || realtimeOverride > REALTIME_OVERRIDE_NONE) {
-    // clear frame buffer
-    memset(_pixels, 0, sizeof(uint32_t) * totalLen);
-    // blend all segments into (cleared) buffer
-    for (Segment &seg : _segments) if (seg.isActive() && (seg.on || seg.isInTransition())) {
-      blendSegment(seg);              // blend segment's buffer into frame buffer
+  // CCT buffer is kept between frames as only changed pixels are recomposed
+  if ((hasCCTBus() || correctWB) && !cctFromRgb) {
+    if (!_pixelCCT) {
+      _pixelCCT = static_cast<uint8_t*>(allocate_buffer(totalLen * sizeof(uint8_t), BFRALLOC_PREFER_PSRAM)); // allocate CCT buffer if necessary, prefer PSRAM
+      fullFrame = true;
+    }
+  } else if (_pixelCCT) {
+    p_free(_pixelCCT);
+    _pixelCCT = nullptr;
+  }
+
+  // determine dirty span of the frame buffer
+  const auto segSpan = [](const Segment &seg, size_t &s, size_t &e) {
+    s = seg.start + seg.startY * Segment::maxWidth;
+    e = (seg.stop - 1) + (seg.stopY - 1) * Segment::maxWidth + 1;
+  };
+  size_t dirtyStart = 0;
+  size_t dirtyStop  = totalLen;
+  if (!fullFrame) {
+    // pixels painted directly since last show() and by overlays in last show() need to be recomposed
+    dirtyStart = std::min(_touchedStart, _overlayStart);
+    dirtyStop  = std::max(_touchedStop,  _overlayStop);
+  }
+  for (Segment &seg : _segments) {
+    const bool visible = blendSegments && seg.isActive() && (seg.on || seg.isInTransition());
+    const uint32_t hash = visible ? seg.frameHash() : 0;
+    if (!fullFrame && (hash != seg._lastHash || (visible && seg.isInTransition()))) {
+      size_t s, e;
+      segSpan(seg, s, e);
+      if (s < dirtyStart) dirtyStart = s;
+      if (e > dirtyStop)  dirtyStop  = e;
+    }
+    seg._lastHash = hash;
+  }
+  // overlay layers that changed or moved are recomposed where they were shown and where they are shown now
+  for (OverlayLayer *layer : _overlays) {
+    size_t base = 0, stop = 0;
+    unsigned w, h;
+    if (blendSegments && overlayPlacement(*layer, base, w, h)) stop = std::min(base + (h - 1) * Segment::maxWidth + w, totalLen);
+    else base = 0;
+    layer->track(base, stop, dirtyStart, dirtyStop);
+  }
+  if (dirtyStop > totalLen) dirtyStop = totalLen;
+  if (!fullFrame && blendSegments && dirtyStart < dirtyStop) {
+    // extend span to cover all segments that overlap it
+    bool extended;
+    do {
+      extended = false;
+      for (const Segment &seg : _segments) if (seg._lastHash) {
+        size_t s, e;
+        segSpan(seg, s, e);
+        if (s < dirtyStop && e > dirtyStart && (s < dirtyStart || e > dirtyStop)) {
+          dirtyStart = std::min(dirtyStart, s);
+          dirtyStop  = std::min(std::max(dirtyStop, e), totalLen);
+          extended   = true;
+        }
+      }
+    } while (extended);
+  }
+
+  if (blendSegments && dirtyStart < dirtyStop) {
+    RENDER_PROFILE_START(blendStart);
+    // clear dirty span of frame buffer
+    memset(&_pixels[dirtyStart], 0, sizeof(uint32_t) * (dirtyStop - dirtyStart));
+#ifdef WLED_ENABLE_WIDE_COLOR
+    if (_pixels16) memset(&_pixels16[dirtyStart], 0, sizeof(uint64_t) * (dirtyStop - dirtyStart));
+#endif
+    if (_pixelCCT) memset(&_pixelCCT[dirtyStart], 127, dirtyStop - dirtyStart); // set neutral (50:50) CCT
+    // blend all segments overlapping dirty span into (cleared) buffer
+    for (const Segment &seg : _segments) if (seg._lastHash) {
+      size_t s, e;
+      segSpan(seg, s, e);
+      if (s < dirtyStop && e > dirtyStart) {
+        RENDER_PROFILE_START(segStart);
+        blendSegment(seg); // blend segment's buffer into frame buffer
+        RENDER_PROFILE_SEGMENT(&seg - &_segments[0], seg.mode, RENDER_SEG_BLEND, segStart);
+      }
+    }
+    RENDER_PROFILE_STAGE(RENDER_STAGE_BLEND, blendStart);
+    // overlay layers on top of the segments
+    if (!_overlays.empty()) {
+      RENDER_PROFILE_START(layerStart);
+      blendOverlays(dirtyStart, dirtyStop);
+      RENDER_PROFILE_STAGE(RENDER_STAGE_LAYERS, layerStart);
     }
   }
 
   // avoid race condition, capture _callback value
   show_callback callback = _callback;
-  if (callback) callback(); // will call setPixelColor or setRealtimePixelColor
+  _touchedStart = UINT16_MAX;
+  _touchedStop  = 0;
+  if (callback) {
+    RENDER_PROFILE_START(overlayStart);
+    callback(); // will call setPixelColor or setRealtimePixelColor
+    RENDER_PROFILE_STAGE(RENDER_STAGE_OVERLAY, overlayStart);
+  }
+  // pixels painted by overlays need to be sent now and recomposed in next frame
+  _overlayStart = _touchedStart;
+  _overlayStop  = _touchedStop;
+  _touchedStart = UINT16_MAX;
+  _touchedStop  = 0;
+  if (_overlayStart < dirtyStart) dirtyStart = _overlayStart;
+  if (_overlayStop  > dirtyStop)  dirtyStop  = std::min((size_t)_overlayStop, totalLen);
+  // ABL needs all pixels to estimate current (bus buffers were also dimmed in place)
+  if (BusManager::_useABL && dirtyStart < dirtyStop) {
+    dirtyStart = 0;
+    dirtyStop  = totalLen;
+  }
+#ifdef WLED_ENABLE_WIDE_COLOR
+  // temporal dithering of 8 bit buses changes their output every frame
+  if (_pixels16) {
+    dirtyStart = 0;
+    dirtyStop  = totalLen;
+  }
+#endif
 
   // paint actual pixels
+  RENDER_PROFILE_START(paintStart);
   int oldCCT = Bus::getCCT(); // store original CCT value (since it is global)
   // when cctFromRgb is true we implicitly calculate WW and CW from RGB values (cct==-1)
   if (cctFromRgb) BusManager::setSegmentCCT(-1);
-  for (size_t i = 0; i < totalLen; i++) {
+  // gamma correction is applied by buses (fused with white balance and brightness for digital buses)
+  // note: applying gamma after brightness has too much color loss
+  Bus::setGammaCorrection(!(realtimeMode && arlsDisableGammaCorrection));
+  for (size_t i = dirtyStart; i < dirtyStop; i++) {
     // when correctWB is true setSegmentCCT() will convert CCT into K with which we can then
     // correct/adjust RGB value according to desired CCT value, it will still affect actual WW/CW ratio
     if (_pixelCCT) { // cctFromRgb already exluded at allocation
-      if (i == 0 || _pixelCCT[i-1] != _pixelCCT[i]) BusManager::setSegmentCCT(_pixelCCT[i], correctWB);
+      if (i == dirtyStart || _pixelCCT[i-1] != _pixelCCT[i]) BusManager::setSegmentCCT(_pixelCCT[i], correctWB);
     }
 
-    uint32_t c = _pixels[i]; // need a copy, do not modify _pixels directly (no byte access allowed on ESP32)
-    if (c > 0 && !(realtimeMode && arlsDisableGammaCorrection))
-        c = gamma32(c); // apply gamma correction if enabled note: applying gamma after brightness has too much color loss
-    BusManager::setPixelColor(getMappedPixelIndex(i), c);
+#ifdef WLED_ENABLE_WIDE_COLOR
+    // pixels painted directly into the frame buffer (overlays, realtime data) no longer match their wide color
+    if (_pixels16) {
+      const uint64_t c16 = _pixels16[i];
+      BusManager::setPixelColorWide(getMappedPixelIndex(i), color_narrow(c16) == _pixels[i] ? c16 : color_widen(_pixels[i]));
+      continue;
+    }
+#endif
+    BusManager::setPixelColor(getMappedPixelIndex(i), _pixels[i]);
   }
   Bus::setCCT(oldCCT);  // restore old CCT for ABL adjustments
-
-  p_free(_pixelCCT);
-  _pixelCCT = nullptr;
+  RENDER_PROFILE_STAGE(RENDER_STAGE_PAINT, paintStart);
 
   // some buses send asynchronously and this method will return before
   // all of the data has been sent.
   // See https://github.com/Makuna/NeoPixelBus/wiki/ESP32-NeoMethods#neoesp32rmt-methods
-  BusManager::show();
+  RENDER_PROFILE_START(busStart);
+  BusManager::show(true); // only send buses with changed pixels
+  RENDER_PROFILE_STAGE(RENDER_STAGE_BUS, busStart);
 
   if (diff > 0) { // skip calculation if no time has passed
     size_t fpsCurr = (1000 << FPS_CALC_SHIFT) / diff; // fixed point math
@@ -2046,8 +2309,7 @@ void WS2812FX::printSize() {
   for (const Segment &seg : _segments) size += seg.getSize();
   DEBUG_PRINTF_P(PSTR("Segments: %d -> %u/%dB\n"), _segments.size(), size, Segment::getUsedSegmentData());
   for (const Segment &seg : _segments) DEBUG_PRINTF_P(PSTR("  Seg: %d,%d [A=%d, 2D=%d, RGB=%d, W=%d, CCT=%d]\n"), seg.width(), seg.height(), seg.isActive(), seg.is2D(), seg.hasRGB(), seg.hasWhite(), seg.isCCT());
-  DEBUG_PRINTF_P(PSTR("Modes: %d*%d=%uB\n"), sizeof(mode_ptr), _mode.size(), (_mode.capacity()*sizeof(mode_ptr)));
-  DEBUG_PRINTF_P(PSTR("Data: %d*%d=%uB\n"), sizeof(const char *), _modeData.size(), (_modeData.capacity()*sizeof(const char *)));
+  DEBUG_PRINTF_P(PSTR("Modes: %u in flash + %d*%d=%uB\n"), (unsigned)_effectsLen, sizeof(EffectEntry), _addedEffects.size(), (_addedEffects.capacity()*sizeof(EffectEntry)));
   DEBUG_PRINTF_P(PSTR("Map: %d*%d=%uB\n"), sizeof(uint16_t), (int)customMappingSize, customMappingSize*sizeof(uint16_t));
 }
 #endif
@@ -2064,6 +2326,9 @@ bool WS2812FX::deserializeMap(unsigned n) {
 
   customMappingSize = 0; // prevent use of mapping if anything goes wrong
   currentLedmap = 0;
+  forceFullShow();      // mapping (and possibly dimensions) will change
+  p_free(_pixelCCT);    // CCT buffer will be re-allocated in show() if needed
+  _pixelCCT = nullptr;
   if (n == 0 || isFile) interfaceUpdateCallMode = CALL_MODE_WS_SEND; // schedule WS update (to inform UI)
 
   if (!isFile && n==0 && isMatrix) {
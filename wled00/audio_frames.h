@@ -0,0 +1,94 @@
+/* audio_frames.h
+
+Ring buffer of timestamped audio feature frames, shared between the audio processing (AudioReactive usermod)
+and effects. Written by a single producer, read by any number of consumers without locking.
+
+Every slot is guarded by a version counter (seqlock): the counter is odd while the producer writes the slot,
+readers copy the frame and retry if the counter changed in the meantime. Readers therefore always get a
+consistent frame (no half-updated GEQ channels) and never block the producer.
+
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+#include <atomic>
+
+#define AUDIO_FRAME_GEQ_CHANNELS 16  // must match NUM_GEQ_CHANNELS of AudioReactive
+#ifndef AUDIO_FRAME_HISTORY
+  #define AUDIO_FRAME_HISTORY    32  // number of frames kept (~0.7s with 21ms FFT cycle), must be a power of 2
+#endif
+
+// audio features of one audio processing cycle (40 bytes)
+typedef struct AudioFrame {
+  uint32_t timestamp;                           // millis() when frame was published
+  uint32_t seq;                                 // sequence number of frame (increments by 1 for each published frame)
+  float    volumeSmth;                          // smoothed volume
+  float    majorPeak;                           // strongest (peak) frequency
+  float    magnitude;                           // volume (magnitude) of peak frequency
+  int16_t  volumeRaw;                           // raw volume
+  uint8_t  samplePeak;                          // 1 if a sample peak was detected
+  uint8_t  onset;                               // onset strength 0-255
+  uint8_t  fftResult[AUDIO_FRAME_GEQ_CHANNELS]; // GEQ channels
+} audioframe_t;
+
+template<size_t N> class AudioFrameRing {
+  static_assert(N >= 2 && (N & (N-1)) == 0, "AudioFrameRing size must be a power of 2");
+
+  public:
+    AudioFrameRing() : _count(0) {}
+
+    // producer: publish a new frame (frame.seq is set by the ring)
+    void push(const AudioFrame &frame) {
+      const uint32_t n = _count.load(std::memory_order_relaxed);
+      Slot &slot = _slots[n & (N-1)];
+      const uint32_t v = slot.version.load(std::memory_order_relaxed);
+      slot.version.store(v + 1, std::memory_order_relaxed); // odd: slot is being written
+      std::atomic_thread_fence(std::memory_order_release);
+      slot.frame = frame;
+      slot.frame.seq = n;
+      slot.version.store(v + 2, std::memory_order_release);
+      _count.store(n + 1, std::memory_order_release);
+    }
+
+    // consumer: copy of the latest frame (age 0) or an older one (age 1 = previous frame, ...)
+    // returns false if the frame is not (or no longer) available
+    bool get(AudioFrame &frame, unsigned age = 0) const {
+      for (unsigned retry = 0; retry < 4; retry++) {
+        const uint32_t n = _count.load(std::memory_order_acquire);
+        if (age >= n || age >= N-1) return false; // the oldest slot may be overwritten at any time
+        const uint32_t seq = n - 1 - age;
+        const Slot &slot = _slots[seq & (N-1)];
+        const uint32_t v1 = slot.version.load(std::memory_order_acquire);
+        if (v1 & 1) continue; // producer is writing this slot
+        memcpy(&frame, (const void*)&slot.frame, sizeof(AudioFrame));
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.version.load(std::memory_order_relaxed) == v1 && frame.seq == seq) return true;
+      }
+      return false;
+    }
+
+    // consumer: copy up to maxFrames consecutive frames, newest first; returns number of frames copied
+    size_t history(AudioFrame *frames, size_t maxFrames) const {
+      size_t i = 0;
+      for (; i < maxFrames; i++) {
+        if (!get(frames[i], i)) break;
+        if (i > 0 && frames[i].seq + 1 != frames[i-1].seq) break; // producer overtook us, history would not be consecutive
+      }
+      return i;
+    }
+
+    inline uint32_t count() const { return _count.load(std::memory_order_acquire); } // number of frames published so far (use to detect new frames)
+    inline static constexpr size_t size() { return N - 1; }                          // maximum available history
+
+  private:
+    struct Slot {
+      std::atomic<uint32_t> version{0};
+      AudioFrame            frame{};
+    };
+    Slot                  _slots[N];
+    std::atomic<uint32_t> _count;
+};
+
+typedef AudioFrameRing<AUDIO_FRAME_HISTORY> AudioFrames;
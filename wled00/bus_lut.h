@@ -0,0 +1,131 @@
+/* bus_lut.h
+
+Per bus look-up tables of digital buses (BusDigital::setPixelColor()).
+
+BusColorLUT fuses gamma correction and white balance (color correction from CCT) into one lookup per channel, which
+is applied before the auto white calculation, and holds a brightness table that gives the same result as
+color_fade(c, bri, true). BusColorLUT16 is the 16 bit variant of the first table for 16 bit buses (UCS8903, UCS8904,
+SM16825), with gamma calculated at full precision so low brightness levels do not collapse into a few steps. With the
+wide color frame buffer (color16.h) its entries are interpolated for 16 bit input colors.
+
+Each bus keeps its own tables, so buses with different brightness share nothing and CCT changes only rebuild the
+table of the bus they apply to. Tables are rebuilt when their key (white balance, gamma table version, brightness)
+changes. Kelvin correction and gamma tables are passed in by the caller (colorKtoRGB(), NeoGammaWLEDMethod).
+
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <math.h>
+
+class BusColorLUT {
+  public:
+    // key of the correction table: kelvin (0 for none) and gamma table version (-1 for no gamma)
+    inline bool preMatches(int16_t kelvin, int16_t gamma) const { return kelvin == _kelvin && gamma == _gamma; }
+    inline bool briMatches(uint8_t bri) const                   { return bri == _bri; }
+
+    // correction: RGB multipliers of the white balance (255: none), gammaTable: 256 entries or nullptr (linear)
+    void buildPre(int16_t kelvin, int16_t gamma, const uint8_t correction[3], const uint8_t *gammaTable) {
+      for (unsigned i = 0; i < 256; i++) {
+        const unsigned g = gammaTable ? gammaTable[i] : i;
+        for (unsigned ch = 0; ch < 3; ch++) _pre[ch][i] = (correction[ch] * g) / 255; // see colorBalanceFromKelvin()
+        _pre[3][i] = g;
+      }
+      _kelvin = kelvin;
+      _gamma  = gamma;
+    }
+
+    void buildBri(uint8_t bri) {
+      for (unsigned i = 0; i < 256; i++) _briLUT[i] = (i * bri + 0x7F) >> 8; // video scaling with rounding (see color_fade())
+      _bri = bri;
+    }
+
+    // gamma & white balance of an RGBW32 color
+    inline uint32_t pre(uint32_t c) const {
+      if (!c) return 0;
+      return (uint32_t(_pre[3][c >> 24]) << 24) | (uint32_t(_pre[0][(c >> 16) & 0xFF]) << 16) | (uint32_t(_pre[1][(c >> 8) & 0xFF]) << 8) | _pre[2][c & 0xFF];
+    }
+
+    // brightness, same as color_fade(c, bri, true)
+    inline uint32_t fade(uint32_t c) const {
+      if (!c || _bri == 255) return c;
+      if (_bri == 0) return 0;
+      const uint8_t r = c >> 16, g = c >> 8, b = c, w = c >> 24;
+      uint8_t maxc = (r > g) ? ((r > b) ? r : b) : ((g > b) ? g : b);
+      maxc = (maxc>>2) + 1; // hue preservation threshold (see color_fade())
+      return (uint32_t(_briLUT[w] | (w > 0)) << 24) | (uint32_t(_briLUT[r] | (r > maxc)) << 16) | (uint32_t(_briLUT[g] | (g > maxc)) << 8) | (_briLUT[b] | (b > maxc));
+    }
+
+  private:
+    uint8_t _pre[4][256];   // gamma & white balance for R, G, B and gamma for W
+    uint8_t _briLUT[256];   // brightness scaling, hue preservation is applied separately
+    int16_t _kelvin = 0;
+    int16_t _gamma  = -2;   // invalid, forces initial build
+    int16_t _bri    = -1;   // invalid, forces initial build
+};
+
+// 16 bit gamma & white balance table, allocated only by 16 bit buses
+class BusColorLUT16 {
+  public:
+    inline bool matches(int16_t kelvin, int16_t gamma) const { return kelvin == _kelvin && gamma == _gamma; }
+
+    // gammaValue: gamma exponent (ignored if gamma < 0)
+    void build(int16_t kelvin, int16_t gamma, const uint8_t correction[3], float gammaValue) {
+      uint16_t *gammaRow = _pre[3]; // W channel is gamma only, RGB channels are derived from it
+      if (gamma != _gamma) {
+        for (unsigned i = 0; i < 256; i++) gammaRow[i] = gamma >= 0 ? uint16_t(powf(i / 255.0f, gammaValue) * 65535.0f + 0.5f) : i * 257U;
+      }
+      for (unsigned ch = 0; ch < 3; ch++) {
+        for (unsigned i = 0; i < 256; i++) _pre[ch][i] = (correction[ch] * uint32_t(gammaRow[i])) / 255;
+      }
+      _kelvin = kelvin;
+      _gamma  = gamma;
+    }
+
+    inline uint16_t operator()(unsigned ch, uint8_t v) const { return _pre[ch][v]; } // ch: 0 = R, 1 = G, 2 = B, 3 = W
+
+    // 16 bit input, linear interpolation between the entries of v/257 and v/257+1 (exact for widened 8 bit values)
+    inline uint16_t wide(unsigned ch, uint16_t v) const {
+      const unsigned i = v / 257U, f = v - i * 257U;
+      if (!f) return _pre[ch][i];
+      const int32_t a = _pre[ch][i], b = _pre[ch][i + 1]; // f > 0 implies i < 255
+      return a + ((b - a) * int32_t(f)) / 257;
+    }
+
+  private:
+    uint16_t _pre[4][256];
+    int16_t  _kelvin = 0;
+    int16_t  _gamma  = -2;  // invalid, forces initial build
+};
+
+// auto white calculation of 16 bit channels, same as Bus::autoWhiteCalc() (mode: RGBW_MODE_* of const.h)
+inline void autoWhite16(unsigned mode, uint32_t &r, uint32_t &g, uint32_t &b, uint32_t &w) {
+  if (mode == RGBW_MODE_MANUAL_ONLY || (mode == RGBW_MODE_DUAL && w > 0)) return;
+  if (mode == RGBW_MODE_MAX) { w = r > g ? (r > b ? r : b) : (g > b ? g : b); return; } // brightest RGB channel
+  w = r < g ? (r < b ? r : b) : (g < b ? g : b); // darkest RGB channel
+  if (mode == RGBW_MODE_AUTO_ACCURATE) { r -= w; g -= w; b -= w; } // subtract w in ACCURATE mode
+}
+
+// reorders 16 bit channels in place to the color order of a bus (co as in PolyBus::setPixelColor()):
+// r, g, b and w are then sent in the R, G, B and W slots of the chip, upper nibble of co swaps W or WW & CW
+inline void busColorOrder16(uint8_t co, uint16_t &r, uint16_t &g, uint16_t &b, uint16_t &w, uint16_t &ww, uint16_t &cw) {
+  uint16_t R = r, G = g, B = b, t;
+  switch (co & 0x0F) {
+    default:                     break; //0 = GRB, default
+    case  1: G = r; R = g;       break; //1 = RGB, common for WS2811
+    case  2: G = b; B = g;       break; //2 = BRG
+    case  3: G = r; R = b; B = g; break; //3 = RBG
+    case  4: G = b; R = g; B = r; break; //4 = BGR
+    case  5: R = b; B = r;       break; //5 = GBR
+  }
+  switch (co >> 4) {
+    default:                     break; // no swapping
+    case  1: t = w; w = B; B = t; break; // swap W & B
+    case  2: t = w; w = G; G = t; break; // swap W & G
+    case  3: t = w; w = R; R = t; break; // swap W & R
+    case  4: t = ww; ww = cw; cw = t; break; // swap WW & CW
+  }
+  r = R; g = G; b = B;
+}
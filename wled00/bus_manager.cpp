@@ -167,6 +167,10 @@ BusDigital::BusDigital(const BusConfig &bc)
   else {
     cleanup();
   }
+  if (_valid && is16bit(_type)) {
+    void *mem = d_malloc(sizeof(BusColorLUT16));
+    _lut16 = mem ? new(mem) BusColorLUT16() : nullptr; // 8 bit path is used if table could not be allocated
+  }
   DEBUGBUS_PRINTF_P(PSTR("Bus len:%u, type:%u (RGB:%d, W:%d, CCT:%d), pins:%u,%u [itype:%u, driver:%s] mA=%d/%d %s\n"),
     (int)bc.count,
     (int)bc.type,
@@ -248,8 +252,11 @@ void BusDigital::applyBriLimit(uint8_t newBri) {
 
 void BusDigital::show() {
   if (!_valid) return;
+  #ifdef WLED_ENABLE_WIDE_COLOR
+  _ditherFrame++; // next threshold of temporal dithering
+  #endif
   _NPBbri = (_NPBbri * _bri) / 255;      // total applied brightness for use in restoreColorLossy (see applyBriLimit())
-  PolyBus::show(_busPtr, _iType, _skip); // faster if buffer consistency is not important (no skipped LEDs)
+  PolyBus::show(_busPtr, _iType, true);  // buffer must stay consistent as WS2812FX::show() only updates changed pixels
 }
 
 bool BusDigital::canShow() const {
@@ -269,12 +276,22 @@ void BusDigital::setStatusPixel(uint32_t c) {
 // note: using WLED_O2_ATTR makes this function ~7% faster at the expense of 600 bytes of flash
 void IRAM_ATTR BusDigital::setPixelColor(unsigned pix, uint32_t c) {
   if (!_valid) return;
-  if (Bus::_cct >= 1900) c = colorBalanceFromKelvin(Bus::_cct, c); //color correction from CCT
+  if (_lut16 && is16bit()) { setPixelColor16(pix, c); return; }
+  // gamma and white balance (color correction from CCT) in a single lookup per channel
+  const int16_t kelvin = Bus::_cct >= 1900 ? Bus::_cct : 0;
+  const int16_t gamma  = Bus::_gammaOut && gammaCorrectCol ? NeoGammaWLEDMethod::tableVersion() : -1;
+  if (!_lut.preMatches(kelvin, gamma)) updatePreLUT(kelvin, gamma);
+  c = _lut.pre(c);
   uint8_t cctWW = 0, cctCW = 0;
-  uint16_t wwcw = 0;
   if (hasWhite()) c = autoWhiteCalc(c, cctWW, cctCW);
-  c = color_fade(c, _bri, true); // apply brightness
+  // apply brightness, same as color_fade(c, _bri, true) but table driven
+  if (!_lut.briMatches(_bri)) _lut.buildBri(_bri);
+  paint(pix, _lut.fade(c), cctWW, cctCW);
+}
 
+// output of an 8 bit color (brightness already applied), cctWW & cctCW are scaled by brightness here
+void IRAM_ATTR BusDigital::paint(unsigned pix, uint32_t c, uint8_t cctWW, uint8_t cctCW) {
+  uint16_t wwcw = 0;
   if (hasCCT()) {
     wwcw = ((cctCW + 1) * _bri) & 0xFF00; // apply brightness to CCT (store CW in upper byte)
     wwcw |= ((cctWW + 1) * _bri) >> 8;
@@ -308,6 +325,88 @@ void IRAM_ATTR BusDigital::setPixelColor(unsigned pix, uint32_t c) {
   PolyBus::setPixelColor(_busPtr, _iType, pix, c, co, wwcw);
 }
 
+// 16 bit output path: gamma, white balance, auto white and brightness are calculated with 16 bit precision
+// note: ABL (applyBriLimit()) and getPixelColor() still operate on 8 bit values
+void IRAM_ATTR BusDigital::setPixelColor16(unsigned pix, uint32_t c) {
+  const int16_t kelvin = Bus::_cct >= 1900 ? Bus::_cct : 0;
+  const int16_t gamma  = Bus::_gammaOut && gammaCorrectCol ? NeoGammaWLEDMethod::tableVersion() : -1;
+  if (!_lut16->matches(kelvin, gamma)) updatePreLUT(kelvin, gamma, true);
+  const BusColorLUT16 &lut = *_lut16;
+  paint16(pix, lut(0, R(c)), lut(1, G(c)), lut(2, B(c)), lut(3, W(c)));
+}
+
+#ifdef WLED_ENABLE_WIDE_COLOR
+// color from the wide color frame buffer: 16 bit buses output it at full precision, 8 bit buses dither it temporally
+// note: 8 bit buses allocate their 16 bit table on first use (the buffer only exists if a 16 bit bus is configured)
+void IRAM_ATTR BusDigital::setPixelColorWide(unsigned pix, uint64_t c) {
+  if (!_valid) return;
+  if (!_lut16) {
+    void *mem = d_malloc(sizeof(BusColorLUT16));
+    if (!mem) { setPixelColor(pix, color_narrow(c)); return; } // fall back to 8 bit path
+    _lut16 = new(mem) BusColorLUT16();
+  }
+  const int16_t kelvin = Bus::_cct >= 1900 ? Bus::_cct : 0;
+  const int16_t gamma  = Bus::_gammaOut && gammaCorrectCol ? NeoGammaWLEDMethod::tableVersion() : -1;
+  if (!_lut16->matches(kelvin, gamma)) updatePreLUT(kelvin, gamma, true);
+  const BusColorLUT16 &lut = *_lut16;
+  uint32_t r = lut.wide(0, R16(c)), g = lut.wide(1, G16(c)), b = lut.wide(2, B16(c)), w = lut.wide(3, W16(c));
+  if (is16bit()) { paint16(pix, r, g, b, w); return; }
+
+  uint8_t cctWW = 0, cctCW = 0;
+  if (hasWhite()) {
+    const uint32_t r0 = r, g0 = g, b0 = b;
+    autoWhite16(_gAWM < AW_GLOBAL_DISABLED ? _gAWM : _autoWhiteMode, r, g, b, w);
+    if (hasCCT()) calculateCCT(RGBW32(r0 >> 8, g0 >> 8, b0 >> 8, w >> 8), cctWW, cctCW);
+  }
+  const uint16_t bri = _bri * 257U;
+  const uint8_t  t   = ditherThreshold(_ditherFrame, pix);
+  paint(pix, RGBW32(dither8(fade16(r, bri, true), t), dither8(fade16(g, bri, true), t), dither8(fade16(b, bri, true), t), dither8(fade16(w, bri, true), t)), cctWW, cctCW);
+}
+#endif
+
+// auto white, brightness and output of 16 bit channels (gamma and white balance already applied)
+void IRAM_ATTR BusDigital::paint16(unsigned pix, uint32_t r, uint32_t g, uint32_t b, uint32_t w) {
+  uint8_t cctWW = 0, cctCW = 0;
+  if (hasWhite()) {
+    const uint32_t r0 = r, g0 = g, b0 = b;
+    autoWhite16(_gAWM < AW_GLOBAL_DISABLED ? _gAWM : _autoWhiteMode, r, g, b, w);
+    if (hasCCT()) calculateCCT(RGBW32(r0 >> 8, g0 >> 8, b0 >> 8, w >> 8), cctWW, cctCW); // need original rgb values in case CCT is derived from RGB
+  }
+  // apply brightness (keep non-zero channels lit, similar to video scaling)
+  if (_bri == 0) r = g = b = w = 0;
+  else if (_bri < 255) {
+    const uint16_t bri = _bri * 257U;
+    r = fade16(r, bri, true);
+    g = fade16(g, bri, true);
+    b = fade16(b, bri, true);
+    w = fade16(w, bri, true);
+  }
+  uint16_t ww = (uint32_t(cctWW) * 257U * _bri) / 255U;
+  uint16_t cw = (uint32_t(cctCW) * 257U * _bri) / 255U;
+
+  if (BusManager::_useABL) {
+    // if using ABL, sum all color channels to estimate current and limit brightness in show()
+    if (_milliAmpsPerLed < 255) { // normal ABL
+      _colorSum += (r >> 8) + (g >> 8) + (b >> 8) + (w >> 8);
+    } else { // wacky WS2815 power model, ignore white channel, use max of RGB (issue #549)
+      _colorSum += ((r > g) ? ((r > b) ? r : b) : ((g > b) ? g : b)) >> 8;
+    }
+  }
+
+  if (_reversed) pix = _len - pix -1;
+  pix += _skip;
+  const uint8_t co = _colorOrderMap.getPixelColorOrder(pix+_start, _colorOrder);
+  PolyBus::setPixelColor16(_busPtr, _iType, pix, r, g, b, w, co, ww, cw);
+}
+
+// rebuilds the gamma & white balance table of the 8 bit path or the 16 bit (wide) path
+void BusDigital::updatePreLUT(int16_t kelvin, int16_t gamma, bool wide) {
+  byte correction[4] = {255, 255, 255, 255};
+  if (kelvin >= 1900) colorKtoRGB(kelvin, correction);
+  if (wide) _lut16->build(kelvin, gamma, correction, gammaCorrectVal);
+  else      _lut.buildPre(kelvin, gamma, correction, gamma >= 0 ? NeoGammaWLEDMethod::rawGammaTable() : nullptr);
+}
+
 // returns lossly restored color from bus
 uint32_t IRAM_ATTR BusDigital::getPixelColor(unsigned pix) const {
   if (!_valid) return 0;
@@ -385,6 +484,10 @@ void BusDigital::begin() {
 
 void BusDigital::cleanup() {
   DEBUGBUS_PRINTLN(F("Digital Cleanup."));
+  if (_lut16) {
+    d_free(_lut16); // trivially destructible
+    _lut16 = nullptr;
+  }
   PolyBus::cleanup(_busPtr, _iType);
   _iType = I_NONE;
   _valid = false;
@@ -470,6 +573,7 @@ BusPwm::BusPwm(const BusConfig &bc)
 
 void BusPwm::setPixelColor(unsigned pix, uint32_t c) {
   if (pix != 0 || !_valid) return; //only react to first pixel
+  c = applyGamma(c);
   if (Bus::_cct >= 1900 && (_type == TYPE_ANALOG_3CH || _type == TYPE_ANALOG_4CH)) {
     c = colorBalanceFromKelvin(Bus::_cct, c); //color correction from CCT
   }
@@ -654,6 +758,7 @@ BusOnOff::BusOnOff(const BusConfig &bc)
 
 void BusOnOff::setPixelColor(unsigned pix, uint32_t c) {
   if (pix != 0 || !_valid) return; //only react to first pixel
+  c = applyGamma(c);
   _data = (c > 0) && bool(_bri) ? 0xFF : 0; // if any color channel is on and brightness is not zero, set to on
 }
 
@@ -714,6 +819,7 @@ BusNetwork::BusNetwork(const BusConfig &bc)
 
 void BusNetwork::setPixelColor(unsigned pix, uint32_t c) {
   if (!_valid || pix >= _len) return;
+  c = applyGamma(c);
   uint8_t ww, cw; // dummy, unused
   if (_hasWhite) c = autoWhiteCalc(c, ww, cw);
   if (Bus::_cct >= 1900) c = colorBalanceFromKelvin(Bus::_cct, c); //color correction from CCT
@@ -1039,6 +1145,7 @@ BusHub75Matrix::BusHub75Matrix(const BusConfig &bc) : Bus(bc.type, bc.start, bc.
 
 void IRAM_ATTR BusHub75Matrix::setPixelColor(unsigned pix, uint32_t c) {
   if (!_valid) return; // note: no need to check pix >= _len as that is checked in containsPixel()
+  c = applyGamma(c);
   // if (_cct >= 1900) c = colorBalanceFromKelvin(_cct, c); //color correction from CCT
 
   if (_ledBuffer) {
@@ -1335,10 +1442,16 @@ void BusManager::off() {
   _gMilliAmpsUsed = 0; // reset, assume no LED idle current if relay is off
 }
 
-void BusManager::show() {
-  applyABL(); // apply brightness limit, updates _gMilliAmpsUsed
+// if onlyDirty is set, digital buses whose pixels were not updated since last show are not re-sent as LEDs latch their
+// last values (buses that require refresh are always sent); ABL is only re-evaluated if any pixel was updated
+// note: if ABL is used, all pixels need to be updated in a frame for current estimation to be correct
+void BusManager::show(bool onlyDirty) {
+  bool anyDirty = !onlyDirty;
+  for (const auto &bus : busses) anyDirty |= bus->isDirty();
+  if (anyDirty) applyABL(); // apply brightness limit, updates _gMilliAmpsUsed
   for (auto &bus : busses) {
-    bus->show();
+    if (!onlyDirty || bus->isDirty() || !bus->isDigital() || bus->isOffRefreshRequired()) bus->show();
+    bus->setDirty(false);
   }
 }
 
@@ -1346,8 +1459,19 @@ void IRAM_ATTR BusManager::setPixelColor(unsigned pix, uint32_t c) {
   for (auto &bus : busses) {
     if (!bus->containsPixel(pix)) continue;
     bus->setPixelColor(pix - bus->getStart(), c);
+    bus->setDirty();
+  }
+}
+
+#ifdef WLED_ENABLE_WIDE_COLOR
+void IRAM_ATTR BusManager::setPixelColorWide(unsigned pix, uint64_t c) {
+  for (auto &bus : busses) {
+    if (!bus->containsPixel(pix)) continue;
+    bus->setPixelColorWide(pix - bus->getStart(), c);
+    bus->setDirty();
   }
 }
+#endif
 
 void BusManager::setSegmentCCT(int16_t cct, bool allowWBCorrection) {
   if (cct > 255) cct = 255;
@@ -1465,6 +1589,11 @@ uint8_t PolyBus::_2PchannelsAssigned = 0;
 int16_t Bus::_cct = -1;     // -1 means use approximateKelvinFromRGB(), 0-255 is standard, >1900 use colorBalanceFromKelvin()
 int8_t  Bus::_cctBlend = 0; // -128 to +127
 uint8_t Bus::_gAWM = 255;
+bool    Bus::_gammaOut = false;
+
+uint32_t Bus::applyGamma(uint32_t c) {
+  return _gammaOut && c ? gamma32(c) : c; // gamma32() checks gammaCorrectCol
+}
 
 uint16_t BusDigital::_milliAmpsTotal = 0;
 
@@ -15,6 +15,8 @@
 
 #include "const.h"
 #include "pin_manager.h"
+#include "bus_lut.h"
+#include "color16.h"
 #include <vector>
 #include <memory>
 #ifdef ARDUINO_ARCH_ESP32
@@ -121,6 +123,7 @@ class Bus {
     , _reversed(reversed)
     , _valid(false)
     , _needsRefresh(refresh)
+    , _dirty(true)
     {
       _autoWhiteMode = Bus::hasWhite(type) ? aw : RGBW_MODE_MANUAL_ONLY;
     };
@@ -132,6 +135,9 @@ class Bus {
     virtual bool     canShow() const                            { return true; }
     virtual void     setStatusPixel(uint32_t c)                 {}
     virtual void     setPixelColor(unsigned pix, uint32_t c)    = 0;
+#ifdef WLED_ENABLE_WIDE_COLOR
+    virtual void     setPixelColorWide(unsigned pix, uint64_t c){ setPixelColor(pix, color_narrow(c)); } // color from wide color frame buffer (color16.h)
+#endif
     virtual void     setBrightness(uint8_t b)                   { _bri = b; };
     virtual void     setColorOrder(uint8_t co)                  {}
     virtual uint32_t getPixelColor(unsigned pix) const          { return 0; }
@@ -168,6 +174,8 @@ class Bus {
     inline  bool     isOk() const                               { return _valid; }
     inline  bool     isReversed() const                         { return _reversed; }
     inline  bool     isOffRefreshRequired() const               { return _needsRefresh; }
+    inline  bool     isDirty() const                            { return _dirty; } // pixels were updated since last show
+    inline  void     setDirty(bool dirty = true)                { _dirty = dirty; }
     inline  bool     containsPixel(uint16_t pix) const          { return pix >= _start && pix < _start + _len; }
 
     static inline std::vector<LEDType> getLEDTypes()            { return {{TYPE_NONE, "", PSTR("None")}}; } // not used. just for reference for derived classes
@@ -204,6 +212,8 @@ class Bus {
     static inline void     setGlobalAWMode(uint8_t m) { if (m < 5) _gAWM = m; else _gAWM = AW_GLOBAL_DISABLED; }
     static inline uint8_t  getGlobalAWMode()          { return _gAWM; }
     static inline void     setCCT(int16_t cct)        { _cct = cct; }
+    static inline void     setGammaCorrection(bool g) { _gammaOut = g; }  // gamma is applied by buses in setPixelColor() (set by WS2812FX::show())
+    static inline bool     getGammaCorrection()       { return _gammaOut; }
     static inline int8_t   getCCTBlend()              { return (_cctBlend * 100 + (_cctBlend >= 0 ? 64 : -64)) / 127; } // returns -100 to +100, +/-100% = +/-127. +/-64 for rounding 
     static inline void     setCCTBlend(int8_t b) {    // input is -100 to +100
       _cctBlend = (std::max(-100, std::min(100, (int)b)) * 127 + (b >= 0 ? 50 : -50)) / 100; // +/-50 for rounding, b=+/-100% -> +/-127
@@ -228,6 +238,7 @@ class Bus {
       bool _hasRgb;//       : 1;
       bool _hasWhite;//     : 1;
       bool _hasCCT;//       : 1;
+      bool _dirty;//        : 1;
     //} __attribute__ ((packed));
     static uint8_t _gAWM;
     // _cct has the following meanings (see calculateCCT() & BusManager::setSegmentCCT()):
@@ -241,6 +252,9 @@ class Bus {
     //   63 - semi additive/nonlinear (CCT 127 => 66% warm, 66% cold)
     //  127 - additive CCT blending (CCT 127 => 100% warm, 100% cold)
     static int8_t _cctBlend;
+    static bool   _gammaOut;  // apply gamma correction to colors passed to setPixelColor()
+
+    static uint32_t applyGamma(uint32_t c); // applies gamma correction if enabled (for buses without fused look-up tables)
 
     uint32_t autoWhiteCalc(uint32_t c, uint8_t &ww, uint8_t &cw) const;
 };
@@ -255,6 +269,11 @@ class BusDigital : public Bus {
     bool canShow() const override;
     void setStatusPixel(uint32_t c) override;
     [[gnu::hot]] void setPixelColor(unsigned pix, uint32_t c) override;
+    [[gnu::hot]] void setPixelColor16(unsigned pix, uint32_t c); // 16 bit per channel output path for 16 bit chipsets
+#ifdef WLED_ENABLE_WIDE_COLOR
+    [[gnu::hot]] void setPixelColorWide(unsigned pix, uint64_t c) override; // full precision on 16 bit buses, dithered on 8 bit buses
+#endif
+    void updatePreLUT(int16_t kelvin, int16_t gamma, bool wide = false);
     void setColorOrder(uint8_t colorOrder) override;
     [[gnu::hot]] uint32_t getPixelColor(unsigned pix) const override;
     uint8_t  getColorOrder() const override  { return _colorOrder; }
@@ -287,9 +306,19 @@ class BusDigital : public Bus {
     uint16_t _milliAmpsLimit;
     uint32_t _colorSum; // total color value for the bus, updated in setPixelColor(), used to estimate current
     void    *_busPtr;
+#ifdef WLED_ENABLE_WIDE_COLOR
+    uint8_t  _ditherFrame = 0; // frame counter of temporal dithering (color16.h)
+#endif
 
     static uint16_t _milliAmpsTotal; // is overwitten/recalculated on each show()
 
+    // fused look-up tables of this bus (bus_lut.h), rebuilt only when their inputs change
+    BusColorLUT    _lut;                 // gamma & white balance (before auto white calculation) and brightness
+    BusColorLUT16 *_lut16 = nullptr;     // 16 bit gamma & white balance, only allocated for 16 bit buses (and 8 bit buses fed by the wide color frame buffer)
+
+    [[gnu::hot]] void paint(unsigned pix, uint32_t c, uint8_t cctWW, uint8_t cctCW);       // output of a color with brightness applied
+    [[gnu::hot]] void paint16(unsigned pix, uint32_t r, uint32_t g, uint32_t b, uint32_t w); // auto white, brightness and output of 16 bit channels
+
     inline uint32_t restoreColorLossy(uint32_t c, uint8_t restoreBri) const {
       if (restoreBri < 255) {
         uint8_t* chan = (uint8_t*) &c;
@@ -560,8 +589,11 @@ namespace BusManager {
   void off();
 
   [[gnu::hot]] void     setPixelColor(unsigned pix, uint32_t c);
+#ifdef WLED_ENABLE_WIDE_COLOR
+  [[gnu::hot]] void     setPixelColorWide(unsigned pix, uint64_t c);
+#endif
   [[gnu::hot]] uint32_t getPixelColor(unsigned pix);
-  void        show();
+  void        show(bool onlyDirty = false); // onlyDirty: skip digital buses with unchanged pixels
   bool        canAllShow();
   inline void setStatusPixel(uint32_t c) { for (auto &bus : busses) bus->setStatusPixel(c);}
   inline void setBrightness(uint8_t b)   { for (auto &bus : busses) bus->setBrightness(b); }
@@ -571,6 +603,7 @@ namespace BusManager {
   inline int16_t getSegmentCCT()         { return Bus::getCCT(); }
   inline Bus*    getBus(size_t busNr)    { return busNr < busses.size() ? busses[busNr].get() : nullptr; }
   inline size_t  getNumBusses()          { return busses.size(); }
+  inline bool    has16bitBus()           { for (const auto &bus : busses) if (bus->is16bit()) return true; return false; }
 
   //semi-duplicate of strip.getLengthTotal() (though that just returns strip._length, calculated in finalizeInit())
   inline uint16_t getTotalLength(bool onlyPhysical = false) {
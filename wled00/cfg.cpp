@@ -42,129 +42,8 @@ static inline void getStringFromJson(char* dest, const char* src, size_t len) {
   if (src != nullptr) strlcpy(dest, src, len);
 }
 
-bool deserializeConfig(JsonObject doc, bool fromFS) {
-  bool needsSave = false;
-  //int rev_major = doc["rev"][0]; // 1
-  //int rev_minor = doc["rev"][1]; // 0
-
-  long vid = doc[F("vid")] | VERSION; // 2605010 note: "vid" can be used to detect an update from older versions but only on first call, it is written to the new VID after buses are initialized
-
-  JsonObject id = doc["id"];
-  getStringFromJson(cmDNS, id[F("mdns")], 33);
-  getStringFromJson(serverDescription, id[F("name")], 33);
-#ifndef WLED_DISABLE_ALEXA
-  getStringFromJson(alexaInvocationName, id[F("inv")], 33);
-#endif
-  CJSON(simplifiedUI, id[F("sui")]);
-
-  JsonObject nw = doc["nw"];
-#ifndef WLED_DISABLE_ESPNOW
-  CJSON(enableESPNow, nw[F("espnow")]);
-  linked_remotes.clear();
-  JsonVariant lrem = nw[F("linked_remote")];
-  if (!lrem.isNull()) {
-     if (lrem.is<JsonArray>()) {
-      for (size_t i = 0; i < lrem.size(); i++) {
-        std::array<char, 13> entry{};
-        getStringFromJson(entry.data(), lrem[i], 13);
-        entry[12] = '\0';
-        linked_remotes.emplace_back(entry);
-      }
-    }
-    else { // legacy support for single MAC address in config
-      std::array<char, 13> entry{};
-      getStringFromJson(entry.data(), lrem, 13);
-      entry[12] = '\0';
-      linked_remotes.emplace_back(entry);
-    }
-  }
-#endif
-
-  size_t n = 0;
-  JsonArray nw_ins = nw["ins"];
-  if (!nw_ins.isNull()) {
-    // as password are stored separately in wsec.json when reading configuration vector resize happens there, but for dynamic config we need to resize if necessary
-    if (nw_ins.size() > 1 && nw_ins.size() > multiWiFi.size()) multiWiFi.resize(nw_ins.size()); // resize constructs objects while resizing
-    for (JsonObject wifi : nw_ins) {
-      JsonArray ip = wifi["ip"];
-      JsonArray gw = wifi["gw"];
-      JsonArray sn = wifi["sn"];
-      char ssid[33] = "";
-      char pass[65] = "";
-      char bssid[13] = "";
-      IPAddress nIP = (uint32_t)0U, nGW = (uint32_t)0U, nSN = (uint32_t)0x00FFFFFF; // little endian
-      getStringFromJson(ssid, wifi[F("ssid")], 33);
-      getStringFromJson(pass, wifi["psk"], 65); // password is not normally present but if it is, use it
-      getStringFromJson(bssid, wifi[F("bssid")], 13);
-      for (size_t i = 0; i < 4; i++) {
-        CJSON(nIP[i], ip[i]);
-        CJSON(nGW[i], gw[i]);
-        CJSON(nSN[i], sn[i]);
-      }
-      if (strlen(ssid) > 0) strlcpy(multiWiFi[n].clientSSID, ssid, 33); // this will keep old SSID intact if not present in JSON
-      if (strlen(pass) > 0) strlcpy(multiWiFi[n].clientPass, pass, 65); // this will keep old password intact if not present in JSON
-      if (strlen(bssid) > 0) fillStr2MAC(multiWiFi[n].bssid, bssid);
-      multiWiFi[n].staticIP = nIP;
-      multiWiFi[n].staticGW = nGW;
-      multiWiFi[n].staticSN = nSN;
-#ifdef WLED_ENABLE_WPA_ENTERPRISE
-      byte encType = WIFI_ENCRYPTION_TYPE_PSK;
-      char anonIdent[65] = "";
-      char ident[65] = "";
-      CJSON(encType, wifi[F("enc_type")]);
-      getStringFromJson(anonIdent, wifi["e_anon_ident"], 65);
-      getStringFromJson(ident, wifi["e_ident"], 65);
-      multiWiFi[n].encryptionType = encType;
-      strlcpy(multiWiFi[n].enterpriseAnonIdentity, anonIdent, 65);
-      strlcpy(multiWiFi[n].enterpriseIdentity, ident, 65);
-#endif
-      if (++n >= WLED_MAX_WIFI_COUNT) break;
-    }
-  }
-
-  JsonArray dns = nw[F("dns")];
-  if (!dns.isNull()) {
-    for (size_t i = 0; i < 4; i++) {
-      CJSON(dnsAddress[i], dns[i]);
-    }
-  }
-
-  // https://github.com/wled/WLED/issues/5247
-#ifdef WLED_USE_ETHERNET
-  JsonObject ethernet = doc[F("eth")];
-  CJSON(ethernetType, ethernet["type"]);
-  // NOTE: Ethernet configuration takes priority over other use of pins
-  initEthernet();
-#endif
-
-  JsonObject ap = doc["ap"];
-  getStringFromJson(apSSID, ap[F("ssid")], 33);
-  getStringFromJson(apPass, ap["psk"] , 65); //normally not present due to security
-  //int ap_pskl = ap[F("pskl")];
-  CJSON(apChannel, ap[F("chan")]);
-  if (apChannel > 13 || apChannel < 1) apChannel = 6; // reset to default if invalid
-  CJSON(apHide, ap[F("hide")]);
-  if (apHide > 1) apHide = 1;
-  CJSON(apBehavior, ap[F("behav")]);
-  /*
-  JsonArray ap_ip = ap["ip"];
-  for (unsigned i = 0; i < 4; i++) {
-    apIP[i] = ap_ip;
-  }
-  */
-
-  JsonObject wifi = doc[F("wifi")];
-  noWifiSleep = !(wifi[F("sleep")] | !noWifiSleep); // inverted
-  //noWifiSleep = !noWifiSleep;
-  CJSON(force802_3g, wifi[F("phy")]); //force phy mode g?
-#ifdef ARDUINO_ARCH_ESP32
-  CJSON(txPower, wifi[F("txpwr")]);
-  txPower = min(max((int)txPower, (int)WIFI_POWER_2dBm), (int)WIFI_POWER_19_5dBm);
-#endif
-
-  JsonObject hw = doc[F("hw")];
-
-  // initialize LED pins and lengths prior to other HW (except for ethernet)
+// LED outputs, LED settings and color order map (hw.led, hw.com)
+static void deserializeLedConfig(JsonObject hw, bool fromFS) {
   JsonObject hw_led = hw["led"];
 
   uint16_t total = hw_led[F("total")] | strip.getLengthTotal();
@@ -347,6 +226,132 @@ bool deserializeConfig(JsonObject doc, bool fromFS) {
       if (!BusManager::getColorOrderMap().add(start, len, colorOrder)) break;
     }
   }
+}
+
+bool deserializeConfig(JsonObject doc, bool fromFS, bool ledsCached) {
+  bool needsSave = false;
+  //int rev_major = doc["rev"][0]; // 1
+  //int rev_minor = doc["rev"][1]; // 0
+
+  long vid = doc[F("vid")] | VERSION; // 2605010 note: "vid" can be used to detect an update from older versions but only on first call, it is written to the new VID after buses are initialized
+
+  JsonObject id = doc["id"];
+  getStringFromJson(cmDNS, id[F("mdns")], 33);
+  getStringFromJson(serverDescription, id[F("name")], 33);
+#ifndef WLED_DISABLE_ALEXA
+  getStringFromJson(alexaInvocationName, id[F("inv")], 33);
+#endif
+  CJSON(simplifiedUI, id[F("sui")]);
+
+  JsonObject nw = doc["nw"];
+#ifndef WLED_DISABLE_ESPNOW
+  CJSON(enableESPNow, nw[F("espnow")]);
+  linked_remotes.clear();
+  JsonVariant lrem = nw[F("linked_remote")];
+  if (!lrem.isNull()) {
+     if (lrem.is<JsonArray>()) {
+      for (size_t i = 0; i < lrem.size(); i++) {
+        std::array<char, 13> entry{};
+        getStringFromJson(entry.data(), lrem[i], 13);
+        entry[12] = '\0';
+        linked_remotes.emplace_back(entry);
+      }
+    }
+    else { // legacy support for single MAC address in config
+      std::array<char, 13> entry{};
+      getStringFromJson(entry.data(), lrem, 13);
+      entry[12] = '\0';
+      linked_remotes.emplace_back(entry);
+    }
+  }
+#endif
+
+  size_t n = 0;
+  JsonArray nw_ins = nw["ins"];
+  if (!nw_ins.isNull()) {
+    // as password are stored separately in wsec.json when reading configuration vector resize happens there, but for dynamic config we need to resize if necessary
+    if (nw_ins.size() > 1 && nw_ins.size() > multiWiFi.size()) multiWiFi.resize(nw_ins.size()); // resize constructs objects while resizing
+    for (JsonObject wifi : nw_ins) {
+      JsonArray ip = wifi["ip"];
+      JsonArray gw = wifi["gw"];
+      JsonArray sn = wifi["sn"];
+      char ssid[33] = "";
+      char pass[65] = "";
+      char bssid[13] = "";
+      IPAddress nIP = (uint32_t)0U, nGW = (uint32_t)0U, nSN = (uint32_t)0x00FFFFFF; // little endian
+      getStringFromJson(ssid, wifi[F("ssid")], 33);
+      getStringFromJson(pass, wifi["psk"], 65); // password is not normally present but if it is, use it
+      getStringFromJson(bssid, wifi[F("bssid")], 13);
+      for (size_t i = 0; i < 4; i++) {
+        CJSON(nIP[i], ip[i]);
+        CJSON(nGW[i], gw[i]);
+        CJSON(nSN[i], sn[i]);
+      }
+      if (strlen(ssid) > 0) strlcpy(multiWiFi[n].clientSSID, ssid, 33); // this will keep old SSID intact if not present in JSON
+      if (strlen(pass) > 0) strlcpy(multiWiFi[n].clientPass, pass, 65); // this will keep old password intact if not present in JSON
+      if (strlen(bssid) > 0) fillStr2MAC(multiWiFi[n].bssid, bssid);
+      multiWiFi[n].staticIP = nIP;
+      multiWiFi[n].staticGW = nGW;
+      multiWiFi[n].staticSN = nSN;
+#ifdef WLED_ENABLE_WPA_ENTERPRISE
+      byte encType = WIFI_ENCRYPTION_TYPE_PSK;
+      char anonIdent[65] = "";
+      char ident[65] = "";
+      CJSON(encType, wifi[F("enc_type")]);
+      getStringFromJson(anonIdent, wifi["e_anon_ident"], 65);
+      getStringFromJson(ident, wifi["e_ident"], 65);
+      multiWiFi[n].encryptionType = encType;
+      strlcpy(multiWiFi[n].enterpriseAnonIdentity, anonIdent, 65);
+      strlcpy(multiWiFi[n].enterpriseIdentity, ident, 65);
+#endif
+      if (++n >= WLED_MAX_WIFI_COUNT) break;
+    }
+  }
+
+  JsonArray dns = nw[F("dns")];
+  if (!dns.isNull()) {
+    for (size_t i = 0; i < 4; i++) {
+      CJSON(dnsAddress[i], dns[i]);
+    }
+  }
+
+  // https://github.com/wled/WLED/issues/5247
+#ifdef WLED_USE_ETHERNET
+  JsonObject ethernet = doc[F("eth")];
+  CJSON(ethernetType, ethernet["type"]);
+  // NOTE: Ethernet configuration takes priority over other use of pins
+  initEthernet();
+#endif
+
+  JsonObject ap = doc["ap"];
+  getStringFromJson(apSSID, ap[F("ssid")], 33);
+  getStringFromJson(apPass, ap["psk"] , 65); //normally not present due to security
+  //int ap_pskl = ap[F("pskl")];
+  CJSON(apChannel, ap[F("chan")]);
+  if (apChannel > 13 || apChannel < 1) apChannel = 6; // reset to default if invalid
+  CJSON(apHide, ap[F("hide")]);
+  if (apHide > 1) apHide = 1;
+  CJSON(apBehavior, ap[F("behav")]);
+  /*
+  JsonArray ap_ip = ap["ip"];
+  for (unsigned i = 0; i < 4; i++) {
+    apIP[i] = ap_ip;
+  }
+  */
+
+  JsonObject wifi = doc[F("wifi")];
+  noWifiSleep = !(wifi[F("sleep")] | !noWifiSleep); // inverted
+  //noWifiSleep = !noWifiSleep;
+  CJSON(force802_3g, wifi[F("phy")]); //force phy mode g?
+#ifdef ARDUINO_ARCH_ESP32
+  CJSON(txPower, wifi[F("txpwr")]);
+  txPower = min(max((int)txPower, (int)WIFI_POWER_2dBm), (int)WIFI_POWER_19_5dBm);
+#endif
+
+  JsonObject hw = doc[F("hw")];
+
+  // initialize LED pins and lengths prior to other HW (except for ethernet), unless done from the binary snapshot
+  if (!ledsCached) deserializeLedConfig(hw, fromFS);
 
   // read multiple button configuration
   JsonObject btn_obj = hw["btn"];
@@ -459,7 +464,7 @@ bool deserializeConfig(JsonObject doc, bool fromFS) {
   JsonObject relay = hw[F("relay")];
 
   rlyOpenDrain  = relay[F("odrain")] | rlyOpenDrain;
-  int hw_relay_pin = relay["pin"] | -2;
+  int hw_relay_pin = ledsCached ? -2 : relay["pin"] | -2; // relay is already initialised from the snapshot
   if (hw_relay_pin > -2) {
     PinManager::deallocatePin(rlyPin, PinOwner::Relay);
     if (PinManager::allocatePin(hw_relay_pin,true, PinOwner::Relay)) {
@@ -569,6 +574,7 @@ bool deserializeConfig(JsonObject doc, bool fromFS) {
   CJSON(receiveGroups, if_sync_recv["grp"]);
   CJSON(receiveSegmentOptions, if_sync_recv["seg"]);
   CJSON(receiveSegmentBounds, if_sync_recv["sb"]);
+  CJSON(clockSyncEnabled, if_sync_recv[F("clk")]);
 
   JsonObject if_sync_send = if_sync[F("send")];
   CJSON(sendNotifications, if_sync_send["en"]);
@@ -589,6 +595,7 @@ bool deserializeConfig(JsonObject doc, bool fromFS) {
   CJSON(receiveDirect, if_live["en"]);  // UDP/Hyperion realtime
   CJSON(useMainSegmentOnly, if_live[F("mso")]);
   CJSON(realtimeRespectLedMaps, if_live[F("rlm")]);
+  CJSON(ddpTimecodeSync, if_live[F("ddptc")]);
   CJSON(e131Port, if_live["port"]); // 5568
   if (e131Port == DDP_DEFAULT_PORT) e131Port = E131_DEFAULT_PORT; // prevent double DDP port allocation
   CJSON(e131Multicast, if_live[F("mc")]);
@@ -602,6 +609,8 @@ bool deserializeConfig(JsonObject doc, bool fromFS) {
   if (DMXSegmentSpacing > 150) DMXSegmentSpacing = 0;
   CJSON(e131Priority, if_live_dmx[F("e131prio")]);
   if (e131Priority > 200) e131Priority = 200;
+  CJSON(e131MergeMode, if_live_dmx[F("merge")]);
+  if (e131MergeMode > E131_MERGE_HTP) e131MergeMode = E131_MERGE_LTP;
   CJSON(DMXMode, if_live_dmx["mode"]);
 
   tdd = if_live[F("timeout")] | -1;
@@ -637,6 +646,10 @@ bool deserializeConfig(JsonObject doc, bool fromFS) {
   getStringFromJson(mqttDeviceTopic, if_mqtt[F("topics")][F("device")], MQTT_MAX_TOPIC_LEN+1); // "wled/test"
   getStringFromJson(mqttGroupTopic, if_mqtt[F("topics")][F("group")], MQTT_MAX_TOPIC_LEN+1); // ""
   CJSON(retainMqttMsg, if_mqtt[F("rtn")]);
+  CJSON(mqttPublishJson, if_mqtt[F("json")]);
+  CJSON(mqttPublishWindow, if_mqtt[F("win")]);
+  JsonArray if_mqtt_rate = if_mqtt[F("rate")];
+  for (unsigned i = 0; i < 4 && i < if_mqtt_rate.size(); i++) CJSON(mqttRateLimit[i], if_mqtt_rate[i]);
 #endif
 
 #ifndef WLED_DISABLE_HUESYNC
@@ -724,6 +737,14 @@ bool deserializeConfig(JsonObject doc, bool fromFS) {
     }
   }
 
+  JsonArray cronArray = tm[F("cron")];
+  if (!cronArray.isNull()) {
+    clearCronTimers();
+    for (JsonObject timer : cronArray) {
+      addCronTimer(timer[F("macro")] | 0, timer[F("expr")] | "", timer[F("en")] | 0);
+    }
+  }
+
   JsonObject ota = doc["ota"];
   const char* pwd = ota["psk"]; //normally not present due to security
 
@@ -753,6 +774,30 @@ bool deserializeConfig(JsonObject doc, bool fromFS) {
     CJSON(DMXFixtureMap[i],dmx_fixmap[i]);
   }
 
+  // additional fixture profiles (1-3) and fixture groups, profile and group 0 are the settings above
+  JsonArray dmx_profiles = dmx[F("profiles")];
+  unsigned p = 1;
+  for (JsonArray prof : dmx_profiles) {
+    if (p >= DMX_MAX_PROFILES) break;
+    DMXProfile& dp = dmxPatch.profile[p++];
+    dp.channels = min((unsigned)prof.size(), (unsigned)DMX_MAX_PROFILE_CHANNELS);
+    for (unsigned j = 0; j < dp.channels; j++) dp.map[j] = prof[j] | 0;
+  }
+  for (; p < DMX_MAX_PROFILES; p++) dmxPatch.profile[p].channels = 0;
+  JsonArray dmx_groups = dmx[F("groups")];
+  dmxPatch.groups = 1;
+  for (JsonObject grp : dmx_groups) {
+    if (dmxPatch.groups >= DMX_MAX_GROUPS) break;
+    DMXFixtureGroup& g = dmxPatch.group[dmxPatch.groups++];
+    g.startLED = grp[F("led")] | 0;
+    g.count    = grp["n"] | 0;
+    g.start    = grp["start"] | 1;
+    g.gap      = grp[F("gap")] | 1;
+    g.profile  = grp[F("prof")] | 0;
+    g.universe = grp[F("uni")] | 0;
+  }
+  dmxPatch.invalidate();
+
   CJSON(e131ProxyUniverse, dmx[F("e131proxy")]);
   #endif
 
@@ -776,6 +821,7 @@ bool backupConfig() {
 }
 
 bool restoreConfig() {
+  invalidateConfigCache();
   return restoreFile(s_cfg_json);
 }
 
@@ -795,11 +841,197 @@ void resetConfig() {
     char backupname[32];
     snprintf_P(backupname, sizeof(backupname), PSTR("/rst.%s"), &s_cfg_json[1]);
     WLED_FS.rename(s_cfg_json, backupname);
+    invalidateConfigCache();
     doReboot = true;
   }
 }
 
-bool deserializeConfigFromFS() {
+static const char s_cfg_bin[] PROGMEM = "/cfg.bin";
+
+// size and CRC-32 of cfg.json the snapshot belongs to, size is 0 if there is no cfg.json
+static size_t configFileKey(uint32_t& crc) {
+  crc = 0;
+  File f = WLED_FS.open(FPSTR(s_cfg_json), "r");
+  if (!f) return 0;
+  size_t size = 0;
+  uint8_t buf[128];
+  for (size_t n; (n = f.read(buf, sizeof(buf))) > 0; size += n) crc = ConfigCache::crc32(buf, n, crc);
+  f.close();
+  return size;
+}
+
+void invalidateConfigCache() {
+  if (WLED_FS.exists(FPSTR(s_cfg_bin))) WLED_FS.remove(FPSTR(s_cfg_bin));
+}
+
+// load binary snapshot (see cfg_cache.h) and apply it, returns true if buses and LED settings were configured from it
+bool loadConfigCache() {
+  File f = WLED_FS.open(FPSTR(s_cfg_bin), "r");
+  if (!f) return false;
+  CfgCacheHeader h;
+  CfgCacheData* c = (CfgCacheData*)d_malloc(sizeof(CfgCacheData));
+  bool ok = c && f.read((uint8_t*)&h, sizeof(h)) == sizeof(h) && f.read((uint8_t*)c, sizeof(CfgCacheData)) == sizeof(CfgCacheData);
+  f.close();
+  uint32_t cfgCrc;
+  const size_t cfgSize = ok ? configFileKey(cfgCrc) : 0;
+  ok = ok && ConfigCache::isValid(h, *c, VERSION, cfgSize, cfgCrc);
+  if (!ok) {
+    DEBUG_PRINTLN(F("Config snapshot invalid."));
+    d_free(c);
+    return false;
+  }
+
+  BusManager::setMilliampsMax(c->ablMilliampsMax);
+  Bus::setGlobalAWMode(c->globalAWMode);
+  strip.correctWB  = c->correctWB;
+  strip.cctFromRgb = c->cctFromRgb;
+  cctICused        = c->cctICused;
+  Bus::setCCTBlend(c->cctBlend);
+  strip.setTargetFps(c->targetFps);
+  #ifndef WLED_DISABLE_2D
+  if (c->isMatrix) {
+    strip.isMatrix = true;
+    strip.panel.clear();
+    strip.panel.reserve(c->panels);
+    for (unsigned i = 0; i < c->panels; i++) {
+      WS2812FX::Panel p;
+      p.xOffset = c->panel[i].xOffset;
+      p.yOffset = c->panel[i].yOffset;
+      p.width   = c->panel[i].width;
+      p.height  = c->panel[i].height;
+      p.options = c->panel[i].options;
+      strip.panel.push_back(p);
+    }
+  }
+  #endif
+  for (unsigned i = 0; i < c->buses; i++) {
+    CfgCacheBus& b = c->bus[i];
+    b.text[CFG_CACHE_TEXT_LEN] = 0;
+    busConfigs.emplace_back(b.type, b.pins, b.start, b.len, b.colorOrder, b.reversed, b.skip, b.autoWhite, b.frequency, b.milliAmpsPerLed, b.milliAmpsMax, b.driverType, String(b.text));
+    doInitBusses = true;  // finalization done in beginStrip()
+  }
+  for (unsigned i = 0; i < c->coms; i++) BusManager::getColorOrderMap().add(c->com[i].start, c->com[i].len, c->com[i].colorOrder);
+
+  rlyOpenDrain = c->rlyOpenDrain;
+  rlyMde = c->rlyMde;
+  PinManager::deallocatePin(rlyPin, PinOwner::Relay);
+  if (c->rlyPin >= 0 && PinManager::allocatePin(c->rlyPin, true, PinOwner::Relay)) {
+    rlyPin = c->rlyPin;
+    pinMode(rlyPin, rlyOpenDrain ? OUTPUT_OPEN_DRAIN : OUTPUT);
+  } else {
+    rlyPin = -1;
+  }
+
+  briMultiplier   = c->briMultiplier;
+  paletteBlend    = c->paletteBlend;
+  strip.autoSegments = c->autoSegments;
+  gammaCorrectVal = c->gammaCorrectVal;
+  gammaCorrectBri = c->gammaCorrectBri;
+  gammaCorrectCol = c->gammaCorrectCol;
+  NeoGammaWLEDMethod::calcGammaTable(gammaCorrectVal);
+  transitionDelay = transitionDelayDefault = c->transitionDelayDefault;
+  bootPreset      = c->bootPreset;
+  turnOnAtBoot    = c->turnOnAtBoot;
+  briS            = c->briS;
+  d_free(c);
+  DEBUG_PRINTLN(F("LEDs configured from snapshot."));
+  return true;
+}
+
+// write binary snapshot of the current (applied) configuration, only valid while buses match the saved cfg.json
+void saveConfigCache() {
+  invalidateConfigCache();
+  if (doInitBusses || BusManager::getNumBusses() > CFG_CACHE_MAX_BUSSES) return; // buses not (yet) initialised from cfg.json
+  #ifdef WLED_USE_ETHERNET
+  if (ethernetType != WLED_ETH_NONE) return; // ethernet pins must be allocated before LED pins
+  #endif
+  #ifndef WLED_DISABLE_2D
+  if (strip.isMatrix && strip.panel.size() > CFG_CACHE_MAX_PANELS) return;
+  #endif
+  if (BusManager::getColorOrderMap().count() > CFG_CACHE_MAX_COM) return;
+  uint32_t cfgCrc;
+  const size_t cfgSize = configFileKey(cfgCrc);
+  if (!cfgSize) return;
+
+  CfgCacheData* c = (CfgCacheData*)d_malloc(sizeof(CfgCacheData));
+  if (!c) return;
+  memset(c, 0, sizeof(CfgCacheData)); // also padding, it is part of the CRC
+  c->ablMilliampsMax = BusManager::ablMilliampsMax();
+  c->globalAWMode    = Bus::getGlobalAWMode();
+  c->correctWB       = strip.correctWB;
+  c->cctFromRgb      = strip.cctFromRgb;
+  c->cctICused       = cctICused;
+  c->cctBlend        = Bus::getCCTBlend();
+  c->targetFps       = strip.getTargetFps();
+  #ifndef WLED_DISABLE_2D
+  c->isMatrix        = strip.isMatrix;
+  if (strip.isMatrix) {
+    for (const auto& p : strip.panel) {
+      CfgCachePanel& cp = c->panel[c->panels++];
+      cp.xOffset = p.xOffset;
+      cp.yOffset = p.yOffset;
+      cp.width   = p.width;
+      cp.height  = p.height;
+      cp.options = p.options;
+    }
+  }
+  #endif
+  bool ok = true;
+  for (size_t s = 0; s < BusManager::getNumBusses(); s++) {
+    const Bus *bus = BusManager::getBus(s);
+    if (!bus) break;
+    CfgCacheBus& b = c->bus[c->buses++];
+    memset(b.pins, 255, sizeof(b.pins));
+    bus->getPins(b.pins);
+    b.start           = bus->getStart();
+    b.len             = bus->getLength();
+    b.type            = (bus->getType() & 0x7F) | (bus->isOffRefreshRequired() << 7);
+    b.colorOrder      = bus->getColorOrder();
+    b.reversed        = bus->isReversed();
+    b.skip            = bus->skippedLeds();
+    b.autoWhite       = bus->getAutoWhiteMode();
+    b.frequency       = bus->getFrequency();
+    b.milliAmpsPerLed = bus->getLEDCurrent();
+    b.milliAmpsMax    = bus->getMaxCurrent();
+    b.driverType      = bus->getDriverType();
+    const String text = bus->getCustomText();
+    if (text.length() > CFG_CACHE_TEXT_LEN) ok = false;
+    strlcpy(b.text, text.c_str(), sizeof(b.text));
+  }
+  const ColorOrderMap& com = BusManager::getColorOrderMap();
+  for (size_t s = 0; s < com.count(); s++) {
+    const ColorOrderMapEntry *entry = com.get(s);
+    if (!entry || !entry->len) break;
+    c->com[c->coms++] = {entry->start, entry->len, entry->colorOrder};
+  }
+  c->rlyPin          = rlyPin;
+  c->rlyMde          = rlyMde;
+  c->rlyOpenDrain    = rlyOpenDrain;
+  c->briMultiplier   = briMultiplier;
+  c->paletteBlend    = paletteBlend;
+  c->autoSegments    = strip.autoSegments;
+  c->gammaCorrectBri = gammaCorrectBri;
+  c->gammaCorrectCol = gammaCorrectCol;
+  c->gammaCorrectVal = gammaCorrectVal;
+  c->transitionDelayDefault = transitionDelayDefault;
+  c->bootPreset      = bootPreset;
+  c->turnOnAtBoot    = turnOnAtBoot;
+  c->briS            = briS;
+
+  if (ok) {
+    CfgCacheHeader h;
+    ConfigCache::seal(h, *c, VERSION, cfgSize, cfgCrc);
+    File f = WLED_FS.open(FPSTR(s_cfg_bin), "w");
+    if (f) {
+      ok = f.write((const uint8_t*)&h, sizeof(h)) == sizeof(h) && f.write((const uint8_t*)c, sizeof(CfgCacheData)) == sizeof(CfgCacheData);
+      f.close();
+      if (!ok) invalidateConfigCache();
+    }
+  }
+  d_free(c);
+}
+
+bool deserializeConfigFromFS(bool ledsCached) {
   [[maybe_unused]] bool success = deserializeConfigSec();
 
   if (!requestJSONBufferLock(JSON_LOCK_CFG_DES)) return false;
@@ -811,7 +1043,7 @@ bool deserializeConfigFromFS() {
   // NOTE: This routine deserializes *and* applies the configuration
   //       Therefore, must also initialize ethernet from this function
   JsonObject root = pDoc->as<JsonObject>();
-  bool needsSave = deserializeConfig(root, true);
+  bool needsSave = deserializeConfig(root, true, ledsCached);
   releaseJSONBufferLock();
 
   return needsSave;
@@ -835,6 +1067,7 @@ void serializeConfigToFS() {
   releaseJSONBufferLock();
 
   configNeedsWrite = false;
+  saveConfigCache();
 }
 
 void serializeConfig(JsonObject root) {
@@ -1106,6 +1339,7 @@ void serializeConfig(JsonObject root) {
   if_sync_recv["grp"] = receiveGroups;
   if_sync_recv["seg"] = receiveSegmentOptions;
   if_sync_recv["sb"]  = receiveSegmentBounds;
+  if_sync_recv[F("clk")] = clockSyncEnabled;
 
   JsonObject if_sync_send = if_sync.createNestedObject(F("send"));
   if_sync_send["en"] = sendNotifications;
@@ -1124,6 +1358,7 @@ void serializeConfig(JsonObject root) {
   if_live["en"] = receiveDirect; // UDP/Hyperion realtime
   if_live[F("mso")] = useMainSegmentOnly;
   if_live[F("rlm")] = realtimeRespectLedMaps;
+  if_live[F("ddptc")] = ddpTimecodeSync;
   if_live["port"] = e131Port;
   if_live[F("mc")] = e131Multicast;
 
@@ -1131,6 +1366,7 @@ void serializeConfig(JsonObject root) {
   if_live_dmx[F("uni")] = e131Universe;
   if_live_dmx[F("seqskip")] = e131SkipOutOfSequence;
   if_live_dmx[F("e131prio")] = e131Priority;
+  if_live_dmx[F("merge")] = e131MergeMode;
   if_live_dmx[F("addr")] = DMXAddress;
   if_live_dmx[F("dss")] = DMXSegmentSpacing;
   if_live_dmx["mode"] = DMXMode;
@@ -1166,6 +1402,10 @@ void serializeConfig(JsonObject root) {
   if_mqtt[F("pskl")] = strlen(mqttPass);
   if_mqtt[F("cid")] = mqttClientID;
   if_mqtt[F("rtn")] = retainMqttMsg;
+  if_mqtt[F("json")] = mqttPublishJson;
+  if_mqtt[F("win")] = mqttPublishWindow;
+  JsonArray if_mqtt_rate = if_mqtt.createNestedArray(F("rate"));
+  for (unsigned i = 0; i < 4; i++) if_mqtt_rate.add(mqttRateLimit[i]);
 
   JsonObject if_mqtt_topics = if_mqtt.createNestedObject(F("topics"));
   if_mqtt_topics[F("device")] = mqttDeviceTopic;
@@ -1235,6 +1475,16 @@ void serializeConfig(JsonObject root) {
     end[F("day")] = t.dayEnd;
   }
 
+  JsonArray timers_cron = timers.createNestedArray(F("cron"));
+  for (const CronTimer& t : cronTimers) {
+    char expr[CRON_MAX_LEN];
+    cronPrint(t.time, expr, sizeof(expr));
+    JsonObject ti = timers_cron.createNestedObject();
+    ti[F("en")] = t.enabled ? 1 : 0;
+    ti[F("macro")] = t.preset;
+    ti[F("expr")] = expr; // copied (char*)
+  }
+
   JsonObject ota = root.createNestedObject("ota");
   ota[F("lock")] = otaLock;
   ota[F("lock-wifi")] = wifiLock;
@@ -1256,6 +1506,25 @@ void serializeConfig(JsonObject root) {
     dmx_fixmap.add(DMXFixtureMap[i]);
   }
 
+  JsonArray dmx_profiles = dmx.createNestedArray(F("profiles"));
+  for (unsigned p = 1; p < DMX_MAX_PROFILES; p++) {
+    const DMXProfile& dp = dmxPatch.profile[p];
+    if (dp.channels == 0) break;
+    JsonArray prof = dmx_profiles.createNestedArray();
+    for (unsigned j = 0; j < dp.channels; j++) prof.add(dp.map[j]);
+  }
+  JsonArray dmx_groups = dmx.createNestedArray(F("groups"));
+  for (unsigned i = 1; i < dmxPatch.groups; i++) {
+    const DMXFixtureGroup& g = dmxPatch.group[i];
+    JsonObject grp = dmx_groups.createNestedObject();
+    grp[F("led")]  = g.startLED;
+    grp["n"]       = g.count;
+    grp["start"]   = g.start;
+    grp[F("gap")]  = g.gap;
+    grp[F("prof")] = g.profile;
+    grp[F("uni")]  = g.universe;
+  }
+
   dmx[F("e131proxy")] = e131ProxyUniverse;
   #endif
 
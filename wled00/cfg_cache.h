@@ -0,0 +1,138 @@
+/* cfg_cache.h
+
+Binary snapshot of the configuration needed to light the LEDs at boot (buses, LED settings, relay, boot state).
+
+Parsing /cfg.json takes a large part of the boot time. The snapshot is a fixed layout copy of the settings that are
+used before the first frame, written next to cfg.json (/cfg.bin) whenever cfg.json was parsed or written and the
+buses were initialised from it. At boot it is loaded first, so the strip is set up and the first frame is shown
+before cfg.json is parsed, and those settings are not read from JSON again.
+
+It is only used if
+- magic, layout version and size match and the CRC-32 of the data is correct
+- it was written by the same firmware build (settings may be migrated by a new version)
+- cfg.json has the size and CRC-32 recorded in the snapshot (replaced or edited otherwise, the snapshot is also deleted
+  on upload/restore; a file of the same size with other content, e.g. copied back with another tool, is detected too)
+otherwise cfg.json is parsed as usual and a new snapshot is written.
+No snapshot is written if ethernet is configured, as its pins are allocated before the LEDs.
+
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+
+#define CFG_CACHE_MAGIC       0x47464357UL  // "WCFG"
+#define CFG_CACHE_LAYOUT      2             // increase when the layout of CfgCacheData changes
+#define CFG_CACHE_MAX_BUSSES  36            // physical and virtual
+#define CFG_CACHE_MAX_PANELS  32
+#define CFG_CACHE_MAX_COM     10            // color order mappings
+#define CFG_CACHE_TEXT_LEN    32            // custom bus text
+
+struct CfgCacheBus {
+  uint16_t start;
+  uint16_t len;
+  uint16_t frequency;
+  uint16_t milliAmpsMax;
+  uint8_t  type;          // bit 7: refresh in off state required
+  uint8_t  pins[5];
+  uint8_t  colorOrder;
+  uint8_t  skip;
+  uint8_t  autoWhite;
+  uint8_t  milliAmpsPerLed;
+  uint8_t  driverType;
+  uint8_t  reversed;
+  char     text[CFG_CACHE_TEXT_LEN + 1];
+};
+
+struct CfgCachePanel {
+  uint16_t xOffset;
+  uint16_t yOffset;
+  uint8_t  width;
+  uint8_t  height;
+  uint8_t  options;
+};
+
+struct CfgCacheCom {
+  uint16_t start;
+  uint16_t len;
+  uint8_t  colorOrder;
+};
+
+struct CfgCacheData {
+  // hw.led
+  uint16_t ablMilliampsMax;
+  uint16_t targetFps;
+  uint8_t  globalAWMode;
+  uint8_t  cctBlend;
+  bool     correctWB;
+  bool     cctFromRgb;
+  bool     cctICused;
+  bool     isMatrix;
+  uint8_t  buses;
+  uint8_t  panels;
+  uint8_t  coms;
+  // hw.relay
+  int8_t   rlyPin;
+  bool     rlyMde;
+  bool     rlyOpenDrain;
+  // light, def
+  uint8_t  briMultiplier;
+  uint8_t  paletteBlend;
+  bool     autoSegments;
+  bool     gammaCorrectBri;
+  bool     gammaCorrectCol;
+  float    gammaCorrectVal;
+  uint16_t transitionDelayDefault;
+  uint8_t  bootPreset;
+  bool     turnOnAtBoot;
+  uint8_t  briS;
+  CfgCacheBus   bus[CFG_CACHE_MAX_BUSSES];
+  CfgCachePanel panel[CFG_CACHE_MAX_PANELS];
+  CfgCacheCom   com[CFG_CACHE_MAX_COM];
+};
+
+struct CfgCacheHeader {
+  uint32_t magic;
+  uint16_t layout;
+  uint16_t size;        // sizeof(CfgCacheData)
+  uint32_t build;       // firmware VERSION
+  uint32_t cfgSize;     // size of cfg.json the snapshot belongs to
+  uint32_t cfgCrc;      // CRC-32 of that cfg.json
+  uint32_t crc;         // CRC-32 of data
+};
+
+class ConfigCache {
+  public:
+    // chainable: crc32(b, n, crc32(a, m)) is the CRC of a followed by b, nibble table as cfg.json is hashed at every boot
+    static uint32_t crc32(const uint8_t* data, size_t len, uint32_t crc = 0) {
+      static const uint32_t table[16] = {
+        0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+        0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C, 0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C
+      };
+      crc = ~crc;
+      for (size_t i = 0; i < len; i++) {
+        crc ^= data[i];
+        crc = (crc >> 4) ^ table[crc & 0x0F];
+        crc = (crc >> 4) ^ table[crc & 0x0F];
+      }
+      return ~crc;
+    }
+
+    static void seal(CfgCacheHeader& h, const CfgCacheData& d, uint32_t build, uint32_t cfgSize, uint32_t cfgCrc) {
+      h.magic   = CFG_CACHE_MAGIC;
+      h.layout  = CFG_CACHE_LAYOUT;
+      h.size    = sizeof(CfgCacheData);
+      h.build   = build;
+      h.cfgSize = cfgSize;
+      h.cfgCrc  = cfgCrc;
+      h.crc     = crc32((const uint8_t*)&d, sizeof(d));
+    }
+
+    static bool isValid(const CfgCacheHeader& h, const CfgCacheData& d, uint32_t build, uint32_t cfgSize, uint32_t cfgCrc) {
+      return h.magic == CFG_CACHE_MAGIC && h.layout == CFG_CACHE_LAYOUT && h.size == sizeof(CfgCacheData)
+          && h.build == build && h.cfgSize == cfgSize && h.cfgCrc == cfgCrc
+          && d.buses <= CFG_CACHE_MAX_BUSSES && d.panels <= CFG_CACHE_MAX_PANELS && d.coms <= CFG_CACHE_MAX_COM
+          && h.crc == crc32((const uint8_t*)&d, sizeof(d));
+    }
+};
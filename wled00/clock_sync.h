@@ -0,0 +1,124 @@
+/* clock_sync.h
+
+Clock offset and drift estimation between a WLED node and the sync leader (the node whose notifications it follows).
+
+The follower periodically sends a request with its local time t1, the leader answers with its receive time t2 and
+transmit time t3, the answer arrives at local time t4 (all in microseconds of the respective local clocks):
+  offset = ((t2 - t1) + (t3 - t4)) / 2     leader clock - local clock
+  delay  = (t4 - t1) - (t3 - t2)           round trip network delay
+Of the last CLOCKSYNC_FILTER samples the one with the lowest delay is used (least queuing, least asymmetry), like
+the NTP clock filter. A least squares line through the last CLOCKSYNC_HISTORY filtered samples gives the smoothed
+offset and the skew (frequency difference), so the offset can be extrapolated between samples and during packet loss.
+
+*/
+
+#pragma once
+
+#include <stdint.h>
+
+#define CLOCKSYNC_FILTER      8          // samples considered by the minimum delay filter
+#define CLOCKSYNC_HISTORY     16         // filtered samples used for offset and skew estimation
+#define CLOCKSYNC_STEP        100000     // us, offset errors above this restart estimation
+#define CLOCKSYNC_MAX_SKEW    500e-6f    // maximum frequency difference (500 ppm)
+#define CLOCKSYNC_TIMEOUT     30000000   // us without valid sample until sync is considered lost
+
+class ClockSync {
+  public:
+    struct Stats {
+      uint32_t samples;   // responses received
+      uint32_t used;      // samples used to update the clock
+      uint32_t steps;     // estimation restarts because of large offset errors
+    } stats = {};
+
+    // add a measurement, all values in us
+    void addSample(uint64_t t1, uint64_t t2, uint64_t t3, uint64_t t4) {
+      stats.samples++;
+      const int64_t delay = int64_t(t4 - t1) - int64_t(t3 - t2);
+      if (delay < 0 || t4 < t1) return; // invalid
+      Sample& s = _filter[_next];
+      s.offset = (int64_t(t2 - t1) + int64_t(t3 - t4)) / 2;
+      s.delay = delay;
+      s.time = t4;
+      _next = (_next + 1) % CLOCKSYNC_FILTER;
+      if (_count < CLOCKSYNC_FILTER) _count++;
+
+      // lowest delay sample, only used if it is newer than the last one used
+      const Sample* best = &_filter[0];
+      for (unsigned i = 1; i < _count; i++) if (_filter[i].delay < best->delay) best = &_filter[i];
+      if (_valid && best->time <= _time) return;
+      update(best->offset, best->time);
+      _delay = best->delay;
+      _lastUpdate = t4;
+    }
+
+    // estimated leader clock - local clock at local time now (us)
+    int64_t getOffset(uint64_t now) const {
+      return _offset + int64_t(_skew * float(int64_t(now - _time)));
+    }
+
+    inline bool     isSynced(uint64_t now) const { return _valid && now - _lastUpdate < CLOCKSYNC_TIMEOUT; }
+    inline float    getSkew() const  { return _skew; }   // leader clock rate - local clock rate (1e-6 = 1 ppm)
+    inline uint32_t getDelay() const { return _delay; }  // round trip delay of last used sample (us)
+
+    void reset() {
+      _valid = false;
+      _count = _next = _hcount = _hnext = 0;
+      _skew = 0.0f;
+    }
+
+  private:
+    struct Sample {
+      int64_t  offset;
+      int64_t  delay;
+      uint64_t time;
+    };
+    Sample   _filter[CLOCKSYNC_FILTER];
+    unsigned _count = 0, _next = 0;
+    Sample   _history[CLOCKSYNC_HISTORY]; // filtered samples (delay unused)
+    unsigned _hcount = 0, _hnext = 0;
+    bool     _valid = false;
+    int64_t  _offset = 0;      // offset at _time
+    uint64_t _time = 0;        // local time of last update
+    uint64_t _lastUpdate = 0;
+    float    _skew = 0.0f;
+    uint32_t _delay = 0;
+
+    void update(int64_t offset, uint64_t time) {
+      stats.used++;
+      if (_valid) {
+        const int64_t error = offset - getOffset(time);
+        if (error > CLOCKSYNC_STEP || error < -CLOCKSYNC_STEP) {
+          // clock jumped (e.g. leader rebooted): restart from this sample, older ones belong to the previous clock
+          _hcount = _hnext = 0;
+          _count = _next = 0;
+          _skew = 0.0f;
+          stats.steps++;
+        }
+      }
+      _history[_hnext] = {offset, 0, time};
+      _hnext = (_hnext + 1) % CLOCKSYNC_HISTORY;
+      if (_hcount < CLOCKSYNC_HISTORY) _hcount++;
+      _valid = true;
+      _time = time;
+      _offset = offset;
+      if (_hcount < 4) return;
+
+      // least squares fit relative to the newest sample (x in s, y in us)
+      float sx = 0, sy = 0, sxx = 0, sxy = 0;
+      for (unsigned i = 0; i < _hcount; i++) {
+        const float x = float(int64_t(_history[i].time - time)) * 1e-6f;
+        const float y = float(_history[i].offset - offset);
+        sx += x; sy += y; sxx += x*x; sxy += x*y;
+      }
+      const float n = _hcount;
+      const float d = n * sxx - sx * sx;
+      if (d < 1.0f) return; // samples too close in time
+      float skew = (n * sxy - sx * sy) / d;  // us/s
+      const float a = (sy - skew * sx) / n;  // fitted offset at time
+      skew *= 1e-6f;
+      if (skew >  CLOCKSYNC_MAX_SKEW) skew =  CLOCKSYNC_MAX_SKEW;
+      if (skew < -CLOCKSYNC_MAX_SKEW) skew = -CLOCKSYNC_MAX_SKEW;
+      _skew = skew;
+      _offset = offset + int64_t(a);
+    }
+};
@@ -0,0 +1,74 @@
+/* color16.h
+
+Wide color (4x16 bit per pixel) kernels of the optional wide color frame buffer (build flag WLED_ENABLE_WIDE_COLOR,
+only allocated if a 16 bit bus is configured, see WS2812FX::finalizeInit()).
+
+Wide colors are packed into a uint64_t in the channel order of RGBW32 (W, R, G, B from the most significant word).
+8 bit colors are widened by v*257 so black and full white stay exact and narrowing a widened color returns the
+original. Blend and fade take 16 bit amounts so segment opacity and transitions keep the fraction that the 8 bit
+kernels (color_blend(), color_fade()) drop. Gamma of wide colors is interpolated from the 16 bit bus table
+(BusColorLUT16::wide()).
+
+Buses with 8 bit output get the fraction by temporal dithering: over 16 frames a pixel is rounded up as often as its
+fraction requires, so the average light output keeps 12 bit precision. The threshold sequence is bit reversed (the
+rounding is spread evenly over the frames) and offset per pixel so neighbouring pixels do not flicker in step.
+
+*/
+
+#pragma once
+
+#include <stdint.h>
+
+// 64bit color mangling macros
+#define RGBW64(r,g,b,w) ((uint64_t(uint16_t(w)) << 48) | (uint64_t(uint16_t(r)) << 32) | (uint64_t(uint16_t(g)) << 16) | uint64_t(uint16_t(b)))
+#define R16(c) (uint16_t((c) >> 32))
+#define G16(c) (uint16_t((c) >> 16))
+#define B16(c) (uint16_t(c))
+#define W16(c) (uint16_t((c) >> 48))
+
+// 8 bit channels to 16 bit (0 -> 0, 255 -> 65535)
+inline uint64_t color_widen(uint32_t c) {
+  return RGBW64(((c >> 16) & 0xFF) * 257U, ((c >> 8) & 0xFF) * 257U, (c & 0xFF) * 257U, (c >> 24) * 257U);
+}
+
+// 16 bit channel to 8 bit with rounding (inverse of v*257)
+inline uint8_t narrow8(uint16_t v) { return (uint32_t(v) * 255U + 32767U) / 65535U; }
+
+inline uint32_t color_narrow(uint64_t c) {
+  return (uint32_t(narrow8(W16(c))) << 24) | (uint32_t(narrow8(R16(c))) << 16) | (uint32_t(narrow8(G16(c))) << 8) | narrow8(B16(c));
+}
+
+// blend of a single channel, blend: 0 = a, 65535 = b (fits 32 bit: 65535 * 65535 + 32767)
+inline uint16_t blend16(uint16_t a, uint16_t b, uint16_t blend) {
+  return (uint32_t(a) * (65535U - blend) + uint32_t(b) * blend + 32767U) / 65535U;
+}
+
+inline uint64_t color_blend64(uint64_t a, uint64_t b, uint16_t blend) {
+  if (blend == 0)     return a;
+  if (blend == 65535) return b;
+  return RGBW64(blend16(R16(a), R16(b), blend), blend16(G16(a), G16(b), blend), blend16(B16(a), B16(b), blend), blend16(W16(a), W16(b), blend));
+}
+
+// fade of a single channel, video: channels that are lit stay lit (same arithmetic as BusDigital::setPixelColor16())
+inline uint16_t fade16(uint16_t v, uint16_t amount, bool video = false) {
+  if (amount == 65535 || v == 0) return v;
+  const uint16_t f = (uint32_t(v) * amount + 0x8000U) >> 16;
+  return (video && amount && !f) ? 1 : f;
+}
+
+inline uint64_t color_fade64(uint64_t c, uint16_t amount, bool video = false) {
+  if (amount == 65535) return c;
+  return RGBW64(fade16(R16(c), amount, video), fade16(G16(c), amount, video), fade16(B16(c), amount, video), fade16(W16(c), amount, video));
+}
+
+// threshold of temporal dithering for frame and pixel (16 frame cycle, 4 bit reversed, centered in its step)
+inline uint8_t ditherThreshold(uint8_t frame, unsigned pix) {
+  const unsigned i = (frame + pix * 7U) & 0x0F;
+  const unsigned r = ((i & 1) << 3) | ((i & 2) << 1) | ((i & 4) >> 1) | ((i & 8) >> 3);
+  return (r << 4) | 0x08;
+}
+
+// 16 bit channel to 8 bit, rounded up for thresholds below the fraction (0 -> 0, 65535 -> 255 for every threshold)
+inline uint8_t dither8(uint16_t v, uint8_t threshold) {
+  return (uint32_t(v) - (v >> 8) + threshold) >> 8;
+}
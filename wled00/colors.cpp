@@ -263,6 +263,7 @@ void loadCustomPalettes() {
   byte tcp[72]; //support gradient palettes with up to 18 entries
   CRGBPalette16 targetPalette;
   customPalettes.clear(); // start fresh
+  invalidateJsonCache();  // palette previews (/json/palx) change
   StaticJsonDocument<1536> pDoc; // barely enough to fit 72 numbers -> TODO: current format uses 214 bytes max per palette, why is this buffer so large?
   unsigned emptyPaletteGap = 0; // count gaps in palette files to stop looking for more (each exists() call takes ~5ms)
   for (int index = 0; index < WLED_MAX_CUSTOM_PALETTES; index++) {
@@ -638,6 +639,7 @@ uint16_t approximateKelvinFromRGB(uint32_t rgb) {
 // gamma lookup tables used for color correction (filled on 1st use (cfg.cpp & set.cpp))
 uint8_t NeoGammaWLEDMethod::gammaT[256];
 uint8_t NeoGammaWLEDMethod::gammaT_inv[256];
+uint8_t NeoGammaWLEDMethod::_version = 0;
 
 // re-calculates & fills gamma tables
 void NeoGammaWLEDMethod::calcGammaTable(float gamma)
@@ -650,6 +652,7 @@ void NeoGammaWLEDMethod::calcGammaTable(float gamma)
   }
   gammaT[0] = 0;
   gammaT_inv[0] = 0;
+  _version++;
 }
 
 uint8_t NeoGammaWLEDMethod::Correct(uint8_t value)
@@ -36,7 +36,9 @@ class NeoGammaWLEDMethod {
     [[gnu::hot]] static uint8_t Correct(uint8_t value);             // apply Gamma to single channel
     [[gnu::hot]] static uint32_t inverseGamma32(uint32_t color);    // apply inverse Gamma to RGBW32 color
     static void calcGammaTable(float gamma);                        // re-calculates & fills gamma tables
+    static inline uint8_t tableVersion() { return _version; }            // changes whenever gamma tables are re-calculated (for derived look-up tables)
     static inline uint8_t rawGamma8(uint8_t val) { return gammaT[val]; }  // get value from Gamma table (WLED specific, not used by NPB)
+    static inline const uint8_t* rawGammaTable() { return gammaT; }       // entire Gamma table (for derived look-up tables)
     static inline uint8_t rawInverseGamma8(uint8_t val) { return gammaT_inv[val]; }  // get value from inverse Gamma table (WLED specific, not used by NPB)
     static inline uint32_t Correct32(uint32_t color) { // apply Gamma to RGBW32 color (WLED specific, not used by NPB)
       if (!gammaCorrectCol) return color; // no gamma correction
@@ -47,6 +49,7 @@ class NeoGammaWLEDMethod {
   private:
     static uint8_t gammaT[];
     static uint8_t gammaT_inv[];
+    static uint8_t _version;
 };
 #define gamma32(c) NeoGammaWLEDMethod::Correct32(c)
 #define gamma8(c)  NeoGammaWLEDMethod::rawGamma8(c)
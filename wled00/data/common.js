@@ -223,6 +223,37 @@ function sendDDP(ws, start, len, colors) {
 	return true;
 }
 
+// decode binary live view version 3 (see live_stream.h), st keeps the last frame between calls
+// on success st.w, st.h and st.px (Uint8Array with RGB values, 3*w*h bytes) hold the frame
+function decodeLv(st, buf) {
+	let m = new Uint8Array(buf);
+	if (m.length < 9 || m[0] != 76 || m[1] != 3) return false; // 'L', version 3
+	let key = m[2] & 1, fmt = (m[2] >> 1) & 3, bpp = 3 - fmt;
+	let w = (m[4] << 8) | m[5], h = (m[6] << 8) | m[7], n = w * h;
+	if (key || !st.q || st.q.length != n) {
+		if (!key) return false; // no base for a delta frame, wait for the next key frame
+		st.q = new Uint32Array(n);
+		st.px = new Uint8Array(n * 3);
+	} else if (m[3] != ((st.seq + 1) & 255)) return false;
+	st.seq = m[3];
+	let rd = (p) => { let v = 0; for (let k = 0; k < bpp; k++) v = (v << 8) | m[p + k]; return v; };
+	let q = st.q, i = 0, p = 9;
+	while (p < m.length && i < n) {
+		let c = m[p++];
+		if (c < 128) for (let k = 0; k <= c && i < n; k++, p += bpp) q[i] = key ? rd(p) : q[i] ^ rd(p), i++;
+		else { let v = rd(p); p += bpp; for (let k = 0; k < c - 126 && i < n; k++) q[i] = key ? v : q[i] ^ v, i++; }
+	}
+	let px = st.px;
+	for (i = 0; i < n; i++) {
+		let v = q[i], o = i * 3;
+		if (fmt == 0) { px[o] = v >> 16; px[o+1] = (v >> 8) & 255; px[o+2] = v & 255; }
+		else if (fmt == 1) { px[o] = (v >> 8) & 0xF8; px[o+1] = (v >> 3) & 0xFC; px[o+2] = (v << 3) & 0xF8; }
+		else { px[o] = v & 0xE0; px[o+1] = (v << 3) & 0xE0; px[o+2] = (v << 6) & 0xC0; }
+	}
+	st.w = w; st.h = h;
+	return true;
+}
+
 // Pin utilities
 function getOwnerName(o,t,n) {
 	// Use firmware-provided name if available
@@ -0,0 +1,200 @@
+/* ddp_frames.h
+
+Receive jitter buffer for DDP.
+
+Complete DDP frames (all packets up to PUSH) are buffered and presented at the time given by the sender's
+time code, so several nodes driven by the same source show a frame at the same moment regardless of when
+it arrived over Wi-Fi. The time code is mapped to millis() by the caller (common clock via NTP or WLED sync),
+or by schedule() which follows the sender's clock relative to packet arrival with a fixed playout delay.
+
+Policies:
+- frames due more than DDP_LATE_TOLERANCE ms in the past are dropped (late)
+- frames with the time code of a queued or the last presented frame are dropped (duplicates),
+  frames older than the last presented one are dropped as late
+- frames are presented no later than DDP_MAX_LATENCY ms after they were received
+- if the buffer is full the oldest queued frame is dropped, if several frames are due only the newest is shown
+
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+
+#ifndef DDP_JITTER_FRAMES
+  #define DDP_JITTER_FRAMES 4   // frames waiting for presentation (one more is being received)
+#endif
+#ifndef DDP_JITTER_DELAY
+  #define DDP_JITTER_DELAY 50   // ms playout delay if there is no common clock with the sender
+#endif
+#ifndef DDP_MAX_LATENCY
+  #define DDP_MAX_LATENCY 500   // ms maximum time a frame is held
+#endif
+#define DDP_LATE_TOLERANCE 10   // ms a frame may be overdue and still be presented
+
+// called to present a frame: pixels[start..stop) were received, pixels[i] is the color of LED i
+typedef void (*ddp_frame_callback_function)(const uint32_t* pixels, unsigned start, unsigned stop);
+
+class DDPFrameBuffer {
+  public:
+    struct Stats {
+      uint32_t presented;   // frames presented
+      uint32_t late;        // frames dropped because they arrived after their presentation time
+      uint32_t dropped;     // frames dropped because newer frames were due or the buffer was full
+      uint32_t duplicates;  // frames dropped because their time code was already seen
+      uint32_t clamped;     // frames presented earlier than requested to bound latency
+    } stats = {};
+
+    DDPFrameBuffer(ddp_frame_callback_function callback) : _callback(callback) {}
+    ~DDPFrameBuffer() { end(); }
+    DDPFrameBuffer(const DDPFrameBuffer&) = delete;
+    DDPFrameBuffer& operator=(const DDPFrameBuffer&) = delete;
+
+    // (re)allocate buffer for the given number of LEDs, returns false if not possible
+    bool begin(unsigned leds) {
+      if (_pixels && leds == _leds) return true;
+      end();
+      if (leds == 0) return false;
+      _pixels = (uint32_t*)p_malloc((DDP_JITTER_FRAMES + 1) * leds * sizeof(uint32_t));
+      if (!_pixels) return false;
+      _leds = leds;
+      for (unsigned i = 0; i <= DDP_JITTER_FRAMES; i++) _frame[i].queued = false;
+      _rx = 0;
+      clear(_rx);
+      _queued = 0;
+      _clockValid = _presentedValid = false;
+      return true;
+    }
+
+    void end() {
+      if (_pixels) p_free(_pixels);
+      _pixels = nullptr;
+      _leds = 0;
+      _queued = 0;
+    }
+
+    // store the colors of a DDP packet in the frame being received
+    void write(unsigned start, const uint8_t* data, unsigned count, unsigned channelsPerLed) {
+      if (!_pixels || start >= _leds) return;
+      if (count > _leds - start) count = _leds - start;
+      Frame& f = _frame[_rx];
+      uint32_t* px = pixels(_rx) + start;
+      for (unsigned i = 0; i < count; i++, data += channelsPerLed) {
+        px[i] = RGBW32(data[0], data[1], data[2], channelsPerLed > 3 ? data[3] : 0);
+      }
+      if (start < f.start) f.start = start;
+      if (start + count > f.stop) f.stop = start + count;
+    }
+
+    // frame complete (PUSH), due is the millis() value at which it is to be presented
+    void push(uint32_t timecode, unsigned long due, unsigned long now) {
+      if (!_pixels) return;
+      Frame& f = _frame[_rx];
+      if (f.start >= f.stop) return; // no data
+      f.timecode = timecode;
+      if (_presentedValid && int32_t(_presentedTimecode - timecode) > 65536) _presentedValid = false; // time code jumped back more than 1s: sender restarted
+
+      bool duplicate = _presentedValid && timecode == _presentedTimecode;
+      for (unsigned i = 0; i < _queued; i++) duplicate |= _frame[_queue[i]].timecode == timecode;
+      if (duplicate) {
+        stats.duplicates++;
+        clear(_rx);
+        return;
+      }
+      if (int32_t(due - now) < -DDP_LATE_TOLERANCE || (_presentedValid && int32_t(timecode - _presentedTimecode) < 0)) {
+        stats.late++;
+        clear(_rx);
+        return;
+      }
+      if (int32_t(due - now) > DDP_MAX_LATENCY) {
+        due = now + DDP_MAX_LATENCY;
+        stats.clamped++;
+      }
+      f.due = due;
+
+      if (_queued == DDP_JITTER_FRAMES) {
+        // buffer full: drop the oldest frame
+        _frame[_queue[0]].queued = false;
+        memmove(_queue, _queue + 1, --_queued * sizeof(_queue[0]));
+        stats.dropped++;
+      }
+      // insert sorted by presentation time
+      unsigned pos = _queued;
+      while (pos > 0 && int32_t(_frame[_queue[pos-1]].due - due) > 0) {
+        _queue[pos] = _queue[pos-1];
+        pos--;
+      }
+      _queue[pos] = _rx;
+      _queued++;
+      f.queued = true;
+
+      // continue receiving into a free frame
+      for (unsigned i = 0; i <= DDP_JITTER_FRAMES; i++) if (!_frame[i].queued) { _rx = i; break; }
+      clear(_rx);
+    }
+
+    // present the newest frame that is due
+    void handle(unsigned long now) {
+      unsigned due = 0;
+      while (due < _queued && int32_t(now - _frame[_queue[due]].due) >= 0) due++;
+      if (!due) return;
+      stats.dropped += due - 1;
+      const Frame& f = _frame[_queue[due-1]];
+      _callback(pixels(_queue[due-1]), f.start, f.stop);
+      _presentedTimecode = f.timecode;
+      _presentedValid = true;
+      stats.presented++;
+      // remove presented and older frames (a new clock reference may have scheduled older frames later)
+      unsigned n = 0;
+      for (unsigned i = 0; i < _queued; i++) {
+        Frame& q = _frame[_queue[i]];
+        if (i < due || int32_t(q.timecode - _presentedTimecode) < 0) {
+          if (i >= due) stats.dropped++;
+          q.queued = false;
+        } else _queue[n++] = _queue[i];
+      }
+      _queued = n;
+    }
+
+    // map a time code (middle 32 bits of NTP time, 1/65536 s) to millis() without a common clock:
+    // follows the sender clock using the fastest packet seen as reference, adding DDP_JITTER_DELAY
+    unsigned long schedule(uint32_t timecode, unsigned long now) {
+      const uint32_t local = uint32_t((uint64_t(now) << 16) / 1000);
+      const uint32_t offset = local - timecode;
+      const int32_t diff = int32_t(offset - _clockOffset);
+      if (!_clockValid || diff < -5 * 65536 || diff > 5 * 65536) {
+        _clockOffset = offset; // first frame or sender clock jumped by more than 5s
+        _clockValid = true;
+      } else if (diff < 0) {
+        _clockOffset = offset; // faster packet, new reference
+      } else {
+        _clockOffset += 1;     // slowly follow clock drift (~0.6ms/s at 40 frames/s)
+      }
+      return now - ((int64_t(int32_t(offset - _clockOffset)) * 1000) >> 16) + DDP_JITTER_DELAY;
+    }
+
+    inline bool     isActive() const { return _pixels != nullptr; }
+    inline unsigned getDepth() const { return _queued; }
+
+  private:
+    struct Frame {
+      unsigned long due;
+      uint32_t      timecode;
+      uint16_t      start, stop;  // range of LEDs received
+      bool          queued;
+    };
+    ddp_frame_callback_function _callback;
+    uint32_t* _pixels = nullptr;
+    unsigned  _leds = 0;
+    Frame     _frame[DDP_JITTER_FRAMES + 1];
+    uint8_t   _queue[DDP_JITTER_FRAMES];  // frames waiting for presentation, sorted by presentation time
+    unsigned  _queued = 0;
+    unsigned  _rx = 0;                    // frame being received
+    uint32_t  _presentedTimecode = 0;
+    bool      _presentedValid = false;
+    uint32_t  _clockOffset = 0;           // local clock - sender clock (1/65536 s)
+    bool      _clockValid = false;
+
+    inline uint32_t* pixels(unsigned frame) const { return _pixels + frame * _leds; }
+    inline void clear(unsigned frame) { _frame[frame].start = 0xFFFF; _frame[frame].stop = 0; }
+};
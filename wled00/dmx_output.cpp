@@ -8,62 +8,34 @@
  * https://github.com/Rickgg/ESP-Dmx
  * ESP32 Library from:
  * https://github.com/sparkfun/SparkFunDMX
+ *
+ * Channels are rendered from a compiled patch (see dmx_patch.h), rebuilt when settings or LED count change.
  */
 
 #ifdef WLED_ENABLE_DMX
 
+// the classic fixture settings are profile 0 and fixture group 0
+static void compileDMXPatch(unsigned len) {
+  DMXProfile& prof = dmxPatch.profile[0];
+  prof.channels = DMXChannels;
+  memcpy(prof.map, DMXFixtureMap, sizeof(prof.map));
+  dmxPatch.group[0] = {DMXStartLED, 0, DMXStart, DMXGap, 0, 0};  // uses the amount of LEDs as fixture count
+  if (dmxPatch.groups == 0) dmxPatch.groups = 1;
+  dmxPatch.compile(len);
+}
+
 void handleDMXOutput()
 {
   // don't act, when in DMX Proxy mode
   if (e131ProxyUniverse != 0) return;
 
-  uint8_t brightness = strip.getBrightness();
-
-  bool calc_brightness = true;
-
-   // check if no shutter channel is set
-   for (unsigned i = 0; i < DMXChannels; i++)
-   {
-     if (DMXFixtureMap[i] == 5) calc_brightness = false;
-   }
-
-  uint16_t len = strip.getLengthTotal();
-  for (int i = DMXStartLED; i < len; i++) {        // uses the amount of LEDs as fixture count
-
-    uint32_t in = strip.getPixelColor(i);     // get the colors for the individual fixtures as suggested by Aircoookie in issue #462
-    byte w = W(in);
-    byte r = R(in);
-    byte g = G(in);
-    byte b = B(in);
+  unsigned len = strip.getLengthTotal();
+  if (!dmxPatch.isValid(len)) compileDMXPatch(len);
 
-    int DMXFixtureStart = DMXStart + (DMXGap * (i - DMXStartLED));
-    for (int j = 0; j < DMXChannels; j++) {
-      int DMXAddr = DMXFixtureStart + j;
-      switch (DMXFixtureMap[j]) {
-        case 0:        // Set this channel to 0. Good way to tell strobe- and fade-functions to fuck right off.
-          dmx.write(DMXAddr, 0);
-          break;
-        case 1:        // Red
-          dmx.write(DMXAddr, calc_brightness ? (r * brightness) / 255 : r);
-          break;
-        case 2:        // Green
-          dmx.write(DMXAddr, calc_brightness ? (g * brightness) / 255 : g);
-          break;
-        case 3:        // Blue
-          dmx.write(DMXAddr, calc_brightness ? (b * brightness) / 255 : b);
-          break;
-        case 4:        // White
-          dmx.write(DMXAddr, calc_brightness ? (w * brightness) / 255 : w);
-          break;
-        case 5:        // Shutter channel. Controls the brightness.
-          dmx.write(DMXAddr, brightness);
-          break;
-        case 6:        // Sets this channel to 255. Like 0, but more wholesome.
-          dmx.write(DMXAddr, 255);
-          break;
-      }
-    }
-  }
+  // get the colors for the individual fixtures as suggested by Aircoookie in issue #462
+  dmxPatch.render(strip.getBrightness(), [](unsigned i) { return strip.getPixelColor(i); });
+  const uint8_t* universe = dmxPatch.universe(0);
+  if (universe) dmx.writeBytes(universe + 1, 512);
 
   dmx.update();        // update the DMX bus
 }
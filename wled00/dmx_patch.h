@@ -0,0 +1,247 @@
+/* dmx_patch.h
+
+Compiled DMX output patch.
+
+Fixture groups (a run of LEDs, start address, spacing, profile and universe) and fixture profiles (the function of
+every channel of a fixture) are compiled into a flat table of entries (source pixel, channel slot, transform), sorted
+by pixel, whenever the configuration or the LED count changes. Rendering a frame is then a single pass over that
+table: constant channels come from a template copied at once, every pixel color is fetched once, brightness scaling
+is a table lookup instead of a division per channel. The result are complete universes (start code + 512 channels)
+ready for one bulk transfer. Like the classic DMX output, colors of fixtures whose profile has a shutter channel are
+not scaled (the shutter channel gets the brightness).
+
+Channel functions (DMX_CH_*) 0-6 are those of the classic DMX output settings, 7-10 are the fine (low) byte of a
+16 bit color channel: a profile containing e.g. DMX_CH_RED_FINE outputs red as 16 bit value on its DMX_CH_RED (coarse)
+and DMX_CH_RED_FINE channels, so brightness scaling does not lose resolution.
+Addresses beyond 512 continue in the next universe.
+Like with the classic DMX output the last write wins: a channel addressed by several fixtures (a gap smaller than the
+profile, overlapping groups) gets the value of the fixture that comes last (groups in order, then fixtures in order),
+also if that channel is a constant one. Every channel is thus written by one entry at most.
+
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+
+#ifndef DMX_MAX_UNIVERSES
+  #define DMX_MAX_UNIVERSES 1     // universes rendered (the DMX output has one port)
+#endif
+#define DMX_MAX_PROFILES          4
+#define DMX_MAX_GROUPS            4
+#define DMX_MAX_PROFILE_CHANNELS  15
+#define DMX_UNIVERSE_SIZE         513   // start code + 512 channels
+
+#define DMX_CH_ZERO        0
+#define DMX_CH_RED         1
+#define DMX_CH_GREEN       2
+#define DMX_CH_BLUE        3
+#define DMX_CH_WHITE       4
+#define DMX_CH_SHUTTER     5
+#define DMX_CH_FULL        6
+#define DMX_CH_RED_FINE    7
+#define DMX_CH_GREEN_FINE  8
+#define DMX_CH_BLUE_FINE   9
+#define DMX_CH_WHITE_FINE  10
+
+struct DMXProfile {
+  uint8_t channels;                         // channels per fixture
+  uint8_t map[DMX_MAX_PROFILE_CHANNELS];    // function of each channel (DMX_CH_*)
+};
+
+struct DMXFixtureGroup {
+  uint16_t startLED;   // LED of the first fixture
+  uint16_t count;      // number of fixtures (0 = up to the end of the strip)
+  uint16_t start;      // DMX address of the first fixture (1-512)
+  uint16_t gap;        // address spacing between fixtures
+  uint8_t  profile;
+  uint8_t  universe;   // universe of the start address (relative to the first output universe)
+};
+
+class DMXPatch {
+  public:
+    DMXProfile      profile[DMX_MAX_PROFILES] = {};
+    DMXFixtureGroup group[DMX_MAX_GROUPS] = {};
+    uint8_t         groups = 0;               // groups in use
+
+    DMXPatch() {}
+    ~DMXPatch() { free(); }
+    DMXPatch(const DMXPatch&) = delete;
+    DMXPatch& operator=(const DMXPatch&) = delete;
+
+    inline void invalidate() { _valid = false; }
+    inline bool isValid(unsigned leds) const { return _valid && leds == _leds; }
+
+    // compile groups and profiles for a strip of the given length, returns false if out of memory
+    bool compile(unsigned leds) {
+      free();
+      _leds = leds;
+      _valid = true; // don't retry every frame if memory is missing
+
+      // count entries and universes
+      unsigned entries = 0;
+      _universes = 0;
+      forEachChannel(leds, [&](unsigned, unsigned u, unsigned, uint8_t) {
+        entries++;
+        if (u + 1 > _universes) _universes = u + 1;
+      });
+      if (_universes == 0) return true;
+      if (entries > _universes * 512) entries = _universes * 512; // one entry per channel at most
+
+      _data = (uint8_t*)d_malloc(2 * _universes * DMX_UNIVERSE_SIZE); // output and template
+      _entry = entries ? (Entry*)d_malloc(entries * sizeof(Entry)) : nullptr;
+      uint16_t* owner = (uint16_t*)d_malloc(_universes * DMX_UNIVERSE_SIZE * sizeof(uint16_t)); // entry writing a channel
+      if (!_data || (entries && !_entry) || !owner) {
+        if (owner) d_free(owner);
+        free();
+        return false;
+      }
+      uint8_t* tmpl = _data + _universes * DMX_UNIVERSE_SIZE;
+      memset(tmpl, 0, _universes * DMX_UNIVERSE_SIZE);
+      memset(owner, 0xFF, _universes * DMX_UNIVERSE_SIZE * sizeof(uint16_t));
+
+      // build entries in configuration order, a later fixture replaces what an earlier one wrote to the same channel
+      _entries = 0;
+      forEachChannel(leds, [&](unsigned pixel, unsigned u, unsigned addr, uint8_t fn) {
+        const uint16_t slot = u * DMX_UNIVERSE_SIZE + addr;
+        switch (fn) {
+          case DMX_CH_SHUTTER: set(owner, pixel, slot, 0, OP_SHUTTER); return;
+          case DMX_CH_RED: case DMX_CH_GREEN: case DMX_CH_BLUE: case DMX_CH_WHITE:
+            set(owner, pixel, slot, shift(fn), _shutter ? OP_RAW : (_fine & (1 << fn)) ? OP_COARSE : OP_COLOR); return;
+          case DMX_CH_RED_FINE: case DMX_CH_GREEN_FINE: case DMX_CH_BLUE_FINE: case DMX_CH_WHITE_FINE:
+            // unscaled 16 bit value is v * 257, its low byte equals the high byte
+            set(owner, pixel, slot, shift(fn - DMX_CH_RED_FINE + DMX_CH_RED), _shutter ? OP_RAW : OP_FINE); return;
+          default: // constant: DMX_CH_FULL is 255, DMX_CH_ZERO and unknown functions are 0
+            tmpl[slot] = fn == DMX_CH_FULL ? 255 : 0;
+            if (owner[slot] != UINT16_MAX) _entry[owner[slot]].op = OP_NONE;
+            return;
+        }
+      });
+      d_free(owner);
+      // drop replaced entries, a single pass reads every pixel once
+      unsigned n = 0;
+      for (unsigned i = 0; i < _entries; i++) if (_entry[i].op != OP_NONE) _entry[n++] = _entry[i];
+      _entries = n;
+      sortEntries();
+      memcpy(_data, tmpl, _universes * DMX_UNIVERSE_SIZE);
+      return true;
+    }
+
+    // render all universes, getColor(i) returns the color of LED i
+    template<typename F> void render(uint8_t brightness, F getColor) {
+      if (!_data) return;
+      memcpy(_data, _data + _universes * DMX_UNIVERSE_SIZE, _universes * DMX_UNIVERSE_SIZE);
+      if (brightness != _brightness) buildScaleTable(brightness);
+      unsigned pixel = UINT16_MAX + 1;
+      uint32_t color = 0;
+      for (unsigned i = 0; i < _entries; i++) {
+        const Entry& e = _entry[i];
+        if (e.pixel != pixel) {
+          pixel = e.pixel;
+          color = getColor(pixel);
+        }
+        const uint8_t v = color >> e.shift;
+        switch (e.op) {
+          case OP_COLOR:   _data[e.slot] = _scale8[v]; break;
+          case OP_RAW:     _data[e.slot] = v; break;
+          case OP_COARSE:  _data[e.slot] = _scale16[v] >> 8; break;
+          case OP_FINE:    _data[e.slot] = _scale16[v] & 0xFF; break;
+          case OP_SHUTTER: _data[e.slot] = brightness; break;
+          default: break;
+        }
+      }
+    }
+
+    // universe data for bulk transfer: start code followed by 512 channels
+    inline const uint8_t* universe(unsigned u) const { return u < _universes ? _data + u * DMX_UNIVERSE_SIZE : nullptr; }
+    inline unsigned       getUniverses() const { return _data ? _universes : 0; }
+    inline unsigned       getEntries() const { return _entries; }
+
+  private:
+    enum : uint8_t { OP_COLOR, OP_RAW, OP_COARSE, OP_FINE, OP_SHUTTER, OP_NONE };
+    struct Entry {
+      uint16_t pixel;
+      uint16_t slot;    // universe * DMX_UNIVERSE_SIZE + address
+      uint8_t  shift;   // bit position of the color component
+      uint8_t  op;
+    };
+    Entry*   _entry = nullptr;
+    unsigned _entries = 0;
+    uint8_t* _data = nullptr;       // rendered universes followed by the template with constant channels
+    unsigned _universes = 0;
+    unsigned _leds = 0;
+    bool     _valid = false;
+    bool     _shutter = false;      // current profile has a shutter channel, its colors are not scaled by brightness
+    uint16_t _fine = 0;             // bit DMX_CH_RED..DMX_CH_WHITE set if the current profile has a fine channel for it
+    int      _brightness = -1;      // brightness of the scale tables
+    uint8_t  _scale8[256];
+    uint16_t _scale16[256];
+
+    static inline uint8_t shift(uint8_t fn) {
+      switch (fn) {
+        case DMX_CH_RED:   return 16;
+        case DMX_CH_GREEN: return 8;
+        case DMX_CH_BLUE:  return 0;
+        default:           return 24;  // white
+      }
+    }
+
+    // calls f(pixel, universe, address, function) for every channel of every fixture
+    template<typename F> void forEachChannel(unsigned leds, F f) {
+      for (unsigned g = 0; g < groups && g < DMX_MAX_GROUPS; g++) {
+        const DMXFixtureGroup& grp = group[g];
+        if (grp.profile >= DMX_MAX_PROFILES || grp.start == 0) continue;
+        const DMXProfile& prof = profile[grp.profile];
+        const unsigned channels = prof.channels > DMX_MAX_PROFILE_CHANNELS ? DMX_MAX_PROFILE_CHANNELS : prof.channels;
+        _fine = 0;
+        _shutter = false;
+        for (unsigned j = 0; j < channels; j++) {
+          if (prof.map[j] == DMX_CH_SHUTTER) _shutter = true;
+          if (prof.map[j] >= DMX_CH_RED_FINE && prof.map[j] <= DMX_CH_WHITE_FINE) _fine |= 1 << (prof.map[j] - DMX_CH_RED_FINE + DMX_CH_RED);
+        }
+        unsigned stop = grp.count ? grp.startLED + grp.count : leds;
+        if (stop > leds) stop = leds;
+        for (unsigned pixel = grp.startLED; pixel < stop; pixel++) {
+          const unsigned base = grp.start + grp.gap * (pixel - grp.startLED) - 1; // 0-based, relative to group universe
+          for (unsigned j = 0; j < channels; j++) {
+            const unsigned u = grp.universe + (base + j) / 512;
+            if (u >= DMX_MAX_UNIVERSES) { pixel = stop; break; } // rest of the group is not rendered
+            f(pixel, u, (base + j) % 512 + 1, prof.map[j]);
+          }
+        }
+      }
+    }
+
+    // channel slot is written by pixel, replacing an earlier entry of that channel (owner: entry index per slot)
+    inline void set(uint16_t* owner, unsigned pixel, uint16_t slot, uint8_t shift, uint8_t op) {
+      if (owner[slot] == UINT16_MAX) owner[slot] = _entries++;
+      _entry[owner[slot]] = {uint16_t(pixel), slot, shift, op};
+    }
+
+    // insertion sort by pixel (entries of a group are already in order, so this is about linear)
+    void sortEntries() {
+      for (unsigned i = 1; i < _entries; i++) {
+        const Entry e = _entry[i];
+        unsigned j = i;
+        while (j > 0 && _entry[j-1].pixel > e.pixel) { _entry[j] = _entry[j-1]; j--; }
+        _entry[j] = e;
+      }
+    }
+
+    void buildScaleTable(uint8_t brightness) {
+      for (unsigned v = 0; v < 256; v++) {
+        _scale8[v]  = (v * brightness) / 255;
+        _scale16[v] = (v * 257 * brightness) / 255;
+      }
+      _brightness = brightness;
+    }
+
+    void free() {
+      if (_entry) d_free(_entry);
+      if (_data) d_free(_data);
+      _entry = nullptr;
+      _data = nullptr;
+      _entries = _universes = 0;
+    }
+};
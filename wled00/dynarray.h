@@ -8,11 +8,13 @@ Macros for generating a "dynamic array", a static array of objects declared in d
 
 // Declare the beginning and ending elements of a dynamic array of 'type'.
 // This must be used in only one translation unit in your program for any given array.
+// The markers are aligned like the elements (some compilers over-align arrays, which would leave a gap before the end).
 #define DECLARE_DYNARRAY(type, array_name) \
-  static type const DYNARRAY_BEGIN(array_name)[0] __attribute__((__section__(DYNARRAY_SECTION "." #array_name ".0"), unused)) = {}; \
-  static type const DYNARRAY_END(array_name)[0] __attribute__((__section__(DYNARRAY_SECTION "." #array_name ".99999"), unused)) = {};
+  static type const DYNARRAY_BEGIN(array_name)[0] __attribute__((__section__(DYNARRAY_SECTION "." #array_name ".0"), aligned(alignof(type)), unused)) = {}; \
+  static type const DYNARRAY_END(array_name)[0] __attribute__((__section__(DYNARRAY_SECTION "." #array_name ".99999"), aligned(alignof(type)), unused)) = {};
 
-// Declare an object that is a member of a dynamic array.  "member name" must be unique; "array_section" is an integer for ordering items.
+// Declare an object that is a member of a dynamic array.  "member name" must be unique; "array_section" is an integer for ordering items
+// (sections are sorted by name, use 1-9).
 // It is legal to define multiple items with the same section name; the order of those items will be up to the linker.
 #define DYNARRAY_MEMBER(type, array_name, member_name, array_section) type const member_name __attribute__((__section__(DYNARRAY_SECTION "." #array_name "." #array_section), used))
 
@@ -4,11 +4,23 @@
 #define MAX_4_CH_LEDS_PER_UNIVERSE 128
 #define MAX_CHANNELS_PER_UNIVERSE 512
 
+// e131Sources, e131Frames and ddpFrames are fed by the network tasks (AsyncUDP, AsyncWebSocket) and serviced from loop(), both hold this lock
+// on ESP8266 network callbacks never preempt loop(), so no lock is needed
+#ifdef ARDUINO_ARCH_ESP32
+#include <mutex>
+static std::mutex e131DataLock;
+#define LOCK_E131_DATA() const std::lock_guard<std::mutex> lock(e131DataLock)
+#else
+#define LOCK_E131_DATA()
+#endif
+
 // forward declarations
 static void handleDDPPacket(e131_packet_t* p);
 static void handleArtnetPollReply(IPAddress ipAddress);
 static void prepareArtnetPollReply(ArtPollReply *reply);
 static void sendArtnetPollReply(ArtPollReply *reply, IPAddress ipAddress, uint16_t portAddress);
+static unsigned getE131UniverseCount();
+static unsigned long getDDPPresentationTime(uint32_t timecode);
 
 
 /*
@@ -48,7 +60,7 @@ static void handleDDPPacket(e131_packet_t* p) {
   unsigned stop = start + dataLen / ddpChannelsPerLed;
   uint8_t* data = p->data;
   unsigned c = 0;
-  if (p->flags & DDP_FLAGS_TIME) c = 4; //packet has timecode flag, we do not support it, but data starts 4 bytes later
+  if (p->flags & DDP_FLAGS_TIME) c = 4; //packet has timecode flag, data starts 4 bytes later (time code is used by ddpFrames, see below)
 
   unsigned numLeds = stop - start; // stop >= start is guaranteed
   unsigned maxDataIndex = c + numLeds * ddpChannelsPerLed; // validate bounds before accessing data array
@@ -60,7 +72,17 @@ static void handleDDPPacket(e131_packet_t* p) {
   if (realtimeMode != REALTIME_MODE_DDP) ddpSeenPush = false; // just starting, no push yet
   realtimeLock(realtimeTimeoutMs, REALTIME_MODE_DDP);
 
-  if (!realtimeOverride) {
+  // buffer complete frames and present them at the sender's time code
+  LOCK_E131_DATA(); // held until the frame is pushed, loop() presents frames from the same buffer
+  static uint32_t timecode = 0;
+  bool buffered = false;
+  if (ddpTimecodeSync) buffered = ddpFrames.begin(strip.getLengthTotal());
+  else if (ddpFrames.isActive()) ddpFrames.end();
+  if (p->flags & DDP_FLAGS_TIME) timecode = (uint32_t(data[0]) << 24) | (uint32_t(data[1]) << 16) | (uint32_t(data[2]) << 8) | data[3];
+
+  if (buffered) {
+    ddpFrames.write(start, data + c, numLeds, ddpChannelsPerLed);
+  } else if (!realtimeOverride) {
     for (unsigned i = start; i < stop; i++, c += ddpChannelsPerLed) {
       setRealtimePixel(i, data[c], data[c+1], data[c+2], ddpChannelsPerLed >3 ? data[c+3] : 0);
     }
@@ -69,18 +91,47 @@ static void handleDDPPacket(e131_packet_t* p) {
   bool push = p->flags & DDP_FLAGS_PUSH;
   ddpSeenPush |= push;
   if (!ddpSeenPush || push) { // if we've never seen a push, or this is one, render display
-    e131NewData = true;
+    if (buffered) {
+      // frames without time code are presented immediately, local time serves as their time code
+      const unsigned long now = millis();
+      if (p->flags & DDP_FLAGS_TIME) ddpFrames.push(timecode, getDDPPresentationTime(timecode), now);
+      else                           ddpFrames.push(uint32_t((uint64_t(now) << 16) / 1000), now, now);
+      ddpFrames.handle(now);
+    } else e131NewData = true;
     int sn = p->sequenceNum & 0xF;
     if (sn) e131LastSequenceNumber[0] = sn;
   }
 }
 
+// present a buffered DDP frame
+void handleDDPFrame(const uint32_t* pixels, unsigned start, unsigned stop) {
+  if (realtimeMode != REALTIME_MODE_DDP || realtimeOverride) return;
+  for (unsigned i = start; i < stop; i++) {
+    const uint32_t c = pixels[i];
+    setRealtimePixel(i, R(c), G(c), B(c), W(c));
+  }
+  e131NewData = true;
+}
+
+// DDP time code is the middle 32 bits of NTP time (seconds and fraction in 1/65536 s)
+static unsigned long getDDPPresentationTime(uint32_t timecode) {
+  const unsigned long now = millis();
+  // without a millisecond accurate common clock (NTP, or WLED sync from an NTP synced instance) follow the sender clock
+  if (toki.getTimeSource() < TOKI_TS_UDP_NTP) return ddpFrames.schedule(timecode, now);
+  const Toki::Time t = toki.getTime();
+  const uint32_t local = ((t.sec + YEARS_70) << 16) | ((uint32_t(t.ms) << 16) / 1000);
+  const int32_t delta = (int64_t(int32_t(timecode - local)) * 1000) >> 16;
+  if (delta < -5000 || delta > 5000) return ddpFrames.schedule(timecode, now); // sender time code is not NTP based
+  return now + delta;
+}
+
 //E1.31 and Art-Net protocol support
 void handleE131Packet(e131_packet_t* p, IPAddress clientIP, byte protocol){
 
   int uni = 0, dmxChannels = 0;
   uint8_t* e131_data = nullptr;
   int seq = 0, mde = REALTIME_MODE_E131;
+  uint16_t syncAddress = E131_ARTSYNC;
 
   if (protocol == P_ARTNET)
   {
@@ -88,12 +139,24 @@ void handleE131Packet(e131_packet_t* p, IPAddress clientIP, byte protocol){
       handleArtnetPollReply(clientIP);
       return;
     }
+    if (p->art_opcode == ARTNET_OPCODE_OPSYNC) {
+      LOCK_E131_DATA();
+      e131Frames.sync(E131_ARTSYNC, millis());
+      return;
+    }
     uni = p->art_universe;
     dmxChannels = htons(p->art_length);
     e131_data = p->art_data;
     seq = p->art_sequence_number;
     mde = REALTIME_MODE_ARTNET;
   } else if (protocol == P_E131) {
+    // synchronization packet (E1.31: 6.3)
+    if (htonl(p->root_vector) == E131_VECTOR_ROOT_EXTENDED) {
+      if (!ESPAsyncE131::isSyncPacket(p)) return; // validated like data packets (packets received via WebSocket are not parsed by ESPAsyncE131)
+      LOCK_E131_DATA();
+      e131Frames.sync(htons(p->sync_universe), millis());
+      return;
+    }
     // Ignore PREVIEW data (E1.31: 6.2.6)
     if ((p->options & 0x80) != 0) return;
     dmxChannels = htons(p->property_value_count) - 1;
@@ -102,12 +165,7 @@ void handleE131Packet(e131_packet_t* p, IPAddress clientIP, byte protocol){
     uni = htons(p->universe);
     e131_data = p->property_values;
     seq = p->sequence_number;
-    if (e131Priority != 0) {
-      if (p->priority < e131Priority ) return;
-      // track highest priority & skip all lower priorities
-      if (p->priority >= highPriority.get()) highPriority.set(p->priority);
-      if (p->priority < highPriority.get()) return;
-    }
+    syncAddress = htons(p->sync_address);
   } else { //DDP
     realtimeIP = clientIP;
     handleDDPPacket(p);
@@ -128,19 +186,68 @@ void handleE131Packet(e131_packet_t* p, IPAddress clientIP, byte protocol){
 
   unsigned previousUniverses = uni - e131Universe;
 
-  if (e131SkipOutOfSequence)
-    if (seq < e131LastSequenceNumber[previousUniverses] && seq > 20 && e131LastSequenceNumber[previousUniverses] < 250){
-      DEBUG_PRINTF_P(PSTR("skipping E1.31 frame (last seq=%d, current seq=%d, universe=%d)\n"), e131LastSequenceNumber[previousUniverses], seq, uni);
+  LOCK_E131_DATA(); // held until the data is written, the merge buffer may be changed by other tasks
+  if (protocol == P_E131) {
+    // multiple senders: highest priority wins, equal priorities are merged (E1.31: 6.2.3)
+    // sequence numbers are checked per sender (if enabled), the merged universe gets its own sequence
+    uint16_t channels = dmxChannels;
+    e131Sources.minPriority = e131Priority;
+    e131Sources.mergeMode = e131MergeMode;
+    e131Sources.skipOutOfSequence = e131SkipOutOfSequence;
+    e131_data = e131Sources.merge(previousUniverses, p->cid, p->priority, seq, p->options, e131_data, channels, millis());
+    if (!e131_data) return;
+    dmxChannels = channels;
+    seq = e131Sources.getSequence(previousUniverses);
+  } else if (e131SkipOutOfSequence) {
+    if (seq < e131LastSequenceNumber[previousUniverses] && seq > 20 && e131LastSequenceNumber[previousUniverses] < 250) {
+      DEBUG_PRINTF_P(PSTR("skipping Art-Net frame (last seq=%d, current seq=%d, universe=%d)\n"), e131LastSequenceNumber[previousUniverses], seq, uni);
       return;
     }
+  }
   e131LastSequenceNumber[previousUniverses] = seq;
 
   // update status info
   realtimeIP = clientIP;
 
+  // pixel data spanning multiple universes is assembled into complete frames before it is shown
+  if (DMXMode == DMX_MODE_MULTIPLE_RGB || DMXMode == DMX_MODE_MULTIPLE_DRGB || DMXMode == DMX_MODE_MULTIPLE_RGBW) {
+    if (e131Frames.begin(getE131UniverseCount())) {
+      e131Frames.add(previousUniverses, e131_data, dmxChannels, seq, mde, syncAddress, millis());
+      return;
+    }
+  } else if (e131Frames.isActive()) {
+    e131Frames.end(); // release back buffer
+  }
+
   handleDMXData(uni, dmxChannels, e131_data, mde, previousUniverses);
 }
 
+// called from loop(): show incomplete E1.31/Art-Net frame after timeout, drop lost E1.31 sources, present buffered DDP frame when due
+void handleE131Timeouts() {
+  LOCK_E131_DATA();
+  e131Frames.handle(millis());
+  e131Sources.expire(millis());
+  ddpFrames.handle(millis());
+}
+
+// called by the frame assembler for every universe of a frame that is shown
+void handleE131FrameUniverse(uint8_t index, uint8_t* data, uint16_t channels, uint8_t mode) {
+  handleDMXData(e131Universe + index, channels, data, mode, index);
+}
+
+// number of universes needed to cover all LEDs in DMX_MODE_MULTIPLE_* modes
+static unsigned getE131UniverseCount() {
+  const bool is4Chan = (DMXMode == DMX_MODE_MULTIPLE_RGBW);
+  const unsigned dmxChannelsPerLed = is4Chan ? 4 : 3;
+  const unsigned ledsPerUniverse = is4Chan ? MAX_4_CH_LEDS_PER_UNIVERSE : MAX_3_CH_LEDS_PER_UNIVERSE;
+  const unsigned dmxLenOffset = (DMXAddress == 0) ? 0 : 1;
+  const unsigned dimmerOffset = (DMXMode == DMX_MODE_MULTIPLE_DRGB) ? 1 : 0;
+  const unsigned ledsInFirstUniverse = (((MAX_CHANNELS_PER_UNIVERSE - DMXAddress) + dmxLenOffset) - dimmerOffset) / dmxChannelsPerLed;
+  const unsigned totalLen = strip.getLengthTotal();
+  if (totalLen <= ledsInFirstUniverse) return 1;
+  return std::min(1 + (totalLen - ledsInFirstUniverse + ledsPerUniverse - 1) / ledsPerUniverse, (unsigned)E131_MAX_UNIVERSE_COUNT);
+}
+
 void handleDMXData(uint16_t uni, uint16_t dmxChannels, uint8_t* e131_data, uint8_t mde, uint8_t previousUniverses) {
   byte wChannel = 0;
   unsigned totalLen = strip.getLengthTotal();
@@ -0,0 +1,154 @@
+/* e131_frames.h
+
+Frame assembler for multi-universe E1.31 (sACN) and Art-Net pixel data.
+
+Universes are collected in a back buffer and handed to the strip together, so a frame is never shown
+half old and half new when packets are reordered or lost. A frame is shown:
+- when a synchronization packet (E1.31 sync / ArtSync) arrives, if the sender uses synchronization
+- otherwise as soon as all universes of the frame have been received,
+  or when a universe repeats before the frame was complete (packet loss, the sender has started a new frame),
+  or after E131_FRAME_TIMEOUT if the rest of the frame never arrives.
+
+Universes missing in a shown frame keep their previous content (freeze instead of flicker).
+
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+
+#ifndef E131_FRAME_TIMEOUT
+  #define E131_FRAME_TIMEOUT 50   // ms to wait for missing universes before an incomplete frame is shown
+#endif
+#ifndef E131_SYNC_TIMEOUT
+  #define E131_SYNC_TIMEOUT 2500  // ms without synchronization packet until falling back to unsynchronized mode (E1.31: 6.2.4.1)
+#endif
+#define E131_SLOT_SIZE 513        // DMX start code + 512 channels
+#define E131_ARTSYNC   0xFFFF     // pseudo synchronization address of Art-Net (ArtSync has no address, 0xFFFF is no valid E1.31 universe)
+
+static_assert(E131_MAX_UNIVERSE_COUNT <= 32, "E131_MAX_UNIVERSE_COUNT must fit into 32 bit mask");
+
+// called for every received universe of a frame that is shown, index is relative to the first universe
+typedef void (*e131_universe_callback_function)(uint8_t index, uint8_t* data, uint16_t channels, uint8_t mode);
+
+class E131FrameAssembler {
+  public:
+    struct Stats {
+      uint32_t frames;           // frames shown
+      uint32_t partialFrames;    // frames shown with missing universes
+      uint32_t outOfOrder;       // universes received out of order within a frame or late (late ones are discarded)
+      uint32_t droppedUniverses; // universes missing in shown frames
+      uint32_t syncPackets;      // accepted synchronization packets
+    } stats = {};
+
+    E131FrameAssembler(e131_universe_callback_function callback) : _callback(callback) {}
+    ~E131FrameAssembler() { end(); }
+    E131FrameAssembler(const E131FrameAssembler&) = delete;
+    E131FrameAssembler& operator=(const E131FrameAssembler&) = delete;
+
+    // (re)allocate back buffer for the given number of universes, returns false if not possible
+    bool begin(unsigned universes) {
+      if (_buffer && universes == _universes) return true;
+      end();
+      if (universes == 0 || universes > E131_MAX_UNIVERSE_COUNT) return false;
+      _buffer = (uint8_t*)d_malloc(universes * E131_SLOT_SIZE);
+      if (!_buffer) return false;
+      _universes = universes;
+      _complete = (universes == 32) ? 0xFFFFFFFFUL : (1UL << universes) - 1;
+      _received = _seqValid = 0;
+      return true;
+    }
+
+    void end() {
+      if (_buffer) d_free(_buffer);
+      _buffer = nullptr;
+      _universes = 0;
+      _received = _seqValid = 0;
+    }
+
+    // store a received universe; mode is REALTIME_MODE_E131 (data includes start code) or REALTIME_MODE_ARTNET
+    // syncAddress is the E1.31 synchronization universe of the data packet (0 = none), E131_ARTSYNC for Art-Net
+    void add(unsigned index, const uint8_t* data, unsigned channels, uint8_t seq, uint8_t mode, uint16_t syncAddress, unsigned long now) {
+      if (!_buffer || index >= _universes) return;
+      const uint32_t bit = 1UL << index;
+
+      // discard late and duplicate packets (E1.31: 6.7.2), Art-Net sequence 0 means sequencing is disabled
+      if ((_seqValid & bit) && (seq || mode != REALTIME_MODE_ARTNET)) {
+        const int8_t diff = int8_t(seq - _seq[index]);
+        if (diff <= 0 && diff > -20) {
+          stats.outOfOrder++;
+          return;
+        }
+      }
+      _seq[index] = seq;
+      _seqValid |= bit;
+
+      if (_received && mode != _mode) _received = 0; // protocol changed, drop what we have
+      _syncAddress = syncAddress;
+      _mode = mode;
+
+      if (_received & bit) {
+        // universe repeats: the sender has moved on to the next frame (or we are waiting for sync, newest data wins)
+        if (!synchronized(now)) show();
+      }
+      if (_received & ~((bit << 1) - 1)) stats.outOfOrder++; // a higher universe of this frame was already received
+      if (!_received) _frameStart = now;
+
+      if (channels > E131_SLOT_SIZE - 1) channels = E131_SLOT_SIZE - 1;
+      memcpy(slot(index), data, channels + (mode == REALTIME_MODE_ARTNET ? 0 : 1));
+      _channels[index] = channels;
+      _received |= bit;
+
+      if (_received == _complete && !synchronized(now)) show();
+    }
+
+    // synchronization packet received, show the frame if it belongs to the universes we listen to
+    void sync(uint16_t syncAddress, unsigned long now) {
+      if (!_buffer || syncAddress == 0 || syncAddress != _syncAddress) return;
+      stats.syncPackets++;
+      _lastSync = now;
+      _syncSeen = true;
+      if (_received) show();
+    }
+
+    // show an incomplete frame if the missing universes did not arrive in time (or synchronization was lost)
+    void handle(unsigned long now) {
+      if (!_received || synchronized(now)) return;
+      if (now - _frameStart > E131_FRAME_TIMEOUT) show();
+    }
+
+    inline bool     isActive() const { return _buffer != nullptr; }
+    inline unsigned getUniverses() const { return _universes; }
+    inline bool     synchronized(unsigned long now) const { return _syncSeen && _syncAddress && now - _lastSync < E131_SYNC_TIMEOUT; }
+
+  private:
+    e131_universe_callback_function _callback;
+    uint8_t*      _buffer = nullptr;
+    unsigned      _universes = 0;
+    uint32_t      _complete = 0;     // mask of all universes of a frame
+    uint32_t      _received = 0;     // mask of universes received for the current frame
+    uint32_t      _seqValid = 0;     // mask of universes with known sequence number
+    unsigned long _frameStart = 0;   // time first universe of current frame was received
+    unsigned long _lastSync = 0;     // time last synchronization packet was received
+    uint16_t      _syncAddress = 0;
+    bool          _syncSeen = false;
+    uint8_t       _mode = 0;
+    uint8_t       _seq[E131_MAX_UNIVERSE_COUNT];
+    uint16_t      _channels[E131_MAX_UNIVERSE_COUNT];
+
+    inline uint8_t* slot(unsigned index) const { return _buffer + index * E131_SLOT_SIZE; }
+
+    void show() {
+      for (unsigned i = 0; i < _universes; i++) {
+        if (_received & (1UL << i)) _callback(i, slot(i), _channels[i], _mode);
+      }
+      const unsigned missing = _universes - __builtin_popcount(_received);
+      if (missing) {
+        stats.partialFrames++;
+        stats.droppedUniverses += missing;
+      }
+      stats.frames++;
+      _received = 0;
+    }
+};
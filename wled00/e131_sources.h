@@ -0,0 +1,229 @@
+/* e131_sources.h
+
+E1.31 (sACN) multi-source handling.
+
+Every universe tracks up to E131_MAX_SOURCES senders by their CID in a fixed-size table. Only sources with the
+highest priority of a universe are used, sources of lower priority are ignored until the higher priority ones
+time out (E131_SOURCE_TIMEOUT, E1.31: 6.7.1) or terminate their stream. If skipOutOfSequence is set, late and
+duplicate packets are discarded per source.
+Data of several sources with the same (highest) priority is merged:
+- LTP: latest packet takes precedence
+- HTP: highest value of each channel takes precedence
+
+HTP keeps the last data of every source of the universe and outputs the maximum of each channel over all sources
+with the highest priority, so a source lowering a channel never pulls it below another active source. The buffer
+(E131_MAX_SOURCES + 1 times 513 bytes) is allocated for a universe when its first packet is received in HTP mode
+and freed when the last source of the universe is gone or LTP is selected. At most E131_MAX_HTP_UNIVERSES buffers
+are allocated at a time, further universes are passed through as LTP until a buffer is freed.
+
+Sources time out in merge() and in expire(), which is called from loop() so lost sources are also dropped while no
+packets arrive.
+
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+
+#ifndef E131_MAX_SOURCES
+  #define E131_MAX_SOURCES 4      // senders tracked per universe
+#endif
+#ifndef E131_MAX_HTP_UNIVERSES
+  #define E131_MAX_HTP_UNIVERSES 4 // universes merged HTP at a time (2.5kB of heap each)
+#endif
+#ifndef E131_SOURCE_TIMEOUT
+  #define E131_SOURCE_TIMEOUT 2500  // ms without packet until a source is considered lost (E1.31: 6.7.1)
+#endif
+
+#define E131_MERGE_LTP 0
+#define E131_MERGE_HTP 1
+
+#define E131_OPTION_TERMINATED 0x40 // stream terminated (E1.31: 6.2.6)
+
+class E131SourceMerger {
+  public:
+    struct Stats {
+      uint32_t sourcesLost;       // sources timed out
+      uint32_t sourcesTerminated; // sources that terminated their stream
+      uint32_t rejected;          // packets from new sources not tracked because the table was full
+      uint32_t late;              // late or duplicate packets discarded
+      uint32_t htpOverflow;       // packets passed through as LTP because all HTP merge buffers were in use
+    } stats = {};
+
+    E131SourceMerger() {}
+    ~E131SourceMerger() { freeMergeBuffers(); }
+    E131SourceMerger(const E131SourceMerger&) = delete;
+    E131SourceMerger& operator=(const E131SourceMerger&) = delete;
+
+    // handle packet of a universe (index relative to first universe), returns the data to use or nullptr if the packet is to be ignored
+    // channels is updated to the number of channels of the returned data (which includes the start code, like E1.31 packet data)
+    uint8_t* merge(unsigned index, const uint8_t* cid, uint8_t priority, uint8_t seq, uint8_t options, uint8_t* data, uint16_t& channels, unsigned long now) {
+      if (index >= E131_MAX_UNIVERSE_COUNT) return nullptr;
+      Universe& u = _universe[index];
+      expire(index, now);
+
+      int s = find(u, cid);
+      if (options & E131_OPTION_TERMINATED) {
+        if (s >= 0) {
+          u.source[s].active = false;
+          u.source[s].channels = 0;
+          stats.sourcesTerminated++;
+          if (!getSourceCount(index)) freeMergeBuffer(index);
+        }
+        return nullptr;
+      }
+      if (priority < minPriority) return nullptr;
+
+      if (s < 0) {
+        s = add(u, cid, priority);
+        if (s < 0) {
+          stats.rejected++;
+          return nullptr;
+        }
+      } else if (skipOutOfSequence) {
+        // discard late and duplicate packets (E1.31: 6.7.2)
+        const int8_t diff = int8_t(seq - u.source[s].seq);
+        if (diff <= 0 && diff > -20) {
+          stats.late++;
+          return nullptr;
+        }
+      }
+      Source& src = u.source[s];
+      src.seq = seq;
+      src.priority = priority;
+      src.lastSeen = now;
+
+      // sources with the highest priority
+      uint8_t top = 0;
+      for (unsigned i = 0; i < E131_MAX_SOURCES; i++) if (u.source[i].active && u.source[i].priority > top) top = u.source[i].priority;
+      if (priority < top) return nullptr;
+      unsigned topMask = 0;
+      for (unsigned i = 0; i < E131_MAX_SOURCES; i++) if (u.source[i].active && u.source[i].priority == top) topMask |= 1U << i;
+      u.priority = top;
+      u.seq++;
+
+      if (mergeMode != E131_MERGE_HTP) {
+        if (_mergeBuffer[index]) freeMergeBuffer(index);
+        return data; // LTP: use the packet as is
+      }
+      if (channels > 512 || !allocMergeBuffer(index)) return data;
+
+      // HTP: keep data of every source, so it can be merged as soon as another source of the same priority appears
+      memcpy(sourceData(index, s), data, channels + 1);
+      src.channels = channels;
+      if (!(topMask & (topMask - 1))) return data; // single source
+
+      // every channel is the maximum over all sources with the highest priority
+      uint8_t* value = _mergeBuffer[index];
+      unsigned outChannels = 0;
+      for (unsigned i = 0; i < E131_MAX_SOURCES; i++) if ((topMask & (1U << i)) && u.source[i].channels > outChannels) outChannels = u.source[i].channels;
+      value[0] = data[0]; // start code
+      memset(value + 1, 0, outChannels);
+      for (unsigned i = 0; i < E131_MAX_SOURCES; i++) {
+        if (!(topMask & (1U << i))) continue;
+        const uint8_t* d = sourceData(index, i);
+        for (unsigned c = 1; c <= u.source[i].channels; c++) if (d[c] > value[c]) value[c] = d[c];
+      }
+      channels = outChannels;
+      return value;
+    }
+
+    // drop sources that timed out, call regularly (packets of other sources may not arrive)
+    void expire(unsigned long now) {
+      for (unsigned i = 0; i < E131_MAX_UNIVERSE_COUNT; i++) expire(i, now);
+    }
+
+    // output sequence number of a universe, increments with every accepted packet
+    inline uint8_t getSequence(unsigned index) const { return index < E131_MAX_UNIVERSE_COUNT ? _universe[index].seq : 0; }
+    inline uint8_t getPriority(unsigned index) const { return index < E131_MAX_UNIVERSE_COUNT ? _universe[index].priority : 0; }
+    unsigned getSourceCount(unsigned index) const {
+      unsigned n = 0;
+      if (index < E131_MAX_UNIVERSE_COUNT) for (unsigned i = 0; i < E131_MAX_SOURCES; i++) n += _universe[index].source[i].active;
+      return n;
+    }
+
+    uint8_t minPriority = 0;               // packets with lower priority are ignored
+    uint8_t mergeMode = E131_MERGE_LTP;    // merge of sources with the same priority
+    bool skipOutOfSequence = false;        // discard late and duplicate packets of a source
+
+  private:
+    struct Source {
+      uint8_t       cid[16];
+      unsigned long lastSeen;
+      uint8_t       priority;
+      uint8_t       seq;
+      uint16_t      channels; // channels of data kept for HTP merge (0 = none)
+      bool          active;
+    };
+    struct Universe {
+      Source   source[E131_MAX_SOURCES];
+      uint8_t  priority;  // current highest priority
+      uint8_t  seq;       // output sequence number
+    };
+    Universe _universe[E131_MAX_UNIVERSE_COUNT] = {};
+    uint8_t* _mergeBuffer[E131_MAX_UNIVERSE_COUNT] = {}; // HTP: merged output and data of every source, allocated with the first HTP packet of a universe
+    unsigned _mergeBuffers = 0;                          // merge buffers allocated
+
+    inline uint8_t* sourceData(unsigned index, unsigned s) const { return _mergeBuffer[index] + (s + 1) * (512 + 1); }
+
+    static int find(const Universe& u, const uint8_t* cid) {
+      for (unsigned i = 0; i < E131_MAX_SOURCES; i++) if (u.source[i].active && !memcmp(u.source[i].cid, cid, 16)) return i;
+      return -1;
+    }
+
+    // add new source, replaces a source of lower priority if the table is full
+    static int add(Universe& u, const uint8_t* cid, uint8_t priority) {
+      int s = -1;
+      for (unsigned i = 0; i < E131_MAX_SOURCES; i++) {
+        if (!u.source[i].active) { s = i; break; }
+        if (u.source[i].priority < priority && (s < 0 || u.source[i].priority < u.source[s].priority)) s = i;
+      }
+      if (s < 0) return -1;
+      memcpy(u.source[s].cid, cid, 16);
+      u.source[s].priority = priority;
+      u.source[s].active = true;
+      u.source[s].seq = 0;
+      u.source[s].lastSeen = 0;
+      u.source[s].channels = 0;
+      return s;
+    }
+
+    void expire(unsigned index, unsigned long now) {
+      Universe& u = _universe[index];
+      bool lost = false;
+      for (unsigned i = 0; i < E131_MAX_SOURCES; i++) {
+        if (u.source[i].active && now - u.source[i].lastSeen > E131_SOURCE_TIMEOUT) {
+          u.source[i].active = false;
+          u.source[i].channels = 0;
+          stats.sourcesLost++;
+          lost = true;
+        }
+      }
+      if (lost && _mergeBuffer[index] && !getSourceCount(index)) freeMergeBuffer(index);
+    }
+
+    bool allocMergeBuffer(unsigned index) {
+      if (_mergeBuffer[index]) return true;
+      if (_mergeBuffers >= E131_MAX_HTP_UNIVERSES) {
+        stats.htpOverflow++;
+        return false;
+      }
+      _mergeBuffer[index] = (uint8_t*)d_malloc((E131_MAX_SOURCES + 1) * (512 + 1));
+      if (!_mergeBuffer[index]) return false;
+      _mergeBuffers++;
+      return true;
+    }
+
+    void freeMergeBuffer(unsigned index) {
+      if (!_mergeBuffer[index]) return;
+      d_free(_mergeBuffer[index]);
+      _mergeBuffer[index] = nullptr;
+      _mergeBuffers--;
+      for (unsigned i = 0; i < E131_MAX_SOURCES; i++) _universe[index].source[i].channels = 0; // kept data is gone
+    }
+
+    void freeMergeBuffers() {
+      for (unsigned i = 0; i < E131_MAX_UNIVERSE_COUNT; i++) freeMergeBuffer(i);
+    }
+};
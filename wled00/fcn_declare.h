@@ -33,8 +33,11 @@ bool restoreConfig();
 bool verifyConfig();
 bool configBackupExists();
 void resetConfig();
-bool deserializeConfig(JsonObject doc, bool fromFS = false);
-bool deserializeConfigFromFS();
+bool deserializeConfig(JsonObject doc, bool fromFS = false, bool ledsCached = false);
+bool deserializeConfigFromFS(bool ledsCached = false);
+bool loadConfigCache();
+void saveConfigCache();
+void invalidateConfigCache();
 bool deserializeConfigSec();
 void serializeConfig(JsonObject doc);
 void serializeConfigToFS();
@@ -102,6 +105,9 @@ void handleDMXInput();
 //e131.cpp
 void handleE131Packet(e131_packet_t* p, IPAddress clientIP, byte protocol);
 void handleDMXData(uint16_t uni, uint16_t dmxChannels, uint8_t* e131_data, uint8_t mde, uint8_t previousUniverses);
+void handleE131FrameUniverse(uint8_t index, uint8_t* data, uint16_t channels, uint8_t mode);
+void handleE131Timeouts();
+void handleDDPFrame(const uint32_t* pixels, unsigned start, unsigned stop);
 // void handleArtnetPollReply(IPAddress ipAddress);                                          // local function, only used in e131.cpp
 // void prepareArtnetPollReply(ArtPollReply* reply);                                         // local function, only used in e131.cpp
 // void sendArtnetPollReply(ArtPollReply* reply, IPAddress ipAddress, uint16_t portAddress); // local function, only used in e131.cpp
@@ -177,7 +183,10 @@ void serializeState(JsonObject root, bool forPreset = false, bool includeBri = t
 void serializeInfo(JsonObject root);
 void serializeModeNames(JsonArray arr);
 void serializePins(JsonObject root);
+void serializeFxMem(JsonObject root);
+void serializePerf(JsonObject root);
 void serveJson(AsyncWebServerRequest* request);
+void invalidateJsonCache();
 #ifdef WLED_ENABLE_JSONLIVE
 bool serveLiveLeds(AsyncWebServerRequest* request, uint32_t wsClient = 0);
 #endif
@@ -206,6 +215,7 @@ void parseLxJson(int lxValue, byte segId, bool secondary);
 //mqtt.cpp
 bool initMqtt();
 void publishMqtt();
+void handleMqtt();
 
 //ntp.cpp
 void handleTime();
@@ -249,6 +259,8 @@ void removeTimer(size_t index);
 void clearTimers();
 size_t getTimerCount();
 void compactTimers();
+bool addCronTimer(uint8_t preset, const char* expr, bool enabled = true);
+void clearCronTimers();
 
 //overlay.cpp
 void handleOverlayDraw();
@@ -265,6 +277,7 @@ void serializePlaylist(JsonObject obj);
 //presets.cpp
 const char *getPresetsFileName(bool persistent = true);
 bool presetNeedsSaving();
+bool presetNeedsApplying();
 void initPresetsFile();
 void handlePresets();
 bool applyPreset(byte index, byte callMode = CALL_MODE_DIRECT_CHANGE);
@@ -294,6 +307,7 @@ void handleNotifications();
 void setRealtimePixel(uint16_t i, byte r, byte g, byte b, byte w);
 void refreshNodeList();
 void sendSysInfoUDP();
+uint64_t clockSyncMicros();
 #ifndef WLED_DISABLE_ESPNOW
 void espNowSentCB(uint8_t* address, uint8_t status);
 void espNowReceiveCB(uint8_t* address, uint8_t* data, uint8_t len, signed int rssi, bool broadcast);
@@ -324,7 +338,8 @@ typedef enum UM_Data_Types {
   UMT_UINT32_ARR,
   UMT_INT32_ARR,
   UMT_FLOAT_ARR,
-  UMT_DOUBLE_ARR
+  UMT_DOUBLE_ARR,
+  UMT_PTR         // pointer to an object, see the providing usermod for its type
 } um_types_t;
 typedef struct UM_Exchange_Data {
   // should just use: size_t arr_size, void **arr_ptr, byte *ptr_type
@@ -0,0 +1,152 @@
+/* fx_arena.h
+
+Effect data arena: all segment data (Segment::data) is carved from a single buffer allocated on first use instead of
+individual heap allocations (which fragment DRAM when effects change often). Enabled with -D WLED_ENABLE_FX_ARENA.
+
+Blocks are movable: each block remembers the address of its owner's pointer (Segment::data) which is updated when
+blocks are compacted, so effects must not keep pointers into their data between calls (none do, particle systems
+re-derive their pointers on each call). Released blocks are reused first fit, the arena is compacted only if a
+request fits into the total free space but not into a single hole.
+
+Every block carries a header and is padded to 8 bytes (FX_ARENA_BLOCK_OVERHEAD at most), the default size
+WLED_FX_ARENA_SIZE (FX.h) adds that headroom for two blocks per segment (effect data and transition copy) to
+MAX_SEGMENT_DATA, so everything that fits the MAX_SEGMENT_DATA limit also fits the arena.
+
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#define FX_ARENA_BLOCK_OVERHEAD (2 * sizeof(void*) + 8) // block header and alignment padding (upper bound)
+
+class EffectDataArena {
+  public:
+    explicit EffectDataArena(size_t capacity) : _capacity(capacity) {}
+    ~EffectDataArena() { if (_buffer) p_free(_buffer); }
+    EffectDataArena(const EffectDataArena&) = delete;
+    EffectDataArena& operator=(const EffectDataArena&) = delete;
+
+    // returns cleared block of len bytes or nullptr, *owner is updated when the block moves
+    uint8_t *allocate(size_t len, uint8_t **owner) {
+      if (len == 0 || !owner) return nullptr;
+      if (!_buffer) {
+        // allocated once and never freed, prefer DRAM for speed
+        _buffer = static_cast<uint8_t*>(allocate_buffer(_capacity, BFRALLOC_PREFER_DRAM));
+        if (!_buffer) return nullptr;
+        _top = _used = 0;
+      }
+      const size_t need = HDR + align(len);
+      if (_used + need > _capacity) return nullptr; // will not fit even after compaction
+
+      Block *blk = nullptr;
+      // first fit into a hole left by released blocks, merging adjacent holes on the way
+      for (size_t pos = 0; pos < _top; ) {
+        Block *b = block(pos);
+        if (!b->owner) {
+          while (pos + b->size < _top && !block(pos + b->size)->owner) b->size += block(pos + b->size)->size;
+          if (b->size >= need) { blk = b; break; }
+        }
+        pos += b->size;
+      }
+      if (blk) {
+        if (blk->size >= need + HDR + 8) { // split hole if the remainder is usable
+          Block *rest = reinterpret_cast<Block*>(reinterpret_cast<uint8_t*>(blk) + need);
+          rest->size  = blk->size - need;
+          rest->owner = nullptr;
+          blk->size   = need;
+        }
+      } else {
+        if (_top + need > _capacity) compact(); // enough free space in total but not at the end
+        blk = block(_top);
+        blk->size = need;
+        _top += need;
+      }
+      blk->owner = owner;
+      _used += blk->size;
+      uint8_t *ptr = reinterpret_cast<uint8_t*>(blk) + HDR;
+      memset(ptr, 0, blk->size - HDR);
+      return ptr;
+    }
+
+    // free block (ptr must have been returned by allocate())
+    void release(uint8_t *ptr) {
+      if (!owns(ptr)) return;
+      Block *blk = reinterpret_cast<Block*>(ptr - HDR);
+      if (!blk->owner) return; // double free
+      blk->owner = nullptr;
+      _used -= blk->size;
+      // lower the top if trailing blocks are free
+      size_t last = 0;
+      for (size_t pos = 0; pos < _top; ) {
+        const Block *b = block(pos);
+        pos += b->size;
+        if (b->owner) last = pos;
+      }
+      _top = last;
+    }
+
+    // owner moved (Segment move constructor/assignment)
+    void rebind(uint8_t *ptr, uint8_t **owner) { if (owns(ptr)) reinterpret_cast<Block*>(ptr - HDR)->owner = owner; }
+
+    // largest block that can be allocated without compaction
+    size_t largestFree() const {
+      if (!_buffer) return _capacity > HDR ? _capacity - HDR : 0;
+      size_t largest = _capacity - _top;
+      size_t hole = 0;
+      for (size_t pos = 0; pos < _top; ) {
+        const Block *b = block(pos);
+        if (b->owner) hole = 0;
+        else if ((hole += b->size) > largest) largest = hole;
+        pos += b->size;
+      }
+      return largest > HDR ? largest - HDR : 0;
+    }
+
+    inline size_t   capacity() const    { return _buffer ? _capacity : 0; }
+    inline size_t   used() const        { return _used; }   // including block headers
+    inline size_t   top() const         { return _top; }    // high water mark of allocated blocks
+    inline uint32_t compactions() const { return _compactions; }
+
+  private:
+    struct Block {
+      uint32_t  size;   // block size including header
+      uint8_t **owner;  // address of the pointer referencing this block (nullptr if block is free)
+    };
+    // blocks are 8 byte aligned (same as heap allocations)
+    static constexpr size_t align(size_t n) { return (n + 7) & ~size_t(7); }
+    static constexpr size_t HDR = (sizeof(Block) + 7) & ~size_t(7);
+
+    inline Block       *block(size_t pos)       { return reinterpret_cast<Block*>(_buffer + pos); }
+    inline const Block *block(size_t pos) const { return reinterpret_cast<const Block*>(_buffer + pos); }
+    inline bool owns(const uint8_t *ptr) const  { return _buffer && ptr >= _buffer + HDR && ptr < _buffer + _top; }
+
+    // slide all used blocks to the start of the arena and update their owners
+    // must not be called while an effect function is using a block other than its own
+    void compact() {
+      size_t dst = 0;
+      for (size_t pos = 0; pos < _top; ) {
+        Block *b = block(pos);
+        const size_t size = b->size;
+        if (b->owner) {
+          if (dst != pos) {
+            memmove(_buffer + dst, b, size);
+            b = block(dst);
+            *(b->owner) = _buffer + dst + HDR;
+          }
+          dst += size;
+        }
+        pos += size;
+      }
+      _top = dst;
+      _compactions++;
+    }
+
+    uint8_t  *_buffer = nullptr;
+    size_t    _capacity;
+    size_t    _top = 0;
+    size_t    _used = 0;
+    uint32_t  _compactions = 0;
+};
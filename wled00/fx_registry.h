@@ -0,0 +1,168 @@
+/* fx_registry.h
+
+Compile-time effect registry.
+
+Effects are registered with REGISTER_EFFECT(id, function, metadata) into a dynamic array (see dynarray.h, like
+usermods), which the linker places in flash. The metadata string ("Name@sliders;colors;palette;flags;defaults", see
+https://kno.wled.ge/interfaces/json-api/#effect-metadata) must be constexpr: it is validated by a static_assert and
+pre-parsed by the compiler into an EffectInfo (controls, colors, palette use, 1D/2D/audio flags and parameter
+defaults), so nothing is allocated or parsed at boot and WS2812FX only builds an id -> entry index (two bytes per id).
+Effects added at runtime with WS2812FX::addEffect() are parsed once by the same functions.
+
+The parser is written as C++11 constexpr (single return statement, recursion) to build with every toolchain.
+
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include "dynarray.h"
+
+#define FX_INDEX_NONE      0xFFFF  // no effect registered for an id (WS2812FX::_effectIndex)
+
+// EffectInfo::flags
+#define FX_INFO_DATA       0x01  // has metadata (after '@'), otherwise default controls are shown
+#define FX_INFO_PALETTE    0x02  // uses a palette
+#define FX_INFO_0D         0x04  // single pixel (PWM, on/off)
+#define FX_INFO_1D         0x08
+#define FX_INFO_2D         0x10
+#define FX_INFO_VOLUME     0x20  // audio reactive (volume)
+#define FX_INFO_FREQUENCY  0x40  // audio reactive (frequency)
+
+// parameter defaults of the last metadata section ("sx=24,pal=50")
+#define FX_DEFAULTS(D) \
+  D(SX,sx) D(IX,ix) D(C1,c1) D(C2,c2) D(C3,c3) D(O1,o1) D(O2,o2) D(O3,o3) \
+  D(M12,m12) D(SI,si) D(REV,rev) D(MI,mi) D(RY,rY) D(MY,mY) D(PAL,pal)
+
+enum EffectDefault : uint8_t {
+#define FX_DEF_ENUM(id, key) FX_DEF_##id,
+  FX_DEFAULTS(FX_DEF_ENUM)
+#undef FX_DEF_ENUM
+  FX_DEF_COUNT
+};
+
+struct EffectInfo {
+  uint8_t  nameLen;                 // characters before '@'
+  uint8_t  controls;                // bits 0-4: sliders sx, ix, c1, c2, c3, bits 5-7: checkboxes o1-o3 (labelled)
+  uint8_t  colors;                  // bits 0-2: color slots (labelled)
+  uint8_t  flags;                   // FX_INFO_*
+  uint16_t defined;                 // bit per FX_DEF_* with a default
+  uint8_t  defaults[FX_DEF_COUNT];
+
+  // default of a parameter, -1 if not defined (like extractModeDefaults())
+  constexpr int16_t getDefault(unsigned d) const { return d < FX_DEF_COUNT && ((defined >> d) & 1) ? defaults[d] : -1; }
+};
+
+// function and data pointers first: entries live in flash, on ESP8266 only aligned 32 bit reads are allowed there
+struct EffectEntry {
+  void      (*fcn)();
+  const char *data;                 // metadata (PROGMEM)
+  EffectInfo  info;                 // read with memcpy_P()
+  uint8_t     id;                   // 255: first free id
+};
+
+/*
+ * metadata parser
+ */
+// position behind the next c, nullptr if the string (or the field, if stop is given) ends before
+static constexpr const char* fxAfter(const char* s, char c, char stop = 0) {
+  return !s || !*s || (stop && *s == stop) ? nullptr : *s == c ? s + 1 : fxAfter(s + 1, c, stop);
+}
+static constexpr unsigned fxNameLen(const char* s) {
+  return !*s || *s == '@' ? 0 : 1 + fxNameLen(s + 1);
+}
+static constexpr const char* fxNextSection(const char* s, unsigned n) {
+  return !s || !n ? s : fxNextSection(fxAfter(s, ';'), n - 1);
+}
+// start of metadata section n (0: sliders, 1: colors, 2: palette, 3: flags, 4: defaults), nullptr if not given
+static constexpr const char* fxSection(const char* s, unsigned n) {
+  return fxNextSection(fxAfter(s, '@'), n);
+}
+// start of comma separated field k of a section, nullptr if not given
+static constexpr const char* fxField(const char* sec, unsigned k) {
+  return !sec || !k ? sec : fxField(fxAfter(sec, ',', ';'), k - 1);
+}
+static constexpr bool fxEmpty(const char* p) {
+  return !p || !*p || *p == ',' || *p == ';';
+}
+static constexpr unsigned fxLabels(const char* sec, unsigned k, unsigned n) {
+  return k >= n ? 0 : (fxEmpty(fxField(sec, k)) ? 0 : 1U << k) | fxLabels(sec, k + 1, n);
+}
+static constexpr bool fxHasFlag(const char* p, char c) {
+  return p && *p && *p != ';' && (*p == c || fxHasFlag(p + 1, c));
+}
+static constexpr bool fxIsDigit(char c) {
+  return c >= '0' && c <= '9';
+}
+static constexpr unsigned fxNumber(const char* p, unsigned v = 0) {
+  return fxIsDigit(*p) && v < 1000 ? fxNumber(p + 1, v * 10 + (*p - '0')) : v;
+}
+static constexpr const char* fxSkipDigits(const char* p) {
+  return fxIsDigit(*p) ? fxSkipDigits(p + 1) : p;
+}
+// p points to "key=" (returns the position of the value) or not (nullptr)
+static constexpr const char* fxKey(const char* p, const char* key) {
+  return !*key ? (*p == '=' ? p + 1 : nullptr) : *p == *key ? fxKey(p + 1, key + 1) : nullptr;
+}
+// value of key in the defaults section, nullptr if not given
+static constexpr const char* fxFind(const char* p, const char* key) {
+  return !p ? nullptr : fxKey(p, key) ? fxKey(p, key) : fxFind(fxAfter(p, ',', ';'), key);
+}
+
+static constexpr uint8_t fxFlags(const char* s) {
+  return !fxAfter(s, '@') ? FX_INFO_PALETTE | FX_INFO_1D : // no metadata: UI uses ";;!;1"
+    FX_INFO_DATA
+    | (!fxEmpty(fxSection(s, 2)) && !fxIsDigit(*fxSection(s, 2)) ? FX_INFO_PALETTE : 0)
+    | (fxHasFlag(fxSection(s, 3), '0') ? FX_INFO_0D : 0)
+    | (fxHasFlag(fxSection(s, 3), '1') || fxEmpty(fxSection(s, 3)) ? FX_INFO_1D : 0)
+    | (fxHasFlag(fxSection(s, 3), '2') ? FX_INFO_2D : 0)
+    | (fxHasFlag(fxSection(s, 3), 'v') ? FX_INFO_VOLUME : 0)
+    | (fxHasFlag(fxSection(s, 3), 'f') ? FX_INFO_FREQUENCY : 0);
+}
+
+// pre-parsed metadata (s must be in RAM or constexpr)
+static constexpr EffectInfo fxParse(const char* s) {
+#define FX_DEF_MASK(id, key)  | (fxFind(fxSection(s, 4), #key) ? 1U << FX_DEF_##id : 0)
+#define FX_DEF_VALUE(id, key) uint8_t(fxFind(fxSection(s, 4), #key) ? fxNumber(fxFind(fxSection(s, 4), #key)) : 0),
+  return EffectInfo{
+    uint8_t(fxNameLen(s)),
+    uint8_t(fxSection(s, 1) ? fxLabels(fxSection(s, 0), 0, 8) : 0x03), // no (complete) slider section: speed, intensity
+    uint8_t(fxLabels(fxSection(s, 1), 0, 3)),
+    fxFlags(s),
+    uint16_t(0 FX_DEFAULTS(FX_DEF_MASK)),
+    { FX_DEFAULTS(FX_DEF_VALUE) }
+  };
+#undef FX_DEF_MASK
+#undef FX_DEF_VALUE
+}
+
+/*
+ * metadata validation (compile time)
+ */
+static constexpr bool fxValidFlags(const char* p) {
+  return !p || !*p || *p == ';' ||
+    ((*p == '0' || *p == '1' || *p == '2' || *p == 'v' || *p == 'f') && fxValidFlags(p + 1));
+}
+static constexpr bool fxValidValue(const char* v) {
+  return v && fxIsDigit(*v) && fxNumber(v) <= 255 && (!*fxSkipDigits(v) || *fxSkipDigits(v) == ',');
+}
+// every field of the defaults section is "key=0..255" with a known key (empty section allowed)
+static constexpr bool fxValidDefaults(const char* p) {
+#define FX_DEF_KEY(id, key) fxKey(p, #key) ? fxKey(p, #key) :
+  return !p || !*p || (fxValidValue(FX_DEFAULTS(FX_DEF_KEY) nullptr) && fxValidDefaults(fxAfter(p, ',')));
+#undef FX_DEF_KEY
+}
+static constexpr bool fxValid(const char* s) {
+  return fxNameLen(s) > 0 && fxNameLen(s) < 64
+    && !fxSection(s, 5)              // at most 5 sections
+    && !fxField(fxSection(s, 0), 8)  // 5 sliders, 3 checkboxes
+    && !fxField(fxSection(s, 1), 3)  // 3 colors
+    && fxValidFlags(fxSection(s, 3))
+    && fxValidDefaults(fxSection(s, 4));
+}
+
+// register an effect with constexpr metadata, id 255 takes the first free id (usermods)
+// the explicit alignment keeps the compiler from over-aligning entries, they must be contiguous like an array
+#define REGISTER_EFFECT(id, fcn, data) \
+  static_assert(fxValid(data), "invalid effect metadata: " #data); \
+  DYNARRAY_MEMBER(EffectEntry, effects, fx_##fcn, 1) __attribute__((aligned(alignof(EffectEntry)))) = { &fcn, data, fxParse(data), id }
@@ -0,0 +1,284 @@
+/* gzip_writer.h
+
+Streaming gzip (RFC 1952) compressor for responses generated on the device.
+
+Input is compressed with LZ77 over a sliding window (hash chains, greedy matching) into a single deflate block with
+the fixed Huffman code of RFC 1951. That is good for the 3-5x typical of JSON and needs no code tables, only a
+temporary window of 2*GZIP_WINDOW bytes and 2*GZIP_WINDOW + 2*2^GZIP_HASH_BITS bytes of hash chains, which are freed
+by finish(). write() has the signature ArduinoJson expects of a custom writer, so serializeJson(doc, gzipWriter) works.
+The output is collected in one growing buffer (p_malloc), its ownership can be taken with release().
+
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#ifndef GZIP_WINDOW
+  #ifdef ESP8266
+    #define GZIP_WINDOW      1024   // bytes of history matches may refer to (power of 2)
+    #define GZIP_HASH_BITS   10
+  #else
+    #define GZIP_WINDOW      4096
+    #define GZIP_HASH_BITS   12
+  #endif
+#endif
+#ifndef GZIP_CHAIN
+  #define GZIP_CHAIN         16     // match candidates tried per position
+#endif
+#define GZIP_MIN_MATCH       3
+#define GZIP_MAX_MATCH       258
+#define GZIP_MIN_LOOKAHEAD   (GZIP_MAX_MATCH + GZIP_MIN_MATCH + 1)
+#define GZIP_MAX_DIST        (GZIP_WINDOW - GZIP_MIN_LOOKAHEAD)
+#define GZIP_OUT_CHUNK       512    // output buffer growth
+
+class GzipWriter {
+  public:
+    GzipWriter() {}
+    ~GzipWriter() { end(); }
+    GzipWriter(const GzipWriter&) = delete;
+    GzipWriter& operator=(const GzipWriter&) = delete;
+
+    // start a new stream, output is limited to maxSize bytes (the stream fails if it grows larger)
+    bool begin(size_t maxSize = SIZE_MAX) {
+      end();
+      _win  = (uint8_t*)p_malloc(2 * GZIP_WINDOW);
+      _prev = (uint16_t*)p_malloc(GZIP_WINDOW * sizeof(uint16_t));
+      _head = (uint16_t*)p_malloc((1U << GZIP_HASH_BITS) * sizeof(uint16_t));
+      if (!_win || !_prev || !_head) {
+        end();
+        _failed = true;
+        return false;
+      }
+      memset(_head, 0, (1U << GZIP_HASH_BITS) * sizeof(uint16_t));
+      _maxSize = maxSize;
+      static const uint8_t header[10] = {0x1F, 0x8B, 8, 0, 0, 0, 0, 0, 0, 0xFF}; // deflate, no name, unknown OS
+      for (unsigned i = 0; i < sizeof(header); i++) putByte(header[i]);
+      putBits(1, 1); // last block
+      putBits(1, 2); // fixed Huffman code
+      return !_failed;
+    }
+
+    // free window and output
+    void end() {
+      freeWindow();
+      if (_out) p_free(_out);
+      _out = nullptr;
+      _len = _cap = 0;
+      _fill = _pos = 0;
+      _bits = _bitCount = 0;
+      _crc = 0xFFFFFFFF;
+      _in = 0;
+      _failed = false;
+    }
+
+    inline size_t write(uint8_t c) { return write(&c, 1); }
+
+    // after a failure (output limit) input is only counted, crc() and inputSize() stay valid
+    size_t write(const uint8_t* s, size_t n) {
+      if (!_win) return 0;
+      for (size_t i = 0; i < n; i++) {
+        _crc = crcByte(_crc, s[i]);
+        if (_failed) continue;
+        if (_fill == 2 * GZIP_WINDOW) slide();
+        _win[_fill++] = s[i];
+        if (_fill - _pos >= GZIP_MIN_LOOKAHEAD) compress(false);
+      }
+      _in += n;
+      return n;
+    }
+
+    // compress the remaining input and write the trailer, frees the window
+    bool finish() {
+      if (!_win) return false;
+      if (_failed) {
+        freeWindow();
+        return false;
+      }
+      compress(true);
+      putSymbol(256); // end of block
+      if (_bitCount) putByte(_bits);
+      _bits = _bitCount = 0;
+      const uint32_t crc = ~_crc;
+      for (unsigned i = 0; i < 4; i++) putByte(crc >> (8*i));
+      for (unsigned i = 0; i < 4; i++) putByte(_in >> (8*i));
+      freeWindow();
+      return !_failed;
+    }
+
+    // take ownership of the output (free with p_free())
+    uint8_t* release() {
+      uint8_t* out = _out;
+      _out = nullptr;
+      _cap = 0;
+      return out;
+    }
+
+    inline const uint8_t* data() const { return _out; }
+    inline size_t   size() const       { return _len; }
+    inline uint32_t inputSize() const  { return _in; }
+    inline uint32_t crc() const        { return ~_crc; } // CRC32 of the input so far
+    inline bool     failed() const     { return _failed; }
+
+  private:
+    uint8_t*  _win  = nullptr;  // 2 windows of input, matches are searched in the first
+    uint16_t* _prev = nullptr;  // previous position with the same hash, per position in the window
+    uint16_t* _head = nullptr;  // last position per hash (0 = none)
+    uint8_t*  _out  = nullptr;
+    size_t    _len = 0, _cap = 0, _maxSize = SIZE_MAX;
+    unsigned  _fill = 0;        // bytes in window
+    unsigned  _pos = 0;         // next byte to compress
+    uint32_t  _bits = 0;
+    unsigned  _bitCount = 0;
+    uint32_t  _crc = 0xFFFFFFFF;
+    uint32_t  _in = 0;
+    bool      _failed = false;
+
+    void freeWindow() {
+      if (_win)  p_free(_win);
+      if (_prev) p_free(_prev);
+      if (_head) p_free(_head);
+      _win = nullptr;
+      _prev = _head = nullptr;
+    }
+
+    static uint32_t crcByte(uint32_t crc, uint8_t b) {
+      static const uint32_t table[16] = {
+        0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+        0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C, 0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C
+      };
+      crc ^= b;
+      crc = (crc >> 4) ^ table[crc & 0x0F];
+      crc = (crc >> 4) ^ table[crc & 0x0F];
+      return crc;
+    }
+
+    inline unsigned hash(unsigned p) const {
+      return ((_win[p] << 10) ^ (_win[p+1] << 5) ^ _win[p+2]) & ((1U << GZIP_HASH_BITS) - 1);
+    }
+
+    inline void insert(unsigned p) {
+      const unsigned h = hash(p);
+      _prev[p & (GZIP_WINDOW - 1)] = _head[h];
+      _head[h] = p;
+    }
+
+    // move the second window down, positions that leave the window become 0 (none)
+    void slide() {
+      memmove(_win, _win + GZIP_WINDOW, GZIP_WINDOW);
+      _fill -= GZIP_WINDOW;
+      _pos  -= GZIP_WINDOW;
+      for (unsigned i = 0; i < (1U << GZIP_HASH_BITS); i++) _head[i] = _head[i] >= GZIP_WINDOW ? _head[i] - GZIP_WINDOW : 0;
+      for (unsigned i = 0; i < GZIP_WINDOW; i++)            _prev[i] = _prev[i] >= GZIP_WINDOW ? _prev[i] - GZIP_WINDOW : 0;
+    }
+
+    void compress(bool flush) {
+      while (_pos < _fill) {
+        const unsigned avail = _fill - _pos;
+        if (!flush && avail < GZIP_MIN_LOOKAHEAD) return;
+        unsigned len = 0, dist = 0;
+        if (avail >= GZIP_MIN_MATCH) {
+          const unsigned h = hash(_pos);
+          unsigned cand = _head[h];
+          _prev[_pos & (GZIP_WINDOW - 1)] = cand;
+          _head[h] = _pos;
+          const unsigned maxLen = avail < GZIP_MAX_MATCH ? avail : GZIP_MAX_MATCH;
+          for (unsigned chain = GZIP_CHAIN; cand && _pos - cand <= GZIP_MAX_DIST && chain; chain--) {
+            if (_win[cand + len] == _win[_pos + len]) {
+              unsigned l = 0;
+              while (l < maxLen && _win[cand + l] == _win[_pos + l]) l++;
+              if (l > len) {
+                len  = l;
+                dist = _pos - cand;
+                if (l == maxLen) break;
+              }
+            }
+            cand = _prev[cand & (GZIP_WINDOW - 1)];
+          }
+        }
+        if (len >= GZIP_MIN_MATCH) {
+          putLength(len);
+          putDistance(dist);
+          for (unsigned k = 1; k < len; k++) if (_pos + k + GZIP_MIN_MATCH <= _fill) insert(_pos + k);
+          _pos += len;
+        } else {
+          putSymbol(_win[_pos++]);
+        }
+      }
+    }
+
+    void putByte(uint8_t b) {
+      if (_failed) return;
+      if (_len >= _maxSize) {
+        _failed = true;
+        return;
+      }
+      if (_len == _cap) {
+        uint8_t* out = (uint8_t*)p_malloc(_cap + GZIP_OUT_CHUNK);
+        if (!out) {
+          _failed = true;
+          return;
+        }
+        if (_out) {
+          memcpy(out, _out, _len);
+          p_free(_out);
+        }
+        _out = out;
+        _cap += GZIP_OUT_CHUNK;
+      }
+      _out[_len++] = b;
+    }
+
+    inline void putBits(uint32_t v, unsigned n) {
+      _bits |= v << _bitCount;
+      _bitCount += n;
+      while (_bitCount >= 8) {
+        putByte(_bits);
+        _bits >>= 8;
+        _bitCount -= 8;
+      }
+    }
+
+    // Huffman codes are sent most significant bit first
+    inline void putCode(uint32_t code, unsigned n) {
+      uint32_t r = 0;
+      for (unsigned i = 0; i < n; i++, code >>= 1) r = (r << 1) | (code & 1);
+      putBits(r, n);
+    }
+
+    // literal/length symbol of the fixed code
+    void putSymbol(unsigned s) {
+      if      (s < 144) putCode(0x30  + s,         8);
+      else if (s < 256) putCode(0x190 + s - 144,   9);
+      else if (s < 280) putCode(s - 256,           7);
+      else              putCode(0xC0  + s - 280,   8);
+    }
+
+    void putLength(unsigned len) {
+      if (len == GZIP_MAX_MATCH) {
+        putSymbol(285);
+        return;
+      }
+      const unsigned n = len - 3;
+      if (n < 8) {
+        putSymbol(257 + n);
+        return;
+      }
+      const unsigned e = 29 - __builtin_clz(n); // extra bits: floor(log2(n)) - 2
+      putSymbol(257 + 4*e + 4 + ((n >> e) & 3));
+      putBits(n & ((1U << e) - 1), e);
+    }
+
+    void putDistance(unsigned dist) {
+      const unsigned n = dist - 1;
+      if (n < 4) {
+        putCode(n, 5);
+        return;
+      }
+      const unsigned e = 30 - __builtin_clz(n); // extra bits: floor(log2(n)) - 1
+      putCode(2*e + 2 + ((n >> e) & 1), 5);
+      putBits(n & ((1U << e) - 1), e);
+    }
+};
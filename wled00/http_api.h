@@ -0,0 +1,101 @@
+/* http_api.h
+
+Single pass tokenizer of the HTTP API (handleSet() in set.cpp).
+
+The request is split at "&" once, each parameter name is looked up by binary search in a sorted table of packed
+names, and a pointer to the value of its first occurrence is kept. Values point into the original request, so
+numbers are parsed up to the next parameter like before. Needs byte and parseNumber() (fcn_declare.h).
+
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+// HTTP API parameters, sorted by name (ASCII), F: parameter may be given without "=" (flag)
+#define HTTP_API_KEYS \
+  K(A,0)  K(B,0)  K(B2,0) K(C2,0) K(C3,0) K(CL,0) K(CT,0) K(FP,0) K(FX,0) K(FXD,0) \
+  K(G,0)  K(G2,0) K(GP,0) K(HU,0) K(IN,1) K(IX,0) K(K,0)  K(LO,0)  K(LX,0)  \
+  K(LY,0) K(M,0)  K(M1,0) K(M2,0) K(M3,0) K(MI,0) K(ND,1) K(NF,0) K(NL,0)  \
+  K(NM,0) K(NN,1) K(NP,1) K(NT,0) K(OL,0) K(P1,0) K(P2,0) K(PL,0) K(PS,0) K(R,0)   \
+  K(R2,0) K(RB,1) K(RD,0) K(RN,0) K(RV,0) K(S,0)  K(S2,0) K(SA,0) K(SB,0) K(SC,1)  \
+  K(SM,0) K(SN,0) K(SP,0) K(SR,1) K(SS,0) K(ST,0) K(SV,0) K(SW,0) K(SX,0) K(T,0)   \
+  K(TT,0) K(U0,0) K(U1,0) K(W,0)  K(W2,0) K(X1,0) K(X2,0) K(X3,0)
+
+// parameter names of up to 3 characters packed into 24 bits (big endian), numeric order equals ASCII order
+static constexpr uint32_t apiKeyCode(const char* k) {
+  return (uint32_t(uint8_t(k[0])) << 16) | (k[0] ? (uint32_t(uint8_t(k[1])) << 8) | (k[1] ? uint8_t(k[2]) : 0) : 0);
+}
+
+enum HttpApiKey : uint8_t {
+#define K(name, flag) API_##name,
+  HTTP_API_KEYS
+#undef K
+  API_KEY_COUNT
+};
+
+static constexpr uint32_t API_FLAG = 0x80000000UL;
+static constexpr uint32_t apiKeys[API_KEY_COUNT] PROGMEM = {
+#define K(name, flag) apiKeyCode(#name) | (flag ? API_FLAG : 0),
+  HTTP_API_KEYS
+#undef K
+};
+
+static constexpr bool apiKeysSorted(unsigned i = 1) {
+  return i >= API_KEY_COUNT || ((apiKeys[i-1] & ~API_FLAG) < (apiKeys[i] & ~API_FLAG) && apiKeysSorted(i+1));
+}
+static_assert(apiKeysSorted(), "HTTP_API_KEYS must be sorted");
+
+// tokenizes an HTTP API request ("win&A=128&FX=5...") in a single pass
+// value(key) points to the value of the first occurrence of a parameter (into the request, so numbers can be parsed
+// up to the next parameter like before), for flags without "=" it points to the end of the name, nullptr if not given
+class HttpApiParams {
+  public:
+    explicit HttpApiParams(const char* req) {
+      memset(_value, 0, sizeof(_value));
+      const char* p = strchr(req, '&'); // everything before the first "&" is the path ("win")
+      while (p) {
+        const char* key = ++p;
+        while (*p && *p != '=' && *p != '&') p++;
+        const unsigned len = p - key;
+        if (len > 0 && len <= 3) {
+          char name[4] = {0};
+          memcpy(name, key, len);
+          const int k = find(apiKeyCode(name));
+          if (k >= 0 && !_value[k] && (*p == '=' || (pgm_read_dword(apiKeys + k) & API_FLAG))) {
+            _value[k] = *p == '=' ? p + 1 : p;
+          }
+        }
+        p = strchr(p, '&');
+      }
+    }
+
+    inline const char* value(HttpApiKey key) const { return _value[key]; }
+    inline bool        has(HttpApiKey key) const   { return _value[key] != nullptr; }
+    inline int         num(HttpApiKey key) const   { return atoi(_value[key]); }
+    inline bool        isNonZero(HttpApiKey key) const { return _value[key][0] != '0'; }
+
+    // like updateVal(): parse value into val, supports ~ in/decrementing and r(andom)
+    bool update(HttpApiKey key, byte &val, byte minv=0, byte maxv=255) const {
+      if (!_value[key]) return false;
+      parseNumber(_value[key], val, minv, maxv);
+      return true;
+    }
+
+  private:
+    const char* _value[API_KEY_COUNT];
+
+    static int find(uint32_t code) {
+      int lo = 0, hi = API_KEY_COUNT - 1;
+      while (lo <= hi) {
+        const int mid = (lo + hi) / 2;
+        const uint32_t c = pgm_read_dword(apiKeys + mid) & ~API_FLAG;
+        if (c == code) return mid;
+        if (c < code) lo = mid + 1;
+        else          hi = mid - 1;
+      }
+      return -1;
+    }
+};
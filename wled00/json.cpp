@@ -403,6 +403,7 @@ bool deserializeState(JsonObject root, byte callMode, byte presetId)
 
   blendingStyle = root[F("bs")] | blendingStyle;
   blendingStyle &= 0x1F;
+  transitionSnapshot = root[F("ts")] | false; // only for transitions started by this request (cleared below)
 
   // temporary transition (applies only once)
   tr = root[F("tt")] | -1;
@@ -503,6 +504,7 @@ bool deserializeState(JsonObject root, byte callMode, byte presetId)
     apireq += httpwin;
     handleSet(nullptr, apireq, false);    // may set stateChanged
   }
+  transitionSnapshot = false;
 
   // Applying preset from JSON API has 2 cases: a) "pd" AKA "preset direct" and b) "ps" AKA "preset select"
   // a) "preset direct" can only be an integer value representing preset ID. "preset direct" assumes JSON API contains the rest of preset content (i.e. from UI call)
@@ -690,6 +692,19 @@ void serializeState(JsonObject root, bool forPreset, bool includeBri, bool segme
 }
 
 
+// run count, deferrals, average and maximum time (us) and histogram (see loop_scheduler.h) without trailing empty buckets
+static void serializeLoopTiming(JsonObject obj, const LoopScheduler::Timing &t)
+{
+  obj["n"] = t.runs;
+  if (t.deferred) obj["d"] = t.deferred;
+  obj[F("avg")] = t.avg;
+  obj[F("max")] = t.max;
+  unsigned buckets = LOOP_HIST_BUCKETS;
+  while (buckets > 1 && !t.hist[buckets-1]) buckets--;
+  JsonArray hist = obj.createNestedArray("h");
+  for (unsigned b = 0; b < buckets; b++) hist.add(t.hist[b]);
+}
+
 void serializeInfo(JsonObject root)
 {
   root[F("ver")] = versionString;
@@ -766,6 +781,64 @@ void serializeInfo(JsonObject root)
 
   root[F("lip")] = realtimeIP[0] == 0 ? "" : realtimeIP.toString();
 
+  JsonObject bootinfo = root.createNestedObject(F("boot"));
+  bootinfo[F("frame")] = bootFirstFrame; // ms from power on to first frame with the restored state
+  bootinfo[F("snap")]  = cfgCacheUsed;   // LEDs configured from binary config snapshot
+
+  JsonObject loopinfo = root.createNestedObject(F("loop"));
+  loopinfo[F("frames")] = loopScheduler.stats.frames;
+  loopinfo[F("late")]   = loopScheduler.stats.late;   // frames started after their deadline
+  serializeLoopTiming(loopinfo, loopScheduler.stats.loop);
+  JsonObject tasks = loopinfo.createNestedObject(F("tasks"));
+  #define LOOP_TASK_NAME(id, name, prio) name "\0"
+  const char *name = PSTR(LOOP_TASKS(LOOP_TASK_NAME));
+  #undef LOOP_TASK_NAME
+  for (unsigned i = 0; i < LOOP_TASK_COUNT; i++, name += strlen_P(name) + 1) {
+    const LoopScheduler::Timing &t = loopScheduler.timing(i);
+    if (t.runs || t.deferred) serializeLoopTiming(tasks.createNestedObject(FPSTR(name)), t);
+  }
+
+  if (clockSyncLeader != IPAddress()) {
+    const uint64_t now = clockSyncMicros();
+    JsonObject csinfo = root.createNestedObject(F("csync"));
+    csinfo[F("leader")] = clockSyncLeader.toString();
+    csinfo[F("synced")] = clockSync.isSynced(now);
+    csinfo[F("offset")] = (int32_t)(clockSync.getOffset(now) / 1000); // ms
+    csinfo[F("skew")]   = clockSync.getSkew() * 1e6f;                 // ppm
+    csinfo[F("delay")]  = clockSync.getDelay();                       // us
+    csinfo[F("steps")]  = clockSync.stats.steps;
+  }
+
+  if (ddpFrames.isActive()) {
+    JsonObject ddpinfo = root.createNestedObject(F("ddp"));
+    ddpinfo[F("depth")]   = ddpFrames.getDepth();
+    ddpinfo[F("frames")]  = ddpFrames.stats.presented;
+    ddpinfo[F("late")]    = ddpFrames.stats.late;
+    ddpinfo[F("dropped")] = ddpFrames.stats.dropped;
+    ddpinfo[F("dup")]     = ddpFrames.stats.duplicates;
+    ddpinfo[F("clamped")] = ddpFrames.stats.clamped;
+  }
+
+  if (e131Frames.isActive() || e131Sources.getSourceCount(0)) {
+    JsonObject e131info = root.createNestedObject(F("e131"));
+    if (e131Frames.isActive()) {
+      e131info[F("uni")]     = e131Frames.getUniverses();
+      e131info[F("sync")]    = e131Frames.synchronized(millis());
+      e131info[F("frames")]  = e131Frames.stats.frames;
+      e131info[F("partial")] = e131Frames.stats.partialFrames;
+      e131info[F("ooo")]     = e131Frames.stats.outOfOrder;
+      e131info[F("dropped")] = e131Frames.stats.droppedUniverses;
+      e131info[F("syncpkt")] = e131Frames.stats.syncPackets;
+    }
+    e131info[F("src")]     = e131Sources.getSourceCount(0); // senders of first universe
+    e131info[F("prio")]    = e131Sources.getPriority(0);
+    e131info[F("srclost")] = e131Sources.stats.sourcesLost;
+    e131info[F("srcterm")] = e131Sources.stats.sourcesTerminated;
+    e131info[F("srcrej")]  = e131Sources.stats.rejected;
+    e131info[F("late")]    = e131Sources.stats.late;
+    e131info[F("htpovf")]  = e131Sources.stats.htpOverflow;
+  }
+
   #ifdef WLED_ENABLE_WEBSOCKETS
   root[F("ws")] = ws.count();
   #else
@@ -1047,6 +1120,73 @@ void serializeNodes(JsonObject root)
   }
 }
 
+#ifndef WLED_DISABLE_RENDER_PROFILE
+// min/avg/max of the last complete window and number of samples of one profiled series
+static void serializePerfStat(JsonObject obj, const RenderProfiler::Stat &stat)
+{
+  obj[F("min")] = stat.min;
+  obj[F("avg")] = stat.avg;
+  obj[F("max")] = stat.max;
+  obj["n"]      = stat.samples;
+}
+
+// render times (us) per stage and per segment (see render_profile.h)
+void serializePerf(JsonObject root)
+{
+  root[F("fps")] = strip.getFps();
+  root[F("win")] = RENDER_PROFILE_WINDOW;
+  static const char stageNames[] PROGMEM = "fx\0blend\0ovl\0paint\0bus\0frame\0layer";
+  const char *name = stageNames;
+  JsonObject stages = root.createNestedObject(F("stages"));
+  for (unsigned i = 0; i < RENDER_STAGES; i++, name += strlen_P(name) + 1) {
+    if (renderProfiler.stage(i).samples) serializePerfStat(stages.createNestedObject(FPSTR(name)), renderProfiler.stage(i));
+  }
+  JsonArray segs = root.createNestedArray("seg");
+  for (size_t s = 0; s < strip.getSegmentsNum() && s < RENDER_PROFILE_SEGMENTS; s++) {
+    const Segment &seg = strip.getSegment(s);
+    if (!seg.isActive() || renderProfiler.segmentMode(s) != seg.mode) continue; // not rendered since the effect changed
+    JsonObject segObj = segs.createNestedObject();
+    segObj["id"] = s;
+    segObj["fx"] = seg.mode;
+    if (renderProfiler.segment(s, RENDER_SEG_EFFECT).samples) serializePerfStat(segObj.createNestedObject(F("run")),   renderProfiler.segment(s, RENDER_SEG_EFFECT));
+    if (renderProfiler.segment(s, RENDER_SEG_BLEND).samples)  serializePerfStat(segObj.createNestedObject(F("blend")), renderProfiler.segment(s, RENDER_SEG_BLEND));
+  }
+}
+#endif
+
+// effect data memory usage and fragmentation statistics (/json/fxmem)
+void serializeFxMem(JsonObject root)
+{
+  root[F("used")]  = Segment::getUsedSegmentData();
+  #ifndef BOARD_HAS_PSRAM
+  root[F("max")]   = MAX_SEGMENT_DATA;
+  #else
+  root[F("max")]   = 0; // no limit if PSRAM is available
+  #endif
+  root[F("fails")] = Segment::getDataAllocFails();
+
+  JsonArray segs = root.createNestedArray("seg");
+  for (size_t s = 0; s < strip.getSegmentsNum(); s++) segs.add(strip.getSegment(s).dataSize());
+
+  #ifdef WLED_ENABLE_FX_ARENA
+  JsonObject arena = root.createNestedObject(F("arena"));
+  const size_t capacity = fxArena.capacity();
+  const size_t largest  = fxArena.largestFree();
+  arena[F("size")]    = capacity;
+  arena[F("used")]    = fxArena.used();
+  arena[F("top")]     = fxArena.top();
+  arena[F("maxblk")]  = largest;
+  arena[F("compact")] = fxArena.compactions();
+  // fragmentation in % (0 = all free space is available as a single block)
+  const size_t avail = capacity > fxArena.used() ? capacity - fxArena.used() : 0;
+  arena[F("frag")]    = avail > largest ? 100 - (largest * 100) / avail : 0;
+  #else
+  JsonObject heap = root.createNestedObject(F("heap"));
+  heap[F("free")]   = getFreeHeapSize();
+  heap[F("maxblk")] = getContiguousFreeHeap();
+  #endif
+}
+
 void serializePins(JsonObject root)
 {
   JsonArray pins = root.createNestedArray(F("pins"));
@@ -1213,14 +1353,33 @@ static size_t writeJSONStringElement(uint8_t* dest, size_t maxLen, const char* s
   return 1 + n;
 }
 
+// Writes the mode data array (same content as respondModeData()) to a stream (GzipWriter)
+template<typename T> static void writeModeData(T& out) {
+  char lineBuffer[256];
+  uint8_t element[2*sizeof(lineBuffer)+3]; // worst case: every character escaped
+  bool first = true;
+  out.write('[');
+  for (size_t fx_index = 0; fx_index < strip.getModeCount(); fx_index++) {
+    strncpy_P(lineBuffer, strip.getModeData(fx_index), sizeof(lineBuffer)-1);
+    if (lineBuffer[0] == 0) continue;
+    lineBuffer[sizeof(lineBuffer)-1] = '\0';
+    const char* dataPtr = strchr(lineBuffer,'@');
+    size_t len = writeJSONStringElement(element, sizeof(element), dataPtr ? dataPtr + 1 : "");
+    if (first) out.write(element + 1, len - 1); // skip comma
+    else       out.write(element, len);
+    first = false;
+  }
+  out.write(']');
+}
+
 // Generate a streamed JSON response for the mode data
 // This uses sendChunked to send the reply in blocks based on how much fit in the outbound
 // packet buffer, minimizing the required state (ie. just the next index to send).  This
 // allows us to send an arbitrarily large response without using any significant amount of
 // memory (so no worries about buffer limits).
-void respondModeData(AsyncWebServerRequest* request) {
+void respondModeData(AsyncWebServerRequest* request, const char* etag) {
   size_t fx_index = 0;
-  request->sendChunked(FPSTR(CONTENT_TYPE_JSON),
+  AsyncWebServerResponse *response = request->beginChunkedResponse(FPSTR(CONTENT_TYPE_JSON),
     [fx_index](uint8_t* data, size_t len, size_t) mutable {
       size_t bytes_written = 0;
       char lineBuffer[256];
@@ -1247,6 +1406,118 @@ void respondModeData(AsyncWebServerRequest* request) {
 
       return bytes_written;
   });
+  if (etag && etag[0]) response->addHeader(F("ETag"), etag);
+  request->send(response);
+}
+
+/*
+ * Cache of the /json/eff, /json/fxdata and /json/palx responses
+ * They only change with the firmware, usermods (added effects) or custom palettes. Each is generated once into a gzip
+ * compressed buffer, its strong ETag is derived from the uncompressed content (CRC32 and length). A conditional request
+ * with a matching ETag is answered with 304 before any work is done or the JSON buffer is locked.
+ * Clients that do not accept gzip get freshly generated responses (with the ETag once it is known).
+ */
+#define JSON_CACHE_EFF     0
+#define JSON_CACHE_FXDATA  1
+#define JSON_CACHE_PALX    2  // + page
+#define JSON_CACHE_ENTRIES (JSON_CACHE_PALX + (FIXED_PALETTE_COUNT + WLED_MAX_CUSTOM_PALETTES) / 5 + 1)
+#ifndef JSON_CACHE_SIZE
+  #ifdef ESP8266
+    #define JSON_CACHE_SIZE 12288 // bytes of compressed responses kept in RAM
+  #else
+    #define JSON_CACHE_SIZE 65536
+  #endif
+#endif
+
+struct JsonCacheEntry {
+  std::shared_ptr<uint8_t> gz; // compressed response, shared with responses in flight
+  uint32_t size;               // compressed size
+  uint32_t crc;                // of the uncompressed response
+  uint32_t length;             // uncompressed size (0 = unknown)
+  uint32_t stamp;              // jsonCacheStamp() when generated
+};
+static JsonCacheEntry jsonCache[JSON_CACHE_ENTRIES];
+static uint16_t jsonCacheGeneration = 0;
+
+// invalidates the cache (custom palettes changed)
+void invalidateJsonCache() {
+  jsonCacheGeneration++;
+}
+
+static uint32_t jsonCacheStamp() {
+  return (uint32_t(jsonCacheGeneration) << 16 | uint32_t(cacheInvalidate) << 8 | strip.getModeCount()) + 1; // never 0
+}
+
+static void formatJsonCacheEtag(char* etag, const JsonCacheEntry& e) {
+  if (e.length) sprintf_P(etag, PSTR("\"%08x-%x\""), (unsigned)e.crc, (unsigned)e.length);
+  else etag[0] = 0;
+}
+
+// returns false if the request has to be answered with a freshly generated response (etag is set if known)
+static bool serveJsonCached(AsyncWebServerRequest* request, unsigned id, int page, char* etag) {
+  etag[0] = 0;
+  if (id == JSON_CACHE_PALX) {
+    if (page < 0) return false;
+    id += page;
+  }
+  if (id >= JSON_CACHE_ENTRIES) return false;
+  JsonCacheEntry& e = jsonCache[id];
+  const uint32_t stamp = jsonCacheStamp();
+  const AsyncWebHeader* encoding = request->getHeader(F("Accept-Encoding"));
+  const bool gzip = encoding && encoding->value().indexOf(F("gzip")) >= 0;
+
+  if (e.stamp != stamp) {
+    e = {}; // drop outdated response
+    if (!gzip) return false;
+    size_t used = 0;
+    for (const auto& c : jsonCache) if (c.stamp == stamp) used += c.size;
+    GzipWriter gz;
+    if (!gz.begin(used < JSON_CACHE_SIZE ? JSON_CACHE_SIZE - used : 0)) return false;
+    if (id == JSON_CACHE_FXDATA) writeModeData(gz);
+    else {
+      if (!requestJSONBufferLock(JSON_LOCK_SERVEJSON)) {
+        request->deferResponse();
+        return true;
+      }
+      pDoc->clear();
+      if (id == JSON_CACHE_EFF) serializeModeNames(pDoc->to<JsonArray>());
+      else                      serializePalettes(pDoc->to<JsonObject>(), page);
+      serializeJson(*pDoc, gz);
+      releaseJSONBufferLock();
+    }
+    if (gz.finish()) {
+      e.size = gz.size();
+      e.gz   = std::shared_ptr<uint8_t>(gz.release(), [](uint8_t* p) { p_free(p); });
+    } // else: too large for the cache, only the ETag is kept
+    e.crc    = gz.crc();
+    e.length = gz.inputSize();
+    e.stamp  = stamp;
+    DEBUG_PRINTF_P(PSTR("JSON cache %u: %u -> %u bytes\n"), id, e.length, e.size);
+  }
+
+  formatJsonCacheEtag(etag, e);
+  const AsyncWebHeader* match = request->getHeader(F("If-None-Match"));
+  if (etag[0] && match && match->value() == etag) {
+    AsyncWebServerResponse *response = request->beginResponse(304);
+    response->addHeader(F("ETag"), etag);
+    request->send(response);
+    return true;
+  }
+  if (!gzip || !e.gz) return false;
+
+  std::shared_ptr<uint8_t> gz = e.gz;
+  const size_t size = e.size;
+  AsyncWebServerResponse *response = request->beginResponse(FPSTR(CONTENT_TYPE_JSON), size,
+    [gz, size](uint8_t* buffer, size_t maxLen, size_t index) -> size_t {
+      const size_t len = min(maxLen, size - index);
+      memcpy(buffer, gz.get() + index, len);
+      return len;
+    });
+  response->addHeader(F("Content-Encoding"), F("gzip"));
+  response->addHeader(F("Cache-Control"), F("no-cache"));
+  response->addHeader(F("ETag"), etag);
+  request->send(response);
+  return true;
 }
 
 // Global buffer locking response helper class (to make sure lock is released when AsyncJsonResponse is destroyed)
@@ -1273,24 +1544,42 @@ class LockedJsonResponse: public AsyncJsonResponse {
   virtual ~LockedJsonResponse() { if (_holding_lock) releaseJSONBufferLock(); };
 };
 
+static inline int palettePage(AsyncWebServerRequest* request) {
+  return request->hasParam(F("page")) ? request->getParam(F("page"))->value().toInt() : 0;
+}
+
 void serveJson(AsyncWebServerRequest* request)
 {
   enum class json_target {
-    all, state, info, state_info, nodes, effects, palettes, networks, config, pins
+    all, state, info, state_info, nodes, effects, palettes, networks, config, pins, fxmem, perf
   };
   json_target subJson = json_target::all;
+  char etag[24] = "";
 
   const String& url = request->url();
   if      (url.indexOf("state")    > 0) subJson = json_target::state;
   else if (url.indexOf("info")     > 0) subJson = json_target::info;
   else if (url.indexOf("si")       > 0) subJson = json_target::state_info;
   else if (url.indexOf(F("nodes")) > 0) subJson = json_target::nodes;
-  else if (url.indexOf(F("eff"))   > 0) subJson = json_target::effects;
-  else if (url.indexOf(F("palx"))  > 0) subJson = json_target::palettes;
-  else if (url.indexOf(F("fxda"))  > 0) { respondModeData(request); return; }
+  else if (url.indexOf(F("eff"))   > 0) {
+    if (serveJsonCached(request, JSON_CACHE_EFF, 0, etag)) return;
+    subJson = json_target::effects;
+  }
+  else if (url.indexOf(F("palx"))  > 0) {
+    if (serveJsonCached(request, JSON_CACHE_PALX, palettePage(request), etag)) return;
+    subJson = json_target::palettes;
+  }
+  else if (url.indexOf(F("fxda"))  > 0) {
+    if (!serveJsonCached(request, JSON_CACHE_FXDATA, 0, etag)) respondModeData(request, etag);
+    return;
+  }
   else if (url.indexOf(F("net"))   > 0) subJson = json_target::networks;
   else if (url.indexOf(F("cfg"))   > 0) subJson = json_target::config;
   else if (url.indexOf(F("pins"))  > 0) subJson = json_target::pins;
+  else if (url.indexOf(F("fxmem")) > 0) subJson = json_target::fxmem;
+  #ifndef WLED_DISABLE_RENDER_PROFILE
+  else if (url.indexOf(F("perf"))  > 0) subJson = json_target::perf;
+  #endif
   #ifdef WLED_ENABLE_JSONLIVE
   else if (url.indexOf("live")     > 0) {
     serveLiveLeds(request);
@@ -1325,7 +1614,7 @@ void serveJson(AsyncWebServerRequest* request)
     case json_target::nodes:
       serializeNodes(lDoc); break;
     case json_target::palettes:
-      serializePalettes(lDoc, request->hasParam(F("page")) ? request->getParam(F("page"))->value().toInt() : 0); break;
+      serializePalettes(lDoc, palettePage(request)); break;
     case json_target::effects:
       serializeModeNames(lDoc); break;
     case json_target::networks:
@@ -1334,6 +1623,12 @@ void serveJson(AsyncWebServerRequest* request)
       serializeConfig(lDoc); break;
     case json_target::pins:
       serializePins(lDoc); break;
+    case json_target::fxmem:
+      serializeFxMem(lDoc); break;
+    #ifndef WLED_DISABLE_RENDER_PROFILE
+    case json_target::perf:
+      serializePerf(lDoc); break;
+    #endif
     case json_target::state_info:
     case json_target::all:
       JsonObject state = lDoc.createNestedObject("state");
@@ -1353,6 +1648,7 @@ void serveJson(AsyncWebServerRequest* request)
 
   [[maybe_unused]] size_t len = response->setLength();
   DEBUG_PRINTF_P(PSTR("JSON content length: %u\n"), len);
+  if (etag[0]) response->addHeader(F("ETag"), etag);
 
   request->send(response);
 }
@@ -1400,7 +1696,11 @@ bool serveLiveLeds(AsyncWebServerRequest* request, uint32_t wsClient)
     r = scale8(qadd8(w, r), strip.getBrightness()); //R, add white channel to RGB channels as a simple RGBW -> RGB map
     g = scale8(qadd8(w, g), strip.getBrightness()); //G
     b = scale8(qadd8(w, b), strip.getBrightness()); //B
-    buf += sprintf_P(buf, PSTR("\"%06X\","), RGBW32(r,g,b,0));
+    const uint32_t rgb = RGBW32(r,g,b,0);
+    *buf++ = '"';
+    for (int s = 20; s >= 0; s -= 4) *buf++ = "0123456789ABCDEF"[(rgb >> s) & 0xF]; // same as "%06X" without the sprintf overhead
+    *buf++ = '"';
+    *buf++ = ',';
   }
   buf--;  // remove last comma
   buf += sprintf_P(buf, PSTR("],\"n\":%d"), n);
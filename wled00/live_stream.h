@@ -0,0 +1,228 @@
+/* live_stream.h
+
+Binary live view stream (WebSocket peek, version 3) at full or client-selected resolution.
+
+Message (multi-byte values big endian):
+  [0]     'L'
+  [1]     3 (version)
+  [2]     flags: bit 0 key frame, bits 1-2 format (LIVE_FMT_*)
+  [3]     sequence number
+  [4..5]  width
+  [6..7]  height (1 for a strip)
+  [8]     step (every step-th LED in both dimensions is sent)
+  [9..]   payload
+Pixels are quantised to RGB888 (3 bytes), RGB565 (2 bytes) or the fixed 3-3-2 palette (1 byte), white is added to
+the color channels. In a delta frame every pixel is XORed with the same pixel of the previous frame (unchanged pixels
+are 0). The payload is run length encoded like the serial protocol (serial_frames.h): control byte c < 128 is followed
+by c+1 literal pixels, c >= 128 by one pixel that is repeated c-126 times.
+
+The encoder keeps the last frame sent (quantised) as the base of the next delta frame. Like measureJson() and
+serializeJson(), measure() returns the size of the next message so the buffer can be allocated exactly before
+encode() writes it. Only a message that was handed to the client may be committed as base (encode() updates it), any
+failure afterwards has to be reported with invalidate(), the next message is then a key frame.
+
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#define LIVE_FMT_RGB888      0
+#define LIVE_FMT_RGB565      1
+#define LIVE_FMT_RGB332      2
+
+#define LIVE_FLAG_KEY        0x01
+#define LIVE_HEADER          9
+#ifndef LIVE_KEYFRAME_INTERVAL
+  #define LIVE_KEYFRAME_INTERVAL 100  // frames between key frames
+#endif
+#ifndef LIVE_STREAM_MAX_PIXELS
+  #ifdef ESP8266
+    #define LIVE_STREAM_MAX_PIXELS 1024   // larger frames are sent at a reduced resolution
+  #else
+    #define LIVE_STREAM_MAX_PIXELS 16384
+  #endif
+#endif
+
+class LiveStreamEncoder {
+  public:
+    struct Stats {
+      uint32_t frames;      // messages encoded
+      uint32_t keyframes;
+      uint32_t raw;         // bytes of the quantised frames
+      uint32_t sent;        // bytes of the encoded messages
+    } stats = {};
+
+    LiveStreamEncoder() {}
+    ~LiveStreamEncoder() { end(); }
+    LiveStreamEncoder(const LiveStreamEncoder&) = delete;
+    LiveStreamEncoder& operator=(const LiveStreamEncoder&) = delete;
+
+    // frame buffer of width x height pixels (row by row), send every step-th pixel in the given format,
+    // returns false if out of memory
+    bool begin(unsigned width, unsigned height, unsigned step, uint8_t format) {
+      if (step < 1) step = 1;
+      if (step > 255) step = 255;
+      if (format > LIVE_FMT_RGB332) format = LIVE_FMT_RGB888;
+      const unsigned w = (width + step - 1) / step;
+      const unsigned h = (height + step - 1) / step;
+      if (_prev && w == _w && h == _h && step == _step && format == _format && width == _srcWidth) return true;
+      end();
+      if (w == 0 || h == 0 || w > UINT16_MAX || h > UINT16_MAX) return false;
+      _bpp = format == LIVE_FMT_RGB888 ? 3 : format == LIVE_FMT_RGB565 ? 2 : 1;
+      _prev = (uint8_t*)p_malloc(w * h * _bpp);
+      if (!_prev) return false;
+      _srcWidth = width;
+      _w = w;
+      _h = h;
+      _step = step;
+      _format = format;
+      return true;
+    }
+
+    void end() {
+      if (_prev) p_free(_prev);
+      _prev = nullptr;
+      _w = _h = 0;
+      _valid = false;
+    }
+
+    inline void     invalidate()       { _valid = false; }
+    inline bool     isReady() const    { return _prev; }
+    inline unsigned pixels() const     { return _w * _h; }
+    inline unsigned step() const       { return _step; }
+
+    // size of the next message for the frame buffer px (and brightness)
+    inline size_t measure(const uint32_t* px, uint8_t bri) { return run<false>(px, bri, nullptr, 0); }
+
+    // write the next message to buf, returns its size, 0 if it does not fit (frame buffer changed since measure())
+    size_t encode(const uint32_t* px, uint8_t bri, uint8_t* buf, size_t capacity) {
+      const bool key = isKey();
+      const size_t len = run<true>(px, bri, buf, capacity);
+      if (!len) {
+        _valid = false; // base partially updated
+        return 0;
+      }
+      _valid = true;
+      _frames = key ? 1 : _frames + 1;
+      _seq++;
+      stats.frames++;
+      if (key) stats.keyframes++;
+      stats.raw += pixels() * _bpp;
+      stats.sent += len;
+      return len;
+    }
+
+  private:
+    uint8_t* _prev = nullptr;   // last frame sent (quantised)
+    unsigned _srcWidth = 0;
+    unsigned _w = 0, _h = 0;
+    unsigned _frames = 0;       // frames since key frame
+    uint8_t  _step = 1;
+    uint8_t  _format = LIVE_FMT_RGB888;
+    uint8_t  _bpp = 3;
+    uint8_t  _seq = 0;
+    bool     _valid = false;    // _prev holds the last frame the client received
+
+    inline bool isKey() const { return !_valid || _frames >= LIVE_KEYFRAME_INTERVAL; }
+
+    inline uint32_t quantise(uint32_t c, uint8_t bri) const {
+      const uint8_t w = c >> 24;
+      unsigned r = ((c >> 16) & 0xFF) + w;
+      unsigned g = ((c >> 8)  & 0xFF) + w;
+      unsigned b = ( c        & 0xFF) + w;
+      r = r > 255 ? 255 : r;
+      g = g > 255 ? 255 : g;
+      b = b > 255 ? 255 : b;
+      if (bri < 255) {
+        r = (r * (bri + 1)) >> 8;
+        g = (g * (bri + 1)) >> 8;
+        b = (b * (bri + 1)) >> 8;
+      }
+      switch (_format) {
+        case LIVE_FMT_RGB565: return ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3);
+        case LIVE_FMT_RGB332: return (r & 0xE0) | ((g & 0xE0) >> 3) | (b >> 6);
+        default:              return (r << 16) | (g << 8) | b;
+      }
+    }
+
+    inline uint32_t load(const uint8_t* p) const {
+      uint32_t v = 0;
+      for (unsigned k = 0; k < _bpp; k++) v = (v << 8) | p[k];
+      return v;
+    }
+
+    inline void store(uint8_t* p, uint32_t v) const {
+      for (unsigned k = _bpp; k > 0; k--, v >>= 8) p[k-1] = v;
+    }
+
+    // measure (WRITE false) or encode the next message
+    template<bool WRITE> size_t run(const uint32_t* px, uint8_t bri, uint8_t* out, size_t capacity) {
+      if (!_prev || !px) return 0;
+      const bool key = isKey();
+      const unsigned n = pixels();
+      // value (quantised, XORed with the last frame) of output pixel i
+      auto value = [&](unsigned i) -> uint32_t {
+        const unsigned x = i % _w, y = i / _w;
+        const uint32_t v = quantise(px[y * _step * _srcWidth + x * _step], bri);
+        return key ? v : v ^ load(&_prev[i * _bpp]);
+      };
+      auto put = [&](size_t& pos, uint32_t v) {
+        if (WRITE) store(&out[pos], v);
+        pos += _bpp;
+      };
+      auto commit = [&](unsigned i, uint32_t d) {
+        if (WRITE) store(&_prev[i * _bpp], key ? d : d ^ load(&_prev[i * _bpp]));
+      };
+
+      if (WRITE) {
+        if (capacity < LIVE_HEADER) return 0;
+        out[0] = 'L';
+        out[1] = 3;
+        out[2] = (key ? LIVE_FLAG_KEY : 0) | (_format << 1);
+        out[3] = _seq;
+        out[4] = _w >> 8;
+        out[5] = _w;
+        out[6] = _h >> 8;
+        out[7] = _h;
+        out[8] = _step;
+      }
+      size_t pos = LIVE_HEADER;
+      unsigned i = 0;
+      uint32_t cur = n ? value(0) : 0;
+      while (i < n) {
+        // run of equal values
+        unsigned r = 1;
+        uint32_t next = 0;
+        while (i + r < n && r < 129 && (next = value(i + r)) == cur) r++;
+        if (r >= 2) {
+          if (WRITE && pos + 1 + _bpp > capacity) return 0;
+          if (WRITE) out[pos] = r + 126;
+          pos++;
+          put(pos, cur);
+          for (unsigned k = 0; k < r; k++) commit(i + k, cur);
+          i += r;
+          if (i < n) cur = r < 129 ? next : value(i);
+          continue;
+        }
+        // literals up to the start of the next run
+        const size_t ctl = pos++;
+        unsigned l = 0;
+        while (true) {
+          if (WRITE && pos + _bpp > capacity) return 0;
+          put(pos, cur);
+          commit(i, cur);
+          i++;
+          l++;
+          if (i >= n) break;
+          cur = next;                                   // value(i), known from the run check or the look-ahead below
+          if (l == 128) break;
+          if (i + 1 < n && (next = value(i + 1)) == cur) break; // run starts at i
+        }
+        if (WRITE) out[ctl] = l - 1;
+      }
+      return pos;
+    }
+};
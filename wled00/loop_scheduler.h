@@ -0,0 +1,180 @@
+/* loop_scheduler.h
+
+Cooperative, time-budgeted scheduling of the subsystems called from WLED::loop().
+
+Every subsystem (task) is called through run(), which measures its execution time. At the start of each loop iteration
+the time the next frame is due in strip.service() becomes the deadline of the iteration. Depending on its priority
+- a critical task (inputs, realtime data, rendering) is always run
+- a normal task is run unless the frame is already overdue, it then waits for the next iteration (after the frame)
+- a deferrable task (presets, playlists, file system, MQTT, Hue, maintenance) is only run if its expected cost fits into
+  the time left until the deadline, so non-urgent work is sliced across iterations when the frame budget is tight
+No task is deferred longer than LOOP_MAX_DEFER. The expected cost of a task is its peak execution time, which decays by
+a quarter every LOOP_PEAK_DECAY ms, as most tasks are cheap unless they have work to do.
+
+Execution times are collected per task and for the whole iteration in histograms with logarithmic buckets: the first
+bucket holds times below LOOP_HIST_BASE us, each following one is twice as wide, the last one holds everything above.
+All buckets of a histogram are halved when one of them saturates, which keeps the shape of the distribution.
+
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <limits.h>
+
+#define LOOP_CRITICAL     0
+#define LOOP_NORMAL       1
+#define LOOP_DEFERRABLE   2
+
+#ifndef LOOP_MAX_DEFER
+  #define LOOP_MAX_DEFER  100   // ms a task may be deferred at most
+#endif
+#define LOOP_PEAK_DECAY   1000  // ms after which the expected cost of a task decays by a quarter
+#define LOOP_LATE         1     // ms a frame may start after its deadline without being counted as late
+#define LOOP_HIST_BUCKETS 8
+#define LOOP_HIST_BASE    250   // us, upper limit of the first histogram bucket (0.25, 0.5, 1, 2, 4, 8, 16, >16 ms)
+
+// id, name (as reported in /json/info), priority
+#define LOOP_TASKS(T) \
+  T(TIME,       "time",   LOOP_CRITICAL)   \
+  T(IR,         "ir",     LOOP_CRITICAL)   \
+  T(CONNECTION, "conn",   LOOP_CRITICAL)   \
+  T(SERIAL,     "serial", LOOP_CRITICAL)   \
+  T(IMPROV,     "improv", LOOP_NORMAL)     \
+  T(NOTIFY,     "udp",    LOOP_CRITICAL)   \
+  T(TRANSITION, "trans",  LOOP_CRITICAL)   \
+  T(DMX,        "dmx",    LOOP_CRITICAL)   \
+  T(USERMODS,   "um",     LOOP_NORMAL)     \
+  T(IO,         "io",     LOOP_CRITICAL)   \
+  T(REMOTE,     "remote", LOOP_NORMAL)     \
+  T(ALEXA,      "alexa",  LOOP_DEFERRABLE) \
+  T(MQTT,       "mqtt",   LOOP_DEFERRABLE) \
+  T(FILE,       "file",   LOOP_DEFERRABLE) \
+  T(SERVICES,   "svc",    LOOP_NORMAL)     \
+  T(NIGHTLIGHT, "nl",     LOOP_NORMAL)     \
+  T(HUE,        "hue",    LOOP_DEFERRABLE) \
+  T(PLAYLIST,   "pl",     LOOP_DEFERRABLE) \
+  T(PRESETS,    "ps",     LOOP_DEFERRABLE) \
+  T(STRIP,      "strip",  LOOP_CRITICAL)   \
+  T(MAINTAIN,   "maint",  LOOP_DEFERRABLE) \
+  T(HEAP,       "heap",   LOOP_DEFERRABLE) \
+  T(BUSSES,     "bus",    LOOP_CRITICAL)   \
+  T(CONFIG,     "cfg",    LOOP_DEFERRABLE) \
+  T(WS,         "ws",     LOOP_NORMAL)     \
+  T(STATUSLED,  "led",    LOOP_NORMAL)
+
+#define LOOP_TASK_ID(id, name, prio) LOOP_TASK_##id,
+enum LoopTask : uint8_t { LOOP_TASKS(LOOP_TASK_ID) LOOP_TASK_COUNT };
+#undef LOOP_TASK_ID
+
+class LoopScheduler {
+  public:
+    struct Timing {
+      uint32_t runs;
+      uint32_t deferred;                  // iterations the task was skipped
+      uint32_t avg;                       // us, moving average
+      uint32_t max;                       // us
+      uint16_t hist[LOOP_HIST_BUCKETS];
+    };
+
+    struct Stats {
+      uint32_t frames;    // frames rendered by strip.service()
+      uint32_t late;      // frames started more than LOOP_LATE ms after their deadline
+      Timing   loop;      // whole loop iterations
+    } stats = {};
+
+    // start of a loop iteration: now (millis), start of the last frame and interval until the next one (ms),
+    // frame is false if strip.service() will not render (strip off, realtime mode)
+    void beginLoop(unsigned long now, unsigned long lastFrame, unsigned interval, bool frame) {
+      const unsigned long us = micros();
+      if (_running) record(stats.loop, us - _loopStart);
+      _running = true;
+      _loopStart = us;
+      if (lastFrame != _lastFrame) {
+        if (_frame && long(lastFrame - _dueMs) > LOOP_LATE) stats.late++;
+        stats.frames++;
+        _lastFrame = lastFrame;
+      }
+      _frame = frame;
+      _dueMs = lastFrame + interval;
+      _due = us + long(_dueMs - now) * 1000L;
+    }
+
+    // run f() unless the task is to be deferred, returns true if it was run
+    template<typename F> bool run(unsigned id, F f) {
+      if (id >= LOOP_TASK_COUNT) return false;
+      Task& t = _task[id];
+      const unsigned long start = micros();
+      if (_frame && priority(id) != LOOP_CRITICAL) {
+        const long left = long(_due - start);
+        if (priority(id) == LOOP_NORMAL ? left < 0 : left < long(t.peak)) {
+          if (!t.waiting) {
+            t.waiting = true;
+            t.since = start;
+          }
+          if (start - t.since < LOOP_MAX_DEFER * 1000UL) {
+            t.timing.deferred++;
+            return false;
+          }
+        }
+      }
+      t.waiting = false;
+      f();
+      const unsigned long cost = micros() - start;
+      record(t.timing, cost);
+      if (cost >= t.peak) {
+        t.peak = cost;
+        t.decayed = start;
+      } else if (start - t.decayed > LOOP_PEAK_DECAY * 1000UL) {
+        t.peak -= t.peak >> 2;
+        t.decayed = start;
+      }
+      return true;
+    }
+
+    // time left until the frame deadline (us), negative if overdue
+    inline long remaining() const { return _frame ? long(_due - micros()) : LONG_MAX; }
+
+    inline const Timing& timing(unsigned id) const { return _task[id < LOOP_TASK_COUNT ? id : 0].timing; }
+
+    static uint8_t priority(unsigned id) {
+      #define LOOP_TASK_PRIO(id, name, prio) prio,
+      static const uint8_t prio[LOOP_TASK_COUNT] = { LOOP_TASKS(LOOP_TASK_PRIO) };
+      #undef LOOP_TASK_PRIO
+      return id < LOOP_TASK_COUNT ? prio[id] : LOOP_CRITICAL;
+    }
+
+    // upper limit of histogram bucket b (us), 0 for the last one (open)
+    static inline uint32_t bucketLimit(unsigned b) { return b < LOOP_HIST_BUCKETS - 1 ? uint32_t(LOOP_HIST_BASE) << b : 0; }
+
+    void reset() {
+      stats = {};
+      for (unsigned i = 0; i < LOOP_TASK_COUNT; i++) _task[i].timing = {};
+    }
+
+  private:
+    struct Task {
+      Timing        timing;
+      unsigned long peak;      // us, expected cost
+      unsigned long decayed;   // us, last change of peak
+      unsigned long since;     // us, first iteration the task was deferred
+      bool          waiting;   // deferred since
+    };
+    Task          _task[LOOP_TASK_COUNT] = {};
+    unsigned long _loopStart = 0;  // us
+    unsigned long _due = 0;        // us, frame deadline
+    unsigned long _dueMs = 0;
+    unsigned long _lastFrame = 0;
+    bool          _frame = false;  // a frame is expected in this iteration
+    bool          _running = false;
+
+    static void record(Timing& t, unsigned long us) {
+      t.runs++;
+      t.avg = us > t.avg ? t.avg + (us - t.avg) / 8 : t.avg - (t.avg - us) / 8;
+      if (us > t.max) t.max = us;
+      unsigned b = 0;
+      while (b < LOOP_HIST_BUCKETS - 1 && us >= bucketLimit(b)) b++;
+      if (t.hist[b] == UINT16_MAX) for (unsigned i = 0; i < LOOP_HIST_BUCKETS; i++) t.hist[i] >>= 1;
+      t.hist[b]++;
+    }
+};
@@ -54,12 +54,9 @@ static void onMqttConnect(bool sessionPresent)
 
   DEBUG_PRINTLN(F("MQTT ready"));
 
-#ifndef USERMOD_SMARTNEST
-  snprintf_P(subuf, sizeof(subuf)-1, sTopicFormat, MQTT_MAX_TOPIC_LEN, mqttDeviceTopic, "status");
-  mqtt->publish(subuf, 0, true, "online"); // retain message for a LWT
-#endif
-
-  publishMqtt();
+  // new session: publish complete state (incl. retained "online" status for LWT) without waiting for the window
+  mqttPublisher.reset();
+  mqttPublisher.mark((1U << MQTT_TOPIC_STATUS) | (1U << MQTT_TOPIC_BRI) | (1U << MQTT_TOPIC_COL) | (1U << MQTT_TOPIC_XML) | (1U << MQTT_TOPIC_JSON), millis(), true);
 }
 
 
@@ -162,32 +159,81 @@ class bufferPrint : public Print {
 }; // anonymous namespace
 
 
+// state changed: mark state topics for publishing, messages are coalesced and sent from handleMqtt()
 void publishMqtt()
 {
   if (!WLED_MQTT_CONNECTED) return;
-  DEBUG_PRINTLN(F("Publish MQTT"));
-
   #ifndef USERMOD_SMARTNEST
-  char s[10];
-  char subuf[MQTT_MAX_TOPIC_LEN + 16];
+  mqttPublisher.mark((1U << MQTT_TOPIC_BRI) | (1U << MQTT_TOPIC_COL) | (1U << MQTT_TOPIC_XML) | (1U << MQTT_TOPIC_JSON), millis());
+  #endif
+}
 
-  sprintf_P(s, PSTR("%u"), bri);
-  snprintf_P(subuf, sizeof(subuf)-1, sTopicFormat, MQTT_MAX_TOPIC_LEN, mqttDeviceTopic, "g");
-  mqtt->publish(subuf, 0, retainMqttMsg, s);         // optionally retain message (#2263)
 
-  sprintf_P(s, PSTR("#%06X"), (colPri[3] << 24) | (colPri[0] << 16) | (colPri[1] << 8) | (colPri[2]));
-  snprintf_P(subuf, sizeof(subuf)-1, sTopicFormat, MQTT_MAX_TOPIC_LEN, mqttDeviceTopic, "c");
-  mqtt->publish(subuf, 0, retainMqttMsg, s);         // optionally retain message (#2263)
+// render a state topic, returns false if not possible right now
+static bool renderMqttTopic(unsigned topic, DynamicBuffer& buf, size_t& len)
+{
+  switch (topic) {
+    case MQTT_TOPIC_BRI:
+      len = sprintf_P(buf.data(), PSTR("%u"), bri);
+      return true;
+    case MQTT_TOPIC_COL:
+      len = sprintf_P(buf.data(), PSTR("#%06X"), (colPri[3] << 24) | (colPri[0] << 16) | (colPri[1] << 8) | (colPri[2]));
+      return true;
+    case MQTT_TOPIC_STATUS:
+      len = strlcpy(buf.data(), "online", buf.size());
+      return true;
+    case MQTT_TOPIC_XML: {
+      // TODO: use a DynamicBufferList.  Requires a list-read-capable MQTT client API.
+      bufferPrint pbuf(buf.data(), buf.size());
+      XML_response(pbuf);
+      len = pbuf.size();
+      return true;
+    }
+    case MQTT_TOPIC_JSON: {
+      if (jsonBufferLock || !requestJSONBufferLock(JSON_LOCK_MQTT)) return false; // don't wait for the buffer
+      serializeState(pDoc->to<JsonObject>());
+      len = measureJson(*pDoc);
+      if (len >= buf.size()) buf = DynamicBuffer(len + 1);
+      const bool ok = buf.size() > len;
+      if (ok) serializeJson(*pDoc, buf.data(), buf.size());
+      releaseJSONBufferLock();
+      return ok;
+    }
+  }
+  return false;
+}
 
-  snprintf_P(subuf, sizeof(subuf)-1, sTopicFormat, MQTT_MAX_TOPIC_LEN, mqttDeviceTopic, "status");
-  mqtt->publish(subuf, 0, true, "online");  // retain message for a LWT
 
-  // TODO: use a DynamicBufferList.  Requires a list-read-capable MQTT client API.
-  DynamicBuffer buf(1024);
-  bufferPrint pbuf(buf.data(), buf.size());
-  XML_response(pbuf);
-  snprintf_P(subuf, sizeof(subuf)-1, sTopicFormat, MQTT_MAX_TOPIC_LEN, mqttDeviceTopic, "v");
-  mqtt->publish(subuf, 0, retainMqttMsg, buf.data(), pbuf.size());   // optionally retain message (#2263)
+// publish (at most) one pending state topic per call, so a burst of messages does not block the loop
+void handleMqtt()
+{
+  if (!WLED_MQTT_CONNECTED) return;
+  #ifndef USERMOD_SMARTNEST
+  mqttPublisher.window = mqttPublishWindow;
+  for (unsigned i = 0; i < 4; i++) mqttPublisher.interval[i] = mqttRateLimit[i];
+  if (!mqttPublishJson) mqttPublisher.cancel(MQTT_TOPIC_JSON);
+
+  const unsigned long now = millis();
+  const int topic = mqttPublisher.due(now);
+  if (topic < 0) return;
+
+  static const char topicNames[MQTT_TOPICS][7] PROGMEM = { "g", "c", "v", "state", "status" };
+  char name[7];
+  strcpy_P(name, topicNames[topic]);
+  DEBUG_PRINTF_P(PSTR("Publish MQTT %s\n"), name);
+
+  DynamicBuffer buf(topic == MQTT_TOPIC_XML ? 1024 : 16); // JSON state is resized to fit
+  size_t len = 0;
+  if (buf.size() == 0 || !renderMqttTopic(topic, buf, len)) {
+    mqttPublisher.defer(topic, now);
+    return;
+  }
+  char subuf[MQTT_MAX_TOPIC_LEN + 16];
+  snprintf_P(subuf, sizeof(subuf)-1, sTopicFormat, MQTT_MAX_TOPIC_LEN, mqttDeviceTopic, name);
+  const bool retain = topic == MQTT_TOPIC_STATUS || retainMqttMsg; // status is retained for a LWT, others optionally (#2263)
+  mqttPublisher.publish(topic, buf.data(), len, now, [&](const char* payload, size_t length) {
+    return mqtt->publish(subuf, 0, retain, payload, length) != 0; // 0: not accepted (e.g. TCP send buffer full)
+  });
   #endif
 }
 
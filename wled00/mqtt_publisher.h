@@ -0,0 +1,130 @@
+/* mqtt_publisher.h
+
+Change-driven, coalescing MQTT state publisher.
+
+State changes only mark topics as pending (cheap, may happen many times per second during fades or encoder input).
+A pending topic is rendered and published once the coalescing window since its first change has passed and its
+minimum interval (rate limit) since its last publish has elapsed, so all changes within the window result in a
+single message carrying the latest state. Payloads equal to the last published one are not sent again.
+If the client cannot take a message (TCP backpressure), the topic stays pending and is retried later instead of
+blocking the loop. Payloads are rendered at publish time, so memory use does not depend on the number of changes.
+
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define MQTT_TOPIC_BRI      0   // <device>/g
+#define MQTT_TOPIC_COL      1   // <device>/c
+#define MQTT_TOPIC_XML      2   // <device>/v
+#define MQTT_TOPIC_JSON     3   // <device>/state (optional)
+#define MQTT_TOPIC_STATUS   4   // <device>/status
+#define MQTT_TOPICS         5
+
+#ifndef MQTT_PUBLISH_WINDOW
+  #define MQTT_PUBLISH_WINDOW 100 // ms changes are coalesced into one message
+#endif
+#define MQTT_RETRY_DELAY      50  // ms until a message the client did not accept is retried
+
+class MqttPublisher {
+  public:
+    struct Stats {
+      uint32_t published;   // messages published
+      uint32_t coalesced;   // changes merged into a pending message
+      uint32_t unchanged;   // messages skipped because the payload did not change
+      uint32_t deferred;    // messages the client did not accept (retried later)
+    } stats = {};
+
+    uint16_t window = MQTT_PUBLISH_WINDOW;  // coalescing window (ms)
+    uint16_t interval[MQTT_TOPICS] = {};    // minimum time between messages of a topic (ms), 0 = no limit
+
+    // topics (bit mask of 1 << MQTT_TOPIC_*) changed, immediate skips the coalescing window
+    void mark(unsigned topics, unsigned long now, bool immediate = false) {
+      for (unsigned t = 0; t < MQTT_TOPICS; t++) {
+        if (!(topics & (1U << t))) continue;
+        Topic& s = _topic[t];
+        if (s.pending) {
+          stats.coalesced++;
+          if (immediate) s.since = now - window;
+          continue;
+        }
+        s.pending = true;
+        s.since = immediate ? now - window : now;
+      }
+    }
+
+    // next topic that is to be published now, -1 if none
+    int due(unsigned long now) const {
+      for (unsigned t = 0; t < MQTT_TOPICS; t++) {
+        const Topic& s = _topic[t];
+        if (!s.pending || now - s.since < window || (s.deferred && now - s.retry < MQTT_RETRY_DELAY)) continue;
+        if (s.valid && now - s.sent < interval[t]) continue;
+        return t;
+      }
+      return -1;
+    }
+
+    // publish the rendered payload of a due topic through send(), which returns false if the client did not accept it
+    template<typename F> bool publish(unsigned topic, const char* payload, size_t len, unsigned long now, F send) {
+      if (topic >= MQTT_TOPICS) return false;
+      Topic& s = _topic[topic];
+      const uint32_t h = hash(payload, len);
+      if (s.valid && h == s.hash && len == s.len) {
+        stats.unchanged++;
+        s.pending = s.deferred = false;
+        return true;
+      }
+      if (!send(payload, len)) {
+        stats.deferred++;
+        defer(topic, now);
+        return false;
+      }
+      stats.published++;
+      s.pending = s.deferred = false;
+      s.valid = true;
+      s.hash = h;
+      s.len = len;
+      s.sent = now;
+      return true;
+    }
+
+    // rendering was not possible (e.g. buffer busy), try again later
+    inline void defer(unsigned topic, unsigned long now) {
+      if (topic >= MQTT_TOPICS) return;
+      _topic[topic].deferred = true;
+      _topic[topic].retry = now;
+    }
+
+    // drop a pending topic without publishing (e.g. disabled)
+    inline void cancel(unsigned topic) {
+      if (topic < MQTT_TOPICS) _topic[topic].pending = _topic[topic].deferred = false;
+    }
+
+    inline bool isPending(unsigned topic) const { return topic < MQTT_TOPICS && _topic[topic].pending; }
+
+    // forget published payloads (new connection: everything is sent again)
+    void reset() {
+      for (unsigned t = 0; t < MQTT_TOPICS; t++) _topic[t].valid = false;
+    }
+
+  private:
+    struct Topic {
+      unsigned long since;   // first change of the pending message
+      unsigned long sent;    // last publish
+      unsigned long retry;   // time of the last deferred publish or render
+      uint32_t      hash;    // FNV-1a of the last published payload
+      size_t        len;
+      bool          pending;
+      bool          deferred;  // retry after MQTT_RETRY_DELAY
+      bool          valid;   // hash is of a payload published on this connection
+    };
+    Topic _topic[MQTT_TOPICS] = {};
+
+    static uint32_t hash(const char* p, size_t len) {
+      uint32_t h = 2166136261UL;
+      for (size_t i = 0; i < len; i++) h = (h ^ uint8_t(p[i])) * 16777619UL;
+      return h;
+    }
+};
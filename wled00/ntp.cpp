@@ -388,69 +388,86 @@ byte weekdayMondayFirst()
 
 bool isTodayInDateRange(byte monthStart, byte dayStart, byte monthEnd, byte dayEnd)
 {
-	if (monthStart == 0 || dayStart == 0) return true;
-	if (monthEnd == 0) monthEnd = monthStart;
-	if (dayEnd == 0) dayEnd = 31;
-	byte d = day(localTime);
-	byte m = month(localTime);
-
-	if (monthStart < monthEnd) {
-		if (m > monthStart && m < monthEnd) return true;
-		if (m == monthStart) return (d >= dayStart);
-		if (m == monthEnd) return (d <= dayEnd);
-		return false;
-	}
-	if (monthEnd < monthStart) { //range spans change of year
-		if (m > monthStart || m < monthEnd) return true;
-		if (m == monthStart) return (d >= dayStart);
-		if (m == monthEnd) return (d <= dayEnd);
-		return false;
-	}
-
-	//start month and end month are the same
-	if (dayEnd < dayStart) return (m != monthStart || (d <= dayEnd || d >= dayStart)); //all year, except the designated days in this month
-	return (m == monthStart && d >= dayStart && d <= dayEnd); //just the designated days this month
+  return scheduleDateInRange(monthStart, dayStart, monthEnd, dayEnd, month(localTime), day(localTime));
 }
 
+static time_t getSunTime(time_t theDay, bool sunset);
+
+// rule of schedule entry id: timers first, then cronTimers
+static bool getTimerRule(unsigned id, ScheduleRule& rule)
+{
+  rule = {};
+  if (id < timers.size()) {
+    const Timer& t = timers[id];
+    if (!t.isEnabled()) return false;
+    rule.time.seconds  = 1;
+    rule.time.minutes  = t.minute >= 0 && t.minute < 60 ? 1ULL << t.minute : 0;
+    rule.time.hours    = t.hour == 24 ? 0xFFFFFF : t.hour < 24 ? 1UL << t.hour : 0; // hour 24: every hour
+    rule.time.days     = CRON_ALL_DAYS;
+    rule.time.months   = CRON_ALL_MONTHS;
+    rule.time.weekdays = (t.weekdays & 0x7E) | (t.weekdays >> 7); // bits 1-7 Monday to Sunday, bit 0 is enabled
+    rule.sun           = t.isSunrise() ? SCHEDULE_SUNRISE : t.isSunset() ? SCHEDULE_SUNSET : 0;
+    rule.offset        = t.minute;
+    rule.monthStart    = t.monthStart;
+    rule.dayStart      = t.dayStart;
+    rule.monthEnd      = t.monthEnd;
+    rule.dayEnd        = t.dayEnd;
+    return true;
+  }
+  id -= timers.size();
+  if (id >= cronTimers.size() || !cronTimers[id].enabled || !cronTimers[id].preset) return false;
+  rule.time = cronTimers[id].time;
+  return true;
+}
+
+// sunrise/sunset of a day in local minutes after midnight, cached as every sun timer needs it
+// days without one (polar day or night) are cached as a run, so further sun timers skip them without float math
+static uint32_t sunCacheDay[2] = {UINT32_MAX, UINT32_MAX};
+static int16_t  sunCacheMinutes[2];
+static uint32_t sunNoneFirst[2] = {UINT32_MAX, UINT32_MAX};
+static uint32_t sunNoneLast[2];
+
+static int getTimerSunMinutes(uint32_t theDay, bool sunset)
+{
+  if (theDay >= sunNoneFirst[sunset] && theDay <= sunNoneLast[sunset]) return -1;
+  if (sunCacheDay[sunset] != theDay) {
+    const time_t t = getSunTime((time_t)theDay * 86400 + 43200, sunset);
+    sunCacheMinutes[sunset] = t ? (t % 86400) / 60 : -1;
+    sunCacheDay[sunset] = theDay;
+    if (!t) { // find the end of this run of days without sun
+      sunNoneFirst[sunset] = sunNoneLast[sunset] = theDay;
+      while (sunNoneLast[sunset] - theDay < SCHEDULE_SUN_HORIZON && !getSunTime((time_t)(sunNoneLast[sunset] + 1) * 86400 + 43200, sunset))
+        sunNoneLast[sunset]++;
+    }
+  }
+  return sunCacheMinutes[sunset];
+}
+
+static Schedule timerSchedule(getTimerRule, getTimerSunMinutes);
+
 void checkTimers()
 {
   if (lastTimerMinute != minute(localTime)) {
     lastTimerMinute = minute(localTime);
     if (!hour(localTime) && minute(localTime)==1) calculateSunriseAndSunset();
     DEBUG_PRINTF_P(PSTR("Local time: %02d:%02d\n"), hour(localTime), minute(localTime));
-    for (size_t i = 0; i < timers.size(); i++) {
-      const Timer& t = timers[i];
-      if (!t.isEnabled()) continue;
-      time_t tt = 0;
-      if (t.isSunrise()) {
-        if (!sunrise) continue;
-        tt = sunrise + t.minute * 60;
-      } else if (t.isSunset()) {
-        if (!sunset) continue;
-        tt = sunset + t.minute * 60;
-      } else {
-        struct tm tim = {};
-        tim.tm_year = year(localTime) - 1900;
-        tim.tm_mon = month(localTime) - 1;
-        tim.tm_mday = day(localTime);
-        tim.tm_hour = t.hour;
-        tim.tm_min = t.minute;
-        tim.tm_sec = 0;
-        tim.tm_isdst = -1;
-        tt = mktime(&tim);
-      }
-      if ((hour(tt) == hour(localTime) && minute(tt) == minute(localTime)) || (t.hour == 24 && t.minute == minute(localTime))) {
-        if (!((t.weekdays >> weekdayMondayFirst()) & 0x01)) continue;
-        if (!isTodayInDateRange(t.monthStart, t.dayStart, t.monthEnd, t.dayEnd)) continue;
-        applyPreset(t.preset);
-        #ifdef WLED_DEBUG
-        if (t.isSunrise()) DEBUG_PRINTF_P(PSTR("Sunrise timer %d offset %d\n"), t.preset, t.minute);
-        else if (t.isSunset()) DEBUG_PRINTF_P(PSTR("Sunset timer %d offset %d\n"), t.preset, t.minute);
-        else DEBUG_PRINTF_P(PSTR("Timer %d: preset %d\n"), i, t.preset);
-        #endif
-      }
-    }
   }
+  // only the earliest entry is compared, entries are recomputed when they fire or the time base changes
+  const int32_t offset = localTime - (time_t)toki.second();
+  timerSchedule.update(localTime, offset, timers.size() + cronTimers.size(), [](unsigned id) {
+    if (id < timers.size()) {
+      const Timer& t = timers[id];
+      applyPreset(t.preset);
+      #ifdef WLED_DEBUG
+      if (t.isSunrise()) DEBUG_PRINTF_P(PSTR("Sunrise timer %d offset %d\n"), t.preset, t.minute);
+      else if (t.isSunset()) DEBUG_PRINTF_P(PSTR("Sunset timer %d offset %d\n"), t.preset, t.minute);
+      else DEBUG_PRINTF_P(PSTR("Timer %d: preset %d\n"), id, t.preset);
+      #endif
+    } else {
+      applyPreset(cronTimers[id - timers.size()].preset);
+      DEBUG_PRINTF_P(PSTR("Cron timer %d: preset %d\n"), id - timers.size(), cronTimers[id - timers.size()].preset);
+    }
+  });
 }
 
 #define ZENITH -0.83
@@ -507,58 +524,47 @@ static int getSunriseUTC(int year, int month, int day, float lat, float lon, boo
 }
 
 #define SUNSET_MAX (24*60) // 1day = max expected absolute value for sun offset in minutes
+// sunrise (or sunset) in local time on the day of theDay (local time), 0 if there is none or no location is set
+static time_t getSunTime(time_t theDay, bool sunset) {
+  if (!(int)(longitude*10.) && !(int)(latitude*10.)) return 0;
+
+  // Due to limited accuracy, its possible to get a bad sunrise/sunset displayed as "00:00" (see issue #3601)
+  // So in case of invalid result, we try to use the sunset/sunrise of previous day. Max 3 days back, this worked well in all cases I tried.
+  // When latitude = 66,6 (N or S), the functions sometimes returns 2147483647, so this "unexpected large" is another condition for retry
+  int minUTC = 0;
+  int retryCount = 0;
+  do {
+    time_t prevDay = theDay - retryCount * 86400; // one day back = 86400 seconds
+    minUTC = getSunriseUTC(year(prevDay), month(prevDay), day(prevDay), latitude, longitude, sunset);
+    DEBUG_PRINTF_P(sunset ? PSTR("* sunset  (minutes from UTC) = %d\n") : PSTR("* sunrise (minutes from UTC) = %d\n"), minUTC);
+    retryCount ++;
+  } while ((abs(minUTC) > SUNSET_MAX)  && (retryCount <= 3));
+  if (abs(minUTC) > SUNSET_MAX) return 0; // there is no sunrise/sunset
+
+  if (minUTC < 0) minUTC += 24*60; // add a day if negative
+  struct tm tim_0;
+  tim_0.tm_year = year(theDay)-1900;
+  tim_0.tm_mon = month(theDay)-1;
+  tim_0.tm_mday = day(theDay);
+  tim_0.tm_hour = minUTC / 60;
+  tim_0.tm_min = minUTC % 60;
+  tim_0.tm_sec = 0;
+  tim_0.tm_isdst = 0;
+  return tz->toLocal(mktime(&tim_0) + utcOffsetSecs);
+}
+
 // calculate sunrise and sunset (if longitude and latitude are set)
 void calculateSunriseAndSunset() {
   if ((int)(longitude*10.) || (int)(latitude*10.)) {
-    struct tm tim_0;
-    tim_0.tm_year = year(localTime)-1900;
-    tim_0.tm_mon = month(localTime)-1;
-    tim_0.tm_mday = day(localTime);
-    tim_0.tm_sec = 0;
-    tim_0.tm_isdst = 0;
-
-    // Due to limited accuracy, its possible to get a bad sunrise/sunset displayed as "00:00" (see issue #3601)
-    // So in case of invalid result, we try to use the sunset/sunrise of previous day. Max 3 days back, this worked well in all cases I tried.
-    // When latitude = 66,6 (N or S), the functions sometimes returns 2147483647, so this "unexpected large" is another condition for retry
-    int minUTC = 0;
-    int retryCount = 0;
-    do {
-      time_t theDay = localTime - retryCount * 86400; // one day back = 86400 seconds
-      minUTC = getSunriseUTC(year(theDay), month(theDay), day(theDay), latitude, longitude, false);
-      DEBUG_PRINTF_P(PSTR("* sunrise (minutes from UTC) = %d\n"), minUTC);
-      retryCount ++;
-    } while ((abs(minUTC) > SUNSET_MAX)  && (retryCount <= 3));
-
-    if (abs(minUTC) <= SUNSET_MAX) {
-      // there is a sunrise
-      if (minUTC < 0) minUTC += 24*60; // add a day if negative
-      tim_0.tm_hour = minUTC / 60;
-      tim_0.tm_min = minUTC % 60;
-      sunrise = tz->toLocal(mktime(&tim_0) + utcOffsetSecs);
-      DEBUG_PRINTF_P(PSTR("Sunrise: %02d:%02d\n"), hour(sunrise), minute(sunrise));
-    } else {
-      sunrise = 0;
-    }
-
-    retryCount = 0;
-    do {
-      time_t theDay = localTime - retryCount * 86400; // one day back = 86400 seconds
-      minUTC = getSunriseUTC(year(theDay), month(theDay), day(theDay), latitude, longitude, true);
-      DEBUG_PRINTF_P(PSTR("* sunset  (minutes from UTC) = %d\n"), minUTC);
-      retryCount ++;
-    } while ((abs(minUTC) > SUNSET_MAX)  && (retryCount <= 3));
-
-    if (abs(minUTC) <= SUNSET_MAX) {
-      // there is a sunset
-      if (minUTC < 0) minUTC += 24*60; // add a day if negative
-      tim_0.tm_hour = minUTC / 60;
-      tim_0.tm_min = minUTC % 60;
-      sunset = tz->toLocal(mktime(&tim_0) + utcOffsetSecs);
-      DEBUG_PRINTF_P(PSTR("Sunset: %02d:%02d\n"), hour(sunset), minute(sunset));
-    } else {
-      sunset = 0;
-    }
+    sunrise = getSunTime(localTime, false);
+    DEBUG_PRINTF_P(PSTR("Sunrise: %02d:%02d\n"), hour(sunrise), minute(sunrise));
+    sunset = getSunTime(localTime, true);
+    DEBUG_PRINTF_P(PSTR("Sunset: %02d:%02d\n"), hour(sunset), minute(sunset));
   }
+  // location or time changed
+  sunCacheDay[0] = sunCacheDay[1] = UINT32_MAX;
+  sunNoneFirst[0] = sunNoneFirst[1] = UINT32_MAX;
+  timerSchedule.invalidate();
 }
 
 //time from JSON and HTTP API
@@ -611,18 +617,21 @@ void addTimer(uint8_t preset, uint8_t hour, int8_t minute, uint8_t weekdays,
   }
   Timer t(preset, hour, minute, weekdays, monthStart, monthEnd, dayStart, dayEnd);
   timers.push_back(t);
+  timerSchedule.invalidate();
   DEBUG_PRINTF("Timer added: preset=%d, hour=%d, minute=%d, count=%d\n", preset, hour, minute, timers.size());
 }
 
 void removeTimer(size_t index) {
   if (index < timers.size()) {
     timers.erase(timers.begin() + index);
+    timerSchedule.invalidate();
     DEBUG_PRINTF("Timer removed at index %d, count=%d\n", index, timers.size());
   }
 }
 
 void clearTimers() {
   timers.clear();
+  timerSchedule.invalidate();
   DEBUG_PRINTLN(F("All timers cleared"));
 }
 
@@ -640,5 +649,28 @@ void compactTimers() {
     }
   }
   timers.shrink_to_fit();
+  timerSchedule.invalidate();
+}
+
+bool addCronTimer(uint8_t preset, const char* expr, bool enabled) {
+  CronSpec time;
+  if (!cronParse(expr, time)) {
+    DEBUG_PRINTF_P(PSTR("Timer: Invalid cron expression \"%s\"\n"), expr ? expr : "");
+    return false;
+  }
+  if (cronTimers.size() >= WLED_MAX_CRON_TIMERS) {
+    DEBUG_PRINTLN(F("Timer: Maximum number of cron timers reached"));
+    return false;
+  }
+  cronTimers.push_back({time, preset, enabled});
+  timerSchedule.invalidate();
+  DEBUG_PRINTF_P(PSTR("Cron timer added: preset=%d, count=%d\n"), preset, cronTimers.size());
+  return true;
+}
+
+void clearCronTimers() {
+  cronTimers.clear();
+  cronTimers.shrink_to_fit();
+  timerSchedule.invalidate();
 }
 
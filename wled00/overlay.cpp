@@ -5,15 +5,19 @@ static void _overlayAnalogCountdown();
 
 /*
  * Used to draw clock overlays over the strip
+ * The clock is drawn into an overlay layer covering overlayMin to overlayMax, which is only redrawn when the time
+ * shown (once per second) or the settings change
  */
+static OverlayLayer clockLayer;
+static uint32_t     clockKey = 0; // inputs of the clock face last drawn
+
+// paint pixel(s) of the clock face (strip indices)
+static inline void clockPixel(unsigned i, uint32_t c)            { clockLayer.setPixelColor(i - overlayMin, c); }
+static inline void clockRange(unsigned i, unsigned i2, uint32_t c) { clockLayer.setRange(i - overlayMin, i2 - overlayMin, c); }
 
 static void _overlayAnalogClock()
 {
   int overlaySize = overlayMax - overlayMin +1;
-  if (countdownMode)
-  {
-    _overlayAnalogCountdown(); return;
-  }
   float hourP = ((float)(hour(localTime)%12))/12.0f;
   float minuteP = ((float)minute(localTime))/60.0f;
   hourP = hourP + minuteP/12.0f;
@@ -28,11 +32,11 @@ static void _overlayAnalogClock()
   {
     if (secondPixel < analogClock12pixel)
     {
-      strip.setRange(analogClock12pixel, overlayMax, color_fade(0xFF0000, bri));
-      strip.setRange(overlayMin, secondPixel, color_fade(0xFF0000, bri));
+      clockRange(analogClock12pixel, overlayMax, color_fade(0xFF0000, bri));
+      clockRange(overlayMin, secondPixel, color_fade(0xFF0000, bri));
     } else
     {
-      strip.setRange(analogClock12pixel, secondPixel, color_fade(0xFF0000, bri));
+      clockRange(analogClock12pixel, secondPixel, color_fade(0xFF0000, bri));
     }
   }
   if (analogClock5MinuteMarks)
@@ -41,12 +45,12 @@ static void _overlayAnalogClock()
     {
       unsigned pix = analogClock12pixel + roundf((overlaySize / 12.0f) *i);
       if (pix > overlayMax) pix -= overlaySize;
-      strip.setPixelColor(pix, color_fade(0x00FFAA, bri));
+      clockPixel(pix, color_fade(0x00FFAA, bri));
     }
   }
-  if (!analogClockSecondsTrail) strip.setPixelColor(secondPixel, color_fade(0xFF0000, bri));
-  strip.setPixelColor(minutePixel, color_fade(0x00FF00, bri));
-  strip.setPixelColor(hourPixel, color_fade(0x0000FF, bri));
+  if (!analogClockSecondsTrail) clockPixel(secondPixel, color_fade(0xFF0000, bri));
+  clockPixel(minutePixel, color_fade(0x00FF00, bri));
+  clockPixel(hourPixel, color_fade(0x0000FF, bri));
 }
 
 
@@ -81,27 +85,61 @@ static void _overlayAnalogCountdown()
     byte pixelCnt = perc*overlaySize;
     if (analogClock12pixel + pixelCnt > overlayMax)
     {
-      strip.setRange(analogClock12pixel, overlayMax, ((uint32_t)colSec[3] << 24)| ((uint32_t)colSec[0] << 16) | ((uint32_t)colSec[1] << 8) | colSec[2]);
-      strip.setRange(overlayMin, overlayMin +pixelCnt -(1+ overlayMax -analogClock12pixel), ((uint32_t)colSec[3] << 24)| ((uint32_t)colSec[0] << 16) | ((uint32_t)colSec[1] << 8) | colSec[2]);
+      clockRange(analogClock12pixel, overlayMax, ((uint32_t)colSec[3] << 24)| ((uint32_t)colSec[0] << 16) | ((uint32_t)colSec[1] << 8) | colSec[2]);
+      clockRange(overlayMin, overlayMin +pixelCnt -(1+ overlayMax -analogClock12pixel), ((uint32_t)colSec[3] << 24)| ((uint32_t)colSec[0] << 16) | ((uint32_t)colSec[1] << 8) | colSec[2]);
     } else
     {
-      strip.setRange(analogClock12pixel, analogClock12pixel + pixelCnt, ((uint32_t)colSec[3] << 24)| ((uint32_t)colSec[0] << 16) | ((uint32_t)colSec[1] << 8) | colSec[2]);
+      clockRange(analogClock12pixel, analogClock12pixel + pixelCnt, ((uint32_t)colSec[3] << 24)| ((uint32_t)colSec[0] << 16) | ((uint32_t)colSec[1] << 8) | colSec[2]);
     }
   }
 }
 
+// FNV-1a hash of everything the clock face depends on
+static uint32_t _overlayClockKey()
+{
+  const uint32_t inputs[] = {
+    uint32_t(countdownMode ? toki.second() : localTime), uint32_t(countdownTime),
+    overlayMin | (uint32_t(overlayMax) << 16), analogClock12pixel,
+    countdownMode | (analogClockSecondsTrail << 1) | (analogClock5MinuteMarks << 2) | (uint32_t(bri) << 8),
+    ((uint32_t)colSec[3] << 24)| ((uint32_t)colSec[0] << 16) | ((uint32_t)colSec[1] << 8) | colSec[2]
+  };
+  uint32_t key = 2166136261UL;
+  for (uint32_t v : inputs) key = (key ^ v) * 16777619UL;
+  return key | 1; // 0 forces a redraw
+}
+
 void handleOverlayDraw() {
   UsermodManager::handleOverlayDraw();
+  if (overlayCurrent != 1 || overlayMax < overlayMin) {
+    if (clockLayer.isReady()) {
+      strip.removeOverlay(&clockLayer);
+      clockLayer.end();
+      clockKey = 0;
+    }
+    return;
+  }
+  bool visible = true;
   if (analogClockSolidBlack) {
     for (unsigned i = 0; i < strip.getSegmentsNum(); i++) {
       const Segment& segment = strip.getSegment(i);
       if (!segment.isActive()) continue;
       if (segment.mode > 0 || segment.colors[0] > 0) {
-        return;
+        visible = false;
+        break;
       }
     }
   }
-  if (overlayCurrent == 1) _overlayAnalogClock();
+  clockLayer.setVisible(visible);
+  if (!visible) return;
+  if (clockLayer.width() != unsigned(overlayMax - overlayMin + 1)) clockKey = 0; // new buffer
+  if (!clockLayer.begin(overlayMax - overlayMin + 1, 1, overlayMin)) return;
+  strip.addOverlay(&clockLayer);
+  const uint32_t key = _overlayClockKey();
+  if (key == clockKey) return; // nothing changed, layer is still shown
+  clockKey = key;
+  clockLayer.clear();
+  if (countdownMode) _overlayAnalogCountdown();
+  else               _overlayAnalogClock();
 }
 
 /*
@@ -0,0 +1,154 @@
+/* overlay_layer.h
+
+Overlay layers composited on top of the segments (analog clock, countdown, usermod displays).
+
+A layer is a persistent buffer of w x h pixels with an alpha value each. It is placed at a pixel of the frame buffer
+(rows are Segment::maxWidth apart) or relative to the origin of a segment, it is then clipped to the segment and hidden
+while the segment is off. Layers registered with strip.addOverlay() are composited in WS2812FX::show() in the same
+pass as the segments, right after blendSegment(), with the opacity and blend mode (like a segment's) of the layer.
+
+The content persists between frames, so a client only draws when it changes (e.g. once per second for a clock).
+Changing pixels or the placement marks the layer, show() then recomposes the area it covered and covers now from the
+segment buffers. Unlike pixels painted with strip.setPixelColor() in the show callback, the pixels below are kept and
+nothing is repainted in frames where neither the segments below nor the layer changed.
+Changes made in the show callback (handleOverlayDraw()) are shown with the next frame.
+
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+class OverlayLayer {
+  public:
+    OverlayLayer() {}
+    ~OverlayLayer() { end(); } // remove with strip.removeOverlay() first
+    OverlayLayer(const OverlayLayer&) = delete;
+    OverlayLayer& operator=(const OverlayLayer&) = delete;
+
+    // w x h pixels at frame buffer pixel (x, y) or at (x, y) of a segment (segment >= 0), all transparent,
+    // the content is kept if the size did not change, returns false if out of memory
+    bool begin(unsigned w, unsigned h = 1, unsigned x = 0, unsigned y = 0, int segment = -1) {
+      if (!_px || w != _w || h != _h) {
+        end();
+        if (!w || !h || w > UINT16_MAX || h > UINT16_MAX) return false;
+        _px = (uint32_t*)p_malloc(w * h * (sizeof(uint32_t) + 1));
+        if (!_px) return false;
+        _alpha = (uint8_t*)(_px + w * h);
+        _w = w;
+        _h = h;
+        clear();
+      }
+      place(x, y, segment);
+      return true;
+    }
+
+    void end() {
+      if (_px) p_free(_px);
+      _px = nullptr;
+      _alpha = nullptr;
+      _w = _h = 0;
+      _changed = true;
+    }
+
+    inline void place(unsigned x, unsigned y, int segment = -1) {
+      if (x == _x && y == _y && segment == _segment) return;
+      _x = x;
+      _y = y;
+      _segment = segment < 0 || segment > INT8_MAX ? -1 : segment;
+      _changed = true;
+    }
+
+    inline void setPixelColorXY(unsigned x, unsigned y, uint32_t c, uint8_t alpha = 255) {
+      if (x >= _w || y >= _h) return;
+      const unsigned i = x + y * _w;
+      if (_px[i] == c && _alpha[i] == alpha) return;
+      _px[i] = c;
+      _alpha[i] = alpha;
+      _changed = true;
+    }
+    inline void setPixelColor(unsigned i, uint32_t c, uint8_t alpha = 255) { if (_w) setPixelColorXY(i % _w, i / _w, c, alpha); }
+    // pixels i to i2 (inclusive, like strip.setRange())
+    void setRange(unsigned i, unsigned i2, uint32_t c, uint8_t alpha = 255) {
+      if (i2 < i) { const unsigned t = i; i = i2; i2 = t; }
+      if (!_px) return;
+      if (i2 >= unsigned(_w * _h)) i2 = _w * _h - 1;
+      for (unsigned n = i; n <= i2; n++) setPixelColor(n, c, alpha);
+    }
+    // make all pixels transparent
+    inline void clear() {
+      if (!_alpha) return;
+      memset(_alpha, 0, _w * _h);
+      _changed = true;
+    }
+
+    inline void setOpacity(uint8_t o)   { if (o != _opacity)   { _opacity = o;   _changed = true; } }
+    inline void setBlendMode(uint8_t m) { if (m != _blendMode) { _blendMode = m; _changed = true; } }
+    inline void setVisible(bool v)      { if (v != _visible)   { _visible = v;   _changed = true; } }
+
+    inline bool     isReady() const     { return _px; }
+    inline unsigned width() const       { return _w; }
+    inline unsigned height() const      { return _h; }
+    inline int      segment() const     { return _segment; }
+    inline uint8_t  opacity() const     { return _opacity; }
+    inline uint8_t  blendMode() const   { return _blendMode; }
+    inline bool     isVisible() const   { return _visible && _opacity && _px; }
+    inline uint32_t getPixelColorXY(unsigned x, unsigned y) const { return x < _w && y < _h ? _px[x + y * _w] : 0; }
+    inline uint8_t  getAlphaXY(unsigned x, unsigned y) const      { return x < _w && y < _h ? _alpha[x + y * _w] : 0; }
+    inline unsigned x() const           { return _x; }
+    inline unsigned y() const           { return _y; }
+
+    // register the area the layer is shown at in this frame ([start, stop) of the frame buffer, empty if hidden),
+    // extends the dirty span by the area it was shown at and the new one if the layer changed or moved
+    void track(size_t start, size_t stop, size_t &dirtyStart, size_t &dirtyStop) {
+      if (_changed || start != _shownStart || stop != _shownStop) {
+        if (_shownStart < _shownStop) {
+          if (_shownStart < dirtyStart) dirtyStart = _shownStart;
+          if (_shownStop  > dirtyStop)  dirtyStop  = _shownStop;
+        }
+        if (start < stop) {
+          if (start < dirtyStart) dirtyStart = start;
+          if (stop  > dirtyStop)  dirtyStop  = stop;
+        }
+      }
+      _shownStart = start;
+      _shownStop  = stop;
+      _changed    = false;
+    }
+    inline size_t shownStart() const { return _shownStart; }
+    inline size_t shownStop() const  { return _shownStop; }
+
+    // blend w x h pixels of the layer into frame at base (rows stride apart), limited to [start, stop) of the frame,
+    // blend(top, bottom) applies the blend mode
+    template<typename F> void composite(uint32_t *frame, size_t base, size_t stride, unsigned w, unsigned h,
+                                        size_t start, size_t stop, F blend) const {
+      if (!isVisible()) return;
+      if (w > _w) w = _w;
+      if (h > _h) h = _h;
+      for (unsigned j = 0; j < h; j++) {
+        const size_t row = base + j * stride;
+        if (row >= stop) break;
+        const size_t a = row > start ? row : start;
+        const size_t b = row + w < stop ? row + w : stop;
+        for (size_t i = a, k = j * _w + (a - row); i < b; i++, k++) {
+          if (!_alpha[k]) continue;
+          const uint8_t o = _opacity == 255 ? _alpha[k] : (_alpha[k] * (_opacity + 1)) >> 8;
+          frame[i] = color_blend(frame[i], blend(_px[k], frame[i]), o);
+        }
+      }
+    }
+
+  private:
+    uint32_t *_px = nullptr;
+    uint8_t  *_alpha = nullptr;   // behind the pixels (same allocation)
+    uint16_t  _w = 0, _h = 0;
+    uint16_t  _x = 0, _y = 0;
+    int8_t    _segment = -1;
+    uint8_t   _opacity = 255;
+    uint8_t   _blendMode = 0;     // like Segment::blendMode
+    bool      _visible = true;
+    bool      _changed = true;    // content or placement changed since the last show()
+    size_t    _shownStart = 0, _shownStop = 0; // frame buffer span covered in the last show()
+};
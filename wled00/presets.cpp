@@ -26,6 +26,10 @@ bool presetNeedsSaving() {
   return presetToSave;
 }
 
+bool presetNeedsApplying() {
+  return presetToApply;
+}
+
 static void doSaveState() {
   bool persist = (presetToSave < 251);
 
@@ -0,0 +1,134 @@
+/* render_profile.h
+
+Lightweight render profiling of strip.service() and strip.show().
+
+The time of every effect call and segment blend is recorded per segment (together with the effect it ran), the time
+of the rendering stages (all effects, blending, overlays, gamma/mapping, bus output, whole frame) per stage. Times are
+taken from the CPU cycle counter (a single register read) on the controller and from std::chrono on a host build.
+Statistics are kept over windows of RENDER_PROFILE_WINDOW samples: min, average and max of the last complete window
+are published (in us), so they follow changes quickly and cost nothing to read.
+
+Profiling is compiled in unless WLED_DISABLE_RENDER_PROFILE is defined, the RENDER_PROFILE_* macros are then empty.
+
+*/
+
+#pragma once
+
+#include <stdint.h>
+#ifndef ARDUINO
+  #include <chrono>
+#endif
+
+#ifndef RENDER_PROFILE_WINDOW
+  #define RENDER_PROFILE_WINDOW   32    // samples per statistics window
+#endif
+#ifndef RENDER_PROFILE_SEGMENTS
+  #ifdef ESP8266
+    #define RENDER_PROFILE_SEGMENTS 8   // segments profiled individually
+  #else
+    #define RENDER_PROFILE_SEGMENTS 32
+  #endif
+#endif
+
+#define RENDER_STAGE_EFFECTS  0   // all effect calls
+#define RENDER_STAGE_BLEND    1   // blending segments into the frame buffer
+#define RENDER_STAGE_OVERLAY  2   // show callback (realtime, overlays)
+#define RENDER_STAGE_PAINT    3   // gamma, white balance and mapping into bus buffers
+#define RENDER_STAGE_BUS      4   // BusManager::show()
+#define RENDER_STAGE_FRAME    5   // whole frame in service()
+#define RENDER_STAGE_LAYERS   6   // compositing overlay layers (overlay_layer.h)
+#define RENDER_STAGES         7
+
+#define RENDER_SEG_EFFECT     0   // effect function of a segment (including the old effect during transitions)
+#define RENDER_SEG_BLEND      1   // blending a segment into the frame buffer
+
+class RenderProfiler {
+  public:
+    struct Stat {
+      uint32_t min, avg, max;   // us, last complete window
+      uint32_t samples;         // total
+    };
+
+    // current time in ticks (wraps, only differences are meaningful)
+    static inline uint32_t ticks() {
+      #ifdef ARDUINO
+      return ESP.getCycleCount();
+      #else
+      return uint32_t(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+      #endif
+    }
+
+    static inline uint32_t ticksPerUs() {
+      #ifdef ARDUINO
+      return ESP.getCpuFreqMHz();
+      #else
+      return 1000;
+      #endif
+    }
+
+    inline void addStage(unsigned stage, uint32_t t) {
+      if (stage < RENDER_STAGES) add(_stage[stage], t);
+    }
+
+    // kind is RENDER_SEG_EFFECT or RENDER_SEG_BLEND, statistics of a segment restart when its effect changes
+    void addSegment(unsigned seg, uint8_t mode, unsigned kind, uint32_t t) {
+      if (seg >= RENDER_PROFILE_SEGMENTS || kind > RENDER_SEG_BLEND) return;
+      SegmentSeries& s = _seg[seg];
+      if (mode != s.mode) {
+        s = {};
+        s.mode = mode;
+      }
+      add(s.series[kind], t);
+    }
+
+    inline const Stat& stage(unsigned stage) const { return _stage[stage < RENDER_STAGES ? stage : 0].stat; }
+    inline const Stat& segment(unsigned seg, unsigned kind) const {
+      return _seg[seg < RENDER_PROFILE_SEGMENTS ? seg : 0].series[kind ? RENDER_SEG_BLEND : RENDER_SEG_EFFECT].stat;
+    }
+    inline uint8_t segmentMode(unsigned seg) const { return seg < RENDER_PROFILE_SEGMENTS ? _seg[seg].mode : 0; }
+
+    void reset() {
+      for (unsigned i = 0; i < RENDER_STAGES; i++) _stage[i] = {};
+      for (unsigned i = 0; i < RENDER_PROFILE_SEGMENTS; i++) _seg[i] = {};
+    }
+
+  private:
+    struct Series {
+      Stat     stat;
+      uint32_t sum;       // ticks of current window (saturating)
+      uint32_t lo, hi;
+      uint16_t n;
+    };
+    struct SegmentSeries {
+      Series  series[2];
+      uint8_t mode;
+    };
+    Series        _stage[RENDER_STAGES] = {};
+    SegmentSeries _seg[RENDER_PROFILE_SEGMENTS] = {};
+
+    static void add(Series& s, uint32_t t) {
+      if (!s.n || t < s.lo) s.lo = t;
+      if (!s.n || t > s.hi) s.hi = t;
+      s.sum = s.sum + t < s.sum ? UINT32_MAX : s.sum + t;
+      s.stat.samples++;
+      if (++s.n < RENDER_PROFILE_WINDOW && s.stat.samples > RENDER_PROFILE_WINDOW) return;
+      // window complete (the first window is published with every sample)
+      const uint32_t tpu = ticksPerUs();
+      s.stat.min = s.lo / tpu;
+      s.stat.avg = s.sum / s.n / tpu;
+      s.stat.max = s.hi / tpu;
+      if (s.n < RENDER_PROFILE_WINDOW) return;
+      s.n = 0;
+      s.sum = 0;
+    }
+};
+
+#ifndef WLED_DISABLE_RENDER_PROFILE
+  #define RENDER_PROFILE_START(t)                   const uint32_t t = RenderProfiler::ticks()
+  #define RENDER_PROFILE_STAGE(stage, t)            renderProfiler.addStage(stage, RenderProfiler::ticks() - (t))
+  #define RENDER_PROFILE_SEGMENT(seg, mode, kind, t) renderProfiler.addSegment(seg, mode, kind, RenderProfiler::ticks() - (t))
+#else
+  #define RENDER_PROFILE_START(t)
+  #define RENDER_PROFILE_STAGE(stage, t)
+  #define RENDER_PROFILE_SEGMENT(seg, mode, kind, t)
+#endif
@@ -0,0 +1,387 @@
+/* schedule.h
+
+Schedule engine for timers: presets applied at a time of day, relative to sunrise/sunset or by a cron expression.
+
+Times are local seconds since 1970 (like localTime). The next instant every entry fires is computed once and kept in
+a min-heap, so update() only compares the top of the heap with the current time. An entry is recomputed when it
+fires, all entries are recomputed when the configuration changes (invalidate()), the UTC offset changes (timezone or
+DST transition) or the clock jumps (time set, NTP sync). Like the per-minute scan this replaces, local times skipped
+by a DST transition do not fire and repeated ones fire again.
+
+Cron expressions have 6 fields (second minute hour day-of-month month day-of-week) or 5 (second 0). A field is a
+comma separated list of values a, ranges a-b or every value (star), each optionally with a step (/n), a/n is a to the
+end of the range. Day of week is 0-7, 0 and 7 are Sunday. @yearly, @monthly, @weekly, @daily and @hourly are accepted
+as well. If both day of month and day of week are restricted, a day matches either of them (like cron).
+
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define SCHEDULE_SUNRISE     1
+#define SCHEDULE_SUNSET      2
+
+#ifndef SCHEDULE_MAX_CATCHUP
+  #define SCHEDULE_MAX_CATCHUP 60   // s the clock may advance between two updates, entries missed meanwhile still fire
+#endif
+#define SCHEDULE_HORIZON     (8*366) // days searched for the next instant (Feb 29 across 2100)
+#define SCHEDULE_SUN_HORIZON 366     // days searched for sunrise/sunset, sun times repeat yearly and cost float math per day
+#define CRON_MAX_LEN         320     // longest expression printed by cronPrint() (including terminator)
+
+#define CRON_ALL_DAYS        0xFFFFFFFEUL
+#define CRON_ALL_MONTHS      0x1FFE
+#define CRON_ALL_WEEKDAYS    0x7F
+
+struct CronSpec {
+  uint64_t seconds;   // bit 0-59
+  uint64_t minutes;   // bit 0-59
+  uint32_t hours;     // bit 0-23
+  uint32_t days;      // bit 1-31
+  uint16_t months;    // bit 1-12
+  uint8_t  weekdays;  // bit 0-6, Sunday first
+};
+
+struct ScheduleRule {
+  CronSpec time;      // time of day is ignored for sun
+  uint8_t  sun;       // 0, SCHEDULE_SUNRISE or SCHEDULE_SUNSET
+  int16_t  offset;    // minutes relative to sunrise/sunset
+  uint8_t  monthStart, dayStart, monthEnd, dayEnd; // additional date range (isTodayInDateRange()), 0: none
+};
+
+// timer applying a preset by a cron expression (cronTimers)
+struct CronTimer {
+  CronSpec time;
+  uint8_t  preset;
+  bool     enabled;
+};
+
+// local minutes after midnight of sunrise/sunset on day (days since 1970), -1 if there is none
+typedef int (*ScheduleSunFn)(uint32_t day, bool sunset);
+
+/*
+ * calendar
+ */
+// civil date of days since 1970 (proleptic Gregorian calendar)
+static inline void scheduleDate(uint32_t days, unsigned& year, unsigned& month, unsigned& day) {
+  const uint32_t z   = days + 719468;
+  const uint32_t era = z / 146097;
+  const uint32_t doe = z - era * 146097;                                // [0, 146096]
+  const uint32_t yoe = (doe - doe/1460 + doe/36524 - doe/146096) / 365; // [0, 399]
+  const uint32_t doy = doe - (365*yoe + yoe/4 - yoe/100);               // [0, 365], March first
+  const uint32_t mp  = (5*doy + 2) / 153;                               // [0, 11]
+  day   = doy - (153*mp + 2)/5 + 1;
+  month = mp < 10 ? mp + 3 : mp - 9;
+  year  = yoe + era * 400 + (month <= 2);
+}
+
+static inline unsigned scheduleWeekday(uint32_t days) {
+  return (days + 4) % 7; // 1970-01-01 was a Thursday, 0 is Sunday
+}
+
+// date range of a timer, monthStart or dayStart 0 is every day
+static bool scheduleDateInRange(unsigned monthStart, unsigned dayStart, unsigned monthEnd, unsigned dayEnd, unsigned m, unsigned d) {
+  if (monthStart == 0 || dayStart == 0) return true;
+  if (monthEnd == 0) monthEnd = monthStart;
+  if (dayEnd == 0) dayEnd = 31;
+
+  if (monthStart < monthEnd) {
+    if (m > monthStart && m < monthEnd) return true;
+    if (m == monthStart) return (d >= dayStart);
+    if (m == monthEnd) return (d <= dayEnd);
+    return false;
+  }
+  if (monthEnd < monthStart) { //range spans change of year
+    if (m > monthStart || m < monthEnd) return true;
+    if (m == monthStart) return (d >= dayStart);
+    if (m == monthEnd) return (d <= dayEnd);
+    return false;
+  }
+
+  //start month and end month are the same
+  if (dayEnd < dayStart) return (m != monthStart || (d <= dayEnd || d >= dayStart)); //all year, except the designated days in this month
+  return (m == monthStart && d >= dayStart && d <= dayEnd); //just the designated days this month
+}
+
+/*
+ * cron expressions
+ */
+static const char* cronNumber(const char* p, unsigned& v) {
+  if (*p < '0' || *p > '9') return nullptr;
+  for (v = 0; *p >= '0' && *p <= '9' && v < 100; p++) v = v * 10 + (*p - '0');
+  return p;
+}
+
+// one field (values lo-hi) into bits, returns the position behind it or nullptr
+static const char* cronField(const char* p, unsigned lo, unsigned hi, uint64_t& bits) {
+  bits = 0;
+  do {
+    unsigned a = lo, b = hi, step = 1;
+    if (*p == '*') p++;
+    else {
+      if (!(p = cronNumber(p, a))) return nullptr;
+      b = a;
+      if (*p == '-') {
+        if (!(p = cronNumber(p + 1, b))) return nullptr;
+      } else if (*p == '/') b = hi;                 // a/n: a to the end of the range
+    }
+    if (*p == '/' && (!(p = cronNumber(p + 1, step)) || step == 0)) return nullptr;
+    if (a < lo || b > hi || a > b) return nullptr;
+    for (unsigned v = a; v <= b; v += step) bits |= 1ULL << v;
+  } while (*p == ',' && p++);
+  return *p == ' ' || *p == '\t' || *p == 0 ? p : nullptr;
+}
+
+// parse a cron expression, returns false if it is invalid
+static bool cronParse(const char* s, CronSpec& c) {
+  static const struct { const char* name; const char* expr; } macros[] = {
+    {"@yearly", "0 0 0 1 1 *"}, {"@annually", "0 0 0 1 1 *"}, {"@monthly", "0 0 0 1 * *"},
+    {"@weekly", "0 0 0 * * 0"}, {"@daily", "0 0 0 * * *"}, {"@midnight", "0 0 0 * * *"}, {"@hourly", "0 0 * * * *"}
+  };
+  if (!s) return false;
+  while (*s == ' ' || *s == '\t') s++;
+  if (*s == '@') {
+    for (const auto& m : macros) {
+      const char *a = s, *b = m.name;
+      while (*b && *a == *b) a++, b++;
+      if (!*b && (*a == 0 || *a == ' ')) return cronParse(m.expr, c);
+    }
+    return false;
+  }
+  unsigned fields = 0;
+  for (const char* p = s; *p; ) {
+    fields++;
+    while (*p && *p != ' ' && *p != '\t') p++;
+    while (*p == ' ' || *p == '\t') p++;
+  }
+  if (fields != 5 && fields != 6) return false;
+
+  static const uint8_t range[6][2] = {{0,59}, {0,59}, {0,23}, {1,31}, {1,12}, {0,7}};
+  uint64_t bits[6] = {1, 0, 0, 0, 0, 0}; // second 0 if omitted
+  const char* p = s;
+  for (unsigned f = 6 - fields; f < 6; f++) {
+    if (!(p = cronField(p, range[f][0], range[f][1], bits[f]))) return false;
+    while (*p == ' ' || *p == '\t') p++;
+  }
+  c.seconds  = bits[0];
+  c.minutes  = bits[1];
+  c.hours    = bits[2];
+  c.days     = bits[3];
+  c.months   = bits[4];
+  c.weekdays = (bits[5] | (bits[5] >> 7)) & CRON_ALL_WEEKDAYS; // 7 is Sunday
+  return true;
+}
+
+// print one field, lists ranges and evenly stepped values compactly
+static size_t cronPrintField(char* out, size_t pos, size_t len, uint64_t bits, unsigned lo, unsigned hi) {
+  auto put = [&](char ch) { if (pos + 1 < len) out[pos] = ch; pos++; };
+  auto num = [&](unsigned v) { if (v >= 10) put('0' + v / 10); put('0' + v % 10); };
+  const uint64_t all = ((2ULL << hi) - 1) & ~((1ULL << lo) - 1);
+  bits &= all;
+  if (bits == all || !bits) { // an empty field cannot be expressed (cronParse() never returns one)
+    put('*');
+    return pos;
+  }
+  // a-b/n (*/n if it starts at lo and no further value would fit)
+  const unsigned first = __builtin_ctzll(bits), last = 63 - __builtin_clzll(bits);
+  uint64_t rest = bits & (bits - 1);
+  if (rest && (rest & (rest - 1))) {
+    const unsigned step = __builtin_ctzll(rest) - first;
+    uint64_t prog = 0;
+    for (unsigned v = first; v <= last; v += step) prog |= 1ULL << v;
+    if (step > 1 && prog == bits) {
+      if (first == lo && last + step > hi) put('*');
+      else { num(first); put('-'); num(last); }
+      put('/');
+      num(step);
+      return pos;
+    }
+  }
+  bool comma = false;
+  for (unsigned v = lo; v <= hi; v++) {
+    if (!((bits >> v) & 1)) continue;
+    unsigned e = v;
+    while (e < hi && ((bits >> (e + 1)) & 1)) e++;
+    if (comma) put(',');
+    num(v);
+    if (e > v) { put(e == v + 1 ? ',' : '-'); num(e); }
+    comma = true;
+    v = e;
+  }
+  return pos;
+}
+
+// print c as 6 field cron expression, returns its length (truncated if it is len or more)
+static size_t cronPrint(const CronSpec& c, char* out, size_t len) {
+  size_t pos = 0;
+  const uint64_t bits[6] = {c.seconds, c.minutes, c.hours, c.days, c.months, c.weekdays};
+  static const uint8_t range[6][2] = {{0,59}, {0,59}, {0,23}, {1,31}, {1,12}, {0,6}};
+  for (unsigned f = 0; f < 6; f++) {
+    if (f) { if (pos + 1 < len) out[pos] = ' '; pos++; }
+    pos = cronPrintField(out, pos, len, bits[f], range[f][0], range[f][1]);
+  }
+  if (len) out[pos < len ? pos : len - 1] = 0;
+  return pos;
+}
+
+/*
+ * next instant of a rule
+ */
+static bool scheduleDayMatches(const ScheduleRule& r, uint32_t day) {
+  unsigned y, m, d;
+  scheduleDate(day, y, m, d);
+  const CronSpec& c = r.time;
+  if (!((c.months >> m) & 1)) return false;
+  const bool dom = (c.days >> d) & 1;
+  const bool dow = (c.weekdays >> scheduleWeekday(day)) & 1;
+  const bool dayOk = c.days == CRON_ALL_DAYS ? dow : c.weekdays == CRON_ALL_WEEKDAYS ? dom : dom || dow;
+  return dayOk && scheduleDateInRange(r.monthStart, r.dayStart, r.monthEnd, r.dayEnd, m, d);
+}
+
+// first second of the day >= sod matching the time of c, -1 if none
+static int32_t scheduleTimeOfDay(const CronSpec& c, uint32_t sod) {
+  unsigned h = sod / 3600, mi = (sod / 60) % 60, s = sod % 60;
+  for (; h < 24; h++, mi = 0, s = 0) {
+    if (!((c.hours >> h) & 1)) continue;
+    for (; mi < 60; mi++, s = 0) {
+      if (!((c.minutes >> mi) & 1)) continue;
+      const uint64_t rest = (c.seconds & ((1ULL << 60) - 1)) >> s;
+      if (rest) return h * 3600 + mi * 60 + s + __builtin_ctzll(rest);
+    }
+  }
+  return -1;
+}
+
+// first instant after the given one the rule fires, 0 if none within SCHEDULE_HORIZON (SCHEDULE_SUN_HORIZON for sun
+// rules, so a location without sunrise/sunset does not stall the loop; the entry is searched again on the next rebuild)
+static uint32_t scheduleNext(const ScheduleRule& r, uint32_t after, ScheduleSunFn sunFn) {
+  const uint32_t t = after + 1;
+  const unsigned horizon = r.sun ? SCHEDULE_SUN_HORIZON : SCHEDULE_HORIZON;
+  uint32_t sod = t % 86400;
+  uint32_t day = t / 86400;
+  for (unsigned n = 0; n < horizon; n++, day++, sod = 0) {
+    if (!scheduleDayMatches(r, day)) continue;
+    int32_t at;
+    if (r.sun) {
+      const int sun = sunFn ? sunFn(day, r.sun == SCHEDULE_SUNSET) : -1;
+      if (sun < 0) continue;
+      at = ((sun + r.offset) % 1440 + 1440) % 1440 * 60; // the time of day is used, like the minute compare did
+      if (at < (int32_t)sod) continue;
+    } else {
+      at = scheduleTimeOfDay(r.time, sod);
+      if (at < 0) continue;
+    }
+    return day * 86400 + at;
+  }
+  return 0;
+}
+
+class Schedule {
+  public:
+    // rule of entry id, false if the entry is disabled
+    typedef bool (*RuleFn)(unsigned id, ScheduleRule& rule);
+
+    struct Stats {
+      uint32_t rebuilds;    // full recomputations
+      uint32_t computed;    // next instants computed
+      uint32_t fired;
+    } stats = {};
+
+    Schedule(RuleFn ruleFn, ScheduleSunFn sunFn) : _ruleFn(ruleFn), _sunFn(sunFn) {}
+    ~Schedule() { end(); }
+    Schedule(const Schedule&) = delete;
+    Schedule& operator=(const Schedule&) = delete;
+
+    // free the heap
+    void end() {
+      if (_heap) p_free(_heap);
+      _heap = nullptr;
+      _size = _cap = 0;
+      _valid = false;
+    }
+
+    // configuration changed (entries, location), recompute all entries on the next update()
+    inline void invalidate() { _valid = false; }
+
+    // call at least every second with the local time and UTC offset (s), fire(id) is called for every entry due
+    template<typename F> void update(uint32_t now, int32_t offset, unsigned count, F fire) {
+      if (!_valid || count != _count || offset != _offset || now < _last || now - _last > SCHEDULE_MAX_CATCHUP)
+        rebuild(now - 1, count); // entries due this second still fire
+      _last = now;
+      _offset = offset;
+      while (_valid && _size && _heap[0].at <= now) {
+        const unsigned id = _heap[0].id;
+        fire(id);
+        stats.fired++;
+        if (!_valid) break; // fire() changed the configuration
+        const uint32_t next = compute(id, now);
+        if (next) _heap[0].at = next;
+        else      _heap[0] = _heap[--_size];
+        siftDown(0);
+      }
+    }
+
+    // next instant an entry fires (0 if none), id of that entry
+    inline uint32_t next(unsigned* id = nullptr) const {
+      if (!_size) return 0;
+      if (id) *id = _heap[0].id;
+      return _heap[0].at;
+    }
+    inline unsigned size() const { return _size; }
+
+  private:
+    struct Item {
+      uint32_t at;
+      uint16_t id;
+    };
+    Item*         _heap = nullptr;
+    unsigned      _size = 0, _cap = 0;
+    unsigned      _count = 0;     // entries the heap was built for
+    uint32_t      _last = 0;      // time of the last update
+    int32_t       _offset = 0;
+    RuleFn        _ruleFn;
+    ScheduleSunFn _sunFn;
+    bool          _valid = false;
+
+    inline bool before(const Item& a, const Item& b) const { return a.at < b.at || (a.at == b.at && a.id < b.id); }
+
+    uint32_t compute(unsigned id, uint32_t after) {
+      ScheduleRule r;
+      if (!_ruleFn(id, r)) return 0;
+      stats.computed++;
+      return scheduleNext(r, after, _sunFn);
+    }
+
+    void siftDown(unsigned i) {
+      while (true) {
+        unsigned m = i, l = 2*i + 1, r = l + 1;
+        if (l < _size && before(_heap[l], _heap[m])) m = l;
+        if (r < _size && before(_heap[r], _heap[m])) m = r;
+        if (m == i) return;
+        const Item tmp = _heap[i];
+        _heap[i] = _heap[m];
+        _heap[m] = tmp;
+        i = m;
+      }
+    }
+
+    void rebuild(uint32_t after, unsigned count) {
+      if (count > UINT16_MAX) count = UINT16_MAX;
+      if (count > _cap || count < _cap / 2) {
+        if (_heap) p_free(_heap);
+        _heap = count ? (Item*)p_malloc(count * sizeof(Item)) : nullptr;
+        _cap = _heap ? count : 0;
+      }
+      _size = 0;
+      _count = count;
+      _valid = true;
+      stats.rebuilds++;
+      if (!_heap) return;
+      for (unsigned id = 0; id < count; id++) {
+        const uint32_t at = compute(id, after);
+        if (at) _heap[_size++] = {at, (uint16_t)id};
+      }
+      for (unsigned i = _size / 2; i-- > 0; ) siftDown(i); // heapify
+    }
+};
@@ -0,0 +1,323 @@
+/* serial_frames.h
+
+Framed binary protocol for high-throughput LED streaming over serial (USB CDC or UART).
+
+Frame (all multi-byte values big endian):
+  [0]     SERIAL_FRAME_START
+  [1]     type (SERIAL_FRAME_PIXELS, SERIAL_FRAME_BAUD)
+  [2]     flags (SERIAL_FLAG_*)
+  [3]     sequence number
+  [4..5]  first pixel
+  [6..7]  pixel count
+  [8..9]  payload length
+  [10..]  payload
+  [n..n+1] CRC-16/CCITT (poly 0x1021, init 0xFFFF) of bytes 1 to end of payload
+
+Pixel payload is R,G,B(,W with SERIAL_FLAG_RGBW) per pixel. With SERIAL_FLAG_RLE it is a sequence of runs,
+control byte c < 128: c+1 literal pixels follow, c >= 128: one pixel follows that is repeated c-126 times.
+With SERIAL_FLAG_DELTA pixels are XORed onto the previous frame (unchanged pixels are 0 and compress well),
+which is only accepted if its sequence number directly follows the last frame, otherwise a key frame is requested.
+Baud payload is the new baud rate (4 bytes), it is switched to after the acknowledgement was sent.
+
+With SERIAL_FLAG_ACK (and always for baud frames) the receiver answers
+  SERIAL_FRAME_START, SERIAL_FRAME_ACK, sequence number, status (SERIAL_ACK_*)
+so the sender can wait for it before sending the next frame (flow control).
+
+The whole frame is read in bulk into a buffer and checked before any pixel is changed, pixels are then decoded
+into a frame buffer that is committed to the strip as a whole. The receive buffer is allocated once a valid header
+arrived, the frame buffer with the first frame that passed the checksum, so stray start bytes cost no memory. Both
+are freed again if no valid frame arrived for SERIAL_FRAME_RELEASE ms.
+
+After a rejected (invalid header, checksum mismatch) or timed out frame the rest of it must not be taken for
+commands or Adalight data: the payload announced by the header is dropped, then every byte up to the next start
+byte, until the line was idle for SERIAL_FRAME_TIMEOUT ms.
+
+handleSerial() (wled_serial.cpp) calls start() when its command parser sees a start byte and hands all bytes to
+receive() while active(), handle() is called once per loop.
+
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+
+#define SERIAL_FRAME_START    0xC5
+#define SERIAL_FRAME_PIXELS   0x01
+#define SERIAL_FRAME_BAUD     0x02
+#define SERIAL_FRAME_ACK      0x81
+
+#define SERIAL_FLAG_RGBW      0x01
+#define SERIAL_FLAG_RLE       0x02
+#define SERIAL_FLAG_DELTA     0x04
+#define SERIAL_FLAG_ACK       0x08
+
+#define SERIAL_ACK_OK         0
+#define SERIAL_ACK_CRC        1   // checksum mismatch, frame discarded
+#define SERIAL_ACK_FORMAT     2   // invalid header or payload
+#define SERIAL_ACK_KEYFRAME   3   // delta frame does not follow the last frame, send a full frame
+#define SERIAL_ACK_NOMEM      4   // not enough memory for frame
+
+#define SERIAL_FRAME_INCOMPLETE -1
+#define SERIAL_FRAME_HEADER   9   // bytes after start byte up to payload
+#ifndef SERIAL_FRAME_TIMEOUT
+  #define SERIAL_FRAME_TIMEOUT 100 // ms a started frame may take until it is discarded
+#endif
+#ifndef SERIAL_FRAME_RELEASE
+  #define SERIAL_FRAME_RELEASE 10000 // ms without a valid frame until the buffers are freed
+#endif
+
+class SerialFrameDecoder {
+  public:
+    struct Stats {
+      uint32_t frames;      // frames accepted
+      uint32_t crcErrors;   // frames discarded because of checksum mismatch
+      uint32_t errors;      // frames discarded because of invalid format or missing memory
+      uint32_t keyframes;   // delta frames rejected because the previous frame is unknown
+      uint32_t bytes;       // bytes received in frames
+    } stats = {};
+
+    SerialFrameDecoder() {}
+    ~SerialFrameDecoder() { end(); }
+    SerialFrameDecoder(const SerialFrameDecoder&) = delete;
+    SerialFrameDecoder& operator=(const SerialFrameDecoder&) = delete;
+
+    // set number of LEDs (frames addressing more are rejected), buffers are allocated when valid frames arrive
+    void begin(unsigned leds) {
+      if (leds == _leds) return;
+      end();
+      _leds = leds;
+    }
+
+    void end() {
+      freeBuffers();
+      _leds = 0;
+      _state = RX_IDLE;
+    }
+
+    // start byte received, a new frame follows
+    void start(unsigned long now) {
+      _pos = 0;
+      _length = SERIAL_FRAME_HEADER;
+      _skip = 0;
+      _started = now;
+      _state = RX_FRAME;
+    }
+
+    // call regularly: a timed out frame is discarded, discarding ends once the line was idle, buffers are freed
+    // if no valid frame arrived for SERIAL_FRAME_RELEASE ms
+    void handle(unsigned long now) {
+      if (_state == RX_FRAME && timedOut(now)) {
+        abort();
+        dropped(0, now);
+        _state = RX_DISCARD;
+      }
+      if (_state == RX_DISCARD && timedOut(now)) _state = RX_IDLE;
+      if (_state == RX_IDLE && (_pixels || _rx) && now - _lastFrame > SERIAL_FRAME_RELEASE) freeBuffers();
+    }
+
+    // bytes on the line belong to a frame (being received or discarded), hand them to receive()
+    inline bool active() const { return _state != RX_IDLE; }
+
+    // read the current frame from stream (Serial) in bulk as far as available, or drop bytes of a rejected one
+    // completed frames are acknowledged if requested and ack is set (TX allowed)
+    // returns SERIAL_FRAME_INCOMPLETE or the status of the completed frame
+    template<class S> int receive(S& stream, unsigned long now, bool ack) {
+      if (_state == RX_DISCARD) {
+        // drop the rest of a rejected frame: the announced payload, then anything up to the next start byte
+        uint8_t buf[64];
+        unsigned n = unsigned(stream.available());
+        if (n > _skip) n = _skip;
+        if (n > sizeof(buf)) n = sizeof(buf);
+        if (n)                                      n = stream.readBytes(buf, n);
+        else if (stream.peek() != SERIAL_FRAME_START) n = stream.readBytes(buf, 1);
+        else _state = RX_IDLE; // starts the next frame
+        dropped(n, now);
+        return SERIAL_FRAME_INCOMPLETE;
+      }
+      if (_state != RX_FRAME) return SERIAL_FRAME_INCOMPLETE;
+
+      int status;
+      do {
+        unsigned n = unsigned(stream.available());
+        if (n > missing()) n = missing();
+        if (n == 0) return SERIAL_FRAME_INCOMPLETE;
+        status = received(stream.readBytes(buffer(), n));
+      } while (status == SERIAL_FRAME_INCOMPLETE);
+
+      if (ack && wantsAck()) {
+        const uint8_t reply[4] = {SERIAL_FRAME_START, SERIAL_FRAME_ACK, sequence(), uint8_t(status)};
+        stream.write(reply, sizeof(reply));
+      }
+      if (rejected(status)) {
+        dropped(0, now);
+        _state = RX_DISCARD;
+      } else _state = RX_IDLE;
+      return status;
+    }
+
+    // frame timed out: the bytes still expected are part of it
+    void abort() {
+      _skip = _pos >= SERIAL_FRAME_HEADER ? _length - _pos : 0;
+      _pos = _length = 0;
+    }
+
+    // status of a completed frame: the rest of the frame may still follow and has to be discarded
+    static inline bool rejected(int status) { return status != SERIAL_FRAME_INCOMPLETE && status != SERIAL_ACK_OK && status != SERIAL_ACK_KEYFRAME; }
+
+    // discarding a rejected frame: bytes of it that are still to come for sure, n bytes dropped at time now
+    // (timedOut() tells if the line was idle long enough to end discarding)
+    inline unsigned remaining() const { return _skip; }
+    inline void dropped(unsigned n, unsigned long now) { _skip -= n < _skip ? n : _skip; _started = now; }
+
+    // where to read received bytes to and how many are (at most) expected, for bulk reads
+    inline uint8_t* buffer()        { return (_pos < SERIAL_FRAME_HEADER ? _header : _rx) + (_pos < SERIAL_FRAME_HEADER ? _pos : _pos - SERIAL_FRAME_HEADER); }
+    inline unsigned missing() const { return (_pos < SERIAL_FRAME_HEADER ? SERIAL_FRAME_HEADER : _length) - _pos; }
+    inline bool     timedOut(unsigned long now) const { return now - _started > SERIAL_FRAME_TIMEOUT; }
+
+    // n bytes were read to buffer(), returns SERIAL_FRAME_INCOMPLETE or the status (SERIAL_ACK_*) of the completed frame
+    int received(unsigned n) {
+      stats.bytes += n;
+      _pos += n;
+      if (_pos == SERIAL_FRAME_HEADER) {
+        // header complete: check it and make room for payload and CRC
+        const unsigned length = payloadLength() + 2;
+        if (type() == SERIAL_FRAME_PIXELS) {
+          const unsigned bpp = bytesPerPixel();
+          if (first() + count() > _leds || length - 2 > count() * bpp + (count() + 127) / 128) return error(SERIAL_ACK_FORMAT);
+        } else if (type() != SERIAL_FRAME_BAUD || length - 2 != 4) return error(SERIAL_ACK_FORMAT);
+        if (length > _rxSize) {
+          if (_rx) d_free(_rx);
+          else if (!_pixels) _lastFrame = _started; // release timer starts with the first buffer
+          _rx = (uint8_t*)d_malloc(length);
+          _rxSize = _rx ? length : 0;
+          if (!_rx) return error(SERIAL_ACK_NOMEM);
+        }
+        _length = SERIAL_FRAME_HEADER + length;
+      }
+      if (_pos < _length) return SERIAL_FRAME_INCOMPLETE;
+
+      // frame complete
+      const unsigned len = payloadLength();
+      uint16_t crc = crc16(0xFFFF, _header, SERIAL_FRAME_HEADER);
+      crc = crc16(crc, _rx, len);
+      if (crc != ((_rx[len] << 8) | _rx[len+1])) {
+        stats.crcErrors++;
+        return SERIAL_ACK_CRC;
+      }
+      if (type() == SERIAL_FRAME_PIXELS) {
+        if ((flags() & SERIAL_FLAG_DELTA) && (!_valid || sequence() != uint8_t(_sequence + 1))) {
+          stats.keyframes++;
+          return SERIAL_ACK_KEYFRAME;
+        }
+        if (!_pixels) {
+          _pixels = (uint32_t*)d_malloc(_leds * sizeof(uint32_t));
+          if (!_pixels) return error(SERIAL_ACK_NOMEM);
+          memset(_pixels, 0, _leds * sizeof(uint32_t));
+        }
+        if (!decode()) {
+          _valid = false; // frame buffer was partially modified
+          return error(SERIAL_ACK_FORMAT);
+        }
+        _valid = true;
+        _sequence = sequence();
+      }
+      stats.frames++;
+      _lastFrame = _started;
+      return SERIAL_ACK_OK;
+    }
+
+    inline uint8_t  type() const     { return _header[0]; }
+    inline uint8_t  flags() const    { return _header[1]; }
+    inline uint8_t  sequence() const { return _header[2]; }
+    inline unsigned first() const    { return (_header[3] << 8) | _header[4]; }
+    inline unsigned count() const    { return (_header[5] << 8) | _header[6]; }
+    inline bool     wantsAck() const { return (flags() & SERIAL_FLAG_ACK) || type() == SERIAL_FRAME_BAUD; }
+    inline uint32_t baudRate() const { return (uint32_t(_rx[0]) << 24) | (uint32_t(_rx[1]) << 16) | (_rx[2] << 8) | _rx[3]; }
+    inline const uint32_t* pixels() const { return _pixels; } // nullptr until the first pixel frame was accepted
+    inline unsigned length() const  { return _leds; }
+    inline size_t   allocated() const { return (_pixels ? _leds * sizeof(uint32_t) : 0) + _rxSize; } // bytes of buffers held
+
+    static uint16_t crc16(uint16_t crc, const uint8_t* data, unsigned len) {
+      static const uint16_t table[16] = {
+        0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+        0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF
+      };
+      for (unsigned i = 0; i < len; i++) {
+        crc = (crc << 4) ^ table[(crc >> 12) ^ (data[i] >> 4)];
+        crc = (crc << 4) ^ table[(crc >> 12) ^ (data[i] & 0x0F)];
+      }
+      return crc;
+    }
+
+  private:
+    enum : uint8_t { RX_IDLE, RX_FRAME, RX_DISCARD };
+
+    uint32_t*     _pixels = nullptr;  // frame buffer (last decoded frame, base for delta frames)
+    unsigned      _leds = 0;
+    uint8_t*      _rx = nullptr;      // payload and CRC
+    unsigned      _rxSize = 0;
+    uint8_t       _header[SERIAL_FRAME_HEADER];
+    unsigned      _pos = 0;           // bytes of current frame received (after start byte)
+    unsigned      _length = 0;        // bytes of current frame expected (after start byte)
+    unsigned      _skip = 0;          // bytes of a rejected frame still to be dropped
+    unsigned long _started = 0;
+    unsigned long _lastFrame = 0;     // start of the last valid frame (or of the first buffer allocation)
+    uint8_t       _state = RX_IDLE;
+    uint8_t       _sequence = 0;      // sequence number of last decoded frame
+    bool          _valid = false;     // frame buffer holds the sender's last frame
+
+    inline unsigned payloadLength() const { return (_header[7] << 8) | _header[8]; }
+    inline unsigned bytesPerPixel() const { return (flags() & SERIAL_FLAG_RGBW) ? 4 : 3; }
+
+    void freeBuffers() {
+      if (_pixels) d_free(_pixels);
+      if (_rx) d_free(_rx);
+      _pixels = nullptr;
+      _rx = nullptr;
+      _rxSize = 0;
+      _valid = false;
+    }
+
+    int error(int status) {
+      stats.errors++;
+      _skip = _pos == SERIAL_FRAME_HEADER ? payloadLength() + 2 : 0; // header rejected, payload and CRC follow
+      _pos = _length = 0;
+      return status;
+    }
+
+    inline void setPixel(unsigned i, const uint8_t* p, unsigned bpp, bool delta) {
+      const uint32_t c = RGBW32(p[0], p[1], p[2], bpp > 3 ? p[3] : 0);
+      if (delta) _pixels[i] ^= c;
+      else       _pixels[i] = c;
+    }
+
+    bool decode() {
+      const unsigned bpp = bytesPerPixel();
+      const bool delta = flags() & SERIAL_FLAG_DELTA;
+      const uint8_t* p = _rx;
+      const uint8_t* end = _rx + payloadLength();
+      unsigned i = first();
+      const unsigned stop = i + count();
+      if (!(flags() & SERIAL_FLAG_RLE)) {
+        if (unsigned(end - p) != count() * bpp) return false;
+        for (; i < stop; i++, p += bpp) setPixel(i, p, bpp, delta);
+        return true;
+      }
+      while (i < stop) {
+        if (p >= end) return false;
+        const uint8_t c = *p++;
+        if (c < 128) {
+          const unsigned n = c + 1;
+          if (n > stop - i || unsigned(end - p) < n * bpp) return false;
+          for (unsigned k = 0; k < n; k++, p += bpp) setPixel(i++, p, bpp, delta);
+        } else {
+          const unsigned n = c - 126;
+          if (n > stop - i || unsigned(end - p) < bpp) return false;
+          for (unsigned k = 0; k < n; k++) setPixel(i++, p, bpp, delta);
+          p += bpp;
+        }
+      }
+      return p == end;
+    }
+};
@@ -78,6 +78,14 @@ void DMXESPSerial::write(int Channel, uint8_t value) {
   dmxDataStore[Channel] = value;
 }
 
+// Function to send DMX data of several channels, starting with channel 1
+void DMXESPSerial::writeBytes(const uint8_t* data, int channels) {
+  if (dmxStarted == false) init();
+
+  if (channels > channelSize) channels = channelSize;
+  if (channels > 0) memcpy(dmxDataStore + 1, data, channels);
+}
+
 void DMXESPSerial::end() {
   channelSize = 0;
   Serial1.end();
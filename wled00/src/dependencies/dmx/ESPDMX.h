@@ -24,6 +24,7 @@ public:
   void init(int MaxChan);
   uint8_t read(int Channel);
   void write(int channel, uint8_t value);
+  void writeBytes(const uint8_t* data, int channels); // channels 1..channels at once
   void update();
   void end();
 };
@@ -135,6 +135,14 @@ void SparkFunDMX::write(int Channel, uint8_t value) {
 }
 
 
+// Function to send DMX data of several channels, starting with channel 1
+void SparkFunDMX::writeBytes(const uint8_t* data, int channels) {
+  if (channels > dmxMaxChannel) channels = dmxMaxChannel;
+  if (channels <= 0) return;
+  if (channels + 1 > chanSize) chanSize = channels + 1;
+  dmxData[0] = 0;
+  memcpy(dmxData + 1, data, channels);
+}
 
 void SparkFunDMX::update() {
   if (_READWRITE == _WRITE)
@@ -31,6 +31,7 @@ public:
   uint8_t read(int Channel);
 #endif
   void write(int channel, uint8_t value);
+  void writeBytes(const uint8_t* data, int channels); // channels 1..channels at once
   void update();
 private:
   const uint8_t _startCodeValue = 0xFF;
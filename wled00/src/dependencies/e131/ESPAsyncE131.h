@@ -72,6 +72,9 @@ typedef struct ip_addr ip4_addr_t;
 #define ARTNET_OPCODE_OPDMX 0x5000
 #define ARTNET_OPCODE_OPPOLL 0x2000
 #define ARTNET_OPCODE_OPPOLLREPLY 0x2100
+#define ARTNET_OPCODE_OPSYNC 0x5200
+
+#define E131_VECTOR_ROOT_EXTENDED 0x00000008 // root vector of E1.31 synchronization packets
 
 #define P_E131   0
 #define P_ARTNET 1
@@ -118,7 +121,7 @@ typedef union {
       uint32_t frame_vector;
       uint8_t  source_name[64];
       uint8_t  priority;
-      uint16_t reserved;
+      uint16_t sync_address;  // synchronization universe (0 = not synchronized)
       uint8_t  sequence_number;
       uint8_t  options;
       uint16_t universe;
@@ -133,6 +136,15 @@ typedef union {
       uint8_t  property_values[513];
     } __attribute__((packed));
 	
+  struct { //E1.31 synchronization packet
+    uint8_t  sync_root_layer[38];
+    uint16_t sync_flength;
+    uint32_t sync_vector;
+    uint8_t  sync_sequence_number;
+    uint16_t sync_universe;
+    uint16_t sync_reserved;
+  } __attribute__((packed));
+
 	struct { //Art-Net packet
     uint8_t  art_id[8];
     uint16_t art_opcode;
@@ -220,7 +232,9 @@ class ESPAsyncE131 {
     static const uint8_t ACN_ID[];
 	  static const uint8_t ART_ID[];
     static const uint32_t VECTOR_ROOT = 4;
+    static const uint32_t VECTOR_ROOT_EXTENDED = E131_VECTOR_ROOT_EXTENDED;
     static const uint32_t VECTOR_FRAME = 2;
+    static const uint32_t VECTOR_FRAME_SYNC = 1;
     static const uint8_t VECTOR_DMP = 2;
 
     AsyncUDP        udp;        // AsyncUDP
@@ -237,6 +251,9 @@ class ESPAsyncE131 {
  public:
     ESPAsyncE131(e131_packet_callback_function callback);
 
+    // E1.31 synchronization packet with valid ACN packet identifier and vectors
+    static bool isSyncPacket(const e131_packet_t *p);
+
     // Generic UDP listener, no physical or IP configuration
     bool begin(bool multicast, uint16_t port = E131_DEFAULT_PORT, uint16_t universe = 1, uint8_t n = 1);
 };
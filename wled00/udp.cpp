@@ -10,6 +10,18 @@
 #define UDP_IN_MAXSIZE 1472
 #define PRESUMED_NETWORK_DELAY 3 //how many ms could it take on avg to reach the receiver? This will be added to transmitted times
 
+#ifdef ARDUINO_ARCH_ESP32
+#include <esp_timer.h>
+#endif
+
+// clock synchronization with the sync leader (see clock_sync.h), sent on the notifier port
+#define CLOCKSYNC_TOKEN       0xFE  // first byte, distinct from notifier (0), realtime (1-5), TPM2 (0x9c) and API packets
+#define CLOCKSYNC_REQUEST     1
+#define CLOCKSYNC_RESPONSE    2
+#define CLOCKSYNC_PACKET_SIZE 32    // token, type, seq, reserved, t1, t2, t3 (uint64 us), leader effect time (ms) at t3
+#define CLOCKSYNC_INTERVAL    1000  // ms between requests
+#define CLOCKSYNC_INTERVAL_FAST 250 // ms between requests until the sample filter is filled
+
 typedef struct PartialEspNowPacket {
   uint8_t magic;
   uint8_t packet;
@@ -201,12 +213,99 @@ void notify(byte callMode, bool followUp)
     notifierUdp.write(udpOut, WLEDPACKETSIZE); // TODO: add actual used buffer size
     notifierUdp.endPacket();
   }
+  clockSyncLeader = IPAddress(); // we are the leader now, other nodes adopt our timebase
   notificationSentCallMode = callMode;
   notificationSentTime = millis();
   notificationCount = followUp ? notificationCount + 1 : 0;
 }
 
-static void parseNotifyPacket(const uint8_t *udpIn) {
+uint64_t clockSyncMicros() {
+#ifdef ESP8266
+  return micros64();
+#else
+  return esp_timer_get_time();
+#endif
+}
+
+static void putClockSyncTime(uint8_t *buf, uint64_t t) {
+  for (int i = 7; i >= 0; i--, t >>= 8) buf[i] = t & 0xFF;
+}
+
+static uint64_t getClockSyncTime(const uint8_t *buf) {
+  uint64_t t = 0;
+  for (unsigned i = 0; i < 8; i++) t = (t << 8) | buf[i];
+  return t;
+}
+
+static uint8_t  clockSyncSeq = 0;
+static unsigned clockSyncResponses = 0;   // responses of the current leader
+static unsigned long clockSyncLastRequest = 0;
+static uint32_t clockSyncEffectTime = 0;  // leader effect time (millis() + timebase) at clockSyncLeaderTime
+static uint64_t clockSyncLeaderTime = 0;  // leader clock (us) of last response
+
+// follow the effect timeline of the node whose notification was applied
+static void setClockSyncLeader(IPAddress ip) {
+  if (!clockSyncEnabled || ip == IPAddress()) return;
+  if (ip != clockSyncLeader) {
+    clockSyncLeader = ip;
+    clockSync.reset();
+    clockSyncResponses = 0;
+  }
+  clockSyncLastRequest = millis() - CLOCKSYNC_INTERVAL; // request right away, the leader timebase may have changed
+}
+
+static inline bool isClockSynced() {
+  return clockSyncEnabled && clockSyncLeader != IPAddress() && clockSync.isSynced(clockSyncMicros());
+}
+
+// answer requests of followers, add samples from responses of our leader
+static void handleClockSyncPacket(const uint8_t *udpIn, IPAddress remote, uint16_t remotePort, uint64_t rxTime) {
+  if (udpIn[1] == CLOCKSYNC_REQUEST) {
+    uint8_t out[CLOCKSYNC_PACKET_SIZE];
+    memcpy(out, udpIn, 12); // token, seq and t1
+    out[1] = CLOCKSYNC_RESPONSE;
+    putClockSyncTime(out + 12, rxTime);
+    const uint64_t t3 = clockSyncMicros();
+    const uint32_t effectTime = millis() + strip.timebase;
+    putClockSyncTime(out + 20, t3);
+    out[28] = effectTime >> 24; out[29] = effectTime >> 16; out[30] = effectTime >> 8; out[31] = effectTime;
+    notifierUdp.beginPacket(remote, remotePort);
+    notifierUdp.write(out, CLOCKSYNC_PACKET_SIZE);
+    notifierUdp.endPacket();
+  } else if (udpIn[1] == CLOCKSYNC_RESPONSE) {
+    if (remote != clockSyncLeader || udpIn[2] != clockSyncSeq) return; // not our leader or stale response
+    const uint64_t t3 = getClockSyncTime(udpIn + 20);
+    clockSync.addSample(getClockSyncTime(udpIn + 4), getClockSyncTime(udpIn + 12), t3, rxTime);
+    clockSyncEffectTime = (udpIn[28] << 24) | (udpIn[29] << 16) | (udpIn[30] << 8) | (udpIn[31]);
+    clockSyncLeaderTime = t3;
+    clockSyncResponses++;
+  }
+}
+
+// send requests to the leader and run effects on its timeline
+static void handleClockSync() {
+  if (!clockSyncEnabled || clockSyncLeader == IPAddress() || !udpConnected) return;
+  // poll faster until the filter is filled, but only if the leader answers at all (older versions do not)
+  const unsigned long interval = clockSyncResponses && clockSyncResponses < CLOCKSYNC_FILTER ? CLOCKSYNC_INTERVAL_FAST : CLOCKSYNC_INTERVAL;
+  if (millis() - clockSyncLastRequest >= interval) {
+    uint8_t out[CLOCKSYNC_PACKET_SIZE] = {0};
+    out[0] = CLOCKSYNC_TOKEN;
+    out[1] = CLOCKSYNC_REQUEST;
+    out[2] = ++clockSyncSeq;
+    putClockSyncTime(out + 4, clockSyncMicros());
+    notifierUdp.beginPacket(clockSyncLeader, udpPort);
+    notifierUdp.write(out, CLOCKSYNC_PACKET_SIZE);
+    notifierUdp.endPacket();
+    clockSyncLastRequest = millis();
+  }
+  const uint64_t now = clockSyncMicros();
+  if (!clockSync.isSynced(now)) return;
+  // leader effect time now = effect time at t3 + elapsed leader time since t3
+  const int64_t elapsed = int64_t(now + clockSync.getOffset(now) - clockSyncLeaderTime) / 1000;
+  strip.timebase = clockSyncEffectTime + uint32_t(elapsed) - millis();
+}
+
+static void parseNotifyPacket(const uint8_t *udpIn, IPAddress sender = IPAddress()) {
   //ignore notification if received within a second after sending a notification ourselves
   if (millis() - notificationSentTime < 1000) return;
   if (udpIn[1] > 199) return; //do not receive custom versions
@@ -369,11 +468,14 @@ static void parseNotifyPacket(const uint8_t *udpIn) {
   }
 
   if (applyEffects && version > 5) {
-    uint32_t t = (udpIn[25] << 24) | (udpIn[26] << 16) | (udpIn[27] << 8) | (udpIn[28]);
-    t += PRESUMED_NETWORK_DELAY; //adjust trivially for network delay
-    t -= millis();
-    strip.timebase = t;
-    timebaseUpdated = true;
+    setClockSyncLeader(sender);
+    if (!isClockSynced()) { // otherwise timebase follows the leader's clock (handleClockSync())
+      uint32_t t = (udpIn[25] << 24) | (udpIn[26] << 16) | (udpIn[27] << 8) | (udpIn[28]);
+      t += PRESUMED_NETWORK_DELAY; //adjust trivially for network delay
+      t -= millis();
+      strip.timebase = t;
+      timebaseUpdated = true;
+    }
   }
 
   //adjust system time, but only if sender is more accurate than self
@@ -474,6 +576,9 @@ void handleNotifications()
     notify(notificationSentCallMode,true);
   }
 
+  handleE131Timeouts();        // show incomplete E1.31/Art-Net frame, drop lost E1.31 sources, present due DDP frame
+  handleClockSync();
+
   if (e131NewData && millis() - strip.getLastShow() > 15)
   {
     e131NewData = false;
@@ -525,6 +630,13 @@ void handleNotifications()
   unsigned len;
   if (isSupp) len = notifier2Udp.read(udpIn, packetSize);
   else        len =  notifierUdp.read(udpIn, packetSize);
+  const uint64_t rxTime = clockSyncMicros();
+
+  // clock synchronization request or response
+  if (!isSupp && udpIn[0] == CLOCKSYNC_TOKEN && len >= CLOCKSYNC_PACKET_SIZE) {
+    handleClockSyncPacket(udpIn, notifierUdp.remoteIP(), notifierUdp.remotePort(), rxTime);
+    return;
+  }
 
   // WLED nodes info notifications
   if (isSupp && udpIn[0] == 255 && udpIn[1] == 1 && len >= 40) {
@@ -561,7 +673,7 @@ void handleNotifications()
   if (udpIn[0] == 0 && !realtimeMode && receiveGroups)
   {
     DEBUG_PRINTF_P(PSTR("UDP notification from: %d.%d.%d.%d\n"), notifierUdp.remoteIP()[0], notifierUdp.remoteIP()[1], notifierUdp.remoteIP()[2], notifierUdp.remoteIP()[3]);
-    parseNotifyPacket(udpIn);
+    parseNotifyPacket(udpIn, notifierUdp.remoteIP());
     return;
   }
 
@@ -302,17 +302,10 @@ uint8_t extractModeName(uint8_t mode, const char *src, char *dest, uint8_t maxLe
 {
   if (src == JSON_mode_names || src == nullptr) {
     if (mode < strip.getModeCount()) {
-      char lineBuffer[256];
-      //strcpy_P(lineBuffer, (const char*)pgm_read_dword(&(WS2812FX::_modeData[mode])));
-      strncpy_P(lineBuffer, strip.getModeData(mode), sizeof(lineBuffer)/sizeof(char)-1);
-      lineBuffer[sizeof(lineBuffer)/sizeof(char)-1] = '\0'; // terminate string
-      size_t len = strlen(lineBuffer);
-      size_t j = 0;
-      for (; j < maxLen && j < len; j++) {
-        if (lineBuffer[j] == '\0' || lineBuffer[j] == '@') break;
-        dest[j] = lineBuffer[j];
-      }
-      dest[j] = 0; // terminate string
+      size_t len = strip.getEffectInfo(mode).nameLen; // known from the effect registry, no need to search for '@'
+      if (len > maxLen) len = maxLen;
+      strncpy_P(dest, strip.getModeData(mode), len);
+      dest[len] = 0; // terminate string
       return strlen(dest);
     } else return 0;
   }
@@ -429,23 +422,15 @@ uint8_t extractModeSlider(uint8_t mode, uint8_t slider, char *dest, uint8_t maxL
 }
 
 
-// extracts mode parameter defaults from last section of mode data (e.g. "Juggle@!,Trail;!,!,;!;012;sx=16,ix=240")
+// returns mode parameter default from last section of mode data (e.g. "Juggle@!,Trail;!,!,;!;012;sx=16,ix=240")
+// defaults are pre-parsed by the effect registry (fx_registry.h), -1 if not defined
 int16_t extractModeDefaults(uint8_t mode, const char *segVar)
 {
   if (mode < strip.getModeCount()) {
-    char lineBuffer[256];
-    strncpy_P(lineBuffer, strip.getModeData(mode), sizeof(lineBuffer)/sizeof(char)-1);
-    lineBuffer[sizeof(lineBuffer)/sizeof(char)-1] = '\0'; // terminate string
-    if (lineBuffer[0] != 0) {
-      char* startPtr = strrchr(lineBuffer, ';'); // last ";" in FX data
-      if (!startPtr) return -1;
-
-      char* stopPtr = strstr(startPtr, segVar);
-      if (!stopPtr) return -1;
-
-      stopPtr += strlen(segVar) +1; // skip "="
-      return atoi(stopPtr);
-    }
+    const EffectInfo info = strip.getEffectInfo(mode);
+    #define FX_DEF_LOOKUP(id, key) if (strcmp_P(segVar, PSTR(#key)) == 0) return info.getDefault(FX_DEF_##id);
+    FX_DEFAULTS(FX_DEF_LOOKUP)
+    #undef FX_DEF_LOOKUP
   }
   return -1;
 }
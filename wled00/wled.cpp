@@ -42,103 +42,94 @@ void WLED::loop()
 {
   static uint16_t      heapTime = 0;   // timestamp for heap check
   static uint8_t       heapDanger = 0; // counter for consecutive low-heap readings
-#ifdef WLED_DEBUG
-  static unsigned long lastRun = 0;
-  unsigned long        loopMillis = millis();
-  size_t               loopDelay = loopMillis - lastRun;
-  if (lastRun == 0) loopDelay=0; // startup - don't have valid data from last run.
-  if (loopDelay > 2) DEBUG_PRINTF_P(PSTR("Loop delayed more than %ums.\n"), loopDelay);
-  static unsigned long maxLoopMillis = 0;
-  static size_t        avgLoopMillis = 0;
-  static unsigned long maxUsermodMillis = 0;
-  static size_t        avgUsermodMillis = 0;
-  static unsigned long maxStripMillis = 0;
-  static size_t        avgStripMillis = 0;
-  unsigned long        stripMillis;
-#endif
 
-  handleTime();
+  // the next frame is the deadline of this iteration, non-urgent work is deferred if it does not fit before it
+  const bool     renderFrame   = (!realtimeMode || realtimeOverride || (realtimeMode && useMainSegmentOnly)) && (!offMode || strip.isOffRefreshRequired() || strip.needsUpdate());
+  const unsigned frameInterval = strip.needsUpdate() || strip.getFrameTime() <= strip.getMinShowDelay() ? strip.getMinShowDelay() + 1 : strip.getFrameTime();
+  loopScheduler.beginLoop(millis(), strip.getLastFrame(), frameInterval, renderFrame);
+
+  loopScheduler.run(LOOP_TASK_TIME, handleTime);
   #ifndef WLED_DISABLE_INFRARED
-  handleIR();        // 2nd call to function needed for ESP32 to return valid results -- should be good for ESP8266, too
+  loopScheduler.run(LOOP_TASK_IR, handleIR); // 2nd call to function needed for ESP32 to return valid results -- should be good for ESP8266, too
   #endif
-  handleConnection();
+  loopScheduler.run(LOOP_TASK_CONNECTION, [this]{ handleConnection(); });
   #ifdef WLED_ENABLE_ADALIGHT
-  handleSerial();
+  loopScheduler.run(LOOP_TASK_SERIAL, handleSerial);
   #endif
-  handleImprovWifiScan();
-  handleNotifications();
-  handleTransitions();
-  #ifdef WLED_ENABLE_DMX
-  handleDMXOutput();
-  #endif
-  #ifdef WLED_ENABLE_DMX_INPUT
-  dmxInput.update();
+  loopScheduler.run(LOOP_TASK_IMPROV, handleImprovWifiScan);
+  loopScheduler.run(LOOP_TASK_NOTIFY, handleNotifications);
+  loopScheduler.run(LOOP_TASK_TRANSITION, handleTransitions);
+  #if defined(WLED_ENABLE_DMX) || defined(WLED_ENABLE_DMX_INPUT)
+  loopScheduler.run(LOOP_TASK_DMX, []{
+    #ifdef WLED_ENABLE_DMX
+    handleDMXOutput();
+    #endif
+    #ifdef WLED_ENABLE_DMX_INPUT
+    dmxInput.update();
+    #endif
+  });
   #endif
 
-  #ifdef WLED_DEBUG
-  unsigned long usermodMillis = millis();
-  #endif
-  userLoop();
-  UsermodManager::loop();
-  #ifdef WLED_DEBUG
-  usermodMillis = millis() - usermodMillis;
-  avgUsermodMillis += usermodMillis;
-  if (usermodMillis > maxUsermodMillis) maxUsermodMillis = usermodMillis;
-  #endif
+  loopScheduler.run(LOOP_TASK_USERMODS, []{
+    userLoop();
+    UsermodManager::loop();
+  });
 
   yield();
-  handleIO();
+  loopScheduler.run(LOOP_TASK_IO, handleIO);
   #ifndef WLED_DISABLE_INFRARED
-  handleIR();
+  loopScheduler.run(LOOP_TASK_IR, handleIR);
   #endif
   #ifndef WLED_DISABLE_ESPNOW
-  handleRemote();
+  loopScheduler.run(LOOP_TASK_REMOTE, handleRemote);
   #endif
   #ifndef WLED_DISABLE_ALEXA
-  handleAlexa();
+  loopScheduler.run(LOOP_TASK_ALEXA, handleAlexa);
+  #endif
+  #ifndef WLED_DISABLE_MQTT
+  loopScheduler.run(LOOP_TASK_MQTT, handleMqtt);
   #endif
 
-  if (doCloseFile) {
-    closeFile();
+  if (doCloseFile && loopScheduler.run(LOOP_TASK_FILE, closeFile)) {
     yield();
   }
 
-  #ifdef WLED_DEBUG
-  stripMillis = millis();
-  #endif
   if (!realtimeMode || realtimeOverride || (realtimeMode && useMainSegmentOnly))  // block stuff if WARLS/Adalight is enabled
   {
-    if (apActive) dnsServer.processNextRequest();
-    #ifdef WLED_ENABLE_AOTA
-    if (Network.isConnected() && aOtaEnabled && !otaLock && correctPIN) ArduinoOTA.handle();
-    #endif
-    handleNightlight();
+    loopScheduler.run(LOOP_TASK_SERVICES, []{
+      if (apActive) dnsServer.processNextRequest();
+      #ifdef WLED_ENABLE_AOTA
+      if (Network.isConnected() && aOtaEnabled && !otaLock && correctPIN) ArduinoOTA.handle();
+      #endif
+    });
+    loopScheduler.run(LOOP_TASK_NIGHTLIGHT, handleNightlight);
     yield();
 
     #ifndef WLED_DISABLE_HUESYNC
-    handleHue();
+    loopScheduler.run(LOOP_TASK_HUE, handleHue);
     yield();
     #endif
 
     if (!presetNeedsSaving()) {
-      handlePlaylist();
+      loopScheduler.run(LOOP_TASK_PLAYLIST, handlePlaylist);
       yield();
     }
-    handlePresets();
+    loopScheduler.run(LOOP_TASK_PRESETS, handlePresets);
     yield();
 
     if (!offMode || strip.isOffRefreshRequired() || strip.needsUpdate())
-      strip.service();
+      loopScheduler.run(LOOP_TASK_STRIP, []{ strip.service(); });
     #ifdef ESP8266
     else if (!noWifiSleep)
       delay(1); //required to make sure ESP enters modem sleep (see #1184)
     #endif
+    // time from power on to the first frame showing the restored state, frames shown before the boot preset was applied do not count
+    if (!bootFirstFrame) {
+      static unsigned long bootPendingShow = 0;
+      if (presetNeedsApplying() || transitionActive) bootPendingShow = strip.getLastShow();
+      else if (strip.getLastShow() != bootPendingShow) bootFirstFrame = strip.getLastShow();
+    }
   }
-  #ifdef WLED_DEBUG
-  stripMillis = millis() - stripMillis;
-  avgStripMillis += stripMillis;
-  if (stripMillis > maxStripMillis) maxStripMillis = stripMillis;
-  #endif
 
   yield();
 #ifdef ESP8266
@@ -153,15 +144,17 @@ void WLED::loop()
     strip.restartRuntime();
   }
   if (millis() - lastMqttReconnectAttempt > 30000 || lastMqttReconnectAttempt == 0) { // lastMqttReconnectAttempt==0 forces immediate broadcast
-    lastMqttReconnectAttempt = millis();
-    #ifndef WLED_DISABLE_MQTT
-    initMqtt();
-    #endif
-    yield();
-    // refresh WLED nodes list
-    refreshNodeList();
-    if (nodeBroadcastEnabled) sendSysInfoUDP();
-    yield();
+    loopScheduler.run(LOOP_TASK_MAINTAIN, []{
+      lastMqttReconnectAttempt = millis();
+      #ifndef WLED_DISABLE_MQTT
+      initMqtt();
+      #endif
+      yield();
+      // refresh WLED nodes list
+      refreshNodeList();
+      if (nodeBroadcastEnabled) sendSysInfoUDP();
+      yield();
+    });
   }
 
   // 15min PIN time-out
@@ -170,7 +163,7 @@ void WLED::loop()
   }
 
    // free memory and reconnect WiFi to clear stale allocations if heap is too low for too long, check once every 5s
-  if ((uint16_t)(millis() - heapTime) > 5000) {
+  if ((uint16_t)(millis() - heapTime) > 5000) loopScheduler.run(LOOP_TASK_HEAP, []{
     #ifdef ESP8266
     uint32_t heap = getFreeHeapSize(); // ESP8266 needs ~8k of free heap for UI to work properly
     #else
@@ -210,31 +203,33 @@ void WLED::loop()
         break;
     }
     heapTime = (uint16_t)millis();
-  }
+  });
 
   //LED settings have been saved, re-init busses
   //This code block causes severe FPS drop on ESP32 with the original "if (busConfigs[0] != nullptr)" conditional. Investigate!
-  if (doInitBusses) {
-    doInitBusses = false;
-    DEBUG_PRINTLN(F("Re-init busses."));
-    bool aligned = strip.checkSegmentAlignment(); //see if old segments match old bus(ses)
-    strip.finalizeInit(); // will create buses and also load default ledmap if present
-    if (aligned) strip.makeAutoSegments();
-    else strip.fixInvalidSegments();
-    BusManager::setBrightness(scaledBri(bri)); // fix re-initialised bus' brightness #4005 and #4824
-    configNeedsWrite = true;
-  }
-  if (loadLedmap >= 0) {
-    strip.deserializeMap(loadLedmap);
-    loadLedmap = -1;
-  }
+  if (doInitBusses || loadLedmap >= 0) loopScheduler.run(LOOP_TASK_BUSSES, []{
+    if (doInitBusses) {
+      doInitBusses = false;
+      DEBUG_PRINTLN(F("Re-init busses."));
+      bool aligned = strip.checkSegmentAlignment(); //see if old segments match old bus(ses)
+      strip.finalizeInit(); // will create buses and also load default ledmap if present
+      if (aligned) strip.makeAutoSegments();
+      else strip.fixInvalidSegments();
+      BusManager::setBrightness(scaledBri(bri)); // fix re-initialised bus' brightness #4005 and #4824
+      configNeedsWrite = true;
+    }
+    if (loadLedmap >= 0) {
+      strip.deserializeMap(loadLedmap);
+      loadLedmap = -1;
+    }
+  });
   yield();
-  if (configNeedsWrite) serializeConfigToFS();
+  if (configNeedsWrite) loopScheduler.run(LOOP_TASK_CONFIG, []{ serializeConfigToFS(); });
 
   yield();
-  handleWs();
+  loopScheduler.run(LOOP_TASK_WS, handleWs);
 #if defined(STATUSLED)
-  handleStatusLED();
+  loopScheduler.run(LOOP_TASK_STATUSLED, [this]{ handleStatusLED(); });
 #endif
 
   toki.resetTick();
@@ -257,14 +252,6 @@ void WLED::loop()
 
 // DEBUG serial logging (every 30s)
 #ifdef WLED_DEBUG
-  loopMillis = millis() - loopMillis;
-  //if (loopMillis > 30) {
-  //  DEBUG_PRINTF_P(PSTR("Loop took %lums.\n"), loopMillis);
-  //  DEBUG_PRINTF_P(PSTR("Usermods took %lums.\n"), usermodMillis);
-  //  DEBUG_PRINTF_P(PSTR("Strip took %lums.\n"), stripMillis);
-  //}
-  avgLoopMillis += loopMillis;
-  if (loopMillis > maxLoopMillis) maxLoopMillis = loopMillis;
   if (millis() - debugTime > 29999) {
     DEBUG_PRINTLN(F("---DEBUG INFO---"));
     DEBUG_PRINTF_P(PSTR("Runtime: %lu\n"),  millis());
@@ -313,25 +300,15 @@ void WLED::loop()
     DEBUG_PRINTF_P(PSTR("State time: %lu\n"),        wifiStateChangedTime);
     DEBUG_PRINTF_P(PSTR("NTP last sync: %lu\n"),     ntpLastSyncTime);
     DEBUG_PRINTF_P(PSTR("Client IP: %u.%u.%u.%u\n"), Network.localIP()[0], Network.localIP()[1], Network.localIP()[2], Network.localIP()[3]);
-    if (loops > 0) { // avoid division by zero
-      DEBUG_PRINTF_P(PSTR("Loops/sec: %u\n"),         loops / 30);
-      DEBUG_PRINTF_P(PSTR("Loop time[ms]: %u/%lu\n"), avgLoopMillis/loops,    maxLoopMillis);
-      DEBUG_PRINTF_P(PSTR("UM time[ms]: %u/%lu\n"),   avgUsermodMillis/loops, maxUsermodMillis);
-      DEBUG_PRINTF_P(PSTR("Strip time[ms]:%u/%lu\n"), avgStripMillis/loops,   maxStripMillis);
-    }
+    DEBUG_PRINTF_P(PSTR("Loops/sec: %u\n"), (loopScheduler.stats.loop.runs - loops) / 30);
+    DEBUG_PRINTF_P(PSTR("Loop time[us]: %u/%u, late frames: %u/%u\n"), loopScheduler.stats.loop.avg, loopScheduler.stats.loop.max, loopScheduler.stats.late, loopScheduler.stats.frames);
+    DEBUG_PRINTF_P(PSTR("UM time[us]: %u/%u\n"),    loopScheduler.timing(LOOP_TASK_USERMODS).avg, loopScheduler.timing(LOOP_TASK_USERMODS).max);
+    DEBUG_PRINTF_P(PSTR("Strip time[us]: %u/%u\n"), loopScheduler.timing(LOOP_TASK_STRIP).avg,    loopScheduler.timing(LOOP_TASK_STRIP).max);
     strip.printSize();
     server.printStatus(DEBUGOUT);
-    loops = 0;
-    maxLoopMillis = 0;
-    maxUsermodMillis = 0;
-    maxStripMillis = 0;
-    avgLoopMillis = 0;
-    avgUsermodMillis = 0;
-    avgStripMillis = 0;
+    loops = loopScheduler.stats.loop.runs;
     debugTime = millis();
   }
-  loops++;
-  lastRun = millis();
 #endif        // WLED_DEBUG
 }
 
@@ -480,8 +457,16 @@ void WLED::setup()
       resetConfig();
     }
   }
+  // LEDs first: with a valid binary snapshot of the LED configuration the strip is started before cfg.json is parsed
+  const bool ledsCached = cfgCacheUsed = loadConfigCache();
+  if (ledsCached) {
+    DEBUG_PRINTLN(F("Initializing strip from snapshot"));
+    beginStrip();
+    strip.service(); // first frame, usermods are not set up yet so no overlay callback
+  }
+
   DEBUG_PRINTLN(F("Reading config"));
-  bool needsCfgSave = deserializeConfigFromFS();
+  bool needsCfgSave = deserializeConfigFromFS(ledsCached);
   DEBUG_PRINTF_P(PSTR("heap %u\n"), getFreeHeapSize());
 
 #if defined(STATUSLED) && STATUSLED>=0
@@ -492,13 +477,17 @@ void WLED::setup()
   }
 #endif
 
-  DEBUG_PRINTLN(F("Initializing strip"));
-  beginStrip();
+  if (!ledsCached) {
+    DEBUG_PRINTLN(F("Initializing strip"));
+    beginStrip();
+    saveConfigCache(); // buses are now initialised from cfg.json
+  }
   DEBUG_PRINTF_P(PSTR("heap %u\n"), getFreeHeapSize());
 
   DEBUG_PRINTLN(F("Usermods setup"));
   userSetup();
   UsermodManager::setup();
+  strip.setShowCallback(handleOverlayDraw); // calls usermods, must not be installed before they are set up
   DEBUG_PRINTF_P(PSTR("heap %u\n"), getFreeHeapSize());
 
   if (needsCfgSave) serializeConfigToFS(); // usermods required new parameters; need to wait for strip to be initialised #4752
@@ -604,7 +593,6 @@ void WLED::beginStrip()
   strip.finalizeInit(); // busses created during deserializeConfig() if config existed
   strip.makeAutoSegments();
   strip.setBrightness(0);
-  strip.setShowCallback(handleOverlayDraw);
   doInitBusses = false;
 
   // init offMode and relay
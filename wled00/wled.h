@@ -198,6 +198,22 @@ using PSRAMDynamicJsonDocument = BasicJsonDocument<PSRAM_Allocator>;
 #include "bus_manager.h"
 #include "FX.h"
 #include "wled_metadata.h"
+#include "e131_frames.h"
+#include "e131_sources.h"
+#include "ddp_frames.h"
+#include "clock_sync.h"
+#include "cfg_cache.h"
+#include "loop_scheduler.h"
+#include "render_profile.h"
+#include "live_stream.h"
+#include "gzip_writer.h"
+#include "schedule.h"
+#ifndef WLED_DISABLE_MQTT
+  #include "mqtt_publisher.h"
+#endif
+#ifdef WLED_ENABLE_DMX
+  #include "dmx_patch.h"
+#endif
 
 #ifndef CLIENT_SSID
   #define CLIENT_SSID DEFAULT_CLIENT_SSID
@@ -463,6 +479,7 @@ WLED_GLOBAL bool arlsForceMaxBri _INIT(false);                    // enable to f
   // dmx CONFIG
   WLED_GLOBAL byte DMXChannels _INIT(7);        // number of channels per fixture
   WLED_GLOBAL byte DMXFixtureMap[15] _INIT_N(({ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }));
+  WLED_GLOBAL DMXPatch dmxPatch;                 // compiled output patch (profile/group 0 from the settings above, more from cfg.json)
   // assigns the different channels to different functions. See wled21_dmx.ino for more information.
   WLED_GLOBAL uint16_t DMXGap _INIT(10);          // gap between the fixtures. makes addressing easier because you don't have to memorize odd numbers when climbing up onto a rig.
   WLED_GLOBAL uint16_t DMXStart _INIT(10);        // start address of the first fixture
@@ -478,16 +495,33 @@ WLED_GLOBAL bool arlsForceMaxBri _INIT(false);                    // enable to f
 
 WLED_GLOBAL uint16_t e131Universe _INIT(1);                       // settings for E1.31 (sACN) protocol (only DMX_MODE_MULTIPLE_* can span over consequtive universes)
 WLED_GLOBAL uint16_t e131Port _INIT(5568);                        // DMX in port. E1.31 default is 5568, Art-Net is 6454
-WLED_GLOBAL byte e131Priority _INIT(0);                           // E1.31 port priority (if != 0 priority handling is active)
-WLED_GLOBAL E131Priority highPriority _INIT(3);                   // E1.31 highest priority tracking, init = timeout in seconds
+WLED_GLOBAL byte e131Priority _INIT(0);                           // E1.31 minimum priority of accepted senders
+WLED_GLOBAL byte e131MergeMode _INIT(E131_MERGE_LTP);             // E1.31 merge of senders with equal priority (LTP or HTP)
 WLED_GLOBAL byte DMXMode _INIT(DMX_MODE_MULTIPLE_RGB);            // DMX mode (s.a.)
 WLED_GLOBAL uint16_t DMXAddress _INIT(1);                         // DMX start address of fixture, a.k.a. first Channel [for E1.31 (sACN) protocol]
 WLED_GLOBAL uint16_t DMXSegmentSpacing _INIT(0);                  // Number of void/unused channels between each segments DMX channels
 WLED_GLOBAL byte e131LastSequenceNumber[E131_MAX_UNIVERSE_COUNT]; // to detect packet loss
+WLED_GLOBAL E131FrameAssembler e131Frames _INIT_N(((handleE131FrameUniverse))); // multi-universe frame assembly
+WLED_GLOBAL E131SourceMerger e131Sources;                         // E1.31 sender tracking and merging
+WLED_GLOBAL bool ddpTimecodeSync _INIT(false);                    // buffer DDP frames and present them at the sender's time code
+WLED_GLOBAL DDPFrameBuffer ddpFrames _INIT_N(((handleDDPFrame)));  // DDP receive jitter buffer
 WLED_GLOBAL bool e131Multicast _INIT(false);                      // multicast or unicast
 WLED_GLOBAL bool e131SkipOutOfSequence _INIT(false);              // freeze instead of flickering
 WLED_GLOBAL uint16_t pollReplyCount _INIT(0);                     // count number of replies for ArtPoll node report
 
+// boot
+WLED_GLOBAL unsigned long bootFirstFrame _INIT(0);  // millis() when the first frame with the restored state was shown
+WLED_GLOBAL bool cfgCacheUsed _INIT(false);         // LEDs were configured from the binary config snapshot at boot
+
+// main loop
+WLED_GLOBAL LoopScheduler loopScheduler;            // time budgeted scheduling and timing of loop() subsystems
+#ifndef WLED_DISABLE_RENDER_PROFILE
+WLED_GLOBAL RenderProfiler renderProfiler;          // per segment and per stage render times (/json/perf)
+#endif
+#ifdef WLED_ENABLE_FX_ARENA
+WLED_GLOBAL EffectDataArena fxArena _INIT_N(((WLED_FX_ARENA_SIZE))); // effect data of all segments (fx_arena.h)
+#endif
+
 // mqtt
 WLED_GLOBAL unsigned long lastMqttReconnectAttempt _INIT(0);  // used for other periodic tasks too
 #ifndef WLED_DISABLE_MQTT
@@ -508,6 +542,10 @@ WLED_GLOBAL char mqttPass[65] _INIT("");                   // optional: password
 WLED_GLOBAL char mqttClientID[41] _INIT("");               // override the client ID
 WLED_GLOBAL uint16_t mqttPort _INIT(1883);
 WLED_GLOBAL bool retainMqttMsg _INIT(false);               // retain brightness and color
+WLED_GLOBAL bool mqttPublishJson _INIT(false);             // publish JSON state to <device>/state
+WLED_GLOBAL uint16_t mqttPublishWindow _INIT(MQTT_PUBLISH_WINDOW); // ms state changes are coalesced into one message
+WLED_GLOBAL uint16_t mqttRateLimit[4] _INIT_N(({0, 0, 0, 0}));     // minimum ms between messages of g, c, v and state topics
+WLED_GLOBAL MqttPublisher mqttPublisher;
 #define WLED_MQTT_CONNECTED (mqtt != nullptr && mqtt->connected())
 #else
 #define WLED_MQTT_CONNECTED false
@@ -604,6 +642,7 @@ WLED_GLOBAL uint8_t paletteBlend _INIT(0);        // determines blending and wra
 
 // transitions
 WLED_GLOBAL uint8_t       blendingStyle            _INIT(0);      // effect blending/transitionig style
+WLED_GLOBAL bool          transitionSnapshot       _INIT(false);  // blend against a frozen frame of the old effect instead of rendering both effects (set while a JSON request with "ts" is applied)
 WLED_GLOBAL bool          transitionActive         _INIT(false);
 WLED_GLOBAL uint16_t      transitionDelay          _INIT(750);    // global transition duration
 WLED_GLOBAL uint16_t      transitionDelayDefault   _INIT(750);    // default transition time (stored in cfg.json)
@@ -670,6 +709,9 @@ WLED_GLOBAL byte notificationSentCallMode _INIT(CALL_MODE_INIT);
 WLED_GLOBAL uint8_t notificationCount _INIT(0);
 WLED_GLOBAL uint8_t syncGroups    _INIT(0x01);                // sync send groups this instance syncs to (bit mapped)
 WLED_GLOBAL uint8_t receiveGroups _INIT(0x01);                // sync receive groups this instance belongs to (bit mapped)
+WLED_GLOBAL bool clockSyncEnabled _INIT(true);                // synchronize effect timebase with the clock of the sync leader
+WLED_GLOBAL IPAddress clockSyncLeader;                        // node whose notifications we follow (unset if we sent the last one)
+WLED_GLOBAL ClockSync clockSync;                              // offset and drift estimation towards the leader clock
 #ifdef WLED_SAVE_RAM
 // this will save us 8 bytes of RAM while increasing code by ~400 bytes
 typedef class Receive {
@@ -815,6 +857,7 @@ WLED_GLOBAL bool countdownOverTriggered _INIT(true);
 
 WLED_GLOBAL byte lastTimerMinute  _INIT(0);
 WLED_GLOBAL std::vector<Timer> timers;
+WLED_GLOBAL std::vector<CronTimer> cronTimers;         // timers with cron expressions (cfg.json only)
 WLED_GLOBAL bool doAdvancePlaylist _INIT(false);
 
 //improv
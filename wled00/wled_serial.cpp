@@ -1,10 +1,11 @@
 #include "wled.h"
+#include "serial_frames.h"
 
 // forward declarations
 static void sendBytes();
 
 /*
- * Adalight and TPM2 handler
+ * Adalight, TPM2 and binary frame handler
  */
 
 enum class AdaState {
@@ -25,18 +26,23 @@ enum class AdaState {
 static uint16_t currentBaud = 1152; //default baudrate 115200 (divided by 100)
 static bool continuousSendLED = false;
 static uint32_t lastUpdate = 0;
+static SerialFrameDecoder serialFrame;
+
+static void setBaudRate(uint32_t rate){
+  currentBaud = rate/100;
+  Serial.flush();
+  Serial.begin(rate);
+}
 
 void updateBaudRate(uint32_t rate){
   unsigned rate100 = rate/100;
   if (rate100 == currentBaud || rate100 < 96) return;
-  currentBaud = rate100;
 
   if (serialCanTX){
     Serial.print(F("Baud is now ")); Serial.println(rate);
   }
 
-  Serial.flush();
-  Serial.begin(rate);
+  setBaudRate(rate);
 }
 
 // RGB LED data return as JSON array. Slow, but easy to use on the other end.
@@ -55,18 +61,44 @@ static inline void sendJSON(){
 // RGB LED data returned as bytes in TPM2 format. Faster, and slightly less easy to use on the other end.
 static void sendBytes(){
   if (serialCanTX) {
-    Serial.write(0xC9); Serial.write(0xDA);
     unsigned used = strip.getLengthTotal();
     unsigned len = used*3;
-    Serial.write(highByte(len));
-    Serial.write(lowByte(len));
+    uint8_t buf[96]; // write in blocks instead of byte by byte
+    buf[0] = 0xC9; buf[1] = 0xDA;
+    buf[2] = highByte(len);
+    buf[3] = lowByte(len);
+    unsigned n = 4;
     for (unsigned i=0; i < used; i++) {
       uint32_t c = strip.getPixelColor(i);
-      Serial.write(qadd8(W(c), R(c))); //R, add white channel to RGB channels as a simple RGBW -> RGB map
-      Serial.write(qadd8(W(c), G(c))); //G
-      Serial.write(qadd8(W(c), B(c))); //B
+      buf[n++] = qadd8(W(c), R(c)); //R, add white channel to RGB channels as a simple RGBW -> RGB map
+      buf[n++] = qadd8(W(c), G(c)); //G
+      buf[n++] = qadd8(W(c), B(c)); //B
+      if (n > sizeof(buf) - 3) { Serial.write(buf, n); n = 0; }
+    }
+    buf[n++] = 0x36; buf[n++] = '\n';
+    Serial.write(buf, n);
+  }
+}
+
+static void showSerialFrame() {
+  realtimeLock(realtimeTimeoutMs, REALTIME_MODE_ADALIGHT);
+  if (!realtimeOverride) strip.show();
+}
+
+// read as much of a binary frame as is available (in bulk), commit it once it is complete and valid
+static void handleSerialFrame() {
+  if (serialFrame.receive(Serial, millis(), serialCanTX) != SERIAL_ACK_OK) return;
+
+  if (serialFrame.type() == SERIAL_FRAME_PIXELS) {
+    // commit the whole frame buffer at once
+    realtimeLock(realtimeTimeoutMs, REALTIME_MODE_ADALIGHT);
+    if (!realtimeOverride) {
+      const uint32_t *px = serialFrame.pixels();
+      for (unsigned i = 0; i < serialFrame.length(); i++) setRealtimePixel(i, R(px[i]), G(px[i]), B(px[i]), W(px[i]));
+      strip.show();
     }
-    Serial.write(0x36); Serial.write('\n');
+  } else if (serialFrame.type() == SERIAL_FRAME_BAUD && serialFrame.baudRate() >= 9600) {
+    setBaudRate(serialFrame.baudRate()); // acknowledged at the old rate
   }
 }
 
@@ -81,14 +113,41 @@ void handleSerial()
   static byte red   = 0x00;
   static byte green = 0x00;
 
+  serialFrame.handle(millis()); // timed out frame, idle line, unused buffers
+
   while (Serial.available() > 0)
   {
     yield();
+    if (serialFrame.active()) { // binary frame, or the rest of a rejected one
+      continuousSendLED = false;
+      handleSerialFrame();
+      continue;
+    }
+    if (state == AdaState::Data_Red && Serial.available() >= 3) {
+      // read whole pixels in bulk
+      continuousSendLED = false;
+      byte buf[96];
+      unsigned n = min(min((unsigned)Serial.available() / 3, (unsigned)count), (unsigned)(sizeof(buf) / 3));
+      n = Serial.readBytes(buf, n * 3) / 3;
+      for (unsigned i = 0; i < n; i++) {
+        if (!realtimeOverride) setRealtimePixel(pixel++, buf[3*i], buf[3*i+1], buf[3*i+2], 0);
+      }
+      count -= n;
+      if (count == 0) {
+        showSerialFrame();
+        state = AdaState::Header_A;
+      }
+      continue;
+    }
     byte next = Serial.peek();
     switch (state) {
       case AdaState::Header_A:
         if      (next == 'A')  { state = AdaState::Header_d; }
         else if (next == 0xC9) { state = AdaState::TPM2_Header_Type; } //TPM2 start byte
+        else if (next == SERIAL_FRAME_START) { // binary frame (see serial_frames.h), buffers are allocated once it is valid
+          serialFrame.begin(strip.getLengthTotal());
+          serialFrame.start(millis());
+        }
         else if (next == 'I')  { handleImprovPacket(); return; }
         else if (next == 'v')  { Serial.print("WLED"); Serial.write(' '); Serial.println(VERSION); }
         else if (next == 0xB0) { updateBaudRate( 115200); }
@@ -178,9 +237,7 @@ void handleSerial()
         if (!realtimeOverride) setRealtimePixel(pixel++, red, green, blue, 0);
         if (--count > 0) state = AdaState::Data_Red;
         else {
-          realtimeLock(realtimeTimeoutMs, REALTIME_MODE_ADALIGHT);
-
-          if (!realtimeOverride) strip.show();
+          showSerialFrame();
           state = AdaState::Header_A;
         }
         break;
@@ -214,6 +214,7 @@ static void handleUpload(AsyncWebServerRequest *request, const String& filename,
   if (isFinal) {
     request->_tempFile.close();
     if (filename.indexOf(F("cfg.json")) >= 0) { // check for filename with or without slash
+      invalidateConfigCache();
       doReboot = true;
       request->send(200, FPSTR(CONTENT_TYPE_PLAIN), F("Config restore ok.\nRebooting..."));
     } else {
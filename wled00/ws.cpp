@@ -7,6 +7,7 @@
 
 // forward declarations
 static bool sendLiveLedsWs(uint32_t wsClient);
+static void setLiveClientWs(uint16_t wsClient, JsonObject opt);
 
 // define some constants for binary protocols, dont use defines but C++ style constexpr
 constexpr uint8_t BINARY_PROTOCOL_GENERIC = 0xFF; // generic / auto detect NOT IMPLEMENTED
@@ -14,11 +15,23 @@ constexpr uint8_t BINARY_PROTOCOL_E131    = P_E131; // = 0, untested!
 constexpr uint8_t BINARY_PROTOCOL_ARTNET  = P_ARTNET; // = 1, untested!
 constexpr uint8_t BINARY_PROTOCOL_DDP     = P_DDP; // = 2
 
+#define WS_LIVE_INTERVAL 40
+#define WS_LIVE_LEGACY   0xFF // live view format version 1/2 (downsampled RGB)
+#define WS_PERF_INTERVAL 1000
+
 static uint16_t wsLiveClientId = 0;
 static unsigned long wsLastLiveTime = 0;
+static LiveStreamEncoder *wsLiveStream = nullptr; // binary live view version 3 (only used from loop())
+static uint16_t wsLiveInterval = WS_LIVE_INTERVAL;
+static uint8_t wsLiveStep = 1;
+static uint8_t wsLiveFormat = WS_LIVE_LEGACY;
+static volatile bool wsLiveChanged = false;       // live view client or options changed (applied in handleWs())
 //static uint8_t* wsFrameBuffer = nullptr;
+#ifndef WLED_DISABLE_RENDER_PROFILE
+static uint16_t wsPerfClientId = 0;
+static unsigned long wsLastPerfTime = 0;
+#endif
 
-#define WS_LIVE_INTERVAL 40
 
 void wsEvent(AsyncWebSocket * server, AsyncWebSocketClient * client, AwsEventType type, void * arg, uint8_t *data, size_t len)
 {
@@ -28,7 +41,10 @@ void wsEvent(AsyncWebSocket * server, AsyncWebSocketClient * client, AwsEventTyp
     sendDataWs(client);
   } else if(type == WS_EVT_DISCONNECT){
     //client disconnected
-    if (client->id() == wsLiveClientId) wsLiveClientId = 0;
+    if (client->id() == wsLiveClientId) setLiveClientWs(0, JsonObject());
+    #ifndef WLED_DISABLE_RENDER_PROFILE
+    if (client->id() == wsPerfClientId) wsPerfClientId = 0;
+    #endif
     DEBUG_PRINTLN(F("WS client disconnected."));
   } else if(type == WS_EVT_DATA){
     // data packet
@@ -60,7 +76,12 @@ void wsEvent(AsyncWebSocket * server, AsyncWebSocketClient * client, AwsEventTyp
           //if the received value is just "{"v":true}", send only to this client
           verboseResponse = true;
         } else if (root.containsKey("lv")) {
-          wsLiveClientId = root["lv"] ? client->id() : 0;
+          // {"lv":true} legacy live view, {"lv":{"fmt":0-2,"step":n,"int":ms}} full resolution stream (see live_stream.h)
+          setLiveClientWs(root["lv"] ? client->id() : 0, root["lv"]);
+        #ifndef WLED_DISABLE_RENDER_PROFILE
+        } else if (root.containsKey(F("perf"))) {
+          wsPerfClientId = root[F("perf")] ? client->id() : 0; // {"perf":true} subscribes to render profile updates
+        #endif
         } else {
           verboseResponse = deserializeState(root);
         }
@@ -248,9 +269,78 @@ static bool sendLiveLedsWs(uint32_t wsClient)
   return true;
 }
 
+#ifndef WLED_DISABLE_RENDER_PROFILE
+// send {"perf":{...}} (see serializePerf()) to the subscribed client, does not wait for the JSON buffer
+static bool sendPerfWs(uint32_t wsClient)
+{
+  AsyncWebSocketClient * wsc = ws.client(wsClient);
+  if (!wsc || wsc->queueLength() > 0 || jsonBufferLock || !requestJSONBufferLock(JSON_LOCK_WS_SEND)) return false;
+  serializePerf(pDoc->createNestedObject(F("perf")));
+  size_t len = measureJson(*pDoc);
+  AsyncWebSocketBuffer buffer(len);
+  if (buffer) serializeJson(*pDoc, (char *)buffer.data(), len);
+  releaseJSONBufferLock();
+  if (!buffer) return false;
+  wsc->text(std::move(buffer));
+  return true;
+}
+#endif
+
+static void setLiveClientWs(uint16_t wsClient, JsonObject opt)
+{
+  wsLiveClientId = wsClient;
+  wsLiveFormat   = opt.isNull() ? WS_LIVE_LEGACY : constrain(opt[F("fmt")] | LIVE_FMT_RGB565, LIVE_FMT_RGB888, LIVE_FMT_RGB332);
+  wsLiveStep     = constrain(opt[F("step")] | 1, 1, 255);
+  wsLiveInterval = constrain(opt[F("int")] | WS_LIVE_INTERVAL, 20, 10000);
+  wsLiveChanged  = true;
+}
+
+// full resolution live view: encode the frame buffer as delta against the last frame the client received
+static bool sendLiveStreamWs(uint32_t wsClient)
+{
+  AsyncWebSocketClient * wsc = ws.client(wsClient);
+  if (!wsc || wsc->queueLength() > 0 || !strip.getPixels()) return false; // backpressure: skip frames while the client is busy
+  unsigned width  = strip.getLengthTotal();
+  unsigned height = 1;
+#ifndef WLED_DISABLE_2D
+  if (strip.isMatrix) {
+    // ignore anything behind matrix (i.e. extra strip)
+    width  = Segment::maxWidth;
+    height = Segment::maxHeight;
+  }
+#endif
+  // resolution is reduced until the frame fits into LIVE_STREAM_MAX_PIXELS and into memory
+  while (wsLiveStep < 255 && ((width + wsLiveStep - 1) / wsLiveStep) * ((height + wsLiveStep - 1) / wsLiveStep) > LIVE_STREAM_MAX_PIXELS) wsLiveStep++;
+  if (!wsLiveStream->begin(width, height, wsLiveStep, wsLiveFormat)) {
+    wsLiveStep = wsLiveStep < 128 ? wsLiveStep * 2 : 255;
+    return false;
+  }
+
+  const uint8_t brightness = bri ? 255 : 0; // like the legacy format, show colors unscaled unless the light is off
+  const size_t len = wsLiveStream->measure(strip.getPixels(), brightness);
+  AsyncWebSocketBuffer wsBuf(len);
+  if (!wsBuf) {
+    wsLiveStep = wsLiveStep < 128 ? wsLiveStep * 2 : 255; // out of memory
+    return false;
+  }
+  if (!wsLiveStream->encode(strip.getPixels(), brightness, reinterpret_cast<uint8_t*>(wsBuf.data()), len)) return false;
+  wsc->binary(std::move(wsBuf));
+  return true;
+}
+
 void handleWs()
 {
-  if (millis() - wsLastLiveTime > WS_LIVE_INTERVAL)
+  if (wsLiveChanged) {
+    wsLiveChanged = false;
+    if (wsLiveClientId && wsLiveFormat != WS_LIVE_LEGACY) {
+      if (!wsLiveStream) wsLiveStream = new LiveStreamEncoder();
+      wsLiveStream->end(); // new client or options, start with a key frame
+    } else {
+      delete wsLiveStream;
+      wsLiveStream = nullptr;
+    }
+  }
+  if (millis() - wsLastLiveTime > wsLiveInterval)
   {
     #ifdef ESP8266
     ws.cleanupClients(3);
@@ -258,10 +348,16 @@ void handleWs()
     ws.cleanupClients();
     #endif
     bool success = true;
-    if (wsLiveClientId) success = sendLiveLedsWs(wsLiveClientId);
+    if (wsLiveClientId) success = wsLiveStream ? sendLiveStreamWs(wsLiveClientId) : sendLiveLedsWs(wsLiveClientId);
     wsLastLiveTime = millis();
-    if (!success) wsLastLiveTime -= 20; //try again in 20ms if failed due to non-empty WS queue
+    if (!success) wsLastLiveTime = millis() - wsLiveInterval + 20; //try again in 20ms if failed due to non-empty WS queue
   }
+  #ifndef WLED_DISABLE_RENDER_PROFILE
+  if (wsPerfClientId && millis() - wsLastPerfTime > WS_PERF_INTERVAL) {
+    if (sendPerfWs(wsPerfClientId)) wsLastPerfTime = millis();
+    else wsLastPerfTime = millis() - WS_PERF_INTERVAL + 100; // try again in 100ms
+  }
+  #endif
 }
 
 #else